@@ -62,6 +62,29 @@
 */
 #define TC_BLOCK_SIZE 16
 
+/*
+** GCM block and full tag size
+*/
+#define CRYPTO_GCM_BLOCK_SIZE 16
+
+/*
+** Threading
+**
+** Configuration, Crypto_Init, Crypto_Shutdown and SA management (start, stop, rekey, expire) must not overlap any
+** other call.  Once initialized:
+**  - Crypto_TC/TM/AOS_ApplySecurity may be called from any number of threads, also on one SA.  Each thread reserves
+**    its own IV/ARSN values (see Crypto_SA_Counters_Reserve), the receiver must get them back in counter order.
+**  - ProcessSecurity and VerifySecurity may run concurrently on different SAs.  Frames of one SA may advance the
+**    SA's anti-replay window and must be passed in by one thread at a time, Crypto_TM_ProcessSecurity_Batch
+**    decrypts a window on its worker pool and commits it in order.
+**  - TC frames carrying SDLS EP PDUs (TC_PROCESS_SDLS_PDUS_TRUE) build their replies in shared buffers and must be
+**    processed by one thread at a time.
+** The GVCID located for a frame (current_managed_parameters), the scratch arena and the counter blocks are per thread.
+** The libgcrypt and KMC modules keep per call or per thread handles, the OpenSSL module locks each cached context
+** slot and keys a private context while another thread holds it.  wolfSSL and custom modules give no such guarantee,
+** callers using them serialize every call.  CRYPTOGRAPHY_TYPE_AUTO gives the guarantee of the modules it routes to.
+*/
+
 /*
 ** User Prototypes
 */
@@ -82,11 +105,18 @@ extern int32_t Crypto_Config_Kmc_Crypto_Service(char* protocol, char* kmc_crypto
                                                 uint8_t kmc_ignore_ssl_hostname_validation, char* mtls_client_cert_path,
                                                 char* mtls_client_cert_type, char* mtls_client_key_path,
                                                 char* mtls_client_key_pass, char* mtls_issuer_cert);
+extern int32_t Crypto_Config_Kmc_Crypto_Service_Add_Endpoint(char* kmc_crypto_hostname, uint16_t kmc_crypto_port);
+extern int32_t Crypto_Config_Kmc_Crypto_Service_Hedging(uint32_t hedge_delay_ms, uint8_t breaker_threshold,
+                                                        uint32_t breaker_open_ms);
+extern int32_t Crypto_Config_Kmc_Crypto_Service_Batching(uint8_t batch_max, uint32_t batch_window_us);
 extern int32_t Crypto_Config_Cam(uint8_t cam_enabled, char* cookie_file_path, char* keytab_file_path, uint8_t login_method, char* access_manager_uri, char* username, char* cam_home);
 // extern int32_t Crypto_Config_Add_Gvcid_Managed_Parameter(uint8_t tfvn, uint16_t scid, uint8_t vcid, uint8_t has_fecf,
 //                                                          uint8_t has_segmentation_hdr, uint8_t has_ocf, uint16_t max_frame_size, uint8_t aos_has_fhec,
 //                                                          uint8_t aos_has_iz, uint16_t aos_iz_len);
 extern int32_t Crypto_Config_Add_Gvcid_Managed_Parameters(GvcidManagedParameters_t mp_struct);
+extern int32_t Crypto_Config_Gvcid_Idle_Frames(uint8_t tfvn, uint16_t scid, uint8_t vcid, uint8_t idle_vc, uint8_t idle_policy);
+extern int32_t Crypto_Config_Reject_Budget(uint32_t burst, uint32_t rate, uint32_t holdoff_ms);
+extern int32_t Crypto_Config_TM_Anti_Replay(uint8_t tm_check_anti_replay);
 // Initialization
 extern int32_t Crypto_Init(void); // Initialize CryptoLib After Configuration Calls
 extern int32_t Crypto_Init_With_Configs(
@@ -97,6 +127,8 @@ extern int32_t Crypto_SC_Init(void);  // Initialize CryptoLib with Spacecraft de
 extern int32_t Crypto_Init_TC_Unit_Test(void);      // Initialize CryptoLib with unit test default Configurations
 extern int32_t Crypto_Init_TM_Unit_Test(void);      // Initialize CryptoLib with unit test default Configurations
 extern int32_t Crypto_Init_AOS_Unit_Test(void);      // Initialize CryptoLib with unit test default Configurations
+extern int32_t Crypto_Init_From_Snapshot(const char* path, const uint8_t* master_key, uint16_t master_key_len); // Initialize CryptoLib from a saved snapshot
+extern int32_t Crypto_Snapshot_Save(const char* path, const uint8_t* master_key, uint16_t master_key_len);
 
 // Cleanup
 extern int32_t Crypto_Shutdown(void); // Free all allocated memory
@@ -116,32 +148,31 @@ int32_t Crypto_TC_Nontransmitted_SN_Increment(SecurityAssociation_t* sa_ptr, TC_
 int32_t Crypto_TC_Check_ACS_Keylen(crypto_key_t* akp, SecurityAssociation_t* sa_ptr);
 int32_t Crypto_TC_Check_ECS_Keylen(crypto_key_t* ekp, SecurityAssociation_t* sa_ptr);
 void Crypto_TC_Safe_Free_Ptr(uint8_t* ptr);
-int32_t Crypto_TC_Do_Decrypt(uint8_t sa_service_type, uint8_t ecs_is_aead_algorithm, crypto_key_t* ekp, SecurityAssociation_t* sa_ptr, uint8_t* aad, TC_t* tc_sdls_processed_frame, uint8_t* ingest, uint16_t tc_enc_payload_start_index, uint16_t aad_len, char* cam_cookies, crypto_key_t* akp, uint8_t segment_hdr_len);
+int32_t Crypto_TC_Do_Decrypt(uint8_t sa_service_type, uint8_t ecs_is_aead_algorithm, crypto_key_t* ekp, SecurityAssociation_t* sa_ptr, uint8_t* aad, TC_t* tc_sdls_processed_frame, uint8_t* ingest, const crypto_frame_desc_t* desc, uint16_t aad_len, char* cam_cookies, crypto_key_t* akp);
 int32_t Crypto_TC_Process_Sanity_Check(int* len_ingest);
-int32_t Crypto_TC_Prep_AAD(TC_t* tc_sdls_processed_frame, uint8_t fecf_len,  uint8_t sa_service_type, uint8_t ecs_is_aead_algorithm, uint16_t* aad_len, SecurityAssociation_t* sa_ptr, uint8_t segment_hdr_len, uint8_t* ingest, uint8_t** aad);
+int32_t Crypto_TC_Prep_AAD(TC_t* tc_sdls_processed_frame, const crypto_frame_desc_t* desc, uint8_t sa_service_type, uint8_t ecs_is_aead_algorithm, uint16_t* aad_len, SecurityAssociation_t* sa_ptr, uint8_t* ingest, uint8_t** aad);
 int32_t Crypto_TC_Get_Keys(crypto_key_t** ekp, crypto_key_t** akp, SecurityAssociation_t* sa_ptr);
 int32_t Crypto_TC_Check_IV_ARSN(SecurityAssociation_t* sa_ptr,TC_t* tc_sdls_processed_frame);
 uint32_t Crypto_TC_Sanity_Validations(TC_t* tc_sdls_processed_frame, SecurityAssociation_t** sa_ptr);
 void Crypto_TC_Get_Ciper_Mode_TCP(uint8_t sa_service_type, uint32_t* encryption_cipher, uint8_t* ecs_is_aead_algorithm, SecurityAssociation_t* sa_ptr);
 int32_t Crypto_TC_Get_Ciper_Mode_TCA(uint8_t sa_service_type, uint32_t* encryption_cipher, uint8_t* ecs_is_aead_algorithm, SecurityAssociation_t* sa_ptr);
 void Crypto_TC_Calc_Lengths(uint8_t* fecf_len, uint8_t* segment_hdr_len);
-void Crypto_TC_Set_Segment_Header(TC_t* tc_sdls_processed_frame, uint8_t* ingest, int* byte_idx);
+int32_t Crypto_TC_Decode_Frame(uint8_t* ingest, int len_ingest, TC_t* tc_sdls_processed_frame, crypto_frame_desc_t* desc);
 int32_t Crypto_TC_Check_CMD_Frame_Flag(uint8_t header_cc);
 int32_t Crypto_TC_Validate_SA_Service_Type(uint8_t sa_service_type);
 int32_t Crypto_TC_Handle_Enc_Padding(uint8_t sa_service_type, uint32_t* pkcs_padding, uint16_t* p_enc_frame_len, uint16_t* new_enc_frame_header_field_length, uint16_t tf_payload_len, SecurityAssociation_t* sa_ptr);
 int32_t Crypto_TC_Frame_Validation(uint16_t* p_enc_frame_len);
 int32_t Crypto_TC_Accio_Buffer(uint8_t** p_new_enc_frame, uint16_t* p_enc_frame_len);
 int32_t Crypto_TC_ACS_Algo_Check(SecurityAssociation_t* sa_ptr);
-int32_t Crypto_TC_Check_IV_Setup(SecurityAssociation_t* sa_ptr, uint8_t* p_new_enc_frame, uint16_t *index);
-int32_t Crypto_TC_Do_Encrypt_PLAINTEXT(uint8_t sa_service_type, SecurityAssociation_t* sa_ptr, uint16_t* mac_loc, uint16_t tf_payload_len, uint8_t segment_hdr_len, uint8_t* p_new_enc_frame, crypto_key_t* ekp, uint8_t** aad, uint8_t ecs_is_aead_algorithm, uint16_t *index_p, const uint8_t* p_in_frame, char* cam_cookies, uint32_t pkcs_padding);
-void Crypto_TC_Do_Encrypt_NONPLAINTEXT(uint8_t sa_service_type, SecurityAssociation_t* sa_ptr);
-int32_t Crypto_TC_Do_Encrypt(uint8_t sa_service_type, SecurityAssociation_t* sa_ptr, uint16_t* mac_loc, uint16_t tf_payload_len, uint8_t segment_hdr_len, uint8_t* p_new_enc_frame, crypto_key_t* ekp, uint8_t** aad, uint8_t ecs_is_aead_algorithm, uint16_t *index_p, const uint8_t* p_in_frame, char* cam_cookies, uint32_t pkcs_padding, uint16_t new_enc_frame_header_field_length, uint16_t* new_fecf);
+int32_t Crypto_TC_Check_IV_Setup(SecurityAssociation_t* sa_ptr, const crypto_sa_counters_t* counters, uint8_t* p_new_enc_frame, uint16_t *index);
+int32_t Crypto_TC_Do_Encrypt_PLAINTEXT(uint8_t sa_service_type, SecurityAssociation_t* sa_ptr, const crypto_sa_counters_t* counters, uint16_t* mac_loc, uint16_t tf_payload_len, uint8_t segment_hdr_len, uint8_t* p_new_enc_frame, crypto_key_t* ekp, uint8_t** aad, uint8_t ecs_is_aead_algorithm, uint16_t *index_p, const uint8_t* p_in_frame, char* cam_cookies, uint32_t pkcs_padding);
+int32_t Crypto_TC_Do_Encrypt(uint8_t sa_service_type, SecurityAssociation_t* sa_ptr, const crypto_sa_counters_t* counters, uint16_t* mac_loc, uint16_t tf_payload_len, uint8_t segment_hdr_len, uint8_t* p_new_enc_frame, crypto_key_t* ekp, uint8_t** aad, uint8_t ecs_is_aead_algorithm, uint16_t *index_p, const uint8_t* p_in_frame, char* cam_cookies, uint32_t pkcs_padding, uint16_t new_enc_frame_header_field_length, uint16_t* new_fecf);
 int32_t Crypto_TC_Check_Init_Setup(uint16_t in_frame_length);
 int32_t Crypto_TC_Sanity_Setup(const uint8_t* p_in_frame, const uint16_t in_frame_length);
 int32_t Crytpo_TC_Validate_TC_Temp_Header(const uint16_t in_frame_length, TC_FramePrimaryHeader_t temp_tc_header, const uint8_t* p_in_frame, uint8_t* map_id, uint8_t* segmentation_hdr, SecurityAssociation_t** sa_ptr);
 int32_t Crypto_TC_Finalize_Frame_Setup(uint8_t sa_service_type, uint32_t* pkcs_padding, uint16_t* p_enc_frame_len, uint16_t* new_enc_frame_header_field_length, uint16_t tf_payload_len, SecurityAssociation_t** sa_ptr, uint8_t** p_new_enc_frame);
 void Crypto_TC_Handle_Padding(uint32_t pkcs_padding, SecurityAssociation_t* sa_ptr, uint8_t* p_new_enc_frame, uint16_t* index);
-int32_t Crypto_TC_Set_IV(SecurityAssociation_t* sa_ptr, uint8_t* p_new_enc_frame, uint16_t* index);
+int32_t Crypto_TC_Set_IV(SecurityAssociation_t* sa_ptr, const crypto_sa_counters_t* counters, uint8_t* p_new_enc_frame, uint16_t* index);
 
 
 
@@ -149,9 +180,13 @@ int32_t Crypto_TC_Set_IV(SecurityAssociation_t* sa_ptr, uint8_t* p_new_enc_frame
 // Telemetry (TM)
 extern int32_t Crypto_TM_ApplySecurity(uint8_t* pTfBuffer);
 extern int32_t Crypto_TM_ProcessSecurity(uint8_t* p_ingest, uint16_t len_ingest, uint8_t** pp_processed_frame, uint16_t *p_decrypted_length);
+extern int32_t Crypto_TM_ProcessSecurity_Batch(crypto_tm_batch_job_t* jobs, uint32_t num_jobs, uint32_t num_threads);
+extern int32_t Crypto_TM_VerifySecurity(uint8_t* p_ingest, uint16_t len_ingest);
 // Advanced Orbiting Systems (AOS)
 extern int32_t Crypto_AOS_ApplySecurity(uint8_t* pTfBuffer);
 extern int32_t Crypto_AOS_ProcessSecurity(uint8_t* p_ingest, uint16_t len_ingest, uint8_t** pp_processed_frame, uint16_t* p_decrypted_length);
+extern int32_t Crypto_AOS_VerifySecurity(uint8_t* p_ingest, uint16_t len_ingest);
+int32_t Crypto_AOS_Decode_Frame(uint8_t* p_ingest, crypto_frame_desc_t* desc);
 
 
 // Crypo Error Support Functions
@@ -169,19 +204,18 @@ void Crypto_TM_PKCS_Padding(uint32_t* pkcs_padding, SecurityAssociation_t* sa_pt
 void Crypto_TM_Handle_Managed_Parameter_Flags(uint16_t* pdu_len);
 int32_t Crypto_TM_Get_Keys(crypto_key_t** ekp, crypto_key_t** akp, SecurityAssociation_t* sa_ptr);
 int32_t Crypto_TM_Do_Encrypt_NONPLAINTEXT(uint8_t sa_service_type, uint16_t* aad_len, int* mac_loc, uint16_t* idx_p, uint16_t pdu_len, uint8_t* pTfBuffer, uint8_t* aad, SecurityAssociation_t* sa_ptr);
-int32_t Crypto_TM_Do_Encrypt_NONPLAINTEXT_AEAD_Logic(uint8_t sa_service_type, uint8_t ecs_is_aead_algorithm, uint8_t* pTfBuffer, uint16_t pdu_len, uint16_t data_loc, crypto_key_t* ekp, crypto_key_t* akp, uint32_t pkcs_padding, int* mac_loc, uint16_t* aad_len, uint8_t* aad, SecurityAssociation_t* sa_ptr);
-int32_t Crypto_TM_Do_Encrypt_Handle_Increment(uint8_t sa_service_type, SecurityAssociation_t* sa_ptr);
-int32_t Crypto_TM_Do_Encrypt(uint8_t sa_service_type, SecurityAssociation_t* sa_ptr, uint16_t* aad_len, int* mac_loc, uint16_t* idx_p, uint16_t pdu_len, uint8_t* pTfBuffer, uint8_t* aad, uint8_t ecs_is_aead_algorithm, uint16_t data_loc, crypto_key_t* ekp, crypto_key_t* akp, uint32_t pkcs_padding, uint16_t* new_fecf);
+int32_t Crypto_TM_Do_Encrypt_NONPLAINTEXT_AEAD_Logic(uint8_t sa_service_type, uint8_t ecs_is_aead_algorithm, uint8_t* pTfBuffer, uint16_t pdu_len, uint16_t data_loc, crypto_key_t* ekp, crypto_key_t* akp, uint32_t pkcs_padding, int* mac_loc, uint16_t* aad_len, uint8_t* aad, SecurityAssociation_t* sa_ptr, const crypto_sa_counters_t* counters);
+int32_t Crypto_TM_Do_Encrypt(uint8_t sa_service_type, SecurityAssociation_t* sa_ptr, uint16_t* aad_len, int* mac_loc, uint16_t* idx_p, uint16_t pdu_len, uint8_t* pTfBuffer, uint8_t* aad, uint8_t ecs_is_aead_algorithm, uint16_t data_loc, crypto_key_t* ekp, crypto_key_t* akp, uint32_t pkcs_padding, uint16_t* new_fecf, const crypto_sa_counters_t* counters);
 void Crypto_TM_ApplySecurity_Debug_Print(uint16_t idx, uint16_t pdu_len, SecurityAssociation_t* sa_ptr);
-int32_t Crypto_TM_Process_Setup(uint16_t len_ingest, uint16_t* byte_idx, uint8_t* p_ingest, uint8_t* secondary_hdr_len);
+int32_t Crypto_TM_Decode_Frame(uint8_t* p_ingest, crypto_frame_desc_t* desc);
+int32_t Crypto_TM_Process_Setup(uint16_t len_ingest, uint8_t* p_ingest, crypto_frame_desc_t* desc);
 int32_t Crypto_TM_Determine_Cipher_Mode(uint8_t sa_service_type, SecurityAssociation_t* sa_ptr, uint32_t* encryption_cipher, uint8_t* ecs_is_aead_algorithm);
 int32_t Crypto_TM_FECF_Setup(uint8_t* p_ingest, uint16_t len_ingest);
-int32_t Crypto_TM_Parse_Mac_Prep_AAD(uint8_t sa_service_type, uint8_t* p_ingest, int mac_loc, SecurityAssociation_t* sa_ptr, uint16_t* aad_len, uint16_t byte_idx, uint8_t* aad);
-int32_t Crypto_TM_Do_Decrypt_AEAD(uint8_t sa_service_type, uint8_t* p_ingest, uint8_t* p_new_dec_frame, uint16_t byte_idx, uint16_t pdu_len, crypto_key_t* ekp, SecurityAssociation_t* sa_ptr, uint8_t iv_loc, int mac_loc, uint16_t aad_len, uint8_t* aad);
-int32_t Crypto_TM_Do_Decrypt_NONAEAD(uint8_t sa_service_type, uint16_t pdu_len, uint8_t* p_new_dec_frame, uint16_t byte_idx, uint8_t* p_ingest, crypto_key_t* akp, crypto_key_t* ekp, SecurityAssociation_t* sa_ptr, uint8_t iv_loc, int mac_loc, uint16_t aad_len, uint8_t* aad);
-void Crypto_TM_Calc_PDU_MAC(uint16_t* pdu_len, uint16_t byte_idx, SecurityAssociation_t* sa_ptr, int* mac_loc);
-int32_t Crypto_TM_Do_Decrypt(uint8_t sa_service_type, SecurityAssociation_t* sa_ptr, uint8_t ecs_is_aead_algorithm, uint16_t byte_idx, uint8_t* p_new_dec_frame, uint16_t pdu_len, uint8_t* p_ingest, crypto_key_t* ekp, crypto_key_t* akp, uint8_t iv_loc, int mac_loc, uint16_t aad_len, uint8_t* aad, uint8_t** pp_processed_frame, uint16_t* p_decrypted_length);
-void Crypto_TM_Process_Debug_Print(uint16_t byte_idx, uint16_t pdu_len, SecurityAssociation_t* sa_ptr);
+int32_t Crypto_TM_Parse_Mac_Prep_AAD(uint8_t sa_service_type, uint8_t* p_ingest, const crypto_frame_desc_t* desc, SecurityAssociation_t* sa_ptr, uint16_t* aad_len, uint8_t* aad);
+int32_t Crypto_TM_Do_Decrypt_AEAD(uint8_t sa_service_type, uint8_t* p_ingest, uint8_t* p_new_dec_frame, const crypto_frame_desc_t* desc, crypto_key_t* ekp, SecurityAssociation_t* sa_ptr, uint16_t aad_len, uint8_t* aad);
+int32_t Crypto_TM_Do_Decrypt_NONAEAD(uint8_t sa_service_type, const crypto_frame_desc_t* desc, uint8_t* p_new_dec_frame, uint8_t* p_ingest, crypto_key_t* akp, crypto_key_t* ekp, SecurityAssociation_t* sa_ptr, uint16_t aad_len, uint8_t* aad);
+int32_t Crypto_TM_Do_Decrypt(uint8_t sa_service_type, SecurityAssociation_t* sa_ptr, uint8_t ecs_is_aead_algorithm, const crypto_frame_desc_t* desc, uint8_t* p_new_dec_frame, uint8_t* p_ingest, crypto_key_t* ekp, crypto_key_t* akp, uint16_t aad_len, uint8_t* aad, uint8_t** pp_processed_frame, uint16_t* p_decrypted_length);
+void Crypto_TM_Process_Debug_Print(const crypto_frame_desc_t* desc);
 
 
 extern uint8_t Crypto_Prep_Reply(uint8_t* ingest, uint8_t appID);
@@ -203,13 +237,47 @@ int32_t Crypto_window(uint8_t* actual, uint8_t* expected, int length, int window
 uint16_t Crypto_Calc_FECF(const uint8_t* ingest, int len_ingest);
 void Crypto_Calc_CRC_Init_Table(void);
 uint16_t Crypto_Calc_CRC16(uint8_t* data, int size);
+uint32_t Crypto_Calc_CRC32(const uint8_t* data, uint32_t size);
 int32_t Crypto_Check_Anti_Replay(SecurityAssociation_t *sa_ptr, uint8_t *arsn, uint8_t *iv);
 int32_t Crypto_Get_ECS_Algo_Keylen(uint8_t algo);
 int32_t Crypto_Get_ACS_Algo_Keylen(uint8_t algo);
+int32_t Crypto_Flush_SA(uint16_t spi);
+int32_t Crypto_Frame_Desc_Set_SA(crypto_frame_desc_t* desc, SecurityAssociation_t* sa_ptr);
+int32_t Crypto_Frame_Check_IV_ARSN(SecurityAssociation_t* sa_ptr, uint8_t* p_ingest, const crypto_frame_desc_t* desc);
+int32_t Crypto_Frame_Precheck_IV_ARSN(SecurityAssociation_t* sa_ptr, uint8_t* p_ingest, const crypto_frame_desc_t* desc);
+int32_t Crypto_Frame_Check_SA_State(const SecurityAssociation_t* sa_ptr);
+int32_t Crypto_Frame_Verify_Auth(uint8_t sa_service_type, uint8_t ecs_is_aead_algorithm, SecurityAssociation_t* sa_ptr, uint8_t* p_ingest, const crypto_frame_desc_t* desc, crypto_key_t* ekp, crypto_key_t* akp, uint8_t* aad, uint16_t aad_len);
+void Crypto_GCM_Fix_AAD_Tag(uint8_t* tag, const uint8_t* h, uint32_t aad_len, size_t data_len);
+int32_t Crypto_GCM_Check_AAD_Tag(uint8_t* calc_tag, const uint8_t* h, uint32_t aad_len, size_t data_len,
+                                 const uint8_t* mac, uint32_t mac_size);
+
+// Scratch Arena
+void Crypto_Arena_Enter(void);
+void Crypto_Arena_Leave(void);
+void* Crypto_Arena_Alloc(size_t len);
+int32_t Crypto_Arena_Get_Stats(crypto_arena_stats_t* stats);
+void Crypto_Arena_Reset_Stats(void);
+
+// SA Counter Reservation
+int32_t Crypto_SA_Counters_Reserve(SecurityAssociation_t* sa_ptr, uint8_t sa_service_type, crypto_sa_counters_t* counters);
+void Crypto_SA_Counters_Advance(SecurityAssociation_t* sa_ptr, uint32_t count);
+void Crypto_SA_Counters_Gap(uint16_t spi, uint32_t count);
+uint64_t Crypto_SA_Counters_Get_Gaps(uint16_t spi);
+int32_t Crypto_SA_Counters_Set_Block(uint32_t block);
+void Crypto_SA_Counters_Release(void);
+void Crypto_SA_Counters_Flush(uint16_t spi);
+
+// SA Profiles
+const CryptoSaProfile_t* Crypto_SA_Profile_Get(SecurityAssociation_t* sa_ptr, uint8_t frame_type);
+void Crypto_SA_Profile_Flush(uint16_t spi);
+
+// TM Batch Processing
+void Crypto_TM_Batch_Shutdown(void);
 
 int32_t Crypto_Check_Anti_Replay_Verify_Pointers(SecurityAssociation_t* sa_ptr, uint8_t* arsn, uint8_t* iv);
 int32_t Crypto_Check_Anti_Replay_ARSNW(SecurityAssociation_t* sa_ptr, uint8_t* arsn, int8_t* arsn_valid);
 int32_t Crypto_Check_Anti_Replay_GCM(SecurityAssociation_t* sa_ptr, uint8_t* iv, int8_t* iv_valid);
+int32_t Crypto_Precheck_Anti_Replay(SecurityAssociation_t* sa_ptr, uint8_t* arsn, uint8_t* iv);
 
 // Key Management Functions
 int32_t Crypto_Key_OTAR(void);
@@ -225,6 +293,14 @@ int32_t Crypto_MC_erase(uint8_t* ingest);
 int32_t Crypto_MC_selftest(uint8_t* ingest);
 int32_t Crypto_SA_readARSN(uint8_t* ingest);
 int32_t Crypto_MC_resetalarm(void);
+void Crypto_MC_Event(int32_t code, uint16_t spi, const crypto_gvcid_t* gvcid, const char* format, ...);
+uint32_t Crypto_MC_Event_Get_Suppressed(int32_t code);
+void Crypto_MC_Event_Reset(void);
+int32_t Crypto_MC_Reject_Admit(crypto_frame_desc_t* desc);
+void Crypto_MC_Reject_Record(const crypto_frame_desc_t* desc, int32_t status);
+int32_t Crypto_MC_Reject_Get_Gvcid_Counters(uint8_t tfvn, uint16_t scid, uint8_t vcid, crypto_reject_counters_t* counters);
+int32_t Crypto_MC_Reject_Get_SA_Counters(uint16_t spi, crypto_reject_counters_t* counters);
+void Crypto_MC_Reject_Reset(void);
 
 // User Functions
 int32_t Crypto_User_IdleTrigger(uint8_t* ingest);
@@ -255,6 +331,9 @@ int32_t Crypto_Get_Security_Trailer_Length(SecurityAssociation_t* sa_ptr);
 int32_t Crypto_Get_Managed_Parameters_For_Gvcid(uint8_t tfvn, uint16_t scid, uint8_t vcid,
                                                        GvcidManagedParameters_t* managed_parameters_in,
                                                        GvcidManagedParameters_t* managed_parameters_out);
+int32_t Crypto_Get_Managed_Parameters_Ptr_For_Gvcid(uint8_t tfvn, uint16_t scid, uint8_t vcid,
+                                                    const GvcidManagedParameters_t** managed_parameters_out);
+const GvcidIdleFrames_t* Crypto_Get_Idle_Frames_For_Managed_Parameters(const GvcidManagedParameters_t* managed_parameters);
 // int32_t crypto_config_add_gvcid_managed_parameter_recursion(uint8_t tfvn, uint16_t scid, uint8_t vcid,
 //                                                                    uint8_t has_fecf, uint8_t has_segmentation_hdr, uint8_t has_ocf,
 //                                                                    uint16_t max_frame_size, uint8_t aos_has_fhec,
@@ -284,8 +363,8 @@ extern SadbMariaDBConfig_t* sa_mariadb_config;
 extern CryptographyKmcCryptoServiceConfig_t* cryptography_kmc_crypto_config;
 extern CamConfig_t* cam_config;
 extern GvcidManagedParameters_t* gvcid_managed_parameters;
-extern GvcidManagedParameters_t* current_managed_parameters;
-extern GvcidManagedParameters_t gvcid_managed_parameters_array[250];
+extern _Thread_local const GvcidManagedParameters_t* current_managed_parameters;
+extern GvcidManagedParameters_t* gvcid_managed_parameters_array;
 extern GvcidManagedParameters_t current_managed_parameters_struct;
 extern int gvcid_counter;
 extern KeyInterface key_if;
@@ -293,11 +372,27 @@ extern McInterface mc_if;
 extern SaInterface sa_if;
 extern CryptographyInterface cryptography_if;
 
+// Module call sites in the core, bound at compile time when a single module per interface is built
+#ifdef CRYPTO_DIRECT_CALL
+extern const SaInterfaceStruct CRYPTO_DIRECT_SA_IF;
+extern const KeyInterfaceStruct CRYPTO_DIRECT_KEY_IF;
+extern const McInterfaceStruct CRYPTO_DIRECT_MC_IF;
+extern const CryptographyInterfaceStruct CRYPTO_DIRECT_CRYPTOGRAPHY_IF;
+#define CRYPTO_SA_IF (&CRYPTO_DIRECT_SA_IF)
+#define CRYPTO_KEY_IF (&CRYPTO_DIRECT_KEY_IF)
+#define CRYPTO_MC_IF (&CRYPTO_DIRECT_MC_IF)
+#define CRYPTO_CRYPTOGRAPHY_IF (&CRYPTO_DIRECT_CRYPTOGRAPHY_IF)
+#else
+#define CRYPTO_SA_IF sa_if
+#define CRYPTO_KEY_IF key_if
+#define CRYPTO_MC_IF mc_if
+#define CRYPTO_CRYPTOGRAPHY_IF cryptography_if
+#endif
+
 // extern crypto_key_t ak_ring[NUM_KEYS];
 extern CCSDS_t sdls_frame;
 extern SadbMariaDBConfig_t* sa_mariadb_config;
 extern GvcidManagedParameters_t* gvcid_managed_parameters;
-extern GvcidManagedParameters_t* current_managed_parameters;
 // OCF
 extern uint8_t ocf;
 extern SDLS_FSR_t report;
@@ -315,5 +410,7 @@ extern uint8_t badFECF;
 //  CRC
 extern uint32_t crc32Table[256];
 extern uint16_t crc16Table[256];
+// Snapshot
+extern uint8_t crypto_snapshot_restore;
 
 #endif //CRYPTO_H
\ No newline at end of file
@@ -57,11 +57,64 @@
 #endif
 
 // Managed Parameters Size
-#define GVCID_MAN_PARAM_SIZE 250
+#define GVCID_MAN_PARAM_INITIAL_SIZE 16 // Table grows by doubling from this size
+#define GVCID_MAN_PARAM_SIZE 4096       // Upper bound on configured GVCIDs
 
 // Max Frame Size
 #define TC_MAX_FRAME_SIZE 1024
 
+// Scratch Arena Size
+#define CRYPTO_ARENA_SIZE 8192 // Per-thread bytes for transient buffers of one ApplySecurity/ProcessSecurity call
+
+// TM Batch Processing
+#define TM_BATCH_WINDOW 64      // Frames set up, decrypted, and committed per pass
+#define TM_BATCH_MAX_THREADS 16 // Upper bound on decrypt workers
+
+// State Snapshot
+#define CRYPTO_SNAPSHOT_MAGIC 0x43534E50 // "CSNP"
+#define CRYPTO_SNAPSHOT_VERSION 4        // Bump whenever a snapshotted structure changes
+#define CRYPTO_SNAPSHOT_IV_SIZE 12       // AES-GCM IV for the key ring section
+#define CRYPTO_SNAPSHOT_TAG_SIZE 16      // AES-GCM tag for the key ring section
+
+// Shared Memory SADB
+#ifndef SA_SHM_NAME
+#define SA_SHM_NAME "/cryptolib_sadb" // POSIX shared memory object holding the SA table
+#endif
+#define SA_SHM_MAGIC 0x53414442      // "SADB"
+#define SA_SHM_VERSION 1             // Bump whenever the segment layout or SecurityAssociation_t changes
+#define SA_SHM_GVCID_BUCKETS 128     // GVCID index slots, power of two and at least NUM_SA
+#define SA_SHM_INIT_TIMEOUT_MS 5000  // Wait for another process populating the segment
+
+// SA Counter Reservation
+#define SA_COUNTER_SLOTS 64         // Per SA locks and gap counters, power of two and at least NUM_SA
+#define SA_COUNTER_BLOCK_DEFAULT 1  // IV/ARSN values a thread reserves from an SA at once, at most its arsnw
+#define SA_COUNTER_BLOCK_MAX 1024
+
+// KMC Crypto Service Endpoints
+#define KMC_CRYPTO_MAX_ENDPOINTS 4        // Primary plus endpoints added with Crypto_Config_Kmc_Crypto_Service_Add_Endpoint
+#define KMC_CRYPTO_HEDGE_OFF 0            // Hedge delay that never sends a duplicate request
+#define KMC_CRYPTO_HEDGE_P95 0xFFFFFFFF   // Hedge delay following the chosen endpoint's observed p95 latency
+#define KMC_CRYPTO_HEDGE_DEFAULT_MS 100   // p95 hedge delay until enough latencies are observed
+#define KMC_CRYPTO_HEDGE_MIN_MS 5         // Floor of the p95 hedge delay
+#define KMC_CRYPTO_LATENCY_SAMPLES 64     // Recent latencies kept per endpoint for the p95
+#define KMC_CRYPTO_LATENCY_MIN_SAMPLES 20 // Latencies needed before the p95 is trusted
+#define KMC_CRYPTO_BREAKER_THRESHOLD 3    // Consecutive failures opening an endpoint's circuit
+#define KMC_CRYPTO_BREAKER_OPEN_MS 30000  // Time an open circuit is skipped before a trial request
+#define KMC_CRYPTO_BATCH_OFF 1            // Batch size sending every operation in its own request
+#define KMC_CRYPTO_BATCH_MAX 32           // Operations one batch request carries at most
+#define KMC_CRYPTO_BATCH_WINDOW_US 2000   // Default time a batch waits for further operations
+#define KMC_CRYPTO_BATCH_SLOTS 8          // Batches gathering at once, each for its own key reference
+
+// MC Event Rate Limiting
+#define MC_EVENT_CODES 32 // Distinct status codes tracked, further codes share the last bucket
+#define MC_EVENT_BURST 10 // Events of one code reported back to back before limiting starts
+#define MC_EVENT_RATE 1   // Events of one code reported per second once limited
+
+// Frame Rejection Budgets
+#define REJECT_BUDGET_OFF 0    // Burst turning rejection budgets off, rejected frames are only counted
+#define REJECT_GVCID_SLOTS 64  // GVCIDs tracked, further GVCIDs share the last slot
+#define REJECT_HOLDOFF_MS 1000 // Default time a GVCID or SA is shed once its budget ran out
+
 // Spacecraft Defines
 #define SCID 0x0003
 
@@ -78,6 +131,9 @@
 #define TYPE_MAP 1
 #define TYPE_TM 2
 #define TYPE_AOS 3
+#define TC_TFVN 0  // Transfer frame version numbers, CCSDS 232.0-B, 132.0-B, 732.0-B
+#define TM_TFVN 0
+#define AOS_TFVN 1
 
 // Specific to Authentication
 #define SA_NONE 0
@@ -111,10 +167,13 @@
 
 // Generic Defines
 #define NUM_SA 64
+#define CRYPTO_SA_PROFILE_SLOTS 64 // SA profiles cached, indexed by SPI, must be a power of two
 #define SPI_LEN 2 /* bytes */
-#define KEY_SIZE 512 /* bytes */
+#define KEY_SIZE 64 /* bytes, longest key of any supported suite (HMAC-SHA512) */
+#define OTAR_KEY_BLOCK_SIZE 512 /* bytes, encrypted key field of an OTAR key block on the wire */
 #define KEY_ID_SIZE 8
 #define NUM_KEYS 256
+#define KEY_POOL_ALIGN 64 // Key material slots start on a cache line
 #define DISABLED 0
 #define ENABLED 1
 #define IV_SIZE 16   /* TM IV size bytes */
@@ -182,6 +241,7 @@
 #define TM_FRAME_DATA_SIZE 1786 /* bytes */
 #define TM_FILL_SIZE 1145       /* bytes */
 #define TM_PAD_SIZE 2           /* bytes */
+#define TM_FHP_OID 0x7FE        /* First header pointer of a frame carrying only idle data */
 
 // AOS Defines
 #define AOS_FRAME_DATA_SIZE 1786 /* bytes */
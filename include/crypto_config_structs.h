@@ -51,7 +51,8 @@ typedef enum
     SA_TYPE_UNITIALIZED = 0,
     SA_TYPE_CUSTOM,
     SA_TYPE_INMEMORY,
-    SA_TYPE_MARIADB
+    SA_TYPE_MARIADB,
+    SA_TYPE_SHM
 } SadbType;
 typedef enum
 {
@@ -59,7 +60,9 @@ typedef enum
     CRYPTOGRAPHY_TYPE_LIBGCRYPT,
     CRYPTOGRAPHY_TYPE_KMCCRYPTO,
     CRYPTOGRAPHY_TYPE_WOLFSSL,
-    CRYPTOGRAPHY_TYPE_CUSTOM
+    CRYPTOGRAPHY_TYPE_CUSTOM,
+    CRYPTOGRAPHY_TYPE_OPENSSL,
+    CRYPTOGRAPHY_TYPE_AUTO // Fastest compiled in module per cipher suite, measured at init
 } CryptographyType;
 /***************************************
 ** GVCID Managed Parameter enums
@@ -156,6 +159,17 @@ typedef enum
     SA_INCREMENT_NONTRANSMITTED_IV_FALSE,
     SA_INCREMENT_NONTRANSMITTED_IV_TRUE
 } SaIncrementNonTransmittedIvPortion;
+typedef enum
+{
+    IDLE_FRAMES_PROCESS, // Idle frames get full security processing like any other frame
+    IDLE_FRAMES_SKIP,    // Idle frames are dropped after header decode, before SA lookup or crypto
+    IDLE_FRAMES_VERIFY   // Idle frames are authenticated and replay checked, see Crypto_Frame_Verify_Auth for when that decrypts
+} IdleFramePolicy;
+typedef enum
+{
+    IDLE_VC_FALSE,
+    IDLE_VC_TRUE // Every frame on the virtual channel is idle fill
+} IdleVcBool;
 /***************************************
 ** Telemetry specific enums
 ****************************************/
@@ -165,6 +179,11 @@ typedef enum
     TM_HAS_SECONDARY_HDR
 } TmSecondaryHdrPresent;
 typedef enum
+{
+    TM_CHECK_ANTI_REPLAY_FALSE,
+    TM_CHECK_ANTI_REPLAY_TRUE
+} TmCheckAntiReplay;
+typedef enum
 {
     CAM_ENABLED_FALSE,
     CAM_ENABLED_TRUE
@@ -193,7 +212,8 @@ typedef enum
     CRYPTO_CIPHER_AES256_GCM_SIV,
     CRYPTO_CIPHER_AES256_CBC,
     CRYPTO_CIPHER_AES256_CBC_MAC,
-    CRYPTO_CIPHER_AES256_CCM
+    CRYPTO_CIPHER_AES256_CCM,
+    CRYPTO_CIPHER_CHACHA20_POLY1305
 } EncCipherSuite;
 
 /*
@@ -217,6 +237,11 @@ typedef struct
     CheckFecfBool crypto_check_fecf;
     uint8_t vcid_bitmask;
     uint8_t crypto_increment_nontransmitted_iv; // Whether or not CryptoLib increments the non-transmitted portion of the IV field
+    uint32_t reject_burst;      // Rejected frames a GVCID or SA may send back to back, REJECT_BUDGET_OFF to only count
+    uint32_t reject_rate;       // Rejected frames per second a GVCID or SA may send once its burst is used
+    uint32_t reject_holdoff_ms; // Time a GVCID or SA over its budget is shed
+    TmCheckAntiReplay tm_check_anti_replay; // Whether TM ProcessSecurity, serial and batch, holds frames to the SA
+                                            // anti-replay window
 } CryptoConfig_t;
 #define CRYPTO_CONFIG_SIZE (sizeof(CryptoConfig_t))
 
@@ -237,6 +262,17 @@ struct _GvcidManagedParameters_t
 };
 #define GVCID_MANAGED_PARAMETERS_SIZE (sizeof(GvcidManagedParameters_t))
 
+/*
+** Idle Frame Handling
+** Kept per GVCID beside the managed parameters, set with Crypto_Config_Gvcid_Idle_Frames
+*/
+typedef struct
+{
+    IdleVcBool idle_vc;
+    IdleFramePolicy idle_policy;
+} GvcidIdleFrames_t;
+#define GVCID_IDLE_FRAMES_SIZE (sizeof(GvcidIdleFrames_t))
+
 /*
 ** SaDB MariaDB Configuration Block
 */
@@ -275,6 +311,15 @@ typedef struct
     char* mtls_ca_path;
     char* mtls_issuer_cert;
     uint8_t ignore_ssl_hostname_validation;
+    // Further endpoints serving the same crypto service, the primary is kmc_crypto_hostname:kmc_crypto_port
+    uint8_t kmc_crypto_endpoint_count;
+    char* kmc_crypto_endpoint_hostname[KMC_CRYPTO_MAX_ENDPOINTS - 1];
+    uint16_t kmc_crypto_endpoint_port[KMC_CRYPTO_MAX_ENDPOINTS - 1];
+    uint32_t kmc_hedge_delay_ms; // KMC_CRYPTO_HEDGE_OFF, a delay in ms, or KMC_CRYPTO_HEDGE_P95
+    uint8_t kmc_breaker_threshold;
+    uint32_t kmc_breaker_open_ms;
+    uint8_t kmc_batch_max; // Operations sent in one request at most, KMC_CRYPTO_BATCH_OFF sends each on its own
+    uint32_t kmc_batch_window_us;
 
 } CryptographyKmcCryptoServiceConfig_t;
 #define CRYPTOGRAPHY_KMC_CRYPTO_SERVICE_CONFIG_SIZE (sizeof(CryptographyKmcCryptoServiceConfig_t))
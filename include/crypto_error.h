@@ -27,6 +27,7 @@
 #define CRYPTO_MANAGED_PARAM_CONFIGURATION_NOT_COMPLETE 101
 #define CRYPTO_MARIADB_CONFIGURATION_NOT_COMPLETE 102
 #define MANAGED_PARAMETERS_FOR_GVCID_NOT_FOUND 103
+#define CRYPTO_DIRECT_CALL_MODULE_MISMATCH 104
 
 #define SADB_INVALID_SADB_TYPE 200
 #define SADB_NULL_SA_USED 201
@@ -39,6 +40,8 @@
 #define CRYPTOGRAPHY_INVALID_CRYPTO_INTERFACE_TYPE  400
 #define CRYPTOGRAPHY_UNSUPPORTED_OPERATION_FOR_KEY_RING 401
 #define CRYPTOGRAPHY_LIBRARY_INITIALIZIATION_ERROR 402
+#define CRYPTOGRAPHY_AUTO_KNOWN_ANSWER_FAILURE 403
+#define CRYPTOGRAPHY_AUTO_NO_USABLE_INTERFACE 404
 
 #define CRYPTOGRAPHY_KMC_CRYPTO_SERVICE_CONFIGURATION_NOT_COMPLETE 500
 #define CRYPTOGRAPHY_KMC_CURL_INITIALIZATION_FAILURE 501
@@ -56,6 +59,9 @@
 #define CRYPTOGRAHPY_KMC_CRYPTO_SERVICE_EMPTY_RESPONSE 513
 #define CRYPTOGRAHPY_KMC_CRYPTO_SERVICE_DECRYPT_ERROR 514
 #define CRYPTOGRAHPY_KMC_CRYPTO_SERVICE_ENCRYPT_ERROR 515
+#define CRYPTOGRAPHY_KMC_CRYPTO_SERVICE_ENDPOINT_LIMIT 516
+#define CRYPTOGRAPHY_KMC_CRYPTO_SERVICE_BATCH_LIMIT 517
+#define CRYPTOGRAPHY_KMC_CRYPTO_SERVICE_BATCH_UNSUPPORTED 518
 
 #define CAM_CONFIG_NOT_SUPPORTED_ERROR 600
 #define CAM_INVALID_COOKIE_FILE_CONFIGURATION_NULL 601
@@ -127,6 +133,18 @@
 #define CRYPTO_LIB_ERR_KEY_VALIDATION (-55)
 #define CRYPTO_LIB_ERR_SPI_INDEX_OOB (-56)
 #define CRYPTO_LIB_ERR_SA_NOT_OPERATIONAL (-57)
+#define CRYPTO_LIB_ERR_ARENA_EXHAUSTED (-58)
+#define CRYPTO_LIB_ERR_SNAPSHOT_IO (-59)
+#define CRYPTO_LIB_ERR_SNAPSHOT_INVALID (-60)
+#define CRYPTO_LIB_ERR_SNAPSHOT_CHECKSUM (-61)
+#define CRYPTO_LIB_ERR_SNAPSHOT_UNSUPPORTED (-62)
+#define CRYPTO_LIB_ERR_SA_SHM_MAP (-63)
+#define CRYPTO_LIB_ERR_SA_SHM_INCOMPATIBLE (-64)
+#define CRYPTO_LIB_ERR_SA_SHM_LOCK (-65)
+#define CRYPTO_LIB_ERR_SA_COUNTER_BLOCK (-66)
+#define CRYPTO_LIB_ERR_SA_COUNTER_GAP (-67)
+#define CRYPTO_LIB_ERR_IDLE_FRAME (-68)
+#define CRYPTO_LIB_ERR_FRAME_SHED (-69)
 
 extern char *crypto_enum_errlist_core[];
 extern char *crypto_enum_errlist_config[];
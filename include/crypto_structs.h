@@ -83,6 +83,49 @@ typedef struct
 } SecurityAssociation_t;
 #define SA_SIZE (sizeof(SecurityAssociation_t))
 
+/*
+** SA Profile
+** Shape of an SA fixed once it is operational, checked per frame in place of the configuration branches
+*/
+typedef struct
+{
+    SecurityAssociation_t* sa_ptr;
+    const void* managed_parameters;
+    uint16_t spi;
+    uint16_t abm_len;
+    uint8_t frame_type;
+    uint8_t est;
+    uint8_t ast;
+    uint8_t ecs;
+    uint8_t ecs_len;
+    uint8_t acs;
+    uint8_t acs_len;
+    uint8_t shivf_len;
+    uint8_t iv_len;
+    uint8_t shsnf_len;
+    uint8_t shplf_len;
+    uint8_t stmacf_len;
+    uint8_t has_fecf;
+    uint8_t has_segmentation_hdr;
+    uint8_t has_ocf;
+    uint8_t iv_type;
+    uint8_t create_fecf;
+    uint8_t cryptography_type;
+} CryptoSaProfileKey_t;
+
+typedef struct CryptoSaProfile CryptoSaProfile_t;
+struct CryptoSaProfile
+{
+    CryptoSaProfileKey_t key; // Shape the profile was compiled for
+    uint8_t valid;
+    uint8_t spi_hdr[2];      // Security header template, SPI in transmission order
+    uint16_t ecs_key_len;
+    // Specialized frame functions, NULL when the SA takes the generic path
+    int32_t (*tc_apply)(const CryptoSaProfile_t* profile, SecurityAssociation_t* sa_ptr, const uint8_t* p_in_frame,
+                        uint16_t fl, uint8_t** pp_enc_frame, uint16_t* p_enc_frame_len, char* cam_cookies);
+    int32_t (*tm_apply)(const CryptoSaProfile_t* profile, SecurityAssociation_t* sa_ptr, uint8_t* pTfBuffer);
+};
+
 /*
 ** SDLS Definitions
 */
@@ -487,4 +530,118 @@ typedef struct
 #define AOS_MIN_SIZE                                                                                                    \
     (AOS_FRAME_PRIMARYHEADER_SIZE + AOS_FRAME_SECHEADER_SIZE + AOS_FRAME_SECTRAILER_SIZE + AOS_FRAME_OCF_SIZE)
 
+/*
+** Frame Descriptor
+** Filled once per received frame by the TC/TM/AOS decode step and handed to the
+** later processing stages. All locations are byte offsets from the start of the frame.
+*/
+typedef struct
+{
+    uint8_t frame_type;  // TYPE_TC, TYPE_TM, or TYPE_AOS
+    uint8_t tfvn;
+    uint16_t scid;
+    uint8_t vcid;
+    uint8_t map_id;      // TC segment header MAP ID, 0 when not present
+    uint16_t frame_len;  // TC: fl + 1, TM/AOS: managed parameter max frame size
+    uint8_t seg_hdr_len; // TC segment header
+    uint8_t ocf_len;
+    uint8_t fecf_len;
+    uint16_t spi;
+    uint16_t spi_loc;
+    uint8_t idle;        // Idle fill, from the first header pointer or the GVCID managed parameters
+    uint8_t admitted;    // Passed header checks and the rejection budget, later failures are counted
+    uint8_t sa_located;  // Crypto_Frame_Desc_Set_SA placed the frame in its SA, later failures are charged to budgets
+    // Set from the SA by Crypto_Frame_Desc_Set_SA
+    uint16_t iv_loc;
+    uint16_t sn_loc;
+    uint16_t pl_loc;
+    uint16_t pdu_loc;
+    uint16_t pdu_len;
+    uint16_t mac_loc;
+    uint16_t ocf_loc;
+    uint16_t fecf_loc;
+} crypto_frame_desc_t;
+
+/*
+** Frame Rejection Counters
+** Kept per GVCID and per SA by the rejection budgets
+*/
+typedef struct
+{
+    uint32_t rejected; // Frames that failed a check after header decode
+    uint32_t shed;     // Frames dropped unchecked while the budget was exhausted
+    uint32_t holdoffs; // Times the budget ran out
+} crypto_reject_counters_t;
+
+/*
+** Scratch Arena Usage
+*/
+typedef struct
+{
+    size_t high_water;     // Most bytes in use at once
+    uint32_t allocations;
+    uint32_t exhausted;    // Allocations refused because the arena was full
+} crypto_arena_stats_t;
+
+/*
+** SA Counter Reservation
+** IV and ARSN reserved from an SA for one outgoing frame
+*/
+typedef struct
+{
+    uint8_t iv[IV_SIZE];
+    uint8_t arsn[ARSN_SIZE];
+} crypto_sa_counters_t;
+
+/*
+** TM Batch Processing
+** One received frame handed to Crypto_TM_ProcessSecurity_Batch
+*/
+typedef struct
+{
+    uint8_t* p_ingest;
+    uint16_t len_ingest;
+    uint8_t* p_processed_frame; // Set once decryption ran, NULL if the frame fell outside the anti-replay window; caller frees
+    uint16_t processed_length;
+    int32_t status;
+} crypto_tm_batch_job_t;
+
+/*
+** State Snapshot Key Record
+** Key material is written out by value, handles into the key pool do not survive a restart
+*/
+typedef struct
+{
+    uint8_t value[KEY_SIZE];
+    uint32_t key_len;
+    uint8_t key_state;
+} crypto_snapshot_key_t;
+#define CRYPTO_SNAPSHOT_KEY_SIZE (sizeof(crypto_snapshot_key_t))
+
+/*
+** State Snapshot Header
+** Followed by the crypto config, managed parameters, idle frame handling, SA table, and the encrypted key ring,
+** in that order
+*/
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t config_size;  // Structure sizes the snapshot was written with
+    uint32_t gvcid_size;
+    uint32_t idle_size;
+    uint32_t sa_size;
+    uint32_t key_size;
+    uint32_t num_gvcid;
+    uint32_t num_sa;
+    uint32_t num_keys;
+    uint32_t config_crc;   // CRC32 of each plaintext section
+    uint32_t gvcid_crc;
+    uint32_t idle_crc;
+    uint32_t sa_crc;
+    uint8_t key_iv[CRYPTO_SNAPSHOT_IV_SIZE];
+    uint8_t key_tag[CRYPTO_SNAPSHOT_TAG_SIZE]; // Covers the key ring and every header field above key_tag
+    uint32_t header_crc;   // CRC32 of every header field above header_crc
+} crypto_snapshot_header_t;
+
 #endif //CRYPTO_STRUCTS_H
\ No newline at end of file
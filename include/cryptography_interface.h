@@ -26,6 +26,9 @@
 
 #include "crypto_structs.h"
 
+// SPI passed to cryptography_sa_flush to flush every SA
+#define CRYPTOGRAPHY_FLUSH_ALL_SA 0xFFFF
+
 typedef struct
 {
     // Cryptography Interface Initialization & Management Functions
@@ -80,13 +83,25 @@ typedef struct
                                          uint8_t aad_bool, uint8_t* ecs, uint8_t* acs, char* cam_cookies);
     int32_t (*cryptography_get_acs_algo)(int8_t algo_enum);
     int32_t (*cryptography_get_ecs_algo)(int8_t algo_enum);
-    
+    // Optional, zeroizes per SA material the module keeps between calls, see Crypto_Flush_SA
+    int32_t (*cryptography_sa_flush)(uint16_t spi);
+    // Optional, checks an AEAD tag over ciphertext without decrypting it, see Crypto_Frame_Verify_Auth.
+    // Returns CRYPTO_LIB_ERR_UNSUPPORTED_ECS for suites it cannot check this way, the caller then decrypts.
+    int32_t (*cryptography_aead_verify)(uint8_t* data_in, size_t len_data_in,
+                                         uint8_t* key, uint32_t len_key,
+                                         SecurityAssociation_t* sa_ptr,
+                                         uint8_t* iv, uint32_t iv_len,
+                                         uint8_t* mac, uint32_t mac_size,
+                                         uint8_t* aad, uint32_t aad_len,
+                                         uint8_t* ecs);
 
 } CryptographyInterfaceStruct, *CryptographyInterface;
 
 CryptographyInterface get_cryptography_interface_libgcrypt(void);
 CryptographyInterface get_cryptography_interface_kmc_crypto_service(void);
 CryptographyInterface get_cryptography_interface_wolfssl(void);
+CryptographyInterface get_cryptography_interface_openssl(void);
 CryptographyInterface get_cryptography_interface_custom(void);
+CryptographyInterface get_cryptography_interface_auto(void);
 
 #endif //CRYPTOLIB_CRYPTOGRAPHY_INTERFACE_H
@@ -22,9 +22,10 @@
 #include "crypto_structs.h"
 
 /* Structures */
+// Handle onto a key, the material itself lives in the key module's pool and holds up to KEY_SIZE bytes
 typedef struct
 {
-    uint8_t value[KEY_SIZE];
+    uint8_t* value;
     uint32_t key_len;
     uint8_t key_state : 4;
 } crypto_key_t;
@@ -22,12 +22,29 @@
 #include "crypto_structs.h"
 
 /* Structures */
+// Event field value when no SA was resolved at the reporting site
+#define MC_EVENT_SPI_NA 0xFFFF
+
+typedef struct
+{
+    int32_t code;          // CryptoLib status code being reported
+    uint16_t spi;          // MC_EVENT_SPI_NA if unknown
+    uint8_t has_gvcid;     // gvcid is only meaningful when set
+    crypto_gvcid_t gvcid;
+    uint32_t suppressed;   // Events with this code dropped by the rate limiter since the last report
+    const char* detail;
+} McEvent_t;
+
 typedef struct
 {
     /* MC Interface, SDLS */
     int32_t (*mc_initialize)(void);
     void (*mc_log)(int32_t error_code);
     int32_t (*mc_shutdown)(void);
+    // Optional, NULL when the module only records error codes
+    void (*mc_log_message)(const char* message);
+    // Optional, NULL when the module has no structured event sink
+    void (*mc_log_event)(const McEvent_t* event);
     
     /* MC Interface, SDLS-EP */
     /*
@@ -36,6 +36,8 @@ typedef struct
     int32_t (*sa_get_from_spi)(uint16_t, SecurityAssociation_t** );
     int32_t (*sa_get_operational_sa_from_gvcid)(uint8_t, uint16_t, uint16_t, uint8_t, SecurityAssociation_t**);
     int32_t (*sa_save_sa)(SecurityAssociation_t* );
+    // Optional, reserves IV/ARSN values for SADBs shared beyond this process, see Crypto_SA_Counters_Reserve
+    int32_t (*sa_reserve_counters)(SecurityAssociation_t*, uint32_t, uint8_t*, uint8_t*);
     // Security Association Utility Functions
     int32_t (*sa_stop)(void);
     int32_t (*sa_start)(TC_t* tc_frame);
@@ -52,6 +54,9 @@ typedef struct
 SaInterface get_sa_interface_custom(void);
 SaInterface get_sa_interface_inmemory(void);
 SaInterface get_sa_interface_mariadb(void);
+SaInterface get_sa_interface_shm(void);
+// Points the in-memory SA module at another table, NULL restores its own
+void sa_inmemory_bind_table(SecurityAssociation_t* table);
 // SaInterface init_parse_sa_routine(uint8_t* );
 
 #endif //CRYPTOLIB_SA_INTERFACE_H
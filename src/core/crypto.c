@@ -100,7 +100,8 @@ uint8_t Crypto_Is_AEAD_Algorithm(uint32_t cipher_suite_id)
     // CryptoLib only supports AES-GCM, which is an AEAD (Authenticated Encryption with Associated Data) algorithm, so
     // return true/1.
     // TODO - Add cipher suite mapping to which algorithms are AEAD and which are not.
-    if ((cipher_suite_id == CRYPTO_CIPHER_AES256_GCM) || (cipher_suite_id == CRYPTO_CIPHER_AES256_CBC_MAC) || (cipher_suite_id == CRYPTO_CIPHER_AES256_GCM_SIV))
+    if ((cipher_suite_id == CRYPTO_CIPHER_AES256_GCM) || (cipher_suite_id == CRYPTO_CIPHER_AES256_CBC_MAC) || (cipher_suite_id == CRYPTO_CIPHER_AES256_GCM_SIV) ||
+        (cipher_suite_id == CRYPTO_CIPHER_CHACHA20_POLY1305))
     {
 #ifdef DEBUG
         printf(KYEL "CRYPTO IS AEAD? : TRUE\n" RESET);
@@ -416,6 +417,25 @@ uint16_t Crypto_Calc_CRC16(uint8_t* data, int size)
     return crc;
 }
 
+/**
+ * @brief Function: Crypto_Calc_CRC32
+ * Calculates CRC32 (IEEE 802.3), table filled by Crypto_Calc_CRC_Init_Table
+ * @param data: const uint8_t*
+ * @param size: uint32_t
+ * @return uint32: CRC
+ **/
+uint32_t Crypto_Calc_CRC32(const uint8_t* data, uint32_t size)
+{
+    uint32_t crc = 0xFFFFFFFF;
+
+    for (; size > 0; size--)
+    {
+        crc = (crc >> 8) ^ crc32Table[(crc ^ *data++) & 0xFF];
+    }
+
+    return ~crc;
+}
+
 /*
 ** Procedures Specifications
 */
@@ -445,6 +465,7 @@ int32_t Crypto_PDU(uint8_t* ingest, TC_t* tc_frame)
                     printf(KGRN "Key OTAR\n" RESET);
 #endif
                     status = Crypto_Key_OTAR();
+                    Crypto_Flush_SA(CRYPTOGRAPHY_FLUSH_ALL_SA);
                     break;
                 case PID_KEY_ACTIVATION:
 #ifdef PDU_DEBUG
@@ -457,6 +478,7 @@ int32_t Crypto_PDU(uint8_t* ingest, TC_t* tc_frame)
                     printf(KGRN "Key Deactivate\n" RESET);
 #endif
                     status = Crypto_Key_update(KEY_DEACTIVATED);
+                    Crypto_Flush_SA(CRYPTOGRAPHY_FLUSH_ALL_SA);
                     break;
                 case PID_KEY_VERIFICATION:
 #ifdef PDU_DEBUG
@@ -469,6 +491,7 @@ int32_t Crypto_PDU(uint8_t* ingest, TC_t* tc_frame)
                     printf(KGRN "Key Destroy\n" RESET);
 #endif
                     status = Crypto_Key_update(KEY_DESTROYED);
+                    Crypto_Flush_SA(CRYPTOGRAPHY_FLUSH_ALL_SA);
                     break;
                 case PID_KEY_INVENTORY:
 #ifdef PDU_DEBUG
@@ -489,49 +512,53 @@ int32_t Crypto_PDU(uint8_t* ingest, TC_t* tc_frame)
 #ifdef PDU_DEBUG
                     printf(KGRN "SA Create\n" RESET);
 #endif
-                    status = sa_if->sa_create();
+                    status = CRYPTO_SA_IF->sa_create();
                     break;
                 case PID_DELETE_SA:
 #ifdef PDU_DEBUG
                     printf(KGRN "SA Delete\n" RESET);
 #endif
-                    status = sa_if->sa_delete();
+                    status = CRYPTO_SA_IF->sa_delete();
+                    Crypto_Flush_SA(((uint8_t)sdls_frame.pdu.data[0] << 8) | (uint8_t)sdls_frame.pdu.data[1]);
                     break;
                 case PID_SET_ARSNW:
 #ifdef PDU_DEBUG
                     printf(KGRN "SA setARSNW\n" RESET);
 #endif
-                    status = sa_if->sa_setARSNW();
+                    status = CRYPTO_SA_IF->sa_setARSNW();
                     break;
                 case PID_REKEY_SA:
 #ifdef PDU_DEBUG
                     printf(KGRN "SA Rekey\n" RESET);
 #endif
-                    status = sa_if->sa_rekey();
+                    status = CRYPTO_SA_IF->sa_rekey();
+                    Crypto_Flush_SA(((uint8_t)sdls_frame.pdu.data[0] << 8) | (uint8_t)sdls_frame.pdu.data[1]);
                     break;
                 case PID_EXPIRE_SA:
 #ifdef PDU_DEBUG
                     printf(KGRN "SA Expire\n" RESET);
 #endif
-                    status = sa_if->sa_expire();
+                    status = CRYPTO_SA_IF->sa_expire();
+                    Crypto_Flush_SA(((uint8_t)sdls_frame.pdu.data[0] << 8) | (uint8_t)sdls_frame.pdu.data[1]);
                     break;
                 case PID_SET_ARSN:
 #ifdef PDU_DEBUG
                     printf(KGRN "SA SetARSN\n" RESET);
 #endif
-                    status = sa_if->sa_setARSN();
+                    status = CRYPTO_SA_IF->sa_setARSN();
                     break;
                 case PID_START_SA:
 #ifdef PDU_DEBUG
                     printf(KGRN "SA Start\n" RESET);
 #endif
-                    status = sa_if->sa_start(tc_frame);
+                    status = CRYPTO_SA_IF->sa_start(tc_frame);
                     break;
                 case PID_STOP_SA:
 #ifdef PDU_DEBUG
                     printf(KGRN "SA Stop\n" RESET);
 #endif
-                    status = sa_if->sa_stop();
+                    status = CRYPTO_SA_IF->sa_stop();
+                    Crypto_Flush_SA(((uint8_t)sdls_frame.pdu.data[0] << 8) | (uint8_t)sdls_frame.pdu.data[1]);
                     break;
                 case PID_READ_ARSN:
 #ifdef PDU_DEBUG
@@ -543,7 +570,7 @@ int32_t Crypto_PDU(uint8_t* ingest, TC_t* tc_frame)
 #ifdef PDU_DEBUG
                     printf(KGRN "SA Status\n" RESET);
 #endif
-                    status = sa_if->sa_status(ingest);
+                    status = CRYPTO_SA_IF->sa_status(ingest);
                     break;
                 default:
                     printf(KRED "Error: Crypto_PDU failed interpreting SA Procedure Identification Field! \n" RESET);
@@ -685,11 +712,35 @@ int32_t Crypto_PDU(uint8_t* ingest, TC_t* tc_frame)
 }
 
 
+/**
+ * @brief Function: Crypto_Get_Managed_Parameters_For_Gvcid
+ * Copies the managed parameters for a GVCID out of managed_parameters_in.  Lookups against the configured table
+ * go through the hashed index; frame processing should prefer Crypto_Get_Managed_Parameters_Ptr_For_Gvcid,
+ * which avoids the copy.
+ * @param tfvn: uint8
+ * @param scid: uint16
+ * @param vcid: uint8
+ * @param managed_parameters_in: GvcidManagedParameters_t*
+ * @param managed_parameters_out: GvcidManagedParameters_t*
+ * @return int32: Success/Failure
+ **/
 int32_t Crypto_Get_Managed_Parameters_For_Gvcid(uint8_t tfvn, uint16_t scid, uint8_t vcid,
                                                 GvcidManagedParameters_t* managed_parameters_in,
                                                 GvcidManagedParameters_t* managed_parameters_out)
 {
     int32_t status = MANAGED_PARAMETERS_FOR_GVCID_NOT_FOUND;
+
+    if (managed_parameters_in == gvcid_managed_parameters_array)
+    {
+        const GvcidManagedParameters_t* found = NULL;
+        status = Crypto_Get_Managed_Parameters_Ptr_For_Gvcid(tfvn, scid, vcid, &found);
+        if (status == CRYPTO_LIB_SUCCESS)
+        {
+            *managed_parameters_out = *found;
+        }
+        return status;
+    }
+
     for(int i = 0; i < gvcid_counter; i++)
     {
         if (managed_parameters_in[i].tfvn == tfvn && managed_parameters_in[i].scid == scid &&
@@ -703,8 +754,8 @@ int32_t Crypto_Get_Managed_Parameters_For_Gvcid(uint8_t tfvn, uint16_t scid, uin
 
     if(status != CRYPTO_LIB_SUCCESS)
     {
-        printf(KRED "Error: Managed Parameters for GVCID(TFVN: %d, SCID: %d, VCID: %d) not found. \n" RESET, tfvn, scid,
-               vcid);
+        crypto_gvcid_t gvcid = {.tfvn = tfvn, .scid = scid, .vcid = vcid, .mapid = 0};
+        Crypto_MC_Event(status, MC_EVENT_SPI_NA, &gvcid, "Managed Parameters for GVCID not found");
     }
 
     return status;
@@ -940,7 +991,8 @@ int32_t Crypto_Check_Anti_Replay_ARSNW(SecurityAssociation_t* sa_ptr, uint8_t* a
 int32_t Crypto_Check_Anti_Replay_GCM(SecurityAssociation_t* sa_ptr, uint8_t* iv, int8_t* iv_valid)
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
-    if ((sa_ptr->iv_len > 0) && (sa_ptr->ecs == CRYPTO_CIPHER_AES256_GCM))
+    // ChaCha20-Poly1305 nonces are counters in the same way as GCM IVs
+    if ((sa_ptr->iv_len > 0) && (sa_ptr->ecs == CRYPTO_CIPHER_AES256_GCM || sa_ptr->ecs == CRYPTO_CIPHER_CHACHA20_POLY1305))
     {
         // Check IV is in ARSNW
         if(crypto_config.crypto_increment_nontransmitted_iv == SA_INCREMENT_NONTRANSMITTED_IV_TRUE)
@@ -980,6 +1032,34 @@ int32_t Crypto_Check_Anti_Replay_GCM(SecurityAssociation_t* sa_ptr, uint8_t* iv,
     return status;
 }
 
+/**
+ * @brief Function: Crypto_Precheck_Anti_Replay
+ * Read-only form of Crypto_Check_Anti_Replay: checks the ARSN and IV against the SA window without advancing the SA,
+ * so replayed frames can be dropped before the MAC is computed.  The SA is only advanced by Crypto_Check_Anti_Replay
+ * once the frame is authenticated.
+ * @param sa_ptr: SecurityAssociation_t*
+ * @param arsn: uint8_t*
+ * @param iv: uint8_t*
+ * @return int32: Success/Failure
+ **/
+int32_t Crypto_Precheck_Anti_Replay(SecurityAssociation_t* sa_ptr, uint8_t* arsn, uint8_t* iv)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    int8_t iv_valid = -1;
+    int8_t arsn_valid = -1;
+
+    status = Crypto_Check_Anti_Replay_Verify_Pointers(sa_ptr, arsn, iv);
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        status = Crypto_Check_Anti_Replay_ARSNW(sa_ptr, arsn, &arsn_valid);
+    }
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        status = Crypto_Check_Anti_Replay_GCM(sa_ptr, iv, &iv_valid);
+    }
+    return status;
+}
+
 /**
  * @brief Function: Crypto_Check_Anti_Replay
  * Verifies data within window.
@@ -1009,7 +1089,8 @@ int32_t Crypto_Check_Anti_Replay(SecurityAssociation_t* sa_ptr, uint8_t* arsn, u
     }
 
     // For GCM specifically, if have a valid IV...
-    if ((sa_ptr->ecs == CRYPTO_CIPHER_AES256_GCM || sa_ptr->ecs == CRYPTO_CIPHER_AES256_GCM_SIV) && (iv_valid == CRYPTO_TRUE))
+    if ((sa_ptr->ecs == CRYPTO_CIPHER_AES256_GCM || sa_ptr->ecs == CRYPTO_CIPHER_AES256_GCM_SIV ||
+         sa_ptr->ecs == CRYPTO_CIPHER_CHACHA20_POLY1305) && (iv_valid == CRYPTO_TRUE))
     {
         // Using ARSN? Need to be valid to increment both
         if (sa_ptr->arsn_len > 0 && arsn_valid == CRYPTO_TRUE)
@@ -1025,7 +1106,8 @@ int32_t Crypto_Check_Anti_Replay(SecurityAssociation_t* sa_ptr, uint8_t* arsn, u
     }
 
     // If not GCM, and ARSN is valid - can incrmeent it
-    if ((sa_ptr->ecs != CRYPTO_CIPHER_AES256_GCM && sa_ptr->ecs != CRYPTO_CIPHER_AES256_GCM_SIV) && arsn_valid == CRYPTO_TRUE)
+    if ((sa_ptr->ecs != CRYPTO_CIPHER_AES256_GCM && sa_ptr->ecs != CRYPTO_CIPHER_AES256_GCM_SIV &&
+         sa_ptr->ecs != CRYPTO_CIPHER_CHACHA20_POLY1305) && arsn_valid == CRYPTO_TRUE)
     {
         memcpy(sa_ptr->arsn, arsn, sa_ptr->arsn_len);
     }
@@ -1033,7 +1115,7 @@ int32_t Crypto_Check_Anti_Replay(SecurityAssociation_t* sa_ptr, uint8_t* arsn, u
     if(status != CRYPTO_LIB_SUCCESS)
     {
         // Log error if it happened
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
     }
 
     return status;
@@ -1062,6 +1144,9 @@ int32_t Crypto_Get_ECS_Algo_Keylen(uint8_t algo)
     case CRYPTO_CIPHER_AES256_CCM:
         retval = 32;
         break;
+    case CRYPTO_CIPHER_CHACHA20_POLY1305:
+        retval = 32;
+        break;
     default:
         break;
     }
@@ -1096,6 +1181,401 @@ int32_t Crypto_Get_ACS_Algo_Keylen(uint8_t algo)
     return retval;
 }
 
+/**
+ * @brief Function: Crypto_Flush_SA
+ * Has the cryptography module zeroize what it holds for an SA, cached keys and precomputed keystream, and drops its profile
+ * and any reserved counter blocks
+ * Called when an SA is rekeyed, stopped, expired or deleted, and for every SA on key management
+ * @param spi: uint16_t, CRYPTOGRAPHY_FLUSH_ALL_SA for every SA
+ * @return int32: Success/Failure
+ **/
+int32_t Crypto_Flush_SA(uint16_t spi)
+{
+    Crypto_SA_Profile_Flush(spi);
+    Crypto_SA_Counters_Flush(spi);
+    if ((cryptography_if == NULL) || (CRYPTO_CRYPTOGRAPHY_IF->cryptography_sa_flush == NULL))
+    {
+        return CRYPTO_LIB_SUCCESS;
+    }
+    return CRYPTO_CRYPTOGRAPHY_IF->cryptography_sa_flush(spi);
+}
+
+/**
+ * @brief Function: Crypto_Frame_Desc_Set_SA
+ * Completes a decoded frame descriptor with the security header, PDU, and trailer field locations of its SA
+ * The frame header portion must already be filled in by Crypto_TC/TM/AOS_Decode_Frame
+ * @param desc: crypto_frame_desc_t*
+ * @param sa_ptr: SecurityAssociation_t*
+ * @return int32: Success/Failure
+ **/
+int32_t Crypto_Frame_Desc_Set_SA(crypto_frame_desc_t* desc, SecurityAssociation_t* sa_ptr)
+{
+    uint32_t trailer_loc = 0;
+
+    if (desc == NULL)
+    {
+        return CRYPTO_LIB_ERR_NULL_BUFFER;
+    }
+    if (sa_ptr == NULL)
+    {
+        return CRYPTO_LIB_ERR_NULL_SA;
+    }
+
+    desc->iv_loc = desc->spi_loc + SPI_LEN;
+    desc->sn_loc = desc->iv_loc + sa_ptr->shivf_len;
+    if (desc->frame_type == TYPE_TC)
+    {
+        desc->pl_loc = desc->sn_loc + sa_ptr->shsnf_len;
+    }
+    else
+    {
+        // TM/AOS receive path has always stepped over the non-transmitted portion of the ARSN here
+        desc->pl_loc = desc->sn_loc + (sa_ptr->arsn_len - sa_ptr->shsnf_len);
+    }
+    desc->pdu_loc = desc->pl_loc + sa_ptr->shplf_len;
+
+    // Trailer is MAC, then OCF, then FECF; the PDU takes whatever is left in between
+    trailer_loc = (uint32_t)desc->pdu_loc + sa_ptr->stmacf_len + desc->ocf_len + desc->fecf_len;
+    if (trailer_loc > desc->frame_len)
+    {
+        return CRYPTO_LIB_ERR_INVALID_HEADER;
+    }
+    desc->pdu_len = desc->frame_len - trailer_loc;
+    desc->mac_loc = desc->pdu_loc + desc->pdu_len;
+    desc->ocf_loc = desc->mac_loc + sa_ptr->stmacf_len;
+    desc->fecf_loc = desc->ocf_loc + desc->ocf_len;
+    desc->sa_located = CRYPTO_TRUE;
+
+    return CRYPTO_LIB_SUCCESS;
+}
+
+/**
+ * @brief Function: crypto_frame_get_iv_arsn
+ * Full IV and ARSN of a received TM/AOS frame, non-transmitted leading bytes are taken from the SA
+ * @param sa_ptr: SecurityAssociation_t*
+ * @param p_ingest: uint8_t*
+ * @param desc: const crypto_frame_desc_t*
+ * @param iv: uint8_t*, IV_SIZE bytes
+ * @param arsn: uint8_t*, ARSN_SIZE bytes
+ * @return int32_t: Success/Failure
+ **/
+static int32_t crypto_frame_get_iv_arsn(SecurityAssociation_t* sa_ptr, uint8_t* p_ingest, const crypto_frame_desc_t* desc, uint8_t* iv, uint8_t* arsn)
+{
+    if ((sa_ptr->iv_len > IV_SIZE) || (sa_ptr->shivf_len > sa_ptr->iv_len) ||
+        (sa_ptr->arsn_len > ARSN_SIZE) || (sa_ptr->shsnf_len > sa_ptr->arsn_len))
+    {
+        return CRYPTO_LIB_ERR_INVALID_HEADER;
+    }
+
+    memcpy(iv, sa_ptr->iv, sa_ptr->iv_len - sa_ptr->shivf_len);
+    memcpy(iv + (sa_ptr->iv_len - sa_ptr->shivf_len), p_ingest + desc->iv_loc, sa_ptr->shivf_len);
+    memcpy(arsn, sa_ptr->arsn, sa_ptr->arsn_len - sa_ptr->shsnf_len);
+    memcpy(arsn + (sa_ptr->arsn_len - sa_ptr->shsnf_len), p_ingest + desc->sn_loc, sa_ptr->shsnf_len);
+    return CRYPTO_LIB_SUCCESS;
+}
+
+/**
+ * @brief Function: Crypto_Frame_Check_SA_State
+ * Rejects received TM/AOS frames under an SA that has been released, unless the SA state is configured to be ignored.
+ * TM and AOS SAs are not started through the TC EP procedures, so keyed and unkeyed SAs are still processed.
+ * @param sa_ptr: const SecurityAssociation_t*
+ * @return int32_t: Success/Failure
+ **/
+int32_t Crypto_Frame_Check_SA_State(const SecurityAssociation_t* sa_ptr)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+
+    if ((crypto_config.ignore_sa_state == TC_IGNORE_SA_STATE_FALSE) && (sa_ptr->sa_state == SA_NONE))
+    {
+        status = CRYPTO_LIB_ERR_SA_NOT_OPERATIONAL;
+        CRYPTO_MC_IF->mc_log(status);
+    }
+    return status;
+}
+
+/**
+ * @brief Function: Crypto_Frame_Precheck_IV_ARSN
+ * Checks the IV and ARSN carried in a received TM/AOS frame against the SA anti-replay window ahead of the MAC
+ * check, without advancing the SA.  Crypto_Frame_Check_IV_ARSN still has to run once the frame is authenticated.
+ * @param sa_ptr: SecurityAssociation_t*
+ * @param p_ingest: uint8_t*
+ * @param desc: const crypto_frame_desc_t*
+ * @return int32_t: Success/Failure
+ **/
+int32_t Crypto_Frame_Precheck_IV_ARSN(SecurityAssociation_t* sa_ptr, uint8_t* p_ingest, const crypto_frame_desc_t* desc)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    uint8_t iv[IV_SIZE];
+    uint8_t arsn[ARSN_SIZE];
+
+    if (crypto_config.ignore_anti_replay == TC_IGNORE_ANTI_REPLAY_TRUE)
+    {
+        return status;
+    }
+    status = crypto_frame_get_iv_arsn(sa_ptr, p_ingest, desc, iv, arsn);
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        status = Crypto_Precheck_Anti_Replay(sa_ptr, arsn, iv);
+    }
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        CRYPTO_MC_IF->mc_log(status);
+    }
+    return status;
+}
+
+/**
+ * @brief Function: Crypto_Frame_Check_IV_ARSN
+ * Checks the IV and ARSN carried in a verified TM/AOS frame against the SA anti-replay window and saves the
+ * advanced SA counters.  Non-transmitted leading bytes are taken from the SA.
+ * @param sa_ptr: SecurityAssociation_t*
+ * @param p_ingest: uint8_t*
+ * @param desc: const crypto_frame_desc_t*
+ * @return int32_t: Success/Failure
+ **/
+int32_t Crypto_Frame_Check_IV_ARSN(SecurityAssociation_t* sa_ptr, uint8_t* p_ingest, const crypto_frame_desc_t* desc)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    uint8_t iv[IV_SIZE];
+    uint8_t arsn[ARSN_SIZE];
+
+    if (crypto_config.ignore_anti_replay == TC_IGNORE_ANTI_REPLAY_TRUE)
+    {
+        return status;
+    }
+    status = crypto_frame_get_iv_arsn(sa_ptr, p_ingest, desc, iv, arsn);
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        CRYPTO_MC_IF->mc_log(status);
+        return status;
+    }
+
+    status = Crypto_Check_Anti_Replay(sa_ptr, arsn, iv);
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        CRYPTO_MC_IF->mc_log(status);
+    }
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        status = CRYPTO_SA_IF->sa_save_sa(sa_ptr);
+        if (status != CRYPTO_LIB_SUCCESS)
+        {
+            CRYPTO_MC_IF->mc_log(status);
+        }
+    }
+    return status;
+}
+
+/**
+ * @brief Function: Crypto_GCM_Fix_AAD_Tag
+ * Turns a GCM tag computed with the ciphertext fed as AAD into the real tag.  A module that runs A, zero padding to a
+ * block and then C all through the AAD path gets GHASH over the right blocks but with the length block
+ * [len(A')+len(C)]||[0] in place of [len(A)]||[len(C)].  The two tags differ by (Lw ^ Lr) * H, which is added here.
+ * The multiply is branch free on H, only the public lengths select the terms.
+ * @param tag: uint8_t*, full 16 byte tag from the AAD only pass, corrected in place
+ * @param h: const uint8_t*, the hash subkey E(K, 0^128)
+ * @param aad_len: uint32_t
+ * @param data_len: size_t
+ **/
+void Crypto_GCM_Fix_AAD_Tag(uint8_t* tag, const uint8_t* h, uint32_t aad_len, size_t data_len)
+{
+    uint64_t fed_bits = ((((uint64_t)aad_len + 15) & ~(uint64_t)15) + data_len) * 8;
+    uint64_t xh = fed_bits ^ ((uint64_t)aad_len * 8);
+    uint64_t xl = (uint64_t)data_len * 8;
+    uint64_t vh = 0;
+    uint64_t vl = 0;
+    uint64_t zh = 0;
+    uint64_t zl = 0;
+    uint64_t mask;
+    int i;
+
+    for (i = 0; i < 8; i++)
+    {
+        vh = (vh << 8) | h[i];
+        vl = (vl << 8) | h[i + 8];
+    }
+    // GCM bit reflected multiply, most significant multiplier bit first
+    for (i = 0; i < 128; i++)
+    {
+        mask = (uint64_t)0 - (((i < 64) ? (xh >> (63 - i)) : (xl >> (127 - i))) & 1);
+        zh ^= vh & mask;
+        zl ^= vl & mask;
+        mask = (uint64_t)0 - (vl & 1);
+        vl = (vl >> 1) | (vh << 63);
+        vh = (vh >> 1) ^ (0xe100000000000000ULL & mask);
+    }
+    for (i = 0; i < 8; i++)
+    {
+        tag[i] ^= (uint8_t)(zh >> (56 - 8 * i));
+        tag[i + 8] ^= (uint8_t)(zl >> (56 - 8 * i));
+    }
+}
+
+/**
+ * @brief Function: Crypto_GCM_Check_AAD_Tag
+ * Corrects a tag from the AAD only pass (see Crypto_GCM_Fix_AAD_Tag) and compares its first mac_size bytes with mac
+ * in constant time
+ * @param calc_tag: uint8_t*, full 16 byte tag from the AAD only pass, corrected in place
+ * @param h: const uint8_t*, the hash subkey E(K, 0^128)
+ * @param aad_len: uint32_t
+ * @param data_len: size_t
+ * @param mac: const uint8_t*
+ * @param mac_size: uint32_t
+ * @return int32: Success/Failure
+ **/
+int32_t Crypto_GCM_Check_AAD_Tag(uint8_t* calc_tag, const uint8_t* h, uint32_t aad_len, size_t data_len,
+                                 const uint8_t* mac, uint32_t mac_size)
+{
+    uint8_t diff = 0;
+    uint32_t i;
+
+    if ((mac_size == 0) || (mac_size > CRYPTO_GCM_BLOCK_SIZE))
+    {
+        return CRYPTO_LIB_ERR_MAC_VALIDATION_ERROR;
+    }
+    Crypto_GCM_Fix_AAD_Tag(calc_tag, h, aad_len, data_len);
+    for (i = 0; i < mac_size; i++)
+    {
+        diff |= (uint8_t)(calc_tag[i] ^ mac[i]);
+    }
+    return (diff == 0) ? CRYPTO_LIB_SUCCESS : CRYPTO_LIB_ERR_MAC_VALIDATION_ERROR;
+}
+
+/**
+ * @brief Function: Crypto_Frame_Verify_Auth
+ * Checks the MAC/tag of a received TM/AOS frame without touching the frame or returning plaintext.  GMAC and the MAC
+ * validate path only read the frame (zero length pass through).  Authenticated encryption tags are checked over the
+ * ciphertext with the module's optional cryptography_aead_verify, which skips the CTR pass for AES-GCM.  Modules
+ * without it, and suites it does not cover, decrypt the data field into a scratch arena buffer that is wiped
+ * afterwards and cost as much as ProcessSecurity.  Frames without authentication pass.
+ * @param sa_service_type: uint8_t
+ * @param ecs_is_aead_algorithm: uint8_t
+ * @param sa_ptr: SecurityAssociation_t*
+ * @param p_ingest: uint8_t*
+ * @param desc: const crypto_frame_desc_t*
+ * @param ekp: crypto_key_t*
+ * @param akp: crypto_key_t*
+ * @param aad: uint8_t*
+ * @param aad_len: uint16_t
+ * @return int32_t: Success/Failure
+ **/
+int32_t Crypto_Frame_Verify_Auth(uint8_t sa_service_type, uint8_t ecs_is_aead_algorithm, SecurityAssociation_t* sa_ptr, uint8_t* p_ingest, const crypto_frame_desc_t* desc, crypto_key_t* ekp, crypto_key_t* akp, uint8_t* aad, uint16_t aad_len)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    uint8_t* scratch = NULL;
+
+    if ((sa_service_type != SA_AUTHENTICATION) && (sa_service_type != SA_AUTHENTICATED_ENCRYPTION))
+    {
+        return status;
+    }
+
+    if ((ecs_is_aead_algorithm == CRYPTO_TRUE) && (sa_service_type == SA_AUTHENTICATED_ENCRYPTION) &&
+        (CRYPTO_CRYPTOGRAPHY_IF->cryptography_aead_verify != NULL))
+    {
+        status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_aead_verify(p_ingest + desc->pdu_loc, // ciphertext input
+                                                            desc->pdu_len, // in data length
+                                                            &(ekp->value[0]), // Key
+                                                            Crypto_Get_ECS_Algo_Keylen(sa_ptr->ecs),
+                                                            sa_ptr, // SA for key reference
+                                                            p_ingest + desc->iv_loc, // IV
+                                                            sa_ptr->iv_len, // IV Length
+                                                            p_ingest + desc->mac_loc, // Frame Expected Tag
+                                                            sa_ptr->stmacf_len, // tag size
+                                                            aad, // additional authenticated data
+                                                            aad_len, // length of AAD
+                                                            &sa_ptr->ecs); // encryption cipher
+        if (status != CRYPTO_LIB_ERR_UNSUPPORTED_ECS)
+        {
+            if (status != CRYPTO_LIB_SUCCESS)
+            {
+                CRYPTO_MC_IF->mc_log(status);
+            }
+            return status;
+        }
+        // Not covered by the module's verify, fall through to decrypting
+        status = CRYPTO_LIB_SUCCESS;
+    }
+
+    if ((ecs_is_aead_algorithm == CRYPTO_TRUE) && (sa_service_type == SA_AUTHENTICATED_ENCRYPTION))
+    {
+        scratch = (uint8_t*)Crypto_Arena_Alloc(desc->pdu_len);
+        if (scratch == NULL)
+        {
+            status = CRYPTO_LIB_ERR_ARENA_EXHAUSTED;
+            CRYPTO_MC_IF->mc_log(status);
+            return status;
+        }
+        status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_aead_decrypt(scratch, // plaintext output, discarded
+                                                            desc->pdu_len, // length of data
+                                                            p_ingest + desc->pdu_loc, // ciphertext input
+                                                            desc->pdu_len, // in data length
+                                                            &(ekp->value[0]), // Key
+                                                            Crypto_Get_ECS_Algo_Keylen(sa_ptr->ecs),
+                                                            sa_ptr, // SA for key reference
+                                                            p_ingest + desc->iv_loc, // IV
+                                                            sa_ptr->iv_len, // IV Length
+                                                            p_ingest + desc->mac_loc, // Frame Expected Tag
+                                                            sa_ptr->stmacf_len, // tag size
+                                                            aad, // additional authenticated data
+                                                            aad_len, // length of AAD
+                                                            CRYPTO_TRUE, // Decryption Bool
+                                                            CRYPTO_TRUE, // Authentication Bool
+                                                            CRYPTO_TRUE, // AAD Bool
+                                                            &sa_ptr->ecs, // encryption cipher
+                                                            &sa_ptr->acs,  // authentication cipher
+                                                            NULL);
+        memset(scratch, 0, desc->pdu_len);
+    }
+    else if (ecs_is_aead_algorithm == CRYPTO_TRUE)
+    {
+        // GMAC, the tag only covers the AAD so no data is passed through
+        status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_aead_decrypt(p_ingest + desc->pdu_loc, // unused
+                                                            0, // length of data
+                                                            p_ingest + desc->pdu_loc, // unused
+                                                            0, // in data length
+                                                            &(ekp->value[0]), // Key
+                                                            Crypto_Get_ECS_Algo_Keylen(sa_ptr->ecs),
+                                                            sa_ptr, // SA for key reference
+                                                            p_ingest + desc->iv_loc, // IV
+                                                            sa_ptr->iv_len, // IV Length
+                                                            p_ingest + desc->mac_loc, // Frame Expected Tag
+                                                            sa_ptr->stmacf_len, // tag size
+                                                            aad, // additional authenticated data
+                                                            aad_len, // length of AAD
+                                                            CRYPTO_FALSE, // Decryption Bool
+                                                            CRYPTO_TRUE, // Authentication Bool
+                                                            CRYPTO_TRUE, // AAD Bool
+                                                            &sa_ptr->ecs, // encryption cipher
+                                                            &sa_ptr->acs,  // authentication cipher
+                                                            NULL);
+    }
+    else
+    {
+        status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_validate_authentication(p_ingest + desc->pdu_loc, // unused
+                                            0, // no pass through copy
+                                            p_ingest + desc->pdu_loc, // ciphertext input
+                                            desc->pdu_len, // in data length
+                                            &(akp->value[0]), // Key
+                                            Crypto_Get_ACS_Algo_Keylen(sa_ptr->acs),
+                                            sa_ptr, // SA for key reference
+                                            p_ingest + desc->iv_loc, // IV
+                                            sa_ptr->iv_len, // IV Length
+                                            p_ingest + desc->mac_loc, // Frame Expected Tag
+                                            sa_ptr->stmacf_len, // tag size
+                                            aad, // additional authenticated data
+                                            aad_len, // length of AAD
+                                            CRYPTO_CIPHER_NONE, // encryption cipher
+                                            sa_ptr->acs, // authentication cipher
+                                            NULL); // cam cookies
+    }
+
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        CRYPTO_MC_IF->mc_log(status);
+    }
+    return status;
+}
+
 /**
 * @brief: Function: Crypto_Get_Security_Header_Length
 * Return Security Header Length
@@ -23,6 +23,28 @@
 
 #include <string.h> // memcpy/memset
 
+/*
+** AOS Process Context
+** Per-frame state handed from the ProcessSecurity setup stage to decryption or verification
+*/
+typedef struct
+{
+    crypto_frame_desc_t desc;
+    SecurityAssociation_t* sa_ptr;
+    crypto_key_t* ekp;
+    crypto_key_t* akp;
+    uint8_t sa_service_type;
+    uint8_t ecs_is_aead_algorithm;
+    uint8_t idle_policy; // IDLE_FRAMES_PROCESS unless the frame is idle fill
+    uint16_t aad_len;
+    uint8_t aad[1786];
+} crypto_aos_process_ctx_t;
+
+/* Helper functions */
+static int32_t crypto_aos_apply_security(uint8_t* pTfBuffer);
+static int32_t crypto_aos_process_security(uint8_t* p_ingest, uint16_t len_ingest, uint8_t** pp_processed_frame, uint16_t* p_decrypted_length, crypto_aos_process_ctx_t* ctx);
+static int32_t crypto_aos_process_prepare(uint8_t* p_ingest, uint16_t len_ingest, uint8_t verify_only, crypto_aos_process_ctx_t* ctx);
+
 /**
  * @brief Function: Crypto_AOS_ApplySecurity
  * @param ingest: uint8_t*
@@ -42,6 +64,20 @@
  * Security Header
    **/
 int32_t Crypto_AOS_ApplySecurity(uint8_t* pTfBuffer)
+{
+    int32_t status;
+
+    Crypto_Arena_Enter();
+    status = crypto_aos_apply_security(pTfBuffer);
+    Crypto_Arena_Leave();
+    return status;
+}
+
+/**
+ * @brief Function: crypto_aos_apply_security
+ * ApplySecurity body, runs inside the scratch arena scope opened by Crypto_AOS_ApplySecurity
+ **/
+static int32_t crypto_aos_apply_security(uint8_t* pTfBuffer)
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
     int mac_loc = 0;
@@ -56,6 +92,7 @@ int32_t Crypto_AOS_ApplySecurity(uint8_t* pTfBuffer)
     uint16_t new_fecf = 0x0000;
     uint8_t ecs_is_aead_algorithm;
     SecurityAssociation_t* sa_ptr = NULL;
+    crypto_sa_counters_t counters;
     uint8_t tfvn = 0;
     uint16_t scid = 0; 
     uint16_t vcid = 0;
@@ -68,8 +105,8 @@ int32_t Crypto_AOS_ApplySecurity(uint8_t* pTfBuffer)
 
     if ((crypto_config.init_status == UNITIALIZED) || (mc_if == NULL) || (sa_if == NULL))
     {
-        printf(KRED "ERROR: CryptoLib Configuration Not Set! -- CRYPTO_LIB_ERR_NO_CONFIG, Will Exit\n" RESET);
         status = CRYPTO_LIB_ERR_NO_CONFIG;
+        Crypto_MC_Event(status, MC_EVENT_SPI_NA, NULL, "CryptoLib Configuration Not Set");
         // Can't mc_log since it's not configured
         return status;  // return immediately so a NULL crypto_config is not dereferenced later
     }
@@ -93,7 +130,7 @@ int32_t Crypto_AOS_ApplySecurity(uint8_t* pTfBuffer)
     printf("\n");
 #endif
 
-    status = sa_if->sa_get_operational_sa_from_gvcid(tfvn, scid, vcid, 0, &sa_ptr);
+    status = CRYPTO_SA_IF->sa_get_operational_sa_from_gvcid(tfvn, scid, vcid, 0, &sa_ptr);
 
     // No operational/valid SA found
     if (status != CRYPTO_LIB_SUCCESS)
@@ -101,11 +138,11 @@ int32_t Crypto_AOS_ApplySecurity(uint8_t* pTfBuffer)
 #ifdef AOS_DEBUG
         printf(KRED "Error: Could not retrieve an SA!\n" RESET);
 #endif
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
         return status;
     }
 
-    status = Crypto_Get_Managed_Parameters_For_Gvcid(tfvn, scid, vcid, gvcid_managed_parameters_array, &current_managed_parameters_struct);
+    status = Crypto_Get_Managed_Parameters_Ptr_For_Gvcid(tfvn, scid, vcid, &current_managed_parameters);
 
     // No managed parameters found
     if (status != CRYPTO_LIB_SUCCESS)
@@ -113,13 +150,13 @@ int32_t Crypto_AOS_ApplySecurity(uint8_t* pTfBuffer)
 #ifdef AOS_DEBUG
         printf(KRED "Error: No managed parameters found!\n" RESET);
 #endif
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
         return status;
     }
 
 #ifdef AOS_DEBUG
     printf(KYEL "AOS BEFORE Apply Sec:\n\t" RESET);
-    for (int16_t i =0; i < current_managed_parameters_struct.max_frame_size; i++)
+    for (int16_t i =0; i < current_managed_parameters->max_frame_size; i++)
     {
         printf("%02X", pTfBuffer[i]);
     }
@@ -152,9 +189,9 @@ int32_t Crypto_AOS_ApplySecurity(uint8_t* pTfBuffer)
     {
         // Probably unnecessary check
         // Leaving for now as it would be cleaner in SA to have an association enum returned I believe
-        printf(KRED "Error: SA Service Type is not defined! \n" RESET);
         status = CRYPTO_LIB_ERROR;
-        mc_if->mc_log(status);
+        Crypto_MC_Event(status, sa_ptr->spi, NULL, "SA Service Type is not defined");
+        CRYPTO_MC_IF->mc_log(status);
         return status;
     }
 
@@ -186,15 +223,15 @@ int32_t Crypto_AOS_ApplySecurity(uint8_t* pTfBuffer)
     idx = 6;
 
     // Detect if optional 2 byte FHEC is present
-    if(current_managed_parameters_struct.aos_has_fhec == AOS_HAS_FHEC)
+    if(current_managed_parameters->aos_has_fhec == AOS_HAS_FHEC)
     {
         idx += 2;
     }
 
     // Detect if optional variable length Insert Zone is present
-    if(current_managed_parameters_struct.aos_has_iz == AOS_HAS_IZ)
+    if(current_managed_parameters->aos_has_iz == AOS_HAS_IZ)
     {
-        idx += current_managed_parameters_struct.aos_iz_len;
+        idx += current_managed_parameters->aos_iz_len;
     }
 
     // Idx is now at SPI location
@@ -236,7 +273,7 @@ int32_t Crypto_AOS_ApplySecurity(uint8_t* pTfBuffer)
         printf(KRED "\tsa_ptr->ecs_len is: %d\n", sa_ptr->ecs_len);
         printf(KRED "\tsa_ptr->acs_len is: %d\n", sa_ptr->acs_len);
 #endif
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
         return status;
     }
 
@@ -248,16 +285,23 @@ int32_t Crypto_AOS_ApplySecurity(uint8_t* pTfBuffer)
                 sa_ptr->iv_len > 0 )
                 {
                     status = CRYPTO_LIB_ERR_IV_NOT_SUPPORTED_FOR_ACS_ALGO;
-                    mc_if->mc_log(status);
+                    CRYPTO_MC_IF->mc_log(status);
                     return status;
                 }
         }
     }
+    // Reserve this frame's IV and ARSN, the SA moves on past them right away
+    status = Crypto_SA_Counters_Reserve(sa_ptr, sa_service_type, &counters);
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        return status;
+    }
+
     // Start index from the transmitted portion
     for (i = sa_ptr->iv_len - sa_ptr->shivf_len; i < sa_ptr->iv_len; i++)
     {
-        // Copy in IV from SA
-        pTfBuffer[idx] = *(sa_ptr->iv + i);
+        // Copy in reserved IV
+        pTfBuffer[idx] = counters.iv[i];
         idx++;
     }
 
@@ -270,8 +314,8 @@ int32_t Crypto_AOS_ApplySecurity(uint8_t* pTfBuffer)
      **/
     for (i = sa_ptr->arsn_len - sa_ptr->shsnf_len; i < sa_ptr->arsn_len; i++)
     {
-        // Copy in ARSN from SA
-        pTfBuffer[idx] = *(sa_ptr->arsn + i);
+        // Copy in reserved ARSN, a field longer than the ARSN still takes the SA bytes ahead of it
+        pTfBuffer[idx] = (i < 0) ? *(sa_ptr->arsn + i) : counters.arsn[i];
         idx++;
     }
 
@@ -328,13 +372,13 @@ int32_t Crypto_AOS_ApplySecurity(uint8_t* pTfBuffer)
      **/
     data_loc = idx;
     // Calculate size of data to be encrypted
-    pdu_len = current_managed_parameters_struct.max_frame_size - idx - sa_ptr->stmacf_len;
+    pdu_len = current_managed_parameters->max_frame_size - idx - sa_ptr->stmacf_len;
     // Check other managed parameter flags, subtract their lengths from data field if present
-    if(current_managed_parameters_struct.has_ocf == AOS_HAS_OCF)
+    if(current_managed_parameters->has_ocf == AOS_HAS_OCF)
     {
         pdu_len -= 4;
     }
-    if(current_managed_parameters_struct.has_fecf == AOS_HAS_FECF)
+    if(current_managed_parameters->has_fecf == AOS_HAS_FECF)
     {
         pdu_len -= 2;
     }
@@ -343,34 +387,36 @@ int32_t Crypto_AOS_ApplySecurity(uint8_t* pTfBuffer)
     printf(KYEL "Data location starts at: %d\n" RESET, idx);
     printf(KYEL "Data size is: %d\n" RESET, pdu_len);
     printf(KYEL "Index at end of SPI is: %d\n", idx);
-    if(current_managed_parameters_struct.has_ocf == AOS_HAS_OCF)
+    if(current_managed_parameters->has_ocf == AOS_HAS_OCF)
     {
         // If OCF exists, comes immediately after MAC
         printf(KYEL "OCF Location is: %d" RESET, idx + pdu_len + sa_ptr->stmacf_len);
     }
-    if(current_managed_parameters_struct.has_fecf == AOS_HAS_FECF)
+    if(current_managed_parameters->has_fecf == AOS_HAS_FECF)
     {
         // If FECF exists, comes just before end of the frame
-        printf(KYEL "FECF Location is: %d\n" RESET, current_managed_parameters_struct.max_frame_size - 2);
+        printf(KYEL "FECF Location is: %d\n" RESET, current_managed_parameters->max_frame_size - 2);
     }
 #endif
 
     // Get Key
     crypto_key_t* ekp = NULL;
-    ekp = key_if->get_key(sa_ptr->ekid);
+    ekp = CRYPTO_KEY_IF->get_key(sa_ptr->ekid);
     if (ekp == NULL)
     {
         status = CRYPTO_LIB_ERR_KEY_ID_ERROR;
-        mc_if->mc_log(status);
+        Crypto_SA_Counters_Gap(sa_ptr->spi, sa_service_type != SA_PLAINTEXT);
+        CRYPTO_MC_IF->mc_log(status);
         return status;
     }
 
     crypto_key_t* akp = NULL;
-    akp = key_if->get_key(sa_ptr->akid);
+    akp = CRYPTO_KEY_IF->get_key(sa_ptr->akid);
     if (akp == NULL)
     {
         status = CRYPTO_LIB_ERR_KEY_ID_ERROR;
-        mc_if->mc_log(status);
+        Crypto_SA_Counters_Gap(sa_ptr->spi, sa_service_type != SA_PLAINTEXT);
+        CRYPTO_MC_IF->mc_log(status);
         return status;
     }
 
@@ -402,8 +448,9 @@ int32_t Crypto_AOS_ApplySecurity(uint8_t* pTfBuffer)
             if (sa_ptr->abm_len < aad_len)
             {
                 status = CRYPTO_LIB_ERR_ABM_TOO_SHORT_FOR_AAD;
-                printf(KRED "Error: abm_len of %d < aad_len of %d\n" RESET, sa_ptr->abm_len, aad_len);
-                mc_if->mc_log(status);
+                Crypto_MC_Event(status, sa_ptr->spi, NULL, "abm_len of %d < aad_len of %d", sa_ptr->abm_len, aad_len);
+                Crypto_SA_Counters_Gap(sa_ptr->spi, 1);
+                CRYPTO_MC_IF->mc_log(status);
                 return status;
             }
             status = Crypto_Prepare_AOS_AAD(&pTfBuffer[0], aad_len, sa_ptr->abm, &aad[0]);
@@ -415,7 +462,7 @@ int32_t Crypto_AOS_ApplySecurity(uint8_t* pTfBuffer)
     {
         if(sa_service_type == SA_ENCRYPTION)
         {
-            status = cryptography_if->cryptography_encrypt(//Stub out data in/out as this is done in place and want to save cycles
+            status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_encrypt(//Stub out data in/out as this is done in place and want to save cycles
                                                         (uint8_t*)(&pTfBuffer[data_loc]), // ciphertext output
                                                         (size_t) pdu_len, // length of data
                                                         (uint8_t*)(&pTfBuffer[data_loc]), // plaintext input
@@ -423,7 +470,7 @@ int32_t Crypto_AOS_ApplySecurity(uint8_t* pTfBuffer)
                                                         &(ekp->value[0]), // Key
                                                         Crypto_Get_ECS_Algo_Keylen(sa_ptr->ecs),
                                                         sa_ptr, // SA (for key reference)
-                                                        sa_ptr->iv, // IV
+                                                        counters.iv, // IV
                                                         sa_ptr->iv_len, // IV Length
                                                         &sa_ptr->ecs, // encryption cipher
                                                         pkcs_padding,  // authentication cipher
@@ -431,14 +478,14 @@ int32_t Crypto_AOS_ApplySecurity(uint8_t* pTfBuffer)
         } 
         if(sa_service_type == SA_AUTHENTICATED_ENCRYPTION)
         {
-            status = cryptography_if->cryptography_aead_encrypt((uint8_t*)(&pTfBuffer[data_loc]), // ciphertext output
+            status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_aead_encrypt((uint8_t*)(&pTfBuffer[data_loc]), // ciphertext output
                                                                 (size_t) pdu_len,  // length of data
                                                                 (uint8_t*)(&pTfBuffer[data_loc]), // plaintext input
                                                                 (size_t) pdu_len, // in data length
                                                                 &(ekp->value[0]), // Key
                                                                 Crypto_Get_ECS_Algo_Keylen(sa_ptr->ecs), // Length of key derived from sa_ptr key_ref
                                                                 sa_ptr, // SA (for key reference)
-                                                                sa_ptr->iv, // IV
+                                                                counters.iv, // IV
                                                                 sa_ptr->iv_len, // IV Length
                                                                 &pTfBuffer[mac_loc], // tag output
                                                                 sa_ptr->stmacf_len, // tag size
@@ -458,7 +505,7 @@ int32_t Crypto_AOS_ApplySecurity(uint8_t* pTfBuffer)
             // TODO - implement non-AEAD algorithm logic
             if(sa_service_type == SA_AUTHENTICATION)
             {
-                status = cryptography_if->cryptography_authenticate(//Stub out data in/out as this is done in place and want to save cycles
+                status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_authenticate(//Stub out data in/out as this is done in place and want to save cycles
                                                                     (uint8_t*)(&pTfBuffer[0]), // ciphertext output
                                                                     (size_t) 0, // length of data
                                                                     (uint8_t*)(&pTfBuffer[0]), // plaintext input
@@ -466,7 +513,7 @@ int32_t Crypto_AOS_ApplySecurity(uint8_t* pTfBuffer)
                                                                     &(akp->value[0]), // Key
                                                                     Crypto_Get_ACS_Algo_Keylen(sa_ptr->acs),
                                                                     sa_ptr, // SA (for key reference)
-                                                                    sa_ptr->iv, // IV
+                                                                    counters.iv, // IV
                                                                     sa_ptr->iv_len, // IV Length
                                                                     &pTfBuffer[mac_loc], // tag output
                                                                     sa_ptr->stmacf_len, // tag size
@@ -480,7 +527,7 @@ int32_t Crypto_AOS_ApplySecurity(uint8_t* pTfBuffer)
             {
                 if (sa_service_type == SA_ENCRYPTION)
                     {
-                        status = cryptography_if->cryptography_encrypt(//Stub out data in/out as this is done in place and want to save cycles
+                        status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_encrypt(//Stub out data in/out as this is done in place and want to save cycles
                                                                     (uint8_t*)(&pTfBuffer[data_loc]), // ciphertext output
                                                                     (size_t) pdu_len, // length of data
                                                                     (uint8_t*)(&pTfBuffer[data_loc]), // plaintext input
@@ -488,7 +535,7 @@ int32_t Crypto_AOS_ApplySecurity(uint8_t* pTfBuffer)
                                                                     &(ekp->value[0]), // Key
                                                                     Crypto_Get_ECS_Algo_Keylen(sa_ptr->ecs),
                                                                     sa_ptr, // SA (for key reference)
-                                                                    sa_ptr->iv, // IV
+                                                                    counters.iv, // IV
                                                                     sa_ptr->iv_len, // IV Length
                                                                     &sa_ptr->ecs, // encryption cipher
                                                                     pkcs_padding,  // authentication cipher
@@ -510,63 +557,10 @@ int32_t Crypto_AOS_ApplySecurity(uint8_t* pTfBuffer)
 
         if (status != CRYPTO_LIB_SUCCESS)
         {
+            Crypto_SA_Counters_Gap(sa_ptr->spi, sa_service_type != SA_PLAINTEXT);
             return status; // Cryptography IF call failed, return.
         }
 
-        if (sa_service_type != SA_PLAINTEXT)
-        {
-#ifdef INCREMENT
-            if (crypto_config.crypto_increment_nontransmitted_iv == SA_INCREMENT_NONTRANSMITTED_IV_TRUE)
-            {
-                if (sa_ptr->shivf_len > 0 && sa_ptr->iv_len != 0)
-                {
-                    Crypto_increment(sa_ptr->iv, sa_ptr->iv_len);
-                }
-            }
-            else // SA_INCREMENT_NONTRANSMITTED_IV_FALSE
-            {
-                // Only increment the transmitted portion
-                if (sa_ptr->shivf_len > 0 && sa_ptr->iv_len != 0)
-                {
-                    Crypto_increment(sa_ptr->iv + (sa_ptr->iv_len - sa_ptr->shivf_len), sa_ptr->shivf_len);
-                }
-            }
-            if (sa_ptr->shsnf_len > 0)
-            {
-                Crypto_increment(sa_ptr->arsn, sa_ptr->arsn_len);
-            }
-
-#ifdef SA_DEBUG
-            if (sa_ptr->iv_len > 0)
-            {
-                printf(KYEL "Next IV value is:\n\t");
-                for (i = 0; i < sa_ptr->iv_len; i++)
-                {
-                    printf("%02x", *(sa_ptr->iv + i));
-                }
-                printf("\n" RESET);
-                printf(KYEL "Next transmitted IV value is:\n\t");
-                for (i = sa_ptr->iv_len - sa_ptr->shivf_len; i < sa_ptr->iv_len; i++)
-                {
-                    printf("%02x", *(sa_ptr->iv + i));
-                }
-                printf("\n" RESET);
-            }
-            printf(KYEL "Next ARSN value is:\n\t");
-            for (i = 0; i < sa_ptr->arsn_len; i++)
-            {
-                printf("%02x", *(sa_ptr->arsn + i));
-            }
-            printf("\n" RESET);
-            printf(KYEL "Next transmitted ARSN value is:\n\t");
-            for (i = sa_ptr->arsn_len - sa_ptr->shsnf_len; i < sa_ptr->arsn_len; i++)
-            {
-                printf("%02x", *(sa_ptr->arsn + i));
-            }
-            printf("\n" RESET);
-#endif
-#endif
-        }
 
     // Move idx to mac location
     idx += pdu_len;
@@ -590,40 +584,40 @@ int32_t Crypto_AOS_ApplySecurity(uint8_t* pTfBuffer)
      **/
 
     // Only calculate & insert FECF if CryptoLib is configured to do so & gvcid includes FECF.
-    if (current_managed_parameters_struct.has_fecf == AOS_HAS_FECF)
+    if (current_managed_parameters->has_fecf == AOS_HAS_FECF)
     {
 #ifdef FECF_DEBUG
-        printf(KCYN "Calcing FECF over %d bytes\n" RESET, current_managed_parameters_struct.max_frame_size - 2);
+        printf(KCYN "Calcing FECF over %d bytes\n" RESET, current_managed_parameters->max_frame_size - 2);
 #endif
         if (crypto_config.crypto_create_fecf == CRYPTO_AOS_CREATE_FECF_TRUE)
         {
-            new_fecf = Crypto_Calc_FECF((uint8_t*)pTfBuffer, current_managed_parameters_struct.max_frame_size - 2);
-            pTfBuffer[current_managed_parameters_struct.max_frame_size - 2] = (uint8_t)((new_fecf & 0xFF00) >> 8);
-            pTfBuffer[current_managed_parameters_struct.max_frame_size - 1] = (uint8_t)(new_fecf & 0x00FF);
+            new_fecf = Crypto_Calc_FECF((uint8_t*)pTfBuffer, current_managed_parameters->max_frame_size - 2);
+            pTfBuffer[current_managed_parameters->max_frame_size - 2] = (uint8_t)((new_fecf & 0xFF00) >> 8);
+            pTfBuffer[current_managed_parameters->max_frame_size - 1] = (uint8_t)(new_fecf & 0x00FF);
         }
         else // CRYPTO_TC_CREATE_FECF_FALSE
         {
-            pTfBuffer[current_managed_parameters_struct.max_frame_size - 2] = (uint8_t)0x00;
-            pTfBuffer[current_managed_parameters_struct.max_frame_size - 1] = (uint8_t)0x00;
+            pTfBuffer[current_managed_parameters->max_frame_size - 2] = (uint8_t)0x00;
+            pTfBuffer[current_managed_parameters->max_frame_size - 1] = (uint8_t)0x00;
         }
         idx += 2;
     }
 
 #ifdef AOS_DEBUG
     printf(KYEL "Printing new AOS frame:\n\t");
-    for(int i = 0; i < current_managed_parameters_struct.max_frame_size; i++)
+    for(int i = 0; i < current_managed_parameters->max_frame_size; i++)
     {
         printf("%02X", pTfBuffer[i]);
     }
     printf("\n");
 #endif
 
-    status = sa_if->sa_save_sa(sa_ptr);
+    status = CRYPTO_SA_IF->sa_save_sa(sa_ptr);
 
 #ifdef DEBUG
     printf(KYEL "----- Crypto_AOS_ApplySecurity END -----\n" RESET);
 #endif
-    mc_if->mc_log(status);
+    CRYPTO_MC_IF->mc_log(status);
     return status;
 }
 
@@ -670,11 +664,11 @@ int32_t Crypto_AOS_ApplySecurity(uint8_t* pTfBuffer)
     // Payload Data Unit
     Crypto_AOS_updatePDU(ingest,*len_ingest);
     printf("LINE: %d\n",__LINE__);
-    if (sa_if->sa_get_from_spi(spi, &sa_ptr) != CRYPTO_LIB_SUCCESS)
+    if (CRYPTO_SA_IF->sa_get_from_spi(spi, &sa_ptr) != CRYPTO_LIB_SUCCESS)
     {
         // TODO - Error handling
         status = CRYPTO_LIB_ERROR;
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
         return status; // Error -- unable to get SA from SPI.
     }
     printf("LINE: %d\n",__LINE__);
@@ -805,7 +799,7 @@ int32_t Crypto_AOS_ApplySecurity(uint8_t* pTfBuffer)
         printf("\n");
 #endif
 
-        status = cryptography_if->cryptography_aead_encrypt(&(ingest[pdu_loc]), // ciphertext output
+        status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_aead_encrypt(&(ingest[pdu_loc]), // ciphertext output
                                                            (size_t)pdu_len,            // length of data
                                                            &(tempAOS[pdu_loc]), // plaintext input
                                                            (size_t)pdu_len,             // in data length
@@ -867,247 +861,158 @@ int32_t Crypto_AOS_ApplySecurity(uint8_t* pTfBuffer)
 #endif
 
    *len_ingest = count;
-    mc_if->mc_log(status);
+    CRYPTO_MC_IF->mc_log(status);
     return status;
 }  **/
 
 /**
- * @brief Function: Crypto_AOS_ProcessSecurity
- * @param ingest: uint8_t*
- * @param len_ingest: int*
+ * @brief Function: Crypto_AOS_Decode_Frame
+ * Decodes the AOS primary header, insert zone length, and SPI of a received frame in one pass
+ * Fills the frame descriptor used by the later processing stages and looks up the managed parameters for the frame GVCID
+ * @param p_ingest: uint8_t*
+ * @param desc: crypto_frame_desc_t*
  * @return int32: Success/Failure
    **/
-int32_t Crypto_AOS_ProcessSecurity(uint8_t* p_ingest, uint16_t len_ingest, uint8_t** pp_processed_frame, uint16_t* p_decrypted_length)
+int32_t Crypto_AOS_Decode_Frame(uint8_t* p_ingest, crypto_frame_desc_t* desc)
 {
-    // Local Variables
     int32_t status = CRYPTO_LIB_SUCCESS;
-    uint8_t aad[1786];
-    uint16_t aad_len = 0;
-    uint16_t byte_idx = 0;
-    uint8_t ecs_is_aead_algorithm;
-    uint32_t encryption_cipher = 0;
-    uint8_t iv_loc;
-    int mac_loc = 0;
-    uint16_t pdu_len = 1;
-    uint8_t* p_new_dec_frame = NULL;
-    SecurityAssociation_t* sa_ptr = NULL;
-    uint8_t sa_service_type = -1;
-    uint8_t spi = -1;
-
-    // Bit math to give concise access to values in the ingest
-    aos_frame_pri_hdr.tfvn = ((uint8_t)p_ingest[0] & 0xC0) >> 6;
-    aos_frame_pri_hdr.scid = (((uint16_t)p_ingest[0] & 0x3F) << 4) | (((uint16_t)p_ingest[1] & 0xF0) >> 4);
-    aos_frame_pri_hdr.vcid = ((uint8_t)p_ingest[1] & 0x0E) >> 1;
 
-#ifdef DEBUG
-    printf(KYEL "\n----- Crypto_AOS_ProcessSecurity START -----\n" RESET);
-#endif
+    memset(desc, 0, sizeof(crypto_frame_desc_t));
+    desc->frame_type = TYPE_AOS;
 
-    if (len_ingest < 6) // Frame length doesn't even have enough bytes for header -- error out.
-    {
-        status = CRYPTO_LIB_ERR_INPUT_FRAME_TOO_SHORT_FOR_AOS_STANDARD;
-        mc_if->mc_log(status);
-        return status;
-    }
+    // Bit math to give concise access to values in the ingest
+    desc->tfvn = ((uint8_t)p_ingest[0] & 0xC0) >> 6;
+    desc->scid = (((uint16_t)p_ingest[0] & 0x3F) << 4) | (((uint16_t)p_ingest[1] & 0xF0) >> 4);
+    desc->vcid = ((uint8_t)p_ingest[1] & 0x0E) >> 1;
 
-    if ((crypto_config.init_status == UNITIALIZED) || (mc_if == NULL) || (sa_if == NULL))
-    {
 #ifdef AOS_DEBUG
-        printf(KRED "ERROR: CryptoLib Configuration Not Set! -- CRYPTO_LIB_ERR_NO_CONFIG, Will Exit\n" RESET);
+    printf(KGRN "AOS Process Using following parameters:\n\t" RESET);
+    printf(KGRN "tvfn: %d\t scid: %d\t vcid: %d\n" RESET,  desc->tfvn, desc->scid, desc->vcid );
 #endif
-        status = CRYPTO_LIB_ERR_NO_CONFIG;
-        // Can't mc_log if it's not configured
-        if (mc_if != NULL)
-        {
-            mc_if->mc_log(status);
-        }
-        return status;
-    }
 
-    // Query SA DB for active SA / SDLS parameters
-    if (sa_if == NULL) // This should not happen, but tested here for safety
+    if (desc->tfvn != AOS_TFVN)
     {
-        printf(KRED "ERROR: SA DB Not initalized! -- CRYPTO_LIB_ERR_NO_INIT, Will Exit\n" RESET);
-        status = CRYPTO_LIB_ERR_NO_INIT;
+        status = CRYPTO_LIB_ERR_INVALID_TFVN;
+        CRYPTO_MC_IF->mc_log(status);
         return status;
     }
 
-#ifdef AOS_DEBUG
-    printf(KGRN "AOS Process Using following parameters:\n\t" RESET);
-    printf(KGRN "tvfn: %d\t scid: %d\t vcid: %d\n" RESET,  aos_frame_pri_hdr.tfvn, aos_frame_pri_hdr.scid, aos_frame_pri_hdr.vcid );
-#endif
-
     // Lookup-retrieve managed parameters for frame via gvcid:
-    status = Crypto_Get_Managed_Parameters_For_Gvcid(
-        aos_frame_pri_hdr.tfvn, aos_frame_pri_hdr.scid, aos_frame_pri_hdr.vcid, 
-        gvcid_managed_parameters_array, &current_managed_parameters_struct);
-
+    status = Crypto_Get_Managed_Parameters_Ptr_For_Gvcid(desc->tfvn, desc->scid, desc->vcid, &current_managed_parameters);
     if (status != CRYPTO_LIB_SUCCESS)
     {
 #ifdef AOS_DEBUG
         printf(KRED "**NO LUCK WITH GVCID!\n" RESET);
 #endif
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
         return status;
     } // Unable to get necessary Managed Parameters for AOS TF -- return with error.
 
+    desc->frame_len = current_managed_parameters->max_frame_size;
+    desc->ocf_len = (current_managed_parameters->has_ocf == AOS_HAS_OCF) ? OCF_SIZE : 0;
+    desc->fecf_len = (current_managed_parameters->has_fecf == AOS_HAS_FECF) ? FECF_SIZE : 0;
+    // Idle fill is known from the virtual channel alone, the M_PDU first header pointer sits behind the security header
+    desc->idle = (Crypto_Get_Idle_Frames_For_Managed_Parameters(current_managed_parameters)->idle_vc == IDLE_VC_TRUE);
+
     // Increment to end of Primary Header start, depends on FHECF presence
-    byte_idx = 6;
-    if (current_managed_parameters_struct.aos_has_fhec == AOS_HAS_FHEC)
+    desc->spi_loc = 6;
+    if (current_managed_parameters->aos_has_fhec == AOS_HAS_FHEC)
     {
-        byte_idx = 8;
+        desc->spi_loc = 8;
     }
 
     // Determine if Insert Zone exists, increment past it if so
-    if (current_managed_parameters_struct.aos_has_iz)
+    if (current_managed_parameters->aos_has_iz == AOS_HAS_IZ)
     {
-        byte_idx += current_managed_parameters_struct.aos_iz_len;
+        desc->spi_loc += current_managed_parameters->aos_iz_len;
     }
 
     /**
      * Begin Security Header Fields
      * Reference CCSDS SDLP 3550b1 4.1.1.1.3
      **/
-    // Get SPI
-    spi = (uint8_t)p_ingest[byte_idx] << 8 | (uint8_t)p_ingest[byte_idx + 1];
-    // Move index to past the SPI
-    byte_idx += 2;
+    desc->spi = (uint16_t)p_ingest[desc->spi_loc] << 8 | (uint16_t)p_ingest[desc->spi_loc + 1];
 
-    status = sa_if->sa_get_from_spi(spi, &sa_ptr);
-    // If no valid SPI, return
-    if (status != CRYPTO_LIB_SUCCESS)
-    {
-        mc_if->mc_log(status);
-        return status;
-    }
+    return status;
+}
 
-#ifdef SA_DEBUG
-        printf(KYEL "DEBUG - Printing SA Entry for current frame.\n" RESET);
-        Crypto_saPrint(sa_ptr);
-#endif
-    // Determine SA Service Type
-    if ((sa_ptr->est == 0) && (sa_ptr->ast == 0))
-    {
-        sa_service_type = SA_PLAINTEXT;
-    }
-    else if ((sa_ptr->est == 0) && (sa_ptr->ast == 1))
-    {
-        sa_service_type = SA_AUTHENTICATION;
-    }
-    else if ((sa_ptr->est == 1) && (sa_ptr->ast == 0))
-    {
-        sa_service_type = SA_ENCRYPTION;
-    }
-    else if ((sa_ptr->est == 1) && (sa_ptr->ast == 1))
-    {
-        sa_service_type = SA_AUTHENTICATED_ENCRYPTION;
-    }
-    else
-    {
-        // Probably unnecessary check
-        // Leaving for now as it would be cleaner in SA to have an association enum returned I believe
-        printf(KRED "Error: SA Service Type is not defined! \n" RESET);
-        status = CRYPTO_LIB_ERROR;
-        mc_if->mc_log(status);
-        return status;
-    }
+/**
+ * @brief Function: Crypto_AOS_ProcessSecurity
+ * Idle frames the GVCID idle policy skips or only verifies return CRYPTO_LIB_ERR_IDLE_FRAME and no processed frame
+ * @param ingest: uint8_t*
+ * @param len_ingest: int*
+ * @return int32: Success/Failure
+   **/
+int32_t Crypto_AOS_ProcessSecurity(uint8_t* p_ingest, uint16_t len_ingest, uint8_t** pp_processed_frame, uint16_t* p_decrypted_length)
+{
+    int32_t status;
+    crypto_aos_process_ctx_t ctx;
 
-    // Determine Algorithm cipher & mode. // TODO - Parse authentication_cipher, and handle AEAD cases properly
-    if (sa_service_type != SA_PLAINTEXT)
-    {
-        if (sa_ptr->ecs != CRYPTO_CIPHER_NONE)
-        {
-            encryption_cipher = sa_ptr->ecs;
-#ifdef TC_DEBUG
-            printf(KYEL "SA Encryption Cipher: %d\n", encryption_cipher);
+    Crypto_Arena_Enter();
+    status = crypto_aos_process_security(p_ingest, len_ingest, pp_processed_frame, p_decrypted_length, &ctx);
+    Crypto_MC_Reject_Record(&ctx.desc, status);
+    Crypto_Arena_Leave();
+    return status;
+}
+
+/**
+ * @brief Function: crypto_aos_process_security
+ * ProcessSecurity body, runs inside the scratch arena scope opened by Crypto_AOS_ProcessSecurity
+ **/
+static int32_t crypto_aos_process_security(uint8_t* p_ingest, uint16_t len_ingest, uint8_t** pp_processed_frame, uint16_t* p_decrypted_length, crypto_aos_process_ctx_t* ctx)
+{
+    // Local Variables
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    uint8_t* aad;
+    uint16_t aad_len = 0;
+    uint16_t byte_idx = 0;
+    uint8_t ecs_is_aead_algorithm;
+    uint16_t pdu_len = 1;
+    uint8_t* p_new_dec_frame = NULL;
+    SecurityAssociation_t* sa_ptr = NULL;
+    uint8_t sa_service_type = -1;
+    crypto_key_t* ekp = NULL;
+    crypto_key_t* akp = NULL;
+    crypto_frame_desc_t desc;
+
+#ifdef DEBUG
+    printf(KYEL "\n----- Crypto_AOS_ProcessSecurity START -----\n" RESET);
 #endif
-        }
-        // If no pointer, must not be using ECS at all
-        else
-        {
-            encryption_cipher = CRYPTO_CIPHER_NONE;
-        }
-        ecs_is_aead_algorithm = Crypto_Is_AEAD_Algorithm(encryption_cipher);
-    }
 
-    if ( encryption_cipher == CRYPTO_CIPHER_NONE && sa_ptr->est == 1)
+    status = crypto_aos_process_prepare(p_ingest, len_ingest, CRYPTO_FALSE, ctx);
+    if (status != CRYPTO_LIB_SUCCESS)
     {
-        status = CRYPTO_LIB_ERR_NO_ECS_SET_FOR_ENCRYPTION_MODE;
-        mc_if->mc_log(status);
         return status;
     }
-
-#ifdef AOS_DEBUG
-    switch (sa_service_type)
-    {
-    case SA_PLAINTEXT:
-        printf(KBLU "Processing a AOS - CLEAR!\n" RESET);
-        break;
-    case SA_AUTHENTICATION:
-        printf(KBLU "Processing a AOS - AUTHENTICATED!\n" RESET);
-        break;
-    case SA_ENCRYPTION:
-        printf(KBLU "Processing a AOS - ENCRYPTED!\n" RESET);
-        break;
-    case SA_AUTHENTICATED_ENCRYPTION:
-        printf(KBLU "Processing a AOS - AUTHENTICATED ENCRYPTION!\n" RESET);
-        break;
-    }
-#endif
-
-    // Parse & Check FECF, if present, and update fecf length
-    if (current_managed_parameters_struct.has_fecf == AOS_HAS_FECF)
+    if (ctx->idle_policy == IDLE_FRAMES_VERIFY)
     {
-        uint16_t received_fecf = (((p_ingest[current_managed_parameters_struct.max_frame_size - 2] << 8) & 0xFF00) |
-                                                        (p_ingest[current_managed_parameters_struct.max_frame_size - 1] & 0x00FF));
-
-        if (crypto_config.crypto_check_fecf == AOS_CHECK_FECF_TRUE)
+        // Idle fill carries nothing worth decrypting, it only has to be authentic and in sequence
+        status = Crypto_Frame_Verify_Auth(ctx->sa_service_type, ctx->ecs_is_aead_algorithm, ctx->sa_ptr, p_ingest, &ctx->desc, ctx->ekp, ctx->akp, ctx->aad, ctx->aad_len);
+        if (status == CRYPTO_LIB_SUCCESS)
         {
-            // Calculate our own
-            uint16_t calculated_fecf = Crypto_Calc_FECF(p_ingest, len_ingest - 2);
-            // Compare FECFs
-            // Invalid FECF
-            if (received_fecf != calculated_fecf)
-            {
-#ifdef FECF_DEBUG
-                printf("Received FECF is 0x%04X\n", received_fecf);
-                printf("Calculated FECF is 0x%04X\n", calculated_fecf);
-                printf("FECF was Calced over %d bytes\n", len_ingest-2);
-#endif
-                status = CRYPTO_LIB_ERR_INVALID_FECF;
-                mc_if->mc_log(status);
-                return status;
-            }
-            // Valid FECF, zero out the field
-            else
-            {
-#ifdef FECF_DEBUG
-                printf(KYEL "FECF CALC MATCHES! - GOOD\n" RESET);
-#endif
-                ;
-            }
+            status = Crypto_Frame_Check_IV_ARSN(ctx->sa_ptr, p_ingest, &ctx->desc);
         }
+        return (status == CRYPTO_LIB_SUCCESS) ? CRYPTO_LIB_ERR_IDLE_FRAME : status;
     }
-    // Needs to be AOS_HAS_FECF (checked above, or AOS_NO_FECF)
-    else if (current_managed_parameters_struct.has_fecf != AOS_NO_FECF)
-    {
-#ifdef AOS_DEBUG
-        printf(KRED "AOS_Process Error...tfvn: %d scid: 0x%04X vcid: 0x%02X fecf_enum: %d\n" RESET, 
-            current_managed_parameters_struct.tfvn, current_managed_parameters_struct.scid, 
-            current_managed_parameters_struct.vcid, current_managed_parameters_struct.has_fecf);
-#endif
-        status = CRYPTO_LIB_ERR_TC_ENUM_USED_FOR_AOS_CONFIG;
-        mc_if->mc_log(status);
-        return status;
-    }
+    desc = ctx->desc;
+    sa_ptr = ctx->sa_ptr;
+    ekp = ctx->ekp;
+    akp = ctx->akp;
+    sa_service_type = ctx->sa_service_type;
+    ecs_is_aead_algorithm = ctx->ecs_is_aead_algorithm;
+    aad = ctx->aad;
+    aad_len = ctx->aad_len;
+
+    byte_idx = desc.pdu_loc;
+    pdu_len = desc.pdu_len;
 
     // Accio buffer
     p_new_dec_frame = (uint8_t*)calloc(1, (len_ingest) * sizeof(uint8_t));
     if (!p_new_dec_frame)
     {
-        printf(KRED "Error: Calloc for decrypted output buffer failed! \n" RESET);
         status = CRYPTO_LIB_ERROR;
-        mc_if->mc_log(status);
+        Crypto_MC_Event(status, sa_ptr->spi, NULL, "Calloc for decrypted output buffer failed");
+        CRYPTO_MC_IF->mc_log(status);
         return status;
     }
 
@@ -1115,12 +1020,12 @@ int32_t Crypto_AOS_ProcessSecurity(uint8_t* p_ingest, uint16_t len_ingest, uint8
     memcpy(p_new_dec_frame, &p_ingest[0], 6);
 
     // Copy over insert zone data, if it exists
-    if (current_managed_parameters_struct.aos_has_iz == AOS_HAS_IZ)
+    if (current_managed_parameters->aos_has_iz == AOS_HAS_IZ)
     {
-        memcpy(p_new_dec_frame+6, &p_ingest[6], current_managed_parameters_struct.aos_iz_len);
+        memcpy(p_new_dec_frame+6, &p_ingest[6], current_managed_parameters->aos_iz_len);
 #ifdef AOS_DEBUG
         printf("Copied over the following:\n\t");
-        for (int i=0; i < current_managed_parameters_struct.aos_iz_len;i++)
+        for (int i=0; i < current_managed_parameters->aos_iz_len;i++)
         {
             printf("%02X",p_ingest[6+i]);
         }
@@ -1128,17 +1033,6 @@ int32_t Crypto_AOS_ProcessSecurity(uint8_t* p_ingest, uint16_t len_ingest, uint8
 #endif
     }
 
-    // Byte_idx is still set to just past the SPI
-    // If IV is present, note location
-    if (sa_ptr->iv_len > 0)
-    {
-        iv_loc = byte_idx;
-    }
-    // Increment byte_idx past Security Header Fields based on SA values
-    byte_idx += sa_ptr->shivf_len;
-    byte_idx += (sa_ptr->arsn_len - sa_ptr->shsnf_len);
-    byte_idx += sa_ptr->shplf_len;
-
 #ifdef SA_DEBUG
     printf(KYEL "IV length of %d bytes\n" RESET, sa_ptr->shivf_len);
     printf(KYEL "ARSN length of %d bytes\n" RESET, sa_ptr->arsn_len - sa_ptr->shsnf_len);
@@ -1146,122 +1040,34 @@ int32_t Crypto_AOS_ProcessSecurity(uint8_t* p_ingest, uint16_t len_ingest, uint8
     printf(KYEL "First byte past Security Header is at index %d\n" RESET, byte_idx);
 #endif
 
-    /**
-     * End Security Header Fields
-     * byte_idx is now at start of pdu / encrypted data
-     **/
-
-    // Calculate size of the protocol data unit
-    // NOTE: This size itself is not the length for authentication 
-    pdu_len = current_managed_parameters_struct.max_frame_size - (byte_idx) - sa_ptr->stmacf_len;
-    if(current_managed_parameters_struct.has_ocf == AOS_HAS_OCF)
-    {
-        pdu_len -= 4;
-    }
-    if(current_managed_parameters_struct.has_fecf == AOS_HAS_FECF)
-    {
-        pdu_len -= 2;
-    }
-
-    // If MAC exists, comes immediately after pdu
-    if (sa_ptr->stmacf_len > 0)
-    {
-        mac_loc = byte_idx + pdu_len;
-    }
-
 #ifdef AOS_DEBUG
     printf(KYEL "Index / data location starts at: %d\n" RESET, byte_idx);
     printf(KYEL "Data size is: %d\n" RESET, pdu_len);
-    if(current_managed_parameters_struct.has_ocf == AOS_HAS_OCF)
+    if(desc.ocf_len > 0)
     {
         // If OCF exists, comes immediately after MAC
-        printf(KYEL "OCF Location is: %d" RESET, byte_idx + pdu_len + sa_ptr->stmacf_len);
+        printf(KYEL "OCF Location is: %d" RESET, desc.ocf_loc);
     }
-    if(current_managed_parameters_struct.has_fecf == AOS_HAS_FECF)
+    if(desc.fecf_len > 0)
     {
         // If FECF exists, comes just before end of the frame
-        printf(KYEL "FECF Location is: %d\n" RESET, current_managed_parameters_struct.max_frame_size - 2);
+        printf(KYEL "FECF Location is: %d\n" RESET, desc.fecf_loc);
     }
 #endif
 
-    // Get Key
-    crypto_key_t* ekp = NULL;
-    ekp = key_if->get_key(sa_ptr->ekid);
-    if (ekp == NULL)
-    {
-        status = CRYPTO_LIB_ERR_KEY_ID_ERROR;
-        mc_if->mc_log(status);
-        return status;
-    }
-
-    crypto_key_t* akp = NULL;
-    akp = key_if->get_key(sa_ptr->akid);
-    if (akp == NULL)
-    {
-        status = CRYPTO_LIB_ERR_KEY_ID_ERROR;
-        mc_if->mc_log(status);
-        return status;
-    }
-
-    /**
-     * Begin Authentication / Encryption
-     **/
-
-    // if(sa_service_type != SA_PLAINTEXT)
-    // {
-        // status = CRYPTO_LIB_ERR_NULL_CIPHERS;
-        // mc_if->mc_log(status);
-        // return status;
-    // }
-
-    // Parse MAC, prepare AAD
-    if ((sa_service_type == SA_AUTHENTICATION) || (sa_service_type == SA_AUTHENTICATED_ENCRYPTION))
-    {
-#ifdef MAC_DEBUG
-        printf("MAC Parsed from Frame:\n\t");
-        Crypto_hexprint(p_ingest+mac_loc,sa_ptr->stmacf_len);
-#endif
-        if (sa_service_type == SA_AUTHENTICATED_ENCRYPTION)
-        {
-            aad_len = byte_idx;
-        }
-        else
-        {
-            aad_len = mac_loc;
-        }
-        if (sa_ptr->abm_len < aad_len)
-        {
-            status = CRYPTO_LIB_ERR_ABM_TOO_SHORT_FOR_AAD;
-            mc_if->mc_log(status);
-            return status;
-        }
-        // Use ingest and abm to create aad
-        Crypto_Prepare_AOS_AAD(p_ingest, aad_len, sa_ptr->abm, &aad[0]);
-
-#ifdef MAC_DEBUG
-        printf("AAD Debug:\n\tAAD Length is %d\n\t AAD is: ", aad_len);
-        for (int i = 0; i<aad_len; i++)
-        {
-            printf("%02X", aad[i]);
-        }
-        printf("\n");
-#endif
-
-    }
-
     if(sa_service_type != SA_PLAINTEXT && ecs_is_aead_algorithm == CRYPTO_TRUE)
     {
 
         if(sa_service_type == SA_ENCRYPTION)
         {
-            status = cryptography_if->cryptography_decrypt(p_new_dec_frame+byte_idx, // plaintext output
+            status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_decrypt(p_new_dec_frame+byte_idx, // plaintext output
                                                         pdu_len,   // length of data
                                                         p_ingest+byte_idx, // ciphertext input
                                                         pdu_len,    // in data length
                                                         &(ekp->value[0]), // Key
                                                         Crypto_Get_ECS_Algo_Keylen(sa_ptr->ecs),
                                                         sa_ptr, // SA for key reference
-                                                        p_ingest+iv_loc, // IV
+                                                        p_ingest+desc.iv_loc, // IV
                                                         sa_ptr->iv_len, // IV Length
                                                         &sa_ptr->ecs, // encryption cipher
                                                         &sa_ptr->acs,  // authentication cipher
@@ -1269,16 +1075,16 @@ int32_t Crypto_AOS_ProcessSecurity(uint8_t* p_ingest, uint16_t len_ingest, uint8
         }
         if(sa_service_type == SA_AUTHENTICATED_ENCRYPTION)
         {
-            status = cryptography_if->cryptography_aead_decrypt(p_new_dec_frame+byte_idx, // plaintext output
+            status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_aead_decrypt(p_new_dec_frame+byte_idx, // plaintext output
                                                                 pdu_len, // length of data
                                                                 p_ingest+byte_idx, // ciphertext input
                                                                 pdu_len, // in data length
                                                                 &(ekp->value[0]), // Key
                                                                 Crypto_Get_ECS_Algo_Keylen(sa_ptr->ecs),
                                                                 sa_ptr, // SA for key reference
-                                                                p_ingest+iv_loc, // IV.
+                                                                p_ingest+desc.iv_loc, // IV.
                                                                 sa_ptr->iv_len, // IV Length
-                                                                p_ingest+mac_loc, // Frame Expected Tag
+                                                                p_ingest+desc.mac_loc, // Frame Expected Tag
                                                                 sa_ptr->stmacf_len, // tag size
                                                                 aad, // additional authenticated data
                                                                 aad_len, // length of AAD
@@ -1297,16 +1103,16 @@ int32_t Crypto_AOS_ProcessSecurity(uint8_t* p_ingest, uint16_t len_ingest, uint8
         // TODO - implement non-AEAD algorithm logic
         if(sa_service_type == SA_AUTHENTICATION || sa_service_type == SA_AUTHENTICATED_ENCRYPTION)
         {
-            status = cryptography_if->cryptography_validate_authentication(p_new_dec_frame+byte_idx, // plaintext output
+            status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_validate_authentication(p_new_dec_frame+byte_idx, // plaintext output
                                                 pdu_len, // length of data
                                                 p_ingest+byte_idx, // ciphertext input
                                                 pdu_len, // in data length
                                                 &(akp->value[0]), // Key
                                                 Crypto_Get_ACS_Algo_Keylen(sa_ptr->acs),
                                                 sa_ptr, // SA for key reference
-                                                p_ingest+iv_loc, // IV
+                                                p_ingest+desc.iv_loc, // IV
                                                 sa_ptr->iv_len, // IV Length
-                                                p_ingest+mac_loc, // Frame Expected Tag
+                                                p_ingest+desc.mac_loc, // Frame Expected Tag
                                                 sa_ptr->stmacf_len, // tag size
                                                 aad, // additional authenticated data
                                                 aad_len, // length of AAD
@@ -1322,18 +1128,18 @@ int32_t Crypto_AOS_ProcessSecurity(uint8_t* p_ingest, uint16_t len_ingest, uint8
             {
                 // free(aad); - non-heap object
                 status = CRYPTO_LIB_ERR_KEY_LENGTH_ERROR;
-                mc_if->mc_log(status);
+                CRYPTO_MC_IF->mc_log(status);
                 return status;
             }
 
-            status = cryptography_if->cryptography_decrypt(p_new_dec_frame+byte_idx, // plaintext output
+            status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_decrypt(p_new_dec_frame+byte_idx, // plaintext output
                                                         pdu_len,   // length of data
                                                         p_ingest+byte_idx, // ciphertext input
                                                         pdu_len,    // in data length
                                                         &(ekp->value[0]), // Key
                                                         Crypto_Get_ECS_Algo_Keylen(sa_ptr->ecs),
                                                         sa_ptr, // SA for key reference
-                                                        p_ingest+iv_loc, // IV
+                                                        p_ingest+desc.iv_loc, // IV
                                                         sa_ptr->iv_len, // IV Length
                                                         &sa_ptr->ecs, // encryption cipher
                                                         &sa_ptr->acs,  // authentication cipher
@@ -1362,12 +1168,12 @@ int32_t Crypto_AOS_ProcessSecurity(uint8_t* p_ingest, uint16_t len_ingest, uint8
 
 #ifdef AOS_DEBUG
     printf(KYEL "\nPrinting received frame:\n\t" RESET);
-    for( int i=0; i<current_managed_parameters_struct.max_frame_size; i++)
+    for( int i=0; i<desc.frame_len; i++)
     {
         printf(KYEL "%02X", p_ingest[i]);
     }
     printf(KYEL "\nPrinting PROCESSED frame:\n\t" RESET);
-        for( int i=0; i<current_managed_parameters_struct.max_frame_size; i++)
+        for( int i=0; i<desc.frame_len; i++)
     {
         printf(KYEL "%02X", p_new_dec_frame[i]);
     }
@@ -1376,15 +1182,342 @@ int32_t Crypto_AOS_ProcessSecurity(uint8_t* p_ingest, uint16_t len_ingest, uint8
 
     *pp_processed_frame = p_new_dec_frame;
     // TODO maybe not just return this without doing the math ourselves
-    *p_decrypted_length = current_managed_parameters_struct.max_frame_size;
+    *p_decrypted_length = desc.frame_len;
 
 #ifdef DEBUG
         printf(KYEL "----- Crypto_AOS_ProcessSecurity END -----\n" RESET);
 #endif
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
+        return status;
+    }
+
+/**
+ * @brief Function: Crypto_AOS_VerifySecurity
+ * Verify-only counterpart of Crypto_AOS_ProcessSecurity for relays that forward frames unchanged: SA lookup, a
+ * read-only anti-replay window check, FECF, MAC/tag check, then the anti-replay window update.  Accepted frames advance
+ * the SA IV/ARSN; no plaintext is returned.  AES-GCM tags are checked without decrypting when the module provides
+ * cryptography_aead_verify, other authenticated encryption SAs are decrypted to a scratch buffer (see
+ * Crypto_Frame_Verify_Auth).
+ * @param p_ingest: uint8_t*
+ * @param len_ingest: uint16_t
+ * @return int32: CRYPTO_LIB_SUCCESS to accept, otherwise the reject reason
+ **/
+int32_t Crypto_AOS_VerifySecurity(uint8_t* p_ingest, uint16_t len_ingest)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    crypto_aos_process_ctx_t ctx;
+
+    Crypto_Arena_Enter();
+    status = crypto_aos_process_prepare(p_ingest, len_ingest, CRYPTO_TRUE, &ctx);
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        status = Crypto_Frame_Verify_Auth(ctx.sa_service_type, ctx.ecs_is_aead_algorithm, ctx.sa_ptr, p_ingest, &ctx.desc, ctx.ekp, ctx.akp, ctx.aad, ctx.aad_len);
+    }
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        status = Crypto_Frame_Check_IV_ARSN(ctx.sa_ptr, p_ingest, &ctx.desc);
+    }
+    if ((status == CRYPTO_LIB_SUCCESS) && (ctx.idle_policy == IDLE_FRAMES_VERIFY))
+    {
+        status = CRYPTO_LIB_ERR_IDLE_FRAME;
+    }
+    Crypto_MC_Reject_Record(&ctx.desc, status);
+    Crypto_Arena_Leave();
+    return status;
+}
+
+/**
+ * @brief Function: crypto_aos_process_prepare
+ * Everything ProcessSecurity does ahead of decryption, cheapest check first: length, version and GVCID, rejection
+ * budget, SPI and SA state, anti-replay window (verify paths only, read-only), FECF, then keys and AAD.
+ * Idle frames the GVCID idle policy skips are rejected with CRYPTO_LIB_ERR_IDLE_FRAME before the SA lookup.
+ * @param p_ingest: uint8_t*
+ * @param len_ingest: uint16_t
+ * @param verify_only: uint8_t
+ * @param ctx: crypto_aos_process_ctx_t*
+ * @return int32_t: Success/Failure
+ **/
+static int32_t crypto_aos_process_prepare(uint8_t* p_ingest, uint16_t len_ingest, uint8_t verify_only, crypto_aos_process_ctx_t* ctx)
+{
+    // Local Variables
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    uint32_t encryption_cipher = 0;
+
+    ctx->sa_ptr = NULL;
+    ctx->ekp = NULL;
+    ctx->akp = NULL;
+    ctx->sa_service_type = -1;
+    ctx->ecs_is_aead_algorithm = CRYPTO_FALSE;
+    ctx->idle_policy = IDLE_FRAMES_PROCESS;
+    ctx->aad_len = 0;
+    ctx->desc.admitted = CRYPTO_FALSE;
+
+    if (len_ingest < 6) // Frame length doesn't even have enough bytes for header -- error out.
+    {
+        status = CRYPTO_LIB_ERR_INPUT_FRAME_TOO_SHORT_FOR_AOS_STANDARD;
+        CRYPTO_MC_IF->mc_log(status);
+        return status;
+    }
+
+    if ((crypto_config.init_status == UNITIALIZED) || (mc_if == NULL) || (sa_if == NULL))
+    {
+#ifdef AOS_DEBUG
+        printf(KRED "ERROR: CryptoLib Configuration Not Set! -- CRYPTO_LIB_ERR_NO_CONFIG, Will Exit\n" RESET);
+#endif
+        status = CRYPTO_LIB_ERR_NO_CONFIG;
+        // Can't mc_log if it's not configured
+        if (mc_if != NULL)
+        {
+            CRYPTO_MC_IF->mc_log(status);
+        }
+        return status;
+    }
+
+    // Query SA DB for active SA / SDLS parameters
+    if (sa_if == NULL) // This should not happen, but tested here for safety
+    {
+        status = CRYPTO_LIB_ERR_NO_INIT;
+        Crypto_MC_Event(status, MC_EVENT_SPI_NA, NULL, "SA DB Not initialized");
+        return status;
+    }
+
+    // Decode primary header, insert zone, and SPI once for all later stages
+    status = Crypto_AOS_Decode_Frame(p_ingest, &ctx->desc);
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        return status;
+    }
+    status = Crypto_MC_Reject_Admit(&ctx->desc);
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        return status;
+    }
+    if (ctx->desc.idle)
+    {
+        ctx->idle_policy = Crypto_Get_Idle_Frames_For_Managed_Parameters(current_managed_parameters)->idle_policy;
+        if (ctx->idle_policy == IDLE_FRAMES_SKIP)
+        {
+            return CRYPTO_LIB_ERR_IDLE_FRAME;
+        }
+    }
+
+    status = CRYPTO_SA_IF->sa_get_from_spi(ctx->desc.spi, &ctx->sa_ptr);
+    // If no valid SPI, return
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        CRYPTO_MC_IF->mc_log(status);
+        return status;
+    }
+    status = Crypto_Frame_Check_SA_State(ctx->sa_ptr);
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        return status;
+    }
+
+#ifdef SA_DEBUG
+        printf(KYEL "DEBUG - Printing SA Entry for current frame.\n" RESET);
+        Crypto_saPrint(ctx->sa_ptr);
+#endif
+    // Determine SA Service Type
+    if ((ctx->sa_ptr->est == 0) && (ctx->sa_ptr->ast == 0))
+    {
+        ctx->sa_service_type = SA_PLAINTEXT;
+    }
+    else if ((ctx->sa_ptr->est == 0) && (ctx->sa_ptr->ast == 1))
+    {
+        ctx->sa_service_type = SA_AUTHENTICATION;
+    }
+    else if ((ctx->sa_ptr->est == 1) && (ctx->sa_ptr->ast == 0))
+    {
+        ctx->sa_service_type = SA_ENCRYPTION;
+    }
+    else if ((ctx->sa_ptr->est == 1) && (ctx->sa_ptr->ast == 1))
+    {
+        ctx->sa_service_type = SA_AUTHENTICATED_ENCRYPTION;
+    }
+    else
+    {
+        // Probably unnecessary check
+        // Leaving for now as it would be cleaner in SA to have an association enum returned I believe
+        status = CRYPTO_LIB_ERROR;
+        Crypto_MC_Event(status, ctx->sa_ptr->spi, NULL, "SA Service Type is not defined");
+        CRYPTO_MC_IF->mc_log(status);
         return status;
     }
 
+    // Determine Algorithm cipher & mode. // TODO - Parse authentication_cipher, and handle AEAD cases properly
+    if (ctx->sa_service_type != SA_PLAINTEXT)
+    {
+        if (ctx->sa_ptr->ecs != CRYPTO_CIPHER_NONE)
+        {
+            encryption_cipher = ctx->sa_ptr->ecs;
+#ifdef TC_DEBUG
+            printf(KYEL "SA Encryption Cipher: %d\n", encryption_cipher);
+#endif
+        }
+        // If no pointer, must not be using ECS at all
+        else
+        {
+            encryption_cipher = CRYPTO_CIPHER_NONE;
+        }
+        ctx->ecs_is_aead_algorithm = Crypto_Is_AEAD_Algorithm(encryption_cipher);
+    }
+
+    if ( encryption_cipher == CRYPTO_CIPHER_NONE && ctx->sa_ptr->est == 1)
+    {
+        status = CRYPTO_LIB_ERR_NO_ECS_SET_FOR_ENCRYPTION_MODE;
+        CRYPTO_MC_IF->mc_log(status);
+        return status;
+    }
+
+    // Locate security header fields, PDU, MAC, OCF, and FECF for this SA
+    // NOTE: The PDU size itself is not the length for authentication 
+    status = Crypto_Frame_Desc_Set_SA(&ctx->desc, ctx->sa_ptr);
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        CRYPTO_MC_IF->mc_log(status);
+        return status;
+    }
+    // Paths that commit the anti-replay window drop stale IV/ARSN before spending a CRC on the frame
+    if (verify_only || (ctx->idle_policy == IDLE_FRAMES_VERIFY))
+    {
+        status = Crypto_Frame_Precheck_IV_ARSN(ctx->sa_ptr, p_ingest, &ctx->desc);
+        if (status != CRYPTO_LIB_SUCCESS)
+        {
+            return status;
+        }
+    }
+
+#ifdef AOS_DEBUG
+    switch (ctx->sa_service_type)
+    {
+    case SA_PLAINTEXT:
+        printf(KBLU "Processing a AOS - CLEAR!\n" RESET);
+        break;
+    case SA_AUTHENTICATION:
+        printf(KBLU "Processing a AOS - AUTHENTICATED!\n" RESET);
+        break;
+    case SA_ENCRYPTION:
+        printf(KBLU "Processing a AOS - ENCRYPTED!\n" RESET);
+        break;
+    case SA_AUTHENTICATED_ENCRYPTION:
+        printf(KBLU "Processing a AOS - AUTHENTICATED ENCRYPTION!\n" RESET);
+        break;
+    }
+#endif
+
+    // Parse & Check FECF, if present, and update fecf length
+    if (current_managed_parameters->has_fecf == AOS_HAS_FECF)
+    {
+        uint16_t received_fecf = (((p_ingest[ctx->desc.frame_len - 2] << 8) & 0xFF00) |
+                                                        (p_ingest[ctx->desc.frame_len - 1] & 0x00FF));
+
+        if (crypto_config.crypto_check_fecf == AOS_CHECK_FECF_TRUE)
+        {
+            // Calculate our own
+            uint16_t calculated_fecf = Crypto_Calc_FECF(p_ingest, len_ingest - 2);
+            // Compare FECFs
+            // Invalid FECF
+            if (received_fecf != calculated_fecf)
+            {
+#ifdef FECF_DEBUG
+                printf("Received FECF is 0x%04X\n", received_fecf);
+                printf("Calculated FECF is 0x%04X\n", calculated_fecf);
+                printf("FECF was Calced over %d bytes\n", len_ingest-2);
+#endif
+                status = CRYPTO_LIB_ERR_INVALID_FECF;
+                CRYPTO_MC_IF->mc_log(status);
+                return status;
+            }
+            // Valid FECF, zero out the field
+            else
+            {
+#ifdef FECF_DEBUG
+                printf(KYEL "FECF CALC MATCHES! - GOOD\n" RESET);
+#endif
+                ;
+            }
+        }
+    }
+    // Needs to be AOS_HAS_FECF (checked above, or AOS_NO_FECF)
+    else if (current_managed_parameters->has_fecf != AOS_NO_FECF)
+    {
+#ifdef AOS_DEBUG
+        printf(KRED "AOS_Process Error...tfvn: %d scid: 0x%04X vcid: 0x%02X fecf_enum: %d\n" RESET, 
+            current_managed_parameters->tfvn, current_managed_parameters->scid, 
+            current_managed_parameters->vcid, current_managed_parameters->has_fecf);
+#endif
+        status = CRYPTO_LIB_ERR_TC_ENUM_USED_FOR_AOS_CONFIG;
+        CRYPTO_MC_IF->mc_log(status);
+        return status;
+    }
+
+    // Get Key
+    ctx->ekp = CRYPTO_KEY_IF->get_key(ctx->sa_ptr->ekid);
+    if (ctx->ekp == NULL)
+    {
+        status = CRYPTO_LIB_ERR_KEY_ID_ERROR;
+        CRYPTO_MC_IF->mc_log(status);
+        return status;
+    }
+
+    ctx->akp = CRYPTO_KEY_IF->get_key(ctx->sa_ptr->akid);
+    if (ctx->akp == NULL)
+    {
+        status = CRYPTO_LIB_ERR_KEY_ID_ERROR;
+        CRYPTO_MC_IF->mc_log(status);
+        return status;
+    }
+
+    /**
+     * Begin Authentication / Encryption
+     **/
+
+    // if(ctx->sa_service_type != SA_PLAINTEXT)
+    // {
+        // status = CRYPTO_LIB_ERR_NULL_CIPHERS;
+        // CRYPTO_MC_IF->mc_log(status);
+        // return status;
+    // }
+
+    // Parse MAC, prepare AAD
+    if ((ctx->sa_service_type == SA_AUTHENTICATION) || (ctx->sa_service_type == SA_AUTHENTICATED_ENCRYPTION))
+    {
+#ifdef MAC_DEBUG
+        printf("MAC Parsed from Frame:\n\t");
+        Crypto_hexprint(p_ingest+ctx->desc.mac_loc,ctx->sa_ptr->stmacf_len);
+#endif
+        if (ctx->sa_service_type == SA_AUTHENTICATED_ENCRYPTION)
+        {
+            ctx->aad_len = ctx->desc.pdu_loc;
+        }
+        else
+        {
+            ctx->aad_len = ctx->desc.mac_loc;
+        }
+        if (ctx->sa_ptr->abm_len < ctx->aad_len)
+        {
+            status = CRYPTO_LIB_ERR_ABM_TOO_SHORT_FOR_AAD;
+            CRYPTO_MC_IF->mc_log(status);
+            return status;
+        }
+        // Use ingest and abm to create aad
+        Crypto_Prepare_AOS_AAD(p_ingest, ctx->aad_len, ctx->sa_ptr->abm, ctx->aad);
+
+#ifdef MAC_DEBUG
+        printf("AAD Debug:\n\tAAD Length is %d\n\t AAD is: ", ctx->aad_len);
+        for (int i = 0; i<ctx->aad_len; i++)
+        {
+            printf("%02X", ctx->aad[i]);
+        }
+        printf("\n");
+#endif
+
+    }
+
+    return status;
+}
+
 /**
  * @brief Function: Crypto_Get_aosLength
  * Returns the total length of the current aos_frame in BYTES!
@@ -1417,10 +1550,10 @@ void Crypto_AOS_updatePDU(uint8_t* ingest, int len_ingest)
     SecurityAssociation_t* sa_ptr;
 
     // Consider a helper function here, or elsewhere, to do all the 'math' in one spot as a global accessible list of variables
-    if (sa_if->sa_get_from_spi(tm_frame[0], &sa_ptr) != CRYPTO_LIB_SUCCESS) // modify
+    if (CRYPTO_SA_IF->sa_get_from_spi(tm_frame[0], &sa_ptr) != CRYPTO_LIB_SUCCESS) // modify
     {
         // TODO - Error handling
-        printf(KRED"Update PDU Error!\n");
+        Crypto_MC_Event(CRYPTO_LIB_ERR_SPI_INDEX_OOB, tm_frame[0], NULL, "Update PDU Error");
         return; // Error -- unable to get SA from SPI.
     }
     if ((sa_ptr->est == 1) && (sa_ptr->ast == 1))
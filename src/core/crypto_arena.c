@@ -0,0 +1,125 @@
+/* Copyright (C) 2009 - 2022 National Aeronautics and Space Administration.
+   All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any kind, either expressed, implied, or statutory,
+   including, but not limited to, any warranty that the software will conform to specifications, any implied warranties
+   of merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+   documentation will conform to the program, or any warranty that the software will be error free.
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+   consequential damages, arising out of, resulting from, or in any way connected with the software or its
+   documentation, whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained
+   from, or arose out of the results of, or use of, the software, documentation or services provided hereunder.
+
+   ITC Team
+   NASA IV&V
+   jstar-development-team@mail.nasa.gov
+*/
+
+/*
+** Includes
+*/
+#include "crypto.h"
+
+#include <string.h> // memset
+
+/*
+** Scratch Arena
+** Transient buffers that only live for one ApplySecurity/ProcessSecurity call are bumped out of a fixed
+** per-thread block instead of the heap.  The outermost call opens a scope and the whole block is released
+** when it returns, so nested top-level calls share the outer scope.
+*/
+#define CRYPTO_ARENA_ALIGN 8
+
+typedef struct
+{
+    uint8_t buffer[CRYPTO_ARENA_SIZE];
+    size_t used;
+    uint32_t depth;
+    crypto_arena_stats_t stats;
+} crypto_arena_t;
+
+static _Thread_local crypto_arena_t crypto_arena;
+
+/**
+ * @brief Function: Crypto_Arena_Enter
+ * Opens a scratch scope.  Memory left over from allocations made outside any scope is reclaimed when the
+ * outermost scope opens.
+ **/
+void Crypto_Arena_Enter(void)
+{
+    if (crypto_arena.depth == 0)
+    {
+        crypto_arena.used = 0;
+    }
+    crypto_arena.depth++;
+}
+
+/**
+ * @brief Function: Crypto_Arena_Leave
+ * Closes a scratch scope, releasing every arena allocation once the outermost scope closes
+ **/
+void Crypto_Arena_Leave(void)
+{
+    if (crypto_arena.depth > 0)
+    {
+        crypto_arena.depth--;
+    }
+    if (crypto_arena.depth == 0)
+    {
+        crypto_arena.used = 0;
+    }
+}
+
+/**
+ * @brief Function: Crypto_Arena_Alloc
+ * Zeroed scratch allocation valid until the enclosing top-level call returns.  Never freed by the caller.
+ * @param len: size_t
+ * @return void*: Allocation, NULL when the arena is exhausted
+ **/
+void* Crypto_Arena_Alloc(size_t len)
+{
+    size_t start = (crypto_arena.used + (CRYPTO_ARENA_ALIGN - 1)) & ~((size_t)CRYPTO_ARENA_ALIGN - 1);
+    void* ptr;
+
+    if ((start > CRYPTO_ARENA_SIZE) || (len > CRYPTO_ARENA_SIZE - start))
+    {
+        crypto_arena.stats.exhausted++;
+        return NULL;
+    }
+
+    ptr = &crypto_arena.buffer[start];
+    memset(ptr, 0, len);
+    crypto_arena.used = start + len;
+    crypto_arena.stats.allocations++;
+    if (crypto_arena.used > crypto_arena.stats.high_water)
+    {
+        crypto_arena.stats.high_water = crypto_arena.used;
+    }
+    return ptr;
+}
+
+/**
+ * @brief Function: Crypto_Arena_Get_Stats
+ * Usage counters of the calling thread's arena
+ * @param stats: crypto_arena_stats_t*
+ * @return int32: Success/Failure
+ **/
+int32_t Crypto_Arena_Get_Stats(crypto_arena_stats_t* stats)
+{
+    if (stats == NULL)
+    {
+        return CRYPTO_LIB_ERR_NULL_BUFFER;
+    }
+    *stats = crypto_arena.stats;
+    return CRYPTO_LIB_SUCCESS;
+}
+
+/**
+ * @brief Function: Crypto_Arena_Reset_Stats
+ * Clears the calling thread's arena counters
+ **/
+void Crypto_Arena_Reset_Stats(void)
+{
+    memset(&crypto_arena.stats, 0, sizeof(crypto_arena.stats));
+}
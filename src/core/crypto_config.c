@@ -37,13 +37,25 @@ CryptoConfig_t crypto_config;
 CryptographyKmcCryptoServiceConfig_t* cryptography_kmc_crypto_config = NULL;
 CamConfig_t* cam_config = NULL;
 
-GvcidManagedParameters_t gvcid_managed_parameters_array[GVCID_MAN_PARAM_SIZE];  
+GvcidManagedParameters_t* gvcid_managed_parameters_array = NULL;
 int gvcid_counter = 0;
+static int gvcid_capacity = 0;
 GvcidManagedParameters_t gvcid_null_struct = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
 GvcidManagedParameters_t current_managed_parameters_struct = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
 
+// Idle frame handling, one entry per gvcid_managed_parameters_array position
+static GvcidIdleFrames_t* gvcid_idle_frames_array = NULL;
+static const GvcidIdleFrames_t gvcid_idle_frames_default = {IDLE_VC_FALSE, IDLE_FRAMES_PROCESS};
+
+// Open addressed hash index over gvcid_managed_parameters_array, keyed by (tfvn, scid, vcid)
+// Each slot holds an array position, or -1 when empty
+static int32_t* gvcid_index = NULL;
+static uint32_t gvcid_index_mask = 0;
+static void crypto_gvcid_index_rebuild(void);
+
 GvcidManagedParameters_t* gvcid_managed_parameters = NULL;
-GvcidManagedParameters_t* current_managed_parameters = NULL;
+// Per thread, every apply/process call locates its own GVCID (see Threading in crypto.h)
+_Thread_local const GvcidManagedParameters_t* current_managed_parameters = &gvcid_null_struct;
 
 // Free all configuration structs
 int32_t crypto_free_config_structs(void);
@@ -182,7 +194,19 @@ int32_t Crypto_Init_With_Configs(CryptoConfig_t* crypto_config_p, GvcidManagedPa
         memcpy(&crypto_config, crypto_config_p, CRYPTO_CONFIG_SIZE);
         crypto_config.init_status = INITIALIZED;
     }
-    gvcid_managed_parameters_array[0] = *gvcid_managed_parameters_p;
+    if (gvcid_counter == 0)
+    {
+        status = Crypto_Config_Add_Gvcid_Managed_Parameters(*gvcid_managed_parameters_p);
+        if (status != CRYPTO_LIB_SUCCESS)
+        {
+            return status;
+        }
+    }
+    else
+    {
+        gvcid_managed_parameters_array[0] = *gvcid_managed_parameters_p;
+        crypto_gvcid_index_rebuild();
+    }
     sa_mariadb_config = sa_mariadb_config_p;
     cryptography_kmc_crypto_config = cryptography_kmc_crypto_config_p;
     status = Crypto_Init();
@@ -203,7 +227,7 @@ int32_t Crypto_Init(void)
         printf(KRED "ERROR: CryptoLib must be configured before intializing!\n" RESET);
         return status; // No configuration set -- return!
     }
-    if (gvcid_managed_parameters_array[0].set_flag == 0)
+    if (gvcid_counter == 0 || gvcid_managed_parameters_array[0].set_flag == 0)
     {
         status = CRYPTO_MANAGED_PARAM_CONFIGURATION_NOT_COMPLETE;
         printf(KRED "ERROR: CryptoLib  Managed Parameters must be configured before intializing!\n" RESET);
@@ -229,7 +253,11 @@ int32_t Crypto_Init(void)
             key_if = get_key_interface_kmc();
         }
     }
-    key_if->key_init();
+    // A snapshot restore fills the key ring itself once the interfaces are up
+    if (crypto_snapshot_restore == CRYPTO_FALSE)
+    {
+        key_if->key_init();
+    }
     // TODO: Check and return status on error
 
     /* MC Interface */
@@ -248,6 +276,8 @@ int32_t Crypto_Init(void)
         }
     }
     mc_if->mc_initialize();
+    Crypto_MC_Event_Reset();
+    Crypto_MC_Reject_Reset();
     // TODO: Check and return status on error
 
     /* SA Interface */
@@ -261,6 +291,10 @@ int32_t Crypto_Init(void)
         {
             sa_if = get_sa_interface_inmemory();
         }
+        else if (crypto_config.sa_type == SA_TYPE_SHM)
+        {
+            sa_if = get_sa_interface_shm();
+        }
         else if (crypto_config.sa_type == SA_TYPE_MARIADB)
         {
             if (sa_mariadb_config == NULL)
@@ -280,12 +314,28 @@ int32_t Crypto_Init(void)
 
     /* Crypto Interface */
     // Determine which cryptographic module is in use
-    cryptography_if = get_cryptography_interface_libgcrypt();
+    cryptography_if = NULL;
+    if (crypto_config.cryptography_type == CRYPTOGRAPHY_TYPE_AUTO)
+    {   // Every compiled in module, routed per cipher suite to the fastest at init
+        cryptography_if = get_cryptography_interface_auto();
+    }
+    if ((cryptography_if == NULL) && (crypto_config.cryptography_type == CRYPTOGRAPHY_TYPE_OPENSSL))
+    {   // Explicit choice when OpenSSL is built alongside libgcrypt
+        cryptography_if = get_cryptography_interface_openssl();
+    }
+    if (cryptography_if == NULL)
+    {
+        cryptography_if = get_cryptography_interface_libgcrypt();
+    }
     if (cryptography_if == NULL)
     {
         cryptography_if = get_cryptography_interface_wolfssl();
     }
     if (cryptography_if == NULL)
+    {
+        cryptography_if = get_cryptography_interface_openssl();
+    }
+    if (cryptography_if == NULL)
     {
         cryptography_if = get_cryptography_interface_custom();
     }
@@ -303,6 +353,17 @@ int32_t Crypto_Init(void)
         return status;
     }
 
+#ifdef CRYPTO_DIRECT_CALL
+    // The core calls the modules bound at build time, the configuration has to select those same modules
+    if ((sa_if != CRYPTO_SA_IF) || (key_if != CRYPTO_KEY_IF) || (mc_if != CRYPTO_MC_IF) ||
+        (cryptography_if != CRYPTO_CRYPTOGRAPHY_IF))
+    {
+        printf(KRED "ERROR: CryptoLib configuration selects a module other than the one bound by CRYPTO_DIRECT_CALL!\n" RESET);
+        status = CRYPTO_DIRECT_CALL_MODULE_MISMATCH;
+        return status;
+    }
+#endif
+
     // Initialize the cryptography library.
     status = cryptography_if->cryptography_init();
     if(status != CRYPTO_LIB_SUCCESS){
@@ -318,11 +379,17 @@ int32_t Crypto_Init(void)
         return status;
     }
 
-    // Init Security Associations
-    status = sa_if->sa_init();
+    // Init Security Associations, a snapshot restore fills the SA table itself
+    if (crypto_snapshot_restore == CRYPTO_FALSE)
+    {
+        status = sa_if->sa_init();
+    }
     if (status==CRYPTO_LIB_SUCCESS)
     {
-        status = sa_if->sa_config();
+        if (crypto_snapshot_restore == CRYPTO_FALSE)
+        {
+            status = sa_if->sa_config();
+        }
 
         Crypto_Local_Init();
         Crypto_Local_Config();
@@ -358,14 +425,20 @@ int32_t Crypto_Shutdown(void)
 
     crypto_free_config_structs();
 
-    current_managed_parameters = NULL;
+    current_managed_parameters = &gvcid_null_struct;
     current_managed_parameters_struct = gvcid_null_struct;
-    for(int i = 0; i < gvcid_counter; i++)
-    {
-        gvcid_managed_parameters_array[i] = gvcid_null_struct;
-    }
-    
+    free(gvcid_managed_parameters_array);
+    gvcid_managed_parameters_array = NULL;
+    free(gvcid_idle_frames_array);
+    gvcid_idle_frames_array = NULL;
+    free(gvcid_index);
+    gvcid_index = NULL;
+    gvcid_index_mask = 0;
+    gvcid_capacity = 0;
     gvcid_counter = 0;
+    Crypto_SA_Profile_Flush(CRYPTOGRAPHY_FLUSH_ALL_SA);
+    Crypto_SA_Counters_Flush(CRYPTOGRAPHY_FLUSH_ALL_SA);
+    Crypto_TM_Batch_Shutdown();
 
     // if (gvcid_managed_parameters != NULL)
     // {
@@ -434,9 +507,62 @@ int32_t Crypto_Config_CryptoLib(uint8_t key_type, uint8_t mc_type, uint8_t sa_ty
     crypto_config.crypto_check_fecf = crypto_check_fecf;
     crypto_config.vcid_bitmask = vcid_bitmask;
     crypto_config.crypto_increment_nontransmitted_iv = crypto_increment_nontransmitted_iv;
+    crypto_config.reject_burst = REJECT_BUDGET_OFF;
+    crypto_config.reject_rate = 0;
+    crypto_config.reject_holdoff_ms = REJECT_HOLDOFF_MS;
+    crypto_config.tm_check_anti_replay = TM_CHECK_ANTI_REPLAY_FALSE;
     return status;
 }
 
+/**
+ * @brief Function: Crypto_Config_Reject_Budget
+ * Limits how many frames failing TC/TM/AOS processing each GVCID and each SA may send.  Every GVCID and SA has a
+ * bucket holding burst tokens and refilling at rate per second.  A rejected frame takes one token from both its
+ * GVCID's and its SA's bucket, but only once processing located its SA; frames failing header, SPI, or SA state
+ * checks are counted and charged to neither.  A rejection finding a bucket empty sheds all frames of that GVCID, or
+ * carrying that SPI, for holdoff_ms, right after header decode and before any SA, FECF or crypto work, with
+ * CRYPTO_LIB_ERR_FRAME_SHED.
+ * Neither the GVCID nor the SPI of a rejected frame is authenticated.  Whoever can inject frames naming a GVCID and
+ * an SA in use on it can run out either budget and get that GVCID's or SA's genuine traffic shed for the hold-off.
+ * Budgets bound the crypto work spent on bad frames at that price, and are best left off where frames can be
+ * injected.  Call after Crypto_Config_CryptoLib, which turns budgets off.
+ * @param burst: uint32, REJECT_BUDGET_OFF to only count rejected frames
+ * @param rate: uint32, at least 1 unless burst is REJECT_BUDGET_OFF
+ * @param holdoff_ms: uint32
+ * @return int32: Success/Failure
+ **/
+int32_t Crypto_Config_Reject_Budget(uint32_t burst, uint32_t rate, uint32_t holdoff_ms)
+{
+    if ((burst != REJECT_BUDGET_OFF) && (rate == 0))
+    {
+        return CRYPTO_LIB_ERROR;
+    }
+    crypto_config.reject_burst = burst;
+    crypto_config.reject_rate = rate;
+    crypto_config.reject_holdoff_ms = holdoff_ms;
+    return CRYPTO_LIB_SUCCESS;
+}
+
+/**
+ * @brief Function: Crypto_Config_TM_Anti_Replay
+ * Holds frames decrypted by Crypto_TM_ProcessSecurity and Crypto_TM_ProcessSecurity_Batch to the SA anti-replay
+ * window, advancing the SA IV/ARSN for each accepted frame.  Off by default, both then hand back every frame that
+ * decrypts, and only Crypto_TM_VerifySecurity and idle frames verified under the GVCID idle policy are checked.
+ * TC_IGNORE_ANTI_REPLAY_TRUE still skips the window either way.  Call after Crypto_Config_CryptoLib, which turns the
+ * check off.
+ * @param tm_check_anti_replay: uint8
+ * @return int32: Success/Failure
+ **/
+int32_t Crypto_Config_TM_Anti_Replay(uint8_t tm_check_anti_replay)
+{
+    if (tm_check_anti_replay > TM_CHECK_ANTI_REPLAY_TRUE)
+    {
+        return CRYPTO_LIB_ERROR;
+    }
+    crypto_config.tm_check_anti_replay = tm_check_anti_replay;
+    return CRYPTO_LIB_SUCCESS;
+}
+
 /**
  * @brief Function: Crypto_Config_MariaDB
  * @param mysql_username: char*
@@ -501,9 +627,92 @@ int32_t Crypto_Config_Kmc_Crypto_Service(char* protocol, char* kmc_crypto_hostna
     cryptography_kmc_crypto_config->mtls_ca_path = crypto_deep_copy_string(kmc_tls_ca_path);
     cryptography_kmc_crypto_config->mtls_issuer_cert = crypto_deep_copy_string(mtls_issuer_cert);
     cryptography_kmc_crypto_config->ignore_ssl_hostname_validation = kmc_ignore_ssl_hostname_validation;
+    cryptography_kmc_crypto_config->kmc_hedge_delay_ms = KMC_CRYPTO_HEDGE_OFF;
+    cryptography_kmc_crypto_config->kmc_breaker_threshold = KMC_CRYPTO_BREAKER_THRESHOLD;
+    cryptography_kmc_crypto_config->kmc_breaker_open_ms = KMC_CRYPTO_BREAKER_OPEN_MS;
+    cryptography_kmc_crypto_config->kmc_batch_max = KMC_CRYPTO_BATCH_OFF;
+    cryptography_kmc_crypto_config->kmc_batch_window_us = KMC_CRYPTO_BATCH_WINDOW_US;
     return status;
 }
 
+/**
+ * @brief Function: Crypto_Config_Kmc_Crypto_Service_Add_Endpoint
+ * Adds an endpoint serving the same KMC crypto service, protocol, app URI and TLS settings are shared with the primary
+ * @param kmc_crypto_hostname: char*
+ * @param kmc_crypto_port: uint16_t
+ * @return int32_t: Success/Failure
+ **/
+int32_t Crypto_Config_Kmc_Crypto_Service_Add_Endpoint(char* kmc_crypto_hostname, uint16_t kmc_crypto_port)
+{
+    uint8_t count;
+
+    if (cryptography_kmc_crypto_config == NULL)
+    {
+        return CRYPTOGRAPHY_KMC_CRYPTO_SERVICE_CONFIGURATION_NOT_COMPLETE;
+    }
+    if (kmc_crypto_hostname == NULL)
+    {
+        return CRYPTO_LIB_ERR_NULL_BUFFER;
+    }
+    count = cryptography_kmc_crypto_config->kmc_crypto_endpoint_count;
+    if (count >= KMC_CRYPTO_MAX_ENDPOINTS - 1)
+    {
+        return CRYPTOGRAPHY_KMC_CRYPTO_SERVICE_ENDPOINT_LIMIT;
+    }
+    cryptography_kmc_crypto_config->kmc_crypto_endpoint_hostname[count] = crypto_deep_copy_string(kmc_crypto_hostname);
+    cryptography_kmc_crypto_config->kmc_crypto_endpoint_port[count] = kmc_crypto_port;
+    cryptography_kmc_crypto_config->kmc_crypto_endpoint_count++;
+    return CRYPTO_LIB_SUCCESS;
+}
+
+/**
+ * @brief Function: Crypto_Config_Kmc_Crypto_Service_Hedging
+ * Requests still unanswered after the hedge delay are duplicated to a second endpoint, the first answer is used.
+ * An endpoint failing breaker_threshold requests in a row is skipped for breaker_open_ms, then tried again once.
+ * A breaker_threshold of 0 never skips an endpoint.
+ * @param hedge_delay_ms: uint32_t, KMC_CRYPTO_HEDGE_OFF, a delay in ms, or KMC_CRYPTO_HEDGE_P95
+ * @param breaker_threshold: uint8_t
+ * @param breaker_open_ms: uint32_t
+ * @return int32_t: Success/Failure
+ **/
+int32_t Crypto_Config_Kmc_Crypto_Service_Hedging(uint32_t hedge_delay_ms, uint8_t breaker_threshold,
+                                                 uint32_t breaker_open_ms)
+{
+    if (cryptography_kmc_crypto_config == NULL)
+    {
+        return CRYPTOGRAPHY_KMC_CRYPTO_SERVICE_CONFIGURATION_NOT_COMPLETE;
+    }
+    cryptography_kmc_crypto_config->kmc_hedge_delay_ms = hedge_delay_ms;
+    cryptography_kmc_crypto_config->kmc_breaker_threshold = breaker_threshold;
+    cryptography_kmc_crypto_config->kmc_breaker_open_ms = breaker_open_ms;
+    return CRYPTO_LIB_SUCCESS;
+}
+
+/**
+ * @brief Function: Crypto_Config_Kmc_Crypto_Service_Batching
+ * Operations on the same key reference issued by concurrent callers are gathered for up to batch_window_us and
+ * sent in one request of at most batch_max operations. A batch_max of KMC_CRYPTO_BATCH_OFF (or 0) sends every
+ * operation on its own.  The KMC crypto service has no batch endpoint of its own, batching needs a service side
+ * extension answering POST batch?keyRef=<key>.  Endpoints without it answer 404 or 405 and are not sent batches again.
+ * @param batch_max: uint8_t
+ * @param batch_window_us: uint32_t
+ * @return int32_t: Success/Failure
+ **/
+int32_t Crypto_Config_Kmc_Crypto_Service_Batching(uint8_t batch_max, uint32_t batch_window_us)
+{
+    if (cryptography_kmc_crypto_config == NULL)
+    {
+        return CRYPTOGRAPHY_KMC_CRYPTO_SERVICE_CONFIGURATION_NOT_COMPLETE;
+    }
+    if (batch_max > KMC_CRYPTO_BATCH_MAX)
+    {
+        return CRYPTOGRAPHY_KMC_CRYPTO_SERVICE_BATCH_LIMIT;
+    }
+    cryptography_kmc_crypto_config->kmc_batch_max = batch_max;
+    cryptography_kmc_crypto_config->kmc_batch_window_us = batch_window_us;
+    return CRYPTO_LIB_SUCCESS;
+}
+
 /**
  * @brief Function: Crypto_Config_Cam
  * @param cam_enabled: uint8_t
@@ -529,22 +738,237 @@ int32_t Crypto_Config_Cam(uint8_t cam_enabled, char* cookie_file_path, char* key
 
 
 
+/**
+ * @brief Function: crypto_gvcid_hash
+ * Hashes a packed (tfvn, scid, vcid) key into the managed parameter index
+ * @param key: uint32
+ * @return uint32: Starting slot
+ **/
+static uint32_t crypto_gvcid_hash(uint32_t key)
+{
+    key *= 2654435761u;
+    key ^= key >> 16;
+    return key & gvcid_index_mask;
+}
+
+/**
+ * @brief Function: crypto_gvcid_index_insert
+ * Indexes an array position.  A GVCID that is already indexed keeps its first entry, matching the
+ * first-match behavior of a scan over the table.
+ * @param position: int32
+ **/
+static void crypto_gvcid_index_insert(int32_t position)
+{
+    const GvcidManagedParameters_t* mp = &gvcid_managed_parameters_array[position];
+    uint32_t key = ((uint32_t)mp->tfvn << 16) | ((uint32_t)mp->scid << 6) | mp->vcid;
+    uint32_t slot = crypto_gvcid_hash(key);
+
+    while (gvcid_index[slot] != -1)
+    {
+        const GvcidManagedParameters_t* existing = &gvcid_managed_parameters_array[gvcid_index[slot]];
+        if (existing->tfvn == mp->tfvn && existing->scid == mp->scid && existing->vcid == mp->vcid)
+        {
+            return;
+        }
+        slot = (slot + 1) & gvcid_index_mask;
+    }
+    gvcid_index[slot] = position;
+}
+
+/**
+ * @brief Function: crypto_gvcid_index_rebuild
+ * Clears the index and re-inserts every table entry in order
+ **/
+static void crypto_gvcid_index_rebuild(void)
+{
+    memset(gvcid_index, 0xFF, (gvcid_index_mask + 1) * sizeof(int32_t));
+    for (int32_t i = 0; i < gvcid_counter; i++)
+    {
+        crypto_gvcid_index_insert(i);
+    }
+}
+
+/**
+ * @brief Function: crypto_gvcid_table_grow
+ * Doubles the managed parameter table and rebuilds its index at under 50% load
+ * @return int32: Success/Failure
+ **/
+static int32_t crypto_gvcid_table_grow(void)
+{
+    int new_capacity = (gvcid_capacity == 0) ? GVCID_MAN_PARAM_INITIAL_SIZE : gvcid_capacity * 2;
+    uint32_t index_size = 1;
+    GvcidManagedParameters_t* new_array = NULL;
+    GvcidIdleFrames_t* new_idle_frames = NULL;
+    int32_t* new_index = NULL;
+    int32_t current_offset = -1;
+
+    if (new_capacity > GVCID_MAN_PARAM_SIZE)
+    {
+        new_capacity = GVCID_MAN_PARAM_SIZE;
+    }
+    while (index_size < (uint32_t)new_capacity * 2)
+    {
+        index_size <<= 1;
+    }
+
+    // Keep current_managed_parameters valid if it points into the table being moved
+    if (gvcid_managed_parameters_array != NULL && current_managed_parameters >= gvcid_managed_parameters_array &&
+        current_managed_parameters < gvcid_managed_parameters_array + gvcid_counter)
+    {
+        current_offset = (int32_t)(current_managed_parameters - gvcid_managed_parameters_array);
+    }
+
+    // Allocate the index first; a failed realloc below leaves the old tables intact, and capacity is
+    // only committed once every table covers it
+    new_index = malloc(index_size * sizeof(int32_t));
+    if (new_index == NULL)
+    {
+        return CRYPTO_LIB_ERR_EXCEEDS_MANAGED_PARAMETER_MAX_LIMIT;
+    }
+    new_array = realloc(gvcid_managed_parameters_array, new_capacity * GVCID_MANAGED_PARAMETERS_SIZE);
+    if (new_array == NULL)
+    {
+        free(new_index);
+        return CRYPTO_LIB_ERR_EXCEEDS_MANAGED_PARAMETER_MAX_LIMIT;
+    }
+    gvcid_managed_parameters_array = new_array;
+    if (current_offset >= 0)
+    {
+        current_managed_parameters = gvcid_managed_parameters_array + current_offset;
+    }
+    new_idle_frames = realloc(gvcid_idle_frames_array, new_capacity * GVCID_IDLE_FRAMES_SIZE);
+    if (new_idle_frames == NULL)
+    {
+        free(new_index);
+        return CRYPTO_LIB_ERR_EXCEEDS_MANAGED_PARAMETER_MAX_LIMIT;
+    }
+    gvcid_idle_frames_array = new_idle_frames;
+
+    gvcid_capacity = new_capacity;
+    free(gvcid_index);
+    gvcid_index = new_index;
+    gvcid_index_mask = index_size - 1;
+    crypto_gvcid_index_rebuild();
+    return CRYPTO_LIB_SUCCESS;
+}
+
+/**
+ * @brief Function: Crypto_Config_Add_Gvcid_Managed_Parameters
+ * Appends managed parameters to the table, growing it as needed.  Pointers previously returned by
+ * Crypto_Get_Managed_Parameters_Ptr_For_Gvcid are not guaranteed to survive a call to this function.
+ * @param gvcid_managed_parameters_struct: GvcidManagedParameters_t
+ * @return int32: Success/Failure
+ **/
 int32_t Crypto_Config_Add_Gvcid_Managed_Parameters(GvcidManagedParameters_t gvcid_managed_parameters_struct)
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
-    if (gvcid_counter > GVCID_MAN_PARAM_SIZE)
+    if (gvcid_counter >= GVCID_MAN_PARAM_SIZE)
     {
         status = CRYPTO_LIB_ERR_EXCEEDS_MANAGED_PARAMETER_MAX_LIMIT;
+        return status;
     }
-    else
+    if (gvcid_counter == gvcid_capacity)
     {
-        gvcid_managed_parameters_array[gvcid_counter] = gvcid_managed_parameters_struct;
-        gvcid_counter++;    
+        status = crypto_gvcid_table_grow();
+        if (status != CRYPTO_LIB_SUCCESS)
+        {
+            return status;
+        }
     }
-    
+
+    gvcid_managed_parameters_array[gvcid_counter] = gvcid_managed_parameters_struct;
+    gvcid_idle_frames_array[gvcid_counter] = gvcid_idle_frames_default;
+    crypto_gvcid_index_insert(gvcid_counter);
+    gvcid_counter++;
+
     return status; 
 }
 
+/**
+ * @brief Function: Crypto_Get_Managed_Parameters_Ptr_For_Gvcid
+ * Hashed lookup of the managed parameters for a GVCID.  Cost is independent of the channel's position in the
+ * table, and the entry is returned by reference rather than copied.
+ * @param tfvn: uint8
+ * @param scid: uint16
+ * @param vcid: uint8
+ * @param managed_parameters_out: const GvcidManagedParameters_t**
+ * @return int32: Success/Failure
+ **/
+int32_t Crypto_Get_Managed_Parameters_Ptr_For_Gvcid(uint8_t tfvn, uint16_t scid, uint8_t vcid,
+                                                    const GvcidManagedParameters_t** managed_parameters_out)
+{
+    int32_t status = MANAGED_PARAMETERS_FOR_GVCID_NOT_FOUND;
+
+    // Out of range identifiers can never match the bit-field widths of a stored entry
+    if (gvcid_index != NULL && tfvn <= 0x0F && scid <= 0x03FF && vcid <= 0x3F)
+    {
+        uint32_t key = ((uint32_t)tfvn << 16) | ((uint32_t)scid << 6) | vcid;
+        uint32_t slot = crypto_gvcid_hash(key);
+
+        while (gvcid_index[slot] != -1)
+        {
+            const GvcidManagedParameters_t* mp = &gvcid_managed_parameters_array[gvcid_index[slot]];
+            if (mp->tfvn == tfvn && mp->scid == scid && mp->vcid == vcid)
+            {
+                *managed_parameters_out = mp;
+                status = CRYPTO_LIB_SUCCESS;
+                break;
+            }
+            slot = (slot + 1) & gvcid_index_mask;
+        }
+    }
+
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        crypto_gvcid_t gvcid = {.tfvn = tfvn, .scid = scid, .vcid = vcid, .mapid = 0};
+        Crypto_MC_Event(status, MC_EVENT_SPI_NA, &gvcid, "Managed Parameters for GVCID not found");
+    }
+
+    return status;
+}
+
+/**
+ * @brief Function: Crypto_Config_Gvcid_Idle_Frames
+ * Sets how TM and AOS ProcessSecurity handle idle frames on a GVCID whose managed parameters were already added.
+ * Frames are idle when idle_vc marks the whole virtual channel as idle fill, or, for TM, when the first header
+ * pointer says the frame only carries idle data.
+ * @param tfvn: uint8
+ * @param scid: uint16
+ * @param vcid: uint8
+ * @param idle_vc: uint8, IdleVcBool
+ * @param idle_policy: uint8, IdleFramePolicy
+ * @return int32: Success/Failure
+ **/
+int32_t Crypto_Config_Gvcid_Idle_Frames(uint8_t tfvn, uint16_t scid, uint8_t vcid, uint8_t idle_vc, uint8_t idle_policy)
+{
+    const GvcidManagedParameters_t* mp = NULL;
+    int32_t status = Crypto_Get_Managed_Parameters_Ptr_For_Gvcid(tfvn, scid, vcid, &mp);
+
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        gvcid_idle_frames_array[mp - gvcid_managed_parameters_array].idle_vc = idle_vc;
+        gvcid_idle_frames_array[mp - gvcid_managed_parameters_array].idle_policy = idle_policy;
+    }
+    return status;
+}
+
+/**
+ * @brief Function: Crypto_Get_Idle_Frames_For_Managed_Parameters
+ * Idle frame handling for the GVCID of a managed parameters entry, as returned by
+ * Crypto_Get_Managed_Parameters_Ptr_For_Gvcid
+ * @param managed_parameters: const GvcidManagedParameters_t*
+ * @return const GvcidIdleFrames_t*: Never NULL, entries outside the table process idle frames in full
+ **/
+const GvcidIdleFrames_t* Crypto_Get_Idle_Frames_For_Managed_Parameters(const GvcidManagedParameters_t* managed_parameters)
+{
+    if (gvcid_managed_parameters_array == NULL || managed_parameters < gvcid_managed_parameters_array ||
+        managed_parameters >= gvcid_managed_parameters_array + gvcid_counter)
+    {
+        return &gvcid_idle_frames_default;
+    }
+    return &gvcid_idle_frames_array[managed_parameters - gvcid_managed_parameters_array];
+}
+
 /**
  * @brief Function: Crypto_Config_Add_Gvcid_Managed_Parameter
  * @param tfvn: uint8
@@ -601,6 +1025,7 @@ int32_t Crypto_Config_Add_Gvcid_Managed_Parameters(GvcidManagedParameters_t gvci
 int32_t crypto_free_config_structs(void)
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
+    uint8_t i;
 
     //free(crypto_config); //no strings in this struct, just free it.
     crypto_config.init_status = UNITIALIZED;
@@ -632,6 +1057,10 @@ int32_t crypto_free_config_structs(void)
         free(cryptography_kmc_crypto_config->mtls_ca_bundle);
         free(cryptography_kmc_crypto_config->mtls_ca_path);
         free(cryptography_kmc_crypto_config->mtls_issuer_cert);
+        for (i = 0; i < cryptography_kmc_crypto_config->kmc_crypto_endpoint_count; i++)
+        {
+            free(cryptography_kmc_crypto_config->kmc_crypto_endpoint_hostname[i]);
+        }
         free(cryptography_kmc_crypto_config);
         cryptography_kmc_crypto_config=NULL;
     }
@@ -0,0 +1,357 @@
+/* Copyright (C) 2009 - 2022 National Aeronautics and Space Administration.
+   All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any kind, either expressed, implied, or statutory,
+   including, but not limited to, any warranty that the software will conform to specifications, any implied warranties
+   of merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+   documentation will conform to the program, or any warranty that the software will be error free.
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+   consequential damages, arising out of, resulting from, or in any way connected with the software or its
+   documentation, whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained
+   from, or arose out of the results of, or use of, the software, documentation or services provided hereunder.
+
+   ITC Team
+   NASA IV&V
+   jstar-development-team@mail.nasa.gov
+*/
+
+/*
+** Includes
+*/
+#include "crypto.h"
+
+#include <sched.h>  // sched_yield
+#include <string.h> // memcpy
+
+/*
+** SA Counter Reservation
+** ApplySecurity takes the IV and ARSN of a frame out of the SA before building it, and the SA is advanced in the
+** same step, so threads applying security on one SA never share a counter.  The counters are big-endian byte
+** strings of up to IV_SIZE/ARSN_SIZE octets, too wide for an atomic add, so the copy-and-advance runs under a
+** short per SA spin lock instead.  A thread can reserve a block of values at once and hand them out without
+** touching the SA again; values it never sends are counted as gaps.
+** The receiver's anti-replay window only moves forward, accepting the next arsnw values, so frames have to reach it
+** in counter order, and a block is never larger than the SA's arsnw.  A block is reserved when its first value is
+** used, so the values skipped between two frames sent are at most the unused rest of one block.
+*/
+typedef struct
+{
+    uint8_t lock;
+    uint32_t generation; // Bumped by Crypto_SA_Counters_Flush, outstanding blocks are dropped
+    uint64_t gaps;       // Reserved values never sent
+} crypto_counter_slot_t;
+
+typedef struct
+{
+    SecurityAssociation_t* sa_ptr;
+    uint16_t spi;
+    uint32_t generation;
+    uint32_t remaining;
+    uint8_t iv_len;
+    uint8_t shivf_len;
+    uint8_t arsn_len;
+    uint8_t shsnf_len;
+    crypto_sa_counters_t next;
+} crypto_counter_block_t;
+
+static crypto_counter_slot_t crypto_counter_slots[SA_COUNTER_SLOTS];
+static uint32_t crypto_counter_block_size = SA_COUNTER_BLOCK_DEFAULT;
+static _Thread_local crypto_counter_block_t crypto_counter_blocks[SA_COUNTER_SLOTS];
+
+/**
+ * @brief Function: crypto_counter_add
+ * Adds to a big-endian counter, wrapping to zero like Crypto_increment
+ * @param num: uint8_t*
+ * @param length: int
+ * @param count: uint32
+ **/
+static void crypto_counter_add(uint8_t* num, int length, uint32_t count)
+{
+    uint64_t carry = count;
+    int i;
+
+    for (i = length - 1; (i >= 0) && (carry != 0); i--)
+    {
+        carry += num[i];
+        num[i] = (uint8_t)(carry & 0xFF);
+        carry >>= 8;
+    }
+}
+
+/**
+ * @brief Function: crypto_counter_step
+ * Moves an IV/ARSN pair of an SA on by count frames, following the SA increment rules
+ * @param sa_ptr: const SecurityAssociation_t*
+ * @param iv: uint8_t*
+ * @param arsn: uint8_t*
+ * @param count: uint32
+ **/
+static void crypto_counter_step(const SecurityAssociation_t* sa_ptr, uint8_t* iv, uint8_t* arsn, uint32_t count)
+{
+#ifdef INCREMENT
+    if (sa_ptr->shivf_len > 0 && sa_ptr->iv_len != 0)
+    {
+        if (crypto_config.crypto_increment_nontransmitted_iv == SA_INCREMENT_NONTRANSMITTED_IV_TRUE)
+        {
+            crypto_counter_add(iv, sa_ptr->iv_len, count);
+        }
+        else // SA_INCREMENT_NONTRANSMITTED_IV_FALSE
+        {
+            // Only increment the transmitted portion
+            crypto_counter_add(iv + (sa_ptr->iv_len - sa_ptr->shivf_len), sa_ptr->shivf_len, count);
+        }
+    }
+    if (sa_ptr->shsnf_len > 0)
+    {
+        crypto_counter_add(arsn, sa_ptr->arsn_len, count);
+    }
+#else
+    sa_ptr = sa_ptr;
+    iv = iv;
+    arsn = arsn;
+    count = count;
+#endif
+}
+
+/**
+ * @brief Function: crypto_counter_reserve
+ * Copies the next counters of an SA out and advances the SA past count frames
+ * @param sa_ptr: SecurityAssociation_t*
+ * @param count: uint32
+ * @param iv: uint8_t*
+ * @param arsn: uint8_t*
+ * @return int32: Success/Failure
+ **/
+static int32_t crypto_counter_reserve(SecurityAssociation_t* sa_ptr, uint32_t count, uint8_t* iv, uint8_t* arsn)
+{
+    crypto_counter_slot_t* slot = &crypto_counter_slots[sa_ptr->spi & (SA_COUNTER_SLOTS - 1)];
+
+    // SADBs shared with other processes serialize on their own lock
+    if (CRYPTO_SA_IF->sa_reserve_counters != NULL)
+    {
+        return CRYPTO_SA_IF->sa_reserve_counters(sa_ptr, count, iv, arsn);
+    }
+
+    while (__atomic_test_and_set(&slot->lock, __ATOMIC_ACQUIRE))
+    {
+        while (__atomic_load_n(&slot->lock, __ATOMIC_RELAXED))
+        {
+            sched_yield();
+        }
+    }
+    memcpy(iv, sa_ptr->iv, IV_SIZE);
+    memcpy(arsn, sa_ptr->arsn, ARSN_SIZE);
+    Crypto_SA_Counters_Advance(sa_ptr, count);
+    __atomic_clear(&slot->lock, __ATOMIC_RELEASE);
+    return CRYPTO_LIB_SUCCESS;
+}
+
+/**
+ * @brief Function: crypto_counter_drop
+ * Discards what is left of a thread's block, the values are reported as gaps
+ * @param block: crypto_counter_block_t*
+ **/
+static void crypto_counter_drop(crypto_counter_block_t* block)
+{
+    if (block->remaining > 0)
+    {
+        Crypto_SA_Counters_Gap(block->spi, block->remaining);
+    }
+    block->remaining = 0;
+    block->sa_ptr = NULL;
+}
+
+/**
+ * @brief Function: Crypto_SA_Counters_Reserve
+ * Reserves the IV and ARSN of one outgoing frame.  The SA is already advanced when this returns, so the frame
+ * must be built from the reserved values only.  Plaintext SAs never advance and are copied as is.
+ * With a block size above one the values come out of this thread's block, which is refilled from the SA when
+ * it runs out.  Blocks are cut down to the SA's arsnw.  SADBs that hand out a fresh copy of the SA on every lookup
+ * reserve one value at a time.
+ * @param sa_ptr: SecurityAssociation_t*
+ * @param sa_service_type: uint8
+ * @param counters: crypto_sa_counters_t*
+ * @return int32: Success/Failure
+ **/
+int32_t Crypto_SA_Counters_Reserve(SecurityAssociation_t* sa_ptr, uint8_t sa_service_type, crypto_sa_counters_t* counters)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    crypto_counter_block_t* block;
+    uint32_t block_size;
+    uint32_t generation;
+
+    if (sa_ptr == NULL)
+    {
+        return CRYPTO_LIB_ERR_NULL_SA;
+    }
+    if (counters == NULL)
+    {
+        return CRYPTO_LIB_ERR_NULL_BUFFER;
+    }
+
+    if (sa_service_type == SA_PLAINTEXT)
+    {
+        memcpy(counters->iv, sa_ptr->iv, IV_SIZE);
+        memcpy(counters->arsn, sa_ptr->arsn, ARSN_SIZE);
+        return status;
+    }
+
+    block_size = __atomic_load_n(&crypto_counter_block_size, __ATOMIC_RELAXED);
+    if (block_size > sa_ptr->arsnw)
+    {
+        // Skipping the unused rest of a larger block would move the receiver past its window for good
+        block_size = sa_ptr->arsnw;
+    }
+    if ((block_size <= 1) || (crypto_config.sa_type == SA_TYPE_MARIADB))
+    {
+        status = crypto_counter_reserve(sa_ptr, 1, counters->iv, counters->arsn);
+    }
+    else
+    {
+        block = &crypto_counter_blocks[sa_ptr->spi & (SA_COUNTER_SLOTS - 1)];
+        generation = __atomic_load_n(&crypto_counter_slots[sa_ptr->spi & (SA_COUNTER_SLOTS - 1)].generation,
+                                     __ATOMIC_ACQUIRE);
+        if ((block->sa_ptr != sa_ptr) || (block->spi != sa_ptr->spi) || (block->generation != generation) ||
+            (block->iv_len != sa_ptr->iv_len) || (block->shivf_len != sa_ptr->shivf_len) ||
+            (block->arsn_len != sa_ptr->arsn_len) || (block->shsnf_len != sa_ptr->shsnf_len))
+        {
+            crypto_counter_drop(block);
+        }
+        if (block->remaining == 0)
+        {
+            status = crypto_counter_reserve(sa_ptr, block_size, block->next.iv, block->next.arsn);
+            if (status == CRYPTO_LIB_SUCCESS)
+            {
+                block->sa_ptr = sa_ptr;
+                block->spi = sa_ptr->spi;
+                block->generation = generation;
+                block->remaining = block_size;
+                block->iv_len = sa_ptr->iv_len;
+                block->shivf_len = sa_ptr->shivf_len;
+                block->arsn_len = sa_ptr->arsn_len;
+                block->shsnf_len = sa_ptr->shsnf_len;
+            }
+        }
+        if (status == CRYPTO_LIB_SUCCESS)
+        {
+            memcpy(counters, &block->next, sizeof(crypto_sa_counters_t));
+            crypto_counter_step(sa_ptr, block->next.iv, block->next.arsn, 1);
+            block->remaining--;
+        }
+    }
+
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        CRYPTO_MC_IF->mc_log(status);
+    }
+#ifdef SA_DEBUG
+    else
+    {
+        int i;
+        printf(KYEL "Reserved IV value:\n\t");
+        for (i = 0; i < sa_ptr->iv_len; i++)
+        {
+            printf("%02x", counters->iv[i]);
+        }
+        printf("\n" RESET);
+        printf(KYEL "Reserved ARSN value:\n\t");
+        for (i = 0; i < sa_ptr->arsn_len; i++)
+        {
+            printf("%02x", counters->arsn[i]);
+        }
+        printf("\n" RESET);
+    }
+#endif
+    return status;
+}
+
+/**
+ * @brief Function: Crypto_SA_Counters_Advance
+ * Moves the counters of an SA on by count frames.  Callers serialize, SADB modules use it from their
+ * sa_reserve_counters under their own lock.
+ * @param sa_ptr: SecurityAssociation_t*
+ * @param count: uint32
+ **/
+void Crypto_SA_Counters_Advance(SecurityAssociation_t* sa_ptr, uint32_t count)
+{
+    crypto_counter_step(sa_ptr, sa_ptr->iv, sa_ptr->arsn, count);
+}
+
+/**
+ * @brief Function: Crypto_SA_Counters_Gap
+ * Records reserved IV/ARSN values that will never be sent, a frame that failed after its reservation or the
+ * unused rest of a block.  The receiver sees the gap as a jump, which stays within its anti-replay window as long as
+ * no more than one block's rest and frame failures fall between two frames sent.
+ * @param spi: uint16
+ * @param count: uint32, 0 for frames that reserved nothing, such as plaintext
+ **/
+void Crypto_SA_Counters_Gap(uint16_t spi, uint32_t count)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    __atomic_fetch_add(&crypto_counter_slots[spi & (SA_COUNTER_SLOTS - 1)].gaps, count, __ATOMIC_RELAXED);
+    Crypto_MC_Event(CRYPTO_LIB_ERR_SA_COUNTER_GAP, spi, NULL, "%u reserved IV/ARSN values not sent", count);
+}
+
+/**
+ * @brief Function: Crypto_SA_Counters_Get_Gaps
+ * @param spi: uint16
+ * @return uint64: Reserved values never sent on the SA
+ **/
+uint64_t Crypto_SA_Counters_Get_Gaps(uint16_t spi)
+{
+    return __atomic_load_n(&crypto_counter_slots[spi & (SA_COUNTER_SLOTS - 1)].gaps, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Function: Crypto_SA_Counters_Set_Block
+ * Sets how many values a thread reserves from an SA at once.  Threads pick the new size up when their
+ * current block runs out.  Each SA uses at most its arsnw values per block.
+ * @param block: uint32, 1 to SA_COUNTER_BLOCK_MAX
+ * @return int32: Success/Failure
+ **/
+int32_t Crypto_SA_Counters_Set_Block(uint32_t block)
+{
+    if ((block == 0) || (block > SA_COUNTER_BLOCK_MAX))
+    {
+        return CRYPTO_LIB_ERR_SA_COUNTER_BLOCK;
+    }
+    __atomic_store_n(&crypto_counter_block_size, block, __ATOMIC_RELAXED);
+    return CRYPTO_LIB_SUCCESS;
+}
+
+/**
+ * @brief Function: Crypto_SA_Counters_Release
+ * Hands back the calling thread's blocks, call before a producer thread exits.  The unused values are gaps.
+ **/
+void Crypto_SA_Counters_Release(void)
+{
+    int i;
+    for (i = 0; i < SA_COUNTER_SLOTS; i++)
+    {
+        crypto_counter_drop(&crypto_counter_blocks[i]);
+    }
+}
+
+/**
+ * @brief Function: Crypto_SA_Counters_Flush
+ * Invalidates the blocks every thread holds for an SA, each thread drops its block on its next reservation
+ * Called through Crypto_Flush_SA whenever an SA is rekeyed, stopped, expired or deleted
+ * @param spi: uint16_t, CRYPTOGRAPHY_FLUSH_ALL_SA for every SA
+ **/
+void Crypto_SA_Counters_Flush(uint16_t spi)
+{
+    int i;
+    if (spi == CRYPTOGRAPHY_FLUSH_ALL_SA)
+    {
+        for (i = 0; i < SA_COUNTER_SLOTS; i++)
+        {
+            __atomic_fetch_add(&crypto_counter_slots[i].generation, 1, __ATOMIC_RELEASE);
+        }
+        return;
+    }
+    __atomic_fetch_add(&crypto_counter_slots[spi & (SA_COUNTER_SLOTS - 1)].generation, 1, __ATOMIC_RELEASE);
+}
@@ -78,6 +78,19 @@ char *crypto_enum_errlist_core[] =
         (char*) "CRYPTO_LIB_ERR_EXCEEDS_MANAGED_PARAMETER_MAX_LIMIT",
         (char*) "CRYPTO_LIB_ERR_KEY_VALIDATION",
         (char*) "CRYPTO_LIB_ERR_SPI_INDEX_OOB", 
+        (char*) "CRYPTO_LIB_ERR_SA_NOT_OPERATIONAL",
+        (char*) "CRYPTO_LIB_ERR_ARENA_EXHAUSTED",
+        (char*) "CRYPTO_LIB_ERR_SNAPSHOT_IO",
+        (char*) "CRYPTO_LIB_ERR_SNAPSHOT_INVALID",
+        (char*) "CRYPTO_LIB_ERR_SNAPSHOT_CHECKSUM",
+        (char*) "CRYPTO_LIB_ERR_SNAPSHOT_UNSUPPORTED",
+        (char*) "CRYPTO_LIB_ERR_SA_SHM_MAP",
+        (char*) "CRYPTO_LIB_ERR_SA_SHM_INCOMPATIBLE",
+        (char*) "CRYPTO_LIB_ERR_SA_SHM_LOCK",
+        (char*) "CRYPTO_LIB_ERR_SA_COUNTER_BLOCK",
+        (char*) "CRYPTO_LIB_ERR_SA_COUNTER_GAP",
+        (char*) "CRYPTO_LIB_ERR_IDLE_FRAME",
+        (char*) "CRYPTO_LIB_ERR_FRAME_SHED",
 };
 
 char *crypto_enum_errlist_config[] =
@@ -86,6 +99,7 @@ char *crypto_enum_errlist_config[] =
         (char*) "CRYPTO_MANAGED_PARAM_CONFIGURATION_NOT_COMPLETE",
         (char*) "CRYPTO_MARIADB_CONFIGURATION_NOT_COMPLETE",
         (char*) "MANAGED_PARAMETERS_FOR_GVCID_NOT_FOUND",
+        (char*) "CRYPTO_DIRECT_CALL_MODULE_MISMATCH",
 };
 
 char *crypto_enum_errlist_sa_if[] =
@@ -105,6 +119,8 @@ char *crypto_enum_errlist_crypto_if[] =
         (char*) "CRYPTOGRAPHY_INVALID_CRYPTO_INTERFACE_TYPE",
         (char*) "CRYPTOGRAPHY_UNSUPPORTED_OPERATION_FOR_KEY_RING",
         (char*) "CRYPTOGRAPHY_LIBRARY_INITIALIZIATION_ERROR",
+        (char*) "CRYPTOGRAPHY_AUTO_KNOWN_ANSWER_FAILURE",
+        (char*) "CRYPTOGRAPHY_AUTO_NO_USABLE_INTERFACE",
 };
 char *crypto_enum_errlist_crypto_kmc[] =
 {
@@ -124,6 +140,9 @@ char *crypto_enum_errlist_crypto_kmc[] =
         (char*) "CRYPTOGRAHPY_KMC_CRYPTO_SERVICE_EMPTY_RESPONSE",
         (char*) "CRYPTOGRAHPY_KMC_CRYPTO_SERVICE_DECRYPT_ERROR",
         (char*) "CRYPTOGRAHPY_KMC_CRYPTO_SERVICE_ENCRYPT_ERROR",
+        (char*) "CRYPTOGRAPHY_KMC_CRYPTO_SERVICE_ENDPOINT_LIMIT",
+        (char*) "CRYPTOGRAPHY_KMC_CRYPTO_SERVICE_BATCH_LIMIT",
+        (char*) "CRYPTOGRAPHY_KMC_CRYPTO_SERVICE_BATCH_UNSUPPORTED",
 };
 
 char *crypto_enum_errlist_crypto_cam[] =
@@ -181,11 +200,11 @@ char* Crypto_Get_Error_Code_Enum_String(int32_t crypto_error_code)
     }
     else if(crypto_error_code >= 500) // KMC Error Codes
     {
-        return_string = Crypto_Get_Error_Code_String(crypto_error_code, 515, crypto_enum_errlist_crypto_kmc[crypto_error_code % 500]);
+        return_string = Crypto_Get_Error_Code_String(crypto_error_code, 518, crypto_enum_errlist_crypto_kmc[crypto_error_code % 500]);
     }
     else if(crypto_error_code >= 400) // Crypto Interface Error Codes
     {
-        return_string = Crypto_Get_Error_Code_String(crypto_error_code, 402, crypto_enum_errlist_crypto_if[crypto_error_code % 400]);
+        return_string = Crypto_Get_Error_Code_String(crypto_error_code, 404, crypto_enum_errlist_crypto_if[crypto_error_code % 400]);
     }
     else if(crypto_error_code >= 300) // SADB MariadDB Error Codes
     {
@@ -197,7 +216,7 @@ char* Crypto_Get_Error_Code_Enum_String(int32_t crypto_error_code)
     }
     else if(crypto_error_code >= 100) // Configuration Error Codes
     {
-        return_string = Crypto_Get_Error_Code_String(crypto_error_code, 103, crypto_enum_errlist_config[crypto_error_code % 100]);
+        return_string = Crypto_Get_Error_Code_String(crypto_error_code, 104, crypto_enum_errlist_config[crypto_error_code % 100]);
     }
     else if(crypto_error_code <= 0) // Cryptolib Core Error Codes
     {
@@ -44,7 +44,7 @@ int32_t Crypto_Key_OTAR(void)
     int x = 0;
     int y;
     int32_t status = CRYPTO_LIB_SUCCESS;
-    int pdu_keys = (sdls_frame.pdu.pdu_len - 30) / (2 + KEY_SIZE);
+    int pdu_keys = (sdls_frame.pdu.pdu_len - 30) / (2 + OTAR_KEY_BLOCK_SIZE);
     int w;
     crypto_key_t* ekp = NULL;
 
@@ -83,15 +83,15 @@ int32_t Crypto_Key_OTAR(void)
         // printf("packet.mac[%d] = 0x%02x\n", w, packet.mac[w]);
     }
 
-    ekp = key_if->get_key(packet.mkid);
+    ekp = CRYPTO_KEY_IF->get_key(packet.mkid);
     if (ekp == NULL)
     {
         return CRYPTO_LIB_ERR_KEY_ID_ERROR;
     }
 
     uint8_t ecs = CRYPTO_CIPHER_AES256_GCM;
-    status = cryptography_if->cryptography_aead_decrypt(&(sdls_frame.pdu.data[14]), // plaintext output
-                                                        (size_t)(pdu_keys * (2 + KEY_SIZE)), // length of data
+    status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_aead_decrypt(&(sdls_frame.pdu.data[14]), // plaintext output
+                                                        (size_t)(pdu_keys * (2 + OTAR_KEY_BLOCK_SIZE)), // length of data
                                                         NULL,                               // in place decryption
                                                         0,                                  // in data length
                                                         &(ekp->value[0]), //key
@@ -135,13 +135,14 @@ int32_t Crypto_Key_OTAR(void)
         }
         else
         {
-            ekp = key_if->get_key(packet.EKB[x].ekid);
+            ekp = CRYPTO_KEY_IF->get_key(packet.EKB[x].ekid);
             if (ekp == NULL)
             {
                 return CRYPTO_LIB_ERR_KEY_ID_ERROR;
             }
             
             count = count + 2;
+            // Key slots hold KEY_SIZE bytes, the rest of the wire block is not kept
             for (y = count; y < (KEY_SIZE + count); y++)
             { 
                 // Encrypted Key
@@ -152,7 +153,7 @@ int32_t Crypto_Key_OTAR(void)
                 // Setup Key Ring
                 ekp->value[y - count] = sdls_frame.pdu.data[y];
             }
-            count = count + KEY_SIZE;
+            count = count + OTAR_KEY_BLOCK_SIZE;
 
             // Set state to PREACTIVE
             ekp->key_state = KEY_PREACTIVE;
@@ -259,7 +260,7 @@ int32_t Crypto_Key_update(uint8_t state)
             // TODO: Exit
         }
 
-        ekp = key_if->get_key(packet.kblk[x].kid);
+        ekp = CRYPTO_KEY_IF->get_key(packet.kblk[x].kid);
         if (ekp == NULL)
         {
             return CRYPTO_LIB_ERR_KEY_ID_ERROR;
@@ -331,7 +332,7 @@ int32_t Crypto_Key_inventory(uint8_t* ingest)
         ingest[count++] = (x & 0xFF00) >> 8;
         ingest[count++] = (x & 0x00FF);
         // Get Key
-        ekp = key_if->get_key(x);
+        ekp = CRYPTO_KEY_IF->get_key(x);
         if (ekp == NULL)
         {
             return CRYPTO_LIB_ERR_KEY_ID_ERROR;
@@ -403,7 +404,7 @@ int32_t Crypto_Key_verify(uint8_t* ingest, TC_t* tc_frame)
         ingest[count++] = (packet.blk[x].kid & 0x00FF);
 
         // Get Key
-        ekp = key_if->get_key(x);
+        ekp = CRYPTO_KEY_IF->get_key(x);
         if (ekp == NULL)
         {
             return CRYPTO_LIB_ERR_KEY_ID_ERROR;
@@ -419,7 +420,7 @@ int32_t Crypto_Key_verify(uint8_t* ingest, TC_t* tc_frame)
 
         // Encrypt challenge
         uint8_t ecs = CRYPTO_CIPHER_AES256_GCM;
-        cryptography_if->cryptography_aead_encrypt(&(ingest[count]), // ciphertext output
+        CRYPTO_CRYPTOGRAPHY_IF->cryptography_aead_encrypt(&(ingest[count]), // ciphertext output
                                                    (size_t)CHALLENGE_SIZE, // length of data
                                                    &(packet.blk[x].challenge[0]), // plaintext input
                                                    (size_t)CHALLENGE_SIZE, // in data length
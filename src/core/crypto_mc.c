@@ -20,6 +20,49 @@
 ** Includes
 */
 #include "crypto.h"
+#include <stdarg.h>
+#include <time.h>
+
+#include <pthread.h>
+
+/*
+** Event Rate Limiting
+*/
+typedef struct
+{
+    int32_t code;
+    uint8_t in_use;
+    uint64_t credit_ns;        // Token bucket, one event costs MC_EVENT_PERIOD_NS
+    uint64_t last_ns;
+    uint32_t suppressed;       // Dropped since the last reported event
+    uint32_t suppressed_total; // Dropped since Crypto_MC_Event_Reset
+} crypto_mc_event_bucket_t;
+
+#define MC_EVENT_PERIOD_NS (1000000000ULL / MC_EVENT_RATE)
+#define MC_EVENT_DETAIL_SIZE 256
+
+static crypto_mc_event_bucket_t mc_event_buckets[MC_EVENT_CODES];
+// Concurrent ApplySecurity callers and TM batch decrypt workers report through the same buckets
+static pthread_mutex_t mc_event_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+** Frame Rejection Budgets
+*/
+typedef struct
+{
+    crypto_gvcid_t gvcid;
+    uint8_t in_use;
+    uint64_t credit_ns;     // Token bucket, one rejected frame costs 1e9 / reject_rate ns
+    uint64_t last_ns;       // 0 until the first rejection
+    uint64_t shed_until_ns; // Frames are shed until then once the budget ran out
+    crypto_reject_counters_t counters;
+} crypto_reject_bucket_t;
+
+static crypto_reject_bucket_t reject_gvcid_buckets[REJECT_GVCID_SLOTS];
+static crypto_reject_bucket_t reject_sa_buckets[NUM_SA];
+// Latest time any bucket is shed until, admission skips the clock while it is 0
+static uint64_t reject_shed_horizon_ns;
+static pthread_mutex_t reject_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 /*
 ** Security Association Monitoring and Control
@@ -200,7 +243,7 @@ int32_t Crypto_SA_readARSN(uint8_t* ingest)
     ingest[count++] = (spi & 0xFF00) >> 8;
     ingest[count++] = (spi & 0x00FF);
 
-    if (sa_if->sa_get_from_spi(spi, &sa_ptr) != CRYPTO_LIB_SUCCESS)
+    if (CRYPTO_SA_IF->sa_get_from_spi(spi, &sa_ptr) != CRYPTO_LIB_SUCCESS)
     {
         // TODO - Error handling
         return CRYPTO_LIB_ERROR; // Error -- unable to get SA from SPI.
@@ -254,3 +297,405 @@ int32_t Crypto_MC_resetalarm(void)
     report.ispif = 0;
     return CRYPTO_LIB_SUCCESS;
 }
+
+/**
+ * @brief Function: Crypto_MC_Event_Now_Ns
+ * @return uint64: Monotonic time in nanoseconds
+ **/
+static uint64_t Crypto_MC_Event_Now_Ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Function: Crypto_MC_Event_Bucket
+ * Finds the rate limiting bucket for a status code, claiming a free one on first use.
+ * @param code: int32
+ * @return crypto_mc_event_bucket_t*: Bucket for the code
+ **/
+static crypto_mc_event_bucket_t* Crypto_MC_Event_Bucket(int32_t code)
+{
+    uint32_t start = (uint32_t)code % MC_EVENT_CODES;
+    uint32_t i;
+
+    for (i = 0; i < MC_EVENT_CODES; i++)
+    {
+        crypto_mc_event_bucket_t* bucket = &mc_event_buckets[(start + i) % MC_EVENT_CODES];
+        if (!bucket->in_use)
+        {
+            bucket->in_use = 1;
+            bucket->code = code;
+            bucket->credit_ns = MC_EVENT_BURST * MC_EVENT_PERIOD_NS;
+            bucket->last_ns = Crypto_MC_Event_Now_Ns();
+            return bucket;
+        }
+        if (bucket->code == code)
+        {
+            return bucket;
+        }
+    }
+    // Table full, untracked codes are limited together
+    return &mc_event_buckets[MC_EVENT_CODES - 1];
+}
+
+/**
+ * @brief Function: Crypto_MC_Event
+ * Reports a frame path failure to the MC interface.  Each status code has its own token bucket allowing
+ * MC_EVENT_BURST events back to back and MC_EVENT_RATE per second after that; events over the limit are only
+ * counted, and the count is attached to the next event that gets through.  The detail is formatted only for
+ * reported events, so a flood of bad frames costs a counter increment each.
+ * @param code: int32
+ * @param spi: uint16, MC_EVENT_SPI_NA if unknown
+ * @param gvcid: const crypto_gvcid_t*, NULL if unknown
+ * @param format: const char*, printf style detail
+ **/
+void Crypto_MC_Event(int32_t code, uint16_t spi, const crypto_gvcid_t* gvcid, const char* format, ...)
+{
+    crypto_mc_event_bucket_t* bucket;
+    uint64_t now;
+    uint64_t max_credit = MC_EVENT_BURST * MC_EVENT_PERIOD_NS;
+    uint32_t suppressed;
+    char detail[MC_EVENT_DETAIL_SIZE];
+    McEvent_t event;
+    va_list args;
+
+    pthread_mutex_lock(&mc_event_mutex);
+    bucket = Crypto_MC_Event_Bucket(code);
+    now = Crypto_MC_Event_Now_Ns();
+    bucket->credit_ns += now - bucket->last_ns;
+    if (bucket->credit_ns > max_credit)
+    {
+        bucket->credit_ns = max_credit;
+    }
+    bucket->last_ns = now;
+
+    if (bucket->credit_ns < MC_EVENT_PERIOD_NS)
+    {
+        bucket->suppressed++;
+        bucket->suppressed_total++;
+        pthread_mutex_unlock(&mc_event_mutex);
+        return;
+    }
+    bucket->credit_ns -= MC_EVENT_PERIOD_NS;
+    suppressed = bucket->suppressed;
+    bucket->suppressed = 0;
+    pthread_mutex_unlock(&mc_event_mutex);
+
+    detail[0] = '\0';
+    if (format != NULL)
+    {
+        va_start(args, format);
+        vsnprintf(detail, sizeof(detail), format, args);
+        va_end(args);
+    }
+
+    memset(&event, 0, sizeof(event));
+    event.code = code;
+    event.spi = spi;
+    if (gvcid != NULL)
+    {
+        event.has_gvcid = 1;
+        event.gvcid = *gvcid;
+    }
+    event.suppressed = suppressed;
+    event.detail = detail;
+
+    if (mc_if != NULL)
+    {
+        if (mc_if->mc_log_event != NULL)
+        {
+            mc_if->mc_log_event(&event);
+        }
+        else if (mc_if->mc_log_message != NULL)
+        {
+            mc_if->mc_log_message(detail);
+        }
+    }
+#ifdef DEBUG
+    printf(KRED "MC_Event: %d, %s" RESET, code, detail);
+    if (event.suppressed > 0)
+    {
+        printf(" (%u suppressed)", event.suppressed);
+    }
+    printf("\n");
+#endif
+}
+
+/**
+ * @brief Function: Crypto_MC_Event_Get_Suppressed
+ * @param code: int32
+ * @return uint32: Events with this code dropped by the rate limiter since the last reset
+ **/
+uint32_t Crypto_MC_Event_Get_Suppressed(int32_t code)
+{
+    uint32_t i;
+    for (i = 0; i < MC_EVENT_CODES; i++)
+    {
+        if (mc_event_buckets[i].in_use && mc_event_buckets[i].code == code)
+        {
+            return mc_event_buckets[i].suppressed_total;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Function: Crypto_MC_Event_Reset
+ * Clears all rate limiting state and suppression counters
+ **/
+void Crypto_MC_Event_Reset(void)
+{
+    pthread_mutex_lock(&mc_event_mutex);
+    memset(mc_event_buckets, 0, sizeof(mc_event_buckets));
+    pthread_mutex_unlock(&mc_event_mutex);
+}
+
+/**
+ * @brief Function: Crypto_MC_Reject_Gvcid_Bucket
+ * Finds the rejection bucket for a GVCID, claiming a free one on first use when claim is set.
+ * @param tfvn: uint8
+ * @param scid: uint16
+ * @param vcid: uint8
+ * @param claim: uint8
+ * @return crypto_reject_bucket_t*: Bucket for the GVCID, NULL if the GVCID has none and claim is not set
+ **/
+static crypto_reject_bucket_t* Crypto_MC_Reject_Gvcid_Bucket(uint8_t tfvn, uint16_t scid, uint8_t vcid, uint8_t claim)
+{
+    uint32_t start = (((uint32_t)tfvn << 16) | ((uint32_t)scid << 6) | vcid) % REJECT_GVCID_SLOTS;
+    uint32_t i;
+
+    for (i = 0; i < REJECT_GVCID_SLOTS; i++)
+    {
+        crypto_reject_bucket_t* bucket = &reject_gvcid_buckets[(start + i) % REJECT_GVCID_SLOTS];
+        if (!bucket->in_use)
+        {
+            if (!claim)
+            {
+                return NULL;
+            }
+            bucket->in_use = 1;
+            bucket->gvcid.tfvn = tfvn;
+            bucket->gvcid.scid = scid;
+            bucket->gvcid.vcid = vcid;
+            return bucket;
+        }
+        if (bucket->gvcid.tfvn == tfvn && bucket->gvcid.scid == scid && bucket->gvcid.vcid == vcid)
+        {
+            return bucket;
+        }
+    }
+    // Table full, untracked GVCIDs are budgeted together
+    return &reject_gvcid_buckets[REJECT_GVCID_SLOTS - 1];
+}
+
+/**
+ * @brief Function: Crypto_MC_Reject_Charge
+ * Takes a token for a rejected frame from a bucket when budgets are on.  The first rejection finding the bucket
+ * empty starts a hold-off.
+ * @param bucket: crypto_reject_bucket_t*
+ * @param now: uint64, monotonic ns
+ * @return uint8: CRYPTO_TRUE if a hold-off started
+ **/
+static uint8_t Crypto_MC_Reject_Charge(crypto_reject_bucket_t* bucket, uint64_t now)
+{
+    uint64_t period;
+    uint64_t max_credit;
+
+    if ((crypto_config.reject_burst == REJECT_BUDGET_OFF) || (crypto_config.reject_rate == 0) ||
+        (now < bucket->shed_until_ns))
+    {
+        return CRYPTO_FALSE;
+    }
+
+    period = 1000000000ULL / crypto_config.reject_rate;
+    max_credit = (uint64_t)crypto_config.reject_burst * period;
+    bucket->credit_ns = (bucket->last_ns == 0) ? max_credit : bucket->credit_ns + (now - bucket->last_ns);
+    if (bucket->credit_ns > max_credit)
+    {
+        bucket->credit_ns = max_credit;
+    }
+    bucket->last_ns = now;
+
+    if (bucket->credit_ns >= period)
+    {
+        bucket->credit_ns -= period;
+        return CRYPTO_FALSE;
+    }
+    bucket->shed_until_ns = now + ((uint64_t)crypto_config.reject_holdoff_ms * 1000000ULL);
+    bucket->counters.holdoffs++;
+    if (bucket->shed_until_ns > reject_shed_horizon_ns)
+    {
+        reject_shed_horizon_ns = bucket->shed_until_ns;
+    }
+    return CRYPTO_TRUE;
+}
+
+/**
+ * @brief Function: Crypto_MC_Reject_Admit
+ * Called by TC/TM/AOS processing right after header decode.  Frames of a GVCID or SA in a rejection hold-off are
+ * shed; any other frame is marked admitted so that a later failure is counted, and charged once its SA was located.
+ * With budgets off this takes no lock, and the clock is only read while some GVCID or SA is held off.
+ * @param desc: crypto_frame_desc_t*, decoded GVCID and SPI
+ * @return int32: Success or CRYPTO_LIB_ERR_FRAME_SHED
+ **/
+int32_t Crypto_MC_Reject_Admit(crypto_frame_desc_t* desc)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    crypto_reject_bucket_t* bucket = NULL;
+    uint64_t now;
+
+    if (crypto_config.reject_burst != REJECT_BUDGET_OFF)
+    {
+        pthread_mutex_lock(&reject_mutex);
+        if (reject_shed_horizon_ns != 0)
+        {
+            now = Crypto_MC_Event_Now_Ns();
+            if (now >= reject_shed_horizon_ns)
+            {
+                reject_shed_horizon_ns = 0;
+            }
+            else
+            {
+                bucket = Crypto_MC_Reject_Gvcid_Bucket(desc->tfvn, desc->scid, desc->vcid, CRYPTO_FALSE);
+                if ((bucket == NULL || now >= bucket->shed_until_ns) && (desc->spi < NUM_SA))
+                {
+                    bucket = &reject_sa_buckets[desc->spi];
+                }
+                if (bucket != NULL && now < bucket->shed_until_ns)
+                {
+                    bucket->counters.shed++;
+                    status = CRYPTO_LIB_ERR_FRAME_SHED;
+                }
+            }
+        }
+        pthread_mutex_unlock(&reject_mutex);
+    }
+    desc->admitted = (status == CRYPTO_LIB_SUCCESS);
+    return status;
+}
+
+/**
+ * @brief Function: Crypto_MC_Reject_Record
+ * Counts the final status of an admitted frame against its GVCID and the SPI it carried.  Both budgets are charged
+ * by the same rule: only when the frame got as far as its SA (desc->sa_located), so frames failing header, SPI, or
+ * SA state checks are counted but never start a hold-off.  Accepted frames, idle frames, and frames never admitted
+ * are not counted.  A budget running out is reported as a CRYPTO_LIB_ERR_FRAME_SHED MC event.
+ * @param desc: const crypto_frame_desc_t*
+ * @param status: int32, processing result of the frame
+ **/
+void Crypto_MC_Reject_Record(const crypto_frame_desc_t* desc, int32_t status)
+{
+    crypto_gvcid_t gvcid;
+    crypto_reject_bucket_t* gvcid_bucket = NULL;
+    crypto_reject_bucket_t* sa_bucket = NULL;
+    uint8_t gvcid_holdoff = CRYPTO_FALSE;
+    uint8_t sa_holdoff = CRYPTO_FALSE;
+    uint64_t now = 0;
+
+    if (!desc->admitted || (status == CRYPTO_LIB_SUCCESS) || (status == CRYPTO_LIB_ERR_IDLE_FRAME))
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&reject_mutex);
+    if (crypto_config.reject_burst != REJECT_BUDGET_OFF)
+    {
+        now = Crypto_MC_Event_Now_Ns();
+    }
+    gvcid_bucket = Crypto_MC_Reject_Gvcid_Bucket(desc->tfvn, desc->scid, desc->vcid, CRYPTO_TRUE);
+    gvcid_bucket->counters.rejected++;
+    if (desc->spi < NUM_SA)
+    {
+        sa_bucket = &reject_sa_buckets[desc->spi];
+        sa_bucket->counters.rejected++;
+    }
+    if (desc->sa_located)
+    {
+        gvcid_holdoff = Crypto_MC_Reject_Charge(gvcid_bucket, now);
+        sa_holdoff = (sa_bucket != NULL) && Crypto_MC_Reject_Charge(sa_bucket, now);
+    }
+    pthread_mutex_unlock(&reject_mutex);
+
+    memset(&gvcid, 0, sizeof(gvcid));
+    gvcid.tfvn = desc->tfvn;
+    gvcid.scid = desc->scid;
+    gvcid.vcid = desc->vcid;
+    if (gvcid_holdoff)
+    {
+        Crypto_MC_Event(CRYPTO_LIB_ERR_FRAME_SHED, desc->spi, &gvcid, "Rejection budget exhausted, shedding GVCID for %u ms",
+                        crypto_config.reject_holdoff_ms);
+    }
+    if (sa_holdoff)
+    {
+        Crypto_MC_Event(CRYPTO_LIB_ERR_FRAME_SHED, desc->spi, &gvcid, "Rejection budget exhausted, shedding SA for %u ms",
+                        crypto_config.reject_holdoff_ms);
+    }
+}
+
+/**
+ * @brief Function: Crypto_MC_Reject_Get_Gvcid_Counters
+ * @param tfvn: uint8
+ * @param scid: uint16
+ * @param vcid: uint8
+ * @param counters: crypto_reject_counters_t*, zeroed for a GVCID without rejected frames
+ * @return int32: Success/Failure
+ **/
+int32_t Crypto_MC_Reject_Get_Gvcid_Counters(uint8_t tfvn, uint16_t scid, uint8_t vcid, crypto_reject_counters_t* counters)
+{
+    crypto_reject_bucket_t* bucket;
+
+    if (counters == NULL)
+    {
+        return CRYPTO_LIB_ERR_NULL_BUFFER;
+    }
+    pthread_mutex_lock(&reject_mutex);
+    bucket = Crypto_MC_Reject_Gvcid_Bucket(tfvn, scid, vcid, CRYPTO_FALSE);
+    if (bucket != NULL)
+    {
+        *counters = bucket->counters;
+    }
+    else
+    {
+        memset(counters, 0, sizeof(crypto_reject_counters_t));
+    }
+    pthread_mutex_unlock(&reject_mutex);
+    return CRYPTO_LIB_SUCCESS;
+}
+
+/**
+ * @brief Function: Crypto_MC_Reject_Get_SA_Counters
+ * Frames rejected per SPI they carried, and that SA's own budget
+ * @param spi: uint16
+ * @param counters: crypto_reject_counters_t*
+ * @return int32: Success/Failure
+ **/
+int32_t Crypto_MC_Reject_Get_SA_Counters(uint16_t spi, crypto_reject_counters_t* counters)
+{
+    if (counters == NULL)
+    {
+        return CRYPTO_LIB_ERR_NULL_BUFFER;
+    }
+    if (spi >= NUM_SA)
+    {
+        return CRYPTO_LIB_ERR_SPI_INDEX_OOB;
+    }
+    pthread_mutex_lock(&reject_mutex);
+    *counters = reject_sa_buckets[spi].counters;
+    pthread_mutex_unlock(&reject_mutex);
+    return CRYPTO_LIB_SUCCESS;
+}
+
+/**
+ * @brief Function: Crypto_MC_Reject_Reset
+ * Clears all rejection budgets, hold-offs, and counters
+ **/
+void Crypto_MC_Reject_Reset(void)
+{
+    pthread_mutex_lock(&reject_mutex);
+    memset(reject_gvcid_buckets, 0, sizeof(reject_gvcid_buckets));
+    memset(reject_sa_buckets, 0, sizeof(reject_sa_buckets));
+    reject_shed_horizon_ns = 0;
+    pthread_mutex_unlock(&reject_mutex);
+}
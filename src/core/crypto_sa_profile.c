@@ -0,0 +1,486 @@
+/* Copyright (C) 2009 - 2022 National Aeronautics and Space Administration.
+   All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any kind, either expressed, implied, or statutory,
+   including, but not limited to, any warranty that the software will conform to specifications, any implied warranties
+   of merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+   documentation will conform to the program, or any warranty that the software will be error free.
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+   consequential damages, arising out of, resulting from, or in any way connected with the software or its
+   documentation, whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained
+   from, or arose out of the results of, or use of, the software, documentation or services provided hereunder.
+
+   ITC Team
+   NASA IV&V
+   jstar-development-team@mail.nasa.gov
+*/
+
+/*
+** Includes
+*/
+#include "crypto.h"
+
+#include <string.h> // memcpy, memcmp, memset
+
+/*
+** Profile Shape
+** Only the common operational shape is specialized: authenticated encryption with an AEAD cipher suite,
+** a fully transmitted 96-bit IV, a 128-bit MAC, no sequence number and no pad length field.
+** Every other SA keeps taking the generic ApplySecurity path.
+*/
+#define CRYPTO_SA_PROFILE_IV_LEN 12
+#define CRYPTO_SA_PROFILE_MAC_LEN 16
+
+// FECF handling baked into each specialized function
+#define CRYPTO_SA_PROFILE_FECF_NONE 0
+#define CRYPTO_SA_PROFILE_FECF_CALC 1
+#define CRYPTO_SA_PROFILE_FECF_ZERO 2
+
+#define CRYPTO_SA_PROFILE_TM_PRI_HDR_LEN 6
+
+/*
+** Static Library Declarations
+*/
+static CryptoSaProfile_t crypto_sa_profiles[CRYPTO_SA_PROFILE_SLOTS];
+
+/**
+ * @brief Function: crypto_sa_profile_build_key
+ * Captures everything the specialized functions assume about an SA and its channel
+ * @param key: CryptoSaProfileKey_t*
+ * @param sa_ptr: SecurityAssociation_t*
+ * @param frame_type: uint8_t
+ **/
+static void crypto_sa_profile_build_key(CryptoSaProfileKey_t* key, SecurityAssociation_t* sa_ptr, uint8_t frame_type)
+{
+    // Zeroed first so padding bytes compare equal
+    memset(key, 0, sizeof(CryptoSaProfileKey_t));
+    key->sa_ptr = sa_ptr;
+    key->managed_parameters = current_managed_parameters;
+    key->spi = sa_ptr->spi;
+    key->abm_len = sa_ptr->abm_len;
+    key->frame_type = frame_type;
+    key->est = sa_ptr->est;
+    key->ast = sa_ptr->ast;
+    key->ecs = sa_ptr->ecs;
+    key->ecs_len = sa_ptr->ecs_len;
+    key->acs = sa_ptr->acs;
+    key->acs_len = sa_ptr->acs_len;
+    key->shivf_len = sa_ptr->shivf_len;
+    key->iv_len = sa_ptr->iv_len;
+    key->shsnf_len = sa_ptr->shsnf_len;
+    key->shplf_len = sa_ptr->shplf_len;
+    key->stmacf_len = sa_ptr->stmacf_len;
+    key->has_fecf = current_managed_parameters->has_fecf;
+    key->has_segmentation_hdr = current_managed_parameters->has_segmentation_hdr;
+    key->has_ocf = current_managed_parameters->has_ocf;
+    key->iv_type = crypto_config.iv_type;
+    key->create_fecf = crypto_config.crypto_create_fecf;
+    key->cryptography_type = crypto_config.cryptography_type;
+}
+
+/**
+ * @brief Function: crypto_tc_apply_aead
+ * Body of the specialized TC ApplySecurity functions, byte for byte what the generic path produces for the profile shape
+ * Always inlined with constant lengths so each instantiation drops the branches that do not apply
+ * @param profile: const CryptoSaProfile_t*
+ * @param sa_ptr: SecurityAssociation_t*
+ * @param p_in_frame: const uint8_t*
+ * @param fl: uint16_t, frame length field of the input frame
+ * @param pp_enc_frame: uint8_t**
+ * @param p_enc_frame_len: uint16_t*
+ * @param cam_cookies: char*
+ * @param seg_len: uint8_t
+ * @param fecf_mode: uint8_t
+ * @return int32: Success/Failure
+ **/
+static inline __attribute__((always_inline)) int32_t
+crypto_tc_apply_aead(const CryptoSaProfile_t* profile, SecurityAssociation_t* sa_ptr, const uint8_t* p_in_frame,
+                     uint16_t fl, uint8_t** pp_enc_frame, uint16_t* p_enc_frame_len, char* cam_cookies,
+                     const uint8_t seg_len, const uint8_t fecf_mode)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    const uint16_t hdr_len = TC_FRAME_HEADER_SIZE + seg_len;
+    const uint16_t aad_len = hdr_len + SPI_LEN + CRYPTO_SA_PROFILE_IV_LEN;
+    const uint16_t fecf_len = (fecf_mode == CRYPTO_SA_PROFILE_FECF_NONE) ? 0 : FECF_SIZE;
+    uint16_t tf_payload_len = fl - hdr_len - fecf_len + 1;
+    uint16_t new_enc_frame_header_field_length = 0;
+    uint8_t aad[TC_FRAME_HEADER_SIZE + TC_SEGMENT_HDR_SIZE + SPI_LEN + CRYPTO_SA_PROFILE_IV_LEN];
+    uint8_t* p_new_enc_frame = NULL;
+    crypto_key_t* ekp = NULL;
+    crypto_sa_counters_t counters;
+    uint16_t i;
+
+    *p_enc_frame_len = fl + 1 + SPI_LEN + CRYPTO_SA_PROFILE_IV_LEN + CRYPTO_SA_PROFILE_MAC_LEN;
+    new_enc_frame_header_field_length = (*p_enc_frame_len) - 1;
+
+    status = Crypto_TC_Frame_Validation(p_enc_frame_len);
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        return status;
+    }
+    // Every byte is written below, no need to clear the buffer
+    p_new_enc_frame = (uint8_t*)malloc(*p_enc_frame_len);
+    if (p_new_enc_frame == NULL)
+    {
+        status = CRYPTO_LIB_ERROR;
+        CRYPTO_MC_IF->mc_log(status);
+        return status;
+    }
+
+    // Copy original TF header, w/ segment header if applicable, and set the new length
+    memcpy(p_new_enc_frame, p_in_frame, hdr_len);
+    p_new_enc_frame[2] = (p_new_enc_frame[2] & 0xFC) | ((new_enc_frame_header_field_length & 0x0300) >> 8);
+    p_new_enc_frame[3] = new_enc_frame_header_field_length & 0x00FF;
+
+    status = Crypto_SA_Counters_Reserve(sa_ptr, SA_AUTHENTICATED_ENCRYPTION, &counters);
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        free(p_new_enc_frame);
+        return status;
+    }
+
+    // Security header is the SPI template followed by the whole IV
+    p_new_enc_frame[hdr_len] = profile->spi_hdr[0];
+    p_new_enc_frame[hdr_len + 1] = profile->spi_hdr[1];
+    memcpy(p_new_enc_frame + hdr_len + SPI_LEN, counters.iv, CRYPTO_SA_PROFILE_IV_LEN);
+
+    for (i = 0; i < aad_len; i++)
+    {
+        aad[i] = p_new_enc_frame[i] & sa_ptr->abm[i];
+    }
+
+    ekp = CRYPTO_KEY_IF->get_key(sa_ptr->ekid);
+    if (ekp == NULL)
+    {
+        status = CRYPTO_LIB_ERR_KEY_ID_ERROR;
+    }
+    else if (ekp->key_len != profile->ecs_key_len)
+    {
+        status = CRYPTO_LIB_ERR_KEY_LENGTH_ERROR;
+    }
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_aead_encrypt(p_new_enc_frame + aad_len,                    // ciphertext output
+                                                                   (size_t)tf_payload_len,                       // length of data
+                                                                   (uint8_t*)(p_in_frame + hdr_len),             // plaintext input
+                                                                   (size_t)tf_payload_len,                       // in data length
+                                                                   &(ekp->value[0]),                             // Key
+                                                                   profile->ecs_key_len,                         // Length of key
+                                                                   sa_ptr,                                       // SA (for key reference)
+                                                                   counters.iv,                                  // IV
+                                                                   CRYPTO_SA_PROFILE_IV_LEN,                     // IV Length
+                                                                   p_new_enc_frame + aad_len + tf_payload_len,   // tag output
+                                                                   CRYPTO_SA_PROFILE_MAC_LEN,                    // tag size
+                                                                   aad,                                          // AAD Input
+                                                                   aad_len,                                      // Length of AAD
+                                                                   CRYPTO_TRUE,
+                                                                   CRYPTO_TRUE,
+                                                                   CRYPTO_TRUE,
+                                                                   &sa_ptr->ecs, // encryption cipher
+                                                                   &sa_ptr->acs, // authentication cipher
+                                                                   cam_cookies);
+    }
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        free(p_new_enc_frame);
+        Crypto_SA_Counters_Gap(sa_ptr->spi, 1);
+        CRYPTO_MC_IF->mc_log(status);
+        return status;
+    }
+
+    if (fecf_mode == CRYPTO_SA_PROFILE_FECF_CALC)
+    {
+        uint16_t new_fecf = Crypto_Calc_FECF(p_new_enc_frame, new_enc_frame_header_field_length - 1);
+        p_new_enc_frame[new_enc_frame_header_field_length - 1] = (uint8_t)((new_fecf & 0xFF00) >> 8);
+        p_new_enc_frame[new_enc_frame_header_field_length] = (uint8_t)(new_fecf & 0x00FF);
+    }
+    else if (fecf_mode == CRYPTO_SA_PROFILE_FECF_ZERO)
+    {
+        p_new_enc_frame[new_enc_frame_header_field_length - 1] = 0x00;
+        p_new_enc_frame[new_enc_frame_header_field_length] = 0x00;
+    }
+
+    *pp_enc_frame = p_new_enc_frame;
+
+    status = CRYPTO_SA_IF->sa_save_sa(sa_ptr);
+    CRYPTO_MC_IF->mc_log(status);
+    return status;
+}
+
+/**
+ * @brief Function: crypto_tm_apply_aead
+ * Body of the specialized TM ApplySecurity functions, in place on a frame without a secondary header
+ * Always inlined with constant lengths so each instantiation drops the branches that do not apply
+ * @param profile: const CryptoSaProfile_t*
+ * @param sa_ptr: SecurityAssociation_t*
+ * @param pTfBuffer: uint8_t*
+ * @param ocf_len: uint8_t
+ * @param fecf_mode: uint8_t
+ * @return int32: Success/Failure
+ **/
+static inline __attribute__((always_inline)) int32_t
+crypto_tm_apply_aead(const CryptoSaProfile_t* profile, SecurityAssociation_t* sa_ptr, uint8_t* pTfBuffer,
+                     const uint8_t ocf_len, const uint8_t fecf_mode)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    const uint16_t data_loc = CRYPTO_SA_PROFILE_TM_PRI_HDR_LEN + SPI_LEN + CRYPTO_SA_PROFILE_IV_LEN;
+    const uint16_t fecf_len = (fecf_mode == CRYPTO_SA_PROFILE_FECF_NONE) ? 0 : FECF_SIZE;
+    const uint16_t frame_len = current_managed_parameters->max_frame_size;
+    uint16_t pdu_len = frame_len - data_loc - CRYPTO_SA_PROFILE_MAC_LEN - ocf_len - fecf_len;
+    uint8_t aad[CRYPTO_SA_PROFILE_TM_PRI_HDR_LEN + SPI_LEN + CRYPTO_SA_PROFILE_IV_LEN];
+    crypto_key_t* ekp = NULL;
+    crypto_sa_counters_t counters;
+
+    status = Crypto_SA_Counters_Reserve(sa_ptr, SA_AUTHENTICATED_ENCRYPTION, &counters);
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        return status;
+    }
+
+    pTfBuffer[CRYPTO_SA_PROFILE_TM_PRI_HDR_LEN] = profile->spi_hdr[0];
+    pTfBuffer[CRYPTO_SA_PROFILE_TM_PRI_HDR_LEN + 1] = profile->spi_hdr[1];
+    memcpy(pTfBuffer + CRYPTO_SA_PROFILE_TM_PRI_HDR_LEN + SPI_LEN, counters.iv, CRYPTO_SA_PROFILE_IV_LEN);
+
+    ekp = CRYPTO_KEY_IF->get_key(sa_ptr->ekid);
+    if (ekp == NULL)
+    {
+        status = CRYPTO_LIB_ERR_KEY_ID_ERROR;
+        Crypto_SA_Counters_Gap(sa_ptr->spi, 1);
+        CRYPTO_MC_IF->mc_log(status);
+        return status;
+    }
+
+    Crypto_Prepare_TM_AAD(pTfBuffer, data_loc, sa_ptr->abm, aad);
+    status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_aead_encrypt(&pTfBuffer[data_loc],            // ciphertext output
+                                                               (size_t)pdu_len,                 // length of data
+                                                               &pTfBuffer[data_loc],            // plaintext input
+                                                               (size_t)pdu_len,                 // in data length
+                                                               &(ekp->value[0]),                // Key
+                                                               profile->ecs_key_len,            // Length of key
+                                                               sa_ptr,                          // SA (for key reference)
+                                                               counters.iv,                     // IV
+                                                               CRYPTO_SA_PROFILE_IV_LEN,        // IV Length
+                                                               &pTfBuffer[data_loc + pdu_len],  // tag output
+                                                               CRYPTO_SA_PROFILE_MAC_LEN,       // tag size
+                                                               aad,                             // AAD Input
+                                                               data_loc,                        // Length of AAD
+                                                               CRYPTO_TRUE,
+                                                               CRYPTO_TRUE,
+                                                               CRYPTO_TRUE,
+                                                               &sa_ptr->ecs, // encryption cipher
+                                                               &sa_ptr->acs, // authentication cipher
+                                                               NULL);
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        Crypto_SA_Counters_Gap(sa_ptr->spi, 1);
+        return status;
+    }
+
+    if (fecf_mode == CRYPTO_SA_PROFILE_FECF_CALC)
+    {
+        uint16_t new_fecf = Crypto_Calc_FECF(pTfBuffer, frame_len - 2);
+        pTfBuffer[frame_len - 2] = (uint8_t)((new_fecf & 0xFF00) >> 8);
+        pTfBuffer[frame_len - 1] = (uint8_t)(new_fecf & 0x00FF);
+    }
+    else if (fecf_mode == CRYPTO_SA_PROFILE_FECF_ZERO)
+    {
+        pTfBuffer[frame_len - 2] = 0x00;
+        pTfBuffer[frame_len - 1] = 0x00;
+    }
+
+    status = CRYPTO_SA_IF->sa_save_sa(sa_ptr);
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        CRYPTO_MC_IF->mc_log(status);
+    }
+    return status;
+}
+
+/*
+** Specialized Instantiations
+*/
+#define CRYPTO_SA_PROFILE_TC_APPLY(name, seg_len, fecf_mode)                                                        \
+    static int32_t name(const CryptoSaProfile_t* profile, SecurityAssociation_t* sa_ptr, const uint8_t* p_in_frame, \
+                        uint16_t fl, uint8_t** pp_enc_frame, uint16_t* p_enc_frame_len, char* cam_cookies)          \
+    {                                                                                                               \
+        return crypto_tc_apply_aead(profile, sa_ptr, p_in_frame, fl, pp_enc_frame, p_enc_frame_len, cam_cookies,   \
+                                    seg_len, fecf_mode);                                                            \
+    }
+
+#define CRYPTO_SA_PROFILE_TM_APPLY(name, ocf_len, fecf_mode)                                       \
+    static int32_t name(const CryptoSaProfile_t* profile, SecurityAssociation_t* sa_ptr, uint8_t* pTfBuffer) \
+    {                                                                                              \
+        return crypto_tm_apply_aead(profile, sa_ptr, pTfBuffer, ocf_len, fecf_mode);               \
+    }
+
+CRYPTO_SA_PROFILE_TC_APPLY(crypto_tc_apply_aead_noseg_nofecf, 0, CRYPTO_SA_PROFILE_FECF_NONE)
+CRYPTO_SA_PROFILE_TC_APPLY(crypto_tc_apply_aead_noseg_fecf, 0, CRYPTO_SA_PROFILE_FECF_CALC)
+CRYPTO_SA_PROFILE_TC_APPLY(crypto_tc_apply_aead_noseg_zerofecf, 0, CRYPTO_SA_PROFILE_FECF_ZERO)
+CRYPTO_SA_PROFILE_TC_APPLY(crypto_tc_apply_aead_seg_nofecf, TC_SEGMENT_HDR_SIZE, CRYPTO_SA_PROFILE_FECF_NONE)
+CRYPTO_SA_PROFILE_TC_APPLY(crypto_tc_apply_aead_seg_fecf, TC_SEGMENT_HDR_SIZE, CRYPTO_SA_PROFILE_FECF_CALC)
+CRYPTO_SA_PROFILE_TC_APPLY(crypto_tc_apply_aead_seg_zerofecf, TC_SEGMENT_HDR_SIZE, CRYPTO_SA_PROFILE_FECF_ZERO)
+
+CRYPTO_SA_PROFILE_TM_APPLY(crypto_tm_apply_aead_noocf_nofecf, 0, CRYPTO_SA_PROFILE_FECF_NONE)
+CRYPTO_SA_PROFILE_TM_APPLY(crypto_tm_apply_aead_noocf_fecf, 0, CRYPTO_SA_PROFILE_FECF_CALC)
+CRYPTO_SA_PROFILE_TM_APPLY(crypto_tm_apply_aead_noocf_zerofecf, 0, CRYPTO_SA_PROFILE_FECF_ZERO)
+CRYPTO_SA_PROFILE_TM_APPLY(crypto_tm_apply_aead_ocf_nofecf, OCF_SIZE, CRYPTO_SA_PROFILE_FECF_NONE)
+CRYPTO_SA_PROFILE_TM_APPLY(crypto_tm_apply_aead_ocf_fecf, OCF_SIZE, CRYPTO_SA_PROFILE_FECF_CALC)
+CRYPTO_SA_PROFILE_TM_APPLY(crypto_tm_apply_aead_ocf_zerofecf, OCF_SIZE, CRYPTO_SA_PROFILE_FECF_ZERO)
+
+/**
+ * @brief Function: crypto_sa_profile_is_aead_shape
+ * Checks the frame type independent part of the profile shape
+ * @param key: const CryptoSaProfileKey_t*
+ * @return uint8_t: CRYPTO_TRUE/CRYPTO_FALSE
+ **/
+static uint8_t crypto_sa_profile_is_aead_shape(const CryptoSaProfileKey_t* key)
+{
+    if ((key->est != 1) || (key->ast != 1))
+    {
+        return CRYPTO_FALSE;
+    }
+    if ((key->ecs != CRYPTO_CIPHER_AES256_GCM) && (key->ecs != CRYPTO_CIPHER_AES256_GCM_SIV) &&
+        (key->ecs != CRYPTO_CIPHER_CHACHA20_POLY1305))
+    {
+        return CRYPTO_FALSE;
+    }
+    if ((key->iv_len != CRYPTO_SA_PROFILE_IV_LEN) || (key->shivf_len != CRYPTO_SA_PROFILE_IV_LEN) ||
+        (key->stmacf_len != CRYPTO_SA_PROFILE_MAC_LEN) || (key->shsnf_len != 0) || (key->shplf_len != 0))
+    {
+        return CRYPTO_FALSE;
+    }
+    // KMC owns IVs and buffers on its side
+    if (key->cryptography_type == CRYPTOGRAPHY_TYPE_KMCCRYPTO)
+    {
+        return CRYPTO_FALSE;
+    }
+    return CRYPTO_TRUE;
+}
+
+/**
+ * @brief Function: crypto_sa_profile_compile
+ * Picks the specialized functions for the shape captured in the profile key
+ * @param profile: CryptoSaProfile_t*
+ **/
+static void crypto_sa_profile_compile(CryptoSaProfile_t* profile)
+{
+    const CryptoSaProfileKey_t* key = &profile->key;
+    uint8_t fecf_mode = CRYPTO_SA_PROFILE_FECF_NONE;
+
+    profile->tc_apply = NULL;
+    profile->tm_apply = NULL;
+    profile->spi_hdr[0] = (key->spi & 0xFF00) >> 8;
+    profile->spi_hdr[1] = key->spi & 0x00FF;
+    profile->ecs_key_len = (uint16_t)Crypto_Get_ECS_Algo_Keylen(key->ecs);
+    profile->valid = 1;
+
+    if (crypto_sa_profile_is_aead_shape(key) == CRYPTO_FALSE)
+    {
+        return;
+    }
+
+    if (key->frame_type == TYPE_TC)
+    {
+        uint8_t seg_len = (key->has_segmentation_hdr == TC_HAS_SEGMENT_HDRS) ? TC_SEGMENT_HDR_SIZE : 0;
+        if ((key->iv_type != IV_INTERNAL) ||
+            ((key->has_segmentation_hdr != TC_HAS_SEGMENT_HDRS) && (key->has_segmentation_hdr != TC_NO_SEGMENT_HDRS)) ||
+            ((key->has_fecf != TC_HAS_FECF) && (key->has_fecf != TC_NO_FECF)) ||
+            (key->abm_len < TC_FRAME_HEADER_SIZE + seg_len + SPI_LEN + CRYPTO_SA_PROFILE_IV_LEN))
+        {
+            return;
+        }
+        if (key->has_fecf == TC_HAS_FECF)
+        {
+            fecf_mode = (key->create_fecf == CRYPTO_TC_CREATE_FECF_TRUE) ? CRYPTO_SA_PROFILE_FECF_CALC
+                                                                         : CRYPTO_SA_PROFILE_FECF_ZERO;
+        }
+        switch (fecf_mode)
+        {
+        case CRYPTO_SA_PROFILE_FECF_CALC:
+            profile->tc_apply = seg_len ? crypto_tc_apply_aead_seg_fecf : crypto_tc_apply_aead_noseg_fecf;
+            break;
+        case CRYPTO_SA_PROFILE_FECF_ZERO:
+            profile->tc_apply = seg_len ? crypto_tc_apply_aead_seg_zerofecf : crypto_tc_apply_aead_noseg_zerofecf;
+            break;
+        default:
+            profile->tc_apply = seg_len ? crypto_tc_apply_aead_seg_nofecf : crypto_tc_apply_aead_noseg_nofecf;
+            break;
+        }
+    }
+    else if (key->frame_type == TYPE_TM)
+    {
+        uint8_t has_ocf = (key->has_ocf == TM_HAS_OCF);
+        if (((key->ecs_len == 0) && (key->acs_len == 0)) ||
+            (key->abm_len < CRYPTO_SA_PROFILE_TM_PRI_HDR_LEN + SPI_LEN + CRYPTO_SA_PROFILE_IV_LEN))
+        {
+            return;
+        }
+        if (key->has_fecf == TM_HAS_FECF)
+        {
+            fecf_mode = (key->create_fecf == CRYPTO_TM_CREATE_FECF_TRUE) ? CRYPTO_SA_PROFILE_FECF_CALC
+                                                                         : CRYPTO_SA_PROFILE_FECF_ZERO;
+        }
+        switch (fecf_mode)
+        {
+        case CRYPTO_SA_PROFILE_FECF_CALC:
+            profile->tm_apply = has_ocf ? crypto_tm_apply_aead_ocf_fecf : crypto_tm_apply_aead_noocf_fecf;
+            break;
+        case CRYPTO_SA_PROFILE_FECF_ZERO:
+            profile->tm_apply = has_ocf ? crypto_tm_apply_aead_ocf_zerofecf : crypto_tm_apply_aead_noocf_zerofecf;
+            break;
+        default:
+            profile->tm_apply = has_ocf ? crypto_tm_apply_aead_ocf_nofecf : crypto_tm_apply_aead_noocf_nofecf;
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Function: Crypto_SA_Profile_Get
+ * Returns the compiled profile for an SA on the current managed parameters, compiling it on first use
+ * The shape is compared on every frame so SAs changed through the SA interface or directly fall back correctly
+ * @param sa_ptr: SecurityAssociation_t*
+ * @param frame_type: uint8_t, TYPE_TC or TYPE_TM
+ * @return const CryptoSaProfile_t*: Profile with a specialized function for the frame type, NULL for the generic path
+ **/
+const CryptoSaProfile_t* Crypto_SA_Profile_Get(SecurityAssociation_t* sa_ptr, uint8_t frame_type)
+{
+    CryptoSaProfileKey_t key;
+    CryptoSaProfile_t* profile = NULL;
+
+    if ((sa_ptr == NULL) || (current_managed_parameters == NULL))
+    {
+        return NULL;
+    }
+
+    crypto_sa_profile_build_key(&key, sa_ptr, frame_type);
+    profile = &crypto_sa_profiles[sa_ptr->spi & (CRYPTO_SA_PROFILE_SLOTS - 1)];
+    if ((profile->valid == 0) || (memcmp(&profile->key, &key, sizeof(CryptoSaProfileKey_t)) != 0))
+    {
+        memcpy(&profile->key, &key, sizeof(CryptoSaProfileKey_t));
+        crypto_sa_profile_compile(profile);
+    }
+
+    if (((frame_type == TYPE_TC) && (profile->tc_apply != NULL)) ||
+        ((frame_type == TYPE_TM) && (profile->tm_apply != NULL)))
+    {
+        return profile;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Function: Crypto_SA_Profile_Flush
+ * Drops the compiled profile of an SA so the next frame recompiles it
+ * @param spi: uint16_t, CRYPTOGRAPHY_FLUSH_ALL_SA for every SA
+ **/
+void Crypto_SA_Profile_Flush(uint16_t spi)
+{
+    if (spi == CRYPTOGRAPHY_FLUSH_ALL_SA)
+    {
+        memset(crypto_sa_profiles, 0, sizeof(crypto_sa_profiles));
+        return;
+    }
+    memset(&crypto_sa_profiles[spi & (CRYPTO_SA_PROFILE_SLOTS - 1)], 0, sizeof(CryptoSaProfile_t));
+}
@@ -0,0 +1,507 @@
+/* Copyright (C) 2009 - 2022 National Aeronautics and Space Administration.
+   All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any kind, either expressed, implied, or statutory,
+   including, but not limited to, any warranty that the software will conform to specifications, any implied warranties
+   of merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+   documentation will conform to the program, or any warranty that the software will be error free.
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+   consequential damages, arising out of, resulting from, or in any way connected with the software or its
+   documentation, whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained
+   from, or arose out of the results of, or use of, the software, documentation or services provided hereunder.
+
+   ITC Team
+   NASA IV&V
+   jstar-development-team@mail.nasa.gov
+*/
+
+/*
+** Includes
+*/
+#include "crypto.h"
+
+#include <fcntl.h>
+#include <stddef.h> // offsetof
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+** State Snapshot
+** The configuration, managed parameters, idle frame handling, SA table, and key ring of an initialized library
+** written to one file.  Loading maps the file and copies each section straight into place, skipping the
+** configuration calls, SA population, and key ring setup that Crypto_Init would otherwise run.  The key ring is stored encrypted with
+** AES-256-GCM under a caller supplied master key; the other sections carry a CRC32.
+*/
+
+// Set while Crypto_Init runs on behalf of a snapshot load, the SA and key modules are filled afterwards
+uint8_t crypto_snapshot_restore = CRYPTO_FALSE;
+
+/* Helper functions */
+static uint32_t crypto_snapshot_length(const crypto_snapshot_header_t* header);
+static int32_t crypto_snapshot_check_header(const crypto_snapshot_header_t* header, size_t file_len);
+static int32_t crypto_snapshot_write(const char* path, const uint8_t* image, uint32_t image_len);
+static int32_t crypto_snapshot_restore_tables(const crypto_snapshot_header_t* header, const uint8_t* image,
+                                              const uint8_t* master_key, uint16_t master_key_len);
+
+/**
+ * @brief Function: Crypto_Snapshot_Save
+ * Writes the current configuration, managed parameters, idle frame handling, SA table, and key ring to path.  Only the internal key
+ * ring and in-memory SA database are held by the library, so other module types are not supported.
+ * @param path: const char*
+ * @param master_key: const uint8_t*, AES-256 key the key ring is encrypted under
+ * @param master_key_len: uint16_t
+ * @return int32: Success/Failure
+ **/
+int32_t Crypto_Snapshot_Save(const char* path, const uint8_t* master_key, uint16_t master_key_len)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    crypto_snapshot_header_t* header = NULL;
+    uint8_t* image = NULL;
+    uint8_t* plain_keys = NULL;
+    uint8_t* section = NULL;
+    uint32_t image_len = 0;
+    uint32_t keys_len = 0;
+    uint8_t ecs = CRYPTO_CIPHER_AES256_GCM;
+    uint8_t acs = CRYPTO_MAC_NONE;
+    SecurityAssociation_t* sa_ptr = NULL;
+    crypto_key_t* key_ptr = NULL;
+    crypto_snapshot_key_t* record = NULL;
+    GvcidIdleFrames_t* idle_frames = NULL;
+    FILE* random_file = NULL;
+    uint32_t i;
+
+    if ((path == NULL) || (master_key == NULL))
+    {
+        return CRYPTO_LIB_ERR_NULL_BUFFER;
+    }
+    if ((crypto_config.init_status == UNITIALIZED) || (sa_if == NULL) || (key_if == NULL) || (cryptography_if == NULL))
+    {
+        return CRYPTO_LIB_ERR_NO_INIT;
+    }
+    if (master_key_len != Crypto_Get_ECS_Algo_Keylen(ecs))
+    {
+        return CRYPTO_LIB_ERR_KEY_LENGTH_ERROR;
+    }
+    if ((crypto_config.key_type != KEY_TYPE_INTERNAL) || (crypto_config.sa_type != SA_TYPE_INMEMORY))
+    {
+        return CRYPTO_LIB_ERR_SNAPSHOT_UNSUPPORTED;
+    }
+
+    header = (crypto_snapshot_header_t*)calloc(1, sizeof(crypto_snapshot_header_t));
+    if (header == NULL)
+    {
+        return CRYPTO_LIB_ERROR;
+    }
+    header->magic = CRYPTO_SNAPSHOT_MAGIC;
+    header->version = CRYPTO_SNAPSHOT_VERSION;
+    header->config_size = CRYPTO_CONFIG_SIZE;
+    header->gvcid_size = GVCID_MANAGED_PARAMETERS_SIZE;
+    header->idle_size = GVCID_IDLE_FRAMES_SIZE;
+    header->sa_size = SA_SIZE;
+    header->key_size = CRYPTO_SNAPSHOT_KEY_SIZE;
+    header->num_gvcid = gvcid_counter;
+    header->num_sa = NUM_SA;
+    header->num_keys = NUM_KEYS;
+
+    image_len = crypto_snapshot_length(header);
+    keys_len = NUM_KEYS * CRYPTO_SNAPSHOT_KEY_SIZE;
+    image = (uint8_t*)calloc(1, image_len);
+    plain_keys = (uint8_t*)calloc(1, keys_len);
+    if ((image == NULL) || (plain_keys == NULL))
+    {
+        status = CRYPTO_LIB_ERROR;
+    }
+
+    // Plaintext sections
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        section = image + sizeof(crypto_snapshot_header_t);
+        memcpy(section, &crypto_config, CRYPTO_CONFIG_SIZE);
+        header->config_crc = Crypto_Calc_CRC32(section, CRYPTO_CONFIG_SIZE);
+        section += CRYPTO_CONFIG_SIZE;
+
+        memcpy(section, gvcid_managed_parameters_array, header->num_gvcid * GVCID_MANAGED_PARAMETERS_SIZE);
+        header->gvcid_crc = Crypto_Calc_CRC32(section, header->num_gvcid * GVCID_MANAGED_PARAMETERS_SIZE);
+        section += header->num_gvcid * GVCID_MANAGED_PARAMETERS_SIZE;
+
+        idle_frames = (GvcidIdleFrames_t*)section;
+        for (i = 0; i < header->num_gvcid; i++)
+        {
+            idle_frames[i] = *Crypto_Get_Idle_Frames_For_Managed_Parameters(&gvcid_managed_parameters_array[i]);
+        }
+        header->idle_crc = Crypto_Calc_CRC32(section, header->num_gvcid * GVCID_IDLE_FRAMES_SIZE);
+        section += header->num_gvcid * GVCID_IDLE_FRAMES_SIZE;
+
+        for (i = 0; i < NUM_SA; i++)
+        {
+            // Lookup status only flags SA contents, the entry is returned regardless
+            CRYPTO_SA_IF->sa_get_from_spi(i, &sa_ptr);
+            memcpy(section + (i * SA_SIZE), sa_ptr, SA_SIZE);
+        }
+        header->sa_crc = Crypto_Calc_CRC32(section, NUM_SA * SA_SIZE);
+        section += NUM_SA * SA_SIZE;
+
+        for (i = 0; i < NUM_KEYS; i++)
+        {
+            key_ptr = CRYPTO_KEY_IF->get_key(i);
+            if (key_ptr != NULL)
+            {
+                record = (crypto_snapshot_key_t*)(plain_keys + (i * CRYPTO_SNAPSHOT_KEY_SIZE));
+                memcpy(record->value, key_ptr->value, KEY_SIZE);
+                record->key_len = key_ptr->key_len;
+                record->key_state = key_ptr->key_state;
+            }
+        }
+    }
+
+    // Fresh IV for every save, the master key is long lived
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        random_file = fopen("/dev/urandom", "rb");
+        if ((random_file == NULL) || (fread(header->key_iv, 1, CRYPTO_SNAPSHOT_IV_SIZE, random_file) != CRYPTO_SNAPSHOT_IV_SIZE))
+        {
+            status = CRYPTO_LIB_ERR_SNAPSHOT_IO;
+        }
+        if (random_file != NULL)
+        {
+            fclose(random_file);
+        }
+    }
+
+    // Key ring, the tag also covers the header so sizes and checksums cannot be swapped under it
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_aead_encrypt(section, // ciphertext output
+                                                                   keys_len, // length of data
+                                                                   plain_keys, // plaintext input
+                                                                   keys_len, // in data length
+                                                                   (uint8_t*)master_key, // Key
+                                                                   master_key_len,
+                                                                   NULL, // No SA, key passed explicitly
+                                                                   header->key_iv, // IV
+                                                                   CRYPTO_SNAPSHOT_IV_SIZE, // IV Length
+                                                                   header->key_tag, // tag output
+                                                                   CRYPTO_SNAPSHOT_TAG_SIZE, // tag size
+                                                                   (uint8_t*)header, // AAD Input
+                                                                   offsetof(crypto_snapshot_header_t, key_tag), // Length of AAD
+                                                                   CRYPTO_TRUE, // Encryption Bool
+                                                                   CRYPTO_TRUE, // Authentication Bool
+                                                                   CRYPTO_TRUE, // AAD Bool
+                                                                   &ecs, // encryption cipher
+                                                                   &acs, // authentication cipher
+                                                                   NULL);
+    }
+
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        header->header_crc = Crypto_Calc_CRC32((uint8_t*)header, offsetof(crypto_snapshot_header_t, header_crc));
+        memcpy(image, header, sizeof(crypto_snapshot_header_t));
+        status = crypto_snapshot_write(path, image, image_len);
+    }
+
+    if (plain_keys != NULL)
+    {
+        memset(plain_keys, 0, keys_len);
+        free(plain_keys);
+    }
+    free(image);
+    free(header);
+    if ((status != CRYPTO_LIB_SUCCESS) && (mc_if != NULL))
+    {
+        CRYPTO_MC_IF->mc_log(status);
+    }
+    return status;
+}
+
+/**
+ * @brief Function: Crypto_Init_From_Snapshot
+ * Initializes CryptoLib from a file written by Crypto_Snapshot_Save, in place of the Crypto_Config_* calls
+ * and Crypto_Init.  The file is mapped rather than read; its header, section checksums, and key ring tag are
+ * checked but the SA and key validation passes of a normal init are not repeated, as the snapshot was taken
+ * from an initialized library.
+ * @param path: const char*
+ * @param master_key: const uint8_t*, AES-256 key the key ring was encrypted under
+ * @param master_key_len: uint16_t
+ * @return int32: Success/Failure
+ **/
+int32_t Crypto_Init_From_Snapshot(const char* path, const uint8_t* master_key, uint16_t master_key_len)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    const crypto_snapshot_header_t* header = NULL;
+    const uint8_t* section = NULL;
+    const GvcidIdleFrames_t* idle_frames = NULL;
+    uint8_t* image = MAP_FAILED;
+    struct stat file_stat;
+    uint32_t gvcid_len = 0;
+    uint32_t idle_len = 0;
+    int fd = -1;
+    uint32_t i;
+
+    if ((path == NULL) || (master_key == NULL))
+    {
+        return CRYPTO_LIB_ERR_NULL_BUFFER;
+    }
+
+    // Header and section checksums need the CRC table before Crypto_Init builds it
+    Crypto_Calc_CRC_Init_Table();
+
+    fd = open(path, O_RDONLY);
+    if ((fd < 0) || (fstat(fd, &file_stat) != 0))
+    {
+        status = CRYPTO_LIB_ERR_SNAPSHOT_IO;
+    }
+    if ((status == CRYPTO_LIB_SUCCESS) && ((size_t)file_stat.st_size < sizeof(crypto_snapshot_header_t)))
+    {
+        status = CRYPTO_LIB_ERR_SNAPSHOT_INVALID;
+    }
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        image = (uint8_t*)mmap(NULL, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (image == MAP_FAILED)
+        {
+            status = CRYPTO_LIB_ERR_SNAPSHOT_IO;
+        }
+    }
+
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        header = (const crypto_snapshot_header_t*)image;
+        status = crypto_snapshot_check_header(header, file_stat.st_size);
+    }
+
+    // Plaintext sections
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        section = image + sizeof(crypto_snapshot_header_t);
+        gvcid_len = header->num_gvcid * GVCID_MANAGED_PARAMETERS_SIZE;
+        idle_len = header->num_gvcid * GVCID_IDLE_FRAMES_SIZE;
+        if ((Crypto_Calc_CRC32(section, CRYPTO_CONFIG_SIZE) != header->config_crc) ||
+            (Crypto_Calc_CRC32(section + CRYPTO_CONFIG_SIZE, gvcid_len) != header->gvcid_crc) ||
+            (Crypto_Calc_CRC32(section + CRYPTO_CONFIG_SIZE + gvcid_len, idle_len) != header->idle_crc) ||
+            (Crypto_Calc_CRC32(section + CRYPTO_CONFIG_SIZE + gvcid_len + idle_len, NUM_SA * SA_SIZE) != header->sa_crc))
+        {
+            status = CRYPTO_LIB_ERR_SNAPSHOT_CHECKSUM;
+        }
+    }
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        memcpy(&crypto_config, section, CRYPTO_CONFIG_SIZE);
+        crypto_config.init_status = INITIALIZED;
+        if ((crypto_config.key_type != KEY_TYPE_INTERNAL) || (crypto_config.sa_type != SA_TYPE_INMEMORY))
+        {
+            status = CRYPTO_LIB_ERR_SNAPSHOT_UNSUPPORTED;
+        }
+        section += CRYPTO_CONFIG_SIZE;
+    }
+    // Adding managed parameters resets the GVCID's idle frame handling, so it is set again from its own section
+    idle_frames = (const GvcidIdleFrames_t*)(section + gvcid_len);
+    for (i = 0; (status == CRYPTO_LIB_SUCCESS) && (i < header->num_gvcid); i++)
+    {
+        GvcidManagedParameters_t managed_parameters;
+        memcpy(&managed_parameters, section + (i * GVCID_MANAGED_PARAMETERS_SIZE), GVCID_MANAGED_PARAMETERS_SIZE);
+        status = Crypto_Config_Add_Gvcid_Managed_Parameters(managed_parameters);
+        if (status == CRYPTO_LIB_SUCCESS)
+        {
+            status = Crypto_Config_Gvcid_Idle_Frames(managed_parameters.tfvn, managed_parameters.scid,
+                                                     managed_parameters.vcid, idle_frames[i].idle_vc,
+                                                     idle_frames[i].idle_policy);
+        }
+    }
+
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        crypto_snapshot_restore = CRYPTO_TRUE;
+        status = Crypto_Init();
+        crypto_snapshot_restore = CRYPTO_FALSE;
+        if (status == CRYPTO_LIB_SUCCESS)
+        {
+            status = crypto_snapshot_restore_tables(header, image, master_key, master_key_len);
+            if (status != CRYPTO_LIB_SUCCESS)
+            {
+                CRYPTO_MC_IF->mc_log(status);
+                Crypto_Shutdown();
+            }
+        }
+    }
+
+    if (image != MAP_FAILED)
+    {
+        munmap(image, file_stat.st_size);
+    }
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    return status;
+}
+
+/**
+ * @brief Function: crypto_snapshot_length
+ * Total snapshot file length for the sizes in header
+ * @param header: const crypto_snapshot_header_t*
+ * @return uint32_t: Length in bytes
+ **/
+static uint32_t crypto_snapshot_length(const crypto_snapshot_header_t* header)
+{
+    return sizeof(crypto_snapshot_header_t) + header->config_size + (header->num_gvcid * header->gvcid_size) +
+           (header->num_gvcid * header->idle_size) + (header->num_sa * header->sa_size) + (header->num_keys * header->key_size);
+}
+
+/**
+ * @brief Function: crypto_snapshot_check_header
+ * Checks a mapped header was written by this build's structure layout and matches the file length
+ * @param header: const crypto_snapshot_header_t*
+ * @param file_len: size_t
+ * @return int32_t: Success/Failure
+ **/
+static int32_t crypto_snapshot_check_header(const crypto_snapshot_header_t* header, size_t file_len)
+{
+    if ((header->magic != CRYPTO_SNAPSHOT_MAGIC) ||
+        (Crypto_Calc_CRC32((const uint8_t*)header, offsetof(crypto_snapshot_header_t, header_crc)) != header->header_crc))
+    {
+        return CRYPTO_LIB_ERR_SNAPSHOT_CHECKSUM;
+    }
+    if ((header->version != CRYPTO_SNAPSHOT_VERSION) || (header->config_size != CRYPTO_CONFIG_SIZE) ||
+        (header->gvcid_size != GVCID_MANAGED_PARAMETERS_SIZE) || (header->idle_size != GVCID_IDLE_FRAMES_SIZE) ||
+        (header->sa_size != SA_SIZE) ||
+        (header->key_size != CRYPTO_SNAPSHOT_KEY_SIZE) || (header->num_sa != NUM_SA) || (header->num_keys != NUM_KEYS) ||
+        (header->num_gvcid == 0) || (header->num_gvcid > GVCID_MAN_PARAM_SIZE) ||
+        (crypto_snapshot_length(header) != file_len))
+    {
+        return CRYPTO_LIB_ERR_SNAPSHOT_INVALID;
+    }
+    return CRYPTO_LIB_SUCCESS;
+}
+
+/**
+ * @brief Function: crypto_snapshot_write
+ * Writes the image next to path and renames it over path, so a crash never leaves a partial snapshot
+ * @param path: const char*
+ * @param image: const uint8_t*
+ * @param image_len: uint32_t
+ * @return int32_t: Success/Failure
+ **/
+static int32_t crypto_snapshot_write(const char* path, const uint8_t* image, uint32_t image_len)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    FILE* snapshot_file = NULL;
+    char* tmp_path = NULL;
+    size_t path_len = strlen(path);
+
+    tmp_path = (char*)malloc(path_len + 5);
+    if (tmp_path == NULL)
+    {
+        return CRYPTO_LIB_ERROR;
+    }
+    memcpy(tmp_path, path, path_len);
+    memcpy(tmp_path + path_len, ".tmp", 5);
+
+    snapshot_file = fopen(tmp_path, "wb");
+    if (snapshot_file == NULL)
+    {
+        status = CRYPTO_LIB_ERR_SNAPSHOT_IO;
+    }
+    if ((status == CRYPTO_LIB_SUCCESS) && (fwrite(image, 1, image_len, snapshot_file) != image_len))
+    {
+        status = CRYPTO_LIB_ERR_SNAPSHOT_IO;
+    }
+    if ((snapshot_file != NULL) && (fclose(snapshot_file) != 0))
+    {
+        status = CRYPTO_LIB_ERR_SNAPSHOT_IO;
+    }
+    if ((status == CRYPTO_LIB_SUCCESS) && (rename(tmp_path, path) != 0))
+    {
+        status = CRYPTO_LIB_ERR_SNAPSHOT_IO;
+    }
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        remove(tmp_path);
+    }
+    free(tmp_path);
+    return status;
+}
+
+/**
+ * @brief Function: crypto_snapshot_restore_tables
+ * Copies the SA table into the SA module and decrypts the key ring into the key module
+ * @param header: const crypto_snapshot_header_t*
+ * @param image: const uint8_t*
+ * @param master_key: const uint8_t*
+ * @param master_key_len: uint16_t
+ * @return int32_t: Success/Failure
+ **/
+static int32_t crypto_snapshot_restore_tables(const crypto_snapshot_header_t* header, const uint8_t* image,
+                                              const uint8_t* master_key, uint16_t master_key_len)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    const uint8_t* section = NULL;
+    uint8_t* plain_keys = NULL;
+    uint32_t keys_len = NUM_KEYS * CRYPTO_SNAPSHOT_KEY_SIZE;
+    uint8_t ecs = CRYPTO_CIPHER_AES256_GCM;
+    uint8_t acs = CRYPTO_MAC_NONE;
+    SecurityAssociation_t* sa_ptr = NULL;
+    crypto_key_t* key_ptr = NULL;
+    const crypto_snapshot_key_t* record = NULL;
+    uint32_t i;
+
+    if (master_key_len != Crypto_Get_ECS_Algo_Keylen(ecs))
+    {
+        return CRYPTO_LIB_ERR_KEY_LENGTH_ERROR;
+    }
+    plain_keys = (uint8_t*)calloc(1, keys_len);
+    if (plain_keys == NULL)
+    {
+        return CRYPTO_LIB_ERROR;
+    }
+
+    // Key ring first, nothing is restored under the wrong master key
+    section = image + sizeof(crypto_snapshot_header_t) + CRYPTO_CONFIG_SIZE +
+              (header->num_gvcid * (GVCID_MANAGED_PARAMETERS_SIZE + GVCID_IDLE_FRAMES_SIZE)) + (NUM_SA * SA_SIZE);
+    status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_aead_decrypt(plain_keys, // plaintext output
+                                                               keys_len, // length of data
+                                                               (uint8_t*)section, // ciphertext input
+                                                               keys_len, // in data length
+                                                               (uint8_t*)master_key, // Key
+                                                               master_key_len,
+                                                               NULL, // No SA, key passed explicitly
+                                                               (uint8_t*)header->key_iv, // IV
+                                                               CRYPTO_SNAPSHOT_IV_SIZE, // IV Length
+                                                               (uint8_t*)header->key_tag, // Expected tag
+                                                               CRYPTO_SNAPSHOT_TAG_SIZE, // tag size
+                                                               (uint8_t*)header, // additional authenticated data
+                                                               offsetof(crypto_snapshot_header_t, key_tag), // length of AAD
+                                                               CRYPTO_TRUE, // Decryption Bool
+                                                               CRYPTO_TRUE, // Authentication Bool
+                                                               CRYPTO_TRUE, // AAD Bool
+                                                               &ecs, // encryption cipher
+                                                               &acs, // authentication cipher
+                                                               NULL);
+    for (i = 0; (status == CRYPTO_LIB_SUCCESS) && (i < NUM_KEYS); i++)
+    {
+        key_ptr = CRYPTO_KEY_IF->get_key(i);
+        if (key_ptr != NULL)
+        {
+            record = (const crypto_snapshot_key_t*)(plain_keys + (i * CRYPTO_SNAPSHOT_KEY_SIZE));
+            memcpy(key_ptr->value, record->value, KEY_SIZE);
+            key_ptr->key_len = record->key_len;
+            key_ptr->key_state = record->key_state;
+        }
+    }
+    memset(plain_keys, 0, keys_len);
+    free(plain_keys);
+
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        section = image + sizeof(crypto_snapshot_header_t) + CRYPTO_CONFIG_SIZE +
+                  (header->num_gvcid * (GVCID_MANAGED_PARAMETERS_SIZE + GVCID_IDLE_FRAMES_SIZE));
+        for (i = 0; i < NUM_SA; i++)
+        {
+            CRYPTO_SA_IF->sa_get_from_spi(i, &sa_ptr);
+            memcpy(sa_ptr, section + (i * SA_SIZE), SA_SIZE);
+        }
+    }
+    return status;
+}
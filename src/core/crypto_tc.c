@@ -24,6 +24,8 @@
 #include <string.h> // memcpy
 
 /* Helper functions */
+static int32_t crypto_tc_apply_security_cam(const uint8_t* p_in_frame, const uint16_t in_frame_length, uint8_t** pp_in_frame, uint16_t* p_enc_frame_len, char* cam_cookies);
+static int32_t crypto_tc_process_security_cam(uint8_t* ingest, int* len_ingest, TC_t* tc_sdls_processed_frame, char* cam_cookies, crypto_frame_desc_t* desc);
 static int32_t crypto_tc_validate_sa(SecurityAssociation_t* sa);
 static int32_t crypto_handle_incrementing_nontransmitted_counter(uint8_t* dest, uint8_t* src, int src_full_len, int transmitted_len, int window);
 
@@ -58,9 +60,9 @@ int32_t Crypto_TC_Get_SA_Service_Type(uint8_t* sa_service_type, SecurityAssociat
     {
         // Probably unnecessary check
         // Leaving for now as it would be cleaner in SA to have an association enum returned I believe
-        printf(KRED "Error: SA Service Type is not defined! \n" RESET);
         status = CRYPTO_LIB_ERROR;
-        mc_if->mc_log(status);
+        Crypto_MC_Event(status, sa_ptr->spi, NULL, "SA Service Type is not defined");
+        CRYPTO_MC_IF->mc_log(status);
         return status;
     }
     return status;
@@ -99,7 +101,7 @@ int32_t Crypto_TC_Get_Ciper_Mode_TCA(uint8_t sa_service_type, uint32_t* encrypti
     if (*encryption_cipher == CRYPTO_CIPHER_NONE && sa_ptr->est == 1)
     {
         status = CRYPTO_LIB_ERR_NO_ECS_SET_FOR_ENCRYPTION_MODE;
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
     }
     return status;
 }
@@ -125,7 +127,7 @@ int32_t Crypto_TC_Check_CMD_Frame_Flag(uint8_t header_cc)
         printf(KYEL "DEBUG - Received Control/Command frame - nothing to do.\n" RESET);
 #endif
         status = CRYPTO_LIB_ERR_INVALID_CC_FLAG;
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
     }
     return status;
 }
@@ -142,8 +144,8 @@ int32_t Crypto_TC_Validate_SA_Service_Type(uint8_t sa_service_type)
 
     if ((sa_service_type != SA_PLAINTEXT) && (sa_service_type != SA_AUTHENTICATED_ENCRYPTION) && (sa_service_type != SA_ENCRYPTION) && (sa_service_type != SA_AUTHENTICATION))
     {
-        printf(KRED "Unknown SA Service Type Detected!\n" RESET);
         status = CRYPTO_LIB_ERR_INVALID_SA_SERVICE_TYPE;
+        Crypto_MC_Event(status, MC_EVENT_SPI_NA, NULL, "Unknown SA Service Type %d", sa_service_type);
     }
     return status;
 }
@@ -186,7 +188,7 @@ int32_t Crypto_TC_Handle_Enc_Padding(uint8_t sa_service_type, uint32_t* pkcs_pad
             if (*p_enc_frame_len > TC_MAX_FRAME_SIZE)
             {
                 status = CRYPTO_LIB_ERR_TC_FRAME_SIZE_EXCEEDS_SPEC_LIMIT;
-                mc_if->mc_log(status);
+                CRYPTO_MC_IF->mc_log(status);
             }
         }
     }
@@ -202,24 +204,25 @@ int32_t Crypto_TC_Handle_Enc_Padding(uint8_t sa_service_type, uint32_t* pkcs_pad
 int32_t Crypto_TC_Frame_Validation(uint16_t* p_enc_frame_len)
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
-    if (*p_enc_frame_len > current_managed_parameters_struct.max_frame_size)
+    if (*p_enc_frame_len > current_managed_parameters->max_frame_size)
     {
 #ifdef DEBUG
-        printf("Managed length is: %d\n", current_managed_parameters_struct.max_frame_size);
+        printf("Managed length is: %d\n", current_managed_parameters->max_frame_size);
         printf("New enc frame length will be: %d\n", *p_enc_frame_len);
 #endif
-        printf(KRED "Error: New frame would violate maximum tc frame managed parameter! \n" RESET);
         status = CRYPTO_LIB_ERR_TC_FRAME_SIZE_EXCEEDS_MANAGED_PARAM_MAX_LIMIT;
-        mc_if->mc_log(status);
-        printf("STATUS=%d\n", status);
+        Crypto_MC_Event(status, MC_EVENT_SPI_NA, NULL, "New frame length %d would violate maximum tc frame managed parameter %d",
+                        *p_enc_frame_len, current_managed_parameters->max_frame_size);
+        CRYPTO_MC_IF->mc_log(status);
         return status;
     }
     // Ensure the frame to be created will not violate spec max length
     if ((*p_enc_frame_len > 1024) && status == CRYPTO_LIB_SUCCESS)
     {
-        printf(KRED "Error: New frame would violate specification max TC frame size! \n" RESET);
         status = CRYPTO_LIB_ERR_TC_FRAME_SIZE_EXCEEDS_SPEC_LIMIT;
-        mc_if->mc_log(status);
+        Crypto_MC_Event(status, MC_EVENT_SPI_NA, NULL, "New frame length %d would violate specification max TC frame size",
+                        *p_enc_frame_len);
+        CRYPTO_MC_IF->mc_log(status);
     }
     return status;
 }
@@ -238,9 +241,9 @@ int32_t Crypto_TC_Accio_Buffer(uint8_t** p_new_enc_frame, uint16_t* p_enc_frame_
     *p_new_enc_frame = (uint8_t*)malloc((*p_enc_frame_len) * sizeof(uint8_t));
     if (!p_new_enc_frame)
     {
-        printf(KRED "Error: Malloc for encrypted output buffer failed! \n" RESET);
         status = CRYPTO_LIB_ERROR;
-        mc_if->mc_log(status);
+        Crypto_MC_Event(status, MC_EVENT_SPI_NA, NULL, "Malloc for encrypted output buffer failed");
+        CRYPTO_MC_IF->mc_log(status);
         return status;
     }
     memset(*p_new_enc_frame, 0, *p_enc_frame_len);
@@ -264,7 +267,7 @@ int32_t Crypto_TC_ACS_Algo_Check(SecurityAssociation_t* sa_ptr)
                 sa_ptr->iv_len > 0)
             {
                 status = CRYPTO_LIB_ERR_IV_NOT_SUPPORTED_FOR_ACS_ALGO;
-                mc_if->mc_log(status);
+                CRYPTO_MC_IF->mc_log(status);
             }
         }
     }
@@ -275,11 +278,12 @@ int32_t Crypto_TC_ACS_Algo_Check(SecurityAssociation_t* sa_ptr)
  * @brief Function: Crypto_TC_Check_IV_Setup
  * Verifies IV - Sanity Check
  * @param sa_ptr: SecurityAssociation_t*
+ * @param counters: const crypto_sa_counters_t*
  * @param p_new_enc_frame: uint8_t*
  * @param index: uint16_t*
  * @return int32: Success/Failure
  **/
-int32_t Crypto_TC_Check_IV_Setup(SecurityAssociation_t* sa_ptr, uint8_t* p_new_enc_frame, uint16_t *index)
+int32_t Crypto_TC_Check_IV_Setup(SecurityAssociation_t* sa_ptr, const crypto_sa_counters_t* counters, uint8_t* p_new_enc_frame, uint16_t *index)
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
     int i;
@@ -289,7 +293,7 @@ int32_t Crypto_TC_Check_IV_Setup(SecurityAssociation_t* sa_ptr, uint8_t* p_new_e
         // Start index from the transmitted portion
         for (i = sa_ptr->iv_len - sa_ptr->shivf_len; i < sa_ptr->iv_len; i++)
         {
-            *(p_new_enc_frame + index_temp) = *(sa_ptr->iv + i);
+            *(p_new_enc_frame + index_temp) = counters->iv[i];
             index_temp++;
         }
     }
@@ -308,7 +312,7 @@ int32_t Crypto_TC_Check_IV_Setup(SecurityAssociation_t* sa_ptr, uint8_t* p_new_e
         else
         {
             status = CRYPTO_LIB_ERR_NULL_IV;
-            mc_if->mc_log(status);
+            CRYPTO_MC_IF->mc_log(status);
             return status;
         }
     }
@@ -322,6 +326,7 @@ int32_t Crypto_TC_Check_IV_Setup(SecurityAssociation_t* sa_ptr, uint8_t* p_new_e
  * Handles Plaintext TC Encryption
  * @param sa_service_type: uint8_t
  * @param sa_ptr: SecurityAssociation_t*
+ * @param counters: const crypto_sa_counters_t*
  * @param mac_loc: uint16_t*
  * @param tf_payload_len: uint16_t
  * @param segment_hdr_len:  uint8_t 
@@ -335,7 +340,7 @@ int32_t Crypto_TC_Check_IV_Setup(SecurityAssociation_t* sa_ptr, uint8_t* p_new_e
  * @param pkcs_padding:uint32_t 
  * @return int32: Success/Failure
  **/
-int32_t Crypto_TC_Do_Encrypt_PLAINTEXT(uint8_t sa_service_type, SecurityAssociation_t* sa_ptr, uint16_t* mac_loc, uint16_t tf_payload_len, uint8_t segment_hdr_len, uint8_t* p_new_enc_frame, crypto_key_t* ekp, uint8_t** aad, uint8_t ecs_is_aead_algorithm, uint16_t *index_p, const uint8_t* p_in_frame, char* cam_cookies, uint32_t pkcs_padding)
+int32_t Crypto_TC_Do_Encrypt_PLAINTEXT(uint8_t sa_service_type, SecurityAssociation_t* sa_ptr, const crypto_sa_counters_t* counters, uint16_t* mac_loc, uint16_t tf_payload_len, uint8_t segment_hdr_len, uint8_t* p_new_enc_frame, crypto_key_t* ekp, uint8_t** aad, uint8_t ecs_is_aead_algorithm, uint16_t *index_p, const uint8_t* p_in_frame, char* cam_cookies, uint32_t pkcs_padding)
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
     uint16_t index = *index_p;
@@ -367,10 +372,16 @@ int32_t Crypto_TC_Do_Encrypt_PLAINTEXT(uint8_t sa_service_type, SecurityAssociat
             if (sa_ptr->abm_len < aad_len)
             {
                 status = CRYPTO_LIB_ERR_ABM_TOO_SHORT_FOR_AAD;
-                mc_if->mc_log(status);
+                CRYPTO_MC_IF->mc_log(status);
                 return status;
             }
             *aad = Crypto_Prepare_TC_AAD(p_new_enc_frame, aad_len, sa_ptr->abm);
+            if (*aad == NULL)
+            {
+                status = CRYPTO_LIB_ERR_ARENA_EXHAUSTED;
+                CRYPTO_MC_IF->mc_log(status);
+                return status;
+            }
         }
 
 #ifdef TC_DEBUG
@@ -379,11 +390,11 @@ int32_t Crypto_TC_Do_Encrypt_PLAINTEXT(uint8_t sa_service_type, SecurityAssociat
 #endif
 
         /* Get Key */
-        ekp = key_if->get_key(sa_ptr->ekid);
+        ekp = CRYPTO_KEY_IF->get_key(sa_ptr->ekid);
         if (ekp == NULL)
         {
             status = CRYPTO_LIB_ERR_KEY_ID_ERROR;
-            mc_if->mc_log(status);
+            CRYPTO_MC_IF->mc_log(status);
             return status;
         }
         if (ecs_is_aead_algorithm == CRYPTO_TRUE)
@@ -391,20 +402,19 @@ int32_t Crypto_TC_Do_Encrypt_PLAINTEXT(uint8_t sa_service_type, SecurityAssociat
             // Check that key length to be used ets the algorithm requirement
             if ((int32_t)ekp->key_len != Crypto_Get_ECS_Algo_Keylen(sa_ptr->ecs))
             {
-                Crypto_TC_Safe_Free_Ptr(*aad);
                 status = CRYPTO_LIB_ERR_KEY_LENGTH_ERROR;
-                mc_if->mc_log(status);
+                CRYPTO_MC_IF->mc_log(status);
                 return status;
             }
 
-            status = cryptography_if->cryptography_aead_encrypt(&p_new_enc_frame[index],                                          // ciphertext output
+            status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_aead_encrypt(&p_new_enc_frame[index],                                          // ciphertext output
                                                                 (size_t)tf_payload_len,                                           // length of data
                                                                 (uint8_t*)(p_in_frame + TC_FRAME_HEADER_SIZE + segment_hdr_len), // plaintext input
                                                                 (size_t)tf_payload_len,                                           // in data length
                                                                 &(ekp->value[0]),                                                 // Key
                                                                 Crypto_Get_ECS_Algo_Keylen(sa_ptr->ecs),                          // Length of key derived from sa_ptr key_ref
                                                                 sa_ptr,                                                           // SA (for key reference)
-                                                                sa_ptr->iv,                                                       // IV
+                                                                (uint8_t*)counters->iv,                                           // IV
                                                                 sa_ptr->iv_len,                                                   // IV Length
                                                                 mac_ptr,                                                          // tag output
                                                                 sa_ptr->stmacf_len,                                               // tag size
@@ -425,11 +435,10 @@ int32_t Crypto_TC_Do_Encrypt_PLAINTEXT(uint8_t sa_service_type, SecurityAssociat
                 // Check that key length to be used ets the algorithm requirement
                 if ((int32_t)ekp->key_len != Crypto_Get_ECS_Algo_Keylen(sa_ptr->ecs))
                 {
-                    Crypto_TC_Safe_Free_Ptr(*aad);
                     return CRYPTO_LIB_ERR_KEY_LENGTH_ERROR;
                 }
 
-                status = cryptography_if->cryptography_encrypt(&p_new_enc_frame[index], // ciphertext output
+                status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_encrypt(&p_new_enc_frame[index], // ciphertext output
                                                                 (size_t)tf_payload_len,
                                                                 &p_new_enc_frame[index], // length of data
                                                                 //(uint8_t*)(p_in_frame + TC_FRAME_HEADER_SIZE + segment_hdr_len), // plaintext input
@@ -438,7 +447,7 @@ int32_t Crypto_TC_Do_Encrypt_PLAINTEXT(uint8_t sa_service_type, SecurityAssociat
                                                                 &(ekp->value[0]),                        // Key
                                                                 Crypto_Get_ECS_Algo_Keylen(sa_ptr->ecs), // Length of key derived from sa_ptr key_ref
                                                                 sa_ptr,                                  // SA (for key reference)
-                                                                sa_ptr->iv,                              // IV
+                                                                (uint8_t*)counters->iv,                  // IV
                                                                 sa_ptr->iv_len,                          // IV Length
                                                                 &sa_ptr->ecs,                            // encryption cipher
                                                                 pkcs_padding,
@@ -449,7 +458,7 @@ int32_t Crypto_TC_Do_Encrypt_PLAINTEXT(uint8_t sa_service_type, SecurityAssociat
             {
                 /* Get Key */
                 crypto_key_t* akp = NULL;
-                akp = key_if->get_key(sa_ptr->akid);
+                akp = CRYPTO_KEY_IF->get_key(sa_ptr->akid);
                 if (akp == NULL)
                 {
                     return CRYPTO_LIB_ERR_KEY_ID_ERROR;
@@ -458,18 +467,17 @@ int32_t Crypto_TC_Do_Encrypt_PLAINTEXT(uint8_t sa_service_type, SecurityAssociat
                 // Check that key length to be used ets the algorithm requirement
                 if ((int32_t)akp->key_len != Crypto_Get_ACS_Algo_Keylen(sa_ptr->acs))
                 {
-                    Crypto_TC_Safe_Free_Ptr(*aad);
                     return CRYPTO_LIB_ERR_KEY_LENGTH_ERROR;
                 }
 
-                status = cryptography_if->cryptography_authenticate(&p_new_enc_frame[index],                                          // ciphertext output
+                status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_authenticate(&p_new_enc_frame[index],                                          // ciphertext output
                                                                     (size_t)tf_payload_len,                                           // length of data
                                                                     (uint8_t*)(p_in_frame + TC_FRAME_HEADER_SIZE + segment_hdr_len), // plaintext input
                                                                     (size_t)tf_payload_len,                                           // in data length
                                                                     &(akp->value[0]),                                                 // Key
                                                                     Crypto_Get_ACS_Algo_Keylen(sa_ptr->acs),
                                                                     sa_ptr,             // SA (for key reference)
-                                                                    sa_ptr->iv,         // IV
+                                                                    (uint8_t*)counters->iv, // IV
                                                                     sa_ptr->iv_len,     // IV Length
                                                                     mac_ptr,            // tag output
                                                                     sa_ptr->stmacf_len, // tag size
@@ -484,85 +492,19 @@ int32_t Crypto_TC_Do_Encrypt_PLAINTEXT(uint8_t sa_service_type, SecurityAssociat
         *index_p = index;
         if (status != CRYPTO_LIB_SUCCESS)
         {
-            Crypto_TC_Safe_Free_Ptr(*aad);
-            mc_if->mc_log(status);
+            CRYPTO_MC_IF->mc_log(status);
             return status; // Cryptography IF call failed, return.
         }
     }
     return status;
 }
 
-/**
- * @brief Function: Crypto_TC_Do_Encrypt_NONPLAINTEXT
- * Handles NON-Plaintext TC Encryption
- * @param sa_service_type: uint8_t
- * @param sa_ptr: SecurityAssociation_t*
- * @return int32: Success/Failure
- **/
-void Crypto_TC_Do_Encrypt_NONPLAINTEXT(uint8_t sa_service_type, SecurityAssociation_t* sa_ptr)
-{
-    if (sa_service_type != SA_PLAINTEXT)
-    {
-#ifdef INCREMENT
-        if (crypto_config.crypto_increment_nontransmitted_iv == SA_INCREMENT_NONTRANSMITTED_IV_TRUE)
-        {
-            if (sa_ptr->shivf_len > 0 && sa_ptr->iv_len != 0)
-            {
-                Crypto_increment(sa_ptr->iv, sa_ptr->iv_len);
-            }
-        }
-        else // SA_INCREMENT_NONTRANSMITTED_IV_FALSE
-        {
-            // Only increment the transmitted portion
-            if (sa_ptr->shivf_len > 0 && sa_ptr->iv_len != 0)
-            {
-                Crypto_increment(sa_ptr->iv + (sa_ptr->iv_len - sa_ptr->shivf_len), sa_ptr->shivf_len);
-            }
-        }
-        if (sa_ptr->shsnf_len > 0)
-        {
-            Crypto_increment(sa_ptr->arsn, sa_ptr->arsn_len);
-        }
-
-#ifdef SA_DEBUG
-        int i = 0;
-        if (sa_ptr->iv_len > 0)
-        {
-            printf(KYEL "Next IV value is:\n\t");
-            for (i = 0; i < sa_ptr->iv_len; i++)
-            {
-                printf("%02x", *(sa_ptr->iv + i));
-            }
-            printf("\n" RESET);
-            printf(KYEL "Next transmitted IV value is:\n\t");
-            for (i = sa_ptr->iv_len - sa_ptr->shivf_len; i < sa_ptr->iv_len; i++)
-            {
-                printf("%02x", *(sa_ptr->iv + i));
-            }
-            printf("\n" RESET);
-        }
-        printf(KYEL "Next ARSN value is:\n\t");
-        for (i = 0; i < sa_ptr->arsn_len; i++)
-        {
-            printf("%02x", *(sa_ptr->arsn + i));
-        }
-        printf("\n" RESET);
-        printf(KYEL "Next transmitted ARSN value is:\n\t");
-        for (i = sa_ptr->arsn_len - sa_ptr->shsnf_len; i < sa_ptr->arsn_len; i++)
-        {
-            printf("%02x", *(sa_ptr->arsn + i));
-        }
-        printf("\n" RESET);
-#endif
-#endif
-    }
-}
-
 /**
  * @brief Function: Crypto_TC_Do_Encrypt
  * Starts TC Encryption - Handles Plaintext and NON Plaintext
  * @param sa_service_type: uint8_t
  * @param sa_ptr: SecurityAssociation_t*
+ * @param counters: const crypto_sa_counters_t*
  * @param mac_loc: uint16_t*
  * @param tf_payload_len: uint16_t
  * @param segment_hdr_len:  uint8_t 
@@ -578,25 +520,22 @@ void Crypto_TC_Do_Encrypt_NONPLAINTEXT(uint8_t sa_service_type, SecurityAssociat
  * @param new_fecf: uint16_t*
  * @return int32: Success/Failure
  **/
-int32_t Crypto_TC_Do_Encrypt(uint8_t sa_service_type, SecurityAssociation_t* sa_ptr, uint16_t* mac_loc, uint16_t tf_payload_len, uint8_t segment_hdr_len, uint8_t* p_new_enc_frame, crypto_key_t* ekp, uint8_t** aad, uint8_t ecs_is_aead_algorithm, uint16_t *index_p, const uint8_t* p_in_frame, char* cam_cookies, uint32_t pkcs_padding, uint16_t new_enc_frame_header_field_length, uint16_t* new_fecf)
+int32_t Crypto_TC_Do_Encrypt(uint8_t sa_service_type, SecurityAssociation_t* sa_ptr, const crypto_sa_counters_t* counters, uint16_t* mac_loc, uint16_t tf_payload_len, uint8_t segment_hdr_len, uint8_t* p_new_enc_frame, crypto_key_t* ekp, uint8_t** aad, uint8_t ecs_is_aead_algorithm, uint16_t *index_p, const uint8_t* p_in_frame, char* cam_cookies, uint32_t pkcs_padding, uint16_t new_enc_frame_header_field_length, uint16_t* new_fecf)
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
     uint16_t index = *index_p;
-    status = Crypto_TC_Do_Encrypt_PLAINTEXT(sa_service_type, sa_ptr, mac_loc, tf_payload_len, segment_hdr_len, p_new_enc_frame, ekp, aad, ecs_is_aead_algorithm, index_p, p_in_frame, cam_cookies, pkcs_padding);
+    status = Crypto_TC_Do_Encrypt_PLAINTEXT(sa_service_type, sa_ptr, counters, mac_loc, tf_payload_len, segment_hdr_len, p_new_enc_frame, ekp, aad, ecs_is_aead_algorithm, index_p, p_in_frame, cam_cookies, pkcs_padding);
     if (status != CRYPTO_LIB_SUCCESS)
     {
-        Crypto_TC_Safe_Free_Ptr(*aad);
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
         return status; 
     }
-    //TODO:  Status?
-    Crypto_TC_Do_Encrypt_NONPLAINTEXT(sa_service_type, sa_ptr);
     /*
     ** End Authentication / Encryption
     */
 
     // Only calculate & insert FECF if CryptoLib is configured to do so & gvcid includes FECF.
-    if (current_managed_parameters_struct.has_fecf == TC_HAS_FECF)
+    if (current_managed_parameters->has_fecf == TC_HAS_FECF)
     {
 #ifdef FECF_DEBUG
         printf(KCYN "Calcing FECF over %d bytes\n" RESET, new_enc_frame_header_field_length - 1);
@@ -630,8 +569,8 @@ int32_t Crypto_TC_Check_Init_Setup(uint16_t in_frame_length)
 
     if ((crypto_config.init_status == UNITIALIZED) || (mc_if == NULL) || (sa_if == NULL))
     {
-        printf(KRED "ERROR: CryptoLib Configuration Not Set! -- CRYPTO_LIB_ERR_NO_CONFIG, Will Exit\n" RESET);
         status = CRYPTO_LIB_ERR_NO_CONFIG;
+        Crypto_MC_Event(status, MC_EVENT_SPI_NA, NULL, "CryptoLib Configuration Not Set");
         // Can't mc_log since it's not configured
         return status; // return immediately so a NULL crypto_config is not dereferenced later
     }
@@ -639,7 +578,7 @@ int32_t Crypto_TC_Check_Init_Setup(uint16_t in_frame_length)
     if (in_frame_length < 5) // Frame length doesn't have enough bytes for TC TF header -- error out.
     {
         status = CRYPTO_LIB_ERR_INPUT_FRAME_TOO_SHORT_FOR_TC_STANDARD;
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
         return status;
     }
 
@@ -659,8 +598,8 @@ int32_t Crypto_TC_Sanity_Setup(const uint8_t* p_in_frame, const uint16_t in_fram
     if (p_in_frame == NULL)
     {
         status = CRYPTO_LIB_ERR_NULL_BUFFER;
-        printf(KRED "Error: Input Buffer NULL! \n" RESET);
-        mc_if->mc_log(status);
+        Crypto_MC_Event(status, MC_EVENT_SPI_NA, NULL, "Input Buffer NULL");
+        CRYPTO_MC_IF->mc_log(status);
         return status; // Just return here, nothing can be done.
     }
 
@@ -704,21 +643,21 @@ int32_t Crytpo_TC_Validate_TC_Temp_Header(const uint16_t in_frame_length, TC_Fra
     if (in_frame_length < temp_tc_header.fl + 1) // Specified frame length larger than provided frame!
     {
         status = CRYPTO_LIB_ERR_INPUT_FRAME_LENGTH_SHORTER_THAN_FRAME_HEADERS_LENGTH;
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
         return status;
     }
 
     // Lookup-retrieve managed parameters for frame via gvcid:
-    status = Crypto_Get_Managed_Parameters_For_Gvcid(temp_tc_header.tfvn, temp_tc_header.scid, temp_tc_header.vcid,
-                                                     gvcid_managed_parameters_array, &current_managed_parameters_struct);
+    status = Crypto_Get_Managed_Parameters_Ptr_For_Gvcid(temp_tc_header.tfvn, temp_tc_header.scid, temp_tc_header.vcid,
+                                                         &current_managed_parameters);
 
     if (status != CRYPTO_LIB_SUCCESS)
     {
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
         return status;
     } // Unable to get necessary Managed Parameters for TC TF -- return with error.
 
-    if (current_managed_parameters_struct.has_segmentation_hdr == TC_HAS_SEGMENT_HDRS)
+    if (current_managed_parameters->has_segmentation_hdr == TC_HAS_SEGMENT_HDRS)
     {
         *segmentation_hdr = p_in_frame[5];
         *map_id = *segmentation_hdr & 0x3F;
@@ -727,15 +666,15 @@ int32_t Crytpo_TC_Validate_TC_Temp_Header(const uint16_t in_frame_length, TC_Fra
     status = Crypto_TC_Check_CMD_Frame_Flag(temp_tc_header.cc);
     if (status != CRYPTO_LIB_SUCCESS)
     {
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
         return status;
     }
-    status = sa_if->sa_get_operational_sa_from_gvcid(temp_tc_header.tfvn, temp_tc_header.scid,
+    status = CRYPTO_SA_IF->sa_get_operational_sa_from_gvcid(temp_tc_header.tfvn, temp_tc_header.scid,
                                                         temp_tc_header.vcid, *map_id, sa_ptr);
     // If unable to get operational SA, can return
     if (status != CRYPTO_LIB_SUCCESS)
     {
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
         return status;
     }
 
@@ -743,7 +682,7 @@ int32_t Crytpo_TC_Validate_TC_Temp_Header(const uint16_t in_frame_length, TC_Fra
     status = crypto_tc_validate_sa(*sa_ptr);
     if (status != CRYPTO_LIB_SUCCESS)
     {
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
         return status;
     }
 
@@ -782,7 +721,7 @@ int32_t Crypto_TC_Finalize_Frame_Setup(uint8_t sa_service_type, uint32_t* pkcs_p
     }
     if(status != CRYPTO_LIB_SUCCESS)
     {
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
     }
 
     return status;
@@ -827,11 +766,12 @@ void Crypto_TC_Handle_Padding(uint32_t pkcs_padding, SecurityAssociation_t* sa_p
  * @brief Function: Crypto_TC_Set_IV
  * Performs validation and setup of IV
  * @param sa_ptr: SecurityAssociation_t* 
+ * @param counters: const crypto_sa_counters_t*
  * @param p_new_enc_frame: uint8_t* 
  * @param index: uint16_t*
  * @return int32: Success/Failure
  **/
-int32_t Crypto_TC_Set_IV(SecurityAssociation_t* sa_ptr, uint8_t* p_new_enc_frame, uint16_t* index)
+int32_t Crypto_TC_Set_IV(SecurityAssociation_t* sa_ptr, const crypto_sa_counters_t* counters, uint8_t* p_new_enc_frame, uint16_t* index)
 {
     uint32_t status = CRYPTO_LIB_SUCCESS;
     #ifdef SA_DEBUG
@@ -841,13 +781,13 @@ int32_t Crypto_TC_Set_IV(SecurityAssociation_t* sa_ptr, uint8_t* p_new_enc_frame
         printf(KYEL "Using IV value:\n\t");
         for (i = 0; i < sa_ptr->iv_len; i++)
         {
-            printf("%02x", *(sa_ptr->iv + i));
+            printf("%02x", counters->iv[i]);
         }
         printf("\n" RESET);
         printf(KYEL "Transmitted IV value:\n\t");
         for (i = sa_ptr->iv_len - sa_ptr->shivf_len; i < sa_ptr->iv_len; i++)
         {
-            printf("%02x", *(sa_ptr->iv + i));
+            printf("%02x", counters->iv[i]);
         }
         printf("\n" RESET);
     }
@@ -855,12 +795,12 @@ int32_t Crypto_TC_Set_IV(SecurityAssociation_t* sa_ptr, uint8_t* p_new_enc_frame
     status = Crypto_TC_ACS_Algo_Check(sa_ptr);
     if(status == CRYPTO_LIB_SUCCESS)
     {
-        status = Crypto_TC_Check_IV_Setup(sa_ptr, p_new_enc_frame, index);   
+        status = Crypto_TC_Check_IV_Setup(sa_ptr, counters, p_new_enc_frame, index);   
     }
 
     if(status != CRYPTO_LIB_SUCCESS)
     {
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
     }
     return status;
 }
@@ -892,6 +832,20 @@ int32_t Crypto_TC_ApplySecurity(const uint8_t* p_in_frame, const uint16_t in_fra
  **/
 int32_t Crypto_TC_ApplySecurity_Cam(const uint8_t* p_in_frame, const uint16_t in_frame_length, uint8_t** pp_in_frame,
                                     uint16_t* p_enc_frame_len, char* cam_cookies)
+{
+    int32_t status;
+
+    Crypto_Arena_Enter();
+    status = crypto_tc_apply_security_cam(p_in_frame, in_frame_length, pp_in_frame, p_enc_frame_len, cam_cookies);
+    Crypto_Arena_Leave();
+    return status;
+}
+
+/**
+ * @brief Function: crypto_tc_apply_security_cam
+ * ApplySecurity body, runs inside the scratch arena scope opened by Crypto_TC_ApplySecurity_Cam
+ **/
+static int32_t crypto_tc_apply_security_cam(const uint8_t* p_in_frame, const uint16_t in_frame_length, uint8_t** pp_in_frame, uint16_t* p_enc_frame_len, char* cam_cookies)
 {
     // Local Variables
     int32_t status = CRYPTO_LIB_SUCCESS;
@@ -909,6 +863,7 @@ int32_t Crypto_TC_ApplySecurity_Cam(const uint8_t* p_in_frame, const uint16_t in
     int i;
     uint32_t pkcs_padding = 0;
     crypto_key_t* ekp = NULL;
+    crypto_sa_counters_t counters;
     uint8_t map_id = 0;
     uint8_t segmentation_hdr = 0x00;
 
@@ -942,18 +897,24 @@ int32_t Crypto_TC_ApplySecurity_Cam(const uint8_t* p_in_frame, const uint16_t in
     printf(KYEL "DEBUG - Printing SA Entry for current frame.\n" RESET);
     Crypto_saPrint(sa_ptr);
 #endif
+    // SAs with a compiled profile skip the per-frame configuration checks below
+    const CryptoSaProfile_t* profile = Crypto_SA_Profile_Get(sa_ptr, TYPE_TC);
+    if (profile != NULL)
+    {
+        return profile->tc_apply(profile, sa_ptr, p_in_frame, temp_tc_header.fl, pp_in_frame, p_enc_frame_len, cam_cookies);
+    }
     // Determine SA Service Type
     status = Crypto_TC_Get_SA_Service_Type(&sa_service_type, sa_ptr);
     if(status != CRYPTO_LIB_SUCCESS)
     {
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
         return status;
     }
     // Determine Algorithm cipher & mode. // TODO - Parse authentication_cipher, and handle AEAD cases properly
     status = Crypto_TC_Get_Ciper_Mode_TCA(sa_service_type, &encryption_cipher, &ecs_is_aead_algorithm, sa_ptr);
     if(status != CRYPTO_LIB_SUCCESS)
     {
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
         return status;
     }
 #ifdef TC_DEBUG
@@ -1001,7 +962,7 @@ int32_t Crypto_TC_ApplySecurity_Cam(const uint8_t* p_in_frame, const uint16_t in
     status = Crypto_TC_Finalize_Frame_Setup(sa_service_type, &pkcs_padding, p_enc_frame_len, &new_enc_frame_header_field_length, tf_payload_len, &sa_ptr, &p_new_enc_frame);
     if(status != CRYPTO_LIB_SUCCESS)
     {
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
         return status;
     }
 
@@ -1043,7 +1004,7 @@ int32_t Crypto_TC_ApplySecurity_Cam(const uint8_t* p_in_frame, const uint16_t in
     */
     uint16_t index = TC_FRAME_HEADER_SIZE; // Frame header is 5 bytes
 
-    if (current_managed_parameters_struct.has_segmentation_hdr == TC_HAS_SEGMENT_HDRS)
+    if (current_managed_parameters->has_segmentation_hdr == TC_HAS_SEGMENT_HDRS)
     {
         index++; // Add 1 byte to index because segmentation header used for this gvcid.
     }
@@ -1056,11 +1017,18 @@ int32_t Crypto_TC_ApplySecurity_Cam(const uint8_t* p_in_frame, const uint16_t in
     *(p_new_enc_frame + index) = ((sa_ptr->spi & 0xFF00) >> 8);
     *(p_new_enc_frame + index + 1) = (sa_ptr->spi & 0x00FF);
     index += 2;
+    // Reserve this frame's IV and ARSN, the SA moves on past them right away
+    status = Crypto_SA_Counters_Reserve(sa_ptr, sa_service_type, &counters);
+    if(status != CRYPTO_LIB_SUCCESS)
+    {
+        return status;
+    }
     // Set initialization vector if specified
-    status = Crypto_TC_Set_IV(sa_ptr, p_new_enc_frame, &index);
+    status = Crypto_TC_Set_IV(sa_ptr, &counters, p_new_enc_frame, &index);
     if(status != CRYPTO_LIB_SUCCESS)
     {
-        mc_if->mc_log(status);
+        Crypto_SA_Counters_Gap(sa_ptr->spi, sa_service_type != SA_PLAINTEXT);
+        CRYPTO_MC_IF->mc_log(status);
         return status;   
     }
     // Set anti-replay sequence number if specified
@@ -1072,8 +1040,8 @@ int32_t Crypto_TC_ApplySecurity_Cam(const uint8_t* p_in_frame, const uint16_t in
     */
     for (i = sa_ptr->arsn_len - sa_ptr->shsnf_len; i < sa_ptr->arsn_len; i++)
     {
-        // Copy in ARSN from SA
-        *(p_new_enc_frame + index) = *(sa_ptr->arsn + i);
+        // Copy in reserved ARSN, a field longer than the ARSN still takes the SA bytes ahead of it
+        *(p_new_enc_frame + index) = (i < 0) ? *(sa_ptr->arsn + i) : counters.arsn[i];
         index++;
     }
 
@@ -1115,10 +1083,11 @@ int32_t Crypto_TC_ApplySecurity_Cam(const uint8_t* p_in_frame, const uint16_t in
     /*
     ** Begin Authentication / Encryption
     */
-    status = Crypto_TC_Do_Encrypt(sa_service_type, sa_ptr, &mac_loc, tf_payload_len, segment_hdr_len, p_new_enc_frame, ekp, &aad, ecs_is_aead_algorithm, &index, p_in_frame, cam_cookies, pkcs_padding, new_enc_frame_header_field_length, &new_fecf);
+    status = Crypto_TC_Do_Encrypt(sa_service_type, sa_ptr, &counters, &mac_loc, tf_payload_len, segment_hdr_len, p_new_enc_frame, ekp, &aad, ecs_is_aead_algorithm, &index, p_in_frame, cam_cookies, pkcs_padding, new_enc_frame_header_field_length, &new_fecf);
     if(status != CRYPTO_LIB_SUCCESS)
     {
-        mc_if->mc_log(status);
+        Crypto_SA_Counters_Gap(sa_ptr->spi, sa_service_type != SA_PLAINTEXT);
+        CRYPTO_MC_IF->mc_log(status);
         return status;   
     }
 
@@ -1134,13 +1103,12 @@ int32_t Crypto_TC_ApplySecurity_Cam(const uint8_t* p_in_frame, const uint16_t in
 
     *pp_in_frame = p_new_enc_frame;
 
-    status = sa_if->sa_save_sa(sa_ptr);
+    status = CRYPTO_SA_IF->sa_save_sa(sa_ptr);
 
 #ifdef DEBUG
     printf(KYEL "----- Crypto_TC_ApplySecurity END -----\n" RESET);
 #endif
-    Crypto_TC_Safe_Free_Ptr(aad);
-    mc_if->mc_log(status);
+    CRYPTO_MC_IF->mc_log(status);
     return status;
 }
 
@@ -1169,7 +1137,7 @@ int32_t Crypto_TC_ProcessSecurity(uint8_t* ingest, int* len_ingest, TC_t* tc_sdl
 int32_t Crypto_TC_Parse_Check_FECF(uint8_t* ingest, int* len_ingest, TC_t* tc_sdls_processed_frame)
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
-    if (current_managed_parameters_struct.has_fecf == TC_HAS_FECF)
+    if (current_managed_parameters->has_fecf == TC_HAS_FECF)
     {
         tc_sdls_processed_frame->tc_sec_trailer.fecf = (((ingest[tc_sdls_processed_frame->tc_header.fl - 1] << 8) & 0xFF00) |
                                                         (ingest[tc_sdls_processed_frame->tc_header.fl] & 0x00FF));
@@ -1188,7 +1156,7 @@ int32_t Crypto_TC_Parse_Check_FECF(uint8_t* ingest, int* len_ingest, TC_t* tc_sd
                 printf("FECF was Calced over %d bytes\n", *len_ingest - 2);
 #endif
                 status = CRYPTO_LIB_ERR_INVALID_FECF;
-                mc_if->mc_log(status);
+                CRYPTO_MC_IF->mc_log(status);
             }
         }
     }
@@ -1213,7 +1181,7 @@ int32_t Crypto_TC_Nontransmitted_IV_Increment(SecurityAssociation_t* sa_ptr, TC_
         status = crypto_handle_incrementing_nontransmitted_counter(tc_sdls_processed_frame->tc_sec_header.iv, sa_ptr->iv, sa_ptr->iv_len, sa_ptr->shivf_len, sa_ptr->arsnw);
         if (status != CRYPTO_LIB_SUCCESS)
         {
-            mc_if->mc_log(status);
+            CRYPTO_MC_IF->mc_log(status);
             return status;
         }
     }
@@ -1241,7 +1209,7 @@ int32_t Crypto_TC_Nontransmitted_SN_Increment(SecurityAssociation_t* sa_ptr, TC_
         status = crypto_handle_incrementing_nontransmitted_counter(tc_sdls_processed_frame->tc_sec_header.sn, sa_ptr->arsn, sa_ptr->arsn_len, sa_ptr->shsnf_len, sa_ptr->arsnw);
         if (status != CRYPTO_LIB_SUCCESS)
         {
-            mc_if->mc_log(status);
+            CRYPTO_MC_IF->mc_log(status);
         }
     }
     else // Not checking ARSN in ARSNW
@@ -1265,7 +1233,7 @@ int32_t Crypto_TC_Check_ACS_Keylen(crypto_key_t* akp, SecurityAssociation_t* sa_
     if ((int32_t)akp->key_len != Crypto_Get_ACS_Algo_Keylen(sa_ptr->acs))
     {
         status = CRYPTO_LIB_ERR_KEY_LENGTH_ERROR; 
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
     }
     return status;
 }
@@ -1283,7 +1251,7 @@ int32_t Crypto_TC_Check_ECS_Keylen(crypto_key_t* ekp, SecurityAssociation_t* sa_
     if ((int32_t)ekp->key_len != Crypto_Get_ECS_Algo_Keylen(sa_ptr->ecs))
     {
         status = CRYPTO_LIB_ERR_KEY_LENGTH_ERROR;
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
     } 
     return status;
 }
@@ -1308,14 +1276,13 @@ void Crypto_TC_Safe_Free_Ptr(uint8_t* ptr)
  * @param aad: uint8_t* 
  * @param tc_sdls_processed_frame: TC_t* 
  * @param ingest: uint8_t* 
- * @param tc_enc_payload_start_index: uint16_t 
+ * @param desc: const crypto_frame_desc_t* 
  * @param aad_len: uint16_t 
  * @param cam_cookies: char* 
  * @param akp: crypto_key_t* 
- * @param segment_hdr_len: uint8_t 
  * @return int32_t: Success/Failure
  **/
-int32_t Crypto_TC_Do_Decrypt(uint8_t sa_service_type, uint8_t ecs_is_aead_algorithm, crypto_key_t* ekp, SecurityAssociation_t* sa_ptr, uint8_t* aad, TC_t* tc_sdls_processed_frame, uint8_t* ingest, uint16_t tc_enc_payload_start_index, uint16_t aad_len, char* cam_cookies, crypto_key_t* akp, uint8_t segment_hdr_len)
+int32_t Crypto_TC_Do_Decrypt(uint8_t sa_service_type, uint8_t ecs_is_aead_algorithm, crypto_key_t* ekp, SecurityAssociation_t* sa_ptr, uint8_t* aad, TC_t* tc_sdls_processed_frame, uint8_t* ingest, const crypto_frame_desc_t* desc, uint16_t aad_len, char* cam_cookies, crypto_key_t* akp)
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
 
@@ -1325,14 +1292,13 @@ int32_t Crypto_TC_Do_Decrypt(uint8_t sa_service_type, uint8_t ecs_is_aead_algori
 
         status = Crypto_TC_Check_ECS_Keylen(ekp, sa_ptr);
         if(status!= CRYPTO_LIB_SUCCESS){
-            Crypto_TC_Safe_Free_Ptr(aad);
             return status;
         }
 
-        status = cryptography_if->cryptography_aead_decrypt(
+        status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_aead_decrypt(
             tc_sdls_processed_frame->tc_pdu,               // plaintext output
             (size_t)(tc_sdls_processed_frame->tc_pdu_len), // length of data
-            &(ingest[tc_enc_payload_start_index]),         // ciphertext input
+            &(ingest[desc->pdu_loc]),                    // ciphertext input
             (size_t)(tc_sdls_processed_frame->tc_pdu_len), // in data length
             &(ekp->value[0]),                              // Key
             Crypto_Get_ECS_Algo_Keylen(sa_ptr->ecs),       // 
@@ -1360,14 +1326,13 @@ int32_t Crypto_TC_Do_Decrypt(uint8_t sa_service_type, uint8_t ecs_is_aead_algori
             status = Crypto_TC_Check_ACS_Keylen(akp, sa_ptr);
             if(status!= CRYPTO_LIB_SUCCESS)
             {
-                Crypto_TC_Safe_Free_Ptr(aad);
                 return status;
             }
 
-            status = cryptography_if->cryptography_validate_authentication(
+            status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_validate_authentication(
                 tc_sdls_processed_frame->tc_pdu,               // plaintext output
                 (size_t)(tc_sdls_processed_frame->tc_pdu_len), // length of data
-                &(ingest[tc_enc_payload_start_index]),         // ciphertext input
+                &(ingest[desc->pdu_loc]),                    // ciphertext input
                 (size_t)(tc_sdls_processed_frame->tc_pdu_len), // in data length
                 &(akp->value[0]),                              // Key
                 Crypto_Get_ACS_Algo_Keylen(sa_ptr->acs),       // 
@@ -1388,16 +1353,15 @@ int32_t Crypto_TC_Do_Decrypt(uint8_t sa_service_type, uint8_t ecs_is_aead_algori
             // Check that key length to be used emets the algorithm requirement
             if ((int32_t)ekp->key_len != Crypto_Get_ECS_Algo_Keylen(sa_ptr->ecs))
             {
-                Crypto_TC_Safe_Free_Ptr(aad);
                 status = CRYPTO_LIB_ERR_KEY_LENGTH_ERROR; 
-                mc_if->mc_log(status);
+                CRYPTO_MC_IF->mc_log(status);
                 return status;
             }
 
-            status = cryptography_if->cryptography_decrypt(
+            status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_decrypt(
                 tc_sdls_processed_frame->tc_pdu,               // plaintext output
                 (size_t)(tc_sdls_processed_frame->tc_pdu_len), // length of data
-                &(ingest[tc_enc_payload_start_index]),         // ciphertext input
+                &(ingest[desc->pdu_loc]),                    // ciphertext input
                 (size_t)(tc_sdls_processed_frame->tc_pdu_len), // in data length
                 &(ekp->value[0]),                              // Key
                 Crypto_Get_ECS_Algo_Keylen(sa_ptr->ecs),       // 
@@ -1412,11 +1376,9 @@ int32_t Crypto_TC_Do_Decrypt(uint8_t sa_service_type, uint8_t ecs_is_aead_algori
             // Handle Padding Removal
             if (sa_ptr->shplf_len != 0)
             {
-                int padding_location = TC_FRAME_HEADER_SIZE + segment_hdr_len + SPI_LEN + sa_ptr->shivf_len +
-                                       sa_ptr->shsnf_len;
                 uint16_t padding_amount = 0;
                 // Get Padding Amount from ingest frame
-                padding_amount = (int)ingest[padding_location];
+                padding_amount = (int)ingest[desc->pl_loc];
                 // Remove Padding from final decrypted portion
                 tc_sdls_processed_frame->tc_pdu_len -= padding_amount;
             }
@@ -1424,7 +1386,7 @@ int32_t Crypto_TC_Do_Decrypt(uint8_t sa_service_type, uint8_t ecs_is_aead_algori
     }
     else if (sa_service_type == SA_PLAINTEXT)
     {
-        memcpy(tc_sdls_processed_frame->tc_pdu, &(ingest[tc_enc_payload_start_index]),
+        memcpy(tc_sdls_processed_frame->tc_pdu, &(ingest[desc->pdu_loc]),
                tc_sdls_processed_frame->tc_pdu_len);
     }
     return status;
@@ -1446,14 +1408,14 @@ int32_t Crypto_TC_Process_Sanity_Check(int* len_ingest)
 
     if ((mc_if == NULL) || (crypto_config.init_status == UNITIALIZED))
     {
-        printf(KRED "ERROR: CryptoLib Configuration Not Set! -- CRYPTO_LIB_ERR_NO_CONFIG, Will Exit\n" RESET);
         status = CRYPTO_LIB_ERR_NO_CONFIG;
-        mc_if->mc_log(status);
+        Crypto_MC_Event(status, MC_EVENT_SPI_NA, NULL, "CryptoLib Configuration Not Set");
+        CRYPTO_MC_IF->mc_log(status);
     }
     if ((*len_ingest < 5) && (status == CRYPTO_LIB_SUCCESS)) // Frame length doesn't even have enough bytes for header -- error out.
     {
         status = CRYPTO_LIB_ERR_INPUT_FRAME_TOO_SHORT_FOR_TC_STANDARD;
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
     }
     return status;
 }
@@ -1462,47 +1424,49 @@ int32_t Crypto_TC_Process_Sanity_Check(int* len_ingest)
  * @brief Function: Crypto_TC_Prep_AAD
  * Validates and Prepares AAD as necessary
  * @param tc_sdls_processed_frame: TC_t* 
- * @param fecf_len: uint8_t 
+ * @param desc: const crypto_frame_desc_t* 
  * @param sa_service_type: uint8_t 
  * @param ecs_is_aead_algorithm: uint8_t 
  * @param aad_len: uint16_t* 
  * @param sa_ptr: SecurityAssociation_t* 
- * @param segment_hdr_len: uint8_t 
  * @param ingest: uint8_t* 
  * @param aad: uint8_t** 
  * @return int32_t: Success/Failure
  **/
-int32_t Crypto_TC_Prep_AAD(TC_t* tc_sdls_processed_frame, uint8_t fecf_len,  uint8_t sa_service_type, uint8_t ecs_is_aead_algorithm, uint16_t* aad_len, SecurityAssociation_t* sa_ptr, uint8_t segment_hdr_len, uint8_t* ingest, uint8_t** aad)
+int32_t Crypto_TC_Prep_AAD(TC_t* tc_sdls_processed_frame, const crypto_frame_desc_t* desc, uint8_t sa_service_type, uint8_t ecs_is_aead_algorithm, uint16_t* aad_len, SecurityAssociation_t* sa_ptr, uint8_t* ingest, uint8_t** aad)
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
     uint16_t aad_len_temp = *aad_len;
 
     if ((sa_service_type == SA_AUTHENTICATION) || (sa_service_type == SA_AUTHENTICATED_ENCRYPTION))
         {
-            uint16_t tc_mac_start_index = tc_sdls_processed_frame->tc_header.fl + 1 - fecf_len - sa_ptr->stmacf_len;
-
             // Parse the received MAC
             memcpy((tc_sdls_processed_frame->tc_sec_trailer.mac),
-                &(ingest[tc_mac_start_index]), sa_ptr->stmacf_len);
+                &(ingest[desc->mac_loc]), sa_ptr->stmacf_len);
 #ifdef DEBUG
         printf("MAC Parsed from Frame:\n");
         Crypto_hexprint(tc_sdls_processed_frame->tc_sec_trailer.mac, sa_ptr->stmacf_len);
 #endif
-            aad_len_temp = tc_mac_start_index;
+            aad_len_temp = desc->mac_loc;
 
 
         if ((sa_service_type == SA_AUTHENTICATED_ENCRYPTION) && (ecs_is_aead_algorithm == CRYPTO_TRUE))
         {
-            aad_len_temp = TC_FRAME_HEADER_SIZE + segment_hdr_len + SPI_LEN + sa_ptr->shivf_len + sa_ptr->shsnf_len +
-                    sa_ptr->shplf_len;
+            aad_len_temp = desc->pdu_loc;
         }
         if (sa_ptr->abm_len < aad_len_temp)
         {
             status = CRYPTO_LIB_ERR_ABM_TOO_SHORT_FOR_AAD;
-            mc_if->mc_log(status);
+            CRYPTO_MC_IF->mc_log(status);
             return status;
         }
         *aad = Crypto_Prepare_TC_AAD(ingest, aad_len_temp, sa_ptr->abm);
+        if (*aad == NULL)
+        {
+            status = CRYPTO_LIB_ERR_ARENA_EXHAUSTED;
+            CRYPTO_MC_IF->mc_log(status);
+            return status;
+        }
         *aad_len = aad_len_temp;
         aad = aad;
     }
@@ -1521,19 +1485,19 @@ int32_t Crypto_TC_Prep_AAD(TC_t* tc_sdls_processed_frame, uint8_t fecf_len,  uin
 int32_t Crypto_TC_Get_Keys(crypto_key_t** ekp, crypto_key_t** akp, SecurityAssociation_t* sa_ptr)
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
-    *ekp = key_if->get_key(sa_ptr->ekid);
-    *akp = key_if->get_key(sa_ptr->akid);
+    *ekp = CRYPTO_KEY_IF->get_key(sa_ptr->ekid);
+    *akp = CRYPTO_KEY_IF->get_key(sa_ptr->akid);
 
     if (ekp == NULL)
     {
         status = CRYPTO_LIB_ERR_KEY_ID_ERROR;
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
     }
     
     if ((akp == NULL) && (status == CRYPTO_LIB_SUCCESS))
     {
         status = CRYPTO_LIB_ERR_KEY_ID_ERROR;
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
     }
     return status;
 }
@@ -1555,15 +1519,15 @@ int32_t Crypto_TC_Check_IV_ARSN(SecurityAssociation_t* sa_ptr,TC_t* tc_sdls_proc
 
         if (status != CRYPTO_LIB_SUCCESS)
         {
-            mc_if->mc_log(status);
+            CRYPTO_MC_IF->mc_log(status);
         }
         if(status == CRYPTO_LIB_SUCCESS) // else
         {
             // Only save the SA (IV/ARSN) if checking the anti-replay counter; Otherwise we don't update.
-            status = sa_if->sa_save_sa(sa_ptr);
+            status = CRYPTO_SA_IF->sa_save_sa(sa_ptr);
             if (status != CRYPTO_LIB_SUCCESS)
             {
-                mc_if->mc_log(status);
+                CRYPTO_MC_IF->mc_log(status);
             }
         } 
     }
@@ -1592,7 +1556,7 @@ uint32_t Crypto_TC_Sanity_Validations(TC_t* tc_sdls_processed_frame, SecurityAss
 {
     uint32_t status = CRYPTO_LIB_SUCCESS;
 
-    status = sa_if->sa_get_from_spi(tc_sdls_processed_frame->tc_sec_header.spi, sa_ptr);
+    status = CRYPTO_SA_IF->sa_get_from_spi(tc_sdls_processed_frame->tc_sec_header.spi, sa_ptr);
     // If no valid SPI, return
     if(status == CRYPTO_LIB_SUCCESS)
     {
@@ -1601,7 +1565,7 @@ uint32_t Crypto_TC_Sanity_Validations(TC_t* tc_sdls_processed_frame, SecurityAss
     }
     if(status != CRYPTO_LIB_SUCCESS)
     {
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
     }
 
     return status;
@@ -1632,33 +1596,90 @@ void Crypto_TC_Get_Ciper_Mode_TCP(uint8_t sa_service_type, uint32_t* encryption_
  **/
 void Crypto_TC_Calc_Lengths(uint8_t* fecf_len, uint8_t* segment_hdr_len)
 {
-    if (current_managed_parameters_struct.has_fecf == TC_NO_FECF)
+    if (current_managed_parameters->has_fecf == TC_NO_FECF)
     {
         *fecf_len = 0;
     }
 
-    if (current_managed_parameters_struct.has_segmentation_hdr == TC_NO_SEGMENT_HDRS)
+    if (current_managed_parameters->has_segmentation_hdr == TC_NO_SEGMENT_HDRS)
     {
         *segment_hdr_len = 0;
     }
 }
 
- /** 
- * @brief Function: Crypto_TC_Set_Segment_Header
- * Sets up TC Segment Header as necessary
- * @param tc_sdls_processed_frame: TC_t* 
- * @param ingest: uint8_t* 
- * @param byte_idx: int*  
+/**
+ * @brief Function: Crypto_TC_Decode_Frame
+ * Decodes the TC primary header, segment header, and SPI of a received frame in one pass
+ * Fills the processed frame header fields and the frame descriptor used by the later processing stages,
+ * and looks up the managed parameters for the frame GVCID
+ * @param ingest: uint8_t*
+ * @param len_ingest: int
+ * @param tc_sdls_processed_frame: TC_t*
+ * @param desc: crypto_frame_desc_t*
+ * @return int32: Success/Failure
  **/
-void Crypto_TC_Set_Segment_Header(TC_t* tc_sdls_processed_frame, uint8_t* ingest, int* byte_idx)
+int32_t Crypto_TC_Decode_Frame(uint8_t* ingest, int len_ingest, TC_t* tc_sdls_processed_frame, crypto_frame_desc_t* desc)
 {
-    int byte_idx_tmp = *byte_idx;
-    if (current_managed_parameters_struct.has_segmentation_hdr == TC_HAS_SEGMENT_HDRS)
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    TC_FramePrimaryHeader_t* tc_header = &tc_sdls_processed_frame->tc_header;
+
+    memset(desc, 0, sizeof(crypto_frame_desc_t));
+    desc->frame_type = TYPE_TC;
+
+    // Primary Header
+    tc_header->tfvn = ((uint8_t)ingest[0] & 0xC0) >> 6;
+    tc_header->bypass = ((uint8_t)ingest[0] & 0x20) >> 5;
+    tc_header->cc = ((uint8_t)ingest[0] & 0x10) >> 4;
+    tc_header->spare = ((uint8_t)ingest[0] & 0x0C) >> 2;
+    tc_header->scid = (((uint8_t)ingest[0] & 0x03) << 8) | (uint8_t)ingest[1];
+    tc_header->vcid = (((uint8_t)ingest[2] & 0xFC) >> 2) & crypto_config.vcid_bitmask;
+    tc_header->fl = (((uint8_t)ingest[2] & 0x03) << 8) | (uint8_t)ingest[3];
+    tc_header->fsn = (uint8_t)ingest[4];
+
+    if (len_ingest < tc_header->fl + 1) // Specified frame length larger than provided frame!
     {
-        tc_sdls_processed_frame->tc_sec_header.sh = (uint8_t)ingest[*byte_idx];
-        byte_idx_tmp++;
+        status = CRYPTO_LIB_ERR_INPUT_FRAME_LENGTH_SHORTER_THAN_FRAME_HEADERS_LENGTH;
+        CRYPTO_MC_IF->mc_log(status);
+        return status;
     }
-    *byte_idx = byte_idx_tmp;
+
+    if (tc_header->tfvn != TC_TFVN)
+    {
+        status = CRYPTO_LIB_ERR_INVALID_TFVN;
+        CRYPTO_MC_IF->mc_log(status);
+        return status;
+    }
+
+    // Lookup-retrieve managed parameters for frame via gvcid:
+    status = Crypto_Get_Managed_Parameters_Ptr_For_Gvcid(tc_header->tfvn, tc_header->scid, tc_header->vcid,
+                                                         &current_managed_parameters);
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        CRYPTO_MC_IF->mc_log(status);
+        return status;
+    } // Unable to get necessary Managed Parameters for TC TF -- return with error.
+
+    desc->tfvn = tc_header->tfvn;
+    desc->scid = tc_header->scid;
+    desc->vcid = tc_header->vcid;
+    desc->frame_len = tc_header->fl + 1;
+    desc->fecf_len = (current_managed_parameters->has_fecf == TC_NO_FECF) ? 0 : FECF_SIZE;
+    desc->spi_loc = TC_FRAME_HEADER_SIZE;
+
+    // Segment Header
+    if (current_managed_parameters->has_segmentation_hdr == TC_HAS_SEGMENT_HDRS)
+    {
+        tc_sdls_processed_frame->tc_sec_header.sh = (uint8_t)ingest[TC_FRAME_HEADER_SIZE];
+        desc->map_id = tc_sdls_processed_frame->tc_sec_header.sh & 0x3F;
+        desc->seg_hdr_len = TC_SEGMENT_HDR_SIZE;
+        desc->spi_loc += TC_SEGMENT_HDR_SIZE;
+    }
+
+    // Security Header
+    desc->spi = ((uint8_t)ingest[desc->spi_loc] << 8) | (uint8_t)ingest[desc->spi_loc + 1];
+    tc_sdls_processed_frame->tc_sec_header.spi = desc->spi;
+
+    return status;
 }
 
 /**
@@ -1670,6 +1691,25 @@ void Crypto_TC_Set_Segment_Header(TC_t* tc_sdls_processed_frame, uint8_t* ingest
  * @return int32: Success/Failure
 **/
 int32_t Crypto_TC_ProcessSecurity_Cam(uint8_t* ingest, int* len_ingest, TC_t* tc_sdls_processed_frame, char* cam_cookies)
+{
+    int32_t status;
+    crypto_frame_desc_t desc;
+
+    desc.admitted = CRYPTO_FALSE;
+    Crypto_Arena_Enter();
+    status = crypto_tc_process_security_cam(ingest, len_ingest, tc_sdls_processed_frame, cam_cookies, &desc);
+    Crypto_MC_Reject_Record(&desc, status);
+    Crypto_Arena_Leave();
+    return status;
+}
+
+/**
+ * @brief Function: crypto_tc_process_security_cam
+ * ProcessSecurity body, runs inside the scratch arena scope opened by Crypto_TC_ProcessSecurity_Cam
+ * Checks run cheapest first: length, version and GVCID, rejection budget, SPI and SA state, anti-replay window, FECF,
+ * and only then keys and cryptography
+ **/
+static int32_t crypto_tc_process_security_cam(uint8_t* ingest, int* len_ingest, TC_t* tc_sdls_processed_frame, char* cam_cookies, crypto_frame_desc_t* desc)
 // Loads the ingest frame into the global tc_frame while performing decryption
 {
     // Local Variables
@@ -1684,55 +1724,23 @@ int32_t Crypto_TC_ProcessSecurity_Cam(uint8_t* ingest, int* len_ingest, TC_t* tc
     crypto_key_t* ekp = NULL;
     crypto_key_t* akp = NULL;
 
-    int byte_idx = 0;
-
     status = Crypto_TC_Process_Sanity_Check(len_ingest);
     if (status != CRYPTO_LIB_SUCCESS)
     {
         return status;
     }    
 
-    // Primary Header
-    tc_sdls_processed_frame->tc_header.tfvn = ((uint8_t)ingest[byte_idx] & 0xC0) >> 6;
-    tc_sdls_processed_frame->tc_header.bypass = ((uint8_t)ingest[byte_idx] & 0x20) >> 5;
-    tc_sdls_processed_frame->tc_header.cc = ((uint8_t)ingest[byte_idx] & 0x10) >> 4;
-    tc_sdls_processed_frame->tc_header.spare = ((uint8_t)ingest[byte_idx] & 0x0C) >> 2;
-    tc_sdls_processed_frame->tc_header.scid = ((uint8_t)ingest[byte_idx] & 0x03) << 8;
-    byte_idx++;
-    tc_sdls_processed_frame->tc_header.scid = tc_sdls_processed_frame->tc_header.scid | (uint8_t)ingest[byte_idx];
-    byte_idx++;
-    tc_sdls_processed_frame->tc_header.vcid = (((uint8_t)ingest[byte_idx] & 0xFC) >> 2) & crypto_config.vcid_bitmask;
-    tc_sdls_processed_frame->tc_header.fl = ((uint8_t)ingest[byte_idx] & 0x03) << 8;
-    byte_idx++;
-    tc_sdls_processed_frame->tc_header.fl = tc_sdls_processed_frame->tc_header.fl | (uint8_t)ingest[byte_idx];
-    byte_idx++;
-    tc_sdls_processed_frame->tc_header.fsn = (uint8_t)ingest[byte_idx];
-    byte_idx++;
-
-    if (*len_ingest < tc_sdls_processed_frame->tc_header.fl + 1) // Specified frame length larger than provided frame!
+    // Decode primary header, segment header, and SPI once for all later stages
+    status = Crypto_TC_Decode_Frame(ingest, *len_ingest, tc_sdls_processed_frame, desc);
+    if (status != CRYPTO_LIB_SUCCESS)
     {
-        status = CRYPTO_LIB_ERR_INPUT_FRAME_LENGTH_SHORTER_THAN_FRAME_HEADERS_LENGTH;
-        mc_if->mc_log(status);
         return status;
     }
-
-    // Lookup-retrieve managed parameters for frame via gvcid:
-    status = Crypto_Get_Managed_Parameters_For_Gvcid(
-        tc_sdls_processed_frame->tc_header.tfvn, tc_sdls_processed_frame->tc_header.scid,
-        tc_sdls_processed_frame->tc_header.vcid, gvcid_managed_parameters_array, &current_managed_parameters_struct);
-
+    status = Crypto_MC_Reject_Admit(desc);
     if (status != CRYPTO_LIB_SUCCESS)
     {
-        mc_if->mc_log(status);
         return status;
-    } // Unable to get necessary Managed Parameters for TC TF -- return with error.
-
-    // Segment Header
-    Crypto_TC_Set_Segment_Header(tc_sdls_processed_frame, ingest, &byte_idx);
-
-    // Security Header
-    tc_sdls_processed_frame->tc_sec_header.spi = ((uint8_t)ingest[byte_idx] << 8) | (uint8_t)ingest[byte_idx + 1];
-    byte_idx += 2;
+    }
 
 #ifdef TC_DEBUG
     printf("vcid = %d \n", tc_sdls_processed_frame->tc_header.vcid);
@@ -1742,7 +1750,7 @@ int32_t Crypto_TC_ProcessSecurity_Cam(uint8_t* ingest, int* len_ingest, TC_t* tc
     status = Crypto_TC_Sanity_Validations(tc_sdls_processed_frame, &sa_ptr);
     if (status != CRYPTO_LIB_SUCCESS)
     {
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
         return status;
     }
 
@@ -1782,18 +1790,16 @@ int32_t Crypto_TC_ProcessSecurity_Cam(uint8_t* ingest, int* len_ingest, TC_t* tc
     }
 #endif
 
-    // TODO: Calculate lengths when needed
-    uint8_t fecf_len = FECF_SIZE;
-    uint8_t segment_hdr_len = TC_SEGMENT_HDR_SIZE;
-
-    Crypto_TC_Calc_Lengths(&fecf_len, &segment_hdr_len);
-
-    // Parse & Check FECF
-    Crypto_TC_Parse_Check_FECF(ingest, len_ingest, tc_sdls_processed_frame);
-
+    // Locate security header fields, PDU, and MAC for this SA
+    status = Crypto_Frame_Desc_Set_SA(desc, sa_ptr);
+    if (status != CRYPTO_LIB_SUCCESS) // invalid header parsed, sizes overflowed & make no sense!
+    {
+        CRYPTO_MC_IF->mc_log(status);
+        return status;
+    }
 
     // Parse transmitted portion of IV from received frame (Will be Whole IV if iv_len==shivf_len)
-    memcpy((tc_sdls_processed_frame->tc_sec_header.iv + (sa_ptr->iv_len - sa_ptr->shivf_len)), &(ingest[TC_FRAME_HEADER_SIZE + segment_hdr_len + SPI_LEN]),
+    memcpy((tc_sdls_processed_frame->tc_sec_header.iv + (sa_ptr->iv_len - sa_ptr->shivf_len)), &(ingest[desc->iv_loc]),
            sa_ptr->shivf_len);
 
     // Handle non-transmitted IV increment case (transmitted-portion roll-over)
@@ -1810,7 +1816,7 @@ int32_t Crypto_TC_ProcessSecurity_Cam(uint8_t* ingest, int* len_ingest, TC_t* tc
 
     // Parse transmitted portion of ARSN
     memcpy((tc_sdls_processed_frame->tc_sec_header.sn + (sa_ptr->arsn_len - sa_ptr->shsnf_len)),
-           &(ingest[TC_FRAME_HEADER_SIZE + segment_hdr_len + SPI_LEN + sa_ptr->shivf_len]), sa_ptr->shsnf_len);
+           &(ingest[desc->sn_loc]), sa_ptr->shsnf_len);
 
     // Handle non-transmitted SN increment case (transmitted-portion roll-over)
     status = Crypto_TC_Nontransmitted_SN_Increment(sa_ptr, tc_sdls_processed_frame);
@@ -1824,35 +1830,40 @@ int32_t Crypto_TC_ProcessSecurity_Cam(uint8_t* ingest, int* len_ingest, TC_t* tc
     Crypto_hexprint(tc_sdls_processed_frame->tc_sec_header.sn, sa_ptr->arsn_len);
 #endif
 
+    // Stale IV/ARSN is dropped here, before the CRC and the MAC; the window itself only moves once the MAC verifies
+    if (crypto_config.ignore_anti_replay == TC_IGNORE_ANTI_REPLAY_FALSE)
+    {
+        status = Crypto_Precheck_Anti_Replay(sa_ptr, tc_sdls_processed_frame->tc_sec_header.sn,
+                                             tc_sdls_processed_frame->tc_sec_header.iv);
+        if (status != CRYPTO_LIB_SUCCESS)
+        {
+            CRYPTO_MC_IF->mc_log(status);
+            return status;
+        }
+    }
+
+    // Parse & Check FECF
+    status = Crypto_TC_Parse_Check_FECF(ingest, len_ingest, tc_sdls_processed_frame);
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        return status;
+    }
+
     // Parse pad length
     // tc_sdls_processed_frame->tc_sec_header.pad = malloc((sa_ptr->shplf_len * sizeof(uint8_t)));
-    memcpy((tc_sdls_processed_frame->tc_sec_header.pad),
-           &(ingest[TC_FRAME_HEADER_SIZE + segment_hdr_len + SPI_LEN + sa_ptr->shivf_len + sa_ptr->shsnf_len]),
-           sa_ptr->shplf_len);
+    memcpy((tc_sdls_processed_frame->tc_sec_header.pad), &(ingest[desc->pl_loc]), sa_ptr->shplf_len);
 
     // Parse MAC, prepare AAD
-    status = Crypto_TC_Prep_AAD(tc_sdls_processed_frame, fecf_len, sa_service_type, ecs_is_aead_algorithm, &aad_len, sa_ptr, segment_hdr_len, ingest, &aad);
+    status = Crypto_TC_Prep_AAD(tc_sdls_processed_frame, desc, sa_service_type, ecs_is_aead_algorithm, &aad_len, sa_ptr, ingest, &aad);
 
     if(status != CRYPTO_LIB_SUCCESS)
     {
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
         return status;
     }
-    
-
-    uint16_t tc_enc_payload_start_index = TC_FRAME_HEADER_SIZE + segment_hdr_len + SPI_LEN + sa_ptr->shivf_len +
-                                          sa_ptr->shsnf_len + sa_ptr->shplf_len;
 
     // Todo -- if encrypt only, ignore stmacf_len entirely to avoid erroring on SA misconfiguration... Or just throw a warning/error indicating SA misconfiguration?
-    tc_sdls_processed_frame->tc_pdu_len =
-        tc_sdls_processed_frame->tc_header.fl + 1 - tc_enc_payload_start_index - sa_ptr->stmacf_len - fecf_len;
-
-    if (tc_sdls_processed_frame->tc_pdu_len > tc_sdls_processed_frame->tc_header.fl) // invalid header parsed, sizes overflowed & make no sense!
-    {
-        status = CRYPTO_LIB_ERR_INVALID_HEADER;
-        mc_if->mc_log(status);
-        return status;
-    }
+    tc_sdls_processed_frame->tc_pdu_len = desc->pdu_len;
 
 #ifdef DEBUG
     printf(KYEL "TC PDU Calculated Length: %d \n" RESET, tc_sdls_processed_frame->tc_pdu_len);
@@ -1862,15 +1873,14 @@ int32_t Crypto_TC_ProcessSecurity_Cam(uint8_t* ingest, int* len_ingest, TC_t* tc
     status = Crypto_TC_Get_Keys(&ekp, &akp, sa_ptr);
     if (status != CRYPTO_LIB_SUCCESS)
     {
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
         return status; 
     }
 
-    status = Crypto_TC_Do_Decrypt(sa_service_type, ecs_is_aead_algorithm, ekp, sa_ptr, aad, tc_sdls_processed_frame, ingest, tc_enc_payload_start_index, aad_len, cam_cookies, akp, segment_hdr_len);
+    status = Crypto_TC_Do_Decrypt(sa_service_type, ecs_is_aead_algorithm, ekp, sa_ptr, aad, tc_sdls_processed_frame, ingest, desc, aad_len, cam_cookies, akp);
     if (status != CRYPTO_LIB_SUCCESS)
     {
-        Crypto_TC_Safe_Free_Ptr(aad);
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
         return status; // Cryptography IF call failed, return.
     }
 
@@ -1878,8 +1888,7 @@ int32_t Crypto_TC_ProcessSecurity_Cam(uint8_t* ingest, int* len_ingest, TC_t* tc
     status = Crypto_TC_Check_IV_ARSN(sa_ptr, tc_sdls_processed_frame);
     if (status != CRYPTO_LIB_SUCCESS)
     {
-        Crypto_TC_Safe_Free_Ptr(aad);
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
         return status; // Cryptography IF call failed, return.
     }
     
@@ -1889,9 +1898,7 @@ int32_t Crypto_TC_ProcessSecurity_Cam(uint8_t* ingest, int* len_ingest, TC_t* tc
         status = Crypto_Process_Extended_Procedure_Pdu(tc_sdls_processed_frame, ingest);
     }
     
-    Crypto_TC_Safe_Free_Ptr(aad);
-
-    mc_if->mc_log(status);
+    CRYPTO_MC_IF->mc_log(status);
     return status;
 }
 
@@ -1906,8 +1913,8 @@ int32_t Crypto_TC_ProcessSecurity_Cam(uint8_t* ingest, int* len_ingest, TC_t* tc
 int32_t Crypto_Get_tcPayloadLength(TC_t* tc_frame, SecurityAssociation_t* sa_ptr)
 {
     int tf_hdr = 5;
-    int seg_hdr = 0;if(current_managed_parameters_struct.has_segmentation_hdr==TC_HAS_SEGMENT_HDRS){seg_hdr=1;}
-    int fecf = 0;if(current_managed_parameters_struct.has_fecf==TC_HAS_FECF){fecf=FECF_SIZE;}
+    int seg_hdr = 0;if(current_managed_parameters->has_segmentation_hdr==TC_HAS_SEGMENT_HDRS){seg_hdr=1;}
+    int fecf = 0;if(current_managed_parameters->has_fecf==TC_HAS_FECF){fecf=FECF_SIZE;}
     int spi = 2;
     int iv_size = sa_ptr->shivf_len;
     int mac_size = sa_ptr->stmacf_len;
@@ -1930,17 +1937,23 @@ fecf))); #endif
 
 /**
  * @brief Function: Crypto_Prepare_TC_AAD
- * Callocs and returns pointer to buffer where AAD is created & bitwise-anded with bitmask!
- * Note: Function caller is responsible for freeing the returned buffer!
+ * Returns pointer to scratch arena buffer where AAD is created & bitwise-anded with bitmask!
+ * Note: The buffer is released when the enclosing ApplySecurity/ProcessSecurity call returns, do not free it.
  * @param buffer: uint8_t*
  * @param len_aad: uint16_t
  * @param abm_buffer: uint8_t*
+ * @return uint8_t*: AAD, NULL if the scratch arena is exhausted
 **/
 uint8_t* Crypto_Prepare_TC_AAD(uint8_t* buffer, uint16_t len_aad, uint8_t* abm_buffer)
 {
-    uint8_t* aad = (uint8_t*)calloc(1, len_aad * sizeof(uint8_t));
+    uint8_t* aad = (uint8_t*)Crypto_Arena_Alloc(len_aad * sizeof(uint8_t));
     int i;
 
+    if (aad == NULL)
+    {
+        return NULL;
+    }
+
     for (i = 0; i < len_aad; i++)
     {
         aad[i] = buffer[i] & abm_buffer[i];
@@ -2019,7 +2032,11 @@ static int32_t crypto_handle_incrementing_nontransmitted_counter(uint8_t* dest,
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
     // Copy IV to temp
-    uint8_t* temp_counter = malloc(src_full_len);
+    uint8_t* temp_counter = (uint8_t*)Crypto_Arena_Alloc(src_full_len);
+    if (temp_counter == NULL)
+    {
+        return CRYPTO_LIB_ERR_ARENA_EXHAUSTED;
+    }
     memcpy(temp_counter, src, src_full_len);
 
     // Increment temp_counter Until Transmitted Portion Matches Frame.
@@ -2060,6 +2077,5 @@ static int32_t crypto_handle_incrementing_nontransmitted_counter(uint8_t* dest,
     {
         status = CRYPTO_LIB_ERR_FRAME_COUNTER_DOESNT_MATCH_SA;
     }
-    if (!temp_counter) free(temp_counter);
     return status;
 }
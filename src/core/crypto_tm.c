@@ -23,6 +23,95 @@
 
 #include <string.h> // memcpy/memset
 
+#ifdef CRYPTO_TM_PARALLEL
+#include <pthread.h>
+#endif
+
+/*
+** TM Process Context
+** Per-frame state handed from the ProcessSecurity setup stage to decryption
+*/
+typedef struct
+{
+    crypto_frame_desc_t desc;
+    SecurityAssociation_t* sa_ptr;
+    crypto_key_t* ekp;
+    crypto_key_t* akp;
+    uint8_t* p_new_dec_frame;
+    uint8_t sa_service_type;
+    uint8_t ecs_is_aead_algorithm;
+    uint8_t idle_policy; // IDLE_FRAMES_PROCESS unless the frame is idle fill
+    uint16_t aad_len;
+    uint8_t aad[1786];
+} crypto_tm_process_ctx_t;
+
+/*
+** TM Batch Share
+** Part of one batch window decrypted by a single thread, queued to the worker pool through next
+*/
+typedef struct crypto_tm_batch_share_s crypto_tm_batch_share_t;
+typedef struct crypto_tm_batch_window_s crypto_tm_batch_window_t;
+struct crypto_tm_batch_share_s
+{
+    crypto_tm_batch_job_t* jobs;
+    crypto_tm_process_ctx_t* ctx;
+    uint32_t count;
+    uint32_t first;
+    uint32_t stride;
+    crypto_tm_batch_window_t* window;
+    crypto_tm_batch_share_t* next;
+};
+
+/*
+** TM Batch Window
+** Decrypt stage of one window in flight, pending is guarded by the pool lock once the shares are queued
+*/
+struct crypto_tm_batch_window_s
+{
+    crypto_tm_batch_share_t shares[TM_BATCH_MAX_THREADS];
+    uint32_t num_shares;
+    uint32_t pending;
+    uint8_t queued;
+};
+
+#ifdef CRYPTO_TM_PARALLEL
+/*
+** TM Batch Pool
+** Decrypt threads kept from the first parallel batch until Crypto_Shutdown, shared by every batch caller
+*/
+typedef struct
+{
+    pthread_mutex_t lock;
+    pthread_cond_t posted;   // A share was queued or the pool is stopping
+    pthread_cond_t finished; // The last share of a window finished
+    crypto_tm_batch_share_t* head;
+    crypto_tm_batch_share_t* tail;
+    pthread_t threads[TM_BATCH_MAX_THREADS];
+    uint32_t num_threads;
+    uint8_t stopping;
+} crypto_tm_batch_pool_t;
+
+static crypto_tm_batch_pool_t crypto_tm_batch_pool = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER,
+                                                      PTHREAD_COND_INITIALIZER, NULL, NULL, {0}, 0, 0};
+#endif
+
+/* Helper functions */
+static int32_t crypto_tm_apply_security(uint8_t* pTfBuffer);
+static int32_t crypto_tm_process_security(uint8_t* p_ingest, uint16_t len_ingest, uint8_t** pp_processed_frame, uint16_t* p_decrypted_length);
+static int32_t crypto_tm_process_prepare(uint8_t* p_ingest, uint16_t len_ingest, uint8_t alloc_output, uint8_t precheck_replay, crypto_tm_process_ctx_t* ctx);
+static int32_t crypto_tm_process_commit(const crypto_tm_process_ctx_t* ctx, uint8_t* p_ingest, uint8_t** pp_processed_frame, uint16_t* p_decrypted_length);
+static void crypto_tm_batch_decrypt_share(crypto_tm_batch_share_t* share);
+static void crypto_tm_batch_post(crypto_tm_batch_window_t* window, crypto_tm_batch_job_t* jobs, crypto_tm_process_ctx_t* ctx, uint32_t count, uint32_t num_workers);
+static void crypto_tm_batch_finish(crypto_tm_batch_window_t* window);
+static void crypto_tm_batch_setup(crypto_tm_batch_job_t* jobs, crypto_tm_process_ctx_t* ctx, uint32_t count);
+static void crypto_tm_batch_commit(crypto_tm_batch_job_t* jobs, crypto_tm_process_ctx_t* ctx, uint32_t count);
+static uint32_t crypto_tm_batch_workers(uint32_t num_threads);
+#ifdef CRYPTO_TM_PARALLEL
+static crypto_tm_batch_share_t* crypto_tm_batch_pool_pop(void);
+static void crypto_tm_batch_pool_run(crypto_tm_batch_share_t* share);
+static void* crypto_tm_batch_pool_main(void* arg);
+#endif
+
 /**
  * @brief Function: Crypto_TM_Sanity_Check
  * Verify that needed buffers and settings are not null
@@ -40,8 +129,8 @@ int32_t Crypto_TM_Sanity_Check(uint8_t* pTfBuffer)
 
     if ((status == CRYPTO_LIB_SUCCESS) && ((crypto_config.init_status == UNITIALIZED) || (mc_if == NULL) || (sa_if == NULL)))
     {
-        printf(KRED "ERROR: CryptoLib Configuration Not Set! -- CRYPTO_LIB_ERR_NO_CONFIG, Will Exit\n" RESET);
         status = CRYPTO_LIB_ERR_NO_CONFIG;
+        Crypto_MC_Event(status, MC_EVENT_SPI_NA, NULL, "CryptoLib Configuration Not Set");
         // Can't mc_log since it's not configured
     }
     return status;
@@ -77,12 +166,12 @@ int32_t Crypto_TM_Determine_SA_Service_Type(uint8_t* sa_service_type, SecurityAs
     {
         // Probably unnecessary check
         // Leaving for now as it would be cleaner in SA to have an association enum returned I believe
-        printf(KRED "Error: SA Service Type is not defined! \n" RESET);
         status = CRYPTO_LIB_ERROR;
+        Crypto_MC_Event(status, sa_ptr->spi, NULL, "SA Service Type is not defined");
     }
     if(status != CRYPTO_LIB_SUCCESS)
     {
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
     }
     return status;
 }
@@ -154,7 +243,7 @@ int32_t Crypto_TM_IV_Sanity_Check(uint8_t* sa_service_type, SecurityAssociation_
 #ifdef TM_DEBUG
         printf(KRED "CRYPTO_LIB_ERR_NULL_CIPHERS, Invalid cipher lengths, %d\n" RESET, CRYPTO_LIB_ERR_NULL_CIPHERS);
 #endif
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
         return status;
     }
 
@@ -166,7 +255,7 @@ int32_t Crypto_TM_IV_Sanity_Check(uint8_t* sa_service_type, SecurityAssociation_
                 sa_ptr->iv_len > 0 )
                 {
                     status = CRYPTO_LIB_ERR_IV_NOT_SUPPORTED_FOR_ACS_ALGO;
-                    mc_if->mc_log(status);
+                    CRYPTO_MC_IF->mc_log(status);
                     return status;
                 }
         }
@@ -214,11 +303,11 @@ void Crypto_TM_PKCS_Padding(uint32_t* pkcs_padding, SecurityAssociation_t* sa_pt
 **/
 void Crypto_TM_Handle_Managed_Parameter_Flags(uint16_t* pdu_len)
 {
-    if(current_managed_parameters_struct.has_ocf == TM_HAS_OCF)
+    if(current_managed_parameters->has_ocf == TM_HAS_OCF)
     {
         *pdu_len -= 4;
     }
-    if(current_managed_parameters_struct.has_fecf == TM_HAS_FECF)
+    if(current_managed_parameters->has_fecf == TM_HAS_FECF)
     {
         *pdu_len -= 2;
     }
@@ -235,18 +324,18 @@ void Crypto_TM_Handle_Managed_Parameter_Flags(uint16_t* pdu_len)
 int32_t Crypto_TM_Get_Keys(crypto_key_t** ekp, crypto_key_t** akp, SecurityAssociation_t* sa_ptr)
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
-    *ekp = key_if->get_key(sa_ptr->ekid);
+    *ekp = CRYPTO_KEY_IF->get_key(sa_ptr->ekid);
     if (ekp == NULL)
     {
         status = CRYPTO_LIB_ERR_KEY_ID_ERROR;
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
     }
     
-    *akp = key_if->get_key(sa_ptr->akid);
+    *akp = CRYPTO_KEY_IF->get_key(sa_ptr->akid);
     if (akp == NULL && status == CRYPTO_LIB_SUCCESS)
     {
         status = CRYPTO_LIB_ERR_KEY_ID_ERROR;
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
     }
     return status;
 }
@@ -293,8 +382,8 @@ int32_t Crypto_TM_Do_Encrypt_NONPLAINTEXT(uint8_t sa_service_type, uint16_t* aad
             if (sa_ptr->abm_len < *aad_len)
             {
                 status = CRYPTO_LIB_ERR_ABM_TOO_SHORT_FOR_AAD;
-                printf(KRED "Error: abm_len of %d < *aad_len of %d\n" RESET, sa_ptr->abm_len, *aad_len);
-                mc_if->mc_log(status);
+                Crypto_MC_Event(status, sa_ptr->spi, NULL, "abm_len of %d < aad_len of %d", sa_ptr->abm_len, *aad_len);
+                CRYPTO_MC_IF->mc_log(status);
             }
             if (status == CRYPTO_LIB_SUCCESS)
             {
@@ -322,9 +411,10 @@ int32_t Crypto_TM_Do_Encrypt_NONPLAINTEXT(uint8_t sa_service_type, uint16_t* aad
  * @param aad_len: uint16_t*
  * @param aad: uint8_t*
  * @param sa_ptr: SecurityAssociation_t*
+ * @param counters: const crypto_sa_counters_t*
  * @return int32_t: Success/Failure
 **/
-int32_t Crypto_TM_Do_Encrypt_NONPLAINTEXT_AEAD_Logic(uint8_t sa_service_type, uint8_t ecs_is_aead_algorithm, uint8_t* pTfBuffer, uint16_t pdu_len, uint16_t data_loc, crypto_key_t* ekp, crypto_key_t* akp, uint32_t pkcs_padding, int* mac_loc, uint16_t* aad_len, uint8_t* aad, SecurityAssociation_t* sa_ptr)
+int32_t Crypto_TM_Do_Encrypt_NONPLAINTEXT_AEAD_Logic(uint8_t sa_service_type, uint8_t ecs_is_aead_algorithm, uint8_t* pTfBuffer, uint16_t pdu_len, uint16_t data_loc, crypto_key_t* ekp, crypto_key_t* akp, uint32_t pkcs_padding, int* mac_loc, uint16_t* aad_len, uint8_t* aad, SecurityAssociation_t* sa_ptr, const crypto_sa_counters_t* counters)
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
 
@@ -332,7 +422,7 @@ int32_t Crypto_TM_Do_Encrypt_NONPLAINTEXT_AEAD_Logic(uint8_t sa_service_type, ui
     {
         if(sa_service_type == SA_ENCRYPTION)
         {
-            status = cryptography_if->cryptography_encrypt(//Stub out data in/out as this is done in place and want to save cycles
+            status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_encrypt(//Stub out data in/out as this is done in place and want to save cycles
                                                         (uint8_t*)(&pTfBuffer[data_loc]), // ciphertext output
                                                         (size_t) pdu_len, // length of data
                                                         (uint8_t*)(&pTfBuffer[data_loc]), // plaintext input
@@ -340,7 +430,7 @@ int32_t Crypto_TM_Do_Encrypt_NONPLAINTEXT_AEAD_Logic(uint8_t sa_service_type, ui
                                                         &(ekp->value[0]), // Key
                                                         Crypto_Get_ECS_Algo_Keylen(sa_ptr->ecs),
                                                         sa_ptr, // SA (for key reference)
-                                                        sa_ptr->iv, // IV
+                                                        (uint8_t*)counters->iv, // IV
                                                         sa_ptr->iv_len, // IV Length
                                                         &sa_ptr->ecs, // encryption cipher
                                                         pkcs_padding,  // authentication cipher
@@ -348,14 +438,14 @@ int32_t Crypto_TM_Do_Encrypt_NONPLAINTEXT_AEAD_Logic(uint8_t sa_service_type, ui
         } 
         if(sa_service_type == SA_AUTHENTICATED_ENCRYPTION)
         {
-            status = cryptography_if->cryptography_aead_encrypt((uint8_t*)(&pTfBuffer[data_loc]), // ciphertext output
+            status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_aead_encrypt((uint8_t*)(&pTfBuffer[data_loc]), // ciphertext output
                                                                 (size_t) pdu_len,  // length of data
                                                                 (uint8_t*)(&pTfBuffer[data_loc]), // plaintext input
                                                                 (size_t) pdu_len, // in data length
                                                                 &(ekp->value[0]), // Key
                                                                 Crypto_Get_ECS_Algo_Keylen(sa_ptr->ecs), // Length of key derived from sa_ptr key_ref
                                                                 sa_ptr, // SA (for key reference)
-                                                                sa_ptr->iv, // IV
+                                                                (uint8_t*)counters->iv, // IV
                                                                 sa_ptr->iv_len, // IV Length
                                                                 &pTfBuffer[*mac_loc], // tag output
                                                                 sa_ptr->stmacf_len, // tag size
@@ -375,7 +465,7 @@ int32_t Crypto_TM_Do_Encrypt_NONPLAINTEXT_AEAD_Logic(uint8_t sa_service_type, ui
         // TODO - implement non-AEAD algorithm logic
         if(sa_service_type == SA_AUTHENTICATION)
         {
-            status = cryptography_if->cryptography_authenticate(//Stub out data in/out as this is done in place and want to save cycles
+            status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_authenticate(//Stub out data in/out as this is done in place and want to save cycles
                                                                 (uint8_t*)(&pTfBuffer[0]), // ciphertext output
                                                                 (size_t) 0, // length of data
                                                                 (uint8_t*)(&pTfBuffer[0]), // plaintext input
@@ -383,7 +473,7 @@ int32_t Crypto_TM_Do_Encrypt_NONPLAINTEXT_AEAD_Logic(uint8_t sa_service_type, ui
                                                                 &(akp->value[0]), // Key
                                                                 Crypto_Get_ACS_Algo_Keylen(sa_ptr->acs),
                                                                 sa_ptr, // SA (for key reference)
-                                                                sa_ptr->iv, // IV
+                                                                (uint8_t*)counters->iv, // IV
                                                                 sa_ptr->iv_len, // IV Length
                                                                 &pTfBuffer[*mac_loc], // tag output
                                                                 sa_ptr->stmacf_len, // tag size
@@ -397,7 +487,7 @@ int32_t Crypto_TM_Do_Encrypt_NONPLAINTEXT_AEAD_Logic(uint8_t sa_service_type, ui
         {
             if (sa_service_type == SA_ENCRYPTION)
                 {
-                    status = cryptography_if->cryptography_encrypt(//Stub out data in/out as this is done in place and want to save cycles
+                    status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_encrypt(//Stub out data in/out as this is done in place and want to save cycles
                                                                 (uint8_t*)(&pTfBuffer[data_loc]), // ciphertext output
                                                                 (size_t) pdu_len, // length of data
                                                                 (uint8_t*)(&pTfBuffer[data_loc]), // plaintext input
@@ -405,7 +495,7 @@ int32_t Crypto_TM_Do_Encrypt_NONPLAINTEXT_AEAD_Logic(uint8_t sa_service_type, ui
                                                                 &(ekp->value[0]), // Key
                                                                 Crypto_Get_ECS_Algo_Keylen(sa_ptr->ecs),
                                                                 sa_ptr, // SA (for key reference)
-                                                                sa_ptr->iv, // IV
+                                                                (uint8_t*)counters->iv, // IV
                                                                 sa_ptr->iv_len, // IV Length
                                                                 &sa_ptr->ecs, // encryption cipher
                                                                 pkcs_padding,  // authentication cipher
@@ -427,73 +517,6 @@ int32_t Crypto_TM_Do_Encrypt_NONPLAINTEXT_AEAD_Logic(uint8_t sa_service_type, ui
     return status;
 }
 
-/**
- * @brief Function: Crypto_TM_Do_Encrypt_Handle_Increment
- * Handles the incrementing of IV and ARSN as necessary
- * @param sa_service_type: uint8_t
- * @param sa_ptr: SecurityAssociation_t*
- * @return int32_t: Success/Failure
-**/
-int32_t Crypto_TM_Do_Encrypt_Handle_Increment(uint8_t sa_service_type, SecurityAssociation_t* sa_ptr)
-{
-    int32_t status = CRYPTO_LIB_SUCCESS;
-    if (sa_service_type != SA_PLAINTEXT)
-    {
-#ifdef INCREMENT
-        if (crypto_config.crypto_increment_nontransmitted_iv == SA_INCREMENT_NONTRANSMITTED_IV_TRUE)
-        {
-            if (sa_ptr->shivf_len > 0 && sa_ptr->iv_len != 0)
-            {
-                status = Crypto_increment(sa_ptr->iv, sa_ptr->iv_len);
-            }
-        }
-        else // SA_INCREMENT_NONTRANSMITTED_IV_FALSE
-        {
-            // Only increment the transmitted portion
-            if (sa_ptr->shivf_len > 0 && sa_ptr->iv_len != 0)
-            {
-                status = Crypto_increment(sa_ptr->iv + (sa_ptr->iv_len - sa_ptr->shivf_len), sa_ptr->shivf_len);
-            }
-        }
-        if (sa_ptr->shsnf_len > 0 && status == CRYPTO_LIB_SUCCESS)
-        {
-            status = Crypto_increment(sa_ptr->arsn, sa_ptr->arsn_len);
-        }
-
-#ifdef SA_DEBUG
-        if (sa_ptr->iv_len > 0)
-        {
-            printf(KYEL "Next IV value is:\n\t");
-            for (int i = 0; i < sa_ptr->iv_len; i++)
-            {
-                printf("%02x", *(sa_ptr->iv + i));
-            }
-            printf("\n" RESET);
-            printf(KYEL "Next transmitted IV value is:\n\t");
-            for (int i = sa_ptr->iv_len - sa_ptr->shivf_len; i < sa_ptr->iv_len; i++)
-            {
-                printf("%02x", *(sa_ptr->iv + i));
-            }
-            printf("\n" RESET);
-        }
-        printf(KYEL "Next ARSN value is:\n\t");
-        for (int i = 0; i < sa_ptr->arsn_len; i++)
-        {
-            printf("%02x", *(sa_ptr->arsn + i));
-        }
-        printf("\n" RESET);
-        printf(KYEL "Next transmitted ARSN value is:\n\t");
-        for (int i = sa_ptr->arsn_len - sa_ptr->shsnf_len; i < sa_ptr->arsn_len; i++)
-        {
-            printf("%02x", *(sa_ptr->arsn + i));
-        }
-        printf("\n" RESET);
-#endif
-#endif
-    }
-    return status;
-}
-
 /**
  * @brief Function: Crypto_TM_Do_Encrypt
  * Parent function for performing TM Encryption
@@ -511,9 +534,10 @@ int32_t Crypto_TM_Do_Encrypt_Handle_Increment(uint8_t sa_service_type, SecurityA
  * @param akp: crypto_key_t*
  * @param pkcs_padding: uint32_t
  * @param new_fecf: uint16_t*
+ * @param counters: const crypto_sa_counters_t*
  * @return int32_t: Success/Failure
 **/
-int32_t Crypto_TM_Do_Encrypt(uint8_t sa_service_type, SecurityAssociation_t* sa_ptr, uint16_t* aad_len, int* mac_loc, uint16_t* idx_p, uint16_t pdu_len, uint8_t* pTfBuffer, uint8_t* aad, uint8_t ecs_is_aead_algorithm, uint16_t data_loc, crypto_key_t* ekp, crypto_key_t* akp, uint32_t pkcs_padding, uint16_t* new_fecf)
+int32_t Crypto_TM_Do_Encrypt(uint8_t sa_service_type, SecurityAssociation_t* sa_ptr, uint16_t* aad_len, int* mac_loc, uint16_t* idx_p, uint16_t pdu_len, uint8_t* pTfBuffer, uint8_t* aad, uint8_t ecs_is_aead_algorithm, uint16_t data_loc, crypto_key_t* ekp, crypto_key_t* akp, uint32_t pkcs_padding, uint16_t* new_fecf, const crypto_sa_counters_t* counters)
 {
 /**
  * Begin Authentication / Encryption
@@ -525,13 +549,7 @@ int32_t Crypto_TM_Do_Encrypt(uint8_t sa_service_type, SecurityAssociation_t* sa_
 // AEAD Algorithm Logic
     if (status == CRYPTO_LIB_SUCCESS)
     {
-        status = Crypto_TM_Do_Encrypt_NONPLAINTEXT_AEAD_Logic(sa_service_type, ecs_is_aead_algorithm, pTfBuffer, pdu_len, data_loc, ekp, akp, pkcs_padding, mac_loc, aad_len, aad, sa_ptr);
-    }
-
-
-    if (status == CRYPTO_LIB_SUCCESS)
-    {
-        status = Crypto_TM_Do_Encrypt_Handle_Increment(sa_service_type, sa_ptr);
+        status = Crypto_TM_Do_Encrypt_NONPLAINTEXT_AEAD_Logic(sa_service_type, ecs_is_aead_algorithm, pTfBuffer, pdu_len, data_loc, ekp, akp, pkcs_padding, mac_loc, aad_len, aad, sa_ptr, counters);
     }
 
     if (status == CRYPTO_LIB_SUCCESS)
@@ -558,28 +576,28 @@ int32_t Crypto_TM_Do_Encrypt(uint8_t sa_service_type, SecurityAssociation_t* sa_
          **/
 
         // Only calculate & insert FECF if CryptoLib is configured to do so & gvcid includes FECF.
-        if (current_managed_parameters_struct.has_fecf == TM_HAS_FECF)
+        if (current_managed_parameters->has_fecf == TM_HAS_FECF)
         {
 #ifdef FECF_DEBUG
-            printf(KCYN "Calcing FECF over %d bytes\n" RESET, current_managed_parameters_struct.max_frame_size - 2);
+            printf(KCYN "Calcing FECF over %d bytes\n" RESET, current_managed_parameters->max_frame_size - 2);
 #endif
             if (crypto_config.crypto_create_fecf == CRYPTO_TM_CREATE_FECF_TRUE)
             {
-                *new_fecf = Crypto_Calc_FECF((uint8_t*)pTfBuffer, current_managed_parameters_struct.max_frame_size - 2);
-                pTfBuffer[current_managed_parameters_struct.max_frame_size - 2] = (uint8_t)((*new_fecf & 0xFF00) >> 8);
-                pTfBuffer[current_managed_parameters_struct.max_frame_size - 1] = (uint8_t)(*new_fecf & 0x00FF);
+                *new_fecf = Crypto_Calc_FECF((uint8_t*)pTfBuffer, current_managed_parameters->max_frame_size - 2);
+                pTfBuffer[current_managed_parameters->max_frame_size - 2] = (uint8_t)((*new_fecf & 0xFF00) >> 8);
+                pTfBuffer[current_managed_parameters->max_frame_size - 1] = (uint8_t)(*new_fecf & 0x00FF);
             }
             else // CRYPTO_TC_CREATE_FECF_FALSE
             {
-                pTfBuffer[current_managed_parameters_struct.max_frame_size - 2] = (uint8_t)0x00;
-                pTfBuffer[current_managed_parameters_struct.max_frame_size - 1] = (uint8_t)0x00;
+                pTfBuffer[current_managed_parameters->max_frame_size - 2] = (uint8_t)0x00;
+                pTfBuffer[current_managed_parameters->max_frame_size - 1] = (uint8_t)0x00;
             }
             idx += 2;
         }
 
 #ifdef TM_DEBUG
         printf(KYEL "Printing new TM frame:\n\t");
-        for(int i = 0; i < current_managed_parameters_struct.max_frame_size; i++)
+        for(int i = 0; i < current_managed_parameters->max_frame_size; i++)
         {
             printf("%02X", pTfBuffer[i]);
         }
@@ -588,7 +606,7 @@ int32_t Crypto_TM_Do_Encrypt(uint8_t sa_service_type, SecurityAssociation_t* sa_
     }
     if (status == CRYPTO_LIB_SUCCESS)
     {
-        status = sa_if->sa_save_sa(sa_ptr);
+        status = CRYPTO_SA_IF->sa_save_sa(sa_ptr);
 
 #ifdef DEBUG
         printf(KYEL "----- Crypto_TM_ApplySecurity END -----\n" RESET);
@@ -619,15 +637,15 @@ void Crypto_TM_ApplySecurity_Debug_Print(uint16_t idx, uint16_t pdu_len, Securit
     printf(KYEL "Data location starts at: %d\n" RESET, idx);
     printf(KYEL "Data size is: %d\n" RESET, pdu_len);
     printf(KYEL "Index at end of SPI is: %d\n", idx);
-    if(current_managed_parameters_struct.has_ocf == TM_HAS_OCF)
+    if(current_managed_parameters->has_ocf == TM_HAS_OCF)
     {
         // If OCF exists, comes immediately after MAC
         printf(KYEL "OCF Location is: %d" RESET, idx + pdu_len + sa_ptr->stmacf_len);
     }
-    if(current_managed_parameters_struct.has_fecf == TM_HAS_FECF)
+    if(current_managed_parameters->has_fecf == TM_HAS_FECF)
     {
         // If FECF exists, comes just before end of the frame
-        printf(KYEL "FECF Location is: %d\n" RESET, current_managed_parameters_struct.max_frame_size - 2);
+        printf(KYEL "FECF Location is: %d\n" RESET, current_managed_parameters->max_frame_size - 2);
     }
 #endif
 }
@@ -651,6 +669,20 @@ void Crypto_TM_ApplySecurity_Debug_Print(uint16_t idx, uint16_t pdu_len, Securit
  * Security Header
    **/
 int32_t Crypto_TM_ApplySecurity(uint8_t* pTfBuffer)
+{
+    int32_t status;
+
+    Crypto_Arena_Enter();
+    status = crypto_tm_apply_security(pTfBuffer);
+    Crypto_Arena_Leave();
+    return status;
+}
+
+/**
+ * @brief Function: crypto_tm_apply_security
+ * ApplySecurity body, runs inside the scratch arena scope opened by Crypto_TM_ApplySecurity
+ **/
+static int32_t crypto_tm_apply_security(uint8_t* pTfBuffer)
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
     int mac_loc = 0;
@@ -665,6 +697,7 @@ int32_t Crypto_TM_ApplySecurity(uint8_t* pTfBuffer)
     uint16_t new_fecf = 0x0000;
     uint8_t ecs_is_aead_algorithm;
     SecurityAssociation_t* sa_ptr = NULL;
+    crypto_sa_counters_t counters;
     uint8_t tfvn = 0;
     uint16_t scid = 0; 
     uint16_t vcid = 0;
@@ -694,7 +727,7 @@ int32_t Crypto_TM_ApplySecurity(uint8_t* pTfBuffer)
     printf("\n");
 #endif
 
-    status = sa_if->sa_get_operational_sa_from_gvcid(tfvn, scid, vcid, 0, &sa_ptr);
+    status = CRYPTO_SA_IF->sa_get_operational_sa_from_gvcid(tfvn, scid, vcid, 0, &sa_ptr);
 
     // No operational/valid SA found
     if (status != CRYPTO_LIB_SUCCESS)
@@ -702,11 +735,11 @@ int32_t Crypto_TM_ApplySecurity(uint8_t* pTfBuffer)
 #ifdef TM_DEBUG
         printf(KRED "Error: Could not retrieve an SA!\n" RESET);
 #endif
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
         return status;
     }
 
-    status = Crypto_Get_Managed_Parameters_For_Gvcid(tfvn, scid, vcid, gvcid_managed_parameters_array, &current_managed_parameters_struct);
+    status = Crypto_Get_Managed_Parameters_Ptr_For_Gvcid(tfvn, scid, vcid, &current_managed_parameters);
 
     // No managed parameters found
     if (status != CRYPTO_LIB_SUCCESS)
@@ -714,13 +747,13 @@ int32_t Crypto_TM_ApplySecurity(uint8_t* pTfBuffer)
 #ifdef TM_DEBUG
         printf(KRED "Error: No managed parameters found!\n" RESET);
 #endif
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
         return status;
     }
 
  #ifdef TM_DEBUG
     printf(KYEL "TM BEFORE Apply Sec:\n\t" RESET);
-    for (int16_t i =0; i < current_managed_parameters_struct.max_frame_size; i++)
+    for (int16_t i =0; i < current_managed_parameters->max_frame_size; i++)
     {
         printf("%02X", pTfBuffer[i]);
     }
@@ -732,6 +765,17 @@ int32_t Crypto_TM_ApplySecurity(uint8_t* pTfBuffer)
     Crypto_saPrint(sa_ptr);
 #endif
 
+    // SAs with a compiled profile skip the per-frame configuration checks below
+    // Profiles assume the security header directly follows the primary header
+    if ((pTfBuffer[4] & 0x80) == 0)
+    {
+        const CryptoSaProfile_t* profile = Crypto_SA_Profile_Get(sa_ptr, TYPE_TM);
+        if (profile != NULL)
+        {
+            return profile->tm_apply(profile, sa_ptr, pTfBuffer);
+        }
+    }
+
     // Determine SA Service Type
     status = Crypto_TM_Determine_SA_Service_Type(&sa_service_type, sa_ptr);
     if(status != CRYPTO_LIB_SUCCESS) return status;
@@ -781,11 +825,15 @@ int32_t Crypto_TM_ApplySecurity(uint8_t* pTfBuffer)
     status = Crypto_TM_IV_Sanity_Check(&sa_service_type, sa_ptr);
     if(status != CRYPTO_LIB_SUCCESS) return status;
 
+    // Reserve this frame's IV and ARSN, the SA moves on past them right away
+    status = Crypto_SA_Counters_Reserve(sa_ptr, sa_service_type, &counters);
+    if(status != CRYPTO_LIB_SUCCESS) return status;
+
     // Start index from the transmitted portion
     for (i = sa_ptr->iv_len - sa_ptr->shivf_len; i < sa_ptr->iv_len; i++)
     {
-        // Copy in IV from SA
-        pTfBuffer[idx] = *(sa_ptr->iv + i);
+        // Copy in reserved IV
+        pTfBuffer[idx] = counters.iv[i];
         idx++;
     }
 
@@ -798,8 +846,8 @@ int32_t Crypto_TM_ApplySecurity(uint8_t* pTfBuffer)
      **/
     for (i = sa_ptr->arsn_len - sa_ptr->shsnf_len; i < sa_ptr->arsn_len; i++)
     {
-        // Copy in ARSN from SA
-        pTfBuffer[idx] = *(sa_ptr->arsn + i);
+        // Copy in reserved ARSN, a field longer than the ARSN still takes the SA bytes ahead of it
+        pTfBuffer[idx] = (i < 0) ? *(sa_ptr->arsn + i) : counters.arsn[i];
         idx++;
     }
 
@@ -838,7 +886,7 @@ int32_t Crypto_TM_ApplySecurity(uint8_t* pTfBuffer)
      **/
     data_loc = idx;
     // Calculate size of data to be encrypted
-    pdu_len = current_managed_parameters_struct.max_frame_size - idx - sa_ptr->stmacf_len;
+    pdu_len = current_managed_parameters->max_frame_size - idx - sa_ptr->stmacf_len;
     // Check other managed parameter flags, subtract their lengths from data field if present
     Crypto_TM_Handle_Managed_Parameter_Flags(&pdu_len);
     Crypto_TM_ApplySecurity_Debug_Print(idx, pdu_len, sa_ptr);
@@ -847,18 +895,17 @@ int32_t Crypto_TM_ApplySecurity(uint8_t* pTfBuffer)
     crypto_key_t* ekp = NULL;
     crypto_key_t* akp = NULL;
     status = Crypto_TM_Get_Keys(&ekp, &akp, sa_ptr);
-    if(status != CRYPTO_LIB_SUCCESS)
+    if(status == CRYPTO_LIB_SUCCESS)
     {
-        return status;
+        status = Crypto_TM_Do_Encrypt(sa_service_type, sa_ptr, &aad_len, &mac_loc, &idx, pdu_len, pTfBuffer, aad, ecs_is_aead_algorithm, data_loc, ekp, akp, pkcs_padding, &new_fecf, &counters);
     }
-
-    status = Crypto_TM_Do_Encrypt(sa_service_type, sa_ptr, &aad_len, &mac_loc, &idx, pdu_len, pTfBuffer, aad, ecs_is_aead_algorithm, data_loc, ekp, akp, pkcs_padding, &new_fecf);
     if(status != CRYPTO_LIB_SUCCESS)
     {
+        Crypto_SA_Counters_Gap(sa_ptr->spi, sa_service_type != SA_PLAINTEXT);
         return status;
     }
 
-    mc_if->mc_log(status);
+    CRYPTO_MC_IF->mc_log(status);
     return status;
 }
 
@@ -905,11 +952,11 @@ int32_t Crypto_TM_ApplySecurity(uint8_t* pTfBuffer)
     // Payload Data Unit
     Crypto_TM_updatePDU(ingest,*len_ingest);
     printf("LINE: %d\n",__LINE__);
-    if (sa_if->sa_get_from_spi(spi, &sa_ptr) != CRYPTO_LIB_SUCCESS)
+    if (CRYPTO_SA_IF->sa_get_from_spi(spi, &sa_ptr) != CRYPTO_LIB_SUCCESS)
     {
         // TODO - Error handling
         status = CRYPTO_LIB_ERROR;
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
         return status; // Error -- unable to get SA from SPI.
     }
     printf("LINE: %d\n",__LINE__);
@@ -1040,7 +1087,7 @@ int32_t Crypto_TM_ApplySecurity(uint8_t* pTfBuffer)
         printf("\n");
 #endif
 
-        status = cryptography_if->cryptography_aead_encrypt(&(ingest[pdu_loc]), // ciphertext output
+        status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_aead_encrypt(&(ingest[pdu_loc]), // ciphertext output
                                                            (size_t)pdu_len,            // length of data
                                                            &(tempTM[pdu_loc]), // plaintext input
                                                            (size_t)pdu_len,             // in data length
@@ -1102,22 +1149,88 @@ int32_t Crypto_TM_ApplySecurity(uint8_t* pTfBuffer)
 #endif
 
    *len_ingest = count;
-    mc_if->mc_log(status);
+    CRYPTO_MC_IF->mc_log(status);
     return status;
 }  **/
 
 
+/**
+ * @brief Function: Crypto_TM_Decode_Frame
+ * Decodes the TM primary header, secondary header length, and SPI of a received frame in one pass
+ * Fills the frame descriptor used by the later processing stages and looks up the managed parameters for the frame GVCID
+ * @param p_ingest: uint8_t*
+ * @param desc: crypto_frame_desc_t*
+ * @return int32_t: Success/Failure
+**/
+int32_t Crypto_TM_Decode_Frame(uint8_t* p_ingest, crypto_frame_desc_t* desc)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    uint8_t idle_vc;
+
+    memset(desc, 0, sizeof(crypto_frame_desc_t));
+    desc->frame_type = TYPE_TM;
+
+    // Bit math to give concise access to values in the ingest
+    desc->tfvn = ((uint8_t)p_ingest[0] & 0xC0) >> 6;
+    desc->scid = (((uint16_t)p_ingest[0] & 0x3F) << 4) | (((uint16_t)p_ingest[1] & 0xF0) >> 4);
+    desc->vcid = ((uint8_t)p_ingest[1] & 0x0E) >> 1;
+
+#ifdef TM_DEBUG
+    printf(KGRN "TM Process Using following parameters:\n\t" RESET);
+    printf(KGRN "tvfn: %d\t scid: %d\t vcid: %d\n" RESET,  desc->tfvn, desc->scid, desc->vcid );
+#endif
+
+    if (desc->tfvn != TM_TFVN)
+    {
+        status = CRYPTO_LIB_ERR_INVALID_TFVN;
+        CRYPTO_MC_IF->mc_log(status);
+        return status;
+    }
+
+    // Lookup-retrieve managed parameters for frame via gvcid:
+    status = Crypto_Get_Managed_Parameters_Ptr_For_Gvcid(desc->tfvn, desc->scid, desc->vcid, &current_managed_parameters);
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+#ifdef TM_DEBUG
+        printf(KRED "**NO LUCK WITH GVCID!\n" RESET);
+#endif
+        CRYPTO_MC_IF->mc_log(status);
+        return status;
+    } // Unable to get necessary Managed Parameters for TM TF -- return with error.
+
+    desc->frame_len = current_managed_parameters->max_frame_size;
+    desc->ocf_len = (current_managed_parameters->has_ocf == TM_HAS_OCF) ? OCF_SIZE : 0;
+    desc->fecf_len = (current_managed_parameters->has_fecf == TM_HAS_FECF) ? FECF_SIZE : 0;
+
+    // Idle fill: every frame of an idle virtual channel, or a frame whose first header pointer says it only carries
+    // idle data (CCSDS 132.0-B-3 4.1.2.7.6), the pointer is only defined when the synchronization flag is clear
+    idle_vc = Crypto_Get_Idle_Frames_For_Managed_Parameters(current_managed_parameters)->idle_vc;
+    desc->idle = (idle_vc == IDLE_VC_TRUE) ||
+                 (((p_ingest[4] & 0x40) == 0) && ((((uint16_t)p_ingest[4] & 0x07) << 8 | p_ingest[5]) == TM_FHP_OID));
+
+    // Check if secondary header is present within frame
+    // Note: Secondary headers are static only for a mission phase, not guaranteed static 
+    // over the life of a mission Per CCSDS 132.0-B.3 Section 4.1.2.7.2.3
+    Crypto_TM_Check_For_Secondary_Header(p_ingest, &desc->spi_loc);
+
+    /**
+     * Begin Security Header Fields
+     * Reference CCSDS SDLP 3550b1 4.1.1.1.3
+     **/
+    desc->spi = (uint16_t)p_ingest[desc->spi_loc] << 8 | (uint16_t)p_ingest[desc->spi_loc + 1];
+
+    return status;
+}
+
 /**
  * @brief Function: Crypto_TM_Process_Setup
- * Sets up TM Process Security.  Verifies ingest length, verifies pointers are not null, 
- * Retreives managed parameters,  validates GVCID, and verifies the presence of Secondary Header
+ * Sanity checks the received frame and library state, then decodes the frame headers
  * @param len_ingest: uint16_t
- * @param byte_idx: uint16_t*
  * @param p_ingest: uint8_t*
- * @param secondary_hdr_len: uint8_t*
+ * @param desc: crypto_frame_desc_t*
  * @return int32_t: Success/Failure
 **/
-int32_t Crypto_TM_Process_Setup(uint16_t len_ingest, uint16_t* byte_idx, uint8_t* p_ingest, uint8_t* secondary_hdr_len)
+int32_t Crypto_TM_Process_Setup(uint16_t len_ingest, uint8_t* p_ingest, crypto_frame_desc_t* desc)
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
 #ifdef DEBUG
@@ -1127,7 +1240,7 @@ int32_t Crypto_TM_Process_Setup(uint16_t len_ingest, uint16_t* byte_idx, uint8_t
     if (len_ingest < 6) // Frame length doesn't even have enough bytes for header -- error out.
     {
         status = CRYPTO_LIB_ERR_INPUT_FRAME_TOO_SHORT_FOR_TM_STANDARD;
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
     }
 
     if ((status == CRYPTO_LIB_SUCCESS) && ((crypto_config.init_status == UNITIALIZED) || (mc_if == NULL) || (sa_if == NULL)))
@@ -1139,73 +1252,20 @@ int32_t Crypto_TM_Process_Setup(uint16_t len_ingest, uint16_t* byte_idx, uint8_t
         // Can't mc_log if it's not configured
         if (mc_if != NULL)
         {
-            mc_if->mc_log(status);
+            CRYPTO_MC_IF->mc_log(status);
         }
     }
 
     // Query SA DB for active SA / SDLS parameters
     if ((sa_if == NULL) && (status == CRYPTO_LIB_SUCCESS)) // This should not happen, but tested here for safety
     {
-        printf(KRED "ERROR: SA DB Not initalized! -- CRYPTO_LIB_ERR_NO_INIT, Will Exit\n" RESET);
         status = CRYPTO_LIB_ERR_NO_INIT;
+        Crypto_MC_Event(status, MC_EVENT_SPI_NA, NULL, "SA DB Not initialized");
     }
 
-#ifdef TM_DEBUG
-    printf(KGRN "TM Process Using following parameters:\n\t" RESET);
-    printf(KGRN "tvfn: %d\t scid: %d\t vcid: %d\n" RESET,  tm_frame_pri_hdr.tfvn, tm_frame_pri_hdr.scid, tm_frame_pri_hdr.vcid );
-#endif
-
-    // Lookup-retrieve managed parameters for frame via gvcid:
     if (status == CRYPTO_LIB_SUCCESS)
     {
-        status = Crypto_Get_Managed_Parameters_For_Gvcid(
-        tm_frame_pri_hdr.tfvn, tm_frame_pri_hdr.scid, tm_frame_pri_hdr.vcid, 
-        gvcid_managed_parameters_array, &current_managed_parameters_struct);
-    }
-    
-    if (status != CRYPTO_LIB_SUCCESS)
-    {
-#ifdef TM_DEBUG
-        printf(KRED "**NO LUCK WITH GVCID!\n" RESET);
-#endif
-        // Can't mc_log if it's not configured
-        if (mc_if != NULL)
-        {
-            mc_if->mc_log(status);
-        }
-    } // Unable to get necessary Managed Parameters for TM TF -- return with error.
-
-    // Check if secondary header is present within frame
-    // Note: Secondary headers are static only for a mission phase, not guaranteed static 
-    // over the life of a mission Per CCSDS 132.0-B.3 Section 4.1.2.7.2.3
-
-    if(status == CRYPTO_LIB_SUCCESS)
-    {
-        // Secondary Header flag is 1st bit of 5th byte (index 4)
-        *byte_idx = 4;  
-        if((p_ingest[*byte_idx] & 0x80) == 0x80)
-        {
-    #ifdef TM_DEBUG
-            printf(KYEL "A TM Secondary Header flag is set!\n");
-    #endif
-            // Secondary header is present
-            *byte_idx = 6;
-            // Determine length of secondary header
-            // Length coded as total length of secondary header - 1
-            // Reference CCSDS 132.0-B-2 4.1.3.2.3
-            *secondary_hdr_len = (p_ingest[*byte_idx] & 0x3F) + 1;
-    #ifdef TM_DEBUG
-            printf(KYEL "Secondary Header Length is decoded as: %d\n", *secondary_hdr_len);
-    #endif
-            // Increment from current byte (1st byte of secondary header),
-            // to where the SPI would start
-            *byte_idx += *secondary_hdr_len;
-        }
-        else
-        {
-            // No Secondary header, carry on as usual and increment to SPI start
-            *byte_idx = 6;
-        }
+        status = Crypto_TM_Decode_Frame(p_ingest, desc);
     }
 
     return status;
@@ -1244,7 +1304,7 @@ int32_t Crypto_TM_Determine_Cipher_Mode(uint8_t sa_service_type, SecurityAssocia
     if ( *encryption_cipher == CRYPTO_CIPHER_NONE && sa_ptr->est == 1)
     {
         status = CRYPTO_LIB_ERR_NO_ECS_SET_FOR_ENCRYPTION_MODE;
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
     }
 
     return status;
@@ -1261,10 +1321,10 @@ int32_t Crypto_TM_FECF_Setup(uint8_t* p_ingest, uint16_t len_ingest)
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
 
-    if (current_managed_parameters_struct.has_fecf == TM_HAS_FECF)
+    if (current_managed_parameters->has_fecf == TM_HAS_FECF)
     {
-        uint16_t received_fecf = (((p_ingest[current_managed_parameters_struct.max_frame_size - 2] << 8) & 0xFF00) |
-                                                        (p_ingest[current_managed_parameters_struct.max_frame_size - 1] & 0x00FF));
+        uint16_t received_fecf = (((p_ingest[current_managed_parameters->max_frame_size - 2] << 8) & 0xFF00) |
+                                                        (p_ingest[current_managed_parameters->max_frame_size - 1] & 0x00FF));
 
         if (crypto_config.crypto_check_fecf == TM_CHECK_FECF_TRUE)
         {
@@ -1280,7 +1340,7 @@ int32_t Crypto_TM_FECF_Setup(uint8_t* p_ingest, uint16_t len_ingest)
                 printf("FECF was Calced over %d bytes\n", len_ingest-2);
 #endif
                 status = CRYPTO_LIB_ERR_INVALID_FECF;
-                mc_if->mc_log(status);
+                CRYPTO_MC_IF->mc_log(status);
             }
             // Valid FECF, zero out the field
             else
@@ -1293,15 +1353,15 @@ int32_t Crypto_TM_FECF_Setup(uint8_t* p_ingest, uint16_t len_ingest)
         }
     }
     // Needs to be TM_HAS_FECF (checked above_ or TM_NO_FECF)
-    else if (current_managed_parameters_struct.has_fecf != TM_NO_FECF)
+    else if (current_managed_parameters->has_fecf != TM_NO_FECF)
     {
 #ifdef TM_DEBUG
         printf(KRED "TM_Process Error...tfvn: %d scid: 0x%04X vcid: 0x%02X fecf_enum: %d\n" RESET, 
-            current_managed_parameters_struct.tfvn, current_managed_parameters_struct.scid, 
-            current_managed_parameters_struct.vcid, current_managed_parameters_struct.has_fecf);
+            current_managed_parameters->tfvn, current_managed_parameters->scid, 
+            current_managed_parameters->vcid, current_managed_parameters->has_fecf);
 #endif
         status = CRYPTO_LIB_ERR_TC_ENUM_USED_FOR_TM_CONFIG;
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
     }
     return status;
 }
@@ -1311,34 +1371,33 @@ int32_t Crypto_TM_FECF_Setup(uint8_t* p_ingest, uint16_t len_ingest)
  * Parses TM MAC, and calls AAD Prep functionality
  * @param sa_service_type: uint8_t
  * @param p_ingest: uint8_t*
- * @param mac_loc: int
+ * @param desc: const crypto_frame_desc_t*
  * @param sa_ptr: SecurityAssociation_t*
  * @param aad_len: uint16_t*
- * @param byte_idx: uint16_t
  * @param aad: uint8_t*
  * @return int32_t: Success/Failure
 **/
-int32_t Crypto_TM_Parse_Mac_Prep_AAD(uint8_t sa_service_type, uint8_t* p_ingest, int mac_loc, SecurityAssociation_t* sa_ptr, uint16_t* aad_len, uint16_t byte_idx, uint8_t* aad)
+int32_t Crypto_TM_Parse_Mac_Prep_AAD(uint8_t sa_service_type, uint8_t* p_ingest, const crypto_frame_desc_t* desc, SecurityAssociation_t* sa_ptr, uint16_t* aad_len, uint8_t* aad)
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
     if ((sa_service_type == SA_AUTHENTICATION) || (sa_service_type == SA_AUTHENTICATED_ENCRYPTION))
     {
 #ifdef MAC_DEBUG
         printf("MAC Parsed from Frame:\n");
-        Crypto_hexprint(p_ingest+mac_loc,sa_ptr->stmacf_len);
+        Crypto_hexprint(p_ingest+desc->mac_loc,sa_ptr->stmacf_len);
 #endif
         if (sa_service_type == SA_AUTHENTICATED_ENCRYPTION)
         {
-            *aad_len = byte_idx;
+            *aad_len = desc->pdu_loc;
         }
         else
         {
-            *aad_len = mac_loc;
+            *aad_len = desc->mac_loc;
         }
         if (sa_ptr->abm_len < *aad_len)
         {
             status = CRYPTO_LIB_ERR_ABM_TOO_SHORT_FOR_AAD;
-            mc_if->mc_log(status);
+            CRYPTO_MC_IF->mc_log(status);
         }
         // Use ingest and abm to create aad
         if(status == CRYPTO_LIB_SUCCESS)
@@ -1368,29 +1427,28 @@ int32_t Crypto_TM_Parse_Mac_Prep_AAD(uint8_t sa_service_type, uint8_t* p_ingest,
  * @param sa_service_type: uint8_t
  * @param p_ingest: uint8_t*
  * @param p_new_dec_frame: uint8_t*
- * @param byte_idx: uint16_t
- * @param pdu_len: uint16_t
+ * @param desc: const crypto_frame_desc_t*
  * @param ekp: crypto_key_t*
  * @param sa_ptr: SecurityAssociation_t*
- * @param iv_loc: uint8_t
- * @param mac_loc: int
  * @param aad_len: uint16_t
  * @param aad:  uint8_t*
  * @return int32_t: Success/Failure
 */
-int32_t Crypto_TM_Do_Decrypt_AEAD(uint8_t sa_service_type, uint8_t* p_ingest, uint8_t* p_new_dec_frame, uint16_t byte_idx, uint16_t pdu_len, crypto_key_t* ekp, SecurityAssociation_t* sa_ptr, uint8_t iv_loc, int mac_loc, uint16_t aad_len, uint8_t* aad)
+int32_t Crypto_TM_Do_Decrypt_AEAD(uint8_t sa_service_type, uint8_t* p_ingest, uint8_t* p_new_dec_frame, const crypto_frame_desc_t* desc, crypto_key_t* ekp, SecurityAssociation_t* sa_ptr, uint16_t aad_len, uint8_t* aad)
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
+    uint16_t byte_idx = desc->pdu_loc;
+    uint16_t pdu_len = desc->pdu_len;
     if(sa_service_type == SA_ENCRYPTION)
     {
-        status = cryptography_if->cryptography_decrypt(p_new_dec_frame+byte_idx, // plaintext output
+        status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_decrypt(p_new_dec_frame+byte_idx, // plaintext output
                                                     pdu_len,   // length of data
                                                     p_ingest+byte_idx, // ciphertext input
                                                     pdu_len,    // in data length
                                                     &(ekp->value[0]), // Key
                                                     Crypto_Get_ECS_Algo_Keylen(sa_ptr->ecs),
                                                     sa_ptr, // SA for key reference
-                                                    p_ingest+iv_loc, // IV
+                                                    p_ingest+desc->iv_loc, // IV
                                                     sa_ptr->iv_len, // IV Length
                                                     &sa_ptr->ecs, // encryption cipher
                                                     &sa_ptr->acs,  // authentication cipher
@@ -1398,16 +1456,16 @@ int32_t Crypto_TM_Do_Decrypt_AEAD(uint8_t sa_service_type, uint8_t* p_ingest, ui
     }
     if(sa_service_type == SA_AUTHENTICATED_ENCRYPTION)
     {
-        status = cryptography_if->cryptography_aead_decrypt(p_new_dec_frame+byte_idx, // plaintext output
+        status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_aead_decrypt(p_new_dec_frame+byte_idx, // plaintext output
                                                             pdu_len, // length of data
                                                             p_ingest+byte_idx, // ciphertext input
                                                             pdu_len, // in data length
                                                             &(ekp->value[0]), // Key
                                                             Crypto_Get_ECS_Algo_Keylen(sa_ptr->ecs),
                                                             sa_ptr, // SA for key reference
-                                                            p_ingest+iv_loc, // IV
+                                                            p_ingest+desc->iv_loc, // IV
                                                             sa_ptr->iv_len, // IV Length
-                                                            p_ingest+mac_loc, // Frame Expected Tag
+                                                            p_ingest+desc->mac_loc, // Frame Expected Tag
                                                             sa_ptr->stmacf_len, // tag size
                                                             aad, // additional authenticated data
                                                             aad_len, // length of AAD
@@ -1425,34 +1483,33 @@ int32_t Crypto_TM_Do_Decrypt_AEAD(uint8_t sa_service_type, uint8_t* p_ingest, ui
  * @brief Function: Crypto_TM_Do_Decrypt_NONAEAD
  * Performs decryption on NON AEAD Encryption and Authenticated Encryption
  * @param sa_service_type: uint8_t
- * @param pdu_len: uint16_t
+ * @param desc: const crypto_frame_desc_t*
  * @param p_new_dec_frame: uint8_t*
- * @param byte_idx: uint16_t
  * @param p_ingest: uint8_t*
  * @param akp: crypto_key_t*
  * @param ekp: crypto_key_t*
  * @param sa_ptr: SecurityAssociation_t*
- * @param iv_loc: uint8_t
- * @param mac_loc: int
  * @param aad_len: uint16_t
  * @param aad: uint8_t
  * @return int32_t: Success/Failure
 */
-int32_t Crypto_TM_Do_Decrypt_NONAEAD(uint8_t sa_service_type, uint16_t pdu_len, uint8_t* p_new_dec_frame, uint16_t byte_idx, uint8_t* p_ingest, crypto_key_t* akp, crypto_key_t* ekp, SecurityAssociation_t* sa_ptr, uint8_t iv_loc, int mac_loc, uint16_t aad_len, uint8_t* aad)
+int32_t Crypto_TM_Do_Decrypt_NONAEAD(uint8_t sa_service_type, const crypto_frame_desc_t* desc, uint8_t* p_new_dec_frame, uint8_t* p_ingest, crypto_key_t* akp, crypto_key_t* ekp, SecurityAssociation_t* sa_ptr, uint16_t aad_len, uint8_t* aad)
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
+    uint16_t byte_idx = desc->pdu_loc;
+    uint16_t pdu_len = desc->pdu_len;
     if(sa_service_type == SA_AUTHENTICATION || sa_service_type == SA_AUTHENTICATED_ENCRYPTION)
     {
-        status = cryptography_if->cryptography_validate_authentication(p_new_dec_frame+byte_idx, // plaintext output
+        status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_validate_authentication(p_new_dec_frame+byte_idx, // plaintext output
                                             pdu_len, // length of data
                                             p_ingest+byte_idx, // ciphertext input
                                             pdu_len, // in data length
                                             &(akp->value[0]), // Key
                                             Crypto_Get_ACS_Algo_Keylen(sa_ptr->acs),
                                             sa_ptr, // SA for key reference
-                                            p_ingest+iv_loc, // IV
+                                            p_ingest+desc->iv_loc, // IV
                                             sa_ptr->iv_len, // IV Length
-                                            p_ingest+mac_loc, // Frame Expected Tag
+                                            p_ingest+desc->mac_loc, // Frame Expected Tag
                                             sa_ptr->stmacf_len, // tag size
                                             aad, // additional authenticated data
                                             aad_len, // length of AAD
@@ -1468,20 +1525,20 @@ int32_t Crypto_TM_Do_Decrypt_NONAEAD(uint8_t sa_service_type, uint16_t pdu_len,
         {
             // free(aad); - non-heap object
             status = CRYPTO_LIB_ERR_KEY_LENGTH_ERROR;
-            mc_if->mc_log(status);
+            CRYPTO_MC_IF->mc_log(status);
             //return status;
         }
 
         if(status == CRYPTO_LIB_SUCCESS)
         {
-            status = cryptography_if->cryptography_decrypt(p_new_dec_frame+byte_idx, // plaintext output
+            status = CRYPTO_CRYPTOGRAPHY_IF->cryptography_decrypt(p_new_dec_frame+byte_idx, // plaintext output
                                                     pdu_len,   // length of data
                                                     p_ingest+byte_idx, // ciphertext input
                                                     pdu_len,    // in data length
                                                     &(ekp->value[0]), // Key
                                                     Crypto_Get_ECS_Algo_Keylen(sa_ptr->ecs),
                                                     sa_ptr, // SA for key reference
-                                                    p_ingest+iv_loc, // IV
+                                                    p_ingest+desc->iv_loc, // IV
                                                     sa_ptr->iv_len, // IV Length
                                                     &sa_ptr->ecs, // encryption cipher
                                                     &sa_ptr->acs,  // authentication cipher
@@ -1504,83 +1561,51 @@ int32_t Crypto_TM_Do_Decrypt_NONAEAD(uint8_t sa_service_type, uint16_t pdu_len,
     return status;
 }
 
-/**
- * @brief Function: Crypto_TM_Calc_PDU_MAC
- * Calculates the PDU MAC
- * @param pdu_len: uint16_t*
- * @param byte_idx: uint16_t
- * @param sa_ptr: SecurityAssociation_t*
- * @param mac_loc: int*
- * @return int32_t: Success/Failure
-*/
-void Crypto_TM_Calc_PDU_MAC(uint16_t* pdu_len, uint16_t byte_idx, SecurityAssociation_t* sa_ptr, int* mac_loc)
-{
-    *pdu_len = current_managed_parameters_struct.max_frame_size - (byte_idx) - sa_ptr->stmacf_len;
-    if(current_managed_parameters_struct.has_ocf == TM_HAS_OCF)
-    {
-        *pdu_len -= 4;
-    }
-    if(current_managed_parameters_struct.has_fecf == TM_HAS_FECF)
-    {
-        *pdu_len -= 2;
-    }
-
-    // If MAC exists, comes immediately after pdu
-    if (sa_ptr->stmacf_len > 0)
-    {
-        *mac_loc = byte_idx + *pdu_len;
-    }
-}
-
 /**
  * @brief Function: Crypto_TM_Do_Decrypt
  * Parent TM Decryption Functionality
  * @param sa_service_type: uint8_t
  * @param sa_ptr: SecurityAssociation_t*
  * @param ecs_is_aead_algorithm: uint8_t
- * @param byte_idx: uint16_t
+ * @param desc: const crypto_frame_desc_t*
  * @param p_new_dec_frame: uint8_t*
- * @param pdu_len: uint16_t
  * @param p_ingest: uint8_t*
  * @param ekp: crypto_key_t*
  * @param akp: crypto_key_t*
- * @param iv_loc: uint8_t
- * @param mac_loc: int
  * @param aad_len: uint16_t
  * @param aad: uint8_t*
  * @param pp_processed_frame: uint8_t**
  * @param p_decrypted_length: uint16_t*
  * @return int32_t: Success/Failure
 */
-int32_t Crypto_TM_Do_Decrypt(uint8_t sa_service_type, SecurityAssociation_t* sa_ptr, uint8_t ecs_is_aead_algorithm, uint16_t byte_idx, uint8_t* p_new_dec_frame, uint16_t pdu_len, uint8_t* p_ingest, crypto_key_t* ekp, crypto_key_t* akp, uint8_t iv_loc, int mac_loc, uint16_t aad_len, uint8_t* aad, uint8_t** pp_processed_frame, uint16_t* p_decrypted_length)
+int32_t Crypto_TM_Do_Decrypt(uint8_t sa_service_type, SecurityAssociation_t* sa_ptr, uint8_t ecs_is_aead_algorithm, const crypto_frame_desc_t* desc, uint8_t* p_new_dec_frame, uint8_t* p_ingest, crypto_key_t* ekp, crypto_key_t* akp, uint16_t aad_len, uint8_t* aad, uint8_t** pp_processed_frame, uint16_t* p_decrypted_length)
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
     if(sa_service_type != SA_PLAINTEXT && ecs_is_aead_algorithm == CRYPTO_TRUE)
     {
-        status = Crypto_TM_Do_Decrypt_AEAD(sa_service_type, p_ingest, p_new_dec_frame, byte_idx, pdu_len, ekp, sa_ptr, iv_loc, mac_loc, aad_len, aad);
+        status = Crypto_TM_Do_Decrypt_AEAD(sa_service_type, p_ingest, p_new_dec_frame, desc, ekp, sa_ptr, aad_len, aad);
     }
 
     else if (sa_service_type != SA_PLAINTEXT && ecs_is_aead_algorithm == CRYPTO_FALSE)
     {
-        status = Crypto_TM_Do_Decrypt_NONAEAD(sa_service_type, pdu_len, p_new_dec_frame, byte_idx, p_ingest, akp, ekp, sa_ptr, iv_loc, mac_loc, aad_len, aad);
+        status = Crypto_TM_Do_Decrypt_NONAEAD(sa_service_type, desc, p_new_dec_frame, p_ingest, akp, ekp, sa_ptr, aad_len, aad);
         // TODO - implement non-AEAD algorithm logic
     }
 
    // If plaintext, copy byte by byte
     else if(sa_service_type == SA_PLAINTEXT)
     {
-        memcpy(p_new_dec_frame+byte_idx, &(p_ingest[byte_idx]), pdu_len);
-        byte_idx += pdu_len;
+        memcpy(p_new_dec_frame+desc->pdu_loc, &(p_ingest[desc->pdu_loc]), desc->pdu_len);
     }
 
 #ifdef TM_DEBUG
     printf(KYEL "Printing received frame:\n\t" RESET);
-    for( int i=0; i<current_managed_parameters_struct.max_frame_size; i++)
+    for( int i=0; i<desc->frame_len; i++)
     {
         printf(KYEL "%02X", p_ingest[i]);
     }
     printf(KYEL "\nPrinting PROCESSED frame:\n\t" RESET);
-        for( int i=0; i<current_managed_parameters_struct.max_frame_size; i++)
+        for( int i=0; i<desc->frame_len; i++)
     {
         printf(KYEL "%02X", p_new_dec_frame[i]);
     }
@@ -1589,14 +1614,14 @@ int32_t Crypto_TM_Do_Decrypt(uint8_t sa_service_type, SecurityAssociation_t* sa_
 
     *pp_processed_frame = p_new_dec_frame;
     // TODO maybe not just return this without doing the math ourselves
-    *p_decrypted_length = current_managed_parameters_struct.max_frame_size;
+    *p_decrypted_length = desc->frame_len;
 
 #ifdef DEBUG
         printf(KYEL "----- Crypto_TM_ProcessSecurity END -----\n" RESET);
 #endif
     if(status != CRYPTO_LIB_SUCCESS)
     {
-        mc_if->mc_log(status);
+        CRYPTO_MC_IF->mc_log(status);
     }
     
     return status;
@@ -1606,76 +1631,175 @@ int32_t Crypto_TM_Do_Decrypt(uint8_t sa_service_type, SecurityAssociation_t* sa_
  * @brief Function: Crypto_TM_Process_Debug_Print
  * TM Process Helper Debug Print
  * Displays Index/data location start, Data Size, OCF Location, FECF Location
- * @param byte_idx: uint16_t
- * @param pdu_len: uint16_t
- * @param sa_ptr: SecurityAssociation_t*
+ * @param desc: const crypto_frame_desc_t*
 */
-void Crypto_TM_Process_Debug_Print(uint16_t byte_idx, uint16_t pdu_len, SecurityAssociation_t* sa_ptr)
+void Crypto_TM_Process_Debug_Print(const crypto_frame_desc_t* desc)
 {
     // Fix for variable warnings
-    byte_idx = byte_idx;
-    pdu_len = pdu_len;
-    sa_ptr = sa_ptr; 
+    desc = desc;
     #ifdef TM_DEBUG
-    printf(KYEL "Index / data location starts at: %d\n" RESET, byte_idx);
-    printf(KYEL "Data size is: %d\n" RESET, pdu_len);
-    if(current_managed_parameters_struct.has_ocf == TM_HAS_OCF)
+    printf(KYEL "Index / data location starts at: %d\n" RESET, desc->pdu_loc);
+    printf(KYEL "Data size is: %d\n" RESET, desc->pdu_len);
+    if(desc->ocf_len > 0)
     {
         // If OCF exists, comes immediately after MAC
-        printf(KYEL "OCF Location is: %d" RESET, byte_idx + pdu_len + sa_ptr->stmacf_len);
+        printf(KYEL "OCF Location is: %d" RESET, desc->ocf_loc);
     }
-    if(current_managed_parameters_struct.has_fecf == TM_HAS_FECF)
+    if(desc->fecf_len > 0)
     {
         // If FECF exists, comes just before end of the frame
-        printf(KYEL "FECF Location is: %d\n" RESET, current_managed_parameters_struct.max_frame_size - 2);
+        printf(KYEL "FECF Location is: %d\n" RESET, desc->fecf_loc);
     }
     #endif
 }
 
 /**
  * @brief Function: Crypto_TM_ProcessSecurity
+ * Idle frames the GVCID idle policy skips or only verifies return CRYPTO_LIB_ERR_IDLE_FRAME and no processed frame.
+ * Decrypted frames are held to the SA anti-replay window only when set with Crypto_Config_TM_Anti_Replay.
  * @param ingest: uint8_t*
  * @param len_ingest: int*
  * @return int32: Success/Failure
    **/
 int32_t Crypto_TM_ProcessSecurity(uint8_t* p_ingest, uint16_t len_ingest, uint8_t** pp_processed_frame, uint16_t* p_decrypted_length)
 {
-    // Local Variables
+    int32_t status;
+
+    Crypto_Arena_Enter();
+    status = crypto_tm_process_security(p_ingest, len_ingest, pp_processed_frame, p_decrypted_length);
+    Crypto_Arena_Leave();
+    return status;
+}
+
+/**
+ * @brief Function: crypto_tm_process_security
+ * ProcessSecurity body, runs inside the scratch arena scope opened by Crypto_TM_ProcessSecurity
+ **/
+static int32_t crypto_tm_process_security(uint8_t* p_ingest, uint16_t len_ingest, uint8_t** pp_processed_frame, uint16_t* p_decrypted_length)
+{
     int32_t status = CRYPTO_LIB_SUCCESS;
-    uint8_t aad[1786];
-    uint16_t aad_len = 0;
-    uint16_t byte_idx = 0;
-    uint8_t ecs_is_aead_algorithm;
-    uint32_t encryption_cipher = 0;
-    uint8_t iv_loc;
-    int mac_loc = 0;
-    uint16_t pdu_len = 1;
-    uint8_t* p_new_dec_frame = NULL;
-    SecurityAssociation_t* sa_ptr = NULL;
-    uint8_t sa_service_type = -1;
-    uint8_t secondary_hdr_len = 0;
-    uint8_t spi = -1;  
-    crypto_key_t* ekp = NULL;
-    crypto_key_t* akp = NULL;  
+    crypto_tm_process_ctx_t ctx;
 
-    // Bit math to give concise access to values in the ingest
-    tm_frame_pri_hdr.tfvn = ((uint8_t)p_ingest[0] & 0xC0) >> 6;
-    tm_frame_pri_hdr.scid = (((uint16_t)p_ingest[0] & 0x3F) << 4) | (((uint16_t)p_ingest[1] & 0xF0) >> 4);
-    tm_frame_pri_hdr.vcid = ((uint8_t)p_ingest[1] & 0x0E) >> 1;
+    status = crypto_tm_process_prepare(p_ingest, len_ingest, CRYPTO_TRUE, CRYPTO_TRUE, &ctx);
+    if ((status == CRYPTO_LIB_SUCCESS) && (ctx.idle_policy == IDLE_FRAMES_VERIFY))
+    {
+        // Idle fill carries nothing worth decrypting, it only has to be authentic and in sequence
+        status = Crypto_Frame_Verify_Auth(ctx.sa_service_type, ctx.ecs_is_aead_algorithm, ctx.sa_ptr, p_ingest, &ctx.desc, ctx.ekp, ctx.akp, ctx.aad, ctx.aad_len);
+        if (status == CRYPTO_LIB_SUCCESS)
+        {
+            status = Crypto_Frame_Check_IV_ARSN(ctx.sa_ptr, p_ingest, &ctx.desc);
+        }
+        if (status == CRYPTO_LIB_SUCCESS)
+        {
+            status = CRYPTO_LIB_ERR_IDLE_FRAME;
+        }
+    }
+    else if (status == CRYPTO_LIB_SUCCESS) 
+    {
+        status = Crypto_TM_Do_Decrypt(ctx.sa_service_type, ctx.sa_ptr, ctx.ecs_is_aead_algorithm, &ctx.desc, ctx.p_new_dec_frame, p_ingest, ctx.ekp, ctx.akp, ctx.aad_len, ctx.aad, pp_processed_frame, p_decrypted_length);
+        if (status == CRYPTO_LIB_SUCCESS)
+        {
+            status = crypto_tm_process_commit(&ctx, p_ingest, pp_processed_frame, p_decrypted_length);
+        }
+    } 
+    Crypto_MC_Reject_Record(&ctx.desc, status);
+
+    return status;
+}
 
-    status = Crypto_TM_Process_Setup(len_ingest, &byte_idx, p_ingest, &secondary_hdr_len);
+/**
+ * @brief Function: Crypto_TM_VerifySecurity
+ * Verify-only counterpart of Crypto_TM_ProcessSecurity for relays that forward frames unchanged: SA lookup, a
+ * read-only anti-replay window check, FECF, MAC/tag check, then the anti-replay window update.  Accepted frames advance
+ * the SA IV/ARSN; no plaintext is returned.  AES-GCM tags are checked without decrypting when the module provides
+ * cryptography_aead_verify, other authenticated encryption SAs are decrypted to a scratch buffer (see
+ * Crypto_Frame_Verify_Auth).
+ * @param p_ingest: uint8_t*
+ * @param len_ingest: uint16_t
+ * @return int32: CRYPTO_LIB_SUCCESS to accept, otherwise the reject reason
+ **/
+int32_t Crypto_TM_VerifySecurity(uint8_t* p_ingest, uint16_t len_ingest)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    crypto_tm_process_ctx_t ctx;
+
+    Crypto_Arena_Enter();
+    status = crypto_tm_process_prepare(p_ingest, len_ingest, CRYPTO_FALSE, CRYPTO_TRUE, &ctx);
     if (status == CRYPTO_LIB_SUCCESS)
     {
-        /**
-         * Begin Security Header Fields
-         * Reference CCSDS SDLP 3550b1 4.1.1.1.3
-         **/
-        // Get SPI
-        spi = (uint8_t)p_ingest[byte_idx] << 8 | (uint8_t)p_ingest[byte_idx + 1];
-        // Move index to past the SPI
-        byte_idx += 2;
+        status = Crypto_Frame_Verify_Auth(ctx.sa_service_type, ctx.ecs_is_aead_algorithm, ctx.sa_ptr, p_ingest, &ctx.desc, ctx.ekp, ctx.akp, ctx.aad, ctx.aad_len);
+    }
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        status = Crypto_Frame_Check_IV_ARSN(ctx.sa_ptr, p_ingest, &ctx.desc);
+    }
+    if ((status == CRYPTO_LIB_SUCCESS) && (ctx.idle_policy == IDLE_FRAMES_VERIFY))
+    {
+        status = CRYPTO_LIB_ERR_IDLE_FRAME;
+    }
+    Crypto_MC_Reject_Record(&ctx.desc, status);
+    Crypto_Arena_Leave();
+    return status;
+}
+
+/**
+ * @brief Function: crypto_tm_process_prepare
+ * Everything ProcessSecurity does ahead of decryption: frame and SA lookup, FECF check, output buffer, keys, and AAD.
+ * Only uses the global managed parameters while it runs, so the prepared context can be decrypted on any thread.
+ * Verify-only callers pass alloc_output CRYPTO_FALSE and get no output buffer, nor do idle frames verified under the
+ * GVCID idle policy.  Idle frames the policy skips are rejected with CRYPTO_LIB_ERR_IDLE_FRAME before the SA lookup.
+ * Frames of a GVCID or SA over its rejection budget are shed with CRYPTO_LIB_ERR_FRAME_SHED right after decode; the
+ * caller charges any later failure to the budgets with Crypto_MC_Reject_Record.
+ * @param p_ingest: uint8_t*
+ * @param len_ingest: uint16_t
+ * @param alloc_output: uint8_t
+ * @param precheck_replay: uint8_t, CRYPTO_FALSE when the anti-replay window is committed only after more frames are set up
+ * @param ctx: crypto_tm_process_ctx_t*
+ * @return int32_t: Success/Failure
+ **/
+static int32_t crypto_tm_process_prepare(uint8_t* p_ingest, uint16_t len_ingest, uint8_t alloc_output, uint8_t precheck_replay, crypto_tm_process_ctx_t* ctx)
+{
+    // Local Variables
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    uint32_t encryption_cipher = 0;
 
-        status = sa_if->sa_get_from_spi(spi, &sa_ptr);
+    ctx->sa_ptr = NULL;
+    ctx->ekp = NULL;
+    ctx->akp = NULL;
+    ctx->p_new_dec_frame = NULL;
+    ctx->sa_service_type = -1;
+    ctx->ecs_is_aead_algorithm = CRYPTO_FALSE;
+    ctx->idle_policy = IDLE_FRAMES_PROCESS;
+    ctx->aad_len = 0;
+    ctx->desc.admitted = CRYPTO_FALSE;
+
+    // Cheapest checks first so a bad frame is dropped before it costs an SA lookup, FECF, AAD, or MAC: length,
+    // version, and GVCID while decoding the primary header, secondary header, and SPI once for all later stages,
+    // then the rejection budget, SPI and SA state, anti-replay window, and FECF
+    status = Crypto_TM_Process_Setup(len_ingest, p_ingest, &ctx->desc);
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        status = Crypto_MC_Reject_Admit(&ctx->desc);
+    }
+    if ((status == CRYPTO_LIB_SUCCESS) && ctx->desc.idle)
+    {
+        ctx->idle_policy = Crypto_Get_Idle_Frames_For_Managed_Parameters(current_managed_parameters)->idle_policy;
+        if (ctx->idle_policy == IDLE_FRAMES_SKIP)
+        {
+            return CRYPTO_LIB_ERR_IDLE_FRAME;
+        }
+        if (ctx->idle_policy == IDLE_FRAMES_VERIFY)
+        {
+            alloc_output = CRYPTO_FALSE;
+        }
+    }
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        status = CRYPTO_SA_IF->sa_get_from_spi(ctx->desc.spi, &ctx->sa_ptr);
+    }
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        status = Crypto_Frame_Check_SA_State(ctx->sa_ptr);
     }
 
     // If no valid SPI, return
@@ -1683,48 +1807,66 @@ int32_t Crypto_TM_ProcessSecurity(uint8_t* p_ingest, uint16_t len_ingest, uint8_
     {
 #ifdef SA_DEBUG
         printf(KYEL "DEBUG - Printing SA Entry for current frame.\n" RESET);
-        Crypto_saPrint(sa_ptr);
+        Crypto_saPrint(ctx->sa_ptr);
 #endif
         // Determine SA Service Type
-        status = Crypto_TM_Determine_SA_Service_Type(&sa_service_type, sa_ptr);
-        }
-        if (status == CRYPTO_LIB_SUCCESS) 
+        status = Crypto_TM_Determine_SA_Service_Type(&ctx->sa_service_type, ctx->sa_ptr);
+    }
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        // Determine Algorithm cipher & mode. // TODO - Parse authentication_cipher, and handle AEAD cases properly
+        status = Crypto_TM_Determine_Cipher_Mode(ctx->sa_service_type, ctx->sa_ptr, &encryption_cipher, &ctx->ecs_is_aead_algorithm);
+    }
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+#ifdef TM_DEBUG
+        switch (ctx->sa_service_type)
         {
-            // Determine Algorithm cipher & mode. // TODO - Parse authentication_cipher, and handle AEAD cases properly
-            status = Crypto_TM_Determine_Cipher_Mode(sa_service_type, sa_ptr, &encryption_cipher, &ecs_is_aead_algorithm);
+        case SA_PLAINTEXT:
+            printf(KBLU "Processing a TM - CLEAR!\n" RESET);
+            break;
+        case SA_AUTHENTICATION:
+            printf(KBLU "Processing a TM - AUTHENTICATED!\n" RESET);
+            break;
+        case SA_ENCRYPTION:
+            printf(KBLU "Processing a TM - ENCRYPTED!\n" RESET);
+            break;
+        case SA_AUTHENTICATED_ENCRYPTION:
+            printf(KBLU "Processing a TM - AUTHENTICATED ENCRYPTION!\n" RESET);
+            break;
         }
-        if (status == CRYPTO_LIB_SUCCESS) 
+#endif
+
+        // Locate security header fields, PDU, MAC, OCF, and FECF for this SA
+        // NOTE: The PDU size itself is not the length for authentication 
+        status = Crypto_Frame_Desc_Set_SA(&ctx->desc, ctx->sa_ptr);
+        if (status != CRYPTO_LIB_SUCCESS)
         {
-            #ifdef TM_DEBUG
-            switch (sa_service_type)
-            {
-            case SA_PLAINTEXT:
-                printf(KBLU "Processing a TM - CLEAR!\n" RESET);
-                break;
-            case SA_AUTHENTICATION:
-                printf(KBLU "Processing a TM - AUTHENTICATED!\n" RESET);
-                break;
-            case SA_ENCRYPTION:
-                printf(KBLU "Processing a TM - ENCRYPTED!\n" RESET);
-                break;
-            case SA_AUTHENTICATED_ENCRYPTION:
-                printf(KBLU "Processing a TM - AUTHENTICATED ENCRYPTION!\n" RESET);
-                break;
-            }
-            #endif
+            CRYPTO_MC_IF->mc_log(status);
+        }
+    }
 
+    // Frames that will be checked against the anti-replay window once verified are checked against it now as well,
+    // read-only, so replays never reach the MAC.  Batched frames are committed after the whole window is set up.
+    if ((status == CRYPTO_LIB_SUCCESS) && (precheck_replay == CRYPTO_TRUE) && (alloc_output == CRYPTO_FALSE))
+    {
+        status = Crypto_Frame_Precheck_IV_ARSN(ctx->sa_ptr, p_ingest, &ctx->desc);
+    }
+
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
         // Parse & Check FECF, if present, and update fecf length
         status = Crypto_TM_FECF_Setup(p_ingest, len_ingest);
     }
-    
-    if (status == CRYPTO_LIB_SUCCESS) 
+
+    if ((status == CRYPTO_LIB_SUCCESS) && (alloc_output == CRYPTO_TRUE))
     {
         // Accio buffer
-        p_new_dec_frame = (uint8_t*)calloc(1, (len_ingest) * sizeof(uint8_t));
-        if (!p_new_dec_frame)
+        ctx->p_new_dec_frame = (uint8_t*)calloc(1, (len_ingest) * sizeof(uint8_t));
+        if (!ctx->p_new_dec_frame)
         {
-            printf(KRED "Error: Calloc for decrypted output buffer failed! \n" RESET);
             status = CRYPTO_LIB_ERROR;
+            Crypto_MC_Event(status, ctx->sa_ptr->spi, NULL, "Calloc for decrypted output buffer failed");
         }
     }
 
@@ -1732,43 +1874,31 @@ int32_t Crypto_TM_ProcessSecurity(uint8_t* p_ingest, uint16_t len_ingest, uint8_
     {
         // Copy over TM Primary Header (6 bytes),Secondary (if present)
         // If present, the TF Secondary Header will follow the TF PriHdr
-        memcpy(p_new_dec_frame, &p_ingest[0], 6 + secondary_hdr_len);
-
-        // Byte_idx is still set to just past the SPI
-        // If IV is present, note location
-        if (sa_ptr->iv_len > 0)
+        if (ctx->p_new_dec_frame != NULL)
         {
-            iv_loc = byte_idx;
+            memcpy(ctx->p_new_dec_frame, &p_ingest[0], ctx->desc.spi_loc);
         }
-        // Increment byte_idx past Security Header Fields based on SA values
-        byte_idx += sa_ptr->shivf_len;
-        byte_idx += (sa_ptr->arsn_len - sa_ptr->shsnf_len);
-        byte_idx += sa_ptr->shplf_len;
 
     #ifdef SA_DEBUG
-        printf(KYEL "IV length of %d bytes\n" RESET, sa_ptr->shivf_len);
-        printf(KYEL "ARSN length of %d bytes\n" RESET, sa_ptr->arsn_len - sa_ptr->shsnf_len);
-        printf(KYEL "PAD length field of %d bytes\n" RESET, sa_ptr->shplf_len);
-        printf(KYEL "First byte past Security Header is at index %d\n" RESET, byte_idx);
+        printf(KYEL "IV length of %d bytes\n" RESET, ctx->sa_ptr->shivf_len);
+        printf(KYEL "ARSN length of %d bytes\n" RESET, ctx->sa_ptr->arsn_len - ctx->sa_ptr->shsnf_len);
+        printf(KYEL "PAD length field of %d bytes\n" RESET, ctx->sa_ptr->shplf_len);
+        printf(KYEL "First byte past Security Header is at index %d\n" RESET, ctx->desc.pdu_loc);
     #endif
 
-        /**
-         * End Security Header Fields
-         * byte_idx is now at start of pdu / encrypted data
-         **/
-
-        // Calculate size of the protocol data unit
-        // NOTE: This size itself is not the length for authentication 
-        Crypto_TM_Calc_PDU_MAC(&pdu_len, byte_idx, sa_ptr, &mac_loc);
-
-        Crypto_TM_Process_Debug_Print(byte_idx, pdu_len, sa_ptr);
+        Crypto_TM_Process_Debug_Print(&ctx->desc);
 
         // Copy pdu into output frame
         // this will be over-written by decryption functions if necessary,
         // but not by authentication which requires
 
         // Get Key        
-        status = Crypto_TM_Get_Keys(&ekp, &akp, sa_ptr);
+        status = Crypto_TM_Get_Keys(&ctx->ekp, &ctx->akp, ctx->sa_ptr);
+        if (status != CRYPTO_LIB_SUCCESS)
+        {
+            free(ctx->p_new_dec_frame);
+            ctx->p_new_dec_frame = NULL;
+        }
     }
 
     if (status == CRYPTO_LIB_SUCCESS) 
@@ -1780,19 +1910,453 @@ int32_t Crypto_TM_ProcessSecurity(uint8_t* p_ingest, uint16_t len_ingest, uint8_
         // if(sa_service_type != SA_PLAINTEXT)
         // {
             // status = CRYPTO_LIB_ERR_NULL_CIPHERS;
-            // mc_if->mc_log(status);
+            // CRYPTO_MC_IF->mc_log(status);
             // return status;
         // }
 
         // Parse MAC, prepare AAD
-        Crypto_TM_Parse_Mac_Prep_AAD(sa_service_type, p_ingest, mac_loc, sa_ptr, &aad_len, byte_idx, aad);
-
-        status = Crypto_TM_Do_Decrypt(sa_service_type, sa_ptr, ecs_is_aead_algorithm, byte_idx, p_new_dec_frame, pdu_len, p_ingest, ekp, akp, iv_loc, mac_loc, aad_len, aad, pp_processed_frame, p_decrypted_length);
+        Crypto_TM_Parse_Mac_Prep_AAD(ctx->sa_service_type, p_ingest, &ctx->desc, ctx->sa_ptr, &ctx->aad_len, ctx->aad);
     } 
 
     return status;
 }
 
+/**
+ * @brief Function: crypto_tm_process_commit
+ * Holds a decrypted frame to the SA anti-replay window and saves the advanced SA counters when TM anti-replay is
+ * configured (Crypto_Config_TM_Anti_Replay).  Serial and batch processing both commit through here, after decryption.
+ * A frame failing the window loses its processed frame.
+ * @param ctx: const crypto_tm_process_ctx_t*
+ * @param p_ingest: uint8_t*
+ * @param pp_processed_frame: uint8_t**
+ * @param p_decrypted_length: uint16_t*
+ * @return int32_t: Success/Failure
+ **/
+static int32_t crypto_tm_process_commit(const crypto_tm_process_ctx_t* ctx, uint8_t* p_ingest, uint8_t** pp_processed_frame, uint16_t* p_decrypted_length)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+
+    if (crypto_config.tm_check_anti_replay == TM_CHECK_ANTI_REPLAY_TRUE)
+    {
+        status = Crypto_Frame_Check_IV_ARSN(ctx->sa_ptr, p_ingest, &ctx->desc);
+    }
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        // Decrypted before the window was checked, the plaintext must not reach the caller
+        free(ctx->p_new_dec_frame);
+        *pp_processed_frame = NULL;
+        *p_decrypted_length = 0;
+    }
+    return status;
+}
+
+/**
+ * @brief Function: crypto_tm_batch_decrypt_share
+ * Decrypts and verifies every stride'th prepared frame of the window, starting at first
+ * @param share: crypto_tm_batch_share_t*
+ **/
+static void crypto_tm_batch_decrypt_share(crypto_tm_batch_share_t* share)
+{
+    crypto_tm_batch_job_t* job;
+    crypto_tm_process_ctx_t* ctx;
+    uint32_t i;
+
+    for (i = share->first; i < share->count; i += share->stride)
+    {
+        job = &share->jobs[i];
+        ctx = &share->ctx[i];
+        if (job->status != CRYPTO_LIB_SUCCESS)
+        {
+            continue;
+        }
+        Crypto_Arena_Enter();
+        if (ctx->idle_policy == IDLE_FRAMES_VERIFY)
+        {
+            job->status = Crypto_Frame_Verify_Auth(ctx->sa_service_type, ctx->ecs_is_aead_algorithm, ctx->sa_ptr, job->p_ingest, &ctx->desc, ctx->ekp, ctx->akp, ctx->aad, ctx->aad_len);
+        }
+        else
+        {
+            job->status = Crypto_TM_Do_Decrypt(ctx->sa_service_type, ctx->sa_ptr, ctx->ecs_is_aead_algorithm, &ctx->desc, ctx->p_new_dec_frame, job->p_ingest, ctx->ekp, ctx->akp, ctx->aad_len, ctx->aad, &job->p_processed_frame, &job->processed_length);
+        }
+        Crypto_Arena_Leave();
+    }
+}
+
+#ifdef CRYPTO_TM_PARALLEL
+/**
+ * @brief Function: crypto_tm_batch_pool_pop
+ * Takes the oldest queued share, the pool lock must be held
+ * @return crypto_tm_batch_share_t*: NULL when the queue is empty
+ **/
+static crypto_tm_batch_share_t* crypto_tm_batch_pool_pop(void)
+{
+    crypto_tm_batch_share_t* share = crypto_tm_batch_pool.head;
+
+    if (share != NULL)
+    {
+        crypto_tm_batch_pool.head = share->next;
+        if (crypto_tm_batch_pool.head == NULL)
+        {
+            crypto_tm_batch_pool.tail = NULL;
+        }
+        share->next = NULL;
+    }
+    return share;
+}
+
+/**
+ * @brief Function: crypto_tm_batch_pool_run
+ * Decrypts a share taken off the queue and signals its window once the last share is done.  Called with the pool
+ * lock held, which is dropped while the share runs.
+ * @param share: crypto_tm_batch_share_t*
+ **/
+static void crypto_tm_batch_pool_run(crypto_tm_batch_share_t* share)
+{
+    pthread_mutex_unlock(&crypto_tm_batch_pool.lock);
+    crypto_tm_batch_decrypt_share(share);
+    pthread_mutex_lock(&crypto_tm_batch_pool.lock);
+    share->window->pending--;
+    if (share->window->pending == 0)
+    {
+        pthread_cond_broadcast(&crypto_tm_batch_pool.finished);
+    }
+}
+
+/**
+ * @brief Function: crypto_tm_batch_pool_main
+ * Pool thread, runs queued shares until Crypto_TM_Batch_Shutdown stops the pool
+ * @param arg: void*, unused
+ **/
+static void* crypto_tm_batch_pool_main(void* arg)
+{
+    crypto_tm_batch_share_t* share;
+
+    arg = arg;
+    pthread_mutex_lock(&crypto_tm_batch_pool.lock);
+    for (;;)
+    {
+        while ((crypto_tm_batch_pool.head == NULL) && (crypto_tm_batch_pool.stopping == CRYPTO_FALSE))
+        {
+            pthread_cond_wait(&crypto_tm_batch_pool.posted, &crypto_tm_batch_pool.lock);
+        }
+        share = crypto_tm_batch_pool_pop();
+        if (share == NULL)
+        {
+            break;
+        }
+        crypto_tm_batch_pool_run(share);
+    }
+    pthread_mutex_unlock(&crypto_tm_batch_pool.lock);
+    return NULL;
+}
+#endif
+
+/**
+ * @brief Function: Crypto_TM_Batch_Shutdown
+ * Stops and joins the batch decrypt threads, the next parallel batch starts them again.  Called by Crypto_Shutdown.
+ **/
+void Crypto_TM_Batch_Shutdown(void)
+{
+#ifdef CRYPTO_TM_PARALLEL
+    uint32_t t;
+    uint32_t num_threads;
+
+    pthread_mutex_lock(&crypto_tm_batch_pool.lock);
+    crypto_tm_batch_pool.stopping = CRYPTO_TRUE;
+    num_threads = crypto_tm_batch_pool.num_threads;
+    pthread_cond_broadcast(&crypto_tm_batch_pool.posted);
+    pthread_mutex_unlock(&crypto_tm_batch_pool.lock);
+
+    for (t = 0; t < num_threads; t++)
+    {
+        pthread_join(crypto_tm_batch_pool.threads[t], NULL);
+    }
+
+    pthread_mutex_lock(&crypto_tm_batch_pool.lock);
+    crypto_tm_batch_pool.num_threads = 0;
+    crypto_tm_batch_pool.stopping = CRYPTO_FALSE;
+    pthread_mutex_unlock(&crypto_tm_batch_pool.lock);
+#endif
+}
+
+/**
+ * @brief Function: crypto_tm_batch_post
+ * Starts the decrypt stage of one window, split into up to num_workers shares.  With more than one share they are
+ * queued to the worker pool, which grows to num_workers threads on first use, and the caller is free to set up the
+ * next window.  A single share is left for crypto_tm_batch_finish to run on the calling thread.
+ * @param window: crypto_tm_batch_window_t*
+ * @param jobs: crypto_tm_batch_job_t*
+ * @param ctx: crypto_tm_process_ctx_t*
+ * @param count: uint32_t
+ * @param num_workers: uint32_t
+ **/
+static void crypto_tm_batch_post(crypto_tm_batch_window_t* window, crypto_tm_batch_job_t* jobs, crypto_tm_process_ctx_t* ctx, uint32_t count, uint32_t num_workers)
+{
+    uint32_t w;
+
+    if (num_workers > count)
+    {
+        num_workers = count;
+    }
+    for (w = 0; w < num_workers; w++)
+    {
+        window->shares[w].jobs = jobs;
+        window->shares[w].ctx = ctx;
+        window->shares[w].count = count;
+        window->shares[w].first = w;
+        window->shares[w].stride = num_workers;
+        window->shares[w].window = window;
+        window->shares[w].next = NULL;
+    }
+    window->num_shares = num_workers;
+    window->pending = num_workers;
+    window->queued = CRYPTO_FALSE;
+
+#ifdef CRYPTO_TM_PARALLEL
+    if (num_workers > 1)
+    {
+        pthread_mutex_lock(&crypto_tm_batch_pool.lock);
+        while (crypto_tm_batch_pool.num_threads < num_workers)
+        {
+            // Shares no thread picks up are run by the caller in crypto_tm_batch_finish
+            if (pthread_create(&crypto_tm_batch_pool.threads[crypto_tm_batch_pool.num_threads], NULL,
+                               crypto_tm_batch_pool_main, NULL) != 0)
+            {
+                break;
+            }
+            crypto_tm_batch_pool.num_threads++;
+        }
+        for (w = 0; w < num_workers; w++)
+        {
+            if (crypto_tm_batch_pool.tail == NULL)
+            {
+                crypto_tm_batch_pool.head = &window->shares[w];
+            }
+            else
+            {
+                crypto_tm_batch_pool.tail->next = &window->shares[w];
+            }
+            crypto_tm_batch_pool.tail = &window->shares[w];
+        }
+        window->queued = CRYPTO_TRUE;
+        pthread_cond_broadcast(&crypto_tm_batch_pool.posted);
+        pthread_mutex_unlock(&crypto_tm_batch_pool.lock);
+    }
+#endif
+}
+
+/**
+ * @brief Function: crypto_tm_batch_finish
+ * Waits for the decrypt stage posted with crypto_tm_batch_post.  While shares are still queued the calling thread
+ * takes them rather than sit idle, so the window completes even if no pool thread could be started.
+ * @param window: crypto_tm_batch_window_t*
+ **/
+static void crypto_tm_batch_finish(crypto_tm_batch_window_t* window)
+{
+    uint32_t w;
+#ifdef CRYPTO_TM_PARALLEL
+    crypto_tm_batch_share_t* share;
+
+    if (window->queued == CRYPTO_TRUE)
+    {
+        pthread_mutex_lock(&crypto_tm_batch_pool.lock);
+        while (window->pending > 0)
+        {
+            share = crypto_tm_batch_pool_pop();
+            if (share == NULL)
+            {
+                pthread_cond_wait(&crypto_tm_batch_pool.finished, &crypto_tm_batch_pool.lock);
+            }
+            else
+            {
+                crypto_tm_batch_pool_run(share);
+            }
+        }
+        pthread_mutex_unlock(&crypto_tm_batch_pool.lock);
+        return;
+    }
+#endif
+    for (w = 0; w < window->num_shares; w++)
+    {
+        crypto_tm_batch_decrypt_share(&window->shares[w]);
+    }
+}
+
+/**
+ * @brief Function: crypto_tm_batch_setup
+ * Setup stage of one window, in arrival order on the calling thread
+ * @param jobs: crypto_tm_batch_job_t*
+ * @param ctx: crypto_tm_process_ctx_t*
+ * @param count: uint32_t
+ **/
+static void crypto_tm_batch_setup(crypto_tm_batch_job_t* jobs, crypto_tm_process_ctx_t* ctx, uint32_t count)
+{
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        Crypto_Arena_Enter();
+        jobs[i].status = crypto_tm_process_prepare(jobs[i].p_ingest, jobs[i].len_ingest, CRYPTO_TRUE, CRYPTO_FALSE, &ctx[i]);
+        Crypto_Arena_Leave();
+    }
+}
+
+/**
+ * @brief Function: crypto_tm_batch_commit
+ * Commit stage of one window, in arrival order: the anti-replay check of Crypto_TM_ProcessSecurity, or of
+ * Crypto_TM_VerifySecurity for idle frames verified under the GVCID idle policy, then the rejection budgets
+ * @param jobs: crypto_tm_batch_job_t*
+ * @param ctx: crypto_tm_process_ctx_t*
+ * @param count: uint32_t
+ **/
+static void crypto_tm_batch_commit(crypto_tm_batch_job_t* jobs, crypto_tm_process_ctx_t* ctx, uint32_t count)
+{
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        if ((jobs[i].status == CRYPTO_LIB_SUCCESS) && (ctx[i].idle_policy == IDLE_FRAMES_VERIFY))
+        {
+            jobs[i].status = Crypto_Frame_Check_IV_ARSN(ctx[i].sa_ptr, jobs[i].p_ingest, &ctx[i].desc);
+            if (jobs[i].status == CRYPTO_LIB_SUCCESS)
+            {
+                jobs[i].status = CRYPTO_LIB_ERR_IDLE_FRAME;
+            }
+        }
+        else if (jobs[i].status == CRYPTO_LIB_SUCCESS)
+        {
+            jobs[i].status = crypto_tm_process_commit(&ctx[i], jobs[i].p_ingest, &jobs[i].p_processed_frame, &jobs[i].processed_length);
+        }
+        Crypto_MC_Reject_Record(&ctx[i].desc, jobs[i].status);
+    }
+}
+
+/**
+ * @brief Function: crypto_tm_batch_workers
+ * Number of decrypt threads a batch may use.  Frames are only decrypted concurrently when the library is built with
+ * CRYPTO_TM_PARALLEL, the SA copy a frame is prepared against can't go stale, and the cryptography module is safe to
+ * call from several threads at once.
+ * @param num_threads: uint32_t, requested
+ * @return uint32_t: Threads to use, at least 1
+ **/
+static uint32_t crypto_tm_batch_workers(uint32_t num_threads)
+{
+#ifdef CRYPTO_TM_PARALLEL
+    // Only modules safe to call concurrently on one SA, see Threading in crypto.h
+    if ((CRYPTO_CRYPTOGRAPHY_IF != get_cryptography_interface_libgcrypt()) &&
+        (CRYPTO_CRYPTOGRAPHY_IF != get_cryptography_interface_openssl()))
+    {
+        return 1;
+    }
+    if (num_threads > TM_BATCH_MAX_THREADS)
+    {
+        return TM_BATCH_MAX_THREADS;
+    }
+    return (num_threads == 0) ? 1 : num_threads;
+#else
+    num_threads = num_threads;
+    return 1;
+#endif
+}
+
+/**
+ * @brief Function: Crypto_TM_ProcessSecurity_Batch
+ * Processes consecutive frames of one virtual channel.  Frames are handled in windows of TM_BATCH_WINDOW: each frame
+ * is set up in order on the calling thread, the window is decrypted and verified on up to num_threads threads of a
+ * worker pool kept until Crypto_Shutdown, then committed in arrival order.  The next window is set up while the
+ * current one decrypts.  Commit applies the same anti-replay check as Crypto_TM_ProcessSecurity (see
+ * Crypto_Config_TM_Anti_Replay); a frame failing it gets its status and no processed frame.  Decryption only reads
+ * the IV carried in the frame, and every thread count runs the stages in the same order, so per-frame status,
+ * output, and final SA state do not depend on num_threads.  Rejection budgets are charged at commit, frames of the
+ * window being set up are not shed for rejections in the one being decrypted.  The SA copy returned by a MariaDB SA
+ * interface is only current for one frame, so that SA type runs with a window of one and sets up a frame only once
+ * the one before it is committed.
+ * @param jobs: crypto_tm_batch_job_t*
+ * @param num_jobs: uint32_t
+ * @param num_threads: uint32_t
+ * @return int32_t: Success/Failure, per-frame results are in jobs[].status
+ **/
+int32_t Crypto_TM_ProcessSecurity_Batch(crypto_tm_batch_job_t* jobs, uint32_t num_jobs, uint32_t num_threads)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    crypto_tm_process_ctx_t* ctx = NULL;
+    crypto_tm_batch_window_t windows[2];
+    uint32_t window = TM_BATCH_WINDOW;
+    uint8_t overlap = CRYPTO_TRUE;
+    uint32_t num_workers;
+    uint32_t start;
+    uint32_t count;
+    uint32_t next;
+    uint32_t next_count;
+    uint32_t cur;
+    uint32_t i;
+
+    if (jobs == NULL)
+    {
+        status = CRYPTO_LIB_ERR_NULL_BUFFER;
+        return status;
+    }
+    if (num_jobs == 0)
+    {
+        return status;
+    }
+    for (i = 0; i < num_jobs; i++)
+    {
+        jobs[i].p_processed_frame = NULL;
+        jobs[i].processed_length = 0;
+        jobs[i].status = CRYPTO_LIB_SUCCESS;
+    }
+
+    if (crypto_config.sa_type == SA_TYPE_MARIADB)
+    {
+        window = 1;
+        overlap = CRYPTO_FALSE;
+    }
+    num_workers = crypto_tm_batch_workers(num_threads);
+
+    // Two windows of contexts, one decrypting while the other is set up
+    ctx = (crypto_tm_process_ctx_t*)malloc(2 * window * sizeof(crypto_tm_process_ctx_t));
+    if (ctx == NULL)
+    {
+        status = CRYPTO_LIB_ERROR;
+        Crypto_MC_Event(status, MC_EVENT_SPI_NA, NULL, "Malloc for TM batch contexts failed");
+        return status;
+    }
+
+    start = 0;
+    cur = 0;
+    count = (num_jobs < window) ? num_jobs : window;
+    crypto_tm_batch_setup(&jobs[start], &ctx[0], count);
+    crypto_tm_batch_post(&windows[0], &jobs[start], &ctx[0], count, num_workers);
+    while (count > 0)
+    {
+        next = start + count;
+        next_count = ((num_jobs - next) < window) ? (num_jobs - next) : window;
+
+        if (overlap == CRYPTO_TRUE)
+        {
+            crypto_tm_batch_setup(&jobs[next], &ctx[(cur ^ 1) * window], next_count);
+        }
+        crypto_tm_batch_finish(&windows[cur]);
+        crypto_tm_batch_commit(&jobs[start], &ctx[cur * window], count);
+        if (overlap == CRYPTO_FALSE)
+        {
+            crypto_tm_batch_setup(&jobs[next], &ctx[(cur ^ 1) * window], next_count);
+        }
+        if (next_count > 0)
+        {
+            crypto_tm_batch_post(&windows[cur ^ 1], &jobs[next], &ctx[(cur ^ 1) * window], next_count, num_workers);
+        }
+
+        start = next;
+        count = next_count;
+        cur ^= 1;
+    }
+
+    free(ctx);
+    return status;
+}
+
 /**
  * @brief Function: Crypto_Get_tmLength
  * Returns the total length of the current tm_frame in BYTES!
@@ -1825,10 +2389,10 @@ void Crypto_TM_updatePDU(uint8_t* ingest, int len_ingest)
     SecurityAssociation_t* sa_ptr;
 
     // Consider a helper function here, or elsewhere, to do all the 'math' in one spot as a global accessible list of variables
-    if (sa_if->sa_get_from_spi(tm_frame[0], &sa_ptr) != CRYPTO_LIB_SUCCESS) // modify
+    if (CRYPTO_SA_IF->sa_get_from_spi(tm_frame[0], &sa_ptr) != CRYPTO_LIB_SUCCESS) // modify
     {
         // TODO - Error handling
-        printf(KRED"Update PDU Error!\n");
+        Crypto_MC_Event(CRYPTO_LIB_ERR_SPI_INDEX_OOB, tm_frame[0], NULL, "Update PDU Error");
         return; // Error -- unable to get SA from SPI.
     }
     if ((sa_ptr->est == 1) && (sa_ptr->ast == 1))
@@ -126,7 +126,7 @@ int32_t Crypto_User_ModifyKey(void)
 
     crypto_key_t* ekp = NULL;
 
-    ekp = key_if->get_key(kid);
+    ekp = CRYPTO_KEY_IF->get_key(kid);
     if (ekp == NULL)
     {
         return CRYPTO_LIB_ERR_KEY_ID_ERROR;
@@ -135,7 +135,10 @@ int32_t Crypto_User_ModifyKey(void)
     switch (mod)
     {
     case 1: // Invalidate Key
-        ekp->value[KEY_SIZE - 1]++;
+        if (ekp->key_len > 0)
+        {
+            ekp->value[ekp->key_len - 1]++;
+        }
         printf("Key %d value invalidated! \n", kid);
         break;
     case 2: // Modify key state
@@ -177,7 +180,7 @@ int32_t Crypto_User_ModifyVCID(void)
 
     for (i = 0; i < NUM_GVCID; i++)
     {
-        if (sa_if->sa_get_from_spi(i, &sa_ptr) != CRYPTO_LIB_SUCCESS)
+        if (CRYPTO_SA_IF->sa_get_from_spi(i, &sa_ptr) != CRYPTO_LIB_SUCCESS)
         {
             // TODO - Error handling
             return CRYPTO_LIB_ERROR; // Error -- unable to get SA from SPI.
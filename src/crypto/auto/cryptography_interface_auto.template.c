@@ -0,0 +1,826 @@
+/*
+ * Copyright 2021, by the California Institute of Technology.
+ * ALL RIGHTS RESERVED. United States Government Sponsorship acknowledged.
+ * Any commercial use must be negotiated with the Office of Technology
+ * Transfer at the California Institute of Technology.
+ *
+ * This software may be subject to U.S. export control laws. By accepting
+ * this software, the user agrees to comply with all applicable U.S.
+ * export laws and regulations. User has the responsibility to obtain
+ * export licenses, or other export authority as may be required before
+ * exporting such information to foreign countries or providing access to
+ * foreign persons.
+ */
+
+#include <string.h>
+#include <time.h>
+
+#include "crypto.h"
+#include "crypto_error.h"
+#include "cryptography_interface.h"
+
+/*
+** CRYPTOGRAPHY_TYPE_AUTO
+** Every compiled in cryptography module is initialized, each cipher suite is known answer
+** checked and timed on each module, and calls are routed per suite to the fastest module
+*/
+#ifndef CRYPTO_AUTO_BENCH_LEN
+#define CRYPTO_AUTO_BENCH_LEN 1024 // Payload bytes per timed call, a multiple of the AES block
+#endif
+#ifndef CRYPTO_AUTO_BENCH_REPS
+#define CRYPTO_AUTO_BENCH_REPS 16 // Timed calls per round
+#endif
+#define CRYPTO_AUTO_BENCH_ROUNDS 3 // Fastest round is kept
+#define CRYPTO_AUTO_MAX_KAT_LEN 128
+#define CRYPTO_AUTO_MAX_TAG_LEN 64
+#define CRYPTO_AUTO_LOG_LEN 256
+
+typedef struct
+{
+    const char* name;
+    CryptographyInterface (*get_interface)(void);
+} crypto_auto_candidate_t;
+
+typedef struct
+{
+    const char* name;
+    uint8_t ecs;
+    uint8_t acs;
+    const uint8_t* key;
+    uint32_t key_len;
+    const uint8_t* iv;
+    uint32_t iv_len;
+    const uint8_t* aad;
+    uint32_t aad_len;
+    const uint8_t* pt;
+    uint32_t pt_len;
+    const uint8_t* ct; // NULL for MAC only suites
+    const uint8_t* tag; // NULL for encryption only suites
+    uint32_t tag_len;
+} crypto_auto_suite_t;
+
+/*
+** Prototypes
+*/
+static int32_t cryptography_config(void);
+static int32_t cryptography_init(void);
+static int32_t cryptography_shutdown(void);
+static int32_t cryptography_encrypt(uint8_t* data_out, size_t len_data_out,
+                                         uint8_t* data_in, size_t len_data_in,
+                                         uint8_t* key, uint32_t len_key,
+                                         SecurityAssociation_t* sa_ptr,
+                                         uint8_t* iv, uint32_t iv_len,uint8_t* ecs, uint8_t padding, char* cam_cookies);
+static int32_t cryptography_decrypt(uint8_t* data_out, size_t len_data_out,
+                                         uint8_t* data_in, size_t len_data_in,
+                                         uint8_t* key, uint32_t len_key,
+                                         SecurityAssociation_t* sa_ptr,
+                                         uint8_t* iv, uint32_t iv_len,
+                                         uint8_t* ecs, uint8_t* acs, char* cam_cookies);
+static int32_t cryptography_authenticate(uint8_t* data_out, size_t len_data_out,
+                                         uint8_t* data_in, size_t len_data_in,
+                                         uint8_t* key, uint32_t len_key,
+                                         SecurityAssociation_t* sa_ptr,
+                                         uint8_t* iv, uint32_t iv_len,
+                                         uint8_t* mac, uint32_t mac_size,
+                                         uint8_t* aad, uint32_t aad_len,
+                                         uint8_t ecs, uint8_t acs, char* cam_cookies);
+static int32_t cryptography_validate_authentication(uint8_t* data_out, size_t len_data_out,
+                                         const uint8_t* data_in, const size_t len_data_in,
+                                         uint8_t* key, uint32_t len_key,
+                                         SecurityAssociation_t* sa_ptr,
+                                         const uint8_t* iv, uint32_t iv_len,
+                                         const uint8_t* mac, uint32_t mac_size,
+                                         const uint8_t* aad, uint32_t aad_len,
+                                         uint8_t ecs, uint8_t acs, char* cam_cookies);
+static int32_t cryptography_aead_encrypt(uint8_t* data_out, size_t len_data_out,
+                                         uint8_t* data_in, size_t len_data_in,
+                                         uint8_t* key, uint32_t len_key,
+                                         SecurityAssociation_t* sa_ptr,
+                                         uint8_t* iv, uint32_t iv_len,
+                                         uint8_t* mac, uint32_t mac_size,
+                                         uint8_t* aad, uint32_t aad_len,
+                                         uint8_t encrypt_bool, uint8_t authenticate_bool,
+                                         uint8_t aad_bool, uint8_t* ecs, uint8_t* acs, char* cam_cookies);
+static int32_t cryptography_aead_decrypt(uint8_t* data_out, size_t len_data_out,
+                                         uint8_t* data_in, size_t len_data_in,
+                                         uint8_t* key, uint32_t len_key,
+                                         SecurityAssociation_t* sa_ptr,
+                                         uint8_t* iv, uint32_t iv_len,
+                                         uint8_t* mac, uint32_t mac_size,
+                                         uint8_t* aad, uint32_t aad_len,
+                                         uint8_t decrypt_bool, uint8_t authenticate_bool,
+                                         uint8_t aad_bool, uint8_t* ecs, uint8_t* acs, char* cam_cookies);
+static int32_t cryptography_get_acs_algo(int8_t algo_enum);
+static int32_t cryptography_get_ecs_algo(int8_t algo_enum);
+static int32_t cryptography_sa_flush(uint16_t spi);
+static int32_t cryptography_aead_verify(uint8_t* data_in, size_t len_data_in,
+                                        uint8_t* key, uint32_t len_key,
+                                        SecurityAssociation_t* sa_ptr,
+                                        uint8_t* iv, uint32_t iv_len,
+                                        uint8_t* mac, uint32_t mac_size,
+                                        uint8_t* aad, uint32_t aad_len,
+                                        uint8_t* ecs);
+
+/*
+** Known answers
+** AES-256-GCM: GCM spec test case 16, AES-256-GCM-SIV: RFC 8452 C.2, ChaCha20-Poly1305: RFC 8439 2.8.2,
+** AES-256-CBC: SP 800-38A F.2.5, CMAC-AES256: SP 800-38B D.3, HMAC-SHA256/512: RFC 4231 test case 1
+*/
+static const uint8_t crypto_auto_gcm_key[] = {
+    0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c, 0x6d, 0x6a, 0x8f, 0x94,
+    0x67, 0x30, 0x83, 0x08, 0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c,
+    0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08,
+};
+static const uint8_t crypto_auto_gcm_iv[] = {
+    0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88,
+};
+static const uint8_t crypto_auto_gcm_aad[] = {
+    0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef, 0xfe, 0xed, 0xfa, 0xce,
+    0xde, 0xad, 0xbe, 0xef, 0xab, 0xad, 0xda, 0xd2,
+};
+static const uint8_t crypto_auto_gcm_pt[] = {
+    0xd9, 0x31, 0x32, 0x25, 0xf8, 0x84, 0x06, 0xe5, 0xa5, 0x59, 0x09, 0xc5,
+    0xaf, 0xf5, 0x26, 0x9a, 0x86, 0xa7, 0xa9, 0x53, 0x15, 0x34, 0xf7, 0xda,
+    0x2e, 0x4c, 0x30, 0x3d, 0x8a, 0x31, 0x8a, 0x72, 0x1c, 0x3c, 0x0c, 0x95,
+    0x95, 0x68, 0x09, 0x53, 0x2f, 0xcf, 0x0e, 0x24, 0x49, 0xa6, 0xb5, 0x25,
+    0xb1, 0x6a, 0xed, 0xf5, 0xaa, 0x0d, 0xe6, 0x57, 0xba, 0x63, 0x7b, 0x39,
+};
+static const uint8_t crypto_auto_gcm_ct[] = {
+    0x52, 0x2d, 0xc1, 0xf0, 0x99, 0x56, 0x7d, 0x07, 0xf4, 0x7f, 0x37, 0xa3,
+    0x2a, 0x84, 0x42, 0x7d, 0x64, 0x3a, 0x8c, 0xdc, 0xbf, 0xe5, 0xc0, 0xc9,
+    0x75, 0x98, 0xa2, 0xbd, 0x25, 0x55, 0xd1, 0xaa, 0x8c, 0xb0, 0x8e, 0x48,
+    0x59, 0x0d, 0xbb, 0x3d, 0xa7, 0xb0, 0x8b, 0x10, 0x56, 0x82, 0x88, 0x38,
+    0xc5, 0xf6, 0x1e, 0x63, 0x93, 0xba, 0x7a, 0x0a, 0xbc, 0xc9, 0xf6, 0x62,
+};
+static const uint8_t crypto_auto_gcm_tag[] = {
+    0x76, 0xfc, 0x6e, 0xce, 0x0f, 0x4e, 0x17, 0x68, 0xcd, 0xdf, 0x88, 0x53,
+    0xbb, 0x2d, 0x55, 0x1b,
+};
+static const uint8_t crypto_auto_gcm_siv_key[] = {
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+static const uint8_t crypto_auto_gcm_siv_iv[] = {
+    0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+static const uint8_t crypto_auto_gcm_siv_pt[] = {
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+static const uint8_t crypto_auto_gcm_siv_ct[] = {
+    0xc2, 0xef, 0x32, 0x8e, 0x5c, 0x71, 0xc8, 0x3b,
+};
+static const uint8_t crypto_auto_gcm_siv_tag[] = {
+    0x84, 0x31, 0x22, 0x13, 0x0f, 0x73, 0x64, 0xb7, 0x61, 0xe0, 0xb9, 0x74,
+    0x27, 0xe3, 0xdf, 0x28,
+};
+static const uint8_t crypto_auto_chacha_key[] = {
+    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x8b,
+    0x8c, 0x8d, 0x8e, 0x8f, 0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+    0x98, 0x99, 0x9a, 0x9b, 0x9c, 0x9d, 0x9e, 0x9f,
+};
+static const uint8_t crypto_auto_chacha_iv[] = {
+    0x07, 0x00, 0x00, 0x00, 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47,
+};
+static const uint8_t crypto_auto_chacha_aad[] = {
+    0x50, 0x51, 0x52, 0x53, 0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7,
+};
+static const uint8_t crypto_auto_chacha_pt[] = {
+    0x4c, 0x61, 0x64, 0x69, 0x65, 0x73, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x47,
+    0x65, 0x6e, 0x74, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x20, 0x6f, 0x66, 0x20,
+    0x74, 0x68, 0x65, 0x20, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x20, 0x6f, 0x66,
+    0x20, 0x27, 0x39, 0x39, 0x3a, 0x20, 0x49, 0x66, 0x20, 0x49, 0x20, 0x63,
+    0x6f, 0x75, 0x6c, 0x64, 0x20, 0x6f, 0x66, 0x66, 0x65, 0x72, 0x20, 0x79,
+    0x6f, 0x75, 0x20, 0x6f, 0x6e, 0x6c, 0x79, 0x20, 0x6f, 0x6e, 0x65, 0x20,
+    0x74, 0x69, 0x70, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20,
+    0x66, 0x75, 0x74, 0x75, 0x72, 0x65, 0x2c, 0x20, 0x73, 0x75, 0x6e, 0x73,
+    0x63, 0x72, 0x65, 0x65, 0x6e, 0x20, 0x77, 0x6f, 0x75, 0x6c, 0x64, 0x20,
+    0x62, 0x65, 0x20, 0x69, 0x74, 0x2e,
+};
+static const uint8_t crypto_auto_chacha_ct[] = {
+    0xd3, 0x1a, 0x8d, 0x34, 0x64, 0x8e, 0x60, 0xdb, 0x7b, 0x86, 0xaf, 0xbc,
+    0x53, 0xef, 0x7e, 0xc2, 0xa4, 0xad, 0xed, 0x51, 0x29, 0x6e, 0x08, 0xfe,
+    0xa9, 0xe2, 0xb5, 0xa7, 0x36, 0xee, 0x62, 0xd6, 0x3d, 0xbe, 0xa4, 0x5e,
+    0x8c, 0xa9, 0x67, 0x12, 0x82, 0xfa, 0xfb, 0x69, 0xda, 0x92, 0x72, 0x8b,
+    0x1a, 0x71, 0xde, 0x0a, 0x9e, 0x06, 0x0b, 0x29, 0x05, 0xd6, 0xa5, 0xb6,
+    0x7e, 0xcd, 0x3b, 0x36, 0x92, 0xdd, 0xbd, 0x7f, 0x2d, 0x77, 0x8b, 0x8c,
+    0x98, 0x03, 0xae, 0xe3, 0x28, 0x09, 0x1b, 0x58, 0xfa, 0xb3, 0x24, 0xe4,
+    0xfa, 0xd6, 0x75, 0x94, 0x55, 0x85, 0x80, 0x8b, 0x48, 0x31, 0xd7, 0xbc,
+    0x3f, 0xf4, 0xde, 0xf0, 0x8e, 0x4b, 0x7a, 0x9d, 0xe5, 0x76, 0xd2, 0x65,
+    0x86, 0xce, 0xc6, 0x4b, 0x61, 0x16,
+};
+static const uint8_t crypto_auto_chacha_tag[] = {
+    0x1a, 0xe1, 0x0b, 0x59, 0x4f, 0x09, 0xe2, 0x6a, 0x7e, 0x90, 0x2e, 0xcb,
+    0xd0, 0x60, 0x06, 0x91,
+};
+static const uint8_t crypto_auto_aes_key[] = {
+    0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0,
+    0x85, 0x7d, 0x77, 0x81, 0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7,
+    0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4,
+};
+static const uint8_t crypto_auto_cbc_iv[] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b,
+    0x0c, 0x0d, 0x0e, 0x0f,
+};
+static const uint8_t crypto_auto_aes_pt[] = {
+    0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11,
+    0x73, 0x93, 0x17, 0x2a,
+};
+static const uint8_t crypto_auto_cbc_ct[] = {
+    0xf5, 0x8c, 0x4c, 0x04, 0xd6, 0xe5, 0xf1, 0xba, 0x77, 0x9e, 0xab, 0xfb,
+    0x5f, 0x7b, 0xfb, 0xd6,
+};
+static const uint8_t crypto_auto_cmac_tag[] = {
+    0x28, 0xa7, 0x02, 0x3f, 0x45, 0x2e, 0x8f, 0x82, 0xbd, 0x4b, 0xf2, 0x8d,
+    0x8c, 0x37, 0xc3, 0x5c,
+};
+static const uint8_t crypto_auto_hmac_key[] = {
+    0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b,
+    0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b,
+};
+static const uint8_t crypto_auto_hmac_pt[] = {
+    0x48, 0x69, 0x20, 0x54, 0x68, 0x65, 0x72, 0x65,
+};
+static const uint8_t crypto_auto_hmac256_tag[] = {
+    0xb0, 0x34, 0x4c, 0x61, 0xd8, 0xdb, 0x38, 0x53, 0x5c, 0xa8, 0xaf, 0xce,
+    0xaf, 0x0b, 0xf1, 0x2b, 0x88, 0x1d, 0xc2, 0x00, 0xc9, 0x83, 0x3d, 0xa7,
+    0x26, 0xe9, 0x37, 0x6c, 0x2e, 0x32, 0xcf, 0xf7,
+};
+static const uint8_t crypto_auto_hmac512_tag[] = {
+    0x87, 0xaa, 0x7c, 0xde, 0xa5, 0xef, 0x61, 0x9d, 0x4f, 0xf0, 0xb4, 0x24,
+    0x1a, 0x1d, 0x6c, 0xb0, 0x23, 0x79, 0xf4, 0xe2, 0xce, 0x4e, 0xc2, 0x78,
+    0x7a, 0xd0, 0xb3, 0x05, 0x45, 0xe1, 0x7c, 0xde, 0xda, 0xa8, 0x33, 0xb7,
+    0xd6, 0xb8, 0xa7, 0x02, 0x03, 0x8b, 0x27, 0x4e, 0xae, 0xa3, 0xf4, 0xe4,
+    0xbe, 0x9d, 0x91, 0x4e, 0xeb, 0x61, 0xf1, 0x70, 0x2e, 0x69, 0x6c, 0x20,
+    0x3a, 0x12, 0x68, 0x54,
+};
+
+static const crypto_auto_suite_t crypto_auto_suites[] = {
+    {"AES256_GCM", CRYPTO_CIPHER_AES256_GCM, CRYPTO_MAC_NONE, crypto_auto_gcm_key, sizeof(crypto_auto_gcm_key),
+     crypto_auto_gcm_iv, sizeof(crypto_auto_gcm_iv), crypto_auto_gcm_aad, sizeof(crypto_auto_gcm_aad), crypto_auto_gcm_pt,
+     sizeof(crypto_auto_gcm_pt), crypto_auto_gcm_ct, crypto_auto_gcm_tag, sizeof(crypto_auto_gcm_tag)},
+    {"AES256_GCM_SIV", CRYPTO_CIPHER_AES256_GCM_SIV, CRYPTO_MAC_NONE, crypto_auto_gcm_siv_key,
+     sizeof(crypto_auto_gcm_siv_key), crypto_auto_gcm_siv_iv, sizeof(crypto_auto_gcm_siv_iv), NULL, 0,
+     crypto_auto_gcm_siv_pt, sizeof(crypto_auto_gcm_siv_pt), crypto_auto_gcm_siv_ct, crypto_auto_gcm_siv_tag,
+     sizeof(crypto_auto_gcm_siv_tag)},
+    {"CHACHA20_POLY1305", CRYPTO_CIPHER_CHACHA20_POLY1305, CRYPTO_MAC_NONE, crypto_auto_chacha_key,
+     sizeof(crypto_auto_chacha_key), crypto_auto_chacha_iv, sizeof(crypto_auto_chacha_iv), crypto_auto_chacha_aad,
+     sizeof(crypto_auto_chacha_aad), crypto_auto_chacha_pt, sizeof(crypto_auto_chacha_pt), crypto_auto_chacha_ct,
+     crypto_auto_chacha_tag, sizeof(crypto_auto_chacha_tag)},
+    {"AES256_CBC", CRYPTO_CIPHER_AES256_CBC, CRYPTO_MAC_NONE, crypto_auto_aes_key, sizeof(crypto_auto_aes_key),
+     crypto_auto_cbc_iv, sizeof(crypto_auto_cbc_iv), NULL, 0, crypto_auto_aes_pt, sizeof(crypto_auto_aes_pt),
+     crypto_auto_cbc_ct, NULL, 0},
+    {"CMAC_AES256", CRYPTO_CIPHER_NONE, CRYPTO_MAC_CMAC_AES256, crypto_auto_aes_key, sizeof(crypto_auto_aes_key), NULL,
+     0, NULL, 0, crypto_auto_aes_pt, sizeof(crypto_auto_aes_pt), NULL, crypto_auto_cmac_tag,
+     sizeof(crypto_auto_cmac_tag)},
+    {"HMAC_SHA256", CRYPTO_CIPHER_NONE, CRYPTO_MAC_HMAC_SHA256, crypto_auto_hmac_key, sizeof(crypto_auto_hmac_key),
+     NULL, 0, NULL, 0, crypto_auto_hmac_pt, sizeof(crypto_auto_hmac_pt), NULL, crypto_auto_hmac256_tag,
+     sizeof(crypto_auto_hmac256_tag)},
+    {"HMAC_SHA512", CRYPTO_CIPHER_NONE, CRYPTO_MAC_HMAC_SHA512, crypto_auto_hmac_key, sizeof(crypto_auto_hmac_key),
+     NULL, 0, NULL, 0, crypto_auto_hmac_pt, sizeof(crypto_auto_hmac_pt), NULL, crypto_auto_hmac512_tag,
+     sizeof(crypto_auto_hmac512_tag)},
+};
+#define CRYPTO_AUTO_NUM_SUITES (sizeof(crypto_auto_suites) / sizeof(crypto_auto_suites[0]))
+
+// Local modules only, in the same order of preference as Crypto_Init, KMC is never benchmarked
+static const crypto_auto_candidate_t crypto_auto_candidates[] = {
+    {"libgcrypt", get_cryptography_interface_libgcrypt},
+    {"wolfssl", get_cryptography_interface_wolfssl},
+    {"openssl", get_cryptography_interface_openssl},
+    {"custom", get_cryptography_interface_custom},
+};
+#define CRYPTO_AUTO_NUM_CANDIDATES (sizeof(crypto_auto_candidates) / sizeof(crypto_auto_candidates[0]))
+
+/*
+** Module Variables
+*/
+// Cryptography Interface
+static CryptographyInterfaceStruct cryptography_if_struct;
+// Initialized modules, NULL when not compiled in or failed to initialize
+static CryptographyInterface crypto_auto_modules[CRYPTO_AUTO_NUM_CANDIDATES];
+// Per suite routing, suites that were not measured go to the first initialized module
+static CryptographyInterface crypto_auto_ecs_route[UINT8_MAX + 1];
+static CryptographyInterface crypto_auto_acs_route[UINT8_MAX + 1];
+static uint8_t crypto_auto_bench_buf[2][CRYPTO_AUTO_BENCH_LEN];
+
+CryptographyInterface get_cryptography_interface_auto(void)
+{
+    cryptography_if_struct.cryptography_config = cryptography_config;
+    cryptography_if_struct.cryptography_init = cryptography_init;
+    cryptography_if_struct.cryptography_shutdown = cryptography_shutdown;
+    cryptography_if_struct.cryptography_encrypt = cryptography_encrypt;
+    cryptography_if_struct.cryptography_decrypt = cryptography_decrypt;
+    cryptography_if_struct.cryptography_authenticate = cryptography_authenticate;
+    cryptography_if_struct.cryptography_validate_authentication = cryptography_validate_authentication;
+    cryptography_if_struct.cryptography_aead_encrypt = cryptography_aead_encrypt;
+    cryptography_if_struct.cryptography_aead_decrypt = cryptography_aead_decrypt;
+    cryptography_if_struct.cryptography_get_acs_algo = cryptography_get_acs_algo;
+    cryptography_if_struct.cryptography_get_ecs_algo = cryptography_get_ecs_algo;
+    cryptography_if_struct.cryptography_sa_flush = cryptography_sa_flush;
+    cryptography_if_struct.cryptography_aead_verify = cryptography_aead_verify;
+    return &cryptography_if_struct;
+}
+
+/**
+ * @brief Function: crypto_auto_log
+ * Writes a selection line to the MC log when the MC module takes text, and to stdout in debug builds
+ * @param message: const char*
+ **/
+static void crypto_auto_log(const char* message)
+{
+    if ((mc_if != NULL) && (mc_if->mc_log_message != NULL))
+    {
+        mc_if->mc_log_message(message);
+    }
+#ifdef DEBUG
+    printf("%s\n", message);
+#endif
+}
+
+static uint64_t crypto_auto_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static uint8_t crypto_auto_is_unsupported(int32_t status)
+{
+    return (status == CRYPTO_LIB_ERR_UNSUPPORTED_ECS) || (status == CRYPTO_LIB_ERR_UNSUPPORTED_ACS) ||
+           (status == CRYPTO_LIB_ERR_UNSUPPORTED_MODE) || (status == CRYPTO_LIB_ERR_UNSUPPORTED_ECS_MODE);
+}
+
+/**
+ * @brief Function: crypto_auto_protect
+ * Runs the sending side of a suite on one module, AEAD and CBC write data_out, MACs write mac only
+ * @param cif: CryptographyInterface
+ * @param suite: const crypto_auto_suite_t*
+ * @param data_out: uint8_t*
+ * @param data_in: const uint8_t*
+ * @param len: uint32_t
+ * @param mac: uint8_t*
+ * @return int32: Success/Failure
+ **/
+static int32_t crypto_auto_protect(CryptographyInterface cif, const crypto_auto_suite_t* suite, uint8_t* data_out,
+                                   const uint8_t* data_in, uint32_t len, uint8_t* mac)
+{
+    uint8_t ecs = suite->ecs;
+    uint8_t acs = suite->acs;
+
+    if (suite->ecs == CRYPTO_CIPHER_NONE)
+    {
+        return cif->cryptography_authenticate(data_out, len, (uint8_t*)data_in, len, (uint8_t*)suite->key,
+                                              suite->key_len, NULL, NULL, 0, mac, suite->tag_len, (uint8_t*)data_in,
+                                              len, ecs, acs, NULL);
+    }
+    if (suite->tag == NULL)
+    {
+        // Encryption only modes work in place, as called from the TC/TM/AOS paths
+        memcpy(data_out, data_in, len);
+        return cif->cryptography_encrypt(data_out, len, data_out, len, (uint8_t*)suite->key, suite->key_len, NULL,
+                                         (uint8_t*)suite->iv, suite->iv_len, &ecs, 0, NULL);
+    }
+    return cif->cryptography_aead_encrypt(data_out, len, (uint8_t*)data_in, len, (uint8_t*)suite->key, suite->key_len,
+                                          NULL, (uint8_t*)suite->iv, suite->iv_len, mac, suite->tag_len,
+                                          (uint8_t*)suite->aad, suite->aad_len, CRYPTO_TRUE, CRYPTO_TRUE,
+                                          (suite->aad_len > 0), &ecs, &acs, NULL);
+}
+
+/**
+ * @brief Function: crypto_auto_known_answer
+ * Checks one module against a suite's known answer in both directions
+ * @param cif: CryptographyInterface
+ * @param suite: const crypto_auto_suite_t*
+ * @return int32: Success, the module's error, or CRYPTOGRAPHY_AUTO_KNOWN_ANSWER_FAILURE on a mismatch
+ **/
+static int32_t crypto_auto_known_answer(CryptographyInterface cif, const crypto_auto_suite_t* suite)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    uint8_t out[CRYPTO_AUTO_MAX_KAT_LEN];
+    uint8_t mac[CRYPTO_AUTO_MAX_TAG_LEN];
+    uint8_t ecs = suite->ecs;
+    uint8_t acs = suite->acs;
+
+    memset(mac, 0, sizeof(mac));
+    status = crypto_auto_protect(cif, suite, out, suite->pt, suite->pt_len, mac);
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        return status;
+    }
+    if (((suite->ct != NULL) && (memcmp(out, suite->ct, suite->pt_len) != 0)) ||
+        ((suite->tag != NULL) && (memcmp(mac, suite->tag, suite->tag_len) != 0)))
+    {
+        return CRYPTOGRAPHY_AUTO_KNOWN_ANSWER_FAILURE;
+    }
+
+    if (suite->ecs == CRYPTO_CIPHER_NONE)
+    {
+        return cif->cryptography_validate_authentication(out, suite->pt_len, suite->pt, suite->pt_len,
+                                                         (uint8_t*)suite->key, suite->key_len, NULL, NULL, 0,
+                                                         suite->tag, suite->tag_len, suite->pt, suite->pt_len, ecs,
+                                                         acs, NULL);
+    }
+    if (suite->tag == NULL)
+    {
+        status = cif->cryptography_decrypt(out, suite->pt_len, (uint8_t*)suite->ct, suite->pt_len,
+                                           (uint8_t*)suite->key, suite->key_len, NULL, (uint8_t*)suite->iv,
+                                           suite->iv_len, &ecs, &acs, NULL);
+    }
+    else
+    {
+        status = cif->cryptography_aead_decrypt(out, suite->pt_len, (uint8_t*)suite->ct, suite->pt_len,
+                                                (uint8_t*)suite->key, suite->key_len, NULL, (uint8_t*)suite->iv,
+                                                suite->iv_len, (uint8_t*)suite->tag, suite->tag_len,
+                                                (uint8_t*)suite->aad, suite->aad_len, CRYPTO_TRUE, CRYPTO_TRUE,
+                                                (suite->aad_len > 0), &ecs, &acs, NULL);
+    }
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        return status;
+    }
+    if (memcmp(out, suite->pt, suite->pt_len) != 0)
+    {
+        return CRYPTOGRAPHY_AUTO_KNOWN_ANSWER_FAILURE;
+    }
+    return status;
+}
+
+/**
+ * @brief Function: crypto_auto_benchmark
+ * Times the sending side of a suite on one module over CRYPTO_AUTO_BENCH_LEN bytes
+ * @param cif: CryptographyInterface
+ * @param suite: const crypto_auto_suite_t*
+ * @param ns_per_call: uint64_t*, fastest round
+ * @return int32: Success/Failure
+ **/
+static int32_t crypto_auto_benchmark(CryptographyInterface cif, const crypto_auto_suite_t* suite, uint64_t* ns_per_call)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    uint8_t mac[CRYPTO_AUTO_MAX_TAG_LEN];
+    uint64_t start;
+    uint64_t elapsed;
+    int round;
+    int rep;
+
+    *ns_per_call = UINT64_MAX;
+    // One untimed call to warm caches and the module's own context setup
+    status = crypto_auto_protect(cif, suite, crypto_auto_bench_buf[1], crypto_auto_bench_buf[0],
+                                 CRYPTO_AUTO_BENCH_LEN, mac);
+    for (round = 0; (round < CRYPTO_AUTO_BENCH_ROUNDS) && (status == CRYPTO_LIB_SUCCESS); round++)
+    {
+        start = crypto_auto_now_ns();
+        for (rep = 0; (rep < CRYPTO_AUTO_BENCH_REPS) && (status == CRYPTO_LIB_SUCCESS); rep++)
+        {
+            status = crypto_auto_protect(cif, suite, crypto_auto_bench_buf[1], crypto_auto_bench_buf[0],
+                                         CRYPTO_AUTO_BENCH_LEN, mac);
+        }
+        elapsed = (crypto_auto_now_ns() - start) / CRYPTO_AUTO_BENCH_REPS;
+        if (elapsed < *ns_per_call)
+        {
+            *ns_per_call = elapsed;
+        }
+    }
+    return status;
+}
+
+/**
+ * @brief Function: crypto_auto_select
+ * Routes one suite to the fastest module that passes its known answer and logs the timings
+ * @param suite: const crypto_auto_suite_t*
+ **/
+static void crypto_auto_select(const crypto_auto_suite_t* suite)
+{
+    char line[CRYPTO_AUTO_LOG_LEN];
+    size_t used;
+    CryptographyInterface fastest = NULL;
+    const char* fastest_name = "none";
+    uint64_t fastest_ns = UINT64_MAX;
+    uint64_t ns;
+    int32_t status;
+    size_t i;
+
+    used = (size_t)snprintf(line, sizeof(line), "cryptography auto: %s", suite->name);
+    for (i = 0; i < CRYPTO_AUTO_NUM_CANDIDATES; i++)
+    {
+        if (crypto_auto_modules[i] == NULL)
+        {
+            continue;
+        }
+        status = crypto_auto_known_answer(crypto_auto_modules[i], suite);
+        if (status == CRYPTO_LIB_SUCCESS)
+        {
+            status = crypto_auto_benchmark(crypto_auto_modules[i], suite, &ns);
+        }
+
+        if (used < sizeof(line))
+        {
+            if (status == CRYPTO_LIB_SUCCESS)
+            {
+                used += (size_t)snprintf(line + used, sizeof(line) - used, " %s=%luns", crypto_auto_candidates[i].name,
+                                         (unsigned long)ns);
+            }
+            else
+            {
+                used += (size_t)snprintf(line + used, sizeof(line) - used, " %s=%s", crypto_auto_candidates[i].name,
+                                         crypto_auto_is_unsupported(status) ? "unsupported" : "failed");
+            }
+        }
+        if (status != CRYPTO_LIB_SUCCESS)
+        {
+            if (!crypto_auto_is_unsupported(status))
+            {
+                // A module that gets a known answer wrong is never routed to for that suite
+                if (mc_if != NULL)
+                {
+                    mc_if->mc_log(CRYPTOGRAPHY_AUTO_KNOWN_ANSWER_FAILURE);
+                }
+            }
+            continue;
+        }
+        if (ns < fastest_ns)
+        {
+            fastest = crypto_auto_modules[i];
+            fastest_name = crypto_auto_candidates[i].name;
+            fastest_ns = ns;
+        }
+    }
+
+    if (fastest != NULL)
+    {
+        if (suite->ecs != CRYPTO_CIPHER_NONE)
+        {
+            crypto_auto_ecs_route[suite->ecs] = fastest;
+        }
+        else
+        {
+            crypto_auto_acs_route[suite->acs] = fastest;
+        }
+    }
+    if (used < sizeof(line))
+    {
+        snprintf(line + used, sizeof(line) - used, " -> %s", fastest_name);
+    }
+    crypto_auto_log(line);
+}
+
+static int32_t cryptography_config(void)
+{
+    return CRYPTO_LIB_SUCCESS;
+}
+
+static int32_t cryptography_init(void)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    CryptographyInterface fallback = NULL;
+    size_t i;
+
+    for (i = 0; i < CRYPTO_AUTO_NUM_CANDIDATES; i++)
+    {
+        crypto_auto_modules[i] = crypto_auto_candidates[i].get_interface();
+        if (crypto_auto_modules[i] == NULL)
+        {
+            continue;
+        }
+        status = crypto_auto_modules[i]->cryptography_init();
+        if (status == CRYPTO_LIB_SUCCESS)
+        {
+            status = crypto_auto_modules[i]->cryptography_config();
+        }
+        if (status != CRYPTO_LIB_SUCCESS)
+        {
+            printf(KRED "ERROR: cryptography auto: %s failed to initialize (%d), not used\n" RESET,
+                   crypto_auto_candidates[i].name, status);
+            if (mc_if != NULL)
+            {
+                mc_if->mc_log(status);
+            }
+            crypto_auto_modules[i]->cryptography_shutdown();
+            crypto_auto_modules[i] = NULL;
+            continue;
+        }
+        if (fallback == NULL)
+        {
+            fallback = crypto_auto_modules[i];
+        }
+    }
+    if (fallback == NULL)
+    {
+        printf(KRED "ERROR: cryptography auto: no cryptography module could be initialized\n" RESET);
+        return CRYPTOGRAPHY_AUTO_NO_USABLE_INTERFACE;
+    }
+
+    for (i = 0; i <= UINT8_MAX; i++)
+    {
+        crypto_auto_ecs_route[i] = fallback;
+        crypto_auto_acs_route[i] = fallback;
+    }
+    for (i = 0; i < CRYPTO_AUTO_NUM_SUITES; i++)
+    {
+        crypto_auto_select(&crypto_auto_suites[i]);
+    }
+    return CRYPTO_LIB_SUCCESS;
+}
+
+static int32_t cryptography_shutdown(void)
+{
+    size_t i;
+
+    for (i = 0; i < CRYPTO_AUTO_NUM_CANDIDATES; i++)
+    {
+        if (crypto_auto_modules[i] != NULL)
+        {
+            crypto_auto_modules[i]->cryptography_shutdown();
+            crypto_auto_modules[i] = NULL;
+        }
+    }
+    memset(crypto_auto_ecs_route, 0, sizeof(crypto_auto_ecs_route));
+    memset(crypto_auto_acs_route, 0, sizeof(crypto_auto_acs_route));
+    return CRYPTO_LIB_SUCCESS;
+}
+
+/*
+** Routed calls
+** Ciphers route on the ECS, MACs on the ACS, an AEAD call without a cipher routes on its ACS
+*/
+static CryptographyInterface crypto_auto_route(uint8_t* ecs, uint8_t* acs)
+{
+    if ((ecs != NULL) && (*ecs != CRYPTO_CIPHER_NONE))
+    {
+        return crypto_auto_ecs_route[*ecs];
+    }
+    if (acs != NULL)
+    {
+        return crypto_auto_acs_route[*acs];
+    }
+    return crypto_auto_ecs_route[CRYPTO_CIPHER_NONE];
+}
+
+static int32_t cryptography_encrypt(uint8_t* data_out, size_t len_data_out,
+                                         uint8_t* data_in, size_t len_data_in,
+                                         uint8_t* key, uint32_t len_key,
+                                         SecurityAssociation_t* sa_ptr,
+                                         uint8_t* iv, uint32_t iv_len,uint8_t* ecs, uint8_t padding, char* cam_cookies)
+{
+    CryptographyInterface cif = crypto_auto_route(ecs, NULL);
+    if (cif == NULL)
+    {
+        return CRYPTO_LIB_ERR_NO_INIT;
+    }
+    return cif->cryptography_encrypt(data_out, len_data_out, data_in, len_data_in, key, len_key, sa_ptr, iv, iv_len,
+                                     ecs, padding, cam_cookies);
+}
+
+static int32_t cryptography_decrypt(uint8_t* data_out, size_t len_data_out,
+                                         uint8_t* data_in, size_t len_data_in,
+                                         uint8_t* key, uint32_t len_key,
+                                         SecurityAssociation_t* sa_ptr,
+                                         uint8_t* iv, uint32_t iv_len,
+                                         uint8_t* ecs, uint8_t* acs, char* cam_cookies)
+{
+    CryptographyInterface cif = crypto_auto_route(ecs, NULL);
+    if (cif == NULL)
+    {
+        return CRYPTO_LIB_ERR_NO_INIT;
+    }
+    return cif->cryptography_decrypt(data_out, len_data_out, data_in, len_data_in, key, len_key, sa_ptr, iv, iv_len,
+                                     ecs, acs, cam_cookies);
+}
+
+static int32_t cryptography_authenticate(uint8_t* data_out, size_t len_data_out,
+                                         uint8_t* data_in, size_t len_data_in,
+                                         uint8_t* key, uint32_t len_key,
+                                         SecurityAssociation_t* sa_ptr,
+                                         uint8_t* iv, uint32_t iv_len,
+                                         uint8_t* mac, uint32_t mac_size,
+                                         uint8_t* aad, uint32_t aad_len,
+                                         uint8_t ecs, uint8_t acs, char* cam_cookies)
+{
+    CryptographyInterface cif = crypto_auto_acs_route[acs];
+    if (cif == NULL)
+    {
+        return CRYPTO_LIB_ERR_NO_INIT;
+    }
+    return cif->cryptography_authenticate(data_out, len_data_out, data_in, len_data_in, key, len_key, sa_ptr, iv,
+                                          iv_len, mac, mac_size, aad, aad_len, ecs, acs, cam_cookies);
+}
+
+static int32_t cryptography_validate_authentication(uint8_t* data_out, size_t len_data_out,
+                                         const uint8_t* data_in, const size_t len_data_in,
+                                         uint8_t* key, uint32_t len_key,
+                                         SecurityAssociation_t* sa_ptr,
+                                         const uint8_t* iv, uint32_t iv_len,
+                                         const uint8_t* mac, uint32_t mac_size,
+                                         const uint8_t* aad, uint32_t aad_len,
+                                         uint8_t ecs, uint8_t acs, char* cam_cookies)
+{
+    CryptographyInterface cif = crypto_auto_acs_route[acs];
+    if (cif == NULL)
+    {
+        return CRYPTO_LIB_ERR_NO_INIT;
+    }
+    return cif->cryptography_validate_authentication(data_out, len_data_out, data_in, len_data_in, key, len_key,
+                                                     sa_ptr, iv, iv_len, mac, mac_size, aad, aad_len, ecs, acs,
+                                                     cam_cookies);
+}
+
+static int32_t cryptography_aead_encrypt(uint8_t* data_out, size_t len_data_out,
+                                         uint8_t* data_in, size_t len_data_in,
+                                         uint8_t* key, uint32_t len_key,
+                                         SecurityAssociation_t* sa_ptr,
+                                         uint8_t* iv, uint32_t iv_len,
+                                         uint8_t* mac, uint32_t mac_size,
+                                         uint8_t* aad, uint32_t aad_len,
+                                         uint8_t encrypt_bool, uint8_t authenticate_bool,
+                                         uint8_t aad_bool, uint8_t* ecs, uint8_t* acs, char* cam_cookies)
+{
+    CryptographyInterface cif = crypto_auto_route(ecs, acs);
+    if (cif == NULL)
+    {
+        return CRYPTO_LIB_ERR_NO_INIT;
+    }
+    return cif->cryptography_aead_encrypt(data_out, len_data_out, data_in, len_data_in, key, len_key, sa_ptr, iv,
+                                          iv_len, mac, mac_size, aad, aad_len, encrypt_bool, authenticate_bool,
+                                          aad_bool, ecs, acs, cam_cookies);
+}
+
+static int32_t cryptography_aead_decrypt(uint8_t* data_out, size_t len_data_out,
+                                         uint8_t* data_in, size_t len_data_in,
+                                         uint8_t* key, uint32_t len_key,
+                                         SecurityAssociation_t* sa_ptr,
+                                         uint8_t* iv, uint32_t iv_len,
+                                         uint8_t* mac, uint32_t mac_size,
+                                         uint8_t* aad, uint32_t aad_len,
+                                         uint8_t decrypt_bool, uint8_t authenticate_bool,
+                                         uint8_t aad_bool, uint8_t* ecs, uint8_t* acs, char* cam_cookies)
+{
+    CryptographyInterface cif = crypto_auto_route(ecs, acs);
+    if (cif == NULL)
+    {
+        return CRYPTO_LIB_ERR_NO_INIT;
+    }
+    return cif->cryptography_aead_decrypt(data_out, len_data_out, data_in, len_data_in, key, len_key, sa_ptr, iv,
+                                          iv_len, mac, mac_size, aad, aad_len, decrypt_bool, authenticate_bool,
+                                          aad_bool, ecs, acs, cam_cookies);
+}
+
+static int32_t cryptography_get_acs_algo(int8_t algo_enum)
+{
+    CryptographyInterface cif = crypto_auto_acs_route[(uint8_t)algo_enum];
+    if (cif == NULL)
+    {
+        return CRYPTO_LIB_ERR_UNSUPPORTED_ACS;
+    }
+    return cif->cryptography_get_acs_algo(algo_enum);
+}
+
+static int32_t cryptography_get_ecs_algo(int8_t algo_enum)
+{
+    CryptographyInterface cif = crypto_auto_ecs_route[(uint8_t)algo_enum];
+    if (cif == NULL)
+    {
+        return CRYPTO_LIB_ERR_UNSUPPORTED_ECS;
+    }
+    return cif->cryptography_get_ecs_algo(algo_enum);
+}
+
+static int32_t cryptography_sa_flush(uint16_t spi)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    int32_t module_status;
+    size_t i;
+
+    for (i = 0; i < CRYPTO_AUTO_NUM_CANDIDATES; i++)
+    {
+        if ((crypto_auto_modules[i] != NULL) && (crypto_auto_modules[i]->cryptography_sa_flush != NULL))
+        {
+            module_status = crypto_auto_modules[i]->cryptography_sa_flush(spi);
+            if (status == CRYPTO_LIB_SUCCESS)
+            {
+                status = module_status;
+            }
+        }
+    }
+    return status;
+}
+
+// The routed module may not implement verify, report the suite unsupported so the caller decrypts instead
+static int32_t cryptography_aead_verify(uint8_t* data_in, size_t len_data_in,
+                                        uint8_t* key, uint32_t len_key,
+                                        SecurityAssociation_t* sa_ptr,
+                                        uint8_t* iv, uint32_t iv_len,
+                                        uint8_t* mac, uint32_t mac_size,
+                                        uint8_t* aad, uint32_t aad_len,
+                                        uint8_t* ecs)
+{
+    CryptographyInterface cif = crypto_auto_route(ecs, NULL);
+    if (cif == NULL)
+    {
+        return CRYPTO_LIB_ERR_NO_INIT;
+    }
+    if (cif->cryptography_aead_verify == NULL)
+    {
+        return CRYPTO_LIB_ERR_UNSUPPORTED_ECS;
+    }
+    return cif->cryptography_aead_verify(data_in, len_data_in, key, len_key, sa_ptr, iv, iv_len, mac, mac_size, aad,
+                                         aad_len, ecs);
+}
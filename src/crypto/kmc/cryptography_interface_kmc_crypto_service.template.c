@@ -16,8 +16,11 @@
 #include "cryptography_interface.h"
 #include "crypto.h"
 
+#include <errno.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 
 #include <curl/curl.h>
 
@@ -98,7 +101,21 @@ static int32_t cryptography_get_ecs_algo(int8_t algo_enum);
 static int32_t get_auth_algorithm_from_acs(uint8_t acs_enum, const char** algo_ptr);
 static int32_t get_cam_sso_token(void);
 static int32_t initialize_kerberos_keytab_file_login(void);
-static int32_t curl_perform_with_cam_retries(CURL* curl_handle,memory_write* chunk_write, memory_read* chunk_read);
+static int32_t curl_perform_with_cam_retries(CURL* curl_handle, const char* uri, memory_write* chunk_write, memory_read* chunk_read);
+static CURLcode kmc_endpoint_perform(CURL* curl_handle, const char* uri, memory_write* chunk_write, CURL** response_handle);
+static CURLcode kmc_endpoint_hedged_perform(CURL* curl_handle, const char* path, int primary, uint32_t* tried,
+                                            memory_write* chunk_write, CURL** response_handle);
+static char* kmc_endpoint_root_uri(const char* hostname, uint16_t port);
+static int kmc_endpoint_select(uint32_t tried);
+static void kmc_endpoint_set_url(CURL* curl_handle, int endpoint, const char* path);
+static void kmc_endpoint_sample(int endpoint, uint32_t elapsed_ms);
+static void kmc_endpoint_record(int endpoint, uint8_t ok, uint32_t elapsed_ms);
+static uint32_t kmc_endpoint_hedge_delay(int endpoint);
+static uint8_t kmc_response_ok(CURLcode res, CURL* curl_handle);
+static uint64_t kmc_now_ms(void);
+static int32_t kmc_thread_handles(void);
+static int32_t kmc_batch_perform(CURL* curl_handle, const char* uri, const uint8_t* payload, size_t payload_len,
+                                 memory_write* chunk_write, memory_read* chunk_read);
 
 // libcurl call back and support function declarations
 static int32_t configure_curl_connect_opts(CURL* curl, char* cam_cookies);
@@ -115,10 +132,54 @@ static int jsoneq(const char* json, jsmntok_t* tok, const char* s);
 */
 // Cryptography Interface
 static CryptographyInterfaceStruct cryptography_if_struct;
-static CURL* curl;
+static _Thread_local CURL* curl; // Each calling thread performs requests on its own handles
 struct curl_slist *http_headers_list;
 // KMC Crypto Service Endpoints
-static char* kmc_root_uri;
+static char* kmc_root_uri; // Root of the primary endpoint, request URIs are built on it
+// Health of each endpoint serving the crypto service, index 0 is the primary
+typedef struct {
+    char* root_uri;
+    uint16_t port;
+    uint32_t latency_ms[KMC_CRYPTO_LATENCY_SAMPLES]; // Recent request latencies, oldest overwritten first
+    uint32_t samples; // Valid entries in latency_ms
+    uint32_t next_sample;
+    uint32_t ewma_ms; // Smoothed latency, endpoints are chosen by it
+    uint32_t failures; // Consecutive failed requests
+    uint64_t open_until_ms; // Circuit open, endpoint skipped until then
+    uint8_t batch_unsupported; // Answered the batch endpoint with 404 or 405, no batches are sent to it again
+} kmc_endpoint_t;
+static kmc_endpoint_t kmc_endpoints[KMC_CRYPTO_MAX_ENDPOINTS];
+static uint8_t kmc_endpoint_count;
+static _Thread_local CURLM* kmc_multi; // Runs a request and its hedge side by side
+static _Thread_local uint32_t kmc_thread_generation;
+// Handles of every calling thread, cleaned up at shutdown
+typedef struct kmc_thread_handles {
+    CURL* curl;
+    CURLM* multi;
+    struct kmc_thread_handles* next;
+} kmc_thread_handles_t;
+static kmc_thread_handles_t* kmc_handles;
+static uint32_t kmc_generation; // Bumped at init and shutdown, handles of an earlier generation are gone
+static pthread_mutex_t kmc_lock = PTHREAD_MUTEX_INITIALIZER; // Guards the handle list and endpoint health
+// Operation of a caller waiting in a batch
+typedef struct {
+    const char* path; // Request URI without the root
+    const uint8_t* payload;
+    size_t payload_len;
+    memory_write* chunk_write; // Receives the operation's own response
+    uint8_t answered; // Response delivered by the batch
+    uint8_t done;
+} kmc_batch_op_t;
+// Operations gathered for one key reference
+typedef struct {
+    char key_ref[REF_SIZE];
+    kmc_batch_op_t* ops[KMC_CRYPTO_BATCH_MAX];
+    uint8_t count;
+    uint8_t gathering;
+} kmc_batch_t;
+static kmc_batch_t kmc_batches[KMC_CRYPTO_BATCH_SLOTS];
+static pthread_mutex_t kmc_batch_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t kmc_batch_cond = PTHREAD_COND_INITIALIZER; // Batch filled or answered
 //static const char* status_endpoint = "/status";
 static const char* encrypt_endpoint = "encrypt?keyRef=%s&transformation=%s&iv=%s";
 static const char* encrypt_endpoint_null_iv = "encrypt?keyRef=%s&transformation=%s";
@@ -128,6 +189,8 @@ static const char* decrypt_endpoint = "decrypt?metadata=keyLength:%s,keyRef:%s,c
 static const char* decrypt_offset_endpoint = "decrypt?metadata=keyLength:%s,keyRef:%s,cipherTransformation:%s,initialVector:%s,cryptoAlgorithm:%s,macLength:%s,metadataType:EncryptionMetadata,encryptOffset:%s";
 static const char* icv_create_endpoint = "icv-create?keyRef=%s";
 static const char* icv_verify_endpoint = "icv-verify?metadata=integrityCheckValue:%s,keyRef:%s,cryptoAlgorithm:%s,macLength:%s,metadataType:IntegrityCheckMetadata";
+// Not part of the KMC crypto service API, batching needs a service extension answering it (see kmc_batch_send)
+static const char* batch_endpoint = "batch?keyRef=%s";
 
 // CAM Security Endpoints
 static const char* cam_kerberos_uri = "%s/cam-api/ssoToken?loginMethod=kerberos";
@@ -173,23 +236,21 @@ static int32_t cryptography_config(void)
 
     if(curl)
     {
-        //Determine length of port and convert to string for use in URL
-        uint32_t port_str_len = 0;
-        char* port_str = int_to_str(cryptography_kmc_crypto_config->kmc_crypto_port, &port_str_len);
-
-        // Form Root URI
-        //len(protocol)+len(://)+len(hostname)+ len(:) + len(port_str) + len(/) + len(app_uri) + strlen('\0')
-        uint32_t len_root_uri = strlen(cryptography_kmc_crypto_config->protocol) + 3 + // "://"
-                            strlen(cryptography_kmc_crypto_config->kmc_crypto_hostname) + 1 + // ":"
-                            port_str_len + 1 + // "/"
-                            strlen(cryptography_kmc_crypto_config->kmc_crypto_app_uri) + 2; // "/\0"
-
-        kmc_root_uri = malloc(len_root_uri);
-        snprintf(kmc_root_uri,len_root_uri,"%s://%s:%s/%s/",cryptography_kmc_crypto_config->protocol,
-                 cryptography_kmc_crypto_config->kmc_crypto_hostname, port_str,
-                 cryptography_kmc_crypto_config->kmc_crypto_app_uri);
-
-        free(port_str);
+        // Form Root URI of the primary and of every further endpoint
+        kmc_root_uri = kmc_endpoint_root_uri(cryptography_kmc_crypto_config->kmc_crypto_hostname,
+                                             cryptography_kmc_crypto_config->kmc_crypto_port);
+        memset(kmc_endpoints, 0, sizeof(kmc_endpoints));
+        kmc_endpoints[0].root_uri = kmc_root_uri;
+        kmc_endpoints[0].port = cryptography_kmc_crypto_config->kmc_crypto_port;
+        kmc_endpoint_count = 1;
+        for (uint8_t i = 0; i < cryptography_kmc_crypto_config->kmc_crypto_endpoint_count; i++)
+        {
+            kmc_endpoints[kmc_endpoint_count].root_uri =
+                kmc_endpoint_root_uri(cryptography_kmc_crypto_config->kmc_crypto_endpoint_hostname[i],
+                                      cryptography_kmc_crypto_config->kmc_crypto_endpoint_port[i]);
+            kmc_endpoints[kmc_endpoint_count].port = cryptography_kmc_crypto_config->kmc_crypto_endpoint_port[i];
+            kmc_endpoint_count++;
+        }
         //KMC Crypto Service status check is impossible in certain CAM configs, commenting it out.
         // Also, when this library is started up (EG by SDLS service), there's no guarantee the Crypto Service is available at config time.
         //char* status_uri = (char*) malloc(strlen(kmc_root_uri)+strlen(status_endpoint) + 1);
@@ -199,6 +260,7 @@ static int32_t cryptography_config(void)
 #ifdef DEBUG
         printf("Setting up cURL connection to KMC Crypto Service with Params:\n");
         printf("\tKMC Root URI: %s\n",kmc_root_uri);
+        printf("\tKMC Endpoints: %d\n",kmc_endpoint_count);
         //printf("\tKMC Status URL: %s\n",status_uri);
         //printf("\tPort: %d\n",cryptography_kmc_crypto_config->kmc_crypto_port);
         printf("\tSSL Client Cert: %s\n",cryptography_kmc_crypto_config->mtls_client_cert_path);
@@ -250,7 +312,6 @@ static int32_t cryptography_config(void)
 static int32_t cryptography_init(void)
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
-    curl = curl_easy_init();
     curl_global_init(CURL_GLOBAL_ALL);
     http_headers_list = NULL;
     // Prepare HTTP headers list
@@ -259,24 +320,49 @@ static int32_t cryptography_init(void)
     // curl_slist_append(http_headers_list, "Content-Type: application/json");
     // http_headers_list = curl_slist_append(http_headers_list, "charset: utf-8");
 
-    if(curl == NULL) {
-        status = CRYPTOGRAPHY_KMC_CURL_INITIALIZATION_FAILURE;
-    }
+    pthread_mutex_lock(&kmc_lock);
+    __atomic_add_fetch(&kmc_generation, 1, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&kmc_lock);
+    status = kmc_thread_handles();
     kmc_root_uri = NULL;
+    memset(kmc_endpoints, 0, sizeof(kmc_endpoints));
+    kmc_endpoint_count = 0;
     return status;
 }
 static int32_t cryptography_shutdown(void)
 {
-   if(curl){
-       curl_easy_cleanup(curl);
+   kmc_thread_handles_t* handles;
+   pthread_mutex_lock(&kmc_lock);
+   handles = kmc_handles;
+   kmc_handles = NULL;
+   __atomic_add_fetch(&kmc_generation, 1, __ATOMIC_RELEASE);
+   pthread_mutex_unlock(&kmc_lock);
+   if(handles != NULL){
+       while(handles != NULL){
+           kmc_thread_handles_t* next = handles->next;
+           curl_multi_cleanup(handles->multi);
+           curl_easy_cleanup(handles->curl);
+           free(handles);
+           handles = next;
+       }
        curl_global_cleanup();
    }
+   curl = NULL;
+   kmc_multi = NULL;
    if(http_headers_list != NULL){
        curl_slist_free_all(http_headers_list);
    }
-    if(kmc_root_uri != NULL){
+    // The primary's root is kmc_root_uri
+    for (uint8_t i = 0; i < kmc_endpoint_count; i++)
+    {
+        free(kmc_endpoints[i].root_uri);
+        kmc_endpoints[i].root_uri = NULL;
+    }
+    if(kmc_endpoint_count == 0 && kmc_root_uri != NULL){
         free(kmc_root_uri);
     }
+    kmc_root_uri = NULL;
+    kmc_endpoint_count = 0;
     return CRYPTO_LIB_SUCCESS;
 }
 
@@ -303,6 +389,11 @@ static int32_t cryptography_encrypt(uint8_t* data_out, size_t len_data_out,
     printf("PADLENGTH FIELD: 0x%02x\n", *(data_in - sa_ptr->shplf_len));
     #endif
 
+    status = kmc_thread_handles();
+    if(status != CRYPTO_LIB_SUCCESS)
+    {
+        return status;
+    }
     curl_easy_reset(curl);
     status = configure_curl_connect_opts(curl, cam_cookies);
     if(status != CRYPTO_LIB_SUCCESS)
@@ -310,7 +401,7 @@ static int32_t cryptography_encrypt(uint8_t* data_out, size_t len_data_out,
         return status;
     }
     // Base64 URL encode IV for KMC REST Encrypt
-    char* iv_base64 = (char*)calloc(1,B64ENCODE_OUT_SAFESIZE(iv_len)+1);
+    char* iv_base64 = (char*)Crypto_Arena_Alloc(B64ENCODE_OUT_SAFESIZE(iv_len)+1);
     if(iv != NULL) base64urlEncode(iv,iv_len,iv_base64,NULL);
 
     uint8_t* encrypt_payload = data_in;
@@ -329,7 +420,7 @@ static int32_t cryptography_encrypt(uint8_t* data_out, size_t len_data_out,
     char* encrypt_uri;
     
     int len_encrypt_endpoint = strlen(encrypt_endpoint)+strlen(sa_ptr->ek_ref)+strlen(iv_base64)+strlen(AES_CBC_TRANSFORMATION);
-    char* encrypt_endpoint_final = (char*) malloc(len_encrypt_endpoint);
+    char* encrypt_endpoint_final = (char*) Crypto_Arena_Alloc(len_encrypt_endpoint);
     if(iv == NULL){
         snprintf(encrypt_endpoint_final,len_encrypt_endpoint,encrypt_endpoint_null_iv,sa_ptr->ek_ref,AES_CBC_TRANSFORMATION); 
     }
@@ -337,7 +428,7 @@ static int32_t cryptography_encrypt(uint8_t* data_out, size_t len_data_out,
         snprintf(encrypt_endpoint_final,len_encrypt_endpoint,encrypt_endpoint,sa_ptr->ek_ref,AES_CBC_TRANSFORMATION, iv_base64);
     }
 
-    encrypt_uri = (char*) malloc(strlen(kmc_root_uri)+len_encrypt_endpoint);
+    encrypt_uri = (char*) Crypto_Arena_Alloc(strlen(kmc_root_uri)+len_encrypt_endpoint);
     encrypt_uri[0] = '\0';
     strcat(encrypt_uri, kmc_root_uri);
     strcat(encrypt_uri, encrypt_endpoint_final);
@@ -375,7 +466,7 @@ static int32_t cryptography_encrypt(uint8_t* data_out, size_t len_data_out,
     printf("\n");
 #endif
 
-    status = curl_perform_with_cam_retries(curl, chunk_write, chunk_read);
+    status = kmc_batch_perform(curl, encrypt_uri, encrypt_payload, encrypt_payload_len, chunk_write, chunk_read);
     if(status != CRYPTO_LIB_SUCCESS)
     {
         return status;
@@ -547,6 +638,11 @@ static int32_t cryptography_decrypt(uint8_t* data_out, size_t len_data_out,
     uint32_t key_len_in_bits_str_len = 0;
     char* key_len_in_bits_str = int_to_str(key_len_in_bits, &key_len_in_bits);
 
+    status = kmc_thread_handles();
+    if(status != CRYPTO_LIB_SUCCESS)
+    {
+        return status;
+    }
     curl_easy_reset(curl);
     status = configure_curl_connect_opts(curl, cam_cookies);
     if(status != CRYPTO_LIB_SUCCESS)
@@ -554,7 +650,7 @@ static int32_t cryptography_decrypt(uint8_t* data_out, size_t len_data_out,
         return status;
     }
     // Base64 URL encode IV for KMC REST Encrypt
-    char* iv_base64 = (char*)calloc(1,B64ENCODE_OUT_SAFESIZE(iv_len)+1);
+    char* iv_base64 = (char*)Crypto_Arena_Alloc(B64ENCODE_OUT_SAFESIZE(iv_len)+1);
     base64urlEncode(iv,iv_len,iv_base64,NULL);
 
     uint8_t* decrypt_payload = data_in;
@@ -574,11 +670,11 @@ static int32_t cryptography_decrypt(uint8_t* data_out, size_t len_data_out,
     char* decrypt_uri;
     
     int len_decrypt_endpoint = strlen(decrypt_endpoint)+ key_len_in_bits_str_len + strlen(sa_ptr->ek_ref)+strlen(iv_base64)+strlen(AES_CBC_TRANSFORMATION) + strlen(AES_CRYPTO_ALGORITHM);
-    char* decrypt_endpoint_final = (char*) malloc(len_decrypt_endpoint);
+    char* decrypt_endpoint_final = (char*) Crypto_Arena_Alloc(len_decrypt_endpoint);
 
     snprintf(decrypt_endpoint_final,len_decrypt_endpoint,decrypt_endpoint,key_len_in_bits_str,sa_ptr->ek_ref,AES_CBC_TRANSFORMATION, iv_base64, AES_CRYPTO_ALGORITHM);
     free(key_len_in_bits_str);
-    decrypt_uri = (char*) malloc(strlen(kmc_root_uri)+len_decrypt_endpoint);
+    decrypt_uri = (char*) Crypto_Arena_Alloc(strlen(kmc_root_uri)+len_decrypt_endpoint);
     decrypt_uri[0] = '\0';
     strcat(decrypt_uri, kmc_root_uri);
     strcat(decrypt_uri, decrypt_endpoint_final);
@@ -617,7 +713,7 @@ static int32_t cryptography_decrypt(uint8_t* data_out, size_t len_data_out,
     printf("\n");
 #endif
 
-    status = curl_perform_with_cam_retries(curl, chunk_write, chunk_read);
+    status = kmc_batch_perform(curl, decrypt_uri, decrypt_payload, decrypt_payload_len, chunk_write, chunk_read);
     if(status != CRYPTO_LIB_SUCCESS)
     {
         return status;
@@ -733,6 +829,11 @@ static int32_t cryptography_authenticate(uint8_t* data_out, size_t len_data_out,
     iv_len = iv_len;
     ecs = ecs;
     
+    status = kmc_thread_handles();
+    if(status != CRYPTO_LIB_SUCCESS)
+    {
+        return status;
+    }
     curl_easy_reset(curl);
     status = configure_curl_connect_opts(curl, cam_cookies);
     if(status != CRYPTO_LIB_SUCCESS)
@@ -770,10 +871,10 @@ static int32_t cryptography_authenticate(uint8_t* data_out, size_t len_data_out,
 
     // Prepare the Authentication Endpoint URI for KMC Crypto Service
     int len_auth_endpoint = strlen(icv_create_endpoint)+strlen(sa_ptr->ak_ref);
-    char* auth_endpoint_final = (char*) malloc(len_auth_endpoint);
+    char* auth_endpoint_final = (char*) Crypto_Arena_Alloc(len_auth_endpoint);
     snprintf(auth_endpoint_final,len_auth_endpoint,icv_create_endpoint,sa_ptr->ak_ref);
 
-    char* auth_uri = (char*) malloc(strlen(kmc_root_uri)+len_auth_endpoint);
+    char* auth_uri = (char*) Crypto_Arena_Alloc(strlen(kmc_root_uri)+len_auth_endpoint);
     auth_uri[0] = '\0';
     strcat(auth_uri, kmc_root_uri);
     strcat(auth_uri, auth_endpoint_final);
@@ -812,7 +913,7 @@ static int32_t cryptography_authenticate(uint8_t* data_out, size_t len_data_out,
     printf("\n");
 #endif
 
-    status = curl_perform_with_cam_retries(curl, chunk_write, chunk_read);
+    status = kmc_batch_perform(curl, auth_uri, auth_payload, auth_payload_len, chunk_write, chunk_read);
     if(status != CRYPTO_LIB_SUCCESS)
     {
         return status;
@@ -977,6 +1078,11 @@ static int32_t cryptography_validate_authentication(uint8_t* data_out, size_t le
         return CRYPTO_LIB_ERR_NULL_BUFFER;
     }
 
+    status = kmc_thread_handles();
+    if(status != CRYPTO_LIB_SUCCESS)
+    {
+        return status;
+    }
     curl_easy_reset(curl);
     status = configure_curl_connect_opts(curl, cam_cookies);
     if(status != CRYPTO_LIB_SUCCESS)
@@ -987,7 +1093,7 @@ static int32_t cryptography_validate_authentication(uint8_t* data_out, size_t le
     size_t auth_payload_len = aad_len;
 
     // Base64 URL encode MAC for KMC REST Encrypt
-    char* mac_base64 = (char*)calloc(1,B64ENCODE_OUT_SAFESIZE(mac_size) + 1);
+    char* mac_base64 = (char*)Crypto_Arena_Alloc(B64ENCODE_OUT_SAFESIZE(mac_size) + 1);
     base64urlEncode(mac,mac_size,mac_base64,NULL);
 #ifdef DEBUG
     printf("MAC Base64 URL Encoded: %s\n",mac_base64);
@@ -1009,10 +1115,10 @@ static int32_t cryptography_validate_authentication(uint8_t* data_out, size_t le
 
     // Prepare the Authentication Endpoint URI for KMC Crypto Service
     int len_auth_endpoint = strlen(icv_verify_endpoint)+strlen(mac_base64)+strlen(sa_ptr->ak_ref)+strlen(auth_algorithm)+mac_size_str_len;
-    char* auth_endpoint_final = (char*) malloc(len_auth_endpoint);
+    char* auth_endpoint_final = (char*) Crypto_Arena_Alloc(len_auth_endpoint);
     snprintf(auth_endpoint_final,len_auth_endpoint,icv_verify_endpoint,mac_base64,sa_ptr->ak_ref,auth_algorithm,mac_size_str);
     free(mac_size_str);
-    char* auth_uri = (char*) malloc(strlen(kmc_root_uri)+len_auth_endpoint);
+    char* auth_uri = (char*) Crypto_Arena_Alloc(strlen(kmc_root_uri)+len_auth_endpoint);
     auth_uri[0] = '\0';
     strcat(auth_uri, kmc_root_uri);
     strcat(auth_uri, auth_endpoint_final);
@@ -1052,7 +1158,7 @@ static int32_t cryptography_validate_authentication(uint8_t* data_out, size_t le
     printf("\n");
 #endif
 
-    status = curl_perform_with_cam_retries(curl, chunk_write, chunk_read);
+    status = kmc_batch_perform(curl, auth_uri, auth_payload, auth_payload_len, chunk_write, chunk_read);
     if(status != CRYPTO_LIB_SUCCESS)
     {
         return status;
@@ -1153,6 +1259,11 @@ static int32_t cryptography_aead_encrypt(uint8_t* data_out, size_t len_data_out,
     ecs = ecs;
     acs = acs;
 
+    status = kmc_thread_handles();
+    if(status != CRYPTO_LIB_SUCCESS)
+    {
+        return status;
+    }
     curl_easy_reset(curl);
     status = configure_curl_connect_opts(curl, cam_cookies);
     if(status != CRYPTO_LIB_SUCCESS)
@@ -1160,7 +1271,7 @@ static int32_t cryptography_aead_encrypt(uint8_t* data_out, size_t len_data_out,
         return status;
     }
     // Base64 URL encode IV for KMC REST Encrypt
-    char* iv_base64 = (char*)calloc(1,B64ENCODE_OUT_SAFESIZE(iv_len)+1);
+    char* iv_base64 = (char*)Crypto_Arena_Alloc(B64ENCODE_OUT_SAFESIZE(iv_len)+1);
     if(iv != NULL)
     {
         base64urlEncode(iv,iv_len,iv_base64,NULL);
@@ -1180,7 +1291,6 @@ static int32_t cryptography_aead_encrypt(uint8_t* data_out, size_t len_data_out,
     if(sa_ptr->ek_ref[0] == '\0')
     {
         status = CRYPTOGRAHPY_KMC_NULL_ENCRYPTION_KEY_REFERENCE_IN_SA;
-        free(iv_base64);
         return status;
     }
 
@@ -1199,7 +1309,7 @@ static int32_t cryptography_aead_encrypt(uint8_t* data_out, size_t len_data_out,
         char* mac_size_str = int_to_str(mac_size*8, &mac_size_str_len);
         
         int len_encrypt_endpoint = strlen(encrypt_offset_endpoint)+strlen(sa_ptr->ek_ref)+strlen(iv_base64)+strlen(AES_GCM_TRANSFORMATION)+aad_offset_str_len + mac_size_str_len;
-        char* encrypt_endpoint_final = (char*) malloc(len_encrypt_endpoint);
+        char* encrypt_endpoint_final = (char*) Crypto_Arena_Alloc(len_encrypt_endpoint);
         if(iv != NULL)
         {
                                    
@@ -1217,7 +1327,7 @@ static int32_t cryptography_aead_encrypt(uint8_t* data_out, size_t len_data_out,
 #ifdef DEBUG
         printf("KMC ROOT URI: %s\n",kmc_root_uri);
 #endif
-        encrypt_uri = (char*) malloc(strlen(kmc_root_uri)+len_encrypt_endpoint);
+        encrypt_uri = (char*) Crypto_Arena_Alloc(strlen(kmc_root_uri)+len_encrypt_endpoint);
         encrypt_uri[0] = '\0';
         strcat(encrypt_uri, kmc_root_uri);
         strcat(encrypt_uri, encrypt_endpoint_final);
@@ -1241,12 +1351,11 @@ static int32_t cryptography_aead_encrypt(uint8_t* data_out, size_t len_data_out,
         {
             memcpy(&encrypt_payload[aad_len],data_in,len_data_in);
         }
-        free(encrypt_endpoint_final); 
     }
     else //No AAD -- just prepare the endpoint URI
     {
         int len_encrypt_endpoint = strlen(encrypt_endpoint)+strlen(sa_ptr->ek_ref)+strlen(iv_base64)+strlen(AES_GCM_TRANSFORMATION);
-        char* encrypt_endpoint_final = (char*) malloc(len_encrypt_endpoint);
+        char* encrypt_endpoint_final = (char*) Crypto_Arena_Alloc(len_encrypt_endpoint);
         if(iv != NULL)
         {
             snprintf(encrypt_endpoint_final,len_encrypt_endpoint,encrypt_endpoint,sa_ptr->ek_ref,AES_GCM_TRANSFORMATION, iv_base64);
@@ -1257,11 +1366,10 @@ static int32_t cryptography_aead_encrypt(uint8_t* data_out, size_t len_data_out,
         }
         
 
-        encrypt_uri = (char*) malloc(strlen(kmc_root_uri)+len_encrypt_endpoint);
+        encrypt_uri = (char*) Crypto_Arena_Alloc(strlen(kmc_root_uri)+len_encrypt_endpoint);
         encrypt_uri[0] = '\0';
         strcat(encrypt_uri, kmc_root_uri);
         strcat(encrypt_uri, encrypt_endpoint_final);
-        free(encrypt_endpoint_final);
     }
 
 #ifdef DEBUG
@@ -1297,7 +1405,7 @@ static int32_t cryptography_aead_encrypt(uint8_t* data_out, size_t len_data_out,
     printf("\n");
 #endif
 
-    status = curl_perform_with_cam_retries(curl,chunk_write,chunk_read);
+    status = kmc_batch_perform(curl, encrypt_uri, encrypt_payload, encrypt_payload_len, chunk_write, chunk_read);
 #ifdef DEBUG
     printf("Curl Perform Final Status Code: %d\n",status);
     if(chunk_write->response != NULL)
@@ -1308,8 +1416,6 @@ static int32_t cryptography_aead_encrypt(uint8_t* data_out, size_t len_data_out,
 #endif
     if(status != CRYPTO_LIB_SUCCESS)
     {
-        if(iv_base64 != NULL) free(iv_base64);
-        if(encrypt_uri != NULL) free(encrypt_uri);
         if(chunk_write != NULL) free(chunk_write);
         if(chunk_read != NULL) free(chunk_read);
         if(encrypt_payload != NULL) free(encrypt_payload);
@@ -1328,8 +1434,6 @@ static int32_t cryptography_aead_encrypt(uint8_t* data_out, size_t len_data_out,
     if (parse_result < 0) {
         status = CRYPTOGRAHPY_KMC_CRYPTO_JSON_PARSE_ERROR;
         printf("Failed to parse JSON: %d\n", parse_result);
-        if(iv_base64 != NULL) free(iv_base64);
-        if(encrypt_uri != NULL) free(encrypt_uri);
         if(chunk_write != NULL) free(chunk_write);
         if(chunk_read != NULL) free(chunk_read);
         if(encrypt_payload != NULL) free(encrypt_payload);
@@ -1435,8 +1539,6 @@ static int32_t cryptography_aead_encrypt(uint8_t* data_out, size_t len_data_out,
             {
                 status = CRYPTOGRAHPY_KMC_CRYPTO_SERVICE_GENERIC_FAILURE;
                 fprintf(stderr,"KMC Crypto Failure Response:\n%s\n",chunk_write->response);
-                if(iv_base64 != NULL) free(iv_base64);
-                if(encrypt_uri != NULL) free(encrypt_uri);
                 if(chunk_write != NULL) free(chunk_write);
                 if(chunk_read != NULL) free(chunk_read);
                 if(encrypt_payload != NULL) free(encrypt_payload);
@@ -1452,8 +1554,6 @@ static int32_t cryptography_aead_encrypt(uint8_t* data_out, size_t len_data_out,
     }
     if(ciphertext_found == CRYPTO_FALSE){
         status = CRYPTOGRAHPY_KMC_CIPHER_TEXT_NOT_FOUND_IN_JSON_RESPONSE;
-        if(encrypt_uri != NULL) free(encrypt_uri);
-        if(iv_base64 != NULL) free(iv_base64);
         if(ciphertext_base64 != NULL) free(ciphertext_base64);
         if(chunk_write != NULL) free(chunk_write);
         if(chunk_read != NULL) free(chunk_read);
@@ -1493,8 +1593,6 @@ static int32_t cryptography_aead_encrypt(uint8_t* data_out, size_t len_data_out,
     }
     if (ciphertext_base64 != NULL) free(ciphertext_base64);
     if (ciphertext_decoded != NULL) free(ciphertext_decoded);
-    if (iv_base64 != NULL) free(iv_base64);
-    if (encrypt_uri != NULL) free(encrypt_uri);
     //if (encrypt_payload != NULL) free(encrypt_payload);
     if (chunk_write->response != NULL) free(chunk_write->response);
     if (chunk_write != NULL) free(chunk_write);
@@ -1534,6 +1632,11 @@ static int32_t cryptography_aead_decrypt(uint8_t* data_out, size_t len_data_out,
 
 
 
+    status = kmc_thread_handles();
+    if(status != CRYPTO_LIB_SUCCESS)
+    {
+        return status;
+    }
     curl_easy_reset(curl);
     status = configure_curl_connect_opts(curl, cam_cookies);
     if(status != CRYPTO_LIB_SUCCESS)
@@ -1542,7 +1645,7 @@ static int32_t cryptography_aead_decrypt(uint8_t* data_out, size_t len_data_out,
     }
 
     // Base64 URL encode IV for KMC REST Encrypt
-    char* iv_base64 = (char*)calloc(1,B64ENCODE_OUT_SAFESIZE(iv_len)+1);
+    char* iv_base64 = (char*)Crypto_Arena_Alloc(B64ENCODE_OUT_SAFESIZE(iv_len)+1);
     base64urlEncode(iv,iv_len,iv_base64,NULL);
 
     uint8_t* decrypt_payload = data_in;
@@ -1573,7 +1676,7 @@ static int32_t cryptography_aead_decrypt(uint8_t* data_out, size_t len_data_out,
         char* mac_size_str = int_to_str(mac_size*8, &mac_size_str_len);
 
         int len_decrypt_endpoint = strlen(decrypt_offset_endpoint)+ key_len_in_bits_str_len + strlen(sa_ptr->ek_ref)+strlen(iv_base64)+strlen(AES_GCM_TRANSFORMATION) + strlen(AES_CRYPTO_ALGORITHM) + mac_size_str_len + aad_offset_str_len;
-        char* decrypt_endpoint_final = (char*) malloc(len_decrypt_endpoint);
+        char* decrypt_endpoint_final = (char*) Crypto_Arena_Alloc(len_decrypt_endpoint);
 
         snprintf(decrypt_endpoint_final,len_decrypt_endpoint,decrypt_offset_endpoint,key_len_in_bits_str,sa_ptr->ek_ref,AES_GCM_TRANSFORMATION, iv_base64, AES_CRYPTO_ALGORITHM, mac_size_str, aad_offset_str);
 
@@ -1581,7 +1684,7 @@ static int32_t cryptography_aead_decrypt(uint8_t* data_out, size_t len_data_out,
         free(aad_offset_str);
         free(mac_size_str);
 
-        decrypt_uri = (char*) malloc(strlen(kmc_root_uri)+len_decrypt_endpoint);
+        decrypt_uri = (char*) Crypto_Arena_Alloc(strlen(kmc_root_uri)+len_decrypt_endpoint);
         decrypt_uri[0] = '\0';
         strcat(decrypt_uri, kmc_root_uri);
         strcat(decrypt_uri, decrypt_endpoint_final);
@@ -1611,20 +1714,18 @@ static int32_t cryptography_aead_decrypt(uint8_t* data_out, size_t len_data_out,
             memcpy(&decrypt_payload[aad_len + data_offset],mac,mac_size);
         }
 
-        free(decrypt_endpoint_final);
     }
     else //No AAD - just prepare the endpoint URI string
     {
         int len_decrypt_endpoint = strlen(decrypt_endpoint)+ key_len_in_bits_str_len + strlen(sa_ptr->ek_ref)+strlen(iv_base64)+strlen(AES_GCM_TRANSFORMATION) + strlen(AES_CRYPTO_ALGORITHM);
-        char* decrypt_endpoint_final = (char*) malloc(len_decrypt_endpoint);
+        char* decrypt_endpoint_final = (char*) Crypto_Arena_Alloc(len_decrypt_endpoint);
 
         snprintf(decrypt_endpoint_final,len_decrypt_endpoint,decrypt_endpoint,key_len_in_bits_str,sa_ptr->ek_ref,AES_GCM_TRANSFORMATION, iv_base64, AES_CRYPTO_ALGORITHM);
 
-        decrypt_uri = (char*) malloc(strlen(kmc_root_uri)+len_decrypt_endpoint);
+        decrypt_uri = (char*) Crypto_Arena_Alloc(strlen(kmc_root_uri)+len_decrypt_endpoint);
         decrypt_uri[0] = '\0';
         strcat(decrypt_uri, kmc_root_uri);
         strcat(decrypt_uri, decrypt_endpoint_final);
-        free(decrypt_endpoint_final);
     }
 #ifdef DEBUG
     printf("Decrypt URI: %s\n",decrypt_uri);
@@ -1660,12 +1761,10 @@ static int32_t cryptography_aead_decrypt(uint8_t* data_out, size_t len_data_out,
     printf("\n");
 #endif
 
-    status = curl_perform_with_cam_retries(curl, chunk_write, chunk_read);
+    status = kmc_batch_perform(curl, decrypt_uri, decrypt_payload, decrypt_payload_len, chunk_write, chunk_read);
     if(status != CRYPTO_LIB_SUCCESS)
     {
         //free(decrypt_payload);
-        free(decrypt_uri);
-        free(iv_base64);
         return status;
     }
 
@@ -1682,8 +1781,6 @@ static int32_t cryptography_aead_decrypt(uint8_t* data_out, size_t len_data_out,
         status = CRYPTOGRAHPY_KMC_CRYPTO_JSON_PARSE_ERROR;
         printf("Failed to parse JSON: %d\n", parse_result);
         free(decrypt_payload);
-        free(decrypt_uri);
-        free(iv_base64);
         return status;
     }
 
@@ -1734,8 +1831,6 @@ static int32_t cryptography_aead_decrypt(uint8_t* data_out, size_t len_data_out,
                 free(chunk_write);
                 free(http_code_str);
                 free(cleartext_base64);
-                free(decrypt_uri);
-                free(iv_base64);
                 return status;
             }
             free(http_code_str);
@@ -1749,8 +1844,6 @@ static int32_t cryptography_aead_decrypt(uint8_t* data_out, size_t len_data_out,
         free(chunk_write); 
         free(cleartext_base64); 
         free(decrypt_payload);
-        free(decrypt_uri);
-        free(iv_base64);
         return status;
     }
 
@@ -1781,8 +1874,6 @@ static int32_t cryptography_aead_decrypt(uint8_t* data_out, size_t len_data_out,
     free(chunk_write);
     free(cleartext_base64);
     free(decrypt_payload);
-    free(decrypt_uri);
-    free(iv_base64);
     return status;
 }
 
@@ -2137,7 +2228,807 @@ int32_t curl_response_error_check(CURL* curl_handle, char* response)
 
 }
 
-int32_t curl_perform_with_cam_retries(CURL* curl_handle,memory_write* chunk_write, memory_read* chunk_read)
+/**
+ * @brief Function: kmc_thread_handles
+ * Creates the calling thread's cURL handles on its first request after init
+ * @return int32: Success/Failure
+ **/
+static int32_t kmc_thread_handles(void)
+{
+    kmc_thread_handles_t* handles;
+
+    if (curl != NULL && kmc_thread_generation == __atomic_load_n(&kmc_generation, __ATOMIC_ACQUIRE))
+    {
+        return CRYPTO_LIB_SUCCESS;
+    }
+    handles = (kmc_thread_handles_t*)calloc(1, sizeof(kmc_thread_handles_t));
+    if (handles == NULL)
+    {
+        return CRYPTOGRAPHY_KMC_CURL_INITIALIZATION_FAILURE;
+    }
+    handles->curl = curl_easy_init();
+    handles->multi = curl_multi_init();
+    if (handles->curl == NULL || handles->multi == NULL)
+    {
+        if (handles->multi != NULL)
+        {
+            curl_multi_cleanup(handles->multi);
+        }
+        if (handles->curl != NULL)
+        {
+            curl_easy_cleanup(handles->curl);
+        }
+        free(handles);
+        return CRYPTOGRAPHY_KMC_CURL_INITIALIZATION_FAILURE;
+    }
+
+    pthread_mutex_lock(&kmc_lock);
+    handles->next = kmc_handles;
+    kmc_handles = handles;
+    kmc_thread_generation = kmc_generation;
+    pthread_mutex_unlock(&kmc_lock);
+    curl = handles->curl;
+    kmc_multi = handles->multi;
+    return CRYPTO_LIB_SUCCESS;
+}
+
+/**
+ * @brief Function: kmc_now_ms
+ * Monotonic clock used for endpoint latencies and circuit breaker timeouts
+ * @return uint64: Milliseconds
+ **/
+static uint64_t kmc_now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000) + ((uint64_t)ts.tv_nsec / 1000000);
+}
+
+/**
+ * @brief Function: kmc_endpoint_root_uri
+ * Forms the root URI of an endpoint from the configured protocol and app URI
+ * @param hostname: const char*
+ * @param port: uint16_t
+ * @return char*: Root URI, freed by the caller
+ **/
+static char* kmc_endpoint_root_uri(const char* hostname, uint16_t port)
+{
+    //Determine length of port and convert to string for use in URL
+    uint32_t port_str_len = 0;
+    char* port_str = int_to_str(port, &port_str_len);
+
+    //len(protocol)+len(://)+len(hostname)+ len(:) + len(port_str) + len(/) + len(app_uri) + strlen('\0')
+    uint32_t len_root_uri = strlen(cryptography_kmc_crypto_config->protocol) + 3 + // "://"
+                            strlen(hostname) + 1 + // ":"
+                            port_str_len + 1 + // "/"
+                            strlen(cryptography_kmc_crypto_config->kmc_crypto_app_uri) + 2; // "/\0"
+
+    char* root_uri = malloc(len_root_uri);
+    snprintf(root_uri, len_root_uri, "%s://%s:%s/%s/", cryptography_kmc_crypto_config->protocol, hostname, port_str,
+             cryptography_kmc_crypto_config->kmc_crypto_app_uri);
+
+    free(port_str);
+    return root_uri;
+}
+
+/**
+ * @brief Function: kmc_endpoint_select
+ * Picks the fastest endpoint with a closed circuit that was not tried yet for this request.
+ * Endpoints without samples go first so every endpoint gets measured. When every remaining
+ * circuit is open, the one that opened first is given a trial request.
+ * @param tried: uint32_t, bit mask of endpoints already used
+ * @return int: Endpoint index, -1 when none left
+ **/
+static int kmc_endpoint_select(uint32_t tried)
+{
+    uint64_t now = kmc_now_ms();
+    int best = -1;
+    int trial = -1;
+    uint32_t best_score = 0;
+
+    pthread_mutex_lock(&kmc_lock);
+    for (int i = 0; i < kmc_endpoint_count; i++)
+    {
+        kmc_endpoint_t* endpoint = &kmc_endpoints[i];
+        if (tried & (1u << i))
+        {
+            continue;
+        }
+        if (endpoint->open_until_ms > now)
+        {
+            if (trial < 0 || endpoint->open_until_ms < kmc_endpoints[trial].open_until_ms)
+            {
+                trial = i;
+            }
+            continue;
+        }
+        uint32_t score = (endpoint->samples == 0) ? 0 : endpoint->ewma_ms;
+        if (best < 0 || score < best_score)
+        {
+            best = i;
+            best_score = score;
+        }
+    }
+    pthread_mutex_unlock(&kmc_lock);
+    return (best >= 0) ? best : trial;
+}
+
+/**
+ * @brief Function: kmc_endpoint_set_url
+ * Points a handle at the same request path on another endpoint
+ * @param curl_handle: CURL*
+ * @param endpoint: int
+ * @param path: const char*, request URI without the root
+ **/
+static void kmc_endpoint_set_url(CURL* curl_handle, int endpoint, const char* path)
+{
+    size_t len_url = strlen(kmc_endpoints[endpoint].root_uri) + strlen(path) + 1;
+    char* url = malloc(len_url);
+    snprintf(url, len_url, "%s%s", kmc_endpoints[endpoint].root_uri, path);
+    curl_easy_setopt(curl_handle, CURLOPT_URL, url); // cURL keeps its own copy
+    curl_easy_setopt(curl_handle, CURLOPT_PORT, kmc_endpoints[endpoint].port);
+    free(url);
+}
+
+/**
+ * @brief Function: kmc_endpoint_sample
+ * Adds a latency sample to an endpoint, the average moves by 1/8 of the difference. Called with kmc_lock held.
+ * @param endpoint: int
+ * @param elapsed_ms: uint32_t
+ **/
+static void kmc_endpoint_sample(int endpoint, uint32_t elapsed_ms)
+{
+    kmc_endpoint_t* ep = &kmc_endpoints[endpoint];
+    ep->latency_ms[ep->next_sample] = elapsed_ms;
+    ep->next_sample = (ep->next_sample + 1) % KMC_CRYPTO_LATENCY_SAMPLES;
+    if (ep->samples == 0)
+    {
+        ep->ewma_ms = elapsed_ms;
+    }
+    else
+    {
+        ep->ewma_ms = (uint32_t)((int64_t)ep->ewma_ms + (((int64_t)elapsed_ms - (int64_t)ep->ewma_ms) / 8));
+    }
+    if (ep->samples < KMC_CRYPTO_LATENCY_SAMPLES)
+    {
+        ep->samples++;
+    }
+}
+
+/**
+ * @brief Function: kmc_endpoint_record
+ * Records the outcome of a request. Consecutive failures open the endpoint's circuit, a success closes it.
+ * @param endpoint: int
+ * @param ok: uint8_t
+ * @param elapsed_ms: uint32_t
+ **/
+static void kmc_endpoint_record(int endpoint, uint8_t ok, uint32_t elapsed_ms)
+{
+    kmc_endpoint_t* ep = &kmc_endpoints[endpoint];
+    pthread_mutex_lock(&kmc_lock);
+    if (ok)
+    {
+        ep->failures = 0;
+        ep->open_until_ms = 0;
+        kmc_endpoint_sample(endpoint, elapsed_ms);
+        pthread_mutex_unlock(&kmc_lock);
+        return;
+    }
+    ep->failures++;
+    if (cryptography_kmc_crypto_config->kmc_breaker_threshold != 0 &&
+        ep->failures >= cryptography_kmc_crypto_config->kmc_breaker_threshold)
+    {
+        ep->open_until_ms = kmc_now_ms() + cryptography_kmc_crypto_config->kmc_breaker_open_ms;
+#ifdef DEBUG
+        printf("KMC endpoint %s unavailable for %d ms\n", ep->root_uri, cryptography_kmc_crypto_config->kmc_breaker_open_ms);
+#endif
+    }
+    pthread_mutex_unlock(&kmc_lock);
+}
+
+/**
+ * @brief Function: kmc_endpoint_hedge_delay
+ * Time to wait on an endpoint before hedging the request to a second one
+ * @param endpoint: int
+ * @return uint32: Delay in milliseconds
+ **/
+static uint32_t kmc_endpoint_hedge_delay(int endpoint)
+{
+    kmc_endpoint_t* ep = &kmc_endpoints[endpoint];
+    uint32_t sorted[KMC_CRYPTO_LATENCY_SAMPLES];
+    uint32_t delay;
+
+    if (cryptography_kmc_crypto_config->kmc_hedge_delay_ms != KMC_CRYPTO_HEDGE_P95)
+    {
+        return cryptography_kmc_crypto_config->kmc_hedge_delay_ms;
+    }
+    pthread_mutex_lock(&kmc_lock);
+    if (ep->samples < KMC_CRYPTO_LATENCY_MIN_SAMPLES)
+    {
+        pthread_mutex_unlock(&kmc_lock);
+        return KMC_CRYPTO_HEDGE_DEFAULT_MS;
+    }
+
+    // 95th percentile of the recent latencies
+    for (uint32_t i = 0; i < ep->samples; i++)
+    {
+        uint32_t j = i;
+        while (j > 0 && sorted[j - 1] > ep->latency_ms[i])
+        {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = ep->latency_ms[i];
+    }
+    delay = sorted[(ep->samples * 95) / 100];
+    pthread_mutex_unlock(&kmc_lock);
+    return (delay < KMC_CRYPTO_HEDGE_MIN_MS) ? KMC_CRYPTO_HEDGE_MIN_MS : delay;
+}
+
+/**
+ * @brief Function: kmc_response_ok
+ * A request fails over to another endpoint when the transfer broke or the service answered with a server error
+ * @param res: CURLcode
+ * @param curl_handle: CURL*
+ * @return uint8: 1 when the endpoint answered
+ **/
+static uint8_t kmc_response_ok(CURLcode res, CURL* curl_handle)
+{
+    long response_code = 0;
+    if (res != CURLE_OK)
+    {
+        return 0;
+    }
+    curl_easy_getinfo(curl_handle, CURLINFO_RESPONSE_CODE, &response_code);
+    return (response_code < 500) ? 1 : 0;
+}
+
+/**
+ * @brief Function: kmc_endpoint_hedged_perform
+ * Sends the request to one endpoint and, if it has not answered within the hedge delay, the same request to a
+ * second one. The first usable answer wins, the other transfer is dropped.
+ * @param curl_handle: CURL*
+ * @param path: const char*
+ * @param primary: int, endpoint to send to first
+ * @param tried: uint32_t*, endpoints used are added to the mask
+ * @param chunk_write: memory_write*, receives the winning response
+ * @param response_handle: CURL**, handle that produced the response
+ * @return CURLcode: Result of the winning transfer
+ **/
+static CURLcode kmc_endpoint_hedged_perform(CURL* curl_handle, const char* path, int primary, uint32_t* tried,
+                                            memory_write* chunk_write, CURL** response_handle)
+{
+    memory_write hedge_write = {NULL, 0};
+    CURL* hedge = NULL;
+    CURL* winner = NULL;
+    int hedge_endpoint = -1;
+    uint8_t primary_done = 0;
+    uint8_t hedge_done = 0;
+    CURLcode primary_res = CURLE_OK;
+    CURLcode hedge_res = CURLE_OK;
+    uint64_t start = kmc_now_ms();
+    uint64_t hedge_start = 0;
+    uint64_t hedge_at = start + kmc_endpoint_hedge_delay(primary);
+    uint64_t now;
+    int running = 0;
+    int queued = 0;
+    CURLMsg* msg;
+
+    kmc_endpoint_set_url(curl_handle, primary, path);
+    curl_multi_add_handle(kmc_multi, curl_handle);
+
+    while (winner == NULL)
+    {
+        curl_multi_perform(kmc_multi, &running);
+        while ((msg = curl_multi_info_read(kmc_multi, &queued)) != NULL)
+        {
+            if (msg->msg != CURLMSG_DONE)
+            {
+                continue;
+            }
+            now = kmc_now_ms();
+            if (msg->easy_handle == curl_handle)
+            {
+                primary_done = 1;
+                primary_res = msg->data.result;
+                kmc_endpoint_record(primary, kmc_response_ok(primary_res, curl_handle), (uint32_t)(now - start));
+            }
+            else if (msg->easy_handle == hedge)
+            {
+                hedge_done = 1;
+                hedge_res = msg->data.result;
+                kmc_endpoint_record(hedge_endpoint, kmc_response_ok(hedge_res, hedge), (uint32_t)(now - hedge_start));
+            }
+        }
+
+        if (primary_done && kmc_response_ok(primary_res, curl_handle))
+        {
+            winner = curl_handle;
+        }
+        else if (hedge_done && kmc_response_ok(hedge_res, hedge))
+        {
+            winner = hedge;
+        }
+        else if (primary_done && (hedge == NULL || hedge_done))
+        {
+            break; // Nothing answered, the caller fails over
+        }
+        else
+        {
+            now = kmc_now_ms();
+            if (hedge == NULL && !primary_done && now >= hedge_at)
+            {
+                hedge_endpoint = kmc_endpoint_select(*tried);
+                if (hedge_endpoint >= 0)
+                {
+                    *tried |= 1u << hedge_endpoint;
+                    hedge = curl_easy_duphandle(curl_handle);
+                }
+                if (hedge != NULL)
+                {
+#ifdef DEBUG
+                    printf("Hedging KMC request to %s\n", kmc_endpoints[hedge_endpoint].root_uri);
+#endif
+                    curl_easy_setopt(hedge, CURLOPT_WRITEDATA, &hedge_write);
+                    kmc_endpoint_set_url(hedge, hedge_endpoint, path);
+                    curl_multi_add_handle(kmc_multi, hedge);
+                    hedge_start = now;
+                    continue;
+                }
+                hedge_at = UINT64_MAX; // No endpoint left to hedge to
+            }
+            int wait_ms = 100;
+            if (hedge == NULL && hedge_at > now && (hedge_at - now) < (uint64_t)wait_ms)
+            {
+                wait_ms = (int)(hedge_at - now);
+            }
+            curl_multi_wait(kmc_multi, NULL, 0, wait_ms, NULL);
+        }
+    }
+
+    // The slower transfer still tells how fast its endpoint is at least
+    now = kmc_now_ms();
+    pthread_mutex_lock(&kmc_lock);
+    if (winner != NULL && !primary_done)
+    {
+        kmc_endpoint_sample(primary, (uint32_t)(now - start));
+    }
+    if (winner != NULL && hedge != NULL && !hedge_done)
+    {
+        kmc_endpoint_sample(hedge_endpoint, (uint32_t)(now - hedge_start));
+    }
+    pthread_mutex_unlock(&kmc_lock);
+
+    curl_multi_remove_handle(kmc_multi, curl_handle);
+    if (hedge != NULL)
+    {
+        curl_multi_remove_handle(kmc_multi, hedge);
+    }
+
+    if (winner != NULL && winner == hedge)
+    {
+        free(chunk_write->response);
+        chunk_write->response = hedge_write.response;
+        chunk_write->size = hedge_write.size;
+        *response_handle = hedge;
+        return hedge_res;
+    }
+    free(hedge_write.response);
+    if (hedge != NULL)
+    {
+        curl_easy_cleanup(hedge);
+    }
+    *response_handle = curl_handle;
+    return primary_res;
+}
+
+/**
+ * @brief Function: kmc_endpoint_perform
+ * Performs a request on the healthiest endpoint, failing over to the others when it does not answer
+ * @param curl_handle: CURL*, configured for the request on the primary endpoint
+ * @param uri: const char*, request URI on the primary endpoint
+ * @param chunk_write: memory_write*
+ * @param response_handle: CURL**, handle that produced the response, cleaned up by the caller if not curl_handle
+ * @return CURLcode: Result of the last transfer
+ **/
+static CURLcode kmc_endpoint_perform(CURL* curl_handle, const char* uri, memory_write* chunk_write, CURL** response_handle)
+{
+    CURLcode res = CURLE_COULDNT_CONNECT;
+    const char* path = uri + strlen(kmc_root_uri);
+    uint32_t tried = 0;
+    int endpoint;
+
+    *response_handle = curl_handle;
+    if (kmc_endpoint_count == 0)
+    {
+        return curl_easy_perform(curl_handle);
+    }
+
+    while ((endpoint = kmc_endpoint_select(tried)) >= 0)
+    {
+        tried |= 1u << endpoint;
+        // Drop whatever a failed endpoint answered
+        free(chunk_write->response);
+        chunk_write->response = NULL;
+        chunk_write->size = 0;
+
+        if (cryptography_kmc_crypto_config->kmc_hedge_delay_ms != KMC_CRYPTO_HEDGE_OFF && kmc_endpoint_count > 1)
+        {
+            res = kmc_endpoint_hedged_perform(curl_handle, path, endpoint, &tried, chunk_write, response_handle);
+        }
+        else
+        {
+            uint64_t start = kmc_now_ms();
+            kmc_endpoint_set_url(curl_handle, endpoint, path);
+            res = curl_easy_perform(curl_handle);
+            kmc_endpoint_record(endpoint, kmc_response_ok(res, curl_handle), (uint32_t)(kmc_now_ms() - start));
+        }
+        if (kmc_response_ok(res, *response_handle))
+        {
+            break;
+        }
+#ifdef DEBUG
+        printf("KMC endpoint %s failed, trying next endpoint\n", kmc_endpoints[endpoint].root_uri);
+#endif
+    }
+    return res;
+}
+
+/**
+ * @brief Function: kmc_batch_key_ref
+ * Finds the key reference a request URI operates on, batches gather operations of one key reference
+ * @param path: const char*, request URI without the root
+ * @param key_ref: char*, REF_SIZE bytes
+ * @return uint8: 1 when a key reference was found
+ **/
+static uint8_t kmc_batch_key_ref(const char* path, char* key_ref)
+{
+    const char* start = strstr(path, "keyRef=");
+    size_t len;
+
+    if (start == NULL)
+    {
+        start = strstr(path, "keyRef:");
+    }
+    if (start == NULL)
+    {
+        return 0;
+    }
+    start += strlen("keyRef=");
+    len = strcspn(start, "&,");
+    if (len == 0 || len >= REF_SIZE)
+    {
+        return 0;
+    }
+    memcpy(key_ref, start, len);
+    key_ref[len] = '\0';
+    return 1;
+}
+
+/**
+ * @brief Function: kmc_batch_fan_out
+ * Hands each operation its own response from a batch response of the form
+ * {"results":["<base64 response>",...],"httpCode":200}, results are in request order
+ * @param response: char*
+ * @param ops: kmc_batch_op_t**
+ * @param count: uint8_t
+ * @return int32: Success/Failure
+ **/
+static int32_t kmc_batch_fan_out(char* response, kmc_batch_op_t** ops, uint8_t count)
+{
+    jsmn_parser p;
+    jsmntok_t t[KMC_CRYPTO_BATCH_MAX + 8];
+    int parse_result;
+
+    jsmn_init(&p);
+    parse_result = jsmn_parse(&p, response, strlen(response), t, KMC_CRYPTO_BATCH_MAX + 8);
+    if (parse_result < 0)
+    {
+        printf("Failed to parse JSON: %d\n", parse_result);
+        return CRYPTOGRAHPY_KMC_CRYPTO_JSON_PARSE_ERROR;
+    }
+
+    for (int json_idx = 1; json_idx < parse_result - 1; json_idx++)
+    {
+        if (jsoneq(response, &t[json_idx], "results") != 0 || t[json_idx + 1].type != JSMN_ARRAY)
+        {
+            continue;
+        }
+        if (t[json_idx + 1].size != count || json_idx + 1 + count >= parse_result)
+        {
+            return CRYPTOGRAHPY_KMC_CRYPTO_JSON_PARSE_ERROR;
+        }
+        for (uint8_t i = 0; i < count; i++)
+        {
+            jsmntok_t* result = &t[json_idx + 2 + i];
+            size_t len_result = result->end - result->start;
+            size_t len_decoded = 0;
+            char* decoded = malloc(B64DECODE_OUT_SAFESIZE(len_result) + 1);
+            if (decoded == NULL || result->type != JSMN_STRING ||
+                base64Decode(response + result->start, len_result, decoded, &len_decoded) != NO_ERROR)
+            {
+                free(decoded);
+                return CRYPTOGRAHPY_KMC_CRYPTO_JSON_PARSE_ERROR;
+            }
+            decoded[len_decoded] = '\0';
+            free(ops[i]->chunk_write->response);
+            ops[i]->chunk_write->response = decoded;
+            ops[i]->chunk_write->size = len_decoded;
+            ops[i]->answered = CRYPTO_TRUE;
+        }
+        return CRYPTO_LIB_SUCCESS;
+    }
+    return CRYPTOGRAHPY_KMC_CRYPTO_JSON_PARSE_ERROR;
+}
+
+/**
+ * @brief Function: kmc_batch_endpoints_excluded
+ * Endpoints batches are not sent to, as a bit mask for kmc_endpoint_select
+ * @return uint32: Bit mask of endpoints without the batch endpoint
+ **/
+static uint32_t kmc_batch_endpoints_excluded(void)
+{
+    uint32_t excluded = 0;
+
+    pthread_mutex_lock(&kmc_lock);
+    for (int i = 0; i < kmc_endpoint_count; i++)
+    {
+        if (kmc_endpoints[i].batch_unsupported)
+        {
+            excluded |= 1u << i;
+        }
+    }
+    pthread_mutex_unlock(&kmc_lock);
+    return excluded;
+}
+
+/**
+ * @brief Function: kmc_batch_send
+ * Sends the gathered operations in one request to the batch endpoint, the body is
+ * {"requests":[{"uri":"<request URI without the root>","payload":"<base64 payload>"},...]}
+ * The batch endpoint is an extension the KMC crypto service does not offer by itself. An endpoint answering it
+ * with 404 or 405 is not sent batches again, and its operations go out one by one.  A batch is sent to one
+ * endpoint without failover or hedging, when it is not answered its operations are sent on their own.
+ * @param curl_handle: CURL*, reused for the batch request
+ * @param ops: kmc_batch_op_t**
+ * @param count: uint8_t
+ * @param key_ref: const char*
+ * @return int32: Success/Failure
+ **/
+static int32_t kmc_batch_send(CURL* curl_handle, kmc_batch_op_t** ops, uint8_t count, const char* key_ref)
+{
+    int32_t status;
+    CURLcode res;
+    long response_code = 0;
+    uint64_t start;
+    int endpoint;
+    size_t len_body = strlen("{\"requests\":[]}") + 1;
+    size_t used;
+    size_t len_encoded = 0;
+
+    endpoint = kmc_endpoint_select(kmc_batch_endpoints_excluded());
+    if (endpoint < 0)
+    {
+        return CRYPTOGRAPHY_KMC_CRYPTO_SERVICE_BATCH_UNSUPPORTED;
+    }
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        len_body += strlen(",{\"uri\":\"\",\"payload\":\"\"}") + strlen(ops[i]->path) +
+                    B64ENCODE_OUT_SAFESIZE(ops[i]->payload_len);
+    }
+    char* body = malloc(len_body);
+    int len_batch_path = strlen(batch_endpoint) + strlen(key_ref);
+    char* batch_path = malloc(len_batch_path);
+    memory_write* batch_write = (memory_write*)calloc(1, MEMORY_WRITE_SIZE);
+    if (body == NULL || batch_path == NULL || batch_write == NULL)
+    {
+        free(body);
+        free(batch_path);
+        free(batch_write);
+        return CRYPTO_LIB_ERR_NULL_BUFFER;
+    }
+
+    used = snprintf(body, len_body, "{\"requests\":[");
+    for (uint8_t i = 0; i < count; i++)
+    {
+        used += snprintf(body + used, len_body - used, "%s{\"uri\":\"%s\",\"payload\":\"", (i == 0) ? "" : ",",
+                         ops[i]->path);
+        base64Encode(ops[i]->payload, ops[i]->payload_len, body + used, &len_encoded);
+        used += len_encoded;
+        used += snprintf(body + used, len_body - used, "\"}");
+    }
+    used += snprintf(body + used, len_body - used, "]}");
+
+    snprintf(batch_path, len_batch_path, batch_endpoint, key_ref);
+#ifdef DEBUG
+    printf("Batch URI: %s%s\n", kmc_endpoints[endpoint].root_uri, batch_path);
+    printf("Batch of %d operations: %s\n", count, body);
+#endif
+
+    kmc_endpoint_set_url(curl_handle, endpoint, batch_path);
+    curl_easy_setopt(curl_handle, CURLOPT_WRITEDATA, batch_write);
+    curl_easy_setopt(curl_handle, CURLOPT_POSTFIELDSIZE, (long)used);
+    curl_easy_setopt(curl_handle, CURLOPT_POSTFIELDS, body);
+
+    start = kmc_now_ms();
+    res = curl_easy_perform(curl_handle);
+    kmc_endpoint_record(endpoint, kmc_response_ok(res, curl_handle), (uint32_t)(kmc_now_ms() - start));
+    if (res == CURLE_OK)
+    {
+        curl_easy_getinfo(curl_handle, CURLINFO_RESPONSE_CODE, &response_code);
+    }
+    if (response_code == 404 || response_code == 405)
+    {
+        status = CRYPTOGRAPHY_KMC_CRYPTO_SERVICE_BATCH_UNSUPPORTED;
+        pthread_mutex_lock(&kmc_lock);
+        kmc_endpoints[endpoint].batch_unsupported = CRYPTO_TRUE;
+        pthread_mutex_unlock(&kmc_lock);
+        Crypto_MC_Event(status, MC_EVENT_SPI_NA, NULL, "KMC endpoint %s answered batch with %ld, batching off for it",
+                        kmc_endpoints[endpoint].root_uri, response_code);
+    }
+    else if (res != CURLE_OK)
+    {
+        status = CRYPTOGRAHPY_KMC_CRYPTO_SERVICE_CONNECTION_ERROR;
+    }
+    else
+    {
+        status = curl_response_error_check(curl_handle, batch_write->response);
+    }
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        status = kmc_batch_fan_out(batch_write->response, ops, count);
+    }
+
+    free(batch_write->response);
+    free(batch_write);
+    free(batch_path);
+    free(body);
+    return status;
+}
+
+/**
+ * @brief Function: kmc_batch_perform
+ * Performs a request, batched with concurrent requests on the same key reference when batching is configured.
+ * The first caller gathers operations for up to the batch window, or until the batch is full, and sends them.
+ * If the batch cannot be sent or answered, every operation is sent on its own instead.
+ * @param curl_handle: CURL*, configured for the single request
+ * @param uri: const char*
+ * @param payload: const uint8_t*
+ * @param payload_len: size_t
+ * @param chunk_write: memory_write*
+ * @param chunk_read: memory_read*
+ * @return int32: Success/Failure
+ **/
+static int32_t kmc_batch_perform(CURL* curl_handle, const char* uri, const uint8_t* payload, size_t payload_len,
+                                 memory_write* chunk_write, memory_read* chunk_read)
+{
+    kmc_batch_op_t op;
+    kmc_batch_op_t* ops[KMC_CRYPTO_BATCH_MAX];
+    kmc_batch_t* batch = NULL;
+    char key_ref[REF_SIZE];
+    uint8_t batch_max = cryptography_kmc_crypto_config->kmc_batch_max;
+    uint8_t count;
+    struct timespec deadline;
+    int32_t status;
+
+    // Nothing is gathered once no endpoint takes batches
+    if (batch_max <= KMC_CRYPTO_BATCH_OFF || !kmc_batch_key_ref(uri + strlen(kmc_root_uri), key_ref) ||
+        kmc_batch_endpoints_excluded() == (1u << kmc_endpoint_count) - 1)
+    {
+        return curl_perform_with_cam_retries(curl_handle, uri, chunk_write, chunk_read);
+    }
+
+    memset(&op, 0, sizeof(op));
+    op.path = uri + strlen(kmc_root_uri);
+    op.payload = payload;
+    op.payload_len = payload_len;
+    op.chunk_write = chunk_write;
+
+    pthread_mutex_lock(&kmc_batch_lock);
+    for (int i = 0; i < KMC_CRYPTO_BATCH_SLOTS; i++)
+    {
+        if (kmc_batches[i].gathering && kmc_batches[i].count < batch_max && strcmp(kmc_batches[i].key_ref, key_ref) == 0)
+        {
+            batch = &kmc_batches[i];
+            break;
+        }
+    }
+    if (batch != NULL)
+    {
+        // Join the batch, its sender hands back the response
+        batch->ops[batch->count++] = &op;
+        if (batch->count >= batch_max)
+        {
+            pthread_cond_broadcast(&kmc_batch_cond);
+        }
+        while (!op.done)
+        {
+            pthread_cond_wait(&kmc_batch_cond, &kmc_batch_lock);
+        }
+        pthread_mutex_unlock(&kmc_batch_lock);
+        if (op.answered)
+        {
+            return CRYPTO_LIB_SUCCESS;
+        }
+        return curl_perform_with_cam_retries(curl_handle, uri, chunk_write, chunk_read);
+    }
+
+    for (int i = 0; i < KMC_CRYPTO_BATCH_SLOTS; i++)
+    {
+        if (!kmc_batches[i].gathering)
+        {
+            batch = &kmc_batches[i];
+            break;
+        }
+    }
+    if (batch == NULL) // Every slot gathers for another key reference
+    {
+        pthread_mutex_unlock(&kmc_batch_lock);
+        return curl_perform_with_cam_retries(curl_handle, uri, chunk_write, chunk_read);
+    }
+
+    // Start a batch and gather until it is full or the window closes
+    strcpy(batch->key_ref, key_ref);
+    batch->ops[0] = &op;
+    batch->count = 1;
+    batch->gathering = CRYPTO_TRUE;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += cryptography_kmc_crypto_config->kmc_batch_window_us / 1000000;
+    deadline.tv_nsec += (long)(cryptography_kmc_crypto_config->kmc_batch_window_us % 1000000) * 1000;
+    if (deadline.tv_nsec >= 1000000000)
+    {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+    while (batch->count < batch_max)
+    {
+        if (pthread_cond_timedwait(&kmc_batch_cond, &kmc_batch_lock, &deadline) == ETIMEDOUT)
+        {
+            break;
+        }
+    }
+    count = batch->count;
+    memcpy(ops, batch->ops, count * sizeof(kmc_batch_op_t*));
+    batch->gathering = CRYPTO_FALSE;
+    pthread_mutex_unlock(&kmc_batch_lock);
+
+    if (count == 1)
+    {
+        return curl_perform_with_cam_retries(curl_handle, uri, chunk_write, chunk_read);
+    }
+
+    status = kmc_batch_send(curl_handle, ops, count, key_ref);
+    if (status != CRYPTO_LIB_SUCCESS && status != CRYPTOGRAPHY_KMC_CRYPTO_SERVICE_BATCH_UNSUPPORTED)
+    {
+        Crypto_MC_Event(status, MC_EVENT_SPI_NA, NULL, "KMC batch of %d operations failed, sending them one by one",
+                        count);
+    }
+
+    pthread_mutex_lock(&kmc_batch_lock);
+    for (uint8_t i = 1; i < count; i++)
+    {
+        ops[i]->done = CRYPTO_TRUE;
+    }
+    pthread_cond_broadcast(&kmc_batch_cond);
+    pthread_mutex_unlock(&kmc_batch_lock);
+
+    if (op.answered)
+    {
+        return CRYPTO_LIB_SUCCESS;
+    }
+    // The handle was pointed at the batch, send this operation on its own
+    free(chunk_write->response);
+    chunk_write->response = NULL;
+    chunk_write->size = 0;
+    curl_easy_setopt(curl_handle, CURLOPT_URL, uri);
+    curl_easy_setopt(curl_handle, CURLOPT_WRITEDATA, chunk_write);
+    curl_easy_setopt(curl_handle, CURLOPT_POSTFIELDSIZE, (long)payload_len);
+    curl_easy_setopt(curl_handle, CURLOPT_POSTFIELDS, payload);
+    return curl_perform_with_cam_retries(curl_handle, uri, chunk_write, chunk_read);
+}
+
+int32_t curl_perform_with_cam_retries(CURL* curl_handle, const char* uri, memory_write* chunk_write, memory_read* chunk_read)
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
     uint8_t cam_retry = 0;
@@ -2147,7 +3038,8 @@ int32_t curl_perform_with_cam_retries(CURL* curl_handle,memory_write* chunk_writ
         printf("Entering CAM Authentication Retry Loop, Loop #: %d\n",cam_retry);
 #endif
         CURLcode res;
-        res = curl_easy_perform(curl_handle);
+        CURL* response_handle = curl_handle;
+        res = kmc_endpoint_perform(curl_handle, uri, chunk_write, &response_handle);
 
         if(res != CURLE_OK) // This is not a response w/return code, this is something breaking!
         {
@@ -2157,7 +3049,11 @@ int32_t curl_perform_with_cam_retries(CURL* curl_handle,memory_write* chunk_writ
             break; // Go to Post retry loop cleanup and return status.
         }
 
-        status = curl_response_error_check(curl_handle, chunk_write->response);
+        status = curl_response_error_check(response_handle, chunk_write->response);
+        if(response_handle != curl_handle) // Answer came from a hedged request
+        {
+            curl_easy_cleanup(response_handle);
+        }
 
         if(status == CRYPTO_LIB_SUCCESS) // Crypto Service REST call worked! Break out of retry loop.
         {
@@ -19,6 +19,8 @@
 #include "crypto_error.h"
 #include "cryptography_interface.h"
 
+// Full length Poly1305 tag, shorter SA MACs are truncations of it
+#define POLY1305_TAG_SIZE 16
 
 // Cryptography Interface Initialization & Management Functions
 static int32_t cryptography_config(void);
@@ -70,30 +72,41 @@ static int32_t cryptography_aead_decrypt(uint8_t* data_out, size_t len_data_out,
                                          uint8_t* aad, uint32_t aad_len,
                                          uint8_t decrypt_bool, uint8_t authenticate_bool,
                                          uint8_t aad_bool, uint8_t* ecs, uint8_t* acs, char* cam_cookies);
+static int32_t cryptography_aead_verify(uint8_t* data_in, size_t len_data_in,
+                                        uint8_t* key, uint32_t len_key,
+                                        SecurityAssociation_t* sa_ptr,
+                                        uint8_t* iv, uint32_t iv_len,
+                                        uint8_t* mac, uint32_t mac_size,
+                                        uint8_t* aad, uint32_t aad_len,
+                                        uint8_t* ecs);
 static int32_t cryptography_get_acs_algo(int8_t algo_enum);
 static int32_t cryptography_get_ecs_algo(int8_t algo_enum);
 static int32_t cryptography_get_ecs_mode(int8_t algo_enum);
+static void cryptography_gcry_event(int32_t status, const char* call, gcry_error_t gcry_error);
 
 /*
 ** Module Variables
 */
-// Cryptography Interface
-static CryptographyInterfaceStruct cryptography_if_struct;
+
+// Initialized at compile time so CRYPTO_DIRECT_CALL builds can call the module without indirection
+const CryptographyInterfaceStruct cryptography_if_libgcrypt = {
+    .cryptography_config = cryptography_config,
+    .cryptography_init = cryptography_init,
+    .cryptography_shutdown = cryptography_shutdown,
+    .cryptography_encrypt = cryptography_encrypt,
+    .cryptography_decrypt = cryptography_decrypt,
+    .cryptography_authenticate = cryptography_authenticate,
+    .cryptography_validate_authentication = cryptography_validate_authentication,
+    .cryptography_aead_encrypt = cryptography_aead_encrypt,
+    .cryptography_aead_decrypt = cryptography_aead_decrypt,
+    .cryptography_get_acs_algo = cryptography_get_acs_algo,
+    .cryptography_get_ecs_algo = cryptography_get_ecs_algo,
+    .cryptography_aead_verify = cryptography_aead_verify,
+};
 
 CryptographyInterface get_cryptography_interface_libgcrypt(void)
 {
-    cryptography_if_struct.cryptography_config = cryptography_config;
-    cryptography_if_struct.cryptography_init = cryptography_init;
-    cryptography_if_struct.cryptography_shutdown = cryptography_shutdown;
-    cryptography_if_struct.cryptography_encrypt = cryptography_encrypt;
-    cryptography_if_struct.cryptography_decrypt = cryptography_decrypt;
-    cryptography_if_struct.cryptography_authenticate = cryptography_authenticate;
-    cryptography_if_struct.cryptography_validate_authentication = cryptography_validate_authentication;
-    cryptography_if_struct.cryptography_aead_encrypt = cryptography_aead_encrypt;
-    cryptography_if_struct.cryptography_aead_decrypt = cryptography_aead_decrypt;
-    cryptography_if_struct.cryptography_get_acs_algo = cryptography_get_acs_algo;
-    cryptography_if_struct.cryptography_get_ecs_algo = cryptography_get_ecs_algo;
-    return &cryptography_if_struct;
+    return (CryptographyInterface)&cryptography_if_libgcrypt;
 }
 
 static int32_t cryptography_config(void)
@@ -121,6 +134,19 @@ static int32_t cryptography_init(void)
 }
 static int32_t cryptography_shutdown(void){ return CRYPTO_LIB_SUCCESS; }
 
+/**
+ * @brief Function: cryptography_gcry_event
+ * Reports a failed libgcrypt call through the rate limited MC event path
+ * @param status: int32
+ * @param call: const char*
+ * @param gcry_error: gcry_error_t
+ **/
+static void cryptography_gcry_event(int32_t status, const char* call, gcry_error_t gcry_error)
+{
+    Crypto_MC_Event(status, MC_EVENT_SPI_NA, NULL, "%s error code %d: %s/%s", call, gcry_error & GPG_ERR_CODE_MASK,
+                    gcry_strsource(gcry_error), gcry_strerror(gcry_error));
+}
+
 static int32_t cryptography_authenticate(uint8_t* data_out, size_t len_data_out,
                                          uint8_t* data_in, size_t len_data_in,
                                          uint8_t* key, uint32_t len_key,
@@ -161,9 +187,8 @@ static int32_t cryptography_authenticate(uint8_t* data_out, size_t len_data_out,
     gcry_error = gcry_mac_open(&(tmp_mac_hd), algo, GCRY_MAC_FLAG_SECURE, NULL);
     if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
     {
-        printf(KRED "ERROR: gcry_mac_open error code %d\n" RESET, gcry_error & GPG_ERR_CODE_MASK);
-        printf(KRED "Failure: %s/%s\n", gcry_strsource(gcry_error), gcry_strerror(gcry_error));
         status = CRYPTO_LIB_ERR_LIBGCRYPT_ERROR;
+        cryptography_gcry_event(status, "gcry_mac_open", gcry_error);
         return status;
     }
     gcry_error = gcry_mac_setkey(tmp_mac_hd, key_ptr, len_key);
@@ -179,9 +204,8 @@ static int32_t cryptography_authenticate(uint8_t* data_out, size_t len_data_out,
 #endif
     if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
     {
-        printf(KRED "ERROR: gcry_mac_setkey error code %d\n" RESET, gcry_error & GPG_ERR_CODE_MASK);
-        printf(KRED "Failure: %s/%s\n", gcry_strsource(gcry_error), gcry_strerror(gcry_error));
         status = CRYPTO_LIB_ERR_LIBGCRYPT_ERROR;
+        cryptography_gcry_event(status, "gcry_mac_setkey", gcry_error);
         gcry_mac_close(tmp_mac_hd);
         return status;
     }
@@ -192,9 +216,8 @@ static int32_t cryptography_authenticate(uint8_t* data_out, size_t len_data_out,
         gcry_error = gcry_mac_setiv(tmp_mac_hd, iv, iv_len);
         if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
         {
-            printf(KRED "ERROR: gcry_mac_setiv error code %d\n" RESET, gcry_error & GPG_ERR_CODE_MASK);
-            printf(KRED "Failure: %s/%s\n", gcry_strsource(gcry_error), gcry_strerror(gcry_error));
             status = CRYPTO_LIB_ERROR;
+            cryptography_gcry_event(status, "gcry_mac_setiv", gcry_error);
             gcry_mac_close(tmp_mac_hd);
             return status;
         }
@@ -206,10 +229,8 @@ static int32_t cryptography_authenticate(uint8_t* data_out, size_t len_data_out,
     );
     if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
     {
-        printf(KRED "ERROR: gcry_mac_write error code %d\n" RESET,
-                gcry_error & GPG_ERR_CODE_MASK);
-        printf(KRED "Failure: %s/%s\n", gcry_strsource(gcry_error), gcry_strerror(gcry_error));
         status = CRYPTO_LIB_ERROR;
+        cryptography_gcry_event(status, "gcry_mac_write", gcry_error);
         gcry_mac_close(tmp_mac_hd);
         return status;
     }
@@ -221,9 +242,8 @@ static int32_t cryptography_authenticate(uint8_t* data_out, size_t len_data_out,
     );
     if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
     {
-        printf(KRED "ERROR: gcry_mac_read error code %d\n" RESET, gcry_error & GPG_ERR_CODE_MASK);
-        printf(KRED "Failure: %s/%s\n", gcry_strsource(gcry_error), gcry_strerror(gcry_error));
         status = CRYPTO_LIB_ERR_MAC_RETRIEVAL_ERROR;
+        cryptography_gcry_event(status, "gcry_mac_read", gcry_error);
         gcry_mac_close(tmp_mac_hd);
         return status;
     }
@@ -275,9 +295,8 @@ static int32_t cryptography_validate_authentication(uint8_t* data_out, size_t le
     gcry_error = gcry_mac_open(&(tmp_mac_hd), algo, GCRY_MAC_FLAG_SECURE, NULL);
     if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
     {
-        printf(KRED "ERROR: gcry_mac_open error code %d\n" RESET, gcry_error & GPG_ERR_CODE_MASK);
-        printf(KRED "Failure: %s/%s\n" RESET, gcry_strsource(gcry_error), gcry_strerror(gcry_error));
         status = CRYPTO_LIB_ERR_LIBGCRYPT_ERROR;
+        cryptography_gcry_event(status, "gcry_mac_open", gcry_error);
         return status;
     }
 
@@ -293,10 +312,9 @@ static int32_t cryptography_validate_authentication(uint8_t* data_out, size_t le
 #endif
     if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
     {
-        printf(KRED "ERROR: gcry_mac_setkey error code %d\n" RESET, gcry_error & GPG_ERR_CODE_MASK);
-        printf(KRED "Failure: %s/%s\n" RESET, gcry_strsource(gcry_error), gcry_strerror(gcry_error));
         gcry_mac_close(tmp_mac_hd);
         status = CRYPTO_LIB_ERR_LIBGCRYPT_ERROR;
+        cryptography_gcry_event(status, "gcry_mac_setkey", gcry_error);
         return status;
     }
     // If MAC needs IV, set it (only for certain ciphers)
@@ -305,10 +323,9 @@ static int32_t cryptography_validate_authentication(uint8_t* data_out, size_t le
         gcry_error = gcry_mac_setiv(tmp_mac_hd, iv, iv_len);
         if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
         {
-            printf(KRED "ERROR: gcry_mac_setiv error code %d\n" RESET, gcry_error & GPG_ERR_CODE_MASK);
-            printf(KRED "Failure: %s/%s\n" RESET, gcry_strsource(gcry_error), gcry_strerror(gcry_error));
             gcry_mac_close(tmp_mac_hd);
             status = CRYPTO_LIB_ERROR;
+            cryptography_gcry_event(status, "gcry_mac_setiv", gcry_error);
             return status;
         }
     }
@@ -318,25 +335,28 @@ static int32_t cryptography_validate_authentication(uint8_t* data_out, size_t le
     );
     if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
     {
-        printf(KRED "ERROR: gcry_mac_write error code %d\n" RESET,
-                gcry_error & GPG_ERR_CODE_MASK);
-        printf(KRED "Failure: %s/%s\n" RESET, gcry_strsource(gcry_error), gcry_strerror(gcry_error));
         gcry_mac_close(tmp_mac_hd);
         status = CRYPTO_LIB_ERROR;
+        cryptography_gcry_event(status, "gcry_mac_write", gcry_error);
         return status;
     }
 
 #ifdef MAC_DEBUG
     uint32_t* tmac_size = &mac_size;
-    uint8_t* tmac = calloc(1,*tmac_size);
+    uint8_t* tmac = Crypto_Arena_Alloc(*tmac_size);
+    if (tmac == NULL)
+    {
+        gcry_mac_close(tmp_mac_hd);
+        return CRYPTO_LIB_ERR_ARENA_EXHAUSTED;
+    }
     gcry_error = gcry_mac_read(tmp_mac_hd,
                                tmac,      // tag output
                                (size_t *)tmac_size // tag size
     );
     if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
     {
-        printf(KRED "ERROR: gcry_mac_read error code %d\n" RESET, gcry_error & GPG_ERR_CODE_MASK);
         status = CRYPTO_LIB_ERR_MAC_RETRIEVAL_ERROR;
+        cryptography_gcry_event(status, "gcry_mac_read", gcry_error);
         return status;
     }
 
@@ -350,7 +370,6 @@ static int32_t cryptography_validate_authentication(uint8_t* data_out, size_t le
         printf("%02X", tmac[i]);
     }
     printf("\n");
-    if (!tmac) free(tmac);
 
     printf("Received MAC:\n\t");
     for (uint32_t i = 0; i < mac_size; i ++){
@@ -366,10 +385,9 @@ static int32_t cryptography_validate_authentication(uint8_t* data_out, size_t le
     );
     if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
     {
-        printf(KRED "ERROR: gcry_mac_verify error code %d\n" RESET, gcry_error & GPG_ERR_CODE_MASK);
-        printf(KRED "Failure: %s/%s\n" RESET, gcry_strsource(gcry_error), gcry_strerror(gcry_error));
         gcry_mac_close(tmp_mac_hd);
         status = CRYPTO_LIB_ERR_MAC_VALIDATION_ERROR;
+        cryptography_gcry_event(status, "gcry_mac_verify", gcry_error);
         return status;
     }
 #ifdef DEBUG
@@ -428,9 +446,8 @@ static int32_t cryptography_encrypt(uint8_t* data_out, size_t len_data_out,
     gcry_error = gcry_cipher_open(&(tmp_hd), algo, mode, GCRY_CIPHER_NONE);
     if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
     {
-        printf(KRED "ERROR: gcry_cipher_open error code %d\n" RESET, gcry_error & GPG_ERR_CODE_MASK);
-        printf(KRED "Failure: %s/%s\n", gcry_strsource(gcry_error), gcry_strerror(gcry_error));
         status = CRYPTO_LIB_ERR_LIBGCRYPT_ERROR;
+        cryptography_gcry_event(status, "gcry_cipher_open", gcry_error);
         return status;
     }
     gcry_error = gcry_cipher_setkey(tmp_hd, key_ptr, len_key);
@@ -447,18 +464,16 @@ static int32_t cryptography_encrypt(uint8_t* data_out, size_t len_data_out,
 
     if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
     {
-        printf(KRED "ERROR: gcry_cipher_setkey error code %d\n" RESET, gcry_error & GPG_ERR_CODE_MASK);
-        printf(KRED "Failure: %s/%s\n", gcry_strsource(gcry_error), gcry_strerror(gcry_error));
         status = CRYPTO_LIB_ERR_LIBGCRYPT_ERROR;
+        cryptography_gcry_event(status, "gcry_cipher_setkey", gcry_error);
         gcry_cipher_close(tmp_hd);
         return status;
     }
     gcry_error = gcry_cipher_setiv(tmp_hd, iv, iv_len);
     if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
     {
-        printf(KRED "ERROR: gcry_cipher_setiv error code %d\n" RESET, gcry_error & GPG_ERR_CODE_MASK);
-        printf(KRED "Failure: %s/%s\n", gcry_strsource(gcry_error), gcry_strerror(gcry_error));
         status = CRYPTO_LIB_ERR_LIBGCRYPT_ERROR;
+        cryptography_gcry_event(status, "gcry_cipher_setiv", gcry_error);
         gcry_cipher_close(tmp_hd);
         return status;
     }
@@ -488,9 +503,8 @@ static int32_t cryptography_encrypt(uint8_t* data_out, size_t len_data_out,
 
     if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
     {
-        printf(KRED "ERROR: gcry_cipher_encrypt error code %d\n" RESET, gcry_error & GPG_ERR_CODE_MASK);
-        printf(KRED "Failure: %s/%s\n", gcry_strsource(gcry_error), gcry_strerror(gcry_error));
         status = CRYPTO_LIB_ERR_ENCRYPTION_ERROR;
+        cryptography_gcry_event(status, "gcry_cipher_encrypt", gcry_error);
         gcry_cipher_close(tmp_hd);
         return status;
     }
@@ -551,9 +565,8 @@ int32_t cryptography_gcry_setup(int32_t mode, int32_t algo, gcry_cipher_hd_t* tm
     } 
     if ((*gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
     {
-        printf(KRED "ERROR: gcry_cipher_open error code %d\n" RESET, *gcry_error & GPG_ERR_CODE_MASK);
-        printf(KRED "Failure: %s/%s\n", gcry_strsource(*gcry_error), gcry_strerror(*gcry_error));
         status = CRYPTO_LIB_ERR_LIBGCRYPT_ERROR;
+        cryptography_gcry_event(status, "gcry_cipher_open", *gcry_error);
         return status;
     }
     *gcry_error = gcry_cipher_setkey(*tmp_hd, key_ptr, len_key);
@@ -569,18 +582,16 @@ int32_t cryptography_gcry_setup(int32_t mode, int32_t algo, gcry_cipher_hd_t* tm
 
     if ((*gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
     {
-        printf(KRED "ERROR: gcry_cipher_setkey error code %d\n" RESET, *gcry_error & GPG_ERR_CODE_MASK);
-        printf(KRED "Failure: %s/%s\n", gcry_strsource(*gcry_error), gcry_strerror(*gcry_error));
         status = CRYPTO_LIB_ERR_LIBGCRYPT_ERROR;
+        cryptography_gcry_event(status, "gcry_cipher_setkey", *gcry_error);
         gcry_cipher_close(*tmp_hd);
         return status;
     }
     *gcry_error = gcry_cipher_setiv(*tmp_hd, iv, iv_len);
     if ((*gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
     {
-        printf(KRED "ERROR: gcry_cipher_setiv error code %d\n" RESET, *gcry_error & GPG_ERR_CODE_MASK);
-        printf(KRED "Failure: %s/%s\n", gcry_strsource(*gcry_error), gcry_strerror(*gcry_error));
         status = CRYPTO_LIB_ERR_LIBGCRYPT_ERROR;
+        cryptography_gcry_event(status, "gcry_cipher_setiv", *gcry_error);
         gcry_cipher_close(*tmp_hd);
         return status;
     }
@@ -645,10 +656,8 @@ static int32_t cryptography_aead_encrypt(uint8_t* data_out, size_t len_data_out,
         );
         if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
         {
-            printf(KRED "ERROR: gcry_cipher_authenticate error code %d\n" RESET,
-                   gcry_error & GPG_ERR_CODE_MASK);
-            printf(KRED "Failure: %s/%s\n", gcry_strsource(gcry_error), gcry_strerror(gcry_error));
             status = CRYPTO_LIB_ERR_AUTHENTICATION_ERROR;
+            cryptography_gcry_event(status, "gcry_cipher_authenticate", gcry_error);
             gcry_cipher_close(tmp_hd);
             return status;
         }
@@ -677,9 +686,8 @@ static int32_t cryptography_aead_encrypt(uint8_t* data_out, size_t len_data_out,
     }
     if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
     {
-        printf(KRED "ERROR: gcry_cipher_encrypt error code %d\n" RESET, gcry_error & GPG_ERR_CODE_MASK);
-        printf(KRED "Failure: %s/%s\n", gcry_strsource(gcry_error), gcry_strerror(gcry_error));
         status = CRYPTO_LIB_ERR_ENCRYPTION_ERROR;
+        cryptography_gcry_event(status, "gcry_cipher_encrypt", gcry_error);
         gcry_cipher_close(tmp_hd);
         return status;
     }
@@ -696,16 +704,24 @@ static int32_t cryptography_aead_encrypt(uint8_t* data_out, size_t len_data_out,
 
     if (authenticate_bool == CRYPTO_TRUE)
     {
-        gcry_error = gcry_cipher_gettag(tmp_hd,
-                                        mac,  // tag output
-                                        mac_size // tag size
-        );
+        if ((mode == GCRY_CIPHER_MODE_POLY1305) && (mac_size < POLY1305_TAG_SIZE))
+        {
+            // Poly1305 only returns the full tag, truncate it here
+            uint8_t full_tag[POLY1305_TAG_SIZE];
+            gcry_error = gcry_cipher_gettag(tmp_hd, full_tag, POLY1305_TAG_SIZE);
+            memcpy(mac, full_tag, mac_size);
+        }
+        else
+        {
+            gcry_error = gcry_cipher_gettag(tmp_hd,
+                                            mac,  // tag output
+                                            mac_size // tag size
+            );
+        }
         if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
         {
-            printf(KRED "ERROR: gcry_cipher_checktag error code %d\n" RESET,
-                   gcry_error & GPG_ERR_CODE_MASK);
-            printf(KRED "Failure: %s/%s\n", gcry_strsource(gcry_error), gcry_strerror(gcry_error));
             status = CRYPTO_LIB_ERR_MAC_RETRIEVAL_ERROR;
+            cryptography_gcry_event(status, "gcry_cipher_checktag", gcry_error);
             gcry_cipher_close(tmp_hd);
             return status;
         }
@@ -769,28 +785,25 @@ static int32_t cryptography_decrypt(uint8_t* data_out, size_t len_data_out,
     gcry_error = gcry_cipher_open(&(tmp_hd), algo, mode, GCRY_CIPHER_NONE);
     if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
     {
-        printf(KRED "ERROR: gcry_cipher_open error code %d\n" RESET, gcry_error & GPG_ERR_CODE_MASK);
-        printf(KRED "Failure: %s/%s\n", gcry_strsource(gcry_error), gcry_strerror(gcry_error));
         status = CRYPTO_LIB_ERR_LIBGCRYPT_ERROR;
+        cryptography_gcry_event(status, "gcry_cipher_open", gcry_error);
         return status;
     }
     gcry_error = gcry_cipher_setkey(tmp_hd, key_ptr, len_key);
     if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
     {
-        printf(KRED "ERROR: gcry_cipher_setkey error code %d\n" RESET, gcry_error & GPG_ERR_CODE_MASK);
-        printf(KRED "Failure: %s/%s\n", gcry_strsource(gcry_error), gcry_strerror(gcry_error));
         gcry_cipher_close(tmp_hd);
         status = CRYPTO_LIB_ERR_LIBGCRYPT_ERROR;
+        cryptography_gcry_event(status, "gcry_cipher_setkey", gcry_error);
         return status;
     }
 
     gcry_error = gcry_cipher_setiv(tmp_hd, iv, iv_len);
     if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
     {
-        printf(KRED "ERROR: gcry_cipher_setiv error code %d\n" RESET, gcry_error & GPG_ERR_CODE_MASK);
-        printf(KRED "Failure: %s/%s\n", gcry_strsource(gcry_error), gcry_strerror(gcry_error));
         gcry_cipher_close(tmp_hd);
         status = CRYPTO_LIB_ERR_LIBGCRYPT_ERROR;
+        cryptography_gcry_event(status, "gcry_cipher_setiv", gcry_error);
         return status;
     }
 
@@ -802,9 +815,9 @@ static int32_t cryptography_decrypt(uint8_t* data_out, size_t len_data_out,
     );
     if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
     {
-        printf(KRED "ERROR: gcry_cipher_decrypt error code %d\n" RESET, gcry_error & GPG_ERR_CODE_MASK);
         gcry_cipher_close(tmp_hd);
         status = CRYPTO_LIB_ERR_DECRYPT_ERROR;
+        cryptography_gcry_event(status, "gcry_cipher_decrypt", gcry_error);
         return status;
     }
 
@@ -857,37 +870,34 @@ static int32_t cryptography_aead_decrypt(uint8_t* data_out, size_t len_data_out,
     }
 
     // Sanity check for future developers
-    if (algo != GCRY_CIPHER_AES256)
+    if ((algo != GCRY_CIPHER_AES256) && (algo != GCRY_CIPHER_CHACHA20))
     {
-        printf(KRED "Warning - only  AES256 supported for AEAD decrypt - exiting!\n" RESET);
         status = CRYPTO_LIB_ERR_UNSUPPORTED_ECS;
+        Crypto_MC_Event(status, MC_EVENT_SPI_NA, NULL, "Only AES256 and ChaCha20 supported for AEAD decrypt");
         return status;
     }
 
-    gcry_error = gcry_cipher_open(&(tmp_hd), GCRY_CIPHER_AES256, mode, GCRY_CIPHER_NONE);
+    gcry_error = gcry_cipher_open(&(tmp_hd), algo, mode, GCRY_CIPHER_NONE);
     if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
     {
-        printf(KRED "ERROR: gcry_cipher_open error code %d\n" RESET, gcry_error & GPG_ERR_CODE_MASK);
-        printf(KRED "Failure: %s/%s\n", gcry_strsource(gcry_error), gcry_strerror(gcry_error));
         status = CRYPTO_LIB_ERR_LIBGCRYPT_ERROR;
+        cryptography_gcry_event(status, "gcry_cipher_open", gcry_error);
         return status;
     }
     gcry_error = gcry_cipher_setkey(tmp_hd, key_ptr, len_key);
     if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
     {
-        printf(KRED "ERROR: gcry_cipher_setkey error code %d\n" RESET, gcry_error & GPG_ERR_CODE_MASK);
-        printf(KRED "Failure: %s/%s\n", gcry_strsource(gcry_error), gcry_strerror(gcry_error));
         gcry_cipher_close(tmp_hd);
         status = CRYPTO_LIB_ERR_LIBGCRYPT_ERROR;
+        cryptography_gcry_event(status, "gcry_cipher_setkey", gcry_error);
         return status;
     }
     gcry_error = gcry_cipher_setiv(tmp_hd, iv, iv_len);
     if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
     {
-        printf(KRED "ERROR: gcry_cipher_setiv error code %d\n" RESET, gcry_error & GPG_ERR_CODE_MASK);
-        printf(KRED "Failure: %s/%s\n", gcry_strsource(gcry_error), gcry_strerror(gcry_error));
         gcry_cipher_close(tmp_hd);
         status = CRYPTO_LIB_ERR_LIBGCRYPT_ERROR;
+        cryptography_gcry_event(status, "gcry_cipher_setiv", gcry_error);
         return status;
     }
     
@@ -899,10 +909,9 @@ static int32_t cryptography_aead_decrypt(uint8_t* data_out, size_t len_data_out,
         );
         if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
         {
-            printf(KRED "ERROR: gcry_cipher_authenticate error code %d\n" RESET, gcry_error & GPG_ERR_CODE_MASK);
-            printf(KRED "Failure: %s/%s\n", gcry_strsource(gcry_error), gcry_strerror(gcry_error));
             gcry_cipher_close(tmp_hd);
             status = CRYPTO_LIB_ERR_AUTHENTICATION_ERROR;
+            cryptography_gcry_event(status, "gcry_cipher_authenticate", gcry_error);
             return status;
         }
     }
@@ -921,10 +930,9 @@ static int32_t cryptography_aead_decrypt(uint8_t* data_out, size_t len_data_out,
         );
         if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
         {
-            printf(KRED "ERROR: gcry_cipher_decrypt error code %d\n" RESET, gcry_error & GPG_ERR_CODE_MASK);
-            printf(KRED "Failure: %s/%s\n", gcry_strsource(gcry_error), gcry_strerror(gcry_error));
             gcry_cipher_close(tmp_hd);
             status = CRYPTO_LIB_ERR_DECRYPT_ERROR;
+            cryptography_gcry_event(status, "gcry_cipher_decrypt", gcry_error);
             return status;
         }
     }
@@ -937,10 +945,9 @@ static int32_t cryptography_aead_decrypt(uint8_t* data_out, size_t len_data_out,
 
         if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
         {
-            printf(KRED "ERROR: gcry_cipher_decrypt error code %d\n" RESET, gcry_error & GPG_ERR_CODE_MASK);
-            printf(KRED "Failure: %s/%s\n", gcry_strsource(gcry_error), gcry_strerror(gcry_error));
             gcry_cipher_close(tmp_hd);
             status = CRYPTO_LIB_ERR_DECRYPT_ERROR;
+            cryptography_gcry_event(status, "gcry_cipher_decrypt", gcry_error);
             return status;
         }
     }
@@ -973,17 +980,34 @@ static int32_t cryptography_aead_decrypt(uint8_t* data_out, size_t len_data_out,
 /*
 ** *** End debug block
 */
-        gcry_error = gcry_cipher_checktag(tmp_hd,
-                                          mac,       // tag input
-                                          mac_size   // tag size
-        );
+        if ((mode == GCRY_CIPHER_MODE_POLY1305) && (mac_size < POLY1305_TAG_SIZE))
+        {
+            // Poly1305 only checks the full tag, compare the truncated one here
+            uint8_t full_tag[POLY1305_TAG_SIZE];
+            uint8_t diff = 0;
+            gcry_error = gcry_cipher_gettag(tmp_hd, full_tag, POLY1305_TAG_SIZE);
+            for (uint32_t i = 0; i < mac_size; i++)
+            {
+                diff |= full_tag[i] ^ mac[i];
+            }
+            if (((gcry_error & GPG_ERR_CODE_MASK) == GPG_ERR_NO_ERROR) && (diff != 0))
+            {
+                gcry_error = GPG_ERR_CHECKSUM;
+            }
+        }
+        else
+        {
+            gcry_error = gcry_cipher_checktag(tmp_hd,
+                                              mac,       // tag input
+                                              mac_size   // tag size
+            );
+        }
 
         if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
         {
-            printf(KRED "ERROR: gcry_cipher_checktag error code %d\n" RESET, gcry_error & GPG_ERR_CODE_MASK);
-            printf(KRED "Failure: %s/%s\n", gcry_strsource(gcry_error), gcry_strerror(gcry_error));
             gcry_cipher_close(tmp_hd);
             status = CRYPTO_LIB_ERR_MAC_VALIDATION_ERROR;
+            cryptography_gcry_event(status, "gcry_cipher_checktag", gcry_error);
             return status;
         }
     }
@@ -992,6 +1016,109 @@ static int32_t cryptography_aead_decrypt(uint8_t* data_out, size_t len_data_out,
     return status;
 }
 
+/**
+ * @brief Function: cryptography_aead_verify
+ * Checks an AES-GCM tag without the CTR pass.  A, zero padding to a block and the ciphertext are all fed through
+ * gcry_cipher_authenticate, the resulting tag only differs from the real one in the length block, which
+ * Crypto_GCM_Check_AAD_Tag corrects with the hash subkey.  Other suites return CRYPTO_LIB_ERR_UNSUPPORTED_ECS.
+ * @param data_in: uint8_t*, ciphertext
+ * @param len_data_in: size_t
+ * @param key: uint8_t*
+ * @param len_key: uint32_t
+ * @param sa_ptr: SecurityAssociation_t*
+ * @param iv: uint8_t*
+ * @param iv_len: uint32_t
+ * @param mac: uint8_t*, expected tag
+ * @param mac_size: uint32_t
+ * @param aad: uint8_t*
+ * @param aad_len: uint32_t
+ * @param ecs: uint8_t*
+ * @return int32: Success/Failure
+ **/
+static int32_t cryptography_aead_verify(uint8_t* data_in, size_t len_data_in,
+                                        uint8_t* key, uint32_t len_key,
+                                        SecurityAssociation_t* sa_ptr,
+                                        uint8_t* iv, uint32_t iv_len,
+                                        uint8_t* mac, uint32_t mac_size,
+                                        uint8_t* aad, uint32_t aad_len,
+                                        uint8_t* ecs)
+{
+    static const uint8_t zeros[CRYPTO_GCM_BLOCK_SIZE] = {0};
+    gcry_cipher_hd_t tmp_hd;
+    gcry_error_t gcry_error = GPG_ERR_NO_ERROR;
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    int32_t algo = -1;
+    int32_t mode = -1;
+    uint8_t h[CRYPTO_GCM_BLOCK_SIZE];
+    uint8_t tag[CRYPTO_GCM_BLOCK_SIZE];
+
+    sa_ptr = sa_ptr; // Unused in this implementation
+
+    status = cryptography_verify_ecs_enum_algo(ecs, &algo, &mode);
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        return status;
+    }
+    if ((algo != GCRY_CIPHER_AES256) || (mode != GCRY_CIPHER_MODE_GCM))
+    {
+        return CRYPTO_LIB_ERR_UNSUPPORTED_ECS;
+    }
+
+    // Hash subkey H = E(K, 0^128)
+    gcry_error = gcry_cipher_open(&tmp_hd, algo, GCRY_CIPHER_MODE_ECB, GCRY_CIPHER_NONE);
+    if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
+    {
+        status = CRYPTO_LIB_ERR_LIBGCRYPT_ERROR;
+        cryptography_gcry_event(status, "gcry_cipher_open", gcry_error);
+        return status;
+    }
+    gcry_error = gcry_cipher_setkey(tmp_hd, key, len_key);
+    if ((gcry_error & GPG_ERR_CODE_MASK) == GPG_ERR_NO_ERROR)
+    {
+        gcry_error = gcry_cipher_encrypt(tmp_hd, h, sizeof(h), zeros, sizeof(zeros));
+    }
+    gcry_cipher_close(tmp_hd);
+    if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
+    {
+        status = CRYPTO_LIB_ERR_LIBGCRYPT_ERROR;
+        cryptography_gcry_event(status, "gcry_cipher_encrypt", gcry_error);
+        return status;
+    }
+
+    status = cryptography_gcry_setup(mode, algo, &tmp_hd, key, len_key, iv, iv_len, &gcry_error);
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        memset(h, 0, sizeof(h));
+        return status;
+    }
+    gcry_error = gcry_cipher_authenticate(tmp_hd, aad, aad_len);
+    if (((gcry_error & GPG_ERR_CODE_MASK) == GPG_ERR_NO_ERROR) && ((aad_len % CRYPTO_GCM_BLOCK_SIZE) != 0))
+    {
+        gcry_error = gcry_cipher_authenticate(tmp_hd, zeros, CRYPTO_GCM_BLOCK_SIZE - (aad_len % CRYPTO_GCM_BLOCK_SIZE));
+    }
+    if (((gcry_error & GPG_ERR_CODE_MASK) == GPG_ERR_NO_ERROR) && (len_data_in > 0))
+    {
+        gcry_error = gcry_cipher_authenticate(tmp_hd, data_in, len_data_in);
+    }
+    if ((gcry_error & GPG_ERR_CODE_MASK) == GPG_ERR_NO_ERROR)
+    {
+        gcry_error = gcry_cipher_gettag(tmp_hd, tag, sizeof(tag));
+    }
+    gcry_cipher_close(tmp_hd);
+    if ((gcry_error & GPG_ERR_CODE_MASK) != GPG_ERR_NO_ERROR)
+    {
+        memset(h, 0, sizeof(h));
+        status = CRYPTO_LIB_ERR_AUTHENTICATION_ERROR;
+        cryptography_gcry_event(status, "gcry_cipher_authenticate", gcry_error);
+        return status;
+    }
+
+    status = Crypto_GCM_Check_AAD_Tag(tag, h, aad_len, len_data_in, mac, mac_size);
+    memset(h, 0, sizeof(h));
+    memset(tag, 0, sizeof(tag));
+    return status;
+}
+
 /**
  * @brief Function: cryptography_get_acs_algo. Maps Cryptolib ACS enums to libgcrypt enums 
  * It is possible for supported algos to vary between crypto libraries
@@ -1044,6 +1171,9 @@ int32_t cryptography_get_ecs_algo(int8_t algo_enum)
         case CRYPTO_CIPHER_AES256_CCM:
             algo = GCRY_CIPHER_AES256;
             break;
+        case CRYPTO_CIPHER_CHACHA20_POLY1305:
+            algo = GCRY_CIPHER_CHACHA20;
+            break;
 
         default:
 #ifdef DEBUG
@@ -1080,6 +1210,9 @@ int32_t cryptography_get_ecs_mode(int8_t algo_enum)
         case CRYPTO_CIPHER_AES256_CCM:
             mode = GCRY_CIPHER_MODE_CCM;
             break;
+        case CRYPTO_CIPHER_CHACHA20_POLY1305:
+            mode = GCRY_CIPHER_MODE_POLY1305;
+            break;
 
         default:
 #ifdef DEBUG
@@ -0,0 +1,1409 @@
+/*
+ * Copyright 2021, by the California Institute of Technology.
+ * ALL RIGHTS RESERVED. United States Government Sponsorship acknowledged.
+ * Any commercial use must be negotiated with the Office of Technology
+ * Transfer at the California Institute of Technology.
+ *
+ * This software may be subject to U.S. export control laws. By accepting
+ * this software, the user agrees to comply with all applicable U.S.
+ * export laws and regulations. User has the responsibility to obtain
+ * export licenses, or other export authority as may be required before
+ * exporting such information to foreign countries or providing access to
+ * foreign persons.
+ */
+
+#include <limits.h>
+#include <pthread.h>
+
+#include <openssl/core_names.h>
+#include <openssl/crypto.h>
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/opensslv.h>
+#include <openssl/params.h>
+
+#include "crypto.h"
+#include "crypto_error.h"
+#include "cryptography_interface.h"
+#include "keystream_prefetch.h"
+
+/*
+** Cached context tables are indexed by SPI, a collision simply re-keys the slot
+** Must be a power of two
+*/
+#define CRYPTO_OPENSSL_CTX_CACHE_SIZE 64
+#define CRYPTO_OPENSSL_DIRECTION_DECRYPT 0
+#define CRYPTO_OPENSSL_DIRECTION_ENCRYPT 1
+
+typedef struct
+{
+    EVP_CIPHER_CTX* ctx;
+    const EVP_CIPHER* cipher; // Cipher the context is currently keyed for, NULL when unkeyed
+    uint32_t len_key;
+    uint32_t iv_len;
+    uint32_t tag_len; // CCM only, the tag length is part of its key setup
+    uint8_t key[EVP_MAX_KEY_LENGTH];
+    uint8_t ghash_h[CRYPTO_GCM_BLOCK_SIZE]; // GCM hash subkey for cryptography_aead_verify
+    uint8_t ghash_h_valid;
+} crypto_openssl_cipher_slot_t;
+
+typedef struct
+{
+    EVP_MAC_CTX* ctx;
+    int8_t acs; // ACS the context is currently keyed for, CRYPTO_MAC_NONE when unkeyed
+    uint32_t len_key;
+    uint8_t key[EVP_MAX_KEY_LENGTH];
+} crypto_openssl_mac_slot_t;
+
+/*
+** A call holds its SA's cached context under the slot lock for the whole operation.  When another thread holds it,
+** the call keys a private context instead of waiting, so concurrent frames of one SA still run in parallel (see
+** Threading in crypto.h).
+*/
+typedef struct
+{
+    crypto_openssl_cipher_slot_t* slot; // Cache slot, or private_slot when lock is NULL
+    pthread_mutex_t* lock;
+    crypto_openssl_cipher_slot_t private_slot;
+} crypto_openssl_cipher_lease_t;
+
+// Cryptography Interface Initialization & Management Functions
+static int32_t cryptography_config(void);
+static int32_t cryptography_init(void);
+static int32_t cryptography_shutdown(void);
+// Cryptography Interface Functions
+static int32_t cryptography_encrypt(uint8_t* data_out, size_t len_data_out,
+                                         uint8_t* data_in, size_t len_data_in,
+                                         uint8_t* key, uint32_t len_key,
+                                         SecurityAssociation_t* sa_ptr,
+                                         uint8_t* iv, uint32_t iv_len,uint8_t* ecs, uint8_t padding, char* cam_cookies);
+static int32_t cryptography_decrypt(uint8_t* data_out, size_t len_data_out,
+                                         uint8_t* data_in, size_t len_data_in,
+                                         uint8_t* key, uint32_t len_key,
+                                         SecurityAssociation_t* sa_ptr,
+                                         uint8_t* iv, uint32_t iv_len,
+                                         uint8_t* ecs, uint8_t* acs, char* cam_cookies);
+static int32_t cryptography_authenticate(uint8_t* data_out, size_t len_data_out,
+                                         uint8_t* data_in, size_t len_data_in,
+                                         uint8_t* key, uint32_t len_key,
+                                         SecurityAssociation_t* sa_ptr,
+                                         uint8_t* iv, uint32_t iv_len,
+                                         uint8_t* mac, uint32_t mac_size,
+                                         uint8_t* aad, uint32_t aad_len,
+                                         uint8_t ecs, uint8_t acs, char* cam_cookies);
+static int32_t cryptography_validate_authentication(uint8_t* data_out, size_t len_data_out,
+                                         const uint8_t* data_in, const size_t len_data_in,
+                                         uint8_t* key, uint32_t len_key,
+                                         SecurityAssociation_t* sa_ptr,
+                                         const uint8_t* iv, uint32_t iv_len,
+                                         const uint8_t* mac, uint32_t mac_size,
+                                         const uint8_t* aad, uint32_t aad_len,
+                                         uint8_t ecs, uint8_t acs, char* cam_cookies);
+static int32_t cryptography_aead_encrypt(uint8_t* data_out, size_t len_data_out,
+                                         uint8_t* data_in, size_t len_data_in,
+                                         uint8_t* key, uint32_t len_key,
+                                         SecurityAssociation_t* sa_ptr,
+                                         uint8_t* iv, uint32_t iv_len,
+                                         uint8_t* mac, uint32_t mac_size,
+                                         uint8_t* aad, uint32_t aad_len,
+                                         uint8_t encrypt_bool, uint8_t authenticate_bool,
+                                         uint8_t aad_bool, uint8_t* ecs, uint8_t* acs, char* cam_cookies);
+static int32_t cryptography_aead_decrypt(uint8_t* data_out, size_t len_data_out,
+                                         uint8_t* data_in, size_t len_data_in,
+                                         uint8_t* key, uint32_t len_key,
+                                         SecurityAssociation_t* sa_ptr,
+                                         uint8_t* iv, uint32_t iv_len,
+                                         uint8_t* mac, uint32_t mac_size,
+                                         uint8_t* aad, uint32_t aad_len,
+                                         uint8_t decrypt_bool, uint8_t authenticate_bool,
+                                         uint8_t aad_bool, uint8_t* ecs, uint8_t* acs, char* cam_cookies);
+static int32_t cryptography_get_acs_algo(int8_t algo_enum);
+static int32_t cryptography_get_ecs_algo(int8_t algo_enum);
+static int32_t cryptography_sa_flush(uint16_t spi);
+static int32_t cryptography_aead_verify(uint8_t* data_in, size_t len_data_in,
+                                        uint8_t* key, uint32_t len_key,
+                                        SecurityAssociation_t* sa_ptr,
+                                        uint8_t* iv, uint32_t iv_len,
+                                        uint8_t* mac, uint32_t mac_size,
+                                        uint8_t* aad, uint32_t aad_len,
+                                        uint8_t* ecs);
+static void cryptography_openssl_lock_init(void);
+
+/*
+** Module Variables
+*/
+// Fetched algorithm implementations, GCM-SIV is only provided by OpenSSL 3.2 and later
+static EVP_CIPHER* openssl_aes256_gcm = NULL;
+static EVP_CIPHER* openssl_aes256_gcm_siv = NULL;
+static EVP_CIPHER* openssl_aes256_cbc = NULL;
+static EVP_CIPHER* openssl_aes256_ccm = NULL;
+static EVP_CIPHER* openssl_aes256_ecb = NULL;
+static EVP_CIPHER* openssl_chacha20_poly1305 = NULL;
+static EVP_MAC* openssl_cmac = NULL;
+static EVP_MAC* openssl_hmac = NULL;
+// Pre-keyed contexts, reused across frames of the same SA, each slot guarded by its lock
+static crypto_openssl_cipher_slot_t openssl_cipher_cache[2][CRYPTO_OPENSSL_CTX_CACHE_SIZE];
+static crypto_openssl_mac_slot_t openssl_mac_cache[CRYPTO_OPENSSL_CTX_CACHE_SIZE];
+static pthread_mutex_t openssl_cipher_lock[2][CRYPTO_OPENSSL_CTX_CACHE_SIZE];
+static pthread_mutex_t openssl_mac_lock[CRYPTO_OPENSSL_CTX_CACHE_SIZE];
+static pthread_once_t openssl_lock_once = PTHREAD_ONCE_INIT;
+
+// Initialized at compile time so CRYPTO_DIRECT_CALL builds can call the module without indirection
+const CryptographyInterfaceStruct cryptography_if_openssl = {
+    .cryptography_config = cryptography_config,
+    .cryptography_init = cryptography_init,
+    .cryptography_shutdown = cryptography_shutdown,
+    .cryptography_encrypt = cryptography_encrypt,
+    .cryptography_decrypt = cryptography_decrypt,
+    .cryptography_authenticate = cryptography_authenticate,
+    .cryptography_validate_authentication = cryptography_validate_authentication,
+    .cryptography_aead_encrypt = cryptography_aead_encrypt,
+    .cryptography_aead_decrypt = cryptography_aead_decrypt,
+    .cryptography_get_acs_algo = cryptography_get_acs_algo,
+    .cryptography_get_ecs_algo = cryptography_get_ecs_algo,
+    .cryptography_sa_flush = cryptography_sa_flush,
+    .cryptography_aead_verify = cryptography_aead_verify,
+};
+
+CryptographyInterface get_cryptography_interface_openssl(void)
+{
+    return (CryptographyInterface)&cryptography_if_openssl;
+}
+
+static int32_t cryptography_config(void)
+{
+    return CRYPTO_LIB_SUCCESS;
+}
+
+static int32_t cryptography_init(void)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+
+    // Initialize OpenSSL
+    if ((OpenSSL_version_num() >> 28) != OPENSSL_VERSION_MAJOR)
+    {
+        status = CRYPTOGRAPHY_LIBRARY_INITIALIZIATION_ERROR;
+        printf(KRED "ERROR: openssl version mismatch! Built against %s, running %s\n" RESET,
+               OPENSSL_VERSION_TEXT, OpenSSL_version(OPENSSL_VERSION));
+        return status;
+    }
+
+    // Fetch once, re-initialization after a shutdown fetches again
+    if (openssl_aes256_gcm == NULL)
+    {
+        openssl_aes256_gcm = EVP_CIPHER_fetch(NULL, "AES-256-GCM", NULL);
+        openssl_aes256_cbc = EVP_CIPHER_fetch(NULL, "AES-256-CBC", NULL);
+        openssl_aes256_ccm = EVP_CIPHER_fetch(NULL, "AES-256-CCM", NULL);
+        openssl_aes256_ecb = EVP_CIPHER_fetch(NULL, "AES-256-ECB", NULL);
+        openssl_cmac = EVP_MAC_fetch(NULL, OSSL_MAC_NAME_CMAC, NULL);
+        openssl_hmac = EVP_MAC_fetch(NULL, OSSL_MAC_NAME_HMAC, NULL);
+        // Optional, absence only disables the AES-GCM-SIV cipher suite
+        ERR_set_mark();
+        openssl_aes256_gcm_siv = EVP_CIPHER_fetch(NULL, "AES-256-GCM-SIV", NULL);
+        ERR_pop_to_mark();
+        // Optional, not provided under FIPS providers
+        ERR_set_mark();
+        openssl_chacha20_poly1305 = EVP_CIPHER_fetch(NULL, "ChaCha20-Poly1305", NULL);
+        ERR_pop_to_mark();
+    }
+    if ((openssl_aes256_gcm == NULL) || (openssl_aes256_cbc == NULL) || (openssl_aes256_ccm == NULL) ||
+        (openssl_aes256_ecb == NULL) || (openssl_cmac == NULL) || (openssl_hmac == NULL))
+    {
+        status = CRYPTOGRAPHY_LIBRARY_INITIALIZIATION_ERROR;
+        printf(KRED "ERROR: openssl unable to fetch required algorithms\n" RESET);
+        ERR_print_errors_fp(stderr);
+        cryptography_shutdown();
+    }
+#ifdef CRYPTO_KEYSTREAM_PREFETCH
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        status = crypto_keystream_prefetch_init();
+        if (status != CRYPTO_LIB_SUCCESS)
+        {
+            printf(KRED "ERROR: openssl unable to start the keystream prefetch worker\n" RESET);
+            cryptography_shutdown();
+        }
+    }
+#endif
+
+    return status;
+}
+
+static int32_t cryptography_shutdown(void)
+{
+    uint32_t i;
+    uint32_t dir;
+
+#ifdef CRYPTO_KEYSTREAM_PREFETCH
+    crypto_keystream_prefetch_shutdown();
+#endif
+
+    // Freeing a context cleanses the expanded key, cleanse our copies as well
+    pthread_once(&openssl_lock_once, cryptography_openssl_lock_init);
+    for (dir = 0; dir < 2; dir++)
+    {
+        for (i = 0; i < CRYPTO_OPENSSL_CTX_CACHE_SIZE; i++)
+        {
+            pthread_mutex_lock(&openssl_cipher_lock[dir][i]);
+            EVP_CIPHER_CTX_free(openssl_cipher_cache[dir][i].ctx);
+            OPENSSL_cleanse(&openssl_cipher_cache[dir][i], sizeof(crypto_openssl_cipher_slot_t));
+            pthread_mutex_unlock(&openssl_cipher_lock[dir][i]);
+        }
+    }
+    for (i = 0; i < CRYPTO_OPENSSL_CTX_CACHE_SIZE; i++)
+    {
+        pthread_mutex_lock(&openssl_mac_lock[i]);
+        EVP_MAC_CTX_free(openssl_mac_cache[i].ctx);
+        OPENSSL_cleanse(&openssl_mac_cache[i], sizeof(crypto_openssl_mac_slot_t));
+        pthread_mutex_unlock(&openssl_mac_lock[i]);
+    }
+
+    EVP_CIPHER_free(openssl_aes256_gcm);
+    EVP_CIPHER_free(openssl_aes256_gcm_siv);
+    EVP_CIPHER_free(openssl_aes256_cbc);
+    EVP_CIPHER_free(openssl_aes256_ccm);
+    EVP_CIPHER_free(openssl_aes256_ecb);
+    EVP_CIPHER_free(openssl_chacha20_poly1305);
+    EVP_MAC_free(openssl_cmac);
+    EVP_MAC_free(openssl_hmac);
+    openssl_aes256_gcm = NULL;
+    openssl_aes256_gcm_siv = NULL;
+    openssl_aes256_cbc = NULL;
+    openssl_aes256_ccm = NULL;
+    openssl_aes256_ecb = NULL;
+    openssl_chacha20_poly1305 = NULL;
+    openssl_cmac = NULL;
+    openssl_hmac = NULL;
+
+    return CRYPTO_LIB_SUCCESS;
+}
+
+/**
+ * @brief Function: cryptography_openssl_get_cipher
+ * Maps CryptoLib ECS enums to fetched OpenSSL ciphers, NULL if unsupported
+ * @param ecs: uint8_t
+ * @return const EVP_CIPHER*
+ **/
+static const EVP_CIPHER* cryptography_openssl_get_cipher(uint8_t ecs)
+{
+    switch (ecs)
+    {
+        case CRYPTO_CIPHER_AES256_GCM:
+            return openssl_aes256_gcm;
+        case CRYPTO_CIPHER_AES256_GCM_SIV:
+            return openssl_aes256_gcm_siv;
+        case CRYPTO_CIPHER_AES256_CBC:
+            return openssl_aes256_cbc;
+        case CRYPTO_CIPHER_AES256_CCM:
+            return openssl_aes256_ccm;
+        case CRYPTO_CIPHER_CHACHA20_POLY1305:
+            return openssl_chacha20_poly1305;
+        default:
+            return NULL;
+    }
+}
+
+/**
+ * @brief Function: cryptography_openssl_lock_init
+ * Initializes the cache slot locks, run once through openssl_lock_once
+ **/
+static void cryptography_openssl_lock_init(void)
+{
+    uint32_t dir;
+    uint32_t i;
+    for (i = 0; i < CRYPTO_OPENSSL_CTX_CACHE_SIZE; i++)
+    {
+        for (dir = 0; dir < 2; dir++)
+        {
+            pthread_mutex_init(&openssl_cipher_lock[dir][i], NULL);
+        }
+        pthread_mutex_init(&openssl_mac_lock[i], NULL);
+    }
+}
+
+/**
+ * @brief Function: cryptography_openssl_cipher_acquire
+ * Takes the SA's cached cipher context for one direction, or a fresh private one when another thread holds it
+ * @param lease: crypto_openssl_cipher_lease_t*
+ * @param direction: int
+ * @param sa_ptr: const SecurityAssociation_t*
+ **/
+static void cryptography_openssl_cipher_acquire(crypto_openssl_cipher_lease_t* lease, int direction,
+                                                const SecurityAssociation_t* sa_ptr)
+{
+    uint16_t spi = (sa_ptr != NULL) ? sa_ptr->spi : 0;
+    uint32_t i = spi & (CRYPTO_OPENSSL_CTX_CACHE_SIZE - 1);
+
+    pthread_once(&openssl_lock_once, cryptography_openssl_lock_init);
+    if (pthread_mutex_trylock(&openssl_cipher_lock[direction][i]) == 0)
+    {
+        lease->slot = &openssl_cipher_cache[direction][i];
+        lease->lock = &openssl_cipher_lock[direction][i];
+    }
+    else
+    {
+        memset(&lease->private_slot, 0, sizeof(crypto_openssl_cipher_slot_t));
+        lease->slot = &lease->private_slot;
+        lease->lock = NULL;
+    }
+}
+
+/**
+ * @brief Function: cryptography_openssl_cipher_release
+ * Gives back a context taken by cryptography_openssl_cipher_setup.  A failed operation drops the cached key so the
+ * next use re-keys from scratch, private contexts are freed.
+ * @param lease: crypto_openssl_cipher_lease_t*
+ * @param status: int32_t, status of the operation
+ * @return int32: status
+ **/
+static int32_t cryptography_openssl_cipher_release(crypto_openssl_cipher_lease_t* lease, int32_t status)
+{
+    if (lease->lock == NULL)
+    {
+        EVP_CIPHER_CTX_free(lease->slot->ctx);
+        OPENSSL_cleanse(lease->slot, sizeof(crypto_openssl_cipher_slot_t));
+        return status;
+    }
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        lease->slot->cipher = NULL;
+    }
+    pthread_mutex_unlock(lease->lock);
+    return status;
+}
+
+/**
+ * @brief Function: cryptography_openssl_cipher_setup
+ * Leases a cipher context for the SA keyed with key and primed with iv. When the SA's cached
+ * context already holds the same cipher and key only the IV is loaded, skipping key expansion.
+ * On success the caller hands the lease back through cryptography_openssl_cipher_release.
+ * @param lease: crypto_openssl_cipher_lease_t*
+ * @param ecs: uint8_t
+ * @param direction: int
+ * @param sa_ptr: SecurityAssociation_t*
+ * @param key: uint8_t*
+ * @param len_key: uint32_t
+ * @param iv: uint8_t*
+ * @param iv_len: uint32_t
+ * @param tag_len: uint32_t, CCM only
+ * @return int32: Success/Failure
+ **/
+static int32_t cryptography_openssl_cipher_setup(crypto_openssl_cipher_lease_t* lease, uint8_t ecs, int direction,
+                                                 SecurityAssociation_t* sa_ptr, uint8_t* key, uint32_t len_key,
+                                                 uint8_t* iv, uint32_t iv_len, uint32_t tag_len)
+{
+    crypto_openssl_cipher_slot_t* slot;
+    const EVP_CIPHER* cipher;
+    uint8_t iv_block[EVP_MAX_IV_LENGTH];
+    int mode;
+
+    cipher = cryptography_openssl_get_cipher(ecs);
+    if (cipher == NULL)
+    {
+        return CRYPTO_LIB_ERR_UNSUPPORTED_ECS;
+    }
+    if (key == NULL)
+    {
+        return CRYPTO_LIB_ERR_NULL_BUFFER;
+    }
+    if ((int)len_key != EVP_CIPHER_get_key_length(cipher))
+    {
+        printf(KRED "ERROR: openssl key length %d does not match cipher key length %d\n" RESET, len_key,
+               EVP_CIPHER_get_key_length(cipher));
+        return CRYPTO_LIB_ERR_KEY_LENGTH_ERROR;
+    }
+    mode = EVP_CIPHER_get_mode(cipher);
+    if (mode != EVP_CIPH_CCM_MODE)
+    {
+        tag_len = 0;
+    }
+
+    // Block modes take exactly one block of IV, shorter SA IVs are zero extended (matches libgcrypt)
+    if ((mode != EVP_CIPH_GCM_MODE) && (mode != EVP_CIPH_CCM_MODE) && (ecs != CRYPTO_CIPHER_CHACHA20_POLY1305) && (iv != NULL) &&
+        ((int)iv_len != EVP_CIPHER_get_iv_length(cipher)))
+    {
+        memset(iv_block, 0, sizeof(iv_block));
+        memcpy(iv_block, iv, ((int)iv_len < EVP_CIPHER_get_iv_length(cipher)) ? iv_len : (uint32_t)EVP_CIPHER_get_iv_length(cipher));
+        iv = iv_block;
+    }
+
+    cryptography_openssl_cipher_acquire(lease, direction, sa_ptr);
+    slot = lease->slot;
+    if (slot->ctx == NULL)
+    {
+        slot->ctx = EVP_CIPHER_CTX_new();
+        if (slot->ctx == NULL)
+        {
+            return cryptography_openssl_cipher_release(lease, CRYPTO_LIB_ERROR);
+        }
+    }
+
+#ifdef SA_DEBUG
+    uint32_t i;
+    printf(KYEL "OpenSSL Cipher Setup Printing Key:\n\t");
+    for (i = 0; i < len_key; i++)
+    {
+        printf("%02X", *(key + i));
+    }
+    printf("\n" RESET);
+#endif
+
+    // GCM-SIV derives per-nonce keys, always start it from a clean context
+    if ((slot->cipher == cipher) && (slot->len_key == len_key) && (slot->iv_len == iv_len) &&
+        (slot->tag_len == tag_len) && (ecs != CRYPTO_CIPHER_AES256_GCM_SIV) && (CRYPTO_memcmp(slot->key, key, len_key) == 0))
+    {
+        if (EVP_CipherInit_ex2(slot->ctx, NULL, NULL, iv, direction, NULL) != 1)
+        {
+            printf(KRED "ERROR: openssl EVP_CipherInit_ex2 iv reload failed\n" RESET);
+            ERR_print_errors_fp(stderr);
+            return cryptography_openssl_cipher_release(lease, CRYPTO_LIB_ERROR);
+        }
+    }
+    else
+    {
+        slot->cipher = NULL;
+        slot->ghash_h_valid = CRYPTO_FALSE;
+        if (EVP_CipherInit_ex2(slot->ctx, cipher, NULL, NULL, direction, NULL) != 1)
+        {
+            printf(KRED "ERROR: openssl EVP_CipherInit_ex2 cipher selection failed\n" RESET);
+            ERR_print_errors_fp(stderr);
+            return cryptography_openssl_cipher_release(lease, CRYPTO_LIB_ERROR);
+        }
+        if ((mode == EVP_CIPH_GCM_MODE) || (mode == EVP_CIPH_CCM_MODE) || (ecs == CRYPTO_CIPHER_CHACHA20_POLY1305))
+        {
+            if (EVP_CIPHER_CTX_ctrl(slot->ctx, EVP_CTRL_AEAD_SET_IVLEN, (int)iv_len, NULL) != 1)
+            {
+                printf(KRED "ERROR: openssl unsupported IV length %d\n" RESET, iv_len);
+                ERR_print_errors_fp(stderr);
+                return cryptography_openssl_cipher_release(lease, CRYPTO_LIB_ERROR);
+            }
+        }
+        if ((mode == EVP_CIPH_CCM_MODE) && (EVP_CIPHER_CTX_ctrl(slot->ctx, EVP_CTRL_AEAD_SET_TAG, (int)tag_len, NULL) != 1))
+        {
+            printf(KRED "ERROR: openssl unsupported CCM tag length %d\n" RESET, tag_len);
+            ERR_print_errors_fp(stderr);
+            return cryptography_openssl_cipher_release(lease, CRYPTO_LIB_ERROR);
+        }
+        if (EVP_CipherInit_ex2(slot->ctx, NULL, key, iv, direction, NULL) != 1)
+        {
+            printf(KRED "ERROR: openssl EVP_CipherInit_ex2 key setup failed\n" RESET);
+            ERR_print_errors_fp(stderr);
+            return cryptography_openssl_cipher_release(lease, CRYPTO_LIB_ERROR);
+        }
+        memcpy(slot->key, key, len_key);
+        slot->len_key = len_key;
+        slot->iv_len = iv_len;
+        slot->tag_len = tag_len;
+        slot->cipher = cipher;
+    }
+
+    // Frames are padded by the caller, never let OpenSSL add PKCS#7 padding
+    if (mode == EVP_CIPH_CBC_MODE)
+    {
+        EVP_CIPHER_CTX_set_padding(slot->ctx, 0);
+    }
+
+    return CRYPTO_LIB_SUCCESS;
+}
+
+/**
+ * @brief Function: cryptography_openssl_mac_keyed
+ * Computes the MAC with the context of slot, reusing its expanded key when it matches
+ * @param slot: crypto_openssl_mac_slot_t*
+ * @param calc_mac: uint8_t*, at least EVP_MAX_MD_SIZE bytes
+ * @param calc_mac_len: size_t*
+ * @param mac_algo: EVP_MAC*
+ * @param params: const OSSL_PARAM*
+ * @param acs: uint8_t
+ * @param key: const uint8_t*
+ * @param len_key: uint32_t
+ * @param aad: const uint8_t*
+ * @param aad_len: uint32_t
+ * @return int32: Success/Failure
+ **/
+static int32_t cryptography_openssl_mac_keyed(crypto_openssl_mac_slot_t* slot, uint8_t* calc_mac, size_t* calc_mac_len,
+                                              EVP_MAC* mac_algo, const OSSL_PARAM* params, uint8_t acs,
+                                              const uint8_t* key, uint32_t len_key, const uint8_t* aad, uint32_t aad_len)
+{
+    if ((slot->ctx != NULL) && (EVP_MAC_CTX_get0_mac(slot->ctx) != mac_algo))
+    {
+        EVP_MAC_CTX_free(slot->ctx);
+        slot->ctx = NULL;
+    }
+    if (slot->ctx == NULL)
+    {
+        slot->acs = CRYPTO_MAC_NONE;
+        slot->ctx = EVP_MAC_CTX_new(mac_algo);
+        if (slot->ctx == NULL)
+        {
+            return CRYPTO_LIB_ERROR;
+        }
+    }
+
+    if ((slot->acs == (int8_t)acs) && (slot->len_key == len_key) && (CRYPTO_memcmp(slot->key, key, len_key) == 0))
+    {
+        // Restart with the already expanded key
+        if (EVP_MAC_init(slot->ctx, NULL, 0, NULL) != 1)
+        {
+            printf(KRED "ERROR: openssl EVP_MAC_init reset failed\n" RESET);
+            ERR_print_errors_fp(stderr);
+            slot->acs = CRYPTO_MAC_NONE;
+            return CRYPTO_LIB_ERROR;
+        }
+    }
+    else
+    {
+        slot->acs = CRYPTO_MAC_NONE;
+        if (EVP_MAC_init(slot->ctx, key, len_key, params) != 1)
+        {
+            printf(KRED "ERROR: openssl EVP_MAC_init key setup failed\n" RESET);
+            ERR_print_errors_fp(stderr);
+            return CRYPTO_LIB_ERROR;
+        }
+        memcpy(slot->key, key, len_key);
+        slot->len_key = len_key;
+        slot->acs = acs;
+    }
+
+    if (EVP_MAC_update(slot->ctx, aad, aad_len) != 1)
+    {
+        printf(KRED "ERROR: openssl EVP_MAC_update failed\n" RESET);
+        ERR_print_errors_fp(stderr);
+        slot->acs = CRYPTO_MAC_NONE;
+        return CRYPTO_LIB_ERROR;
+    }
+    if (EVP_MAC_final(slot->ctx, calc_mac, calc_mac_len, EVP_MAX_MD_SIZE) != 1)
+    {
+        printf(KRED "ERROR: openssl EVP_MAC_final failed\n" RESET);
+        ERR_print_errors_fp(stderr);
+        slot->acs = CRYPTO_MAC_NONE;
+        return CRYPTO_LIB_ERR_MAC_RETRIEVAL_ERROR;
+    }
+
+    return CRYPTO_LIB_SUCCESS;
+}
+
+/**
+ * @brief Function: cryptography_openssl_mac
+ * Computes the full length MAC over aad using the SA's cached, pre-keyed MAC context, or a private one while another
+ * thread holds it
+ * @param calc_mac: uint8_t*, at least EVP_MAX_MD_SIZE bytes
+ * @param calc_mac_len: size_t*
+ * @param acs: uint8_t
+ * @param sa_ptr: SecurityAssociation_t*
+ * @param key: const uint8_t*
+ * @param len_key: uint32_t
+ * @param aad: const uint8_t*
+ * @param aad_len: uint32_t
+ * @return int32: Success/Failure
+ **/
+static int32_t cryptography_openssl_mac(uint8_t* calc_mac, size_t* calc_mac_len, uint8_t acs,
+                                        SecurityAssociation_t* sa_ptr, const uint8_t* key, uint32_t len_key,
+                                        const uint8_t* aad, uint32_t aad_len)
+{
+    crypto_openssl_mac_slot_t private_slot;
+    crypto_openssl_mac_slot_t* slot;
+    pthread_mutex_t* lock;
+    int32_t status;
+    OSSL_PARAM params[2];
+    EVP_MAC* mac_algo = NULL;
+    uint32_t i = ((sa_ptr != NULL) ? sa_ptr->spi : 0) & (CRYPTO_OPENSSL_CTX_CACHE_SIZE - 1);
+
+    switch (acs)
+    {
+        case CRYPTO_MAC_CMAC_AES256:
+            mac_algo = openssl_cmac;
+            params[0] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_CIPHER, (char*)"AES-256-CBC", 0);
+            break;
+        case CRYPTO_MAC_HMAC_SHA256:
+            mac_algo = openssl_hmac;
+            params[0] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, (char*)"SHA256", 0);
+            break;
+        case CRYPTO_MAC_HMAC_SHA512:
+            mac_algo = openssl_hmac;
+            params[0] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, (char*)"SHA512", 0);
+            break;
+        default:
+            return CRYPTO_LIB_ERR_UNSUPPORTED_ACS;
+    }
+    params[1] = OSSL_PARAM_construct_end();
+
+    if ((key == NULL) || (len_key > EVP_MAX_KEY_LENGTH))
+    {
+        return CRYPTO_LIB_ERR_KEY_LENGTH_ERROR;
+    }
+
+    pthread_once(&openssl_lock_once, cryptography_openssl_lock_init);
+    lock = &openssl_mac_lock[i];
+    slot = &openssl_mac_cache[i];
+    if (pthread_mutex_trylock(lock) != 0)
+    {
+        memset(&private_slot, 0, sizeof(private_slot));
+        slot = &private_slot;
+        lock = NULL;
+    }
+
+    status = cryptography_openssl_mac_keyed(slot, calc_mac, calc_mac_len, mac_algo, params, acs, key, len_key, aad, aad_len);
+
+    if (lock == NULL)
+    {
+        EVP_MAC_CTX_free(slot->ctx);
+        OPENSSL_cleanse(slot, sizeof(crypto_openssl_mac_slot_t));
+    }
+    else
+    {
+        pthread_mutex_unlock(lock);
+    }
+    return status;
+}
+
+static int32_t cryptography_authenticate(uint8_t* data_out, size_t len_data_out,
+                                         uint8_t* data_in, size_t len_data_in,
+                                         uint8_t* key, uint32_t len_key,
+                                         SecurityAssociation_t* sa_ptr, // For key index or key references (when key not passed in explicitly via key param)
+                                         uint8_t* iv, uint32_t iv_len,
+                                         uint8_t* mac, uint32_t mac_size,
+                                         uint8_t* aad, uint32_t aad_len,
+                                         uint8_t ecs, uint8_t acs, char* cam_cookies)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    uint8_t calc_mac[EVP_MAX_MD_SIZE];
+    size_t calc_mac_len = 0;
+
+    // Unused in this implementation
+    len_data_out = len_data_out;
+    iv = iv;
+    iv_len = iv_len;
+    ecs = ecs;
+    cam_cookies = cam_cookies;
+
+    // Need to copy the data over, since authentication won't change/move the data directly
+    if(data_out != NULL)
+    {
+        memcpy(data_out, data_in, len_data_in);
+    }
+    else
+    {
+        return CRYPTO_LIB_ERR_NULL_BUFFER;
+    }
+
+    status = cryptography_openssl_mac(calc_mac, &calc_mac_len, acs, sa_ptr, key, len_key, aad, aad_len);
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        return status;
+    }
+    if (mac_size > calc_mac_len)
+    {
+        status = CRYPTO_LIB_ERR_MAC_RETRIEVAL_ERROR;
+        OPENSSL_cleanse(calc_mac, sizeof(calc_mac));
+        return status;
+    }
+
+    // Truncate to the SA's MAC length
+    memcpy(mac, calc_mac, mac_size);
+    OPENSSL_cleanse(calc_mac, sizeof(calc_mac));
+
+#ifdef MAC_DEBUG
+    uint32_t i;
+    printf("MAC = 0x");
+    for (i = 0; i < mac_size; i++)
+    {
+        printf("%02x", (uint8_t)mac[i]);
+    }
+    printf("\n");
+#endif
+
+    return status;
+}
+
+static int32_t cryptography_validate_authentication(uint8_t* data_out, size_t len_data_out,
+                                                    const uint8_t* data_in, const size_t len_data_in,
+                                                    uint8_t* key, uint32_t len_key,
+                                                    SecurityAssociation_t* sa_ptr,
+                                                    const uint8_t* iv, uint32_t iv_len,
+                                                    const uint8_t* mac, uint32_t mac_size,
+                                                    const uint8_t* aad, uint32_t aad_len,
+                                                    uint8_t ecs, uint8_t acs, char* cam_cookies)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    uint8_t calc_mac[EVP_MAX_MD_SIZE];
+    size_t calc_mac_len = 0;
+    size_t len_in = len_data_in; // Unused
+    len_in = len_in;
+
+    // Unused in this implementation
+    iv = iv;
+    iv_len = iv_len;
+    ecs = ecs;
+    cam_cookies = cam_cookies;
+
+    // Need to copy the data over, since authentication won't change/move the data directly
+    // If you don't want data out, don't set a data out length
+    if(data_out != NULL)
+    {
+        memcpy(data_out, data_in, len_data_out);
+    }
+    else
+    {
+        return CRYPTO_LIB_ERR_NULL_BUFFER;
+    }
+
+    status = cryptography_openssl_mac(calc_mac, &calc_mac_len, acs, sa_ptr, key, len_key, aad, aad_len);
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        return status;
+    }
+
+#ifdef MAC_DEBUG
+    uint32_t i;
+    printf("Calculated MAC (truncated to sa_ptr->stmacf_len):\n\t");
+    for (i = 0; i < mac_size && i < calc_mac_len; i++)
+    {
+        printf("%02X", calc_mac[i]);
+    }
+    printf("\nReceived MAC:\n\t");
+    for (i = 0; i < mac_size; i++)
+    {
+        printf("%02X", mac[i]);
+    }
+    printf("\n");
+#endif
+
+    // Compare computed mac with MAC in frame, constant time
+    if ((mac_size == 0) || (mac_size > calc_mac_len) || (CRYPTO_memcmp(calc_mac, mac, mac_size) != 0))
+    {
+        printf(KRED "ERROR: openssl MAC verification failed\n" RESET);
+        status = CRYPTO_LIB_ERR_MAC_VALIDATION_ERROR;
+    }
+#ifdef DEBUG
+    else
+    {
+        printf("Mac verified!\n");
+    }
+#endif
+    // Zeroise any sensitive information
+    OPENSSL_cleanse(calc_mac, sizeof(calc_mac));
+    return status;
+}
+
+static int32_t cryptography_encrypt(uint8_t* data_out, size_t len_data_out,
+                                         uint8_t* data_in, size_t len_data_in,
+                                         uint8_t* key, uint32_t len_key,
+                                         SecurityAssociation_t* sa_ptr,
+                                         uint8_t* iv, uint32_t iv_len,uint8_t* ecs, uint8_t padding, char* cam_cookies)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    crypto_openssl_cipher_lease_t lease;
+    EVP_CIPHER_CTX* ctx = NULL;
+    int outl = 0;
+    int finl = 0;
+
+    // Unused in this implementation, padding is applied by the caller
+    len_data_out = len_data_out;
+    padding = padding;
+    cam_cookies = cam_cookies;
+
+    if (ecs == NULL)
+    {
+        return CRYPTO_LIB_ERR_NULL_MODE_PTR;
+    }
+    if (len_data_in > INT_MAX)
+    {
+        return CRYPTO_LIB_ERR_ENCRYPTION_ERROR;
+    }
+
+    status = cryptography_openssl_cipher_setup(&lease, *ecs, CRYPTO_OPENSSL_DIRECTION_ENCRYPT, sa_ptr, key, len_key, iv, iv_len, 0);
+    if (status == CRYPTO_LIB_ERR_UNSUPPORTED_ECS)
+    {
+        return CRYPTO_LIB_ERR_UNSUPPORTED_MODE;
+    }
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        return status;
+    }
+    ctx = lease.slot->ctx;
+
+#ifdef TC_DEBUG
+    size_t j;
+    printf("Input payload length is %ld\n", (long int) len_data_in);
+    printf(KYEL "Printing Frame Data prior to encryption:\n\t");
+    for (j = 0; j < len_data_in; j++)
+    {
+        printf("%02X", *(data_in + j));
+    }
+    printf("\n");
+#endif
+
+    // In place when data_out == data_in, as all TC/TM/AOS callers do
+    if ((EVP_EncryptUpdate(ctx, data_out, &outl, data_in, (int)len_data_in) != 1) ||
+        (EVP_EncryptFinal_ex(ctx, data_out + outl, &finl) != 1))
+    {
+        printf(KRED "ERROR: openssl encrypt failed\n" RESET);
+        ERR_print_errors_fp(stderr);
+        status = CRYPTO_LIB_ERR_ENCRYPTION_ERROR;
+        return cryptography_openssl_cipher_release(&lease, status);
+    }
+
+#ifdef TC_DEBUG
+    printf("Output payload length is %ld\n", (long int) len_data_out);
+    printf(KYEL "Printing Frame Data after encryption:\n\t");
+    for (j = 0; j < len_data_out; j++)
+    {
+        printf("%02X", *(data_out + j));
+    }
+    printf("\n");
+#endif
+
+    return cryptography_openssl_cipher_release(&lease, status);
+}
+
+static int32_t cryptography_aead_encrypt(uint8_t* data_out, size_t len_data_out,
+                                         uint8_t* data_in, size_t len_data_in,
+                                         uint8_t* key, uint32_t len_key,
+                                         SecurityAssociation_t* sa_ptr, // For key index or key references (when key not passed in explicitly via key param)
+                                         uint8_t* iv, uint32_t iv_len,
+                                         uint8_t* mac, uint32_t mac_size,
+                                         uint8_t* aad, uint32_t aad_len,
+                                         uint8_t encrypt_bool, uint8_t authenticate_bool,
+                                         uint8_t aad_bool, uint8_t* ecs, uint8_t* acs, char* cam_cookies)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    crypto_openssl_cipher_lease_t lease;
+    EVP_CIPHER_CTX* ctx = NULL;
+    int mode;
+    int outl = 0;
+    int finl = 0;
+    uint8_t empty = 0;
+    size_t len_payload = (encrypt_bool == CRYPTO_TRUE) ? len_data_in : 0;
+
+    // Fix warning
+    len_data_out = len_data_out;
+    acs = acs;
+    cam_cookies = cam_cookies;
+
+    if (ecs == NULL)
+    {
+        status = CRYPTO_LIB_ERR_NULL_ECS_PTR;
+        mc_if->mc_log(status);
+        return status;
+    }
+    if (len_payload > INT_MAX)
+    {
+        return CRYPTO_LIB_ERR_ENCRYPTION_ERROR;
+    }
+
+#ifdef CRYPTO_KEYSTREAM_PREFETCH
+    // Counter IVs owned by CryptoLib are predictable, seal from the prefetched keystream when it is ready
+    uint8_t prefetch = (*ecs == CRYPTO_CIPHER_AES256_GCM) && (sa_ptr != NULL) && (iv == sa_ptr->iv) &&
+                       (crypto_config.iv_type == IV_INTERNAL) && (key != NULL) && (len_key == 32) &&
+                       (iv_len == 12) && (encrypt_bool == CRYPTO_TRUE) && (authenticate_bool == CRYPTO_TRUE) &&
+                       (mac_size > 0) && (mac_size <= 16);
+    if (prefetch && crypto_keystream_prefetch_seal(sa_ptr->spi, key, iv, data_out, data_in, len_data_in,
+                                                   (aad_bool == CRYPTO_TRUE) ? aad : NULL,
+                                                   (aad_bool == CRYPTO_TRUE) ? aad_len : 0,
+                                                   mac, mac_size) == CRYPTO_TRUE)
+    {
+        crypto_keystream_prefetch_schedule(sa_ptr->spi, key, iv, len_data_in);
+        return status;
+    }
+#endif
+
+    status = cryptography_openssl_cipher_setup(&lease, *ecs, CRYPTO_OPENSSL_DIRECTION_ENCRYPT, sa_ptr, key, len_key, iv, iv_len,
+                                               (mac_size != 0) ? mac_size : 16);
+    if(status != CRYPTO_LIB_SUCCESS)
+    {
+        mc_if->mc_log(status);
+        return status;
+    }
+    ctx = lease.slot->ctx;
+    mode = EVP_CIPHER_CTX_get_mode(ctx);
+
+#ifdef DEBUG
+    size_t j;
+    printf("Input payload length is %ld\n", (long int) len_data_in);
+    printf(KYEL "Printing Frame Data prior to encryption:\n\t");
+    for (j = 0; j < len_data_in; j++)
+    {
+        printf("%02X", *(data_in + j));
+    }
+    printf("\n");
+#endif
+
+    // CCM fixes the message length before any data is processed
+    if (mode == EVP_CIPH_CCM_MODE)
+    {
+        if (EVP_EncryptUpdate(ctx, NULL, &outl, NULL, (int)len_payload) != 1)
+        {
+            printf(KRED "ERROR: openssl CCM length setup failed\n" RESET);
+            ERR_print_errors_fp(stderr);
+            status = CRYPTO_LIB_ERR_ENCRYPTION_ERROR;
+            return cryptography_openssl_cipher_release(&lease, status);
+        }
+    }
+
+    if (aad_bool == CRYPTO_TRUE) // Authenticate with AAD!
+    {
+        if (EVP_EncryptUpdate(ctx, NULL, &outl, aad, (int)aad_len) != 1)
+        {
+            printf(KRED "ERROR: openssl AAD update failed\n" RESET);
+            ERR_print_errors_fp(stderr);
+            status = CRYPTO_LIB_ERR_AUTHENTICATION_ERROR;
+            return cryptography_openssl_cipher_release(&lease, status);
+        }
+    }
+
+    outl = 0;
+    if (encrypt_bool == CRYPTO_TRUE)
+    {
+        if (EVP_EncryptUpdate(ctx, data_out, &outl, data_in, (int)len_data_in) != 1)
+        {
+            printf(KRED "ERROR: openssl encrypt update failed\n" RESET);
+            ERR_print_errors_fp(stderr);
+            status = CRYPTO_LIB_ERR_ENCRYPTION_ERROR;
+            return cryptography_openssl_cipher_release(&lease, status);
+        }
+    }
+    else if (mode == EVP_CIPH_CCM_MODE)
+    {
+        // CCM computes its tag on the payload update, run it over an empty payload
+        if (EVP_EncryptUpdate(ctx, &empty, &outl, &empty, 0) != 1)
+        {
+            printf(KRED "ERROR: openssl CCM empty payload update failed\n" RESET);
+            ERR_print_errors_fp(stderr);
+            status = CRYPTO_LIB_ERR_ENCRYPTION_ERROR;
+            return cryptography_openssl_cipher_release(&lease, status);
+        }
+    }
+    // AEAD authenticate only finalizes over the AAD alone
+    if (EVP_EncryptFinal_ex(ctx, (data_out != NULL) ? data_out + outl : NULL, &finl) != 1)
+    {
+        printf(KRED "ERROR: openssl encrypt final failed\n" RESET);
+        ERR_print_errors_fp(stderr);
+        status = CRYPTO_LIB_ERR_ENCRYPTION_ERROR;
+        return cryptography_openssl_cipher_release(&lease, status);
+    }
+
+#ifdef TC_DEBUG
+    printf("Output payload length is %ld\n", (long int) len_data_out);
+    printf(KYEL "Printing Frame Data after encryption:\n\t");
+    for (j = 0; j < len_data_out; j++)
+    {
+        printf("%02X", *(data_out + j));
+    }
+    printf("\n");
+#endif
+
+    if (authenticate_bool == CRYPTO_TRUE)
+    {
+        if (EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, (int)mac_size, mac) != 1)
+        {
+            printf(KRED "ERROR: openssl get tag failed\n" RESET);
+            ERR_print_errors_fp(stderr);
+            status = CRYPTO_LIB_ERR_MAC_RETRIEVAL_ERROR;
+            return cryptography_openssl_cipher_release(&lease, status);
+        }
+
+#ifdef MAC_DEBUG
+        uint32_t i = 0;
+        printf("MAC = 0x");
+        for (i = 0; i < mac_size; i++)
+        {
+            printf("%02x", (uint8_t)mac[i]);
+        }
+        printf("\n");
+#endif
+    }
+    status = cryptography_openssl_cipher_release(&lease, status);
+
+#ifdef CRYPTO_KEYSTREAM_PREFETCH
+    if (prefetch)
+    {
+        crypto_keystream_prefetch_schedule(sa_ptr->spi, key, iv, len_data_in);
+    }
+#endif
+
+    return status;
+}
+
+static int32_t cryptography_decrypt(uint8_t* data_out, size_t len_data_out,
+                                         uint8_t* data_in, size_t len_data_in,
+                                         uint8_t* key, uint32_t len_key,
+                                         SecurityAssociation_t* sa_ptr,
+                                         uint8_t* iv, uint32_t iv_len,
+                                         uint8_t* ecs, uint8_t* acs, char* cam_cookies)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    crypto_openssl_cipher_lease_t lease;
+    EVP_CIPHER_CTX* ctx = NULL;
+    int outl = 0;
+    int finl = 0;
+
+    // Fix warnings
+    len_data_out = len_data_out;
+    acs = acs;
+    cam_cookies = cam_cookies;
+
+    if (ecs == NULL)
+    {
+        return CRYPTO_LIB_ERR_NULL_ECS_PTR;
+    }
+    if (len_data_in > INT_MAX)
+    {
+        return CRYPTO_LIB_ERR_DECRYPT_ERROR;
+    }
+
+    status = cryptography_openssl_cipher_setup(&lease, *ecs, CRYPTO_OPENSSL_DIRECTION_DECRYPT, sa_ptr, key, len_key, iv, iv_len, 0);
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        return status;
+    }
+    ctx = lease.slot->ctx;
+
+    if (EVP_DecryptUpdate(ctx, data_out, &outl, data_in, (int)len_data_in) != 1)
+    {
+        printf(KRED "ERROR: openssl decrypt failed\n" RESET);
+        ERR_print_errors_fp(stderr);
+        status = CRYPTO_LIB_ERR_DECRYPT_ERROR;
+        return cryptography_openssl_cipher_release(&lease, status);
+    }
+    // AEAD modes would check an unset tag on final, there is none on this path
+    if (EVP_CIPHER_CTX_get_mode(ctx) == EVP_CIPH_CBC_MODE)
+    {
+        if (EVP_DecryptFinal_ex(ctx, data_out + outl, &finl) != 1)
+        {
+            printf(KRED "ERROR: openssl decrypt final failed\n" RESET);
+            ERR_print_errors_fp(stderr);
+            status = CRYPTO_LIB_ERR_DECRYPT_ERROR;
+            return cryptography_openssl_cipher_release(&lease, status);
+        }
+    }
+
+    return cryptography_openssl_cipher_release(&lease, status);
+}
+
+static int32_t cryptography_aead_decrypt(uint8_t* data_out, size_t len_data_out,
+                                         uint8_t* data_in, size_t len_data_in,
+                                         uint8_t* key, uint32_t len_key,
+                                         SecurityAssociation_t* sa_ptr,
+                                         uint8_t* iv, uint32_t iv_len,
+                                         uint8_t* mac, uint32_t mac_size,
+                                         uint8_t* aad, uint32_t aad_len,
+                                         uint8_t decrypt_bool, uint8_t authenticate_bool,
+                                         uint8_t aad_bool, uint8_t* ecs, uint8_t* acs, char* cam_cookies)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    crypto_openssl_cipher_lease_t lease;
+    EVP_CIPHER_CTX* ctx = NULL;
+    int mode;
+    int outl = 0;
+    int finl = 0;
+    uint8_t empty = 0;
+    size_t len_payload = (decrypt_bool == CRYPTO_TRUE) ? len_data_in : 0;
+
+    // Fix warnings
+    len_data_out = len_data_out;
+    acs = acs;
+    cam_cookies = cam_cookies;
+
+    if (ecs == NULL)
+    {
+        return CRYPTO_LIB_ERR_NULL_ECS_PTR;
+    }
+    if (len_payload > INT_MAX)
+    {
+        return CRYPTO_LIB_ERR_DECRYPT_ERROR;
+    }
+
+    status = cryptography_openssl_cipher_setup(&lease, *ecs, CRYPTO_OPENSSL_DIRECTION_DECRYPT, sa_ptr, key, len_key, iv, iv_len,
+                                               mac_size);
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        return status;
+    }
+    ctx = lease.slot->ctx;
+    mode = EVP_CIPHER_CTX_get_mode(ctx);
+
+    // CCM and GCM-SIV verify while decrypting, so the expected tag goes in first
+    if ((mode == EVP_CIPH_CCM_MODE) || (*ecs == CRYPTO_CIPHER_AES256_GCM_SIV))
+    {
+        if (EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_TAG, (int)mac_size, mac) != 1)
+        {
+            printf(KRED "ERROR: openssl set tag failed\n" RESET);
+            ERR_print_errors_fp(stderr);
+            status = CRYPTO_LIB_ERR_MAC_VALIDATION_ERROR;
+            return cryptography_openssl_cipher_release(&lease, status);
+        }
+    }
+    if (mode == EVP_CIPH_CCM_MODE)
+    {
+        if (EVP_DecryptUpdate(ctx, NULL, &outl, NULL, (int)len_payload) != 1)
+        {
+            printf(KRED "ERROR: openssl CCM length setup failed\n" RESET);
+            ERR_print_errors_fp(stderr);
+            status = CRYPTO_LIB_ERR_DECRYPT_ERROR;
+            return cryptography_openssl_cipher_release(&lease, status);
+        }
+    }
+
+    if (aad_bool == CRYPTO_TRUE)
+    {
+        if (EVP_DecryptUpdate(ctx, NULL, &outl, aad, (int)aad_len) != 1)
+        {
+            printf(KRED "ERROR: openssl AAD update failed\n" RESET);
+            ERR_print_errors_fp(stderr);
+            status = CRYPTO_LIB_ERR_AUTHENTICATION_ERROR;
+            return cryptography_openssl_cipher_release(&lease, status);
+        }
+    }
+
+    outl = 0;
+    if (decrypt_bool == CRYPTO_TRUE)
+    {
+        if (EVP_DecryptUpdate(ctx, data_out, &outl, data_in, (int)len_data_in) != 1)
+        {
+            printf(KRED "ERROR: openssl decrypt update failed\n" RESET);
+            ERR_print_errors_fp(stderr);
+            // CCM reports a tag mismatch from the update itself
+            status = (mode == EVP_CIPH_CCM_MODE) ? CRYPTO_LIB_ERR_MAC_VALIDATION_ERROR : CRYPTO_LIB_ERR_DECRYPT_ERROR;
+            return cryptography_openssl_cipher_release(&lease, status);
+        }
+    }
+    else // Authentication only
+    {
+        // CCM checks its tag on the payload update, run it over an empty payload
+        if ((mode == EVP_CIPH_CCM_MODE) && (EVP_DecryptUpdate(ctx, &empty, &outl, &empty, 0) != 1))
+        {
+            printf(KRED "ERROR: openssl MAC verification failed\n" RESET);
+            ERR_clear_error();
+            status = CRYPTO_LIB_ERR_MAC_VALIDATION_ERROR;
+            return cryptography_openssl_cipher_release(&lease, status);
+        }
+        // If authentication only, don't decrypt the data. Just pass the data PDU through.
+        memcpy(data_out, data_in, len_data_in);
+    }
+
+    if (authenticate_bool == CRYPTO_TRUE)
+    {
+        if ((mode == EVP_CIPH_GCM_MODE) || (*ecs == CRYPTO_CIPHER_CHACHA20_POLY1305))
+        {
+            if (EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_TAG, (int)mac_size, mac) != 1)
+            {
+                printf(KRED "ERROR: openssl set tag failed\n" RESET);
+                ERR_print_errors_fp(stderr);
+                status = CRYPTO_LIB_ERR_MAC_VALIDATION_ERROR;
+                return cryptography_openssl_cipher_release(&lease, status);
+            }
+        }
+        // CCM already verified during the payload update
+        if (mode != EVP_CIPH_CCM_MODE)
+        {
+            if (EVP_DecryptFinal_ex(ctx, (decrypt_bool == CRYPTO_TRUE) ? data_out + outl : NULL, &finl) != 1)
+            {
+                printf(KRED "ERROR: openssl MAC verification failed\n" RESET);
+                ERR_clear_error();
+                status = CRYPTO_LIB_ERR_MAC_VALIDATION_ERROR;
+                return cryptography_openssl_cipher_release(&lease, status);
+            }
+        }
+    }
+
+    return cryptography_openssl_cipher_release(&lease, status);
+}
+
+/**
+ * @brief Function: cryptography_aead_verify
+ * Checks an AES-GCM tag without the CTR pass.  A, zero padding to a block and the ciphertext are all fed as AAD to
+ * the SA's cached encrypt context, the resulting tag only differs from the real one in the length block, which
+ * Crypto_GCM_Check_AAD_Tag corrects with the hash subkey.  The subkey is cached in the slot until it is rekeyed.
+ * Other suites return CRYPTO_LIB_ERR_UNSUPPORTED_ECS.
+ * @param data_in: uint8_t*, ciphertext
+ * @param len_data_in: size_t
+ * @param key: uint8_t*
+ * @param len_key: uint32_t
+ * @param sa_ptr: SecurityAssociation_t*
+ * @param iv: uint8_t*
+ * @param iv_len: uint32_t
+ * @param mac: uint8_t*, expected tag
+ * @param mac_size: uint32_t
+ * @param aad: uint8_t*
+ * @param aad_len: uint32_t
+ * @param ecs: uint8_t*
+ * @return int32: Success/Failure
+ **/
+static int32_t cryptography_aead_verify(uint8_t* data_in, size_t len_data_in,
+                                        uint8_t* key, uint32_t len_key,
+                                        SecurityAssociation_t* sa_ptr,
+                                        uint8_t* iv, uint32_t iv_len,
+                                        uint8_t* mac, uint32_t mac_size,
+                                        uint8_t* aad, uint32_t aad_len,
+                                        uint8_t* ecs)
+{
+    static const uint8_t zeros[CRYPTO_GCM_BLOCK_SIZE] = {0};
+    crypto_openssl_cipher_slot_t* slot;
+    crypto_openssl_cipher_lease_t lease;
+    EVP_CIPHER_CTX* ctx = NULL;
+    EVP_CIPHER_CTX* ecb = NULL;
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    uint8_t tag[CRYPTO_GCM_BLOCK_SIZE];
+    int outl = 0;
+    int ok;
+
+    if (ecs == NULL)
+    {
+        return CRYPTO_LIB_ERR_NULL_ECS_PTR;
+    }
+    if (*ecs != CRYPTO_CIPHER_AES256_GCM)
+    {
+        return CRYPTO_LIB_ERR_UNSUPPORTED_ECS;
+    }
+    if ((len_data_in > INT_MAX) || (aad_len > INT_MAX))
+    {
+        return CRYPTO_LIB_ERR_AUTHENTICATION_ERROR;
+    }
+
+    status = cryptography_openssl_cipher_setup(&lease, *ecs, CRYPTO_OPENSSL_DIRECTION_ENCRYPT, sa_ptr, key, len_key, iv,
+                                               iv_len, 0);
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        return status;
+    }
+    ctx = lease.slot->ctx;
+    slot = lease.slot;
+
+    // Hash subkey H = E(K, 0^128), once per key
+    if (slot->ghash_h_valid != CRYPTO_TRUE)
+    {
+        ecb = EVP_CIPHER_CTX_new();
+        ok = (ecb != NULL) && (EVP_EncryptInit_ex2(ecb, openssl_aes256_ecb, key, NULL, NULL) == 1) &&
+             (EVP_CIPHER_CTX_set_padding(ecb, 0) == 1) &&
+             (EVP_EncryptUpdate(ecb, slot->ghash_h, &outl, zeros, CRYPTO_GCM_BLOCK_SIZE) == 1) &&
+             (outl == CRYPTO_GCM_BLOCK_SIZE);
+        EVP_CIPHER_CTX_free(ecb);
+        if (!ok)
+        {
+            printf(KRED "ERROR: openssl GCM hash subkey derivation failed\n" RESET);
+            ERR_print_errors_fp(stderr);
+            OPENSSL_cleanse(slot->ghash_h, CRYPTO_GCM_BLOCK_SIZE);
+            return cryptography_openssl_cipher_release(&lease, CRYPTO_LIB_ERROR);
+        }
+        slot->ghash_h_valid = CRYPTO_TRUE;
+    }
+
+    ok = (EVP_EncryptUpdate(ctx, NULL, &outl, aad, (int)aad_len) == 1);
+    if (ok && ((aad_len % CRYPTO_GCM_BLOCK_SIZE) != 0))
+    {
+        ok = (EVP_EncryptUpdate(ctx, NULL, &outl, zeros, (int)(CRYPTO_GCM_BLOCK_SIZE - (aad_len % CRYPTO_GCM_BLOCK_SIZE))) == 1);
+    }
+    if (ok && (len_data_in > 0))
+    {
+        ok = (EVP_EncryptUpdate(ctx, NULL, &outl, data_in, (int)len_data_in) == 1);
+    }
+    ok = ok && (EVP_EncryptFinal_ex(ctx, tag, &outl) == 1) &&
+         (EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, CRYPTO_GCM_BLOCK_SIZE, tag) == 1);
+    if (!ok)
+    {
+        printf(KRED "ERROR: openssl GCM AAD tag failed\n" RESET);
+        ERR_print_errors_fp(stderr);
+        return cryptography_openssl_cipher_release(&lease, CRYPTO_LIB_ERR_AUTHENTICATION_ERROR);
+    }
+
+    status = Crypto_GCM_Check_AAD_Tag(tag, slot->ghash_h, aad_len, len_data_in, mac, mac_size);
+    OPENSSL_cleanse(tag, sizeof(tag));
+    // A forged tag says nothing about the context, keep the key cached
+    cryptography_openssl_cipher_release(&lease, CRYPTO_LIB_SUCCESS);
+    return status;
+}
+
+/**
+ * @brief Function: cryptography_sa_flush
+ * Zeroizes the cached keys and any prefetched keystream of an SA on rekey/stop
+ * @param spi: uint16_t, CRYPTOGRAPHY_FLUSH_ALL_SA for every SA
+ * @return int32: Success/Failure
+ **/
+static int32_t cryptography_sa_flush(uint16_t spi)
+{
+    uint32_t dir;
+    uint32_t i;
+    uint32_t slot = spi & (CRYPTO_OPENSSL_CTX_CACHE_SIZE - 1);
+
+    pthread_once(&openssl_lock_once, cryptography_openssl_lock_init);
+    for (i = 0; i < CRYPTO_OPENSSL_CTX_CACHE_SIZE; i++)
+    {
+        if ((spi != CRYPTOGRAPHY_FLUSH_ALL_SA) && (i != slot))
+        {
+            continue;
+        }
+        // Contexts are kept for reuse, only the key is dropped.  Waits out any call still using the slot.
+        for (dir = 0; dir < 2; dir++)
+        {
+            pthread_mutex_lock(&openssl_cipher_lock[dir][i]);
+            if (openssl_cipher_cache[dir][i].ctx != NULL)
+            {
+                EVP_CIPHER_CTX_reset(openssl_cipher_cache[dir][i].ctx);
+            }
+            openssl_cipher_cache[dir][i].cipher = NULL;
+            OPENSSL_cleanse(openssl_cipher_cache[dir][i].key, EVP_MAX_KEY_LENGTH);
+            OPENSSL_cleanse(openssl_cipher_cache[dir][i].ghash_h, CRYPTO_GCM_BLOCK_SIZE);
+            openssl_cipher_cache[dir][i].ghash_h_valid = CRYPTO_FALSE;
+            pthread_mutex_unlock(&openssl_cipher_lock[dir][i]);
+        }
+        pthread_mutex_lock(&openssl_mac_lock[i]);
+        EVP_MAC_CTX_free(openssl_mac_cache[i].ctx);
+        OPENSSL_cleanse(&openssl_mac_cache[i], sizeof(crypto_openssl_mac_slot_t));
+        pthread_mutex_unlock(&openssl_mac_lock[i]);
+    }
+#ifdef CRYPTO_KEYSTREAM_PREFETCH
+    crypto_keystream_prefetch_flush((spi == CRYPTOGRAPHY_FLUSH_ALL_SA) ? CRYPTO_KEYSTREAM_PREFETCH_ALL_SA : spi);
+#endif
+
+    return CRYPTO_LIB_SUCCESS;
+}
+
+/**
+ * @brief Function: cryptography_get_acs_algo. Maps Cryptolib ACS enums to supported algorithms
+ * Unused by OpenSSL beyond support checks, simply leverage same CryptoLib enums
+ * @param algo_enum
+ **/
+static int32_t cryptography_get_acs_algo(int8_t algo_enum)
+{
+    int32_t algo = CRYPTO_LIB_ERR_UNSUPPORTED_ACS; // All valid algos will be positive
+    switch (algo_enum)
+    {
+        case CRYPTO_MAC_CMAC_AES256:
+            algo = CRYPTO_MAC_CMAC_AES256;
+            break;
+        case CRYPTO_MAC_HMAC_SHA256:
+            algo = CRYPTO_MAC_HMAC_SHA256;
+            break;
+        case CRYPTO_MAC_HMAC_SHA512:
+            algo = CRYPTO_MAC_HMAC_SHA512;
+            break;
+
+        default:
+#ifdef DEBUG
+            printf("ACS Algo Enum not supported\n");
+#endif
+            break;
+    }
+
+    return (int)algo;
+}
+
+/**
+ * @brief Function: cryptography_get_ecs_algo. Maps Cryptolib ECS enums to supported algorithms
+ * GCM-SIV is only reported when the loaded OpenSSL provides it
+ * @param algo_enum
+ **/
+static int32_t cryptography_get_ecs_algo(int8_t algo_enum)
+{
+    int32_t algo = CRYPTO_LIB_ERR_UNSUPPORTED_ECS; // All valid algos will be positive
+    if ((algo_enum == CRYPTO_CIPHER_AES256_CBC_MAC) || (cryptography_openssl_get_cipher(algo_enum) == NULL))
+    {
+#ifdef DEBUG
+        printf("Algo Enum not supported\n");
+#endif
+        return algo;
+    }
+    algo = algo_enum;
+    return (int)algo;
+}
@@ -0,0 +1,467 @@
+/*
+ * Copyright 2021, by the California Institute of Technology.
+ * ALL RIGHTS RESERVED. United States Government Sponsorship acknowledged.
+ * Any commercial use must be negotiated with the Office of Technology
+ * Transfer at the California Institute of Technology.
+ *
+ * This software may be subject to U.S. export control laws. By accepting
+ * this software, the user agrees to comply with all applicable U.S.
+ * export laws and regulations. User has the responsibility to obtain
+ * export licenses, or other export authority as may be required before
+ * exporting such information to foreign countries or providing access to
+ * foreign persons.
+ */
+
+#ifdef CRYPTO_KEYSTREAM_PREFETCH
+
+#include <limits.h>
+#include <pthread.h>
+#include <string.h>
+
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+
+#include "crypto.h"
+#include "crypto_error.h"
+#include "keystream_prefetch.h"
+
+#define KEYSTREAM_KEY_LEN 32
+#define KEYSTREAM_IV_LEN 12
+#define KEYSTREAM_BLOCK 16
+
+typedef struct
+{
+    uint8_t valid;
+    uint8_t iv[KEYSTREAM_IV_LEN];
+    size_t len; // Payload keystream bytes
+    size_t cap;
+    uint8_t* stream; // E(K, J0 + 1) || E(K, J0 + 2) || ...
+} crypto_keystream_entry_t;
+
+typedef struct
+{
+    uint8_t keyed;
+    uint8_t pending; // Worker has IVs to fill for this SA
+    uint16_t spi;
+    uint32_t generation; // Bumped on every flush, stale worker output is discarded
+    uint8_t key[KEYSTREAM_KEY_LEN];
+    uint8_t h[KEYSTREAM_BLOCK]; // Hash subkey E(K, 0^128)
+    EVP_CIPHER_CTX* gcm; // Keyed GCM context, computes the tag over AAD and ciphertext
+    uint8_t next_iv[KEYSTREAM_IV_LEN]; // First IV after the last one used
+    size_t len;
+    crypto_keystream_entry_t ring[CRYPTO_KEYSTREAM_PREFETCH_DEPTH];
+} crypto_keystream_slot_t;
+
+static crypto_keystream_slot_t keystream_slots[CRYPTO_KEYSTREAM_PREFETCH_SLOTS];
+static pthread_mutex_t keystream_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t keystream_cond = PTHREAD_COND_INITIALIZER;
+static pthread_t keystream_worker;
+static uint8_t keystream_running = 0;
+static uint8_t keystream_idle = 0; // Worker is parked on the condition, only then is a wake-up needed
+static EVP_CIPHER* keystream_ctr = NULL;
+static EVP_CIPHER* keystream_ecb = NULL;
+static EVP_CIPHER* keystream_gcm = NULL;
+static pthread_once_t keystream_atfork_once = PTHREAD_ONCE_INIT;
+
+// Consecutive counter IVs map to distinct ring entries
+static uint32_t keystream_ring_index(const uint8_t* iv)
+{
+    uint32_t low = ((uint32_t)iv[8] << 24) | ((uint32_t)iv[9] << 16) | ((uint32_t)iv[10] << 8) | iv[11];
+    return low % CRYPTO_KEYSTREAM_PREFETCH_DEPTH;
+}
+
+static void keystream_slot_clear(crypto_keystream_slot_t* slot)
+{
+    int i;
+    EVP_CIPHER_CTX_free(slot->gcm);
+    for (i = 0; i < CRYPTO_KEYSTREAM_PREFETCH_DEPTH; i++)
+    {
+        if (slot->ring[i].stream != NULL)
+        {
+            OPENSSL_cleanse(slot->ring[i].stream, slot->ring[i].cap);
+            free(slot->ring[i].stream);
+        }
+    }
+    uint32_t generation = slot->generation;
+    OPENSSL_cleanse(slot, sizeof(crypto_keystream_slot_t));
+    slot->generation = generation + 1;
+}
+
+/**
+ * @brief Function: keystream_worker_main
+ * Fills each pending SA ring for the IVs following the last one used
+ * Keystream is computed outside the lock and only committed if the SA was not flushed meanwhile
+ **/
+static void* keystream_worker_main(void* arg)
+{
+    EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+    uint8_t* scratch = malloc(CRYPTO_KEYSTREAM_PREFETCH_MAX_LEN);
+    uint8_t key[KEYSTREAM_KEY_LEN];
+    uint8_t iv[KEYSTREAM_IV_LEN];
+    uint8_t j0[KEYSTREAM_BLOCK];
+    crypto_keystream_slot_t* slot;
+    crypto_keystream_entry_t* entry;
+    uint32_t generation;
+    size_t len;
+    uint8_t* grown;
+    int outl;
+    int i;
+    int k;
+
+    arg = arg;
+
+    pthread_mutex_lock(&keystream_mutex);
+    while (keystream_running && ctx != NULL && scratch != NULL)
+    {
+        slot = NULL;
+        for (i = 0; i < CRYPTO_KEYSTREAM_PREFETCH_SLOTS; i++)
+        {
+            if (keystream_slots[i].keyed && keystream_slots[i].pending)
+            {
+                slot = &keystream_slots[i];
+                break;
+            }
+        }
+        if (slot == NULL)
+        {
+            keystream_idle = 1;
+            pthread_cond_wait(&keystream_cond, &keystream_mutex);
+            keystream_idle = 0;
+            continue;
+        }
+        slot->pending = 0;
+
+        memcpy(iv, slot->next_iv, KEYSTREAM_IV_LEN);
+        for (k = 0; k < CRYPTO_KEYSTREAM_PREFETCH_DEPTH; k++, Crypto_increment(iv, KEYSTREAM_IV_LEN))
+        {
+            entry = &slot->ring[keystream_ring_index(iv)];
+            if (entry->valid && entry->len >= slot->len && memcmp(entry->iv, iv, KEYSTREAM_IV_LEN) == 0)
+            {
+                continue;
+            }
+            memcpy(key, slot->key, KEYSTREAM_KEY_LEN);
+            generation = slot->generation;
+            len = slot->len;
+            pthread_mutex_unlock(&keystream_mutex);
+
+            // Payload keystream starts at J0 + 1, J0 = IV || 0^31 || 1 only masks the tag
+            memcpy(j0, iv, KEYSTREAM_IV_LEN);
+            j0[12] = 0;
+            j0[13] = 0;
+            j0[14] = 0;
+            j0[15] = 2;
+            memset(scratch, 0, len);
+            outl = 0;
+            if (EVP_EncryptInit_ex2(ctx, keystream_ctr, key, j0, NULL) != 1 ||
+                EVP_EncryptUpdate(ctx, scratch, &outl, scratch, (int)len) != 1)
+            {
+                outl = -1;
+            }
+            OPENSSL_cleanse(key, sizeof(key));
+
+            pthread_mutex_lock(&keystream_mutex);
+            if (!keystream_running || slot->generation != generation || outl != (int)len)
+            {
+                break;
+            }
+            if ((entry->cap < len) || (entry->stream == NULL))
+            {
+                grown = malloc((len > 0) ? len : 1);
+                if (grown == NULL)
+                {
+                    break;
+                }
+                if (entry->stream != NULL)
+                {
+                    OPENSSL_cleanse(entry->stream, entry->cap);
+                    free(entry->stream);
+                }
+                entry->stream = grown;
+                entry->cap = len;
+            }
+            memcpy(entry->stream, scratch, len);
+            memcpy(entry->iv, iv, KEYSTREAM_IV_LEN);
+            entry->len = len;
+            entry->valid = 1;
+        }
+        OPENSSL_cleanse(scratch, CRYPTO_KEYSTREAM_PREFETCH_MAX_LEN);
+    }
+    pthread_mutex_unlock(&keystream_mutex);
+
+    if (scratch != NULL)
+    {
+        OPENSSL_cleanse(scratch, CRYPTO_KEYSTREAM_PREFETCH_MAX_LEN);
+        free(scratch);
+    }
+    EVP_CIPHER_CTX_free(ctx);
+    return NULL;
+}
+
+/**
+ * @brief Function: keystream_atfork_prepare
+ * Holds the lock across fork so the child never inherits it mid update
+ **/
+static void keystream_atfork_prepare(void)
+{
+    pthread_mutex_lock(&keystream_mutex);
+}
+
+static void keystream_atfork_parent(void)
+{
+    pthread_mutex_unlock(&keystream_mutex);
+}
+
+/**
+ * @brief Function: keystream_atfork_child
+ * The worker does not survive fork, the child starts without it and without the parent's keystream
+ **/
+static void keystream_atfork_child(void)
+{
+    int i;
+
+    for (i = 0; i < CRYPTO_KEYSTREAM_PREFETCH_SLOTS; i++)
+    {
+        keystream_slot_clear(&keystream_slots[i]);
+    }
+    keystream_running = 0;
+    keystream_idle = 0;
+    pthread_mutex_init(&keystream_mutex, NULL);
+    pthread_cond_init(&keystream_cond, NULL);
+}
+
+static void keystream_atfork_register(void)
+{
+    pthread_atfork(keystream_atfork_prepare, keystream_atfork_parent, keystream_atfork_child);
+}
+
+/**
+ * @brief Function: crypto_keystream_prefetch_init
+ * Starts the prefetch worker, a no-op when already running
+ * @return int32: Success/Failure
+ **/
+int32_t crypto_keystream_prefetch_init(void)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+
+    pthread_once(&keystream_atfork_once, keystream_atfork_register);
+    pthread_mutex_lock(&keystream_mutex);
+    if (!keystream_running)
+    {
+        // A forked child keeps the parent's ciphers
+        if (keystream_ctr == NULL)
+        {
+            keystream_ctr = EVP_CIPHER_fetch(NULL, "AES-256-CTR", NULL);
+        }
+        if (keystream_ecb == NULL)
+        {
+            keystream_ecb = EVP_CIPHER_fetch(NULL, "AES-256-ECB", NULL);
+        }
+        if (keystream_gcm == NULL)
+        {
+            keystream_gcm = EVP_CIPHER_fetch(NULL, "AES-256-GCM", NULL);
+        }
+        keystream_running = 1;
+        if (keystream_ctr == NULL || keystream_ecb == NULL || keystream_gcm == NULL ||
+            pthread_create(&keystream_worker, NULL, keystream_worker_main, NULL) != 0)
+        {
+            keystream_running = 0;
+            EVP_CIPHER_free(keystream_ctr);
+            EVP_CIPHER_free(keystream_ecb);
+            EVP_CIPHER_free(keystream_gcm);
+            keystream_ctr = NULL;
+            keystream_ecb = NULL;
+            keystream_gcm = NULL;
+            status = CRYPTOGRAPHY_LIBRARY_INITIALIZIATION_ERROR;
+        }
+    }
+    pthread_mutex_unlock(&keystream_mutex);
+
+    return status;
+}
+
+/**
+ * @brief Function: crypto_keystream_prefetch_shutdown
+ * Stops the worker and zeroizes all keystream material
+ **/
+void crypto_keystream_prefetch_shutdown(void)
+{
+    uint8_t running;
+
+    pthread_mutex_lock(&keystream_mutex);
+    running = keystream_running;
+    keystream_running = 0;
+    pthread_cond_broadcast(&keystream_cond);
+    pthread_mutex_unlock(&keystream_mutex);
+
+    if (running)
+    {
+        pthread_join(keystream_worker, NULL);
+    }
+    crypto_keystream_prefetch_flush(CRYPTO_KEYSTREAM_PREFETCH_ALL_SA);
+    EVP_CIPHER_free(keystream_ctr);
+    EVP_CIPHER_free(keystream_ecb);
+    EVP_CIPHER_free(keystream_gcm);
+    keystream_ctr = NULL;
+    keystream_ecb = NULL;
+    keystream_gcm = NULL;
+}
+
+/**
+ * @brief Function: crypto_keystream_prefetch_flush
+ * Zeroizes the keystream and key material held for an SA
+ * @param spi: uint16_t, CRYPTO_KEYSTREAM_PREFETCH_ALL_SA for every SA
+ **/
+void crypto_keystream_prefetch_flush(uint16_t spi)
+{
+    int i;
+
+    pthread_mutex_lock(&keystream_mutex);
+    for (i = 0; i < CRYPTO_KEYSTREAM_PREFETCH_SLOTS; i++)
+    {
+        if (spi == CRYPTO_KEYSTREAM_PREFETCH_ALL_SA || (keystream_slots[i].keyed && keystream_slots[i].spi == spi))
+        {
+            keystream_slot_clear(&keystream_slots[i]);
+        }
+    }
+    pthread_mutex_unlock(&keystream_mutex);
+}
+
+/**
+ * @brief Function: crypto_keystream_prefetch_seal
+ * AES-256-GCM encrypt from a prefetched keystream, each keystream entry is used once.  The tag comes from the SA's
+ * keyed GCM context run over AAD, padding and ciphertext as AAD (see Crypto_GCM_Fix_AAD_Tag), so GHASH stays in
+ * OpenSSL and no table is indexed by secret data.
+ * @param spi: uint16_t
+ * @param key: const uint8_t*
+ * @param iv: const uint8_t*
+ * @param data_out: uint8_t*
+ * @param data_in: const uint8_t*
+ * @param len: size_t
+ * @param aad: const uint8_t*
+ * @param aad_len: uint32_t
+ * @param mac: uint8_t*
+ * @param mac_size: uint32_t
+ * @return uint8: CRYPTO_TRUE when sealed, CRYPTO_FALSE when the caller must take the regular path
+ **/
+uint8_t crypto_keystream_prefetch_seal(uint16_t spi, const uint8_t* key, const uint8_t* iv,
+                                       uint8_t* data_out, const uint8_t* data_in, size_t len,
+                                       const uint8_t* aad, uint32_t aad_len,
+                                       uint8_t* mac, uint32_t mac_size)
+{
+    crypto_keystream_slot_t* slot = &keystream_slots[spi & (CRYPTO_KEYSTREAM_PREFETCH_SLOTS - 1)];
+    static const uint8_t zeros[KEYSTREAM_BLOCK] = {0};
+    crypto_keystream_entry_t* entry;
+    uint8_t tag[KEYSTREAM_BLOCK];
+    int outl = 0;
+    int ok;
+    size_t i;
+
+    if ((mac_size > KEYSTREAM_BLOCK) || (aad_len > INT_MAX))
+    {
+        return CRYPTO_FALSE;
+    }
+
+    pthread_mutex_lock(&keystream_mutex);
+    entry = &slot->ring[keystream_ring_index(iv)];
+    if (!slot->keyed || slot->spi != spi || CRYPTO_memcmp(slot->key, key, KEYSTREAM_KEY_LEN) != 0 ||
+        !entry->valid || entry->len < len || memcmp(entry->iv, iv, KEYSTREAM_IV_LEN) != 0)
+    {
+        pthread_mutex_unlock(&keystream_mutex);
+        return CRYPTO_FALSE;
+    }
+
+    for (i = 0; i < len; i++)
+    {
+        data_out[i] = data_in[i] ^ entry->stream[i];
+    }
+    ok = (EVP_EncryptInit_ex2(slot->gcm, NULL, NULL, iv, NULL) == 1) &&
+         (EVP_EncryptUpdate(slot->gcm, NULL, &outl, aad, (int)aad_len) == 1);
+    if (ok && ((aad_len % KEYSTREAM_BLOCK) != 0))
+    {
+        ok = (EVP_EncryptUpdate(slot->gcm, NULL, &outl, zeros, (int)(KEYSTREAM_BLOCK - (aad_len % KEYSTREAM_BLOCK))) == 1);
+    }
+    if (ok && (len > 0))
+    {
+        ok = (EVP_EncryptUpdate(slot->gcm, NULL, &outl, data_out, (int)len) == 1);
+    }
+    ok = ok && (EVP_EncryptFinal_ex(slot->gcm, tag, &outl) == 1) &&
+         (EVP_CIPHER_CTX_ctrl(slot->gcm, EVP_CTRL_AEAD_GET_TAG, KEYSTREAM_BLOCK, tag) == 1);
+
+    // The entry is spent either way, a failed tag leaves the caller to redo the frame on the regular path
+    OPENSSL_cleanse(entry->stream, entry->len);
+    entry->valid = 0;
+    if (ok)
+    {
+        Crypto_GCM_Fix_AAD_Tag(tag, slot->h, aad_len, len);
+        memcpy(mac, tag, mac_size);
+    }
+    pthread_mutex_unlock(&keystream_mutex);
+    OPENSSL_cleanse(tag, sizeof(tag));
+
+    return ok ? CRYPTO_TRUE : CRYPTO_FALSE;
+}
+
+/**
+ * @brief Function: crypto_keystream_prefetch_schedule
+ * Queues the IVs following iv for prefetch, a new key flushes whatever the SA held
+ * @param spi: uint16_t
+ * @param key: const uint8_t*
+ * @param iv: const uint8_t*, the IV just used
+ * @param len: size_t, payload length to cover
+ **/
+void crypto_keystream_prefetch_schedule(uint16_t spi, const uint8_t* key, const uint8_t* iv, size_t len)
+{
+    crypto_keystream_slot_t* slot = &keystream_slots[spi & (CRYPTO_KEYSTREAM_PREFETCH_SLOTS - 1)];
+    EVP_CIPHER_CTX* ctx;
+    uint8_t h[KEYSTREAM_BLOCK] = {0};
+    int outl = 0;
+
+    if (len > CRYPTO_KEYSTREAM_PREFETCH_MAX_LEN)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&keystream_mutex);
+    if (!keystream_running)
+    {
+        pthread_mutex_unlock(&keystream_mutex);
+        return;
+    }
+    if (!slot->keyed || slot->spi != spi || CRYPTO_memcmp(slot->key, key, KEYSTREAM_KEY_LEN) != 0)
+    {
+        keystream_slot_clear(slot);
+        ctx = EVP_CIPHER_CTX_new();
+        if (ctx == NULL || EVP_EncryptInit_ex2(ctx, keystream_ecb, key, NULL, NULL) != 1 ||
+            EVP_EncryptUpdate(ctx, h, &outl, h, KEYSTREAM_BLOCK) != 1)
+        {
+            EVP_CIPHER_CTX_free(ctx);
+            pthread_mutex_unlock(&keystream_mutex);
+            return;
+        }
+        EVP_CIPHER_CTX_free(ctx);
+        slot->gcm = EVP_CIPHER_CTX_new();
+        if (slot->gcm == NULL || EVP_EncryptInit_ex2(slot->gcm, keystream_gcm, key, NULL, NULL) != 1)
+        {
+            keystream_slot_clear(slot);
+            OPENSSL_cleanse(h, sizeof(h));
+            pthread_mutex_unlock(&keystream_mutex);
+            return;
+        }
+        memcpy(slot->h, h, KEYSTREAM_BLOCK);
+        OPENSSL_cleanse(h, sizeof(h));
+        memcpy(slot->key, key, KEYSTREAM_KEY_LEN);
+        slot->spi = spi;
+        slot->keyed = 1;
+    }
+    memcpy(slot->next_iv, iv, KEYSTREAM_IV_LEN);
+    Crypto_increment(slot->next_iv, KEYSTREAM_IV_LEN);
+    slot->len = len;
+    slot->pending = 1;
+    if (keystream_idle)
+    {
+        pthread_cond_signal(&keystream_cond);
+    }
+    pthread_mutex_unlock(&keystream_mutex);
+}
+
+#endif // CRYPTO_KEYSTREAM_PREFETCH
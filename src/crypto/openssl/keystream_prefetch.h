@@ -0,0 +1,44 @@
+/*
+ * Copyright 2021, by the California Institute of Technology.
+ * ALL RIGHTS RESERVED. United States Government Sponsorship acknowledged.
+ * Any commercial use must be negotiated with the Office of Technology
+ * Transfer at the California Institute of Technology.
+ *
+ * This software may be subject to U.S. export control laws. By accepting
+ * this software, the user agrees to comply with all applicable U.S.
+ * export laws and regulations. User has the responsibility to obtain
+ * export licenses, or other export authority as may be required before
+ * exporting such information to foreign countries or providing access to
+ * foreign persons.
+ */
+
+#ifndef CRYPTOLIB_KEYSTREAM_PREFETCH_H
+#define CRYPTOLIB_KEYSTREAM_PREFETCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+** AES-256-GCM keystream prefetch for SAs whose IV is an internal counter
+** A worker thread precomputes E(K, J0) and the CTR keystream of the next IVs,
+** frame time is then reduced to an XOR and a GHASH
+*/
+#ifndef CRYPTO_KEYSTREAM_PREFETCH_DEPTH
+#define CRYPTO_KEYSTREAM_PREFETCH_DEPTH 8 // IVs precomputed ahead per SA
+#endif
+#ifndef CRYPTO_KEYSTREAM_PREFETCH_MAX_LEN
+#define CRYPTO_KEYSTREAM_PREFETCH_MAX_LEN 4096 // Larger payloads always take the regular path
+#endif
+#define CRYPTO_KEYSTREAM_PREFETCH_SLOTS 64 // SAs tracked, indexed by SPI, must be a power of two
+#define CRYPTO_KEYSTREAM_PREFETCH_ALL_SA 0xFFFF
+
+int32_t crypto_keystream_prefetch_init(void);
+void crypto_keystream_prefetch_shutdown(void);
+void crypto_keystream_prefetch_flush(uint16_t spi);
+uint8_t crypto_keystream_prefetch_seal(uint16_t spi, const uint8_t* key, const uint8_t* iv,
+                                       uint8_t* data_out, const uint8_t* data_in, size_t len,
+                                       const uint8_t* aad, uint32_t aad_len,
+                                       uint8_t* mac, uint32_t mac_size);
+void crypto_keystream_prefetch_schedule(uint16_t spi, const uint8_t* key, const uint8_t* iv, size_t len);
+
+#endif //CRYPTOLIB_KEYSTREAM_PREFETCH_H
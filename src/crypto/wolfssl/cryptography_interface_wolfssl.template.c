@@ -17,6 +17,7 @@
 #include <wolfssl/options.h>
 #include <wolfssl/ssl.h>
 #include <wolfssl/wolfcrypt/aes.h>
+#include <wolfssl/wolfcrypt/chacha20_poly1305.h>
 #include <wolfssl/wolfcrypt/ecc.h>
 #include <wolfssl/wolfcrypt/cmac.h>
 #include <wolfssl/wolfcrypt/hmac.h>
@@ -453,6 +454,58 @@ static int32_t cryptography_encrypt(uint8_t* data_out, size_t len_data_out,
     return status;
 }
 
+/**
+ * @brief Function: cryptography_wolfssl_chacha20_poly1305
+ * ChaCha20-Poly1305 through the streaming API, which unlike the one-shot calls accepts an empty payload
+ * @param data_out: uint8_t*
+ * @param data_in: const uint8_t*
+ * @param len_data_in: size_t, zero to authenticate the AAD only
+ * @param key: const uint8_t*
+ * @param len_key: uint32_t
+ * @param iv: const uint8_t*
+ * @param iv_len: uint32_t
+ * @param aad: const uint8_t*
+ * @param aad_len: uint32_t
+ * @param tag: uint8_t*, full length tag output
+ * @param is_encrypt: int
+ * @return int32: Success/Failure
+ **/
+static int32_t cryptography_wolfssl_chacha20_poly1305(uint8_t* data_out, const uint8_t* data_in, size_t len_data_in,
+                                                      const uint8_t* key, uint32_t len_key,
+                                                      const uint8_t* iv, uint32_t iv_len,
+                                                      const uint8_t* aad, uint32_t aad_len,
+                                                      uint8_t* tag, int is_encrypt)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    ChaChaPoly_Aead aead;
+
+    if (len_key != CHACHA20_POLY1305_AEAD_KEYSIZE)
+    {
+        return CRYPTO_LIB_ERR_KEY_LENGTH_ERROR;
+    }
+    if (iv_len != CHACHA20_POLY1305_AEAD_IV_SIZE)
+    {
+        return CRYPTO_LIB_ERR_UNSUPPORTED_ECS;
+    }
+
+    status = wc_ChaCha20Poly1305_Init(&aead, key, iv, is_encrypt);
+    if ((status == 0) && (aad_len > 0))
+    {
+        status = wc_ChaCha20Poly1305_UpdateAad(&aead, aad, aad_len);
+    }
+    if ((status == 0) && (len_data_in > 0))
+    {
+        status = wc_ChaCha20Poly1305_UpdateData(&aead, data_in, data_out, len_data_in);
+    }
+    if (status == 0)
+    {
+        // Final also wipes the Poly1305 state
+        status = wc_ChaCha20Poly1305_Final(&aead, tag);
+    }
+
+    return status;
+}
+
 static int32_t cryptography_aead_encrypt(uint8_t* data_out, size_t len_data_out,
                                          uint8_t* data_in, size_t len_data_in,
                                          uint8_t* key, uint32_t len_key,
@@ -465,6 +518,7 @@ static int32_t cryptography_aead_encrypt(uint8_t* data_out, size_t len_data_out,
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
     Aes enc;
+    uint8_t full_tag[CHACHA20_POLY1305_AEAD_AUTHTAG_SIZE];
 
     // Unused in this implementation
     acs = acs;
@@ -519,6 +573,25 @@ static int32_t cryptography_aead_encrypt(uint8_t* data_out, size_t len_data_out,
             status = CRYPTO_LIB_ERR_UNSUPPORTED_ACS;
             break;
 
+        case CRYPTO_CIPHER_CHACHA20_POLY1305:
+            if (mac_size > CHACHA20_POLY1305_AEAD_AUTHTAG_SIZE)
+            {
+                status = CRYPTO_LIB_ERR_MAC_RETRIEVAL_ERROR;
+                break;
+            }
+            status = cryptography_wolfssl_chacha20_poly1305(data_out, data_in,
+                                                            (encrypt_bool == CRYPTO_TRUE) ? len_data_in : 0,
+                                                            key, len_key, iv, iv_len,
+                                                            (aad_bool == CRYPTO_TRUE) ? aad : NULL,
+                                                            (aad_bool == CRYPTO_TRUE) ? aad_len : 0,
+                                                            full_tag, 1);
+            if ((status == CRYPTO_LIB_SUCCESS) && (authenticate_bool == CRYPTO_TRUE))
+            {
+                // Truncated to the SA MAC length
+                memcpy(mac, full_tag, mac_size);
+            }
+            break;
+
         default:
             status = CRYPTO_LIB_ERR_UNSUPPORTED_ECS;
             break;
@@ -606,6 +679,7 @@ static int32_t cryptography_aead_decrypt(uint8_t* data_out, size_t len_data_out,
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
     Aes dec;
+    uint8_t full_tag[CHACHA20_POLY1305_AEAD_AUTHTAG_SIZE];
     
     // Fix warnings
     acs = acs;
@@ -664,6 +738,38 @@ static int32_t cryptography_aead_decrypt(uint8_t* data_out, size_t len_data_out,
             status = CRYPTO_LIB_ERR_UNSUPPORTED_ECS;
             break;
 
+        case CRYPTO_CIPHER_CHACHA20_POLY1305:
+            if (mac_size > CHACHA20_POLY1305_AEAD_AUTHTAG_SIZE)
+            {
+                status = CRYPTO_LIB_ERR_MAC_VALIDATION_ERROR;
+                break;
+            }
+            status = cryptography_wolfssl_chacha20_poly1305(data_out, data_in,
+                                                            (decrypt_bool == CRYPTO_TRUE) ? len_data_in : 0,
+                                                            key, len_key, iv, iv_len,
+                                                            (aad_bool == CRYPTO_TRUE) ? aad : NULL,
+                                                            (aad_bool == CRYPTO_TRUE) ? aad_len : 0,
+                                                            full_tag, 0);
+            if ((status == CRYPTO_LIB_SUCCESS) && (decrypt_bool != CRYPTO_TRUE))
+            {
+                // If authentication only, don't decrypt the data. Just pass the data PDU through.
+                memcpy(data_out, data_in, len_data_in);
+            }
+            if ((status == CRYPTO_LIB_SUCCESS) && (authenticate_bool == CRYPTO_TRUE))
+            {
+                // Constant time compare of the possibly truncated received tag
+                uint8_t diff = 0;
+                for (uint32_t i = 0; i < mac_size; i++)
+                {
+                    diff |= full_tag[i] ^ mac[i];
+                }
+                if (diff != 0)
+                {
+                    status = CRYPTO_LIB_ERR_MAC_VALIDATION_ERROR;
+                }
+            }
+            break;
+
         default:
             status = CRYPTO_LIB_ERR_UNSUPPORTED_ECS;
             break;
@@ -729,6 +835,9 @@ int32_t cryptography_get_ecs_algo(int8_t algo_enum)
         case CRYPTO_CIPHER_AES256_CCM:
             algo = CRYPTO_CIPHER_AES256_CCM;
             break;
+        case CRYPTO_CIPHER_CHACHA20_POLY1305:
+            algo = CRYPTO_CIPHER_CHACHA20_POLY1305;
+            break;
 
         default:
 #ifdef DEBUG
@@ -17,26 +17,32 @@
 */
 #include "key_interface.h"
 
+#include <string.h>
+#include <sys/mman.h>
+
 /* Variables */
+// Key material for every key in one contiguous pool, the ring only holds handles into it
+static uint8_t key_pool[NUM_KEYS * KEY_SIZE] __attribute__((aligned(KEY_POOL_ALIGN)));
 static crypto_key_t key_ring[NUM_KEYS] = {0};
-static KeyInterfaceStruct key_if_struct;
+static uint8_t key_pool_locked = 0;
 
 /* Prototypes */
 static crypto_key_t* get_key(uint32_t key_id);
 static int32_t key_init(void);
 static int32_t key_shutdown(void);
 
+// Initialized at compile time so CRYPTO_DIRECT_CALL builds can call the module without indirection
+const KeyInterfaceStruct key_if_internal = {
+    /* Key Interface, SDLS */
+    .get_key = get_key,
+    .key_init = key_init,
+    .key_shutdown = key_shutdown,
+};
+
 /* Functions */
 KeyInterface get_key_interface_internal(void)
 {
-    /* Key Interface, SDLS */
-    key_if_struct.get_key = get_key;
-    key_if_struct.key_init = key_init;
-    key_if_struct.key_shutdown = key_shutdown;
-
-    /* Key Interface, SDLS-EP */
-
-    return &key_if_struct;
+    return (KeyInterface)&key_if_internal;
 }
 
 static crypto_key_t* get_key(uint32_t key_id)
@@ -55,13 +61,17 @@ static int32_t key_init(void)
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
 
+    // Keep key material out of swap, best effort as the process may lack the memlock limit
+    if (!key_pool_locked && (mlock(key_pool, sizeof(key_pool)) == 0))
+    {
+        key_pool_locked = 1;
+    }
+
     // Initialize all to zero
+    memset(key_pool, 0, sizeof(key_pool));
     for(uint32_t i = 0; i < NUM_KEYS; i++)
     {
-        for(uint32_t j = 0; j < KEY_SIZE; j++)
-        {
-            key_ring[i].value[j] = 0;
-        }
+        key_ring[i].value = &key_pool[i * KEY_SIZE];
         key_ring[i].key_len = 0;
         key_ring[i].key_state = 0;
     }
@@ -608,5 +618,12 @@ static int32_t key_init(void)
 
 static int32_t key_shutdown(void)
 {
+    // Zeroize before the pages can be swapped out again
+    memset(key_pool, 0, sizeof(key_pool));
+    if (key_pool_locked)
+    {
+        munlock(key_pool, sizeof(key_pool));
+        key_pool_locked = 0;
+    }
     return CRYPTO_LIB_SUCCESS;
 }
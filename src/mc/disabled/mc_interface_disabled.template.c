@@ -17,33 +17,33 @@
 */
 #include "mc_interface.h"
 
-/* Variables */
-static McInterfaceStruct mc_if_struct;
-
 /* Prototypes */
 static int32_t mc_initialize(void);
 static void mc_log(int32_t error_code);
 static int32_t mc_shutdown(void);
 
-/* Functions */
-McInterface get_mc_interface_disabled(void)
-{
+// Initialized at compile time so CRYPTO_DIRECT_CALL builds can call the module without indirection
+const McInterfaceStruct mc_if_disabled = {
     /* MC Interface, SDLS */
-    mc_if_struct.mc_initialize = mc_initialize;
-    mc_if_struct.mc_log = mc_log;
-    mc_if_struct.mc_shutdown = mc_shutdown;
+    .mc_initialize = mc_initialize,
+    .mc_log = mc_log,
+    .mc_shutdown = mc_shutdown,
 
     /* MC Interface, SDLS-EP */
     /*
-    mc_if_struct.mc_ping = mc_ping;
-    mc_if_struct.mc_log_status = mc_log_status;
-    mc_if_struct.mc_dump_log = mc_dump_log;
-    mc_if_struct.mc_erase_log = mc_erase_log;
-    mc_if_struct.mc_self_test = mc_self_test;
-    mc_if_struct.mc_alarm_reset_flag = mc_alarm_reset_flag;
+    .mc_ping = mc_ping,
+    .mc_log_status = mc_log_status,
+    .mc_dump_log = mc_dump_log,
+    .mc_erase_log = mc_erase_log,
+    .mc_self_test = mc_self_test,
+    .mc_alarm_reset_flag = mc_alarm_reset_flag,
     */
+};
 
-    return &mc_if_struct;
+/* Functions */
+McInterface get_mc_interface_disabled(void)
+{
+    return (McInterface)&mc_if_disabled;
 }
 
 static int32_t mc_initialize(void)
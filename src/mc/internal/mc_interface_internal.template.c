@@ -20,32 +20,71 @@
 
 /* Variables */
 static FILE* mc_file_ptr;
-static McInterfaceStruct mc_if_struct;
 
 /* Prototypes */
 static int32_t mc_initialize(void);
 static void mc_log(int32_t error_code);
+static void mc_log_event(const McEvent_t* event)
+{
+    time_t rawtime;
+    struct tm timeinfo_buf;
+    struct tm* timeinfo;
+    time(&rawtime);
+    timeinfo = localtime_r(&rawtime, &timeinfo_buf); // Reentrant, TM batch workers log concurrently
+
+    if ((mc_file_ptr == NULL) || (event == NULL))
+    {
+        return;
+    }
+
+    fprintf(mc_file_ptr, "[%d%d%d,%d:%d:%d], %d",
+        timeinfo->tm_year + 1900, timeinfo->tm_mon + 1,  timeinfo->tm_mday,
+        timeinfo->tm_hour, timeinfo->tm_min, timeinfo->tm_sec, event->code);
+    if (event->spi != MC_EVENT_SPI_NA)
+    {
+        fprintf(mc_file_ptr, ", SPI %d", event->spi);
+    }
+    if (event->has_gvcid)
+    {
+        fprintf(mc_file_ptr, ", GVCID %d/0x%04X/0x%02X", event->gvcid.tfvn, event->gvcid.scid, event->gvcid.vcid);
+    }
+    if (event->suppressed > 0)
+    {
+        fprintf(mc_file_ptr, ", %u suppressed", event->suppressed);
+    }
+    fprintf(mc_file_ptr, ", %s\n", (event->detail != NULL) ? event->detail : "");
+
+    return;
+}
+
 static int32_t mc_shutdown(void);
+static void mc_log_message(const char* message);
+static void mc_log_event(const McEvent_t* event);
 
-/* Functions */
-McInterface get_mc_interface_internal(void)
-{
+// Initialized at compile time so CRYPTO_DIRECT_CALL builds can call the module without indirection
+const McInterfaceStruct mc_if_internal = {
     /* MC Interface, SDLS */
-    mc_if_struct.mc_initialize = mc_initialize;
-    mc_if_struct.mc_log = mc_log;
-    mc_if_struct.mc_shutdown = mc_shutdown;
+    .mc_initialize = mc_initialize,
+    .mc_log = mc_log,
+    .mc_shutdown = mc_shutdown,
+    .mc_log_message = mc_log_message,
+    .mc_log_event = mc_log_event,
 
     /* MC Interface, SDLS-EP */
     /*
-    mc_if_struct.mc_ping = mc_ping;
-    mc_if_struct.mc_log_status = mc_log_status;
-    mc_if_struct.mc_dump_log = mc_dump_log;
-    mc_if_struct.mc_erase_log = mc_erase_log;
-    mc_if_struct.mc_self_test = mc_self_test;
-    mc_if_struct.mc_alarm_reset_flag = mc_alarm_reset_flag;
+    .mc_ping = mc_ping,
+    .mc_log_status = mc_log_status,
+    .mc_dump_log = mc_dump_log,
+    .mc_erase_log = mc_erase_log,
+    .mc_self_test = mc_self_test,
+    .mc_alarm_reset_flag = mc_alarm_reset_flag,
     */
+};
 
-    return &mc_if_struct;
+/* Functions */
+McInterface get_mc_interface_internal(void)
+{
+    return (McInterface)&mc_if_internal;
 }
 
 static int32_t mc_initialize(void)
@@ -66,12 +105,13 @@ static int32_t mc_initialize(void)
 static void mc_log(int32_t error_code)
 {
     time_t rawtime;
+    struct tm timeinfo_buf;
     struct tm* timeinfo;
     time(&rawtime);
-    timeinfo = localtime(&rawtime);
+    timeinfo = localtime_r(&rawtime, &timeinfo_buf);
 
     /* Write to log if error code is valid */
-    if (error_code != CRYPTO_LIB_SUCCESS)
+    if ((error_code != CRYPTO_LIB_SUCCESS) && (mc_file_ptr != NULL))
     {
         fprintf(mc_file_ptr, "[%d%d%d,%d:%d:%d], %d\n", 
             timeinfo->tm_year + 1900, timeinfo->tm_mon + 1,  timeinfo->tm_mday, 
@@ -88,10 +128,32 @@ static void mc_log(int32_t error_code)
     return;
 }
 
+static void mc_log_message(const char* message)
+{
+    time_t rawtime;
+    struct tm timeinfo_buf;
+    struct tm* timeinfo;
+    time(&rawtime);
+    timeinfo = localtime_r(&rawtime, &timeinfo_buf);
+
+    if ((mc_file_ptr != NULL) && (message != NULL))
+    {
+        fprintf(mc_file_ptr, "[%d%d%d,%d:%d:%d], %s\n", 
+            timeinfo->tm_year + 1900, timeinfo->tm_mon + 1,  timeinfo->tm_mday, 
+            timeinfo->tm_hour, timeinfo->tm_min, timeinfo->tm_sec, message);
+    }
+
+    return;
+}
+
 static int32_t mc_shutdown(void)
 {
     /* Close log */
-    fclose(mc_file_ptr);
+    if (mc_file_ptr != NULL)
+    {
+        fclose(mc_file_ptr);
+        mc_file_ptr = NULL;
+    }
 
     return CRYPTO_LIB_SUCCESS;
 }
@@ -39,8 +39,28 @@ static int32_t sa_delete(void);
 ** Global Variables
 */
 // Security
-static SaInterfaceStruct sa_if_struct;
-static SecurityAssociation_t sa[NUM_SA];
+static SecurityAssociation_t sa_table[NUM_SA];
+// Table the module operates on, the shared memory SADB points this at its segment
+static SecurityAssociation_t* sa = sa_table;
+
+// Initialized at compile time so CRYPTO_DIRECT_CALL builds can call the module without indirection
+const SaInterfaceStruct sa_if_inmemory = {
+    .sa_config = sa_config,
+    .sa_init = sa_init,
+    .sa_close = sa_close,
+    .sa_get_from_spi = sa_get_from_spi,
+    .sa_get_operational_sa_from_gvcid = sa_get_operational_sa_from_gvcid,
+    .sa_stop = sa_stop,
+    .sa_save_sa = sa_save_sa,
+    .sa_start = sa_start,
+    .sa_expire = sa_expire,
+    .sa_rekey = sa_rekey,
+    .sa_status = sa_status,
+    .sa_create = sa_create,
+    .sa_setARSN = sa_setARSN,
+    .sa_setARSNW = sa_setARSNW,
+    .sa_delete = sa_delete,
+};
 
 /**
  * @brief Function: get_sa_interface_inmemory
@@ -48,22 +68,17 @@ static SecurityAssociation_t sa[NUM_SA];
  **/
 SaInterface get_sa_interface_inmemory(void)
 {
-    sa_if_struct.sa_config = sa_config;
-    sa_if_struct.sa_init = sa_init;
-    sa_if_struct.sa_close = sa_close;
-    sa_if_struct.sa_get_from_spi = sa_get_from_spi;
-    sa_if_struct.sa_get_operational_sa_from_gvcid = sa_get_operational_sa_from_gvcid;
-    sa_if_struct.sa_stop = sa_stop;
-    sa_if_struct.sa_save_sa = sa_save_sa;
-    sa_if_struct.sa_start = sa_start;
-    sa_if_struct.sa_expire = sa_expire;
-    sa_if_struct.sa_rekey = sa_rekey;
-    sa_if_struct.sa_status = sa_status;
-    sa_if_struct.sa_create = sa_create;
-    sa_if_struct.sa_setARSN = sa_setARSN;
-    sa_if_struct.sa_setARSNW = sa_setARSNW;
-    sa_if_struct.sa_delete = sa_delete;
-    return &sa_if_struct;
+    return (SaInterface)&sa_if_inmemory;
+}
+
+/**
+ * @brief Function: sa_inmemory_bind_table
+ * Points every in-memory SA function at the given table of NUM_SA entries
+ * @param table: SecurityAssociation_t*, NULL restores the module's own table
+ **/
+void sa_inmemory_bind_table(SecurityAssociation_t* table)
+{
+    sa = (table == NULL) ? sa_table : table;
 }
 
 /**
@@ -997,7 +1012,7 @@ static int32_t sa_start(TC_t* tc_frame)
                 gvcid.scid = (sdls_frame.pdu.data[count] << 12) | (sdls_frame.pdu.data[count + 1] << 4) |
                              (sdls_frame.pdu.data[count + 2] >> 4);
                 gvcid.vcid = (sdls_frame.pdu.data[count + 2] << 4) | (sdls_frame.pdu.data[count + 3] && 0x3F);
-                if (current_managed_parameters_struct.has_segmentation_hdr == TC_HAS_SEGMENT_HDRS)
+                if (current_managed_parameters->has_segmentation_hdr == TC_HAS_SEGMENT_HDRS)
                 {
                     gvcid.mapid = (sdls_frame.pdu.data[count + 3]);
                 }
@@ -0,0 +1,889 @@
+/*
+ * Copyright 2021, by the California Institute of Technology.
+ * ALL RIGHTS RESERVED. United States Government Sponsorship acknowledged.
+ * Any commercial use must be negotiated with the Office of Technology
+ * Transfer at the California Institute of Technology.
+ *
+ * This software may be subject to U.S. export control laws. By accepting
+ * this software, the user agrees to comply with all applicable U.S.
+ * export laws and regulations. User has the responsibility to obtain
+ * export licenses, or other export authority as may be required before
+ * exporting such information to foreign countries or providing access to
+ * foreign persons.
+ */
+
+/*
+** Shared Memory SADB
+** The in-memory SA table placed in a POSIX shared memory object so every CryptoLib process on the host works
+** against the same SAs and IV/ARSN counters. The first process to map the object populates it with the
+** in-memory defaults, later processes attach to it as is.
+**
+** Readers never take a lock: every SA carries a sequence number that is odd while a writer updates it, and a
+** reader copies the SA into a process local slot until it gets a stable copy. The core keeps working on that
+** local copy and publishes its counters back through sa_save_sa. Writers serialize on a process-shared mutex.
+*/
+#include "crypto.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+// Segment states
+#define SA_SHM_STATE_EMPTY 0
+#define SA_SHM_STATE_POPULATING 1
+#define SA_SHM_STATE_READY 2
+
+/*
+** Segment Layout
+*/
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t sa_size;
+    uint32_t num_sa;
+    uint32_t state;     // SA_SHM_STATE_*, accessed atomically
+    uint32_t index_seq; // Odd while the GVCID index is rebuilt
+    pthread_mutex_t lock;
+    uint32_t seq[NUM_SA]; // Per SA, odd while the SA is written
+    uint16_t gvcid_index[SA_SHM_GVCID_BUCKETS]; // SPI + 1 of operational SAs, 0 marks an empty slot
+    SecurityAssociation_t sa[NUM_SA];
+} sa_shm_segment_t;
+
+// Security Association Initialization Functions
+static int32_t sa_config(void);
+static int32_t sa_init(void);
+static int32_t sa_close(void);
+// Security Association Interaction Functions
+static int32_t sa_get_from_spi(uint16_t, SecurityAssociation_t**);
+static int32_t sa_get_operational_sa_from_gvcid(uint8_t, uint16_t, uint16_t, uint8_t, SecurityAssociation_t**);
+static int32_t sa_save_sa(SecurityAssociation_t* sa);
+static int32_t sa_reserve_counters(SecurityAssociation_t* sa, uint32_t count, uint8_t* iv, uint8_t* arsn);
+// Security Association Utility Functions
+static int32_t sa_stop(void);
+static int32_t sa_start(TC_t* tc_frame);
+static int32_t sa_expire(void);
+static int32_t sa_rekey(void);
+static int32_t sa_status(uint8_t* );
+static int32_t sa_create(void);
+static int32_t sa_setARSN(void);
+static int32_t sa_setARSNW(void);
+static int32_t sa_delete(void);
+
+/*
+** Global Variables
+*/
+static sa_shm_segment_t* sa_shm = NULL;
+static int sa_shm_fd = -1;
+// Process local copies handed to the core, and the sequence number each was copied at
+static SecurityAssociation_t sa_local[NUM_SA];
+static uint32_t sa_local_seq[NUM_SA];
+
+const SaInterfaceStruct sa_if_shm = {
+    .sa_config = sa_config,
+    .sa_init = sa_init,
+    .sa_close = sa_close,
+    .sa_get_from_spi = sa_get_from_spi,
+    .sa_get_operational_sa_from_gvcid = sa_get_operational_sa_from_gvcid,
+    .sa_stop = sa_stop,
+    .sa_save_sa = sa_save_sa,
+    .sa_reserve_counters = sa_reserve_counters,
+    .sa_start = sa_start,
+    .sa_expire = sa_expire,
+    .sa_rekey = sa_rekey,
+    .sa_status = sa_status,
+    .sa_create = sa_create,
+    .sa_setARSN = sa_setARSN,
+    .sa_setARSNW = sa_setARSNW,
+    .sa_delete = sa_delete,
+};
+
+/**
+ * @brief Function: get_sa_interface_shm
+ * @return SaInterface
+ **/
+SaInterface get_sa_interface_shm(void)
+{
+    return (SaInterface)&sa_if_shm;
+}
+
+/**
+ * @brief Function: sa_shm_gvcid_slot
+ * Home slot of a channel in the GVCID index, the MAP ID is checked against the SA itself
+ * @param tfvn: uint8
+ * @param scid: uint16
+ * @param vcid: uint16
+ * @return uint32: Index slot
+ **/
+static uint32_t sa_shm_gvcid_slot(uint8_t tfvn, uint16_t scid, uint16_t vcid)
+{
+    uint32_t hash = ((uint32_t)tfvn << 26) ^ ((uint32_t)scid << 6) ^ (uint32_t)vcid;
+    hash *= 0x9E3779B1;
+    return (hash >> 16) & (SA_SHM_GVCID_BUCKETS - 1);
+}
+
+/**
+ * @brief Function: sa_shm_write_begin
+ * Marks an SA as being written, caller holds the segment lock
+ * @param seq: uint32_t*
+ **/
+static void sa_shm_write_begin(uint32_t* seq)
+{
+    __atomic_fetch_add(seq, 1, __ATOMIC_SEQ_CST);
+}
+
+/**
+ * @brief Function: sa_shm_write_end
+ * Publishes an SA written since sa_shm_write_begin
+ * @param seq: uint32_t*
+ **/
+static void sa_shm_write_end(uint32_t* seq)
+{
+    __atomic_fetch_add(seq, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Function: sa_shm_lock
+ * Takes the writer lock. A writer that died holding it leaves its sequence numbers odd, those are closed out
+ * so readers do not spin forever on an SA that will never finish updating.
+ * @return int32: Success/Failure
+ **/
+static int32_t sa_shm_lock(void)
+{
+    int i;
+    int rc = pthread_mutex_lock(&sa_shm->lock);
+
+    if (rc == EOWNERDEAD)
+    {
+        for (i = 0; i < NUM_SA; i++)
+        {
+            if (__atomic_load_n(&sa_shm->seq[i], __ATOMIC_RELAXED) & 1)
+            {
+                sa_shm_write_end(&sa_shm->seq[i]);
+            }
+        }
+        if (__atomic_load_n(&sa_shm->index_seq, __ATOMIC_RELAXED) & 1)
+        {
+            sa_shm_write_end(&sa_shm->index_seq);
+        }
+        rc = pthread_mutex_consistent(&sa_shm->lock);
+    }
+    if (rc != 0)
+    {
+        return CRYPTO_LIB_ERR_SA_SHM_LOCK;
+    }
+    return CRYPTO_LIB_SUCCESS;
+}
+
+/**
+ * @brief Function: sa_shm_unlock
+ **/
+static void sa_shm_unlock(void)
+{
+    pthread_mutex_unlock(&sa_shm->lock);
+}
+
+/**
+ * @brief Function: sa_shm_rebuild_index
+ * Indexes the operational SAs by channel, caller holds the segment lock.
+ * SAs are inserted in SPI order so a probe finds the same SA the in-memory linear search would.
+ **/
+static void sa_shm_rebuild_index(void)
+{
+    uint32_t slot;
+    uint32_t probe;
+    uint16_t spi;
+    SecurityAssociation_t* sa_ptr;
+
+    sa_shm_write_begin(&sa_shm->index_seq);
+    memset(sa_shm->gvcid_index, 0, sizeof(sa_shm->gvcid_index));
+    for (spi = 0; spi < NUM_SA; spi++)
+    {
+        sa_ptr = &sa_shm->sa[spi];
+        if (sa_ptr->sa_state != SA_OPERATIONAL)
+        {
+            continue;
+        }
+        slot = sa_shm_gvcid_slot(sa_ptr->gvcid_blk.tfvn, sa_ptr->gvcid_blk.scid, sa_ptr->gvcid_blk.vcid);
+        for (probe = 0; probe < SA_SHM_GVCID_BUCKETS; probe++)
+        {
+            if (sa_shm->gvcid_index[slot] == 0)
+            {
+                sa_shm->gvcid_index[slot] = spi + 1;
+                break;
+            }
+            slot = (slot + 1) & (SA_SHM_GVCID_BUCKETS - 1);
+        }
+    }
+    sa_shm_write_end(&sa_shm->index_seq);
+}
+
+/**
+ * @brief Function: sa_shm_read
+ * Refreshes the local copy of an SA if the shared one changed since it was last copied
+ * @param spi: uint16
+ **/
+static void sa_shm_read(uint16_t spi)
+{
+    uint32_t seq = __atomic_load_n(&sa_shm->seq[spi], __ATOMIC_ACQUIRE);
+    uint32_t check;
+
+    if (((seq & 1) == 0) && (seq == sa_local_seq[spi]))
+    {
+        return;
+    }
+    for (;;)
+    {
+        while (seq & 1)
+        {
+            sched_yield();
+            seq = __atomic_load_n(&sa_shm->seq[spi], __ATOMIC_ACQUIRE);
+        }
+        memcpy(&sa_local[spi], &sa_shm->sa[spi], SA_SIZE);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        check = __atomic_load_n(&sa_shm->seq[spi], __ATOMIC_RELAXED);
+        if (check == seq)
+        {
+            break;
+        }
+        seq = check;
+    }
+    sa_local_seq[spi] = seq;
+}
+
+/**
+ * @brief Function: sa_shm_merge_counter
+ * Keeps the larger of the shared and local big-endian counters in both, counters never move backwards when
+ * processes publish out of order
+ * @param shared: uint8_t*
+ * @param local: uint8_t*
+ * @param len: uint8
+ **/
+static void sa_shm_merge_counter(uint8_t* shared, uint8_t* local, uint8_t len)
+{
+    if (len == 0)
+    {
+        return;
+    }
+    if (memcmp(local, shared, len) > 0)
+    {
+        memcpy(shared, local, len);
+    }
+    else
+    {
+        memcpy(local, shared, len);
+    }
+}
+
+/**
+ * @brief Function: sa_shm_manage_begin
+ * Management services rewrite arbitrary SAs through the in-memory module, every SA is marked as being written
+ * @return int32: Success/Failure
+ **/
+static int32_t sa_shm_manage_begin(void)
+{
+    int32_t status;
+    int i;
+
+    if (sa_shm == NULL)
+    {
+        return CRYPTO_LIB_ERR_SA_SHM_MAP;
+    }
+    status = sa_shm_lock();
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        return status;
+    }
+    for (i = 0; i < NUM_SA; i++)
+    {
+        sa_shm_write_begin(&sa_shm->seq[i]);
+    }
+    return status;
+}
+
+/**
+ * @brief Function: sa_shm_manage_end
+ **/
+static void sa_shm_manage_end(void)
+{
+    int i;
+
+    for (i = 0; i < NUM_SA; i++)
+    {
+        sa_shm_write_end(&sa_shm->seq[i]);
+    }
+    sa_shm_rebuild_index();
+    sa_shm_unlock();
+}
+
+/**
+ * @brief Function: sa_shm_populate
+ * Lays out a fresh segment and fills it with the in-memory defaults
+ * @return int32: Success/Failure
+ **/
+static int32_t sa_shm_populate(void)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    pthread_mutexattr_t attr;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+    if (pthread_mutex_init(&sa_shm->lock, &attr) != 0)
+    {
+        status = CRYPTO_LIB_ERR_SA_SHM_LOCK;
+    }
+    pthread_mutexattr_destroy(&attr);
+
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        sa_shm->magic = SA_SHM_MAGIC;
+        sa_shm->version = SA_SHM_VERSION;
+        sa_shm->sa_size = SA_SIZE;
+        sa_shm->num_sa = NUM_SA;
+        status = get_sa_interface_inmemory()->sa_init();
+    }
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        sa_shm_rebuild_index();
+        __atomic_store_n(&sa_shm->state, SA_SHM_STATE_READY, __ATOMIC_RELEASE);
+    }
+    else
+    {
+        // Let the next process try again
+        __atomic_store_n(&sa_shm->state, SA_SHM_STATE_EMPTY, __ATOMIC_RELEASE);
+    }
+    return status;
+}
+
+/**
+ * @brief Function: sa_shm_attach
+ * Waits for the process populating the segment and checks it was laid out by a compatible build
+ * @return int32: Success/Failure
+ **/
+static int32_t sa_shm_attach(void)
+{
+    struct timespec delay = {0, 1000000};
+    int waited_ms = 0;
+
+    while (__atomic_load_n(&sa_shm->state, __ATOMIC_ACQUIRE) != SA_SHM_STATE_READY)
+    {
+        if (waited_ms++ >= SA_SHM_INIT_TIMEOUT_MS)
+        {
+            return CRYPTO_LIB_ERR_SA_SHM_LOCK;
+        }
+        nanosleep(&delay, NULL);
+    }
+    if ((sa_shm->magic != SA_SHM_MAGIC) || (sa_shm->version != SA_SHM_VERSION) || (sa_shm->sa_size != SA_SIZE) ||
+        (sa_shm->num_sa != NUM_SA))
+    {
+        return CRYPTO_LIB_ERR_SA_SHM_INCOMPATIBLE;
+    }
+    return CRYPTO_LIB_SUCCESS;
+}
+
+/**
+ * @brief Function: sa_config
+ * The segment is populated once by sa_init, configuring again would reset counters other processes rely on
+ * @return int32: Success/Failure
+ **/
+static int32_t sa_config(void)
+{
+    return CRYPTO_LIB_SUCCESS;
+}
+
+/**
+ * @brief Function: sa_init
+ * Maps the shared SA table, populating it if this process created it
+ * @return int32: Success/Failure
+ **/
+static int32_t sa_init(void)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    struct stat st;
+    uint32_t expected = SA_SHM_STATE_EMPTY;
+    int i;
+
+    if (sa_shm != NULL)
+    {
+        sa_close();
+    }
+
+    sa_shm_fd = shm_open(SA_SHM_NAME, O_CREAT | O_RDWR, 0600);
+    if ((sa_shm_fd < 0) || (fstat(sa_shm_fd, &st) != 0))
+    {
+        status = CRYPTO_LIB_ERR_SA_SHM_MAP;
+    }
+    // Sizing a new object to the same length twice is harmless, any other length is another layout
+    else if ((st.st_size == 0) && (ftruncate(sa_shm_fd, sizeof(sa_shm_segment_t)) != 0))
+    {
+        status = CRYPTO_LIB_ERR_SA_SHM_MAP;
+    }
+    else if ((st.st_size != 0) && (st.st_size != (off_t)sizeof(sa_shm_segment_t)))
+    {
+        status = CRYPTO_LIB_ERR_SA_SHM_INCOMPATIBLE;
+    }
+
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        sa_shm = (sa_shm_segment_t*)mmap(NULL, sizeof(sa_shm_segment_t), PROT_READ | PROT_WRITE, MAP_SHARED,
+                                         sa_shm_fd, 0);
+        if (sa_shm == MAP_FAILED)
+        {
+            sa_shm = NULL;
+            status = CRYPTO_LIB_ERR_SA_SHM_MAP;
+        }
+    }
+
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        // The in-memory management and lookup code runs on the shared table from here on
+        sa_inmemory_bind_table(sa_shm->sa);
+        for (i = 0; i < NUM_SA; i++)
+        {
+            sa_local_seq[i] = 1; // Odd, never a published sequence number
+        }
+        if (__atomic_compare_exchange_n(&sa_shm->state, &expected, SA_SHM_STATE_POPULATING, 0, __ATOMIC_ACQ_REL,
+                                        __ATOMIC_ACQUIRE))
+        {
+            status = sa_shm_populate();
+        }
+        else
+        {
+            status = sa_shm_attach();
+        }
+    }
+
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        sa_close();
+        CRYPTO_MC_IF->mc_log(status);
+    }
+    return status;
+}
+
+/**
+ * @brief Function: sa_close
+ * Unmaps the segment, it stays in place for the other processes
+ * @return int32: Success/Failure
+ **/
+static int32_t sa_close(void)
+{
+    if (sa_shm != NULL)
+    {
+        sa_inmemory_bind_table(NULL);
+        munmap(sa_shm, sizeof(sa_shm_segment_t));
+        sa_shm = NULL;
+    }
+    if (sa_shm_fd >= 0)
+    {
+        close(sa_shm_fd);
+        sa_shm_fd = -1;
+    }
+    return CRYPTO_LIB_SUCCESS;
+}
+
+/*
+** Security Association Interaction Functions
+*/
+/**
+ * @brief Function: sa_get_from_spi
+ * @param spi: uint16
+ * @param security_association: SecurityAssociation_t**
+ * @return int32: Success/Failure
+ **/
+static int32_t sa_get_from_spi(uint16_t spi, SecurityAssociation_t** security_association)
+{
+    if (spi >= NUM_SA)
+    {
+        return CRYPTO_LIB_ERR_SPI_INDEX_OOB;
+    }
+    if (sa_shm == NULL)
+    {
+        return CRYPTO_LIB_ERR_SA_SHM_MAP;
+    }
+    sa_shm_read(spi);
+    *security_association = &sa_local[spi];
+
+    if ((sa_local[spi].abm_len == 0) && sa_local[spi].ast)
+    {
+        return CRYPTO_LIB_ERR_NULL_ABM;
+    } // Must have abm if doing authentication
+#ifdef SA_DEBUG
+    printf(KYEL "DEBUG - Printing local copy of SA Entry for current SPI.\n" RESET);
+    Crypto_saPrint(*security_association);
+#endif
+    return CRYPTO_LIB_SUCCESS;
+}
+
+/**
+ * @brief Function: sa_get_operational_sa_from_gvcid
+ * Looks the channel up in the shared GVCID index. Misses take the in-memory search under the lock, which
+ * also works out the most specific error code.
+ * @param tfvn: uint8
+ * @param scid: uint16
+ * @param vcid: uint16
+ * @param mapid: uint8 // tc only
+ * @param security_association: SecurityAssociation_t**
+ * @return int32: Success/Failure
+ **/
+static int32_t sa_get_operational_sa_from_gvcid(uint8_t tfvn, uint16_t scid, uint16_t vcid, uint8_t mapid,
+                                                SecurityAssociation_t** security_association)
+{
+    int32_t status = CRYPTO_LIB_ERR_NO_OPERATIONAL_SA;
+    SecurityAssociation_t* sa_ptr = NULL;
+    SecurityAssociation_t* found = NULL;
+    uint32_t index_seq;
+    uint32_t slot;
+    uint32_t probe;
+    uint16_t entry;
+
+    if (sa_shm == NULL)
+    {
+        return CRYPTO_LIB_ERR_SA_SHM_MAP;
+    }
+
+    for (;;)
+    {
+        index_seq = __atomic_load_n(&sa_shm->index_seq, __ATOMIC_ACQUIRE);
+        if (index_seq & 1)
+        {
+            sched_yield();
+            continue;
+        }
+        found = NULL;
+        slot = sa_shm_gvcid_slot(tfvn, scid, vcid);
+        for (probe = 0; probe < SA_SHM_GVCID_BUCKETS; probe++)
+        {
+            entry = __atomic_load_n(&sa_shm->gvcid_index[slot], __ATOMIC_RELAXED);
+            if (entry == 0)
+            {
+                break;
+            }
+            sa_shm_read(entry - 1);
+            sa_ptr = &sa_local[entry - 1];
+            if ((sa_ptr->gvcid_blk.tfvn == tfvn) && (sa_ptr->gvcid_blk.scid == scid) &&
+                (sa_ptr->gvcid_blk.vcid == vcid) && (sa_ptr->sa_state == SA_OPERATIONAL) &&
+                (crypto_config.unique_sa_per_mapid == TC_UNIQUE_SA_PER_MAP_ID_FALSE ||
+                 sa_ptr->gvcid_blk.mapid == mapid))
+            {
+                found = sa_ptr;
+                break;
+            }
+            slot = (slot + 1) & (SA_SHM_GVCID_BUCKETS - 1);
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&sa_shm->index_seq, __ATOMIC_RELAXED) == index_seq)
+        {
+            break;
+        }
+    }
+
+    if (found == NULL)
+    {
+        status = sa_shm_lock();
+        if (status != CRYPTO_LIB_SUCCESS)
+        {
+            return status;
+        }
+        status = get_sa_interface_inmemory()->sa_get_operational_sa_from_gvcid(tfvn, scid, vcid, mapid, &sa_ptr);
+        if ((status == CRYPTO_LIB_SUCCESS) || (status == CRYPTO_LIB_ERR_NULL_ABM))
+        {
+            // Became operational after the index was read, no writer can be active while the lock is held
+            found = &sa_local[sa_ptr->spi];
+            memcpy(found, sa_ptr, SA_SIZE);
+            sa_local_seq[sa_ptr->spi] = __atomic_load_n(&sa_shm->seq[sa_ptr->spi], __ATOMIC_RELAXED);
+        }
+        sa_shm_unlock();
+        if (found == NULL)
+        {
+            return status;
+        }
+    }
+
+    *security_association = found;
+    // Must have ABM if doing authentication
+    if (found->ast && found->abm_len <= 0)
+    {
+        return CRYPTO_LIB_ERR_NULL_ABM;
+    }
+#ifdef SA_DEBUG
+    printf("Valid operational SA found at index %d.\n", found->spi);
+    printf("\t Tfvn: %d\n", tfvn);
+    printf("\t Scid: %d\n", scid);
+    printf("\t Vcid: %d\n", vcid);
+#endif
+    return CRYPTO_LIB_SUCCESS;
+}
+
+/**
+ * @brief Function: sa_save_sa
+ * Publishes the IV and ARSN of an SA. Only the counters are written back, configuration changes go through
+ * the management services so a stale local copy can never undo them.
+ * @param sa: SecurityAssociation_t*
+ * @return int32: Success/Failure
+ **/
+static int32_t sa_save_sa(SecurityAssociation_t* sa)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    SecurityAssociation_t* shared;
+    uint16_t spi;
+
+    if (sa == NULL)
+    {
+        return CRYPTO_LIB_ERR_NULL_SA;
+    }
+    spi = sa->spi;
+    if (spi >= NUM_SA)
+    {
+        return CRYPTO_LIB_ERR_SPI_INDEX_OOB;
+    }
+    if (sa_shm == NULL)
+    {
+        return CRYPTO_LIB_ERR_SA_SHM_MAP;
+    }
+
+    status = sa_shm_lock();
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        return status;
+    }
+    shared = &sa_shm->sa[spi];
+    sa_shm_write_begin(&sa_shm->seq[spi]);
+    // Lengths differ only if another process reconfigured the SA, its counters then no longer compare
+    if (shared->iv_len == sa->iv_len)
+    {
+        sa_shm_merge_counter(shared->iv, sa->iv, sa->iv_len);
+    }
+    if (shared->arsn_len == sa->arsn_len)
+    {
+        sa_shm_merge_counter(shared->arsn, sa->arsn, sa->arsn_len);
+    }
+    sa_shm_write_end(&sa_shm->seq[spi]);
+    if (sa == &sa_local[spi])
+    {
+        sa_local_seq[spi] = __atomic_load_n(&sa_shm->seq[spi], __ATOMIC_RELAXED);
+    }
+    sa_shm_unlock();
+    return status;
+}
+
+/**
+ * @brief Function: sa_reserve_counters
+ * Reserves count IV/ARSN values from the shared SA, so producers in different processes never send the same
+ * counter.  The first reserved values are copied out and both the shared SA and the local copy move past them.
+ * @param sa: SecurityAssociation_t*
+ * @param count: uint32
+ * @param iv: uint8_t*
+ * @param arsn: uint8_t*
+ * @return int32: Success/Failure
+ **/
+static int32_t sa_reserve_counters(SecurityAssociation_t* sa, uint32_t count, uint8_t* iv, uint8_t* arsn)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    SecurityAssociation_t* shared;
+    uint16_t spi;
+
+    if (sa == NULL)
+    {
+        return CRYPTO_LIB_ERR_NULL_SA;
+    }
+    spi = sa->spi;
+    if (spi >= NUM_SA)
+    {
+        return CRYPTO_LIB_ERR_SPI_INDEX_OOB;
+    }
+    if (sa_shm == NULL)
+    {
+        return CRYPTO_LIB_ERR_SA_SHM_MAP;
+    }
+
+    status = sa_shm_lock();
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        return status;
+    }
+    shared = &sa_shm->sa[spi];
+    sa_shm_write_begin(&sa_shm->seq[spi]);
+    if (shared->iv_len == sa->iv_len)
+    {
+        sa_shm_merge_counter(shared->iv, sa->iv, sa->iv_len);
+    }
+    if (shared->arsn_len == sa->arsn_len)
+    {
+        sa_shm_merge_counter(shared->arsn, sa->arsn, sa->arsn_len);
+    }
+    memcpy(iv, sa->iv, IV_SIZE);
+    memcpy(arsn, sa->arsn, ARSN_SIZE);
+    Crypto_SA_Counters_Advance(sa, count);
+    if (shared->iv_len == sa->iv_len)
+    {
+        memcpy(shared->iv, sa->iv, sa->iv_len);
+    }
+    if (shared->arsn_len == sa->arsn_len)
+    {
+        memcpy(shared->arsn, sa->arsn, sa->arsn_len);
+    }
+    sa_shm_write_end(&sa_shm->seq[spi]);
+    if (sa == &sa_local[spi])
+    {
+        sa_local_seq[spi] = __atomic_load_n(&sa_shm->seq[spi], __ATOMIC_RELAXED);
+    }
+    sa_shm_unlock();
+    return status;
+}
+
+/*
+** Security Association Management Services
+** Run the in-memory implementations on the shared table under the writer lock
+*/
+/**
+ * @brief sa_start
+ * @param tc_frame: TC_t
+ * @return int32: Success/Failure
+ **/
+static int32_t sa_start(TC_t* tc_frame)
+{
+    int32_t status = sa_shm_manage_begin();
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        status = get_sa_interface_inmemory()->sa_start(tc_frame);
+        sa_shm_manage_end();
+    }
+    return status;
+}
+
+/**
+ * @brief Function: sa_stop
+ * @return int32: Success/Failure
+ **/
+static int32_t sa_stop(void)
+{
+    int32_t status = sa_shm_manage_begin();
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        status = get_sa_interface_inmemory()->sa_stop();
+        sa_shm_manage_end();
+    }
+    return status;
+}
+
+/**
+ * @brief Function: sa_rekey
+ * @return int32: Success/Failure
+ **/
+static int32_t sa_rekey(void)
+{
+    int32_t status = sa_shm_manage_begin();
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        status = get_sa_interface_inmemory()->sa_rekey();
+        sa_shm_manage_end();
+    }
+    return status;
+}
+
+/**
+ * @brief Function: sa_expire
+ * @return int32: Success/Failure
+ **/
+static int32_t sa_expire(void)
+{
+    int32_t status = sa_shm_manage_begin();
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        status = get_sa_interface_inmemory()->sa_expire();
+        sa_shm_manage_end();
+    }
+    return status;
+}
+
+/**
+ * @brief Function: sa_create
+ * @return int32: Success/Failure
+ **/
+static int32_t sa_create(void)
+{
+    int32_t status = sa_shm_manage_begin();
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        status = get_sa_interface_inmemory()->sa_create();
+        sa_shm_manage_end();
+    }
+    return status;
+}
+
+/**
+ * @brief Function: sa_delete
+ * @return int32: Success/Failure
+ **/
+static int32_t sa_delete(void)
+{
+    int32_t status = sa_shm_manage_begin();
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        status = get_sa_interface_inmemory()->sa_delete();
+        sa_shm_manage_end();
+    }
+    return status;
+}
+
+/**
+ * @brief Function: sa_setARSN
+ * @return int32: Success/Failure
+ **/
+static int32_t sa_setARSN(void)
+{
+    int32_t status = sa_shm_manage_begin();
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        status = get_sa_interface_inmemory()->sa_setARSN();
+        sa_shm_manage_end();
+    }
+    return status;
+}
+
+/**
+ * @brief Function: sa_setARSNW
+ * @return int32: Success/Failure
+ **/
+static int32_t sa_setARSNW(void)
+{
+    int32_t status = sa_shm_manage_begin();
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        status = get_sa_interface_inmemory()->sa_setARSNW();
+        sa_shm_manage_end();
+    }
+    return status;
+}
+
+/**
+ * @brief Function: sa_status
+ * @param ingest: uint8_t*
+ * @return int32: Success/Failure
+ **/
+static int32_t sa_status(uint8_t* ingest)
+{
+    int32_t status;
+
+    if (sa_shm == NULL)
+    {
+        return CRYPTO_LIB_ERR_SA_SHM_MAP;
+    }
+    status = sa_shm_lock();
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        status = get_sa_interface_inmemory()->sa_status(ingest);
+        sa_shm_unlock();
+    }
+    return status;
+}
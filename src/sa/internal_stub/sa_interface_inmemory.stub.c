@@ -21,3 +21,9 @@ SaInterface get_sa_interface_inmemory(void)
     fprintf(stderr,"ERROR: Loading internal stub source code. Rebuild CryptoLib with -DSA_MARIADB=OFF to use proper internal implementation.\n");
     return &sa_routine;
 }
+
+SaInterface get_sa_interface_shm(void)
+{
+    fprintf(stderr,"ERROR: Loading internal stub source code. Rebuild CryptoLib with -DSA_INTERNAL=ON to use the shared memory SADB.\n");
+    return &sa_routine;
+}
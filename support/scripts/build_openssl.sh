@@ -0,0 +1,14 @@
+#!/bin/bash -i
+#
+# Convenience script for CryptoLib development
+# Will build in current directory
+#
+#  ./build_openssl.sh
+#
+
+SCRIPT_DIR=$( cd -- "$( dirname -- "${BASH_SOURCE[0]}" )" &> /dev/null && pwd )
+source $SCRIPT_DIR/env.sh
+
+rm $BASE_DIR/CMakeCache.txt
+
+cmake $BASE_DIR -DCODECOV=1 -DDEBUG=1 -DCRYPTO_LIBGCRYPT=0 -DCRYPTO_OPENSSL=1 -DTEST=1 -DTEST_ENC=1 -DSA_FILE=1 && make && make test
@@ -31,6 +31,13 @@ static volatile uint8_t tc_seq_num = 0;
 static volatile uint8_t tc_vcid = CRYPTO_STANDALONE_FRAMING_VCID;
 static volatile uint8_t tc_debug = 0;
 static volatile uint8_t tm_debug = 0;
+static volatile uint32_t batch_size = CRYPTO_STANDALONE_DEFAULT_BATCH;
+static volatile uint32_t batch_timeout_us = CRYPTO_STANDALONE_DEFAULT_TIMEOUT_US;
+static udp_stats_t tc_stats;
+static udp_stats_t tm_stats;
+static crypto_standalone_worker_t* workers = NULL;
+static uint32_t num_workers = 0;
+static pthread_rwlock_t crypto_lock = PTHREAD_RWLOCK_INITIALIZER;
 
 
 /*
@@ -62,13 +69,16 @@ void crypto_standalone_print_help(void)
 {
     printf(CRYPTO_PROMPT "command [args]\n"
                          "----------------------------------------------------------------------\n"
+                         "batch # #                          - Set batch size and timeout (us)  \n"
                          "exit                               - Exit app                         \n"
                          "help                               - Display help                     \n"
                          "noop                               - No operation command to device   \n"
                          "reset                              - Reset CryptoLib                  \n"
+                         "stats                              - Display TC / TM socket counters  \n"
                          "tc                                 - Toggle TC debug prints           \n"
                          "tm                                 - Toggle TM debug prints           \n"
                          "vcid #                             - Change active TC virtual channel \n"
+                         "workers                            - Display gateway worker usage     \n"
                          "\n");
 }
 
@@ -108,6 +118,18 @@ int32_t crypto_standalone_get_command(const char* str)
     {
         status = CRYPTO_CMD_TM_DEBUG;
     }
+    else if (strcmp(lcmd, "batch") == 0)
+    {
+        status = CRYPTO_CMD_BATCH;
+    }
+    else if (strcmp(lcmd, "stats") == 0)
+    {
+        status = CRYPTO_CMD_STATS;
+    }
+    else if (strcmp(lcmd, "workers") == 0)
+    {
+        status = CRYPTO_CMD_WORKERS;
+    }
     return status;
 }
 
@@ -210,6 +232,46 @@ int32_t crypto_standalone_process_command(int32_t cc, int32_t num_tokens, char*
         }
         break;
 
+    case CRYPTO_CMD_BATCH:
+        if (crypto_standalone_check_number_arguments(num_tokens, 2) == CRYPTO_LIB_SUCCESS)
+        {
+            int new_size = atoi(&tokens[0]);
+            int new_timeout = atoi(&tokens[CRYPTO_MAX_INPUT_TOKEN_SIZE]);
+            if ((new_size < 1) || (new_size > CRYPTO_STANDALONE_MAX_BATCH))
+            {
+                printf("Error - batch size must be between 1 and %d! Sticking with prior size %d \n",
+                       CRYPTO_STANDALONE_MAX_BATCH, batch_size);
+            }
+            else if (new_timeout < 1)
+            {
+                printf("Error - batch timeout must be greater than zero! Sticking with prior timeout %d us \n",
+                       batch_timeout_us);
+            }
+            else
+            {
+                batch_size = (uint32_t)new_size;
+                batch_timeout_us = (uint32_t)new_timeout;
+                printf("Changed batch size to %d and timeout to %d us \n", batch_size, batch_timeout_us);
+            }
+        }
+        break;
+
+    case CRYPTO_CMD_STATS:
+        if (crypto_standalone_check_number_arguments(num_tokens, 0) == CRYPTO_LIB_SUCCESS)
+        {
+            printf("Batch size %d, timeout %d us \n", batch_size, batch_timeout_us);
+            crypto_standalone_print_stats("TC Apply", &tc_stats);
+            crypto_standalone_print_stats("TM Process", &tm_stats);
+        }
+        break;
+
+    case CRYPTO_CMD_WORKERS:
+        if (crypto_standalone_check_number_arguments(num_tokens, 0) == CRYPTO_LIB_SUCCESS)
+        {
+            crypto_standalone_print_workers();
+        }
+        break;
+
     default:
         printf("Invalid command format, type 'help' for more info\n");
         status = CRYPTO_LIB_ERROR;
@@ -287,13 +349,233 @@ int32_t crypto_standalone_udp_init(udp_info_t* sock, int32_t port, uint8_t bind_
     optlen = sizeof(optval);
     setsockopt(sock->sockfd, SOL_SOCKET, SO_KEEPALIVE, &optval, optlen);
 
+    /* Report kernel receive drops with each datagram */
+    sock->timeout_us = 0;
+    if (bind_sock > 0)
+    {
+        setsockopt(sock->sockfd, SOL_SOCKET, SO_RXQ_OVFL, &optval, optlen);
+    }
+
     return status;
 }
 
+void crypto_standalone_udp_engine_init(udp_info_t* sock, uint16_t buf_len)
+{
+#ifdef CRYPTO_STANDALONE_IO_URING
+    sock->uring = malloc(sizeof(udp_uring_t));
+    if ((sock->uring != NULL) && (crypto_standalone_uring_init(sock->uring, sock, buf_len) != CRYPTO_LIB_SUCCESS))
+    {
+        free(sock->uring);
+        sock->uring = NULL;
+    }
+    if (sock->uring != NULL)
+    {
+        printf("Port %d receiving with io_uring \n", sock->port);
+    }
+#else
+    (void)sock;
+    (void)buf_len;
+#endif
+}
+
+void crypto_standalone_udp_engine_close(udp_info_t* sock)
+{
+#ifdef CRYPTO_STANDALONE_IO_URING
+    if (sock->uring != NULL)
+    {
+        crypto_standalone_uring_close(sock->uring);
+        free(sock->uring);
+        sock->uring = NULL;
+    }
+#else
+    (void)sock;
+#endif
+}
+
+int32_t crypto_standalone_udp_recv_batch(udp_info_t* sock, udp_batch_t* batch, uint8_t* bufs, uint16_t buf_len, uint8_t** frames, uint16_t* lens, udp_stats_t* stats)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    uint32_t count = batch_size;
+    struct cmsghdr* cmsg;
+
+    batch->count = 0;
+#ifdef CRYPTO_STANDALONE_IO_URING
+    if (sock->uring != NULL)
+    {
+        /* Frames stay in the registered buffers until crypto_standalone_udp_release */
+        status = crypto_standalone_uring_recv_batch(sock->uring, count, batch_timeout_us, frames, lens, stats);
+        if (status >= 0)
+        {
+            return status;
+        }
+        printf("crypto_standalone_udp_recv_batch - io_uring receive unsupported, using socket loop \n");
+        crypto_standalone_udp_engine_close(sock);
+    }
+#endif
+
+    /* Pick up timeout changes from the command line */
+    if (sock->timeout_us != batch_timeout_us)
+    {
+        struct timeval tv;
+        sock->timeout_us = batch_timeout_us;
+        tv.tv_sec = sock->timeout_us / 1000000;
+        tv.tv_usec = sock->timeout_us % 1000000;
+        setsockopt(sock->sockfd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        batch->iovs[i].iov_base = &bufs[i * buf_len];
+        batch->iovs[i].iov_len = buf_len;
+        memset(&batch->msgs[i], 0x00, sizeof(batch->msgs[i]));
+        batch->msgs[i].msg_hdr.msg_iov = &batch->iovs[i];
+        batch->msgs[i].msg_hdr.msg_iovlen = 1;
+        batch->msgs[i].msg_hdr.msg_control = batch->control[i];
+        batch->msgs[i].msg_hdr.msg_controllen = sizeof(batch->control[i]);
+    }
+
+    /* Block until the first frame or timeout, then take whatever else is queued */
+    status = recvmmsg(sock->sockfd, batch->msgs, count, MSG_WAITFORONE, NULL);
+    if (status < 1)
+    {
+        if ((status == -1) && (errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))
+        {
+            stats->rx_errors++;
+        }
+        batch->count = 0;
+        return 0;
+    }
+    batch->count = (uint32_t)status;
+    for (uint32_t i = 0; i < batch->count; i++)
+    {
+        frames[i] = &bufs[i * buf_len];
+        lens[i] = (uint16_t)batch->msgs[i].msg_len;
+    }
+
+    stats->rx_batches++;
+    stats->rx_frames += batch->count;
+    if (batch->count == count)
+    {
+        stats->rx_overruns++;
+    }
+    for (uint32_t i = 0; i < batch->count; i++)
+    {
+        if (batch->msgs[i].msg_hdr.msg_flags & MSG_TRUNC)
+        {
+            stats->rx_truncated++;
+        }
+        for (cmsg = CMSG_FIRSTHDR(&batch->msgs[i].msg_hdr); cmsg != NULL; cmsg = CMSG_NXTHDR(&batch->msgs[i].msg_hdr, cmsg))
+        {
+            if ((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SO_RXQ_OVFL))
+            {
+                memcpy((void*)&stats->rx_drops, CMSG_DATA(cmsg), sizeof(uint32_t));
+            }
+        }
+    }
+    return (int32_t)batch->count;
+}
+
+void crypto_standalone_udp_release(udp_info_t* sock)
+{
+#ifdef CRYPTO_STANDALONE_IO_URING
+    if (sock->uring != NULL)
+    {
+        crypto_standalone_uring_release(sock->uring);
+    }
+#else
+    (void)sock;
+#endif
+}
+
+void crypto_standalone_udp_queue(udp_info_t* sock, udp_batch_t* batch, uint8_t* data, uint16_t len, udp_stats_t* stats)
+{
+    uint32_t i = batch->count;
+
+    batch->iovs[i].iov_base = data;
+    batch->iovs[i].iov_len = len;
+    memset(&batch->msgs[i], 0x00, sizeof(batch->msgs[i]));
+    batch->msgs[i].msg_hdr.msg_name = &sock->saddr;
+    batch->msgs[i].msg_hdr.msg_namelen = sizeof(sock->saddr);
+    batch->msgs[i].msg_hdr.msg_iov = &batch->iovs[i];
+    batch->msgs[i].msg_hdr.msg_iovlen = 1;
+    batch->count++;
+
+    if (batch->count == CRYPTO_STANDALONE_MAX_BATCH)
+    {
+        crypto_standalone_udp_flush(sock, batch, stats);
+    }
+}
+
+void crypto_standalone_udp_flush(udp_info_t* sock, udp_batch_t* batch, udp_stats_t* stats)
+{
+    uint32_t sent = 0;
+    int status;
+
+    while (sent < batch->count)
+    {
+        status = sendmmsg(sock->sockfd, &batch->msgs[sent], batch->count - sent, 0);
+        if (status < 1)
+        {
+            /* Skip the frame that failed and carry on with the rest */
+            printf("crypto_standalone_udp_flush - Reply error %d \n", status);
+            stats->tx_errors++;
+            sent++;
+            continue;
+        }
+        for (int i = 0; i < status; i++)
+        {
+            if (batch->msgs[sent + i].msg_len != batch->iovs[sent + i].iov_len)
+            {
+                stats->tx_errors++;
+            }
+        }
+        stats->tx_frames += status;
+        sent += status;
+    }
+    if (batch->count > 0)
+    {
+        stats->tx_batches++;
+    }
+    batch->count = 0;
+}
+
+void crypto_standalone_print_stats(const char* name, udp_stats_t* stats)
+{
+    printf("  %s \n", name);
+    printf("    RX frames %lu in %lu batches, overruns %lu, truncated %lu, errors %lu, kernel drops %u \n",
+           (unsigned long)stats->rx_frames, (unsigned long)stats->rx_batches, (unsigned long)stats->rx_overruns,
+           (unsigned long)stats->rx_truncated, (unsigned long)stats->rx_errors, stats->rx_drops);
+    printf("    Security errors %lu, idle frames %lu \n", (unsigned long)stats->security_errors,
+           (unsigned long)stats->idle_frames);
+    printf("    TX frames %lu in %lu batches, errors %lu \n", (unsigned long)stats->tx_frames,
+           (unsigned long)stats->tx_batches, (unsigned long)stats->tx_errors);
+}
+
+/*
+** Frame security calls run concurrently under the shared lock (see Threading in crypto.h).
+** TC and TM use separate SAs and gateway workers own whole GVCIDs, so frames of one SA are
+** never processed by two threads at once.  Reinitializing CryptoLib takes the lock exclusively.
+*/
+void crypto_standalone_lock(void)
+{
+    pthread_rwlock_rdlock(&crypto_lock);
+}
+
+void crypto_standalone_lock_exclusive(void)
+{
+    pthread_rwlock_wrlock(&crypto_lock);
+}
+
+void crypto_standalone_unlock(void)
+{
+    pthread_rwlock_unlock(&crypto_lock);
+}
+
 int32_t crypto_reset(void)
 {
     int32_t status;
 
+    crypto_standalone_lock_exclusive();
     status = Crypto_Shutdown();
     if (status != CRYPTO_LIB_SUCCESS)
     {
@@ -305,6 +587,7 @@ int32_t crypto_reset(void)
     {
         printf("CryptoLib initialization failed with error %d \n", status);
     }
+    crypto_standalone_unlock();
 
     return status;
 }
@@ -332,105 +615,118 @@ void crypto_standalone_tc_frame(uint8_t* in_data, uint16_t in_length, uint8_t* o
     /* SDLS Trailer */
 }
 
-void *crypto_standalone_tc_apply(void* socks)
+uint8_t* crypto_standalone_tc_prepare(uint8_t* tc_in_ptr, uint16_t* tc_in_len, uint8_t* tc_framed)
+{
+    if (tc_debug == 1)
+    {
+        printf("crypto_standalone_tc_apply - received[%d]: 0x", *tc_in_len);
+        for (int i = 0; i < *tc_in_len; i++)
+        {
+            printf("%02x", tc_in_ptr[i]);
+        }
+        printf("\n");
+    }
+
+/* Frame */
+#ifdef CRYPTO_STANDALONE_HANDLE_FRAMING
+    crypto_standalone_tc_frame(tc_in_ptr, *tc_in_len, tc_framed, tc_in_len);
+    tc_in_ptr = tc_framed;
+    if (tc_debug == 1)
+    {
+        printf("crypto_standalone_tc_apply - framed[%d]: 0x", *tc_in_len);
+        for (int i = 0; i < *tc_in_len; i++)
+        {
+            printf("%02x", tc_in_ptr[i]);
+        }
+        printf("\n");
+    }
+#else
+    (void)tc_framed;
+#endif
+    return tc_in_ptr;
+}
+
+int32_t crypto_standalone_tc_apply_frame(uint8_t* tc_in_ptr, uint16_t tc_in_len, uint8_t** tc_out_ptr, udp_info_t* tc_write_sock, udp_batch_t* tc_tx_batch, udp_stats_t* stats)
 {
     int32_t status = CRYPTO_LIB_SUCCESS;
+    uint16_t tc_out_len = 0;
+
+    /* Process, straight from the receive buffer when unframed */
+    *tc_out_ptr = NULL;
+    crypto_standalone_lock();
+    status = Crypto_TC_ApplySecurity(tc_in_ptr, tc_in_len, tc_out_ptr, &tc_out_len);
+    crypto_standalone_unlock();
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        if (tc_debug == 1)
+        {
+            printf("crypto_standalone_tc_apply - status = %d, encrypted[%d]: 0x", status, tc_out_len);
+            for (int i = 0; i < tc_out_len; i++)
+            {
+                printf("%02x", (*tc_out_ptr)[i]);
+            }
+            printf("\n");
+        }
+
+        /* Reply, the caller frees the encrypted frame once the batch is sent */
+        crypto_standalone_udp_queue(tc_write_sock, tc_tx_batch, *tc_out_ptr, tc_out_len, stats);
+    }
+    else
+    {
+        printf("crypto_standalone_tc_apply - ApplySecurity error %d \n", status);
+        stats->security_errors++;
+    }
+    return status;
+}
+
+void *crypto_standalone_tc_apply(void* socks)
+{
     udp_interface_t* tc_socks = (udp_interface_t*)socks;
     udp_info_t* tc_read_sock = &tc_socks->read;
     udp_info_t* tc_write_sock = &tc_socks->write;
 
-    uint8_t tc_apply_in[TC_MAX_FRAME_SIZE];
-    uint16_t tc_in_len = 0;
-    uint8_t* tc_out_ptr;
-    uint16_t tc_out_len = 0;
-
-#ifdef CRYPTO_STANDALONE_HANDLE_FRAMING
+    uint8_t tc_apply_in[CRYPTO_STANDALONE_MAX_BATCH][TC_MAX_FRAME_SIZE];
+    udp_batch_t tc_rx_batch;
+    udp_batch_t tc_tx_batch;
+    uint8_t* tc_out_ptrs[CRYPTO_STANDALONE_MAX_BATCH];
+    uint8_t* tc_frames[CRYPTO_STANDALONE_MAX_BATCH];
+    uint16_t tc_lens[CRYPTO_STANDALONE_MAX_BATCH];
+    int32_t tc_count = 0;
+    uint8_t* tc_in_ptr;
     uint8_t tc_framed[TC_MAX_FRAME_SIZE];
-#endif
-
-    int sockaddr_size = sizeof(struct sockaddr_in);
 
     /* Prepare */
     memset(tc_apply_in, 0x00, sizeof(tc_apply_in));
+    tc_tx_batch.count = 0;
+    crypto_standalone_udp_engine_init(tc_read_sock, TC_MAX_FRAME_SIZE);
 
     while (keepRunning == CRYPTO_LIB_SUCCESS)
     {
         /* Receive */
-        status = recvfrom(tc_read_sock->sockfd, tc_apply_in, sizeof(tc_apply_in), 0, (struct sockaddr*)&tc_read_sock->ip_address, (socklen_t*)&sockaddr_size);
-        if (status != -1)
+        tc_count = crypto_standalone_udp_recv_batch(tc_read_sock, &tc_rx_batch, &tc_apply_in[0][0], TC_MAX_FRAME_SIZE, tc_frames, tc_lens, &tc_stats);
+        for (int32_t f = 0; f < tc_count; f++)
         {
-            tc_in_len = status;
-            if (tc_debug == 1)
-            {
-                printf("crypto_standalone_tc_apply - received[%d]: 0x", tc_in_len);
-                for (int i = 0; i < status; i++)
-                {
-                    printf("%02x", tc_apply_in[i]);
-                }
-                printf("\n");
-            }
-
-/* Frame */
-#ifdef CRYPTO_STANDALONE_HANDLE_FRAMING
-            crypto_standalone_tc_frame(tc_apply_in, tc_in_len, tc_framed, &tc_out_len);
-            memcpy(tc_apply_in, tc_framed, tc_out_len);
-            tc_in_len = tc_out_len;
-            tc_out_len = 0;
-            if (tc_debug == 1)
-            {
-                printf("crypto_standalone_tc_apply - framed[%d]: 0x", tc_in_len);
-                for (int i = 0; i < tc_in_len; i++)
-                {
-                    printf("%02x", tc_apply_in[i]);
-                }
-                printf("\n");
-            }
-#endif
-
-            /* Process */
-            status = Crypto_TC_ApplySecurity(tc_apply_in, tc_in_len, &tc_out_ptr, &tc_out_len);
-            if (status == CRYPTO_LIB_SUCCESS)
-            {
-                if (tc_debug == 1)
-                {
-                    printf("crypto_standalone_tc_apply - status = %d, encrypted[%d]: 0x", status, tc_out_len);
-                    for (int i = 0; i < tc_out_len; i++)
-                    {
-                        printf("%02x", tc_out_ptr[i]);
-                    }
-                    printf("\n");
-                }
-
-                /* Reply */
-                status = sendto(tc_write_sock->sockfd, tc_out_ptr, tc_out_len, 0, (struct sockaddr*)&tc_write_sock->saddr, sizeof(tc_write_sock->saddr));
-                if ((status == -1) || (status != tc_out_len))
-                {
-                    printf("crypto_standalone_tc_apply - Reply error %d \n", status);
-                }
-            }
-            else
-            {
-                printf("crypto_standalone_tc_apply - ApplySecurity error %d \n", status);
-            }
-
-            /* Reset */
-            memset(tc_apply_in, 0x00, sizeof(tc_apply_in));
-            tc_in_len = 0;
-            tc_out_len = 0;
-            if (!tc_out_ptr) free(tc_out_ptr);
-            if (tc_debug == 1)
-            {
-            #ifdef CRYPTO_STANDALONE_TC_APPLY_DEBUG
-                printf("\n");
-            #endif
-            }
+            tc_in_ptr = crypto_standalone_tc_prepare(tc_frames[f], &tc_lens[f], tc_framed);
+            crypto_standalone_tc_apply_frame(tc_in_ptr, tc_lens[f], &tc_out_ptrs[f], tc_write_sock, &tc_tx_batch, &tc_stats);
         }
 
-        /* Delay */
-        usleep(100);
+        /* Send the batch, then release the encrypted frames it referenced */
+        crypto_standalone_udp_flush(tc_write_sock, &tc_tx_batch, &tc_stats);
+        crypto_standalone_udp_release(tc_read_sock);
+        for (int32_t f = 0; f < tc_count; f++)
+        {
+            free(tc_out_ptrs[f]);
+        }
+        if ((tc_debug == 1) && (tc_count > 0))
+        {
+        #ifdef CRYPTO_STANDALONE_TC_APPLY_DEBUG
+            printf("\n");
+        #endif
+        }
     }
-    close(tc_read_sock->port);
-    close(tc_write_sock->port);
+    crypto_standalone_udp_engine_close(tc_read_sock);
+    close(tc_read_sock->sockfd);
+    close(tc_write_sock->sockfd);
     return tc_read_sock;
 }
 
@@ -448,7 +744,7 @@ void crypto_standalone_tm_frame(uint8_t* in_data, uint16_t in_length, uint8_t* o
     // Calculate security headers and trailers
     uint8_t header_length = 6 + 2 + sa_ptr->shivf_len + sa_ptr->shplf_len + sa_ptr->shsnf_len + 40; // TODO: Why +40?
     uint8_t trailer_length = sa_ptr->stmacf_len;
-    if (current_managed_parameters_struct.has_fecf == TM_HAS_FECF)
+    if (current_managed_parameters->has_fecf == TM_HAS_FECF)
     {
         trailer_length += 4;
     }
@@ -487,9 +783,10 @@ void crypto_standalone_tm_debug_process(uint8_t* tm_process_in)
     }
 }
 
-void crypto_standalone_spp_telem_or_idle(int32_t* status_p, uint8_t* tm_ptr, uint16_t* spp_len_p, udp_interface_t* tm_socks, int* tm_process_len_p)
+void crypto_standalone_spp_telem_or_idle(int32_t* status_p, uint8_t** tm_ptr_p, uint16_t* spp_len_p, udp_interface_t* tm_socks, udp_batch_t* tm_tx_batch, udp_stats_t* stats, int* tm_process_len_p)
 {
     int32_t status = *status_p;
+    uint8_t* tm_ptr = *tm_ptr_p;
     uint16_t spp_len = *spp_len_p;
     int tm_process_len = *tm_process_len_p;
 
@@ -509,24 +806,16 @@ void crypto_standalone_spp_telem_or_idle(int32_t* status_p, uint8_t* tm_ptr, uin
         // Send all SPP telemetry packets
         if (tm_ptr[0] == 0x08)  
         {
-            status = sendto(tm_write_sock->sockfd, tm_ptr, spp_len, 0, (struct sockaddr*)&tm_write_sock->saddr, sizeof(tm_write_sock->saddr));
+            crypto_standalone_udp_queue(tm_write_sock, tm_tx_batch, tm_ptr, spp_len, stats);
         }
         // Only send idle packets if configured to do so
         else
         {
-#ifdef CRYPTO_STANDALONE_DISCARD_IDLE_PACKETS
-            // Don't forward idle packets
-            status = spp_len;
-#else
-            status = sendto(tm_write_sock->sockfd, tm_ptr, spp_len, 0, (struct sockaddr*)&tm_write_sock->saddr, sizeof(tm_write_sock->saddr));
+#ifndef CRYPTO_STANDALONE_DISCARD_IDLE_PACKETS
+            crypto_standalone_udp_queue(tm_write_sock, tm_tx_batch, tm_ptr, spp_len, stats);
 #endif
         }
-
-        // Check status
-        if ((status == -1) || (status != spp_len))
-        {
-            printf("crypto_standalone_tm_process - Reply error %d \n", status);
-        }
+        status = spp_len;
         tm_ptr = &tm_ptr[spp_len];
         tm_process_len = tm_process_len - spp_len;
     }
@@ -542,11 +831,8 @@ void crypto_standalone_spp_telem_or_idle(int32_t* status_p, uint8_t* tm_ptr, uin
         // Don't forward idle frame
         status = spp_len;
 #else
-        status = sendto(tm_write_sock->sockfd, tm_ptr, spp_len, 0, (struct sockaddr*)&tm_write_sock->saddr, sizeof(tm_write_sock->saddr));
-        if ((status == -1) || (status != spp_len))
-        {
-            printf("crypto_standalone_tm_process - Reply error %d \n", status);
-        }
+        crypto_standalone_udp_queue(tm_write_sock, tm_tx_batch, tm_ptr, spp_len, stats);
+        status = spp_len;
         tm_ptr = &tm_ptr[spp_len];
 #endif
         tm_process_len = 0;
@@ -557,21 +843,16 @@ void crypto_standalone_spp_telem_or_idle(int32_t* status_p, uint8_t* tm_ptr, uin
         tm_process_len = 0;
     }
     *status_p = status;
+    *tm_ptr_p = tm_ptr;
     *spp_len_p = spp_len;
     *tm_process_len_p = tm_process_len;
 }
 
-void* crypto_standalone_tm_process(void* socks)
+int32_t crypto_standalone_tm_process_frame(uint8_t* tm_in_ptr, int tm_process_len, udp_interface_t* tm_socks, udp_batch_t* tm_tx_batch, udp_stats_t* stats)
 {
-    int32_t status = CRYPTO_LIB_SUCCESS;
-    udp_interface_t* tm_socks = (udp_interface_t*)socks;
-    udp_info_t* tm_read_sock = &tm_socks->read;
-    udp_info_t* tm_write_sock = &tm_socks->write;
-    
-    uint8_t tm_process_in[TM_CADU_SIZE]; // Accounts for ASM automatically based on #def
-    int tm_process_len = 0;
+    int32_t status = tm_process_len;
     uint16_t spp_len = 0;
-    uint8_t* tm_ptr;
+    uint8_t* tm_ptr = NULL;
     uint16_t tm_out_len = 0;
 
 #ifdef CRYPTO_STANDALONE_HANDLE_FRAMING
@@ -579,104 +860,400 @@ void* crypto_standalone_tm_process(void* socks)
     uint16_t tm_framed_len = 0;
 #endif
 
-    int sockaddr_size = sizeof(struct sockaddr_in);
-
-    while (keepRunning == CRYPTO_LIB_SUCCESS)
-    {
-        /* Receive */
-        status = recvfrom(tm_read_sock->sockfd, tm_process_in, sizeof(tm_process_in), 0, (struct sockaddr*)&tm_read_sock->ip_address, (socklen_t*)&sockaddr_size);
-        if (status != -1)
-        {
-            tm_process_len = status;
-            /* Receive */
-            crypto_standalone_tm_debug_recv(status, tm_process_len, tm_process_in);
-            /* Process */
+    /* Receive */
+    crypto_standalone_tm_debug_recv(status, tm_process_len, tm_in_ptr);
+    /* Process */
+    crypto_standalone_lock();
 #ifdef TM_CADU_HAS_ASM
-            // Process Security skipping prepended ASM
-            crypto_standalone_tm_debug_process(tm_process_in);
-            // Account for ASM length
-            status = Crypto_TM_ProcessSecurity(tm_process_in + 4, (const uint16_t)tm_process_len - 4, &tm_ptr, &tm_out_len);
+    // Process Security skipping prepended ASM
+    crypto_standalone_tm_debug_process(tm_in_ptr);
+    // Account for ASM length
+    status = Crypto_TM_ProcessSecurity(tm_in_ptr + 4, (const uint16_t)tm_process_len - 4, &tm_ptr, &tm_out_len);
 #else
-            if (tm_debug == 1)
+    if (tm_debug == 1)
+    {
+        printf("Processing frame without ASM...\n");
+    }
+    status = Crypto_TM_ProcessSecurity(tm_in_ptr, (const uint16_t)tm_process_len, &tm_ptr, &tm_out_len);
+#endif
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        if (tm_debug == 1)
+        {
+            if (((tm_ptr[4] & 0x0F) == 0x0F) && (tm_ptr[5] == 0xFE))
             {
-                printf("Processing frame without ASM...\n");
+                // OID Frame
             }
-            status = Crypto_TM_ProcessSecurity(tm_process_in, (const uint16_t)tm_process_len, &tm_ptr, &tm_out_len);
-#endif
-            if (status == CRYPTO_LIB_SUCCESS)
+            else
             {
-                if (tm_debug == 1)
+                printf("crypto_standalone_tm_process: 1 - status = %d, decrypted[%d]: 0x", status, tm_out_len);
+                for (int i = 0; i < tm_out_len; i++)
                 {
-                    if (((tm_ptr[4] & 0x0F) == 0x0F) && (tm_ptr[5] == 0xFE))
-                    {
-                        // OID Frame
-                    }
-                    else
-                    {
-                        printf("crypto_standalone_tm_process: 1 - status = %d, decrypted[%d]: 0x", status, tm_out_len);
-                        for (int i = 0; i < tm_out_len; i++)
-                        {
-                            printf("%02x", tm_ptr[i]);
-                        }
-                        printf("\n");
-                    }
+                    printf("%02x", tm_ptr[i]);
                 }
+                printf("\n");
+            }
+        }
 
 /* Frame */
 #ifdef CRYPTO_STANDALONE_HANDLE_FRAMING
 #ifdef TM_CADU_HAS_ASM
-                uint16_t spi = (0xFFFF & tm_process_in[11]) | tm_process_in[12];
-                // crypto_standalone_tm_frame(tm_process_in+4, tm_process_len-4, tm_framed, &tm_framed_len, spi);
-                crypto_standalone_tm_frame(tm_ptr, tm_out_len, tm_framed, &tm_framed_len, spi);
+        uint16_t spi = (0xFFFF & tm_in_ptr[11]) | tm_in_ptr[12];
+        crypto_standalone_tm_frame(tm_ptr, tm_out_len, tm_framed, &tm_framed_len, spi);
 #else
-                uint16_t spi = (0xFFFF & tm_process_in[7]) | tm_process_in[8];
-                crypto_standalone_tm_frame(tm_process_in, tm_process_len, tm_framed, &tm_framed_len, spi);
+        uint16_t spi = (0xFFFF & tm_in_ptr[7]) | tm_in_ptr[8];
+        crypto_standalone_tm_frame(tm_in_ptr, tm_process_len, tm_framed, &tm_framed_len, spi);
 #endif
-                memcpy(tm_process_in, tm_framed, tm_framed_len);
-                tm_process_len = tm_framed_len;
-                tm_framed_len = 0;
-                
-                if (tm_debug == 1)
-                // Note: Need logic to allow broken packet assembly
-                {
-                    printf("crypto_standalone_tm_process: 2 - beginning after first header pointer - deframed[%d]: 0x", tm_process_len);
-                    for (int i = 0; i < tm_process_len; i++)
-                    {
-                        printf("%02x", tm_framed[i]);
-                    }
-                    printf("\n");
-                }
+        crypto_standalone_unlock();
+        memcpy(tm_in_ptr, tm_framed, tm_framed_len);
+        tm_process_len = tm_framed_len;
+        tm_framed_len = 0;
+        
+        if (tm_debug == 1)
+        // Note: Need logic to allow broken packet assembly
+        {
+            printf("crypto_standalone_tm_process: 2 - beginning after first header pointer - deframed[%d]: 0x", tm_process_len);
+            for (int i = 0; i < tm_process_len; i++)
+            {
+                printf("%02x", tm_framed[i]);
+            }
+            printf("\n");
+        }
+#else
+        crypto_standalone_unlock();
 #endif
+        /* Packets are queued from the receive buffer, the processed frame is no longer needed */
+        free(tm_ptr);
 
-                /* Space Packet Protocol Loop */
-                tm_ptr = &tm_process_in[0];
-                while (tm_process_len > 5)
-                {
-                    // SPP Telemetry OR SPP Idle Packet
-                    crypto_standalone_spp_telem_or_idle(&status, tm_ptr, &spp_len, tm_socks, &tm_process_len);
-                }
+        /* Space Packet Protocol Loop */
+        tm_ptr = &tm_in_ptr[0];
+        while (tm_process_len > 5)
+        {
+            // SPP Telemetry OR SPP Idle Packet
+            crypto_standalone_spp_telem_or_idle(&status, &tm_ptr, &spp_len, tm_socks, tm_tx_batch, stats, &tm_process_len);
+        }
+        status = CRYPTO_LIB_SUCCESS;
+    }
+    else if (status == CRYPTO_LIB_ERR_IDLE_FRAME)
+    {
+        // Idle frame handled by the GVCID idle policy, nothing to forward
+        crypto_standalone_unlock();
+        stats->idle_frames++;
+        status = CRYPTO_LIB_SUCCESS;
+    }
+    else
+    {
+        crypto_standalone_unlock();
+        printf("crypto_standalone_tm_process - ProcessSecurity error %d \n", status);
+        stats->security_errors++;
+    }
+#ifdef CRYPTO_STANDALONE_TM_PROCESS_DEBUG
+    printf("\n");
+#endif
+    return status;
+}
+
+void* crypto_standalone_tm_process(void* socks)
+{
+    udp_interface_t* tm_socks = (udp_interface_t*)socks;
+    udp_info_t* tm_read_sock = &tm_socks->read;
+    udp_info_t* tm_write_sock = &tm_socks->write;
+    
+    uint8_t tm_process_in[CRYPTO_STANDALONE_MAX_BATCH][TM_CADU_SIZE]; // Accounts for ASM automatically based on #def
+    udp_batch_t tm_rx_batch;
+    udp_batch_t tm_tx_batch;
+    uint8_t* tm_frames[CRYPTO_STANDALONE_MAX_BATCH];
+    uint16_t tm_lens[CRYPTO_STANDALONE_MAX_BATCH];
+    int32_t tm_count = 0;
+
+    memset(tm_process_in, 0x00, sizeof(tm_process_in));
+    tm_tx_batch.count = 0;
+    crypto_standalone_udp_engine_init(tm_read_sock, TM_CADU_SIZE);
+
+    while (keepRunning == CRYPTO_LIB_SUCCESS)
+    {
+        /* Receive */
+        tm_count = crypto_standalone_udp_recv_batch(tm_read_sock, &tm_rx_batch, &tm_process_in[0][0], TM_CADU_SIZE, tm_frames, tm_lens, &tm_stats);
+        for (int32_t f = 0; f < tm_count; f++)
+        {
+            crypto_standalone_tm_process_frame(tm_frames[f], tm_lens[f], tm_socks, &tm_tx_batch, &tm_stats);
+        }
+
+        /* Send every packet extracted from the batch, then hand the receive buffers back */
+        crypto_standalone_udp_flush(tm_write_sock, &tm_tx_batch, &tm_stats);
+        crypto_standalone_udp_release(tm_read_sock);
+    }
+    crypto_standalone_udp_engine_close(tm_read_sock);
+    close(tm_read_sock->sockfd);
+    close(tm_write_sock->sockfd);
+    return tm_read_sock;
+}
+
+spsc_slot_t* crypto_standalone_queue_reserve(spsc_queue_t* queue)
+{
+    uint32_t tail = queue->tail;
+    if ((tail - __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE)) == CRYPTO_STANDALONE_QUEUE_DEPTH)
+    {
+        return NULL;
+    }
+    return &queue->slots[tail & (CRYPTO_STANDALONE_QUEUE_DEPTH - 1)];
+}
+
+void crypto_standalone_queue_commit(spsc_queue_t* queue)
+{
+    __atomic_store_n(&queue->tail, queue->tail + 1, __ATOMIC_RELEASE);
+}
+
+uint32_t crypto_standalone_queue_peek(spsc_queue_t* queue, uint32_t max)
+{
+    uint32_t available = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE) - queue->head;
+    return (available < max) ? available : max;
+}
+
+spsc_slot_t* crypto_standalone_queue_slot(spsc_queue_t* queue, uint32_t index)
+{
+    return &queue->slots[(queue->head + index) & (CRYPTO_STANDALONE_QUEUE_DEPTH - 1)];
+}
+
+void crypto_standalone_queue_release(spsc_queue_t* queue, uint32_t count)
+{
+    __atomic_store_n(&queue->head, queue->head + count, __ATOMIC_RELEASE);
+}
+
+uint32_t crypto_standalone_gateway_shard(uint16_t scid, uint8_t vcid)
+{
+    return (((uint32_t)scid << 6) | vcid) % num_workers;
+}
+
+static uint64_t crypto_standalone_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+void* crypto_standalone_gateway_tc_dispatch(void* socks)
+{
+    udp_interface_t* tc_socks = (udp_interface_t*)socks;
+    udp_info_t* tc_read_sock = &tc_socks->read;
+
+    uint8_t tc_apply_in[CRYPTO_STANDALONE_MAX_BATCH][TC_MAX_FRAME_SIZE];
+    udp_batch_t tc_rx_batch;
+    uint8_t* tc_frames[CRYPTO_STANDALONE_MAX_BATCH];
+    uint16_t tc_lens[CRYPTO_STANDALONE_MAX_BATCH];
+    int32_t tc_count = 0;
+    uint8_t* tc_in_ptr;
+    uint8_t tc_framed[TC_MAX_FRAME_SIZE];
+    spsc_slot_t* slot;
+    uint32_t shard;
+
+    crypto_standalone_udp_engine_init(tc_read_sock, TC_MAX_FRAME_SIZE);
+    while (keepRunning == CRYPTO_LIB_SUCCESS)
+    {
+        tc_count = crypto_standalone_udp_recv_batch(tc_read_sock, &tc_rx_batch, &tc_apply_in[0][0], TC_MAX_FRAME_SIZE, tc_frames, tc_lens, &tc_stats);
+        for (int32_t f = 0; f < tc_count; f++)
+        {
+            /* Framing stays here so sequence numbers follow arrival order */
+            tc_in_ptr = crypto_standalone_tc_prepare(tc_frames[f], &tc_lens[f], tc_framed);
+            shard = 0;
+            if (tc_lens[f] >= 3)
+            {
+                shard = crypto_standalone_gateway_shard(((tc_in_ptr[0] & 0x03) << 8) | tc_in_ptr[1], (tc_in_ptr[2] & 0xFC) >> 2);
             }
-            else
+
+            slot = crypto_standalone_queue_reserve(&workers[shard].tc_queue);
+            if (slot == NULL)
             {
-                printf("crypto_standalone_tm_process - ProcessSecurity error %d \n", status);
+                workers[shard].tc_queue_drops++;
+                continue;
             }
+            slot->len = tc_lens[f];
+            memcpy(slot->data, tc_in_ptr, tc_lens[f]);
+            crypto_standalone_queue_commit(&workers[shard].tc_queue);
+        }
+        crypto_standalone_udp_release(tc_read_sock);
+    }
+    crypto_standalone_udp_engine_close(tc_read_sock);
+    close(tc_read_sock->sockfd);
+    return tc_read_sock;
+}
 
-            /* Reset */
-            memset(tm_process_in, 0x00, sizeof(tm_process_in));
-            tm_process_len = 0;
-#ifdef CRYPTO_STANDALONE_TM_PROCESS_DEBUG
-            printf("\n");
+void* crypto_standalone_gateway_tm_dispatch(void* socks)
+{
+    udp_interface_t* tm_socks = (udp_interface_t*)socks;
+    udp_info_t* tm_read_sock = &tm_socks->read;
+
+    uint8_t tm_process_in[CRYPTO_STANDALONE_MAX_BATCH][TM_CADU_SIZE];
+    udp_batch_t tm_rx_batch;
+    uint8_t* tm_frames[CRYPTO_STANDALONE_MAX_BATCH];
+    uint16_t tm_lens[CRYPTO_STANDALONE_MAX_BATCH];
+    int32_t tm_count = 0;
+    uint8_t* tm_hdr;
+    spsc_slot_t* slot;
+    uint32_t shard;
+
+#ifdef TM_CADU_HAS_ASM
+    const uint16_t tm_hdr_offset = 4;
+#else
+    const uint16_t tm_hdr_offset = 0;
 #endif
-        }
 
-        /* Delay */
-        usleep(100);
+    crypto_standalone_udp_engine_init(tm_read_sock, TM_CADU_SIZE);
+    while (keepRunning == CRYPTO_LIB_SUCCESS)
+    {
+        tm_count = crypto_standalone_udp_recv_batch(tm_read_sock, &tm_rx_batch, &tm_process_in[0][0], TM_CADU_SIZE, tm_frames, tm_lens, &tm_stats);
+        for (int32_t f = 0; f < tm_count; f++)
+        {
+            shard = 0;
+            if (tm_lens[f] >= tm_hdr_offset + 2)
+            {
+                tm_hdr = tm_frames[f] + tm_hdr_offset;
+                shard = crypto_standalone_gateway_shard(((tm_hdr[0] & 0x3F) << 4) | ((tm_hdr[1] & 0xF0) >> 4), (tm_hdr[1] & 0x0E) >> 1);
+            }
+
+            slot = crypto_standalone_queue_reserve(&workers[shard].tm_queue);
+            if (slot == NULL)
+            {
+                workers[shard].tm_queue_drops++;
+                continue;
+            }
+            slot->len = tm_lens[f];
+            memcpy(slot->data, tm_frames[f], tm_lens[f]);
+            crypto_standalone_queue_commit(&workers[shard].tm_queue);
+        }
+        crypto_standalone_udp_release(tm_read_sock);
     }
-    close(tm_read_sock->port);
-    close(tm_write_sock->port);
+    crypto_standalone_udp_engine_close(tm_read_sock);
+    close(tm_read_sock->sockfd);
     return tm_read_sock;
 }
 
+void* crypto_standalone_gateway_worker(void* worker)
+{
+    crypto_standalone_worker_t* w = (crypto_standalone_worker_t*)worker;
+    udp_batch_t tc_tx_batch;
+    udp_batch_t tm_tx_batch;
+    uint8_t* tc_out_ptrs[CRYPTO_STANDALONE_MAX_BATCH];
+    uint32_t tc_count;
+    uint32_t tm_count;
+    uint64_t start;
+    spsc_slot_t* slot;
+    cpu_set_t cpus;
+
+    CPU_ZERO(&cpus);
+    CPU_SET(w->cpu, &cpus);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0)
+    {
+        printf("crypto_standalone_gateway_worker - unable to pin worker %d to cpu %d \n", w->id, w->cpu);
+    }
+
+    tc_tx_batch.count = 0;
+    tm_tx_batch.count = 0;
+    while (keepRunning == CRYPTO_LIB_SUCCESS)
+    {
+        start = crypto_standalone_now_ns();
+
+        /* TC apply */
+        tc_count = crypto_standalone_queue_peek(&w->tc_queue, batch_size);
+        for (uint32_t f = 0; f < tc_count; f++)
+        {
+            slot = crypto_standalone_queue_slot(&w->tc_queue, f);
+            crypto_standalone_tc_apply_frame(slot->data, slot->len, &tc_out_ptrs[f], &w->tc_socks->write, &tc_tx_batch, &w->tc_stats);
+        }
+        crypto_standalone_udp_flush(&w->tc_socks->write, &tc_tx_batch, &w->tc_stats);
+        for (uint32_t f = 0; f < tc_count; f++)
+        {
+            free(tc_out_ptrs[f]);
+        }
+        crypto_standalone_queue_release(&w->tc_queue, tc_count);
+
+        /* TM process, packets reference the queue slots until flushed */
+        tm_count = crypto_standalone_queue_peek(&w->tm_queue, batch_size);
+        for (uint32_t f = 0; f < tm_count; f++)
+        {
+            slot = crypto_standalone_queue_slot(&w->tm_queue, f);
+            crypto_standalone_tm_process_frame(slot->data, slot->len, w->tm_socks, &tm_tx_batch, &w->tm_stats);
+        }
+        crypto_standalone_udp_flush(&w->tm_socks->write, &tm_tx_batch, &w->tm_stats);
+        crypto_standalone_queue_release(&w->tm_queue, tm_count);
+
+        if ((tc_count + tm_count) > 0)
+        {
+            w->tc_frames += tc_count;
+            w->tm_frames += tm_count;
+            w->busy_ns += crypto_standalone_now_ns() - start;
+        }
+        else
+        {
+            usleep(CRYPTO_STANDALONE_WORKER_IDLE_US);
+            w->idle_ns += crypto_standalone_now_ns() - start;
+        }
+    }
+    return w;
+}
+
+int32_t crypto_standalone_gateway_start(uint32_t count, udp_interface_t* tc_socks, udp_interface_t* tm_socks)
+{
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (cpus < 1)
+    {
+        cpus = 1;
+    }
+    workers = calloc(count, sizeof(crypto_standalone_worker_t));
+    if (workers == NULL)
+    {
+        printf("crypto_standalone_gateway_start - unable to allocate %d workers \n", count);
+        return CRYPTO_LIB_ERROR;
+    }
+    num_workers = count;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        workers[i].id = i;
+        workers[i].cpu = (int)(i % cpus);
+        workers[i].tc_socks = tc_socks;
+        workers[i].tm_socks = tm_socks;
+        if (pthread_create(&workers[i].thread, NULL, crypto_standalone_gateway_worker, &workers[i]) != 0)
+        {
+            perror("Failed to create gateway worker thread");
+            return CRYPTO_LIB_ERROR;
+        }
+    }
+    return CRYPTO_LIB_SUCCESS;
+}
+
+void crypto_standalone_print_workers(void)
+{
+    uint64_t busy;
+    uint64_t idle;
+
+    if (num_workers == 0)
+    {
+        printf("Gateway mode not enabled, start with --workers N \n");
+        return;
+    }
+    for (uint32_t i = 0; i < num_workers; i++)
+    {
+        crypto_standalone_worker_t* w = &workers[i];
+
+        /* Utilization over the interval since the last report */
+        busy = w->busy_ns - w->reported_busy_ns;
+        idle = w->idle_ns - w->reported_idle_ns;
+        w->reported_busy_ns += busy;
+        w->reported_idle_ns += idle;
+
+        printf("  Worker %d (cpu %d) - utilization %.1f%% \n", w->id, w->cpu,
+               (busy + idle) ? (100.0 * (double)busy / (double)(busy + idle)) : 0.0);
+        printf("    TC frames %lu, queue drops %lu, security errors %lu, TX errors %lu \n", (unsigned long)w->tc_frames,
+               (unsigned long)w->tc_queue_drops, (unsigned long)w->tc_stats.security_errors,
+               (unsigned long)w->tc_stats.tx_errors);
+        printf("    TM frames %lu, queue drops %lu, security errors %lu, TX errors %lu \n", (unsigned long)w->tm_frames,
+               (unsigned long)w->tm_queue_drops, (unsigned long)w->tm_stats.security_errors,
+               (unsigned long)w->tm_stats.tx_errors);
+    }
+}
+
 void crypto_standalone_cleanup(const int signal)
 {
     if (signal == SIGINT)
@@ -716,10 +1293,23 @@ int main(int argc, char* argv[])
     tm_process.write.port = TM_PROCESS_FWD_PORT;
 
     printf("Starting CryptoLib in standalone mode! \n");
-    if (argc != 1)
+    for (int i = 1; i < argc; i++)
     {
-        printf("Invalid number of arguments! \n");
-        printf("  Expected zero but received: %s \n", argv[1]);
+        if ((strcmp(argv[i], "--workers") == 0) && (i + 1 < argc))
+        {
+            int requested = atoi(argv[++i]);
+            if ((requested < 0) || (requested > CRYPTO_STANDALONE_MAX_WORKERS))
+            {
+                printf("Invalid worker count %d, must be between 0 and %d \n", requested, CRYPTO_STANDALONE_MAX_WORKERS);
+                requested = 0;
+            }
+            num_workers = (uint32_t)requested;
+        }
+        else
+        {
+            printf("Invalid argument! \n");
+            printf("  Expected [--workers N] but received: %s \n", argv[i]);
+        }
     }
 
     /* Catch CTRL+C */
@@ -788,7 +1378,20 @@ int main(int argc, char* argv[])
         printf("    Write, UDP - %s : %d \n", tm_process.write.ip_address, tm_process.write.port);
         printf("\n");
 
-        status = pthread_create(&tc_apply_thread, NULL, *crypto_standalone_tc_apply, &tc_apply);
+        if (num_workers > 0)
+        {
+            printf("  Gateway mode with %d workers \n\n", num_workers);
+            status = crypto_standalone_gateway_start(num_workers, &tc_apply, &tm_process);
+            if (status != CRYPTO_LIB_SUCCESS)
+            {
+                keepRunning = CRYPTO_LIB_ERROR;
+            }
+        }
+    }
+
+    if (keepRunning == CRYPTO_LIB_SUCCESS)
+    {
+        status = pthread_create(&tc_apply_thread, NULL, (num_workers > 0) ? *crypto_standalone_gateway_tc_dispatch : *crypto_standalone_tc_apply, &tc_apply);
         if (status < 0)
         {
             perror("Failed to create tc_apply_thread thread");
@@ -796,7 +1399,7 @@ int main(int argc, char* argv[])
         }
         else
         {
-            status = pthread_create(&tm_process_thread, NULL, *crypto_standalone_tm_process, &tm_process);
+            status = pthread_create(&tm_process_thread, NULL, (num_workers > 0) ? *crypto_standalone_gateway_tm_dispatch : *crypto_standalone_tm_process, &tm_process);
             if (status < 0)
             {
                 perror("Failed to create tm_process_thread thread");
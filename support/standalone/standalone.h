@@ -28,18 +28,29 @@ extern "C"
 /*
 ** Includes
 */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE // recvmmsg / sendmmsg
+#endif
 #include <stdio.h>
 #include <stdlib.h>
 #include <arpa/inet.h>
 #include <ctype.h>
+#include <errno.h>
 #include <netdb.h>	//hostent
 #include <netinet/in.h>
 #include <pthread.h>
+#include <sched.h>
 #include <signal.h>
 #include <string.h>
 #include <sys/socket.h>
+#include <sys/time.h>
+#include <time.h>
 #include <unistd.h>
 
+#ifdef CRYPTO_STANDALONE_IO_URING
+#include <linux/io_uring.h>
+#endif
+
 #include "crypto.h"
 #include "crypto_config.h"
 
@@ -63,6 +74,25 @@ extern "C"
 #define CRYPTO_STANDALONE_FRAMING_VCID 0x00
 #define CRYPTO_STANDALONE_FRAMING_TC_DATA_LEN 512
 
+/*
+** Socket batching, frames are received with recvmmsg and forwarded with sendmmsg.
+** The timeout bounds how long a bridge blocks waiting for the first frame of a batch,
+** after which whatever is already queued (up to the batch size) is taken in one call.
+*/
+#define CRYPTO_STANDALONE_MAX_BATCH 64
+#define CRYPTO_STANDALONE_DEFAULT_BATCH 16
+#define CRYPTO_STANDALONE_DEFAULT_TIMEOUT_US 1000
+#define CRYPTO_STANDALONE_URING_BUFFERS 256 // Registered receive buffers per socket, power of two
+
+/*
+** Gateway mode, started with --workers N.  Receive threads shard frames by GVCID onto
+** per-worker single producer / single consumer queues so each virtual channel stays in order.
+*/
+#define CRYPTO_STANDALONE_MAX_WORKERS 16
+#define CRYPTO_STANDALONE_QUEUE_DEPTH 256 // Frames per worker queue, power of two
+#define CRYPTO_STANDALONE_QUEUE_FRAME_SIZE ((TM_CADU_SIZE > TC_MAX_FRAME_SIZE) ? TM_CADU_SIZE : TC_MAX_FRAME_SIZE)
+#define CRYPTO_STANDALONE_WORKER_IDLE_US 50
+
 /*
 ** Can be used to reduce ground system error messages
 */
@@ -86,17 +116,53 @@ extern "C"
 #define CRYPTO_CMD_VCID     4
 #define CRYPTO_CMD_TC_DEBUG 5
 #define CRYPTO_CMD_TM_DEBUG 6
+#define CRYPTO_CMD_BATCH    7
+#define CRYPTO_CMD_STATS    8
+#define CRYPTO_CMD_WORKERS  9
 
 
 /*
 ** Structures
 */
+#ifdef CRYPTO_STANDALONE_IO_URING
+typedef struct
+{
+   int ring_fd;
+   int sockfd;
+   void* ring_ptr;
+   size_t ring_size;
+   struct io_uring_sqe* sqes;
+   size_t sqes_size;
+   uint32_t* sq_tail;
+   uint32_t* sq_mask;
+   uint32_t* sq_array;
+   uint32_t* cq_head;
+   uint32_t* cq_tail;
+   uint32_t* cq_mask;
+   struct io_uring_cqe* cqes;
+   struct io_uring_buf_ring* buf_ring;
+   uint16_t buf_tail;
+   uint8_t* bufs;
+   size_t bufs_size;
+   uint16_t buf_len;
+   uint16_t bids[CRYPTO_STANDALONE_MAX_BATCH]; // Buffers handed out by the last batch
+   uint32_t count;
+   uint8_t armed;
+   uint8_t registered;
+   uint8_t ever_received;
+} udp_uring_t;
+#endif
+
 typedef struct 
 {
    int sockfd;
    char* ip_address;
    int port;
    struct sockaddr_in saddr;
+   uint32_t timeout_us; // Receive timeout currently applied to sockfd
+#ifdef CRYPTO_STANDALONE_IO_URING
+   udp_uring_t* uring; // NULL when receiving with the socket loop
+#endif
 } udp_info_t;
 
 typedef struct
@@ -105,6 +171,63 @@ typedef struct
    udp_info_t write;
 } udp_interface_t;
 
+typedef struct
+{
+   struct mmsghdr msgs[CRYPTO_STANDALONE_MAX_BATCH];
+   struct iovec iovs[CRYPTO_STANDALONE_MAX_BATCH];
+   char control[CRYPTO_STANDALONE_MAX_BATCH][CMSG_SPACE(sizeof(uint32_t))];
+   uint32_t count;
+} udp_batch_t;
+
+typedef struct
+{
+   volatile uint64_t rx_frames;
+   volatile uint64_t rx_batches;
+   volatile uint64_t rx_overruns;    // Batches that filled completely, more frames were likely waiting
+   volatile uint64_t rx_truncated;   // Frames larger than the receive buffer
+   volatile uint64_t rx_errors;
+   volatile uint32_t rx_drops;       // Kernel socket buffer drops reported by SO_RXQ_OVFL
+   volatile uint64_t security_errors;
+   volatile uint64_t idle_frames;    // Frames the GVCID idle policy skipped or only verified
+   volatile uint64_t tx_frames;
+   volatile uint64_t tx_batches;
+   volatile uint64_t tx_errors;
+} udp_stats_t;
+
+typedef struct
+{
+   uint16_t len;
+   uint8_t data[CRYPTO_STANDALONE_QUEUE_FRAME_SIZE];
+} spsc_slot_t;
+
+typedef struct
+{
+   uint32_t head __attribute__((aligned(64))); // Written by the consumer only
+   uint32_t tail __attribute__((aligned(64))); // Written by the producer only
+   spsc_slot_t slots[CRYPTO_STANDALONE_QUEUE_DEPTH];
+} spsc_queue_t;
+
+typedef struct
+{
+   uint32_t id;
+   int cpu;
+   pthread_t thread;
+   udp_interface_t* tc_socks;
+   udp_interface_t* tm_socks;
+   spsc_queue_t tc_queue;
+   spsc_queue_t tm_queue;
+   udp_stats_t tc_stats;
+   udp_stats_t tm_stats;
+   volatile uint64_t tc_frames;
+   volatile uint64_t tm_frames;
+   volatile uint64_t tc_queue_drops; // Written by the TC receive thread
+   volatile uint64_t tm_queue_drops; // Written by the TM receive thread
+   volatile uint64_t busy_ns;
+   volatile uint64_t idle_ns;
+   uint64_t reported_busy_ns;        // Command prompt bookkeeping for interval utilization
+   uint64_t reported_idle_ns;
+} crypto_standalone_worker_t;
+
 
 /*
 ** Prototypes
@@ -116,12 +239,42 @@ int32_t crypto_standalone_get_command(const char* str);
 int32_t crypto_standalone_process_command(int32_t cc, int32_t num_tokens, char* tokens);
 int32_t crypto_host_to_ip(const char * hostname, char* ip);
 int32_t crypto_standalone_udp_init(udp_info_t* sock, int32_t port, uint8_t bind_sock);
+void crypto_standalone_udp_engine_init(udp_info_t* sock, uint16_t buf_len);
+void crypto_standalone_udp_engine_close(udp_info_t* sock);
+int32_t crypto_standalone_udp_recv_batch(udp_info_t* sock, udp_batch_t* batch, uint8_t* bufs, uint16_t buf_len, uint8_t** frames, uint16_t* lens, udp_stats_t* stats);
+void crypto_standalone_udp_release(udp_info_t* sock);
+void crypto_standalone_udp_queue(udp_info_t* sock, udp_batch_t* batch, uint8_t* data, uint16_t len, udp_stats_t* stats);
+void crypto_standalone_udp_flush(udp_info_t* sock, udp_batch_t* batch, udp_stats_t* stats);
+void crypto_standalone_print_stats(const char* name, udp_stats_t* stats);
+void crypto_standalone_lock(void);
+void crypto_standalone_lock_exclusive(void);
+void crypto_standalone_unlock(void);
 int32_t crypto_reset(void);
 void crypto_standalone_tc_frame(uint8_t* in_data, uint16_t in_length, uint8_t* out_data, uint16_t* out_length);
+uint8_t* crypto_standalone_tc_prepare(uint8_t* tc_in_ptr, uint16_t* tc_in_len, uint8_t* tc_framed);
+int32_t crypto_standalone_tc_apply_frame(uint8_t* tc_in_ptr, uint16_t tc_in_len, uint8_t** tc_out_ptr, udp_info_t* tc_write_sock, udp_batch_t* tc_tx_batch, udp_stats_t* stats);
 void* crypto_standalone_tc_apply(void* socks);
 void crypto_standalone_tm_frame(uint8_t* in_data, uint16_t in_length, uint8_t* out_data, uint16_t* out_length, uint16_t spi);
+int32_t crypto_standalone_tm_process_frame(uint8_t* tm_in_ptr, int tm_process_len, udp_interface_t* tm_socks, udp_batch_t* tm_tx_batch, udp_stats_t* stats);
 void* crypto_standalone_tm_process(void* socks);
+spsc_slot_t* crypto_standalone_queue_reserve(spsc_queue_t* queue);
+void crypto_standalone_queue_commit(spsc_queue_t* queue);
+uint32_t crypto_standalone_queue_peek(spsc_queue_t* queue, uint32_t max);
+spsc_slot_t* crypto_standalone_queue_slot(spsc_queue_t* queue, uint32_t index);
+void crypto_standalone_queue_release(spsc_queue_t* queue, uint32_t count);
+uint32_t crypto_standalone_gateway_shard(uint16_t scid, uint8_t vcid);
+void* crypto_standalone_gateway_tc_dispatch(void* socks);
+void* crypto_standalone_gateway_tm_dispatch(void* socks);
+void* crypto_standalone_gateway_worker(void* worker);
+int32_t crypto_standalone_gateway_start(uint32_t count, udp_interface_t* tc_socks, udp_interface_t* tm_socks);
+void crypto_standalone_print_workers(void);
 void crypto_standalone_cleanup(const int signal);
+#ifdef CRYPTO_STANDALONE_IO_URING
+int32_t crypto_standalone_uring_init(udp_uring_t* ring, udp_info_t* sock, uint16_t buf_len);
+int32_t crypto_standalone_uring_recv_batch(udp_uring_t* ring, uint32_t count, uint32_t timeout_us, uint8_t** frames, uint16_t* lens, udp_stats_t* stats);
+void crypto_standalone_uring_release(udp_uring_t* ring);
+void crypto_standalone_uring_close(udp_uring_t* ring);
+#endif
 
 
 #ifdef __cplusplus
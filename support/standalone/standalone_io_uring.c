@@ -0,0 +1,321 @@
+/* Copyright (C) 2009 - 2022 National Aeronautics and Space Administration.
+   All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any kind, either expressed, implied, or statutory,
+   including, but not limited to, any warranty that the software will conform to specifications, any implied warranties
+   of merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+   documentation will conform to the program, or any warranty that the software will be error free.
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+   consequential damages, arising out of, resulting from, or in any way connected with the software or its
+   documentation, whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained
+   from, or arose out of the results of, or use of, the software, documentation or services provided hereunder.
+
+   ITC Team
+   NASA IV&V
+   jstar-development-team@mail.nasa.gov
+*/
+
+/*******************************************************************************
+** Standalone CryptoLib io_uring I/O Engine
+** Multishot receive into a registered (provided) buffer ring, so frames can be
+** handed to the security functions straight from the memory they landed in.
+** Uses the raw kernel interface; init fails cleanly on kernels without the
+** required features and the bridge falls back to the socket loop.
+*******************************************************************************/
+
+#include "standalone.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#define CRYPTO_URING_BGID 0
+#define CRYPTO_URING_SQ_ENTRIES 8
+#define CRYPTO_URING_RECV_TAG 1
+
+/*
+** Kernel interface
+*/
+static int crypto_uring_setup(uint32_t entries, struct io_uring_params* p)
+{
+    return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int crypto_uring_enter(int fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags, void* arg, size_t argsz)
+{
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, arg, argsz);
+}
+
+static int crypto_uring_register(int fd, uint32_t opcode, void* arg, uint32_t nr_args)
+{
+    return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+/**
+ * @brief Function: crypto_standalone_uring_arm
+ * Queues a multishot receive that selects its buffers from the registered ring
+ * @param ring: udp_uring_t*
+ * @return int32: Success/Failure
+ **/
+static int32_t crypto_standalone_uring_arm(udp_uring_t* ring)
+{
+    uint32_t tail = *ring->sq_tail;
+    uint32_t index = tail & *ring->sq_mask;
+    struct io_uring_sqe* sqe = &ring->sqes[index];
+
+    memset(sqe, 0x00, sizeof(*sqe));
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = ring->sockfd;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = CRYPTO_URING_BGID;
+    sqe->user_data = CRYPTO_URING_RECV_TAG;
+    ring->sq_array[index] = index;
+    __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+    if (crypto_uring_enter(ring->ring_fd, 1, 0, 0, NULL, 0) != 1)
+    {
+        return CRYPTO_LIB_ERROR;
+    }
+    ring->armed = 1;
+    return CRYPTO_LIB_SUCCESS;
+}
+
+/**
+ * @brief Function: crypto_standalone_uring_recycle
+ * Hands a buffer back to the kernel, the new tail is published by the caller
+ * @param ring: udp_uring_t*
+ * @param bid: uint16
+ **/
+static void crypto_standalone_uring_recycle(udp_uring_t* ring, uint16_t bid)
+{
+    struct io_uring_buf* buf = &ring->buf_ring->bufs[ring->buf_tail & (CRYPTO_STANDALONE_URING_BUFFERS - 1)];
+
+    buf->addr = (uint64_t)(uintptr_t)&ring->bufs[(size_t)bid * ring->buf_len];
+    buf->len = ring->buf_len;
+    buf->bid = bid;
+    ring->buf_tail++;
+}
+
+int32_t crypto_standalone_uring_init(udp_uring_t* ring, udp_info_t* sock, uint16_t buf_len)
+{
+    struct io_uring_params p;
+    struct io_uring_buf_reg reg;
+    size_t sq_size;
+    size_t cq_size;
+
+    memset(ring, 0x00, sizeof(*ring));
+    ring->ring_fd = -1;
+    ring->sockfd = sock->sockfd;
+    ring->buf_len = buf_len;
+
+    memset(&p, 0x00, sizeof(p));
+    p.flags = IORING_SETUP_CQSIZE;
+    p.cq_entries = CRYPTO_STANDALONE_URING_BUFFERS * 2;
+    ring->ring_fd = crypto_uring_setup(CRYPTO_URING_SQ_ENTRIES, &p);
+    if (ring->ring_fd < 0)
+    {
+        printf("crypto_standalone_uring_init - io_uring unavailable (%d), using socket loop \n", errno);
+        return CRYPTO_LIB_ERROR;
+    }
+    if (!(p.features & IORING_FEAT_SINGLE_MMAP) || !(p.features & IORING_FEAT_EXT_ARG))
+    {
+        printf("crypto_standalone_uring_init - io_uring features 0x%x insufficient, using socket loop \n", p.features);
+        crypto_standalone_uring_close(ring);
+        return CRYPTO_LIB_ERROR;
+    }
+
+    /* Map submission / completion rings and SQEs */
+    sq_size = p.sq_off.array + p.sq_entries * sizeof(uint32_t);
+    cq_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    ring->ring_size = (sq_size > cq_size) ? sq_size : cq_size;
+    ring->ring_ptr = mmap(NULL, ring->ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->ring_fd,
+                          IORING_OFF_SQ_RING);
+    ring->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->ring_fd,
+                      IORING_OFF_SQES);
+    if ((ring->ring_ptr == MAP_FAILED) || (ring->sqes == MAP_FAILED))
+    {
+        printf("crypto_standalone_uring_init - ring mmap failed, using socket loop \n");
+        crypto_standalone_uring_close(ring);
+        return CRYPTO_LIB_ERROR;
+    }
+    ring->sq_tail = (uint32_t*)((uint8_t*)ring->ring_ptr + p.sq_off.tail);
+    ring->sq_mask = (uint32_t*)((uint8_t*)ring->ring_ptr + p.sq_off.ring_mask);
+    ring->sq_array = (uint32_t*)((uint8_t*)ring->ring_ptr + p.sq_off.array);
+    ring->cq_head = (uint32_t*)((uint8_t*)ring->ring_ptr + p.cq_off.head);
+    ring->cq_tail = (uint32_t*)((uint8_t*)ring->ring_ptr + p.cq_off.tail);
+    ring->cq_mask = (uint32_t*)((uint8_t*)ring->ring_ptr + p.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe*)((uint8_t*)ring->ring_ptr + p.cq_off.cqes);
+
+    /* Frame memory and the provided buffer ring describing it */
+    ring->bufs_size = (size_t)CRYPTO_STANDALONE_URING_BUFFERS * buf_len;
+    ring->bufs = mmap(NULL, ring->bufs_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ring->buf_ring = mmap(NULL, CRYPTO_STANDALONE_URING_BUFFERS * sizeof(struct io_uring_buf), PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if ((ring->bufs == MAP_FAILED) || (ring->buf_ring == MAP_FAILED))
+    {
+        printf("crypto_standalone_uring_init - buffer mmap failed, using socket loop \n");
+        crypto_standalone_uring_close(ring);
+        return CRYPTO_LIB_ERROR;
+    }
+
+    memset(&reg, 0x00, sizeof(reg));
+    reg.ring_addr = (uint64_t)(uintptr_t)ring->buf_ring;
+    reg.ring_entries = CRYPTO_STANDALONE_URING_BUFFERS;
+    reg.bgid = CRYPTO_URING_BGID;
+    if (crypto_uring_register(ring->ring_fd, IORING_REGISTER_PBUF_RING, &reg, 1) != 0)
+    {
+        printf("crypto_standalone_uring_init - buffer ring registration failed (%d), using socket loop \n", errno);
+        crypto_standalone_uring_close(ring);
+        return CRYPTO_LIB_ERROR;
+    }
+    ring->registered = 1;
+
+    for (uint16_t bid = 0; bid < CRYPTO_STANDALONE_URING_BUFFERS; bid++)
+    {
+        crypto_standalone_uring_recycle(ring, bid);
+    }
+    __atomic_store_n(&ring->buf_ring->tail, ring->buf_tail, __ATOMIC_RELEASE);
+
+    if (crypto_standalone_uring_arm(ring) != CRYPTO_LIB_SUCCESS)
+    {
+        printf("crypto_standalone_uring_init - multishot receive submit failed, using socket loop \n");
+        crypto_standalone_uring_close(ring);
+        return CRYPTO_LIB_ERROR;
+    }
+    return CRYPTO_LIB_SUCCESS;
+}
+
+int32_t crypto_standalone_uring_recv_batch(udp_uring_t* ring, uint32_t count, uint32_t timeout_us, uint8_t** frames,
+                                           uint16_t* lens, udp_stats_t* stats)
+{
+    uint32_t head = *ring->cq_head;
+    uint32_t received = 0;
+
+    /* Block until the first completion or timeout */
+    if (head == __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE))
+    {
+        struct __kernel_timespec ts;
+        struct io_uring_getevents_arg arg;
+
+        ts.tv_sec = timeout_us / 1000000;
+        ts.tv_nsec = (timeout_us % 1000000) * 1000;
+        memset(&arg, 0x00, sizeof(arg));
+        arg.ts = (uint64_t)(uintptr_t)&ts;
+        if (crypto_uring_enter(ring->ring_fd, 0, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg,
+                               sizeof(arg)) < 0)
+        {
+            if ((errno != ETIME) && (errno != EINTR))
+            {
+                stats->rx_errors++;
+            }
+            ring->count = 0;
+            return 0;
+        }
+    }
+
+    /* Take whatever has completed, up to the batch size */
+    while ((received < count) && (head != __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE)))
+    {
+        struct io_uring_cqe* cqe = &ring->cqes[head & *ring->cq_mask];
+
+        if ((cqe->res >= 0) && (cqe->flags & IORING_CQE_F_BUFFER))
+        {
+            uint16_t bid = (uint16_t)(cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+            frames[received] = &ring->bufs[(size_t)bid * ring->buf_len];
+            lens[received] = (uint16_t)cqe->res;
+            ring->bids[received] = bid;
+            received++;
+            ring->ever_received = 1;
+        }
+        else if (cqe->res == -ENOBUFS)
+        {
+            /* Every buffer was in flight, receive stops until re-armed */
+            stats->rx_overruns++;
+        }
+        else if ((cqe->res == -EINVAL) && (ring->ever_received == 0))
+        {
+            /* Kernel does not support multishot receive */
+            __atomic_store_n(ring->cq_head, head + 1, __ATOMIC_RELEASE);
+            ring->count = 0;
+            return CRYPTO_LIB_ERROR;
+        }
+        else if (cqe->res < 0)
+        {
+            stats->rx_errors++;
+        }
+
+        if (!(cqe->flags & IORING_CQE_F_MORE))
+        {
+            ring->armed = 0;
+        }
+        head++;
+    }
+    __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+    ring->count = received;
+
+    if (ring->armed == 0)
+    {
+        crypto_standalone_uring_arm(ring);
+    }
+
+    if (received > 0)
+    {
+        stats->rx_batches++;
+        stats->rx_frames += received;
+        if (received == count)
+        {
+            stats->rx_overruns++;
+        }
+    }
+    return (int32_t)received;
+}
+
+void crypto_standalone_uring_release(udp_uring_t* ring)
+{
+    if (ring->count == 0)
+    {
+        return;
+    }
+    for (uint32_t i = 0; i < ring->count; i++)
+    {
+        crypto_standalone_uring_recycle(ring, ring->bids[i]);
+    }
+    __atomic_store_n(&ring->buf_ring->tail, ring->buf_tail, __ATOMIC_RELEASE);
+    ring->count = 0;
+}
+
+void crypto_standalone_uring_close(udp_uring_t* ring)
+{
+    if (ring->registered)
+    {
+        struct io_uring_buf_reg reg;
+        memset(&reg, 0x00, sizeof(reg));
+        reg.bgid = CRYPTO_URING_BGID;
+        crypto_uring_register(ring->ring_fd, IORING_UNREGISTER_PBUF_RING, &reg, 1);
+        ring->registered = 0;
+    }
+    if ((ring->buf_ring != NULL) && (ring->buf_ring != MAP_FAILED))
+    {
+        munmap(ring->buf_ring, CRYPTO_STANDALONE_URING_BUFFERS * sizeof(struct io_uring_buf));
+    }
+    if ((ring->bufs != NULL) && (ring->bufs != MAP_FAILED))
+    {
+        munmap(ring->bufs, ring->bufs_size);
+    }
+    if ((ring->sqes != NULL) && (ring->sqes != MAP_FAILED))
+    {
+        munmap(ring->sqes, ring->sqes_size);
+    }
+    if ((ring->ring_ptr != NULL) && (ring->ring_ptr != MAP_FAILED))
+    {
+        munmap(ring->ring_ptr, ring->ring_size);
+    }
+    if (ring->ring_fd >= 0)
+    {
+        close(ring->ring_fd);
+    }
+    memset(ring, 0x00, sizeof(*ring));
+    ring->ring_fd = -1;
+}
@@ -0,0 +1,337 @@
+/* Copyright (C) 2009 - 2022 National Aeronautics and Space Administration.
+   All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any kind, either expressed, implied, or statutory,
+   including, but not limited to, any warranty that the software will conform to specifications, any implied warranties
+   of merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+   documentation will conform to the program, or any warranty that the software will be error free.
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+   consequential damages, arising out of, resulting from, or in any way connected with the software or its
+   documentation, whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained
+   from, or arose out of the results of, or use of, the software, documentation or services provided hereunder.
+
+   ITC Team
+   NASA IV&V
+   jstar-development-team@mail.nasa.gov
+*/
+
+#include "kmc_mock.h"
+#include "crypto_error.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define KMC_MOCK_REQUEST_MAX 65536
+#define KMC_MOCK_ITEM_MAX 512
+
+static const char kmc_mock_b64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const char kmc_mock_b64url[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+// One accepted connection, the settings are taken when it arrives
+typedef struct
+{
+    kmc_mock_t* mock;
+    uint8_t id;
+    int fd;
+    int delay_ms;
+    int fail;
+    int batch_unsupported;
+} kmc_mock_conn_t;
+
+/**
+ * @brief Function: kmc_mock_encode
+ * Base64 with padding, in the given alphabet
+ * @return size_t: Encoded length, output is NULL terminated
+ **/
+static size_t kmc_mock_encode(const uint8_t* in, size_t len, char* out, const char* alphabet)
+{
+    size_t o = 0;
+    for (size_t i = 0; i < len; i += 3)
+    {
+        uint32_t v = (uint32_t)in[i] << 16;
+        if (i + 1 < len)
+        {
+            v |= (uint32_t)in[i + 1] << 8;
+        }
+        if (i + 2 < len)
+        {
+            v |= in[i + 2];
+        }
+        out[o++] = alphabet[(v >> 18) & 0x3F];
+        out[o++] = alphabet[(v >> 12) & 0x3F];
+        out[o++] = (i + 1 < len) ? alphabet[(v >> 6) & 0x3F] : '=';
+        out[o++] = (i + 2 < len) ? alphabet[v & 0x3F] : '=';
+    }
+    out[o] = '\0';
+    return o;
+}
+
+/**
+ * @brief Function: kmc_mock_decode
+ * Standard Base64, stops at padding or the first character outside the alphabet
+ * @return size_t: Decoded length
+ **/
+static size_t kmc_mock_decode(const char* in, size_t len, uint8_t* out)
+{
+    uint32_t v = 0;
+    int bits = 0;
+    size_t o = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+        const char* c = strchr(kmc_mock_b64, in[i]);
+        if (in[i] == '\0' || c == NULL)
+        {
+            break;
+        }
+        v = (v << 6) | (uint32_t)(c - kmc_mock_b64);
+        bits += 6;
+        if (bits >= 8)
+        {
+            bits -= 8;
+            out[o++] = (uint8_t)(v >> bits);
+        }
+    }
+    return o;
+}
+
+/**
+ * @brief Function: kmc_mock_icv_body
+ * Body of an icv-create answer for a payload
+ **/
+static void kmc_mock_icv_body(uint8_t id, const uint8_t* payload, size_t payload_len, char* body, size_t len_body)
+{
+    uint8_t mac[KMC_MOCK_MAC_SIZE];
+    char mac_b64[KMC_MOCK_MAC_SIZE * 2];
+
+    memset(mac, 0, sizeof(mac));
+    mac[0] = (uint8_t)(0x11 * (id + 1));
+    memcpy(&mac[1], payload, (payload_len < KMC_MOCK_MAC_SIZE - 1) ? payload_len : KMC_MOCK_MAC_SIZE - 1);
+    kmc_mock_encode(mac, sizeof(mac), mac_b64, kmc_mock_b64url);
+    snprintf(body, len_body,
+             "{\"metadata\":\"integrityCheckValue:%s,keyRef:kmc/test/hmacsha256,cryptoAlgorithm:HmacSHA256,"
+             "metadataType:IntegrityCheckMetadata\",\"httpCode\":200}",
+             mac_b64);
+}
+
+/**
+ * @brief Function: kmc_mock_batch_body
+ * Body of a batch answer, one Base64 encoded answer per operation in request order
+ * @return char*: malloc'd body
+ **/
+static char* kmc_mock_batch_body(kmc_mock_conn_t* conn, const char* request)
+{
+    const char* marker = "\"payload\":\"";
+    const char* cursor = request;
+    size_t len_body = KMC_MOCK_ITEM_MAX;
+    size_t used = 0;
+    char* body = malloc(len_body);
+    int ops = 0;
+
+    used += snprintf(body, len_body, "{\"results\":[");
+    while ((cursor = strstr(cursor, marker)) != NULL)
+    {
+        uint8_t payload[KMC_MOCK_ITEM_MAX];
+        char item[KMC_MOCK_ITEM_MAX];
+        size_t len_payload;
+        cursor += strlen(marker);
+        len_payload = strcspn(cursor, "\"");
+        if (len_payload >= KMC_MOCK_ITEM_MAX)
+        {
+            break;
+        }
+        kmc_mock_icv_body(conn->id, payload, kmc_mock_decode(cursor, len_payload, payload), item, sizeof(item));
+        len_body += KMC_MOCK_ITEM_MAX * 2;
+        body = realloc(body, len_body);
+        used += snprintf(body + used, len_body - used, "%s\"", (ops == 0) ? "" : ",");
+        used += kmc_mock_encode((const uint8_t*)item, strlen(item), body + used, kmc_mock_b64);
+        used += snprintf(body + used, len_body - used, "\"");
+        cursor += len_payload;
+        ops++;
+    }
+    snprintf(body + used, len_body - used, "],\"httpCode\":200}");
+    __atomic_add_fetch(&conn->mock->batch_ops, ops, __ATOMIC_SEQ_CST);
+    return body;
+}
+
+/**
+ * @brief Function: kmc_mock_serve
+ * Serves one request, the connection is closed after the answer
+ **/
+static void* kmc_mock_serve(void* arg)
+{
+    kmc_mock_conn_t conn = *(kmc_mock_conn_t*)arg;
+    char* request = malloc(KMC_MOCK_REQUEST_MAX);
+    char* body = NULL;
+    char* payload = NULL;
+    char header[256];
+    const char* path;
+    const char* status_line = "200 OK";
+    size_t len = 0;
+    long content_length = 0;
+    char* headers_end = NULL;
+    free(arg);
+
+    // Headers, then the rest of the body
+    while (len < KMC_MOCK_REQUEST_MAX - 1)
+    {
+        ssize_t n = recv(conn.fd, request + len, KMC_MOCK_REQUEST_MAX - 1 - len, 0);
+        if (n <= 0)
+        {
+            break;
+        }
+        len += n;
+        request[len] = '\0';
+        if (headers_end == NULL && (headers_end = strstr(request, "\r\n\r\n")) != NULL)
+        {
+            char* cl = strstr(request, "Content-Length:");
+            if (cl != NULL)
+            {
+                content_length = strtol(cl + strlen("Content-Length:"), NULL, 10);
+            }
+            if (strstr(request, "Expect: 100-continue") != NULL)
+            {
+                send(conn.fd, "HTTP/1.1 100 Continue\r\n\r\n", 25, MSG_NOSIGNAL);
+            }
+        }
+        if (headers_end != NULL && (long)(len - (headers_end + 4 - request)) >= content_length)
+        {
+            break;
+        }
+    }
+    request[len] = '\0';
+    payload = (headers_end != NULL) ? headers_end + 4 : request + len;
+    path = strstr(request, "/" KMC_MOCK_APP_URI "/");
+    path = (path != NULL) ? path + strlen("/" KMC_MOCK_APP_URI "/") : "";
+
+    if (conn.fail)
+    {
+        status_line = "500 Internal Server Error";
+        body = strdup("{\"httpCode\":500}");
+    }
+    else if (strncmp(path, "batch", strlen("batch")) == 0)
+    {
+        __atomic_add_fetch(&conn.mock->batch_hits, 1, __ATOMIC_SEQ_CST);
+        if (conn.batch_unsupported)
+        {
+            status_line = "404 Not Found";
+            body = strdup("{\"httpCode\":404}");
+        }
+        else
+        {
+            body = kmc_mock_batch_body(&conn, payload);
+        }
+    }
+    else
+    {
+        body = malloc(KMC_MOCK_ITEM_MAX);
+        kmc_mock_icv_body(conn.id, (const uint8_t*)payload, (size_t)content_length, body, KMC_MOCK_ITEM_MAX);
+    }
+
+    usleep(conn.delay_ms * 1000);
+    snprintf(header, sizeof(header),
+             "HTTP/1.1 %s\r\nContent-Type: application/json\r\nContent-Length: %zu\r\nConnection: close\r\n\r\n",
+             status_line, strlen(body));
+    // A hedge that lost may already be gone
+    send(conn.fd, header, strlen(header), MSG_NOSIGNAL);
+    send(conn.fd, body, strlen(body), MSG_NOSIGNAL);
+    close(conn.fd);
+    free(body);
+    free(request);
+    return NULL;
+}
+
+/**
+ * @brief Function: kmc_mock_accept
+ * Accepts connections until the listening socket is shut down
+ **/
+static void* kmc_mock_accept(void* arg)
+{
+    kmc_mock_t* mock = (kmc_mock_t*)arg;
+    for (;;)
+    {
+        pthread_t conn_thread;
+        int fd = accept(mock->listen_fd, NULL, NULL);
+        if (fd < 0)
+        {
+            break;
+        }
+        kmc_mock_conn_t* conn = malloc(sizeof(kmc_mock_conn_t));
+        conn->mock = mock;
+        conn->id = mock->id;
+        conn->fd = fd;
+        conn->delay_ms = __atomic_load_n(&mock->delay_ms, __ATOMIC_SEQ_CST);
+        conn->fail = __atomic_load_n(&mock->fail, __ATOMIC_SEQ_CST);
+        conn->batch_unsupported = __atomic_load_n(&mock->batch_unsupported, __ATOMIC_SEQ_CST);
+        __atomic_add_fetch(&mock->hits, 1, __ATOMIC_SEQ_CST);
+        pthread_create(&conn_thread, NULL, kmc_mock_serve, conn);
+        pthread_detach(conn_thread);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Function: kmc_mock_start
+ * Starts a stand-in service on an ephemeral loopback port
+ * @param mock: kmc_mock_t*
+ * @param id: uint8_t
+ * @return int32: Success/Failure
+ **/
+int32_t kmc_mock_start(kmc_mock_t* mock, uint8_t id)
+{
+    struct sockaddr_in addr;
+    socklen_t addr_len = sizeof(addr);
+    int one = 1;
+
+    // Requests of an earlier run may still be finishing, they only touch the counters
+    mock->id = id;
+    mock->delay_ms = 0;
+    mock->fail = 0;
+    mock->batch_unsupported = 0;
+    __atomic_store_n(&mock->hits, 0, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&mock->batch_hits, 0, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&mock->batch_ops, 0, __ATOMIC_SEQ_CST);
+    mock->listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    setsockopt(mock->listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    if (bind(mock->listen_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(mock->listen_fd, 64) != 0 ||
+        getsockname(mock->listen_fd, (struct sockaddr*)&addr, &addr_len) != 0)
+    {
+        close(mock->listen_fd);
+        return CRYPTO_LIB_ERROR;
+    }
+    mock->port = ntohs(addr.sin_port);
+    pthread_create(&mock->thread, NULL, kmc_mock_accept, mock);
+    return CRYPTO_LIB_SUCCESS;
+}
+
+/**
+ * @brief Function: kmc_mock_stop
+ * Stops accepting, requests still being served finish on their own
+ * @param mock: kmc_mock_t*
+ **/
+void kmc_mock_stop(kmc_mock_t* mock)
+{
+    shutdown(mock->listen_fd, SHUT_RDWR);
+    pthread_join(mock->thread, NULL);
+    close(mock->listen_fd);
+}
+
+/**
+ * @brief Function: kmc_mock_read
+ * Reads one of the mock's counters
+ * @param counter: int*
+ * @return int: Counter value
+ **/
+int kmc_mock_read(int* counter)
+{
+    return __atomic_load_n(counter, __ATOMIC_SEQ_CST);
+}
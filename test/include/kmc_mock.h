@@ -0,0 +1,60 @@
+/* Copyright (C) 2009 - 2022 National Aeronautics and Space Administration.
+   All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any kind, either expressed, implied, or statutory,
+   including, but not limited to, any warranty that the software will conform to specifications, any implied warranties
+   of merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+   documentation will conform to the program, or any warranty that the software will be error free.
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+   consequential damages, arising out of, resulting from, or in any way connected with the software or its
+   documentation, whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained
+   from, or arose out of the results of, or use of, the software, documentation or services provided hereunder.
+
+   ITC Team
+   NASA IV&V
+   jstar-development-team@mail.nasa.gov
+*/
+
+#ifndef CRYPTOLIB_KMC_MOCK_H
+#define CRYPTOLIB_KMC_MOCK_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <pthread.h>
+#include <stdint.h>
+
+#define KMC_MOCK_MAC_SIZE 16
+#define KMC_MOCK_APP_URI "crypto-service"
+
+/*
+** Stand-in KMC crypto service on a loopback port. Answers icv-create with a MAC whose first byte tells the
+** service apart (0x11 * (id + 1)) and whose remaining bytes echo the start of the payload, and batch requests
+** with one such answer per operation.
+*/
+typedef struct
+{
+    int listen_fd;
+    uint16_t port;
+    uint8_t id;
+    int delay_ms;          // Time before every answer
+    int fail;              // Answer every request with a server error
+    int batch_unsupported; // Answer batch requests with 404
+    int hits;              // Requests received
+    int batch_hits;        // Batch requests received
+    int batch_ops;         // Operations carried by batch requests
+    pthread_t thread;
+} kmc_mock_t;
+
+int32_t kmc_mock_start(kmc_mock_t* mock, uint8_t id);
+void kmc_mock_stop(kmc_mock_t* mock);
+int kmc_mock_read(int* counter);
+
+#ifdef __cplusplus
+} /* Close scope of 'extern "C"' declaration which encloses file. */
+#endif
+
+#endif //CRYPTOLIB_KMC_MOCK_H
@@ -0,0 +1,17 @@
+#ifndef CRYPTOLIB_UT_KMC_ENDPOINTS_H
+#define CRYPTOLIB_UT_KMC_ENDPOINTS_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "crypto.h"
+#include "shared_util.h"
+#include <stdio.h>
+
+#ifdef __cplusplus
+} /* Close scope of 'extern "C"' declaration which encloses file. */
+#endif
+
+#endif //CRYPTOLIB_UT_KMC_ENDPOINTS_H
@@ -0,0 +1,18 @@
+#ifndef CRYPTOLIB_UT_SA_PROFILE_H
+#define CRYPTOLIB_UT_SA_PROFILE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "crypto.h"
+#include "shared_util.h"
+#include <stdio.h>
+#include "cryptography_interface.h"
+
+#ifdef __cplusplus
+} /* Close scope of 'extern "C"' declaration which encloses file. */
+#endif
+
+#endif //CRYPTOLIB_UT_SA_PROFILE_H
\ No newline at end of file
@@ -0,0 +1,1284 @@
+/* Copyright (C) 2009 - 2022 National Aeronautics and Space Administration.
+   All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any kind, either expressed, implied, or statutory,
+   including, but not limited to, any warranty that the software will conform to specifications, any implied warranties
+   of merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+   documentation will conform to the program, or any warranty that the software will be error free.
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+   consequential damages, arising out of, resulting from, or in any way connected with the software or its
+   documentation, whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained
+   from, or arose out of the results of, or use of, the software, documentation or services provided hereunder.
+
+   ITC Team
+   NASA IV&V
+   jstar-development-team@mail.nasa.gov
+*/
+
+/**
+ *  Parametrized performance benchmark for the TC/TM/AOS Apply and Process Security functions.
+ *  Runs self-contained against the in-memory SADB and internal keyring, sweeping frame size, cipher suite,
+ *  service type, direction and cryptography backend.  Each case is warmed up and then timed per call so that
+ *  latency percentiles can be reported alongside throughput.  Results are printed as a table and can be
+ *  emitted as JSON and/or CSV.  Flood mode feeds the process directions frames that must be rejected, one kind of
+ *  damage per case, to measure the worst-case cost of a bad frame.
+ *
+ *  Example:
+ *      pt_benchmark --frame-sizes 512,1024,1786 --suites gcm,cbc --services aead,enc --reps 10000 --json out.json
+ *      pt_benchmark --directions tc-process,tm-process --flood valid,version,spi,fecf,mac --reject-budget 10,1,1000
+ **/
+#include "crypto.h"
+#include "crypto_error.h"
+#include "sa_interface.h"
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+** Benchmark Defaults
+*/
+#define PT_DEFAULT_FRAME_SIZES "512,1024,1786"
+#define PT_DEFAULT_WARMUP 100
+#define PT_DEFAULT_REPS 10000
+#define PT_MAX_LIST 32
+#define PT_BENCH_SPI 4
+#define PT_BENCH_KEY 130
+#define PT_MAC_LEN 16
+#define PT_TC_HDR_LEN 5
+#define PT_TM_HDR_LEN 6
+#define PT_AOS_HDR_LEN 6
+
+/*
+** Sweep Dimensions
+*/
+typedef enum
+{
+    PT_SERVICE_CLEAR,
+    PT_SERVICE_AUTH,
+    PT_SERVICE_ENC,
+    PT_SERVICE_AEAD,
+    PT_SERVICE_COUNT
+} PtService;
+
+typedef enum
+{
+    PT_DIR_TC_APPLY,
+    PT_DIR_TC_PROCESS,
+    PT_DIR_TM_APPLY,
+    PT_DIR_TM_PROCESS,
+    PT_DIR_AOS_APPLY,
+    PT_DIR_AOS_PROCESS,
+    PT_DIR_COUNT
+} PtDirection;
+
+// Damage done to the protected frame a process direction consumes, PT_FLOOD_VALID leaves it intact
+typedef enum
+{
+    PT_FLOOD_VALID,
+    PT_FLOOD_SHORT,
+    PT_FLOOD_VERSION,
+    PT_FLOOD_GVCID,
+    PT_FLOOD_SPI,
+    PT_FLOOD_SA_STATE,
+    PT_FLOOD_REPLAY,
+    PT_FLOOD_FECF,
+    PT_FLOOD_MAC,
+    PT_FLOOD_COUNT
+} PtFlood;
+
+typedef enum
+{
+    PT_BACKEND_LIBGCRYPT,
+    PT_BACKEND_WOLFSSL,
+    PT_BACKEND_OPENSSL,
+    PT_BACKEND_AUTO,
+    PT_BACKEND_COUNT
+} PtBackend;
+
+typedef struct
+{
+    const char* name;
+    uint8_t ecs;
+    uint8_t acs;
+    uint8_t iv_len;
+    uint8_t services; // Bitmask of (1 << PtService) combinations this suite supports
+} PtSuite;
+
+static const PtSuite pt_suites[] = {
+    {"gcm", CRYPTO_CIPHER_AES256_GCM, CRYPTO_MAC_NONE, 12,
+     (1 << PT_SERVICE_AUTH) | (1 << PT_SERVICE_ENC) | (1 << PT_SERVICE_AEAD)},
+    {"cbc", CRYPTO_CIPHER_AES256_CBC, CRYPTO_MAC_NONE, 16, (1 << PT_SERVICE_ENC)},
+    {"cmac", CRYPTO_CIPHER_NONE, CRYPTO_MAC_CMAC_AES256, 0, (1 << PT_SERVICE_AUTH)},
+    {"hmac256", CRYPTO_CIPHER_NONE, CRYPTO_MAC_HMAC_SHA256, 0, (1 << PT_SERVICE_AUTH)},
+    {"hmac512", CRYPTO_CIPHER_NONE, CRYPTO_MAC_HMAC_SHA512, 0, (1 << PT_SERVICE_AUTH)},
+    {"gcm-siv", CRYPTO_CIPHER_AES256_GCM_SIV, CRYPTO_MAC_NONE, 12, (1 << PT_SERVICE_AEAD)},
+    {"chacha20-poly1305", CRYPTO_CIPHER_CHACHA20_POLY1305, CRYPTO_MAC_NONE, 12, (1 << PT_SERVICE_AEAD)},
+};
+#define PT_NUM_SUITES (sizeof(pt_suites) / sizeof(pt_suites[0]))
+
+static const char* pt_service_names[PT_SERVICE_COUNT] = {"clear", "auth", "enc", "aead"};
+static const char* pt_direction_names[PT_DIR_COUNT] = {"tc-apply", "tc-process", "tm-apply",
+                                                       "tm-process", "aos-apply", "aos-process"};
+static const char* pt_backend_names[PT_BACKEND_COUNT] = {"libgcrypt", "wolfssl", "openssl", "auto"};
+static const char* pt_flood_names[PT_FLOOD_COUNT] = {"valid", "short",    "version", "gvcid", "spi",
+                                                     "sa-state", "replay", "fecf",    "mac"};
+
+// How the library reaches its modules, compare a CRYPTO_DIRECT_CALL build against a default one
+#ifdef CRYPTO_DIRECT_CALL
+#define PT_BINDING "direct"
+#else
+#define PT_BINDING "runtime"
+#endif
+
+/*
+** Run Configuration and Results
+*/
+typedef struct
+{
+    uint16_t frame_sizes[PT_MAX_LIST];
+    int num_frame_sizes;
+    uint8_t suites[PT_NUM_SUITES];
+    uint8_t services[PT_SERVICE_COUNT];
+    uint8_t directions[PT_DIR_COUNT];
+    uint8_t backends[PT_BACKEND_COUNT];
+    uint8_t floods[PT_FLOOD_COUNT];
+    uint32_t reject_burst; // Rejection budget, REJECT_BUDGET_OFF unless --reject-budget is given
+    uint32_t reject_rate;
+    uint32_t reject_holdoff_ms;
+    int warmup;
+    int reps;
+    char* json_path;
+    char* csv_path;
+    int verbose;
+} PtOptions;
+
+typedef struct
+{
+    const char* suite;
+    const char* service;
+    const char* direction;
+    const char* backend;
+    const char* flood;
+    uint16_t frame_size;  // Requested frame size
+    uint16_t frame_bytes; // Protected (on the wire) frame length actually measured
+    int32_t status;
+    uint8_t rejected; // Every call of a flood case was rejected
+    const char* skip_reason;
+    uint64_t p50_ns;
+    uint64_t p99_ns;
+    uint64_t p999_ns;
+    uint64_t max_ns;
+    double mean_ns;
+    double mbps;
+    double frames_per_sec;
+} PtResult;
+
+typedef struct
+{
+    PtResult* items;
+    int count;
+    int capacity;
+} PtResultList;
+
+/**
+ * @brief Function: pt_now_ns
+ * Monotonic timestamp in nanoseconds
+ * @return uint64: Nanoseconds
+ **/
+static uint64_t pt_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static int pt_compare_u64(const void* a, const void* b)
+{
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Function: pt_percentile
+ * Nearest-rank percentile over a sorted sample set
+ * @param sorted: uint64_t*
+ * @param n: int
+ * @param pct: double (0.0 - 1.0)
+ * @return uint64: Sample value
+ **/
+static uint64_t pt_percentile(const uint64_t* sorted, int n, double pct)
+{
+    int rank = (int)(pct * n + 0.999999);
+    if (rank < 1)
+    {
+        rank = 1;
+    }
+    if (rank > n)
+    {
+        rank = n;
+    }
+    return sorted[rank - 1];
+}
+
+static PtResult* pt_result_add(PtResultList* list)
+{
+    if (list->count == list->capacity)
+    {
+        int new_capacity = (list->capacity == 0) ? 64 : list->capacity * 2;
+        PtResult* items = realloc(list->items, new_capacity * sizeof(PtResult));
+        if (items == NULL)
+        {
+            return NULL;
+        }
+        list->items = items;
+        list->capacity = new_capacity;
+    }
+    memset(&list->items[list->count], 0, sizeof(PtResult));
+    return &list->items[list->count++];
+}
+
+/*
+** Option Parsing
+*/
+static int pt_lookup(const char* token, const char** names, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (strcmp(token, names[i]) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Function: pt_parse_names
+ * Parses a comma separated list of names into a selection mask, "all" selects everything
+ * @param arg: char*
+ * @param names: const char**
+ * @param count: int
+ * @param selected: uint8_t*
+ * @return int: 0 on success, -1 on unknown name
+ **/
+static int pt_parse_names(char* arg, const char** names, int count, uint8_t* selected)
+{
+    char* save = NULL;
+    memset(selected, 0, count);
+    for (char* tok = strtok_r(arg, ",", &save); tok != NULL; tok = strtok_r(NULL, ",", &save))
+    {
+        if (strcmp(tok, "all") == 0)
+        {
+            memset(selected, 1, count);
+            continue;
+        }
+        int idx = pt_lookup(tok, names, count);
+        if (idx < 0)
+        {
+            fprintf(stderr, "Unknown value '%s'\n", tok);
+            return -1;
+        }
+        selected[idx] = 1;
+    }
+    return 0;
+}
+
+static int pt_parse_frame_sizes(char* arg, PtOptions* opts)
+{
+    char* save = NULL;
+    opts->num_frame_sizes = 0;
+    for (char* tok = strtok_r(arg, ",", &save); tok != NULL; tok = strtok_r(NULL, ",", &save))
+    {
+        long size = strtol(tok, NULL, 10);
+        if (size < 16 || size > TM_FRAME_DATA_SIZE || opts->num_frame_sizes == PT_MAX_LIST)
+        {
+            fprintf(stderr, "Invalid frame size '%s' (16 - %d)\n", tok, TM_FRAME_DATA_SIZE);
+            return -1;
+        }
+        opts->frame_sizes[opts->num_frame_sizes++] = (uint16_t)size;
+    }
+    return 0;
+}
+
+static void pt_usage(const char* prog)
+{
+    printf("Usage: %s [options]\n", prog);
+    printf("  --frame-sizes N,N,..   Protected frame sizes in bytes (default %s)\n", PT_DEFAULT_FRAME_SIZES);
+    printf("  --suites LIST          gcm,cbc,cmac,hmac256,hmac512,gcm-siv,\n"
+           "                         chacha20-poly1305 (default all)\n");
+    printf("  --services LIST        clear,auth,enc,aead (default all)\n");
+    printf("  --directions LIST      tc-apply,tc-process,tm-apply,tm-process,aos-apply,aos-process (default all)\n");
+    printf("  --backends LIST        libgcrypt,wolfssl,openssl,auto (default all, unlinked backends are skipped)\n");
+    printf("  --flood LIST           valid,short,version,gvcid,spi,sa-state,replay,fecf,mac, frames fed to the\n"
+           "                         process directions (default valid)\n");
+    printf("  --reject-budget B,R,MS Rejection budget burst, rate per second and hold-off (default off)\n");
+    printf("  --warmup N             Untimed calls per case (default %d)\n", PT_DEFAULT_WARMUP);
+    printf("  --reps N               Timed calls per case (default %d)\n", PT_DEFAULT_REPS);
+    printf("  --json PATH            Write results as JSON\n");
+    printf("  --csv PATH             Write results as CSV\n");
+    printf("  --verbose              Also list skipped cases\n");
+}
+
+static int pt_parse_options(int argc, char** argv, PtOptions* opts)
+{
+    static struct option long_options[] = {
+        {"frame-sizes", required_argument, 0, 'f'},
+        {"suites", required_argument, 0, 's'},
+        {"services", required_argument, 0, 't'},
+        {"directions", required_argument, 0, 'd'},
+        {"backends", required_argument, 0, 'b'},
+        {"flood", required_argument, 0, 'l'},
+        {"reject-budget", required_argument, 0, 'g'},
+        {"warmup", required_argument, 0, 'w'},
+        {"reps", required_argument, 0, 'r'},
+        {"json", required_argument, 0, 'j'},
+        {"csv", required_argument, 0, 'c'},
+        {"verbose", no_argument, 0, 'v'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}};
+    const char* suite_names[PT_NUM_SUITES];
+    char default_sizes[] = PT_DEFAULT_FRAME_SIZES;
+    int opt;
+
+    for (size_t i = 0; i < PT_NUM_SUITES; i++)
+    {
+        suite_names[i] = pt_suites[i].name;
+    }
+
+    memset(opts, 0, sizeof(PtOptions));
+    pt_parse_frame_sizes(default_sizes, opts);
+    memset(opts->suites, 1, sizeof(opts->suites));
+    memset(opts->services, 1, sizeof(opts->services));
+    memset(opts->directions, 1, sizeof(opts->directions));
+    memset(opts->backends, 1, sizeof(opts->backends));
+    opts->floods[PT_FLOOD_VALID] = 1;
+    opts->reject_burst = REJECT_BUDGET_OFF;
+    opts->reject_holdoff_ms = REJECT_HOLDOFF_MS;
+    opts->warmup = PT_DEFAULT_WARMUP;
+    opts->reps = PT_DEFAULT_REPS;
+
+    while ((opt = getopt_long(argc, argv, "f:s:t:d:b:l:g:w:r:j:c:vh", long_options, NULL)) != -1)
+    {
+        int rc = 0;
+        switch (opt)
+        {
+        case 'f':
+            rc = pt_parse_frame_sizes(optarg, opts);
+            break;
+        case 's':
+            rc = pt_parse_names(optarg, suite_names, PT_NUM_SUITES, opts->suites);
+            break;
+        case 't':
+            rc = pt_parse_names(optarg, pt_service_names, PT_SERVICE_COUNT, opts->services);
+            break;
+        case 'd':
+            rc = pt_parse_names(optarg, pt_direction_names, PT_DIR_COUNT, opts->directions);
+            break;
+        case 'b':
+            rc = pt_parse_names(optarg, pt_backend_names, PT_BACKEND_COUNT, opts->backends);
+            break;
+        case 'l':
+            rc = pt_parse_names(optarg, pt_flood_names, PT_FLOOD_COUNT, opts->floods);
+            break;
+        case 'g':
+            rc = (sscanf(optarg, "%u,%u,%u", &opts->reject_burst, &opts->reject_rate, &opts->reject_holdoff_ms) == 3 &&
+                  opts->reject_rate > 0)
+                     ? 0
+                     : -1;
+            break;
+        case 'w':
+            opts->warmup = atoi(optarg);
+            rc = (opts->warmup < 0) ? -1 : 0;
+            break;
+        case 'r':
+            opts->reps = atoi(optarg);
+            rc = (opts->reps < 1) ? -1 : 0;
+            break;
+        case 'j':
+            opts->json_path = optarg;
+            break;
+        case 'c':
+            opts->csv_path = optarg;
+            break;
+        case 'v':
+            opts->verbose = 1;
+            break;
+        case 'h':
+            pt_usage(argv[0]);
+            exit(0);
+        default:
+            rc = -1;
+            break;
+        }
+        if (rc != 0)
+        {
+            pt_usage(argv[0]);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/*
+** Case Setup
+*/
+static uint8_t pt_backend_linked(PtBackend backend)
+{
+    if (backend == PT_BACKEND_AUTO)
+    {
+        return CRYPTO_TRUE;
+    }
+    if (backend == PT_BACKEND_LIBGCRYPT)
+    {
+        return get_cryptography_interface_libgcrypt() != NULL;
+    }
+    if (backend == PT_BACKEND_OPENSSL)
+    {
+        return get_cryptography_interface_openssl() != NULL;
+    }
+    return get_cryptography_interface_wolfssl() != NULL;
+}
+
+static uint8_t pt_backend_type(PtBackend backend)
+{
+    if (backend == PT_BACKEND_AUTO)
+    {
+        return CRYPTOGRAPHY_TYPE_AUTO;
+    }
+    if (backend == PT_BACKEND_LIBGCRYPT)
+    {
+        return CRYPTOGRAPHY_TYPE_LIBGCRYPT;
+    }
+    return (backend == PT_BACKEND_OPENSSL) ? CRYPTOGRAPHY_TYPE_OPENSSL : CRYPTOGRAPHY_TYPE_WOLFSSL;
+}
+
+/**
+ * @brief Function: pt_configure_sa
+ * Fully specifies the benchmark SA so no field depends on the default in-memory population
+ * @param sa_ptr: SecurityAssociation_t*
+ * @param suite: const PtSuite*
+ * @param service: PtService
+ * @param dir: PtDirection
+ **/
+static void pt_configure_sa(SecurityAssociation_t* sa_ptr, const PtSuite* suite, PtService service, PtDirection dir)
+{
+    sa_ptr->sa_state = SA_OPERATIONAL;
+    sa_ptr->gvcid_blk.mapid = 0;
+    if (dir == PT_DIR_TC_APPLY || dir == PT_DIR_TC_PROCESS)
+    {
+        sa_ptr->gvcid_blk.tfvn = 0;
+        sa_ptr->gvcid_blk.scid = SCID;
+    }
+    else if (dir == PT_DIR_TM_APPLY || dir == PT_DIR_TM_PROCESS)
+    {
+        sa_ptr->gvcid_blk.tfvn = 0;
+        sa_ptr->gvcid_blk.scid = 0x002C;
+    }
+    else
+    {
+        sa_ptr->gvcid_blk.tfvn = 1;
+        sa_ptr->gvcid_blk.scid = 0x0000;
+    }
+    sa_ptr->gvcid_blk.vcid = 0;
+
+    sa_ptr->est = (service == PT_SERVICE_ENC || service == PT_SERVICE_AEAD);
+    sa_ptr->ast = (service == PT_SERVICE_AUTH || service == PT_SERVICE_AEAD);
+    sa_ptr->ecs = CRYPTO_CIPHER_NONE;
+    sa_ptr->ecs_len = 0;
+    sa_ptr->acs = CRYPTO_MAC_NONE;
+    sa_ptr->acs_len = 0;
+    sa_ptr->iv_len = 0;
+    sa_ptr->shivf_len = 0;
+    sa_ptr->shsnf_len = 0;
+    sa_ptr->shplf_len = 0;
+    sa_ptr->stmacf_len = 0;
+    sa_ptr->arsn_len = 0;
+    sa_ptr->arsnw_len = 0;
+    sa_ptr->arsnw = 0;
+    sa_ptr->ekid = PT_BENCH_KEY;
+    sa_ptr->akid = PT_BENCH_KEY;
+    memset(sa_ptr->iv, 0, IV_SIZE);
+    memset(sa_ptr->arsn, 0, ARSN_SIZE);
+    sa_ptr->abm_len = ABM_SIZE;
+    memset(sa_ptr->abm, 0xFF, ABM_SIZE);
+
+    if (service == PT_SERVICE_CLEAR)
+    {
+        return;
+    }
+
+    if (suite->ecs != CRYPTO_CIPHER_NONE)
+    {
+        sa_ptr->ecs = suite->ecs;
+        sa_ptr->ecs_len = 1;
+    }
+    if (suite->acs != CRYPTO_MAC_NONE)
+    {
+        sa_ptr->acs = suite->acs;
+        sa_ptr->acs_len = 1;
+    }
+    sa_ptr->iv_len = suite->iv_len;
+    sa_ptr->shivf_len = suite->iv_len;
+    if (sa_ptr->ast)
+    {
+        sa_ptr->stmacf_len = PT_MAC_LEN;
+    }
+    // MAC-only suites carry no IV, so sequence them with an ARSN instead
+    if (sa_ptr->ast && suite->iv_len == 0)
+    {
+        sa_ptr->arsn_len = 4;
+        sa_ptr->shsnf_len = 4;
+        sa_ptr->arsnw_len = 1;
+        sa_ptr->arsnw = 5;
+    }
+    // TC CBC is PKCS#7 padded by CryptoLib and needs somewhere to carry the pad length
+    if (suite->ecs == CRYPTO_CIPHER_AES256_CBC && (dir == PT_DIR_TC_APPLY || dir == PT_DIR_TC_PROCESS))
+    {
+        sa_ptr->shplf_len = 1;
+    }
+}
+
+/**
+ * @brief Function: pt_sec_overhead
+ * Bytes added to a frame by the security header and trailer of an SA
+ * @param sa_ptr: SecurityAssociation_t*
+ * @return uint16: Overhead in bytes
+ **/
+static uint16_t pt_sec_overhead(const SecurityAssociation_t* sa_ptr)
+{
+    return SPI_LEN + sa_ptr->shivf_len + sa_ptr->shsnf_len + sa_ptr->shplf_len + sa_ptr->stmacf_len;
+}
+
+/**
+ * @brief Function: pt_tc_input_length
+ * Largest unprotected TC whose protected form fits in frame_size, accounting for CBC padding
+ * @param sa_ptr: SecurityAssociation_t*
+ * @param frame_size: uint16_t
+ * @return uint16: Input length, 0 if none fits
+ **/
+static uint16_t pt_tc_input_length(const SecurityAssociation_t* sa_ptr, uint16_t frame_size)
+{
+    uint16_t overhead = pt_sec_overhead(sa_ptr);
+    uint16_t in_len;
+
+    if (frame_size <= overhead + PT_TC_HDR_LEN + FECF_SIZE + 1)
+    {
+        return 0;
+    }
+    in_len = frame_size - overhead;
+    if (sa_ptr->est && sa_ptr->ecs == CRYPTO_CIPHER_AES256_CBC)
+    {
+        // Crypto_TC_Handle_Enc_Padding always pads 1 - 16 bytes
+        while (in_len > PT_TC_HDR_LEN + FECF_SIZE + 1)
+        {
+            uint16_t payload = in_len - PT_TC_HDR_LEN - FECF_SIZE;
+            uint16_t padding = TC_BLOCK_SIZE - (payload % TC_BLOCK_SIZE);
+            if (in_len + overhead + padding <= frame_size)
+            {
+                break;
+            }
+            in_len--;
+        }
+    }
+    return in_len;
+}
+
+static void pt_fill_payload(uint8_t* buffer, uint16_t start, uint16_t end)
+{
+    for (uint16_t i = start; i < end; i++)
+    {
+        buffer[i] = (uint8_t)(i * 7 + 0xA5);
+    }
+}
+
+/**
+ * @brief Function: pt_build_frame
+ * Builds the unprotected frame for a direction.  The security header and trailer space of TM and AOS
+ * frames is left zeroed for ApplySecurity to populate in place.
+ * @param dir: PtDirection
+ * @param sa_ptr: SecurityAssociation_t*
+ * @param frame_size: uint16_t
+ * @param buffer: uint8_t*
+ * @param length: uint16_t*
+ * @param skip_reason: const char**
+ **/
+static void pt_build_frame(PtDirection dir, const SecurityAssociation_t* sa_ptr, uint16_t frame_size, uint8_t* buffer,
+                           uint16_t* length, const char** skip_reason)
+{
+    uint16_t hdr_len = PT_TM_HDR_LEN;
+    uint16_t pdu_len = 0;
+
+    memset(buffer, 0, TM_FRAME_DATA_SIZE);
+    *length = 0;
+
+    if (dir == PT_DIR_TC_APPLY || dir == PT_DIR_TC_PROCESS)
+    {
+        uint16_t in_len = 0;
+        if (frame_size > TC_MAX_FRAME_SIZE)
+        {
+            *skip_reason = "exceeds TC max frame size";
+            return;
+        }
+        in_len = pt_tc_input_length(sa_ptr, frame_size);
+        if (in_len == 0)
+        {
+            *skip_reason = "frame too small for SA";
+            return;
+        }
+        buffer[0] = 0x20; // TFVN 0, bypass, SCID high bits 0
+        buffer[1] = (uint8_t)(SCID & 0xFF);
+        buffer[2] = (uint8_t)(((in_len - 1) >> 8) & 0x03); // VCID 0
+        buffer[3] = (uint8_t)((in_len - 1) & 0xFF);
+        buffer[4] = 0x00;
+        pt_fill_payload(buffer, PT_TC_HDR_LEN, in_len - FECF_SIZE);
+        *length = in_len;
+        return;
+    }
+
+    if (dir == PT_DIR_TM_APPLY || dir == PT_DIR_TM_PROCESS)
+    {
+        // TFVN 0, SCID 0x2C, VCID 0, no secondary header
+        buffer[0] = 0x02;
+        buffer[1] = 0xC0;
+        buffer[4] = 0x18;
+    }
+    else
+    {
+        // TFVN 1, SCID 0, VCID 0 - decodes identically under the AOS and TM header layouts
+        buffer[0] = 0x40;
+        hdr_len = PT_AOS_HDR_LEN;
+    }
+
+    if (frame_size <= hdr_len + pt_sec_overhead(sa_ptr) + FECF_SIZE)
+    {
+        *skip_reason = "frame too small for SA";
+        return;
+    }
+    pdu_len = frame_size - hdr_len - pt_sec_overhead(sa_ptr) - FECF_SIZE;
+    if (sa_ptr->est && sa_ptr->ecs == CRYPTO_CIPHER_AES256_CBC && (pdu_len % TC_BLOCK_SIZE) != 0)
+    {
+        *skip_reason = "CBC needs a block aligned PDU";
+        return;
+    }
+    pt_fill_payload(buffer, hdr_len + SPI_LEN + sa_ptr->shivf_len + sa_ptr->shsnf_len + sa_ptr->shplf_len,
+                    hdr_len + SPI_LEN + sa_ptr->shivf_len + sa_ptr->shsnf_len + sa_ptr->shplf_len + pdu_len);
+    *length = frame_size;
+}
+
+/*
+** Timed Calls
+*/
+typedef struct
+{
+    PtDirection dir;
+    uint8_t* input;      // Unprotected frame (apply) or protected frame (process)
+    uint16_t input_len;
+    uint8_t* scratch;    // Per call copy of input, operations may modify their ingest
+    TC_t* tc_processed;
+    uint16_t out_len;
+} PtCaseState;
+
+/**
+ * @brief Function: pt_run_once
+ * Executes a single operation for the case, timing only the CryptoLib call
+ * @param state: PtCaseState*
+ * @param elapsed_ns: uint64_t* (NULL if untimed)
+ * @return int32: Success/Failure
+ **/
+static int32_t pt_run_once(PtCaseState* state, uint64_t* elapsed_ns)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    uint8_t* out_frame = NULL;
+    uint16_t out_len = 0;
+    int tc_len = state->input_len;
+    uint64_t start;
+    uint64_t end;
+
+    memcpy(state->scratch, state->input, state->input_len);
+
+    start = pt_now_ns();
+    switch (state->dir)
+    {
+    case PT_DIR_TC_APPLY:
+        status = Crypto_TC_ApplySecurity(state->scratch, state->input_len, &out_frame, &out_len);
+        break;
+    case PT_DIR_TC_PROCESS:
+        status = Crypto_TC_ProcessSecurity(state->scratch, &tc_len, state->tc_processed);
+        break;
+    case PT_DIR_TM_APPLY:
+        status = Crypto_TM_ApplySecurity(state->scratch);
+        break;
+    case PT_DIR_TM_PROCESS:
+        status = Crypto_TM_ProcessSecurity(state->scratch, state->input_len, &out_frame, &out_len);
+        break;
+    case PT_DIR_AOS_APPLY:
+        status = Crypto_AOS_ApplySecurity(state->scratch);
+        break;
+    case PT_DIR_AOS_PROCESS:
+        status = Crypto_AOS_ProcessSecurity(state->scratch, state->input_len, &out_frame, &out_len);
+        break;
+    default:
+        status = CRYPTO_LIB_ERROR;
+        break;
+    }
+    end = pt_now_ns();
+
+    if (elapsed_ns != NULL)
+    {
+        *elapsed_ns = end - start;
+    }
+    if (state->dir == PT_DIR_TC_APPLY)
+    {
+        state->out_len = out_len;
+    }
+    else if (state->dir == PT_DIR_TM_APPLY || state->dir == PT_DIR_AOS_APPLY)
+    {
+        state->out_len = state->input_len;
+    }
+    else
+    {
+        // Process directions are measured by the protected frame they consume
+        state->out_len = state->input_len;
+    }
+    if (out_frame != NULL)
+    {
+        free(out_frame);
+    }
+    return status;
+}
+
+/**
+ * @brief Function: pt_protect_for_process
+ * Produces the protected frame a process direction consumes by running the matching apply once
+ * @param state: PtCaseState*
+ * @return int32: Success/Failure
+ **/
+static int32_t pt_protect_for_process(PtCaseState* state)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    uint8_t* out_frame = NULL;
+    uint16_t out_len = 0;
+
+    switch (state->dir)
+    {
+    case PT_DIR_TC_PROCESS:
+        status = Crypto_TC_ApplySecurity(state->input, state->input_len, &out_frame, &out_len);
+        if (status == CRYPTO_LIB_SUCCESS)
+        {
+            memcpy(state->input, out_frame, out_len);
+            state->input_len = out_len;
+        }
+        if (out_frame != NULL)
+        {
+            free(out_frame);
+        }
+        break;
+    case PT_DIR_TM_PROCESS:
+        status = Crypto_TM_ApplySecurity(state->input);
+        break;
+    case PT_DIR_AOS_PROCESS:
+        status = Crypto_AOS_ApplySecurity(state->input);
+        break;
+    default:
+        break;
+    }
+    return status;
+}
+
+/**
+ * @brief Function: pt_flood_frame
+ * Damages the protected frame of a process direction so that one specific check rejects it.  Everything but the
+ * FECF and length kinds gets a fresh FECF, so that the frame gets as far as the damaged field.
+ * @param flood: PtFlood
+ * @param sa_ptr: SecurityAssociation_t*
+ * @param state: PtCaseState*
+ * @return const char*: Skip reason, NULL if the frame was damaged
+ **/
+static const char* pt_flood_frame(PtFlood flood, SecurityAssociation_t* sa_ptr, PtCaseState* state)
+{
+    uint8_t* frame = state->input;
+    uint16_t hdr_len = PT_TC_HDR_LEN;
+    uint16_t fecf;
+
+    if (state->dir == PT_DIR_TM_PROCESS)
+    {
+        hdr_len = PT_TM_HDR_LEN;
+    }
+    else if (state->dir == PT_DIR_AOS_PROCESS)
+    {
+        hdr_len = PT_AOS_HDR_LEN;
+    }
+
+    switch (flood)
+    {
+    case PT_FLOOD_VALID:
+        return NULL;
+    case PT_FLOOD_SHORT:
+        state->input_len = hdr_len - 1;
+        return NULL;
+    case PT_FLOOD_VERSION:
+        if (state->dir == PT_DIR_AOS_PROCESS)
+        {
+            frame[0] &= 0x3F;
+        }
+        else
+        {
+            frame[0] |= 0x40;
+        }
+        break;
+    case PT_FLOOD_GVCID:
+        if (state->dir == PT_DIR_TC_PROCESS)
+        {
+            frame[2] ^= 0x04;
+        }
+        else
+        {
+            frame[1] |= 0x0E;
+        }
+        break;
+    case PT_FLOOD_SPI:
+        frame[hdr_len] = 0xFF;
+        frame[hdr_len + 1] = 0xFF;
+        break;
+    case PT_FLOOD_SA_STATE:
+        sa_ptr->sa_state = SA_NONE;
+        return NULL;
+    case PT_FLOOD_REPLAY:
+        // The frame carries the IV/ARSN the SA saw last, the benchmark turns anti-replay on for this kind
+        if (state->dir != PT_DIR_TC_PROCESS)
+        {
+            return "no anti-replay on this path";
+        }
+        if (sa_ptr->arsn_len == 0 &&
+            sa_ptr->ecs != CRYPTO_CIPHER_AES256_GCM && sa_ptr->ecs != CRYPTO_CIPHER_CHACHA20_POLY1305)
+        {
+            return "SA has no counter IV or ARSN";
+        }
+        return NULL;
+    case PT_FLOOD_FECF:
+        frame[state->input_len - 1] ^= 0xFF;
+        return NULL;
+    case PT_FLOOD_MAC:
+        if (sa_ptr->stmacf_len == 0)
+        {
+            return "SA has no MAC";
+        }
+        if (state->dir != PT_DIR_TC_PROCESS && !sa_ptr->est && Crypto_Is_AEAD_Algorithm(sa_ptr->ecs))
+        {
+            return "GMAC not verified on this path";
+        }
+        frame[state->input_len - FECF_SIZE - 1] ^= 0xFF;
+        break;
+    default:
+        return "unknown flood";
+    }
+
+    fecf = Crypto_Calc_FECF(frame, state->input_len - FECF_SIZE);
+    frame[state->input_len - 2] = (uint8_t)(fecf >> 8);
+    frame[state->input_len - 1] = (uint8_t)(fecf & 0xFF);
+    return NULL;
+}
+
+/**
+ * @brief Function: pt_flood_expected
+ * Whether a call behaved as the flood kind requires: valid frames are accepted, damaged ones rejected
+ * @param flood: PtFlood
+ * @param status: int32_t
+ * @return uint8: CRYPTO_TRUE if expected
+ **/
+static uint8_t pt_flood_expected(PtFlood flood, int32_t status)
+{
+    return (flood == PT_FLOOD_VALID) ? (status == CRYPTO_LIB_SUCCESS) : (status != CRYPTO_LIB_SUCCESS);
+}
+
+/**
+ * @brief Function: pt_run_case
+ * Configures CryptoLib for one point of the sweep, then warms up and times it
+ * @param opts: PtOptions*
+ * @param backend: PtBackend
+ * @param suite: const PtSuite*
+ * @param service: PtService
+ * @param dir: PtDirection
+ * @param frame_size: uint16_t
+ * @param flood: PtFlood
+ * @param result: PtResult*
+ **/
+static void pt_run_case(const PtOptions* opts, PtBackend backend, const PtSuite* suite, PtService service,
+                        PtDirection dir, uint16_t frame_size, PtFlood flood, PtResult* result)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    SecurityAssociation_t* sa_ptr = NULL;
+    SecurityAssociation_t* other_ptr = NULL;
+    GvcidManagedParameters_t mp = {0, SCID, 0, TC_HAS_FECF, AOS_FHEC_NA, AOS_IZ_NA, 0, TC_NO_SEGMENT_HDRS,
+                                   TC_MAX_FRAME_SIZE, TC_OCF_NA, 1};
+    // Frames carry and check an FECF the way the link would, whichever the frame type
+    uint8_t create_fecf = CRYPTO_TC_CREATE_FECF_TRUE;
+    uint8_t check_fecf = TC_CHECK_FECF_TRUE;
+    PtCaseState state;
+    uint64_t* samples = NULL;
+    uint64_t total_ns = 0;
+    uint8_t expected = CRYPTO_FALSE;
+
+    memset(&state, 0, sizeof(state));
+    state.dir = dir;
+    result->suite = (service == PT_SERVICE_CLEAR) ? "none" : suite->name;
+    result->service = pt_service_names[service];
+    result->direction = pt_direction_names[dir];
+    result->backend = pt_backend_names[backend];
+    result->flood = pt_flood_names[flood];
+    result->frame_size = frame_size;
+
+    if (!pt_backend_linked(backend))
+    {
+        result->skip_reason = "backend not linked";
+        return;
+    }
+#ifdef CRYPTO_DIRECT_CALL
+    // Auto routing selects modules at runtime, which the bound build rejects
+    if (backend == PT_BACKEND_AUTO)
+    {
+        result->skip_reason = "backend not bound";
+        return;
+    }
+#endif
+
+    if (dir == PT_DIR_TM_APPLY || dir == PT_DIR_TM_PROCESS)
+    {
+        GvcidManagedParameters_t tm_mp = {0, 0x002C, 0, TM_HAS_FECF, AOS_FHEC_NA, AOS_IZ_NA, 0,
+                                          TM_SEGMENT_HDRS_NA, frame_size, TM_NO_OCF, 1};
+        mp = tm_mp;
+        create_fecf = CRYPTO_TM_CREATE_FECF_TRUE;
+        check_fecf = TM_CHECK_FECF_TRUE;
+    }
+    else if (dir == PT_DIR_AOS_APPLY || dir == PT_DIR_AOS_PROCESS)
+    {
+        GvcidManagedParameters_t aos_mp = {1, 0x0000, 0, AOS_HAS_FECF, AOS_FHEC_NA, AOS_IZ_NA, 0,
+                                           AOS_SEGMENT_HDRS_NA, frame_size, AOS_NO_OCF, 1};
+        mp = aos_mp;
+        create_fecf = CRYPTO_AOS_CREATE_FECF_TRUE;
+        check_fecf = AOS_CHECK_FECF_TRUE;
+    }
+
+    Crypto_Config_CryptoLib(KEY_TYPE_INTERNAL, MC_TYPE_INTERNAL, SA_TYPE_INMEMORY, pt_backend_type(backend),
+                            IV_INTERNAL, create_fecf, TC_PROCESS_SDLS_PDUS_FALSE, TC_NO_PUS_HDR, TC_IGNORE_SA_STATE_FALSE,
+                            (flood == PT_FLOOD_REPLAY) ? TC_IGNORE_ANTI_REPLAY_FALSE : TC_IGNORE_ANTI_REPLAY_TRUE,
+                            TC_UNIQUE_SA_PER_MAP_ID_FALSE, check_fecf, 0x3F, SA_INCREMENT_NONTRANSMITTED_IV_TRUE);
+    Crypto_Config_Reject_Budget(opts->reject_burst, opts->reject_rate, opts->reject_holdoff_ms);
+    Crypto_Config_Add_Gvcid_Managed_Parameters(mp);
+    status = Crypto_Init();
+    if (status != CRYPTO_LIB_SUCCESS)
+    {
+        result->status = status;
+        Crypto_Shutdown();
+        return;
+    }
+
+    // Suites the linked backend cannot run (e.g. GCM-SIV before OpenSSL 3.2) are skipped, not errors
+    if (service != PT_SERVICE_CLEAR &&
+        ((suite->ecs != CRYPTO_CIPHER_NONE && cryptography_if->cryptography_get_ecs_algo(suite->ecs) < 0) ||
+         (suite->acs != CRYPTO_MAC_NONE && cryptography_if->cryptography_get_acs_algo(suite->acs) < 0)))
+    {
+        result->skip_reason = "suite not supported by backend";
+        Crypto_Shutdown();
+        return;
+    }
+
+    // Only the benchmark SA may be operational so GVCID lookups are deterministic
+    SaInterface sa_if_local = get_sa_interface_inmemory();
+    for (uint16_t spi = 1; spi < NUM_SA; spi++)
+    {
+        other_ptr = NULL;
+        sa_if_local->sa_get_from_spi(spi, &other_ptr);
+        if (other_ptr != NULL && spi != PT_BENCH_SPI && other_ptr->sa_state == SA_OPERATIONAL)
+        {
+            other_ptr->sa_state = SA_KEYED;
+        }
+    }
+    sa_if_local->sa_get_from_spi(PT_BENCH_SPI, &sa_ptr);
+    if (sa_ptr == NULL)
+    {
+        result->status = CRYPTO_LIB_ERR_NULL_SA;
+        Crypto_Shutdown();
+        return;
+    }
+    pt_configure_sa(sa_ptr, suite, service, dir);
+
+    // HMAC-SHA512 expects a 64 byte key, stretch the benchmark key to the suite's length
+    if (sa_ptr->acs_len != 0)
+    {
+        crypto_key_t* akp = key_if->get_key(sa_ptr->akid);
+        int32_t key_len = Crypto_Get_ACS_Algo_Keylen(sa_ptr->acs);
+        if (akp != NULL && key_len > 0)
+        {
+            akp->key_len = key_len;
+        }
+    }
+
+    state.input = calloc(1, TM_FRAME_DATA_SIZE);
+    state.scratch = calloc(1, TM_FRAME_DATA_SIZE);
+    state.tc_processed = calloc(1, sizeof(TC_t));
+    samples = calloc(opts->reps, sizeof(uint64_t));
+    if (state.input == NULL || state.scratch == NULL || state.tc_processed == NULL || samples == NULL)
+    {
+        result->status = CRYPTO_LIB_ERROR;
+        goto cleanup;
+    }
+
+    pt_build_frame(dir, sa_ptr, frame_size, state.input, &state.input_len, &result->skip_reason);
+    if (result->skip_reason != NULL)
+    {
+        goto cleanup;
+    }
+
+    status = pt_protect_for_process(&state);
+    if (status == CRYPTO_LIB_SUCCESS)
+    {
+        result->skip_reason = pt_flood_frame(flood, sa_ptr, &state);
+        if (result->skip_reason != NULL)
+        {
+            goto cleanup;
+        }
+        expected = CRYPTO_TRUE;
+    }
+    for (int i = 0; i < opts->warmup && expected; i++)
+    {
+        status = pt_run_once(&state, NULL);
+        expected = pt_flood_expected(flood, status);
+    }
+    for (int i = 0; i < opts->reps && expected; i++)
+    {
+        status = pt_run_once(&state, &samples[i]);
+        expected = pt_flood_expected(flood, status);
+        total_ns += samples[i];
+    }
+    result->status = status;
+    if (!expected)
+    {
+        goto cleanup;
+    }
+    result->rejected = (flood != PT_FLOOD_VALID);
+
+    qsort(samples, opts->reps, sizeof(uint64_t), pt_compare_u64);
+    result->frame_bytes = state.out_len;
+    result->p50_ns = pt_percentile(samples, opts->reps, 0.50);
+    result->p99_ns = pt_percentile(samples, opts->reps, 0.99);
+    result->p999_ns = pt_percentile(samples, opts->reps, 0.999);
+    result->max_ns = samples[opts->reps - 1];
+    result->mean_ns = (double)total_ns / opts->reps;
+    if (total_ns > 0)
+    {
+        result->frames_per_sec = (double)opts->reps * 1e9 / (double)total_ns;
+        result->mbps = result->frames_per_sec * result->frame_bytes * 8.0 / 1e6;
+    }
+
+cleanup:
+    free(samples);
+    free(state.tc_processed);
+    free(state.scratch);
+    free(state.input);
+    Crypto_Shutdown();
+}
+
+/*
+** Reporting
+*/
+static const char* pt_result_state(const PtResult* r)
+{
+    if (r->skip_reason != NULL)
+    {
+        return "skipped";
+    }
+    if (r->status == CRYPTO_LIB_SUCCESS)
+    {
+        return (strcmp(r->flood, "valid") == 0) ? "ok" : "accepted";
+    }
+    return r->rejected ? "rejected" : "error";
+}
+
+static uint8_t pt_result_passed(const PtResult* r)
+{
+    const char* state = pt_result_state(r);
+    return (strcmp(state, "error") != 0) && (strcmp(state, "accepted") != 0);
+}
+
+static void pt_print_table(const PtResultList* list, int verbose)
+{
+    printf("binding: %s\n", PT_BINDING);
+    printf("%-10s %-17s %-6s %-12s %-8s %6s %6s %10s %10s %10s %10s %10s %12s\n", "backend", "suite", "svc",
+           "direction", "flood", "size", "bytes", "p50_ns", "p99_ns", "p999_ns", "max_ns", "Mbps", "frames/s");
+    for (int i = 0; i < list->count; i++)
+    {
+        const PtResult* r = &list->items[i];
+        if (r->skip_reason != NULL)
+        {
+            if (verbose)
+            {
+                printf("%-10s %-17s %-6s %-12s %-8s %6u  skipped: %s\n", r->backend, r->suite, r->service,
+                       r->direction, r->flood, r->frame_size, r->skip_reason);
+            }
+            continue;
+        }
+        if (!pt_result_passed(r))
+        {
+            printf("%-10s %-17s %-6s %-12s %-8s %6u  %s: %s (%d)\n", r->backend, r->suite, r->service, r->direction,
+                   r->flood, r->frame_size, pt_result_state(r), Crypto_Get_Error_Code_Enum_String(r->status),
+                   r->status);
+            continue;
+        }
+        printf("%-10s %-17s %-6s %-12s %-8s %6u %6u %10lu %10lu %10lu %10lu %10.2f %12.1f", r->backend, r->suite,
+               r->service, r->direction, r->flood, r->frame_size, r->frame_bytes, (unsigned long)r->p50_ns,
+               (unsigned long)r->p99_ns, (unsigned long)r->p999_ns, (unsigned long)r->max_ns, r->mbps,
+               r->frames_per_sec);
+        if (r->rejected)
+        {
+            printf("  %s (%d)", Crypto_Get_Error_Code_Enum_String(r->status), r->status);
+        }
+        printf("\n");
+    }
+}
+
+static int pt_write_csv(const char* path, const PtResultList* list)
+{
+    FILE* fp = fopen(path, "w");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "ERROR: Unable to open %s\n", path);
+        return -1;
+    }
+    fprintf(fp, "binding,backend,suite,service,direction,flood,frame_size,frame_bytes,result,status,p50_ns,p99_ns,"
+                "p999_ns,max_ns,mean_ns,mbps,frames_per_sec\n");
+    for (int i = 0; i < list->count; i++)
+    {
+        const PtResult* r = &list->items[i];
+        fprintf(fp, "%s,%s,%s,%s,%s,%s,%u,%u,%s,%d,%lu,%lu,%lu,%lu,%.1f,%.3f,%.1f\n", PT_BINDING, r->backend,
+                r->suite, r->service, r->direction, r->flood, r->frame_size, r->frame_bytes, pt_result_state(r),
+                r->status, (unsigned long)r->p50_ns, (unsigned long)r->p99_ns, (unsigned long)r->p999_ns,
+                (unsigned long)r->max_ns, r->mean_ns, r->mbps, r->frames_per_sec);
+    }
+    fclose(fp);
+    return 0;
+}
+
+static int pt_write_json(const char* path, const PtOptions* opts, const PtResultList* list)
+{
+    FILE* fp = fopen(path, "w");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "ERROR: Unable to open %s\n", path);
+        return -1;
+    }
+    fprintf(fp, "{\n  \"binding\": \"%s\",\n  \"warmup\": %d,\n  \"reps\": %d,\n", PT_BINDING, opts->warmup,
+            opts->reps);
+    fprintf(fp, "  \"reject_budget\": {\"burst\": %u, \"rate\": %u, \"holdoff_ms\": %u},\n  \"results\": [\n",
+            opts->reject_burst, opts->reject_rate, opts->reject_holdoff_ms);
+    for (int i = 0; i < list->count; i++)
+    {
+        const PtResult* r = &list->items[i];
+        fprintf(fp,
+                "    {\"backend\": \"%s\", \"suite\": \"%s\", \"service\": \"%s\", \"direction\": \"%s\", "
+                "\"flood\": \"%s\", \"frame_size\": %u, \"frame_bytes\": %u, \"result\": \"%s\", \"status\": %d, ",
+                r->backend, r->suite, r->service, r->direction, r->flood, r->frame_size, r->frame_bytes,
+                pt_result_state(r), r->status);
+        if (r->skip_reason != NULL)
+        {
+            fprintf(fp, "\"reason\": \"%s\"}", r->skip_reason);
+        }
+        else
+        {
+            fprintf(fp,
+                    "\"p50_ns\": %lu, \"p99_ns\": %lu, \"p999_ns\": %lu, \"max_ns\": %lu, \"mean_ns\": %.1f, "
+                    "\"mbps\": %.3f, \"frames_per_sec\": %.1f}",
+                    (unsigned long)r->p50_ns, (unsigned long)r->p99_ns, (unsigned long)r->p999_ns,
+                    (unsigned long)r->max_ns, r->mean_ns, r->mbps, r->frames_per_sec);
+        }
+        fprintf(fp, "%s\n", (i + 1 < list->count) ? "," : "");
+    }
+    fprintf(fp, "  ]\n}\n");
+    fclose(fp);
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    PtOptions opts;
+    PtResultList results = {NULL, 0, 0};
+    int errors = 0;
+
+    if (pt_parse_options(argc, argv, &opts) != 0)
+    {
+        return 1;
+    }
+
+    for (int b = 0; b < PT_BACKEND_COUNT; b++)
+    {
+        if (!opts.backends[b])
+        {
+            continue;
+        }
+        for (int d = 0; d < PT_DIR_COUNT; d++)
+        {
+            if (!opts.directions[d])
+            {
+                continue;
+            }
+            for (int s = 0; s < PT_SERVICE_COUNT; s++)
+            {
+                if (!opts.services[s])
+                {
+                    continue;
+                }
+                for (size_t c = 0; c < PT_NUM_SUITES; c++)
+                {
+                    // Clear mode has no cipher suite, run it once per frame size
+                    if ((s == PT_SERVICE_CLEAR && c > 0) ||
+                        (s != PT_SERVICE_CLEAR && (!opts.suites[c] || !(pt_suites[c].services & (1 << s)))))
+                    {
+                        continue;
+                    }
+                    for (int f = 0; f < opts.num_frame_sizes; f++)
+                    {
+                        for (int k = 0; k < PT_FLOOD_COUNT; k++)
+                        {
+                            // Only process directions take in frames from the link
+                            if (!opts.floods[k] || (k != PT_FLOOD_VALID && d != PT_DIR_TC_PROCESS &&
+                                                    d != PT_DIR_TM_PROCESS && d != PT_DIR_AOS_PROCESS))
+                            {
+                                continue;
+                            }
+                            PtResult* result = pt_result_add(&results);
+                            if (result == NULL)
+                            {
+                                fprintf(stderr, "ERROR: Out of memory\n");
+                                return 1;
+                            }
+                            pt_run_case(&opts, (PtBackend)b, &pt_suites[c], (PtService)s, (PtDirection)d,
+                                        opts.frame_sizes[f], (PtFlood)k, result);
+                            if (!pt_result_passed(result))
+                            {
+                                errors++;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    pt_print_table(&results, opts.verbose);
+    if (opts.csv_path != NULL && pt_write_csv(opts.csv_path, &results) != 0)
+    {
+        errors++;
+    }
+    if (opts.json_path != NULL && pt_write_json(opts.json_path, &opts, &results) != 0)
+    {
+        errors++;
+    }
+
+    free(results.items);
+    return (errors == 0) ? 0 : 1;
+}
@@ -950,6 +950,71 @@ UTEST(AOS_PROCESS, AEAD_GCM_BITMASK_1)
     free(ptr_processed_frame);
 }
 
+UTEST(AOS_PROCESS, VERIFY_ONLY_AEAD_GCM)
+{
+    remove("sa_save_file.bin");
+    // Local Variables
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    SecurityAssociation_t *sa_ptr = NULL;
+
+    // Configure Parameters, the test frame carries an all zero IV so anti-replay is off here
+    Crypto_Config_CryptoLib(KEY_TYPE_INTERNAL, MC_TYPE_INTERNAL, SA_TYPE_INMEMORY, CRYPTOGRAPHY_TYPE_LIBGCRYPT, 
+                            IV_INTERNAL, CRYPTO_AOS_CREATE_FECF_TRUE, TC_PROCESS_SDLS_PDUS_TRUE, TC_HAS_PUS_HDR,
+                            TC_IGNORE_SA_STATE_FALSE, TC_IGNORE_ANTI_REPLAY_TRUE, TC_UNIQUE_SA_PER_MAP_ID_FALSE,
+                            AOS_CHECK_FECF_TRUE, 0x3F, SA_INCREMENT_NONTRANSMITTED_IV_TRUE);
+    GvcidManagedParameters_t AOS_UT_Managed_Parameters = {1, 0x002c, 0, AOS_HAS_FECF, AOS_FHEC_NA, AOS_IZ_NA, 0, AOS_SEGMENT_HDRS_NA, 1786, AOS_NO_OCF, 1};  
+    Crypto_Config_Add_Gvcid_Managed_Parameters(AOS_UT_Managed_Parameters);
+    status = Crypto_Init();
+
+    // Test frame setup, same as AEAD_GCM_BITMASK_1
+    // Note: SPI 17 (0x0011)
+    // Setup:             | hdr 6    |SPI| IV                             | data | MAC | FECF
+    char* framed_aos_h = "42C000000000000B0000000000000000000000000000000010df143c92a39b3568cc9916c9d06c715bf8017168f88ef107a8016a03207f7d12fe4ccd79ab24043982fe6a8b9675c3b819e2d7dfad32bd85381fb54544d76668a6ab58b988158702e91afe55cd71f1ba50d72bbd1ccc41529101ee1a39c46ecd8a7feb503444606611239d31102dc6371b0e2152dd301e3268d0a45e1bcb58779642e883b6a26546094ba39fb0ce11b39c49092c9b366059e773e4789052311a465f39ba677458510c09826f1ea580fa5c9d5b9677ede38e46fc33fe8d303f9529c15c2bed4c879c5bfdacd86210a431e0f3852b3798369ae1230b4ed5ae66e153757508ead77e85ddac804e8a409cca8b9d3cef0dd1d0298bcdbda1dda336d66ee6b59f2f10ffa6d4bf99885b9082b83cd20c9a44a002c460530a9741e26e78b6e8f9349df8e618b904ed01306ee9ed3a389374efe43e5ed2bcd528943057762f9dc1d392fe2dd2fc6d9cab9e347a25839c07ba47113bad0633b6b5f09228be87631cc1538c2f6e79e9df0f18d658bd8b3ac45b396cfeadd1700ca2ec95cdbe38e5ec013c74cd68d0035bb975c392f5116b661a928bf113c3cacc801a84cbd3f8d3dc2273e0c5270d656648a48db16f860e4a36ee7e8979da4135e40e6952041a0d16b6f51cf67519b80a472b4cf5614d5a0b18dd755b7c8d63936e43de25a3cdf0d03179aebd5cc85fa1cc0c03fbdd240dd878d647619cbf367a7e486e572c5636c7a7d9b517c565a547597d311b69110985b5f7c5d47904a6f6699e93c02ea7559d4ba94d139824e9ef0840ad3e31afdaaa71f7baba8835d568443b0dab10a4f40043160fde9961038bcb823ab570bac0e609e17311a6b0edab4fce98f8df059194393f5109e766f6bf7e21c9a4441acff0cfd28658d48304331cb0c982da833c94cf6a7aadc8e2a696b69df49efcd7efadfd2e95bd3a9ab605c221e08b5f61f3aff2496b7c89f98a76aa305116220c50142cfa4490916f7a6b8732839280d39a402d87ff7e7b1f71b6a243c316307e82b16071ad18e99a548bacc4ed648df49c6eafca0db764b98c75a9e953161cb6d384421b473f95d6801d5413dbde4373abab3269c0fade85ab66a9beea1d32462796dac0024f44ade919286b5e92488e52b51ada1deb0730c9b2e66b9b3c75dab5194cf452cb626ea4d9425b28e6d97a9d93d5c61d1fd02eea18d2b42058de6453abac1165740be3c352d7291f8df7abd0c24e90bc8fbdadc32c31942e82f09f74f3ff75e20e597d87d136998b94d99370a8d6c3eedf44503ccc2d7d560a3c068f8914fb67a976cb15d3be212bc549b26613113a509079ad19e5abd26467e26571c98f17e248e31ad5b0f489a05b71e38725574e9a076bf55d546f970cbc1892801b6a4b4bc7e3b82723cf251dcf3bfee0cb3b8c54a51a99d5272e8165a6cf8b2b05a549d091090c8b7a623541f2b29542eecc1234bc172038f8fcb0fe14413601f2d255708e4a30a789ec92a3f7bb286c80899886d2f59edfe5e120039b2e0e6fce7fa81dd15b14c61afc0c334015cf975b42cb53bc33dc511c6aac87f1e38f48287c4ede88b8a22ab013200d4d894709bc0668ac5ff06add5c28ef3764e3a6f51ba519256574734b0ad395d80ee886018ce0a1b935b1af4747b47011eb030c2ca2ab77cf33019cfca4bbbde219d32666ce9a2db7a9e1f0f3fdff22a0b2cf6d245f0c5de470a40025a9f2e743c1fd626a01eb34293544c3dee8b72892c8a2d4fbe0cb2dec2bda572ba4a1246b811331d80e5078b310eb9090a89216b390df62671425f89e73ca736e49848368be1eca4cc5c3036df2dcee5ca648d199f64b9bb792a2b7eb7ddc5ae43f35bcd9b9a7f4b9b8d493f958666af4dff6a2dec6a4ca908cd67f98d8845a631b3ecff4c5e527a0654ae737885885425f6780da2e53f4e612ee8caf42e4d25cec899e7788e1652f0aa1536c488df58f750b7b63a1573d4df0e3eda5c8359daae006269cc4f79aab4360ce37b2227bc17a7feb2bd62108404b9d4ec6ca9d4a2c903a34d03db5d68004d5235789e61a22ec75f98680b0829cbf905668c9631a5157d39d73d1ab7e558ae6ced855939ea79b80f7256dc29fbf01bacbd718e96916218e41c3fb221f5b9ac58eb3bb694edfc60a9a518f392ba97d542034d17cba204ea92572677c3b6af86383f013fb537ba8441d1b8f645289d8c1347377f3698a830aa82ebe9123808eb105ef216502cee4cd7ef05a14f1e87b5a66eb937a5f7dfd704fb6ad693c90c941a3e4853a148ada9269de95852b412d4d9fc8920120835156c0c6ed168027115535edbf4ff5b72a3f556234c68245c604188572d3a372a898bd6a439bd4a8d6402b28260e81ece7bbf0cdf5a2a2983403289cb060f81d3aedf8b4a82dcdadfed35a86a8b6df4d57801f7718a15660f9b03e0c0450a717e14e92e278d65cc11b7e07277b6992050f69a101af8A2A043A6420DEC5FF4F7B14B80E26374173";
+    char* framed_aos_b = NULL;
+    int framed_aos_len = 0;
+    hex_conversion(framed_aos_h, &framed_aos_b, &framed_aos_len);
+
+    SaInterface sa_if = get_sa_interface_inmemory();
+    sa_if->sa_get_from_spi(10, &sa_ptr); //Disable SPI 10
+    sa_ptr->sa_state = SA_KEYED;
+    sa_if->sa_get_from_spi(11, &sa_ptr);  // Enable and setup 11
+    sa_ptr->sa_state = SA_OPERATIONAL;
+    sa_ptr->akid = 0;
+    sa_ptr->ekid = 130;
+    sa_ptr->est = 1;
+    sa_ptr->ast = 1;
+    sa_ptr->acs_len = 0;
+    sa_ptr->ecs_len = 1;
+    sa_ptr->ecs = CRYPTO_CIPHER_AES256_GCM;
+    sa_ptr->stmacf_len = 16;
+    sa_ptr->abm_len = ABM_SIZE;
+    sa_ptr->gvcid_blk.scid = 44;
+    sa_ptr->iv_len = 16;
+    sa_ptr->shivf_len = 16;
+    sa_ptr->shsnf_len = 0;
+    sa_ptr->shplf_len = 0;
+    memset(sa_ptr->abm, 0xFF, (sa_ptr->abm_len * sizeof(uint8_t))); // Bitmask of ones
+
+    // Authentic frame is accepted and left untouched
+    char* copy = malloc(framed_aos_len);
+    memcpy(copy, framed_aos_b, framed_aos_len);
+    status = Crypto_AOS_VerifySecurity((uint8_t* )framed_aos_b, framed_aos_len);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+    ASSERT_EQ(0, memcmp(copy, framed_aos_b, framed_aos_len));
+
+    // Flipped ciphertext bit with a fixed up FECF fails the tag check
+    copy[100] ^= 0x01;
+    uint16_t fecf = Crypto_Calc_FECF((uint8_t* )copy, framed_aos_len - 2);
+    copy[framed_aos_len - 2] = (uint8_t)(fecf >> 8);
+    copy[framed_aos_len - 1] = (uint8_t)(fecf & 0x00FF);
+    status = Crypto_AOS_VerifySecurity((uint8_t* )copy, framed_aos_len);
+    ASSERT_EQ(CRYPTO_LIB_ERR_MAC_VALIDATION_ERROR, status);
+
+    Crypto_Shutdown();
+    free(copy);
+    free(framed_aos_b);
+}
+
 UTEST(AOS_PROCESS, AOS_SA_SEGFAULT_TEST)
 {
     // Local Variables
@@ -982,4 +1047,52 @@ UTEST(AOS_PROCESS, AOS_SA_SEGFAULT_TEST)
     free(ptr_processed_frame);
 }
 
+UTEST(AOS_PROCESS, IDLE_VC_POLICY)
+{
+    // Local Variables
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    uint8_t* ptr_processed_frame = NULL;
+    uint16_t processed_aos_len;
+
+    // Configure Parameters, every frame on the virtual channel is idle fill
+    Crypto_Config_CryptoLib(KEY_TYPE_INTERNAL, MC_TYPE_INTERNAL, SA_TYPE_INMEMORY, CRYPTOGRAPHY_TYPE_LIBGCRYPT, 
+                            IV_INTERNAL, CRYPTO_AOS_CREATE_FECF_TRUE, TC_PROCESS_SDLS_PDUS_TRUE, TC_HAS_PUS_HDR,
+                            TC_IGNORE_SA_STATE_FALSE, TC_IGNORE_ANTI_REPLAY_FALSE, TC_UNIQUE_SA_PER_MAP_ID_FALSE,
+                            AOS_CHECK_FECF_TRUE, 0x3F, SA_INCREMENT_NONTRANSMITTED_IV_TRUE);
+    GvcidManagedParameters_t AOS_UT_Managed_Parameters = {1, 0x002c, 0, AOS_HAS_FECF, AOS_NO_FHEC, AOS_HAS_IZ, 10, AOS_SEGMENT_HDRS_NA, 1786, AOS_NO_OCF, 1};
+    Crypto_Config_Add_Gvcid_Managed_Parameters(AOS_UT_Managed_Parameters);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_Config_Gvcid_Idle_Frames(1, 0x002c, 0, IDLE_VC_TRUE, IDLE_FRAMES_SKIP));
+    ASSERT_EQ(MANAGED_PARAMETERS_FOR_GVCID_NOT_FOUND, Crypto_Config_Gvcid_Idle_Frames(1, 0x002c, 1, IDLE_VC_TRUE, IDLE_FRAMES_SKIP));
+    status = Crypto_Init();
+
+    // Test frame setup, the SPI is out of range
+    char* framed_aos_h = "42C00000000000000000000000000000FFFF";
+    char* framed_aos_b = NULL;
+    int framed_aos_len = 0;
+    hex_conversion(framed_aos_h, &framed_aos_b, &framed_aos_len);
+
+    // Skipped ahead of the SA lookup
+    status = Crypto_AOS_ProcessSecurity((uint8_t* )framed_aos_b, framed_aos_len, &ptr_processed_frame, &processed_aos_len);
+    ASSERT_EQ(CRYPTO_LIB_ERR_IDLE_FRAME, status);
+    ASSERT_TRUE(ptr_processed_frame == NULL);
+    status = Crypto_AOS_VerifySecurity((uint8_t* )framed_aos_b, framed_aos_len);
+    ASSERT_EQ(CRYPTO_LIB_ERR_IDLE_FRAME, status);
+    Crypto_Shutdown();
+
+    // Verified idle frames still need a usable SA
+    Crypto_Config_CryptoLib(KEY_TYPE_INTERNAL, MC_TYPE_INTERNAL, SA_TYPE_INMEMORY, CRYPTOGRAPHY_TYPE_LIBGCRYPT, 
+                            IV_INTERNAL, CRYPTO_AOS_CREATE_FECF_TRUE, TC_PROCESS_SDLS_PDUS_TRUE, TC_HAS_PUS_HDR,
+                            TC_IGNORE_SA_STATE_FALSE, TC_IGNORE_ANTI_REPLAY_FALSE, TC_UNIQUE_SA_PER_MAP_ID_FALSE,
+                            AOS_CHECK_FECF_TRUE, 0x3F, SA_INCREMENT_NONTRANSMITTED_IV_TRUE);
+    Crypto_Config_Add_Gvcid_Managed_Parameters(AOS_UT_Managed_Parameters);
+    Crypto_Config_Gvcid_Idle_Frames(1, 0x002c, 0, IDLE_VC_TRUE, IDLE_FRAMES_VERIFY);
+    status = Crypto_Init();
+    status = Crypto_AOS_ProcessSecurity((uint8_t* )framed_aos_b, framed_aos_len, &ptr_processed_frame, &processed_aos_len);
+    ASSERT_EQ(CRYPTO_LIB_ERR_SPI_INDEX_OOB, status);
+
+    Crypto_Shutdown();
+    free(framed_aos_b);
+    free(ptr_processed_frame);
+}
+
 UTEST_MAIN();
\ No newline at end of file
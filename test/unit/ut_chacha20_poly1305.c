@@ -0,0 +1,211 @@
+/* Copyright (C) 2009 - 2022 National Aeronautics and Space Administration.
+   All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any kind, either expressed, implied, or statutory,
+   including, but not limited to, any warranty that the software will conform to specifications, any implied warranties
+   of merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+   documentation will conform to the program, or any warranty that the software will be error free.
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+   consequential damages, arising out of, resulting from, or in any way connected with the software or its
+   documentation, whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained
+   from, or arose out of the results of, or use of, the software, documentation or services provided hereunder.
+
+   ITC Team
+   NASA IV&V
+   jstar-development-team@mail.nasa.gov
+*/
+
+#include "ut_chacha20_poly1305.h"
+#include "crypto.h"
+#include "crypto_error.h"
+#include "sa_interface.h"
+#include "utest.h"
+
+// RFC 8439 2.8.2 AEAD_CHACHA20_POLY1305 example
+static char* rfc_key_h = "808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f";
+static char* rfc_nonce_h = "070000004041424344454647";
+static char* rfc_aad_h = "50515253c0c1c2c3c4c5c6c7";
+static char* rfc_pt_h = "4c616469657320616e642047656e746c656d656e206f662074686520636c617373206f66202739393a204966204920636f756c64206f6666657220796f75206f6e6c79206f6e652074697020666f7220746865206675747572652c2073756e73637265656e20776f756c642062652069742e";
+static char* rfc_ct_h = "d31a8d34648e60db7b86afbc53ef7ec2a4aded51296e08fea9e2b5a736ee62d63dbea45e8ca9671282fafb69da92728b1a71de0a9e060b2905d6a5b67ecd3b3692ddbd7f2d778b8c9803aee328091b58fab324e4fad675945585808b4831d7bc3ff4def08e4b7a9de576d26586cec64b6116";
+static char* rfc_tag_h = "1ae10b594f09e26a7e902ecbd0600691";
+
+/**
+ * @brief Unit Test: Crypto ECS Get Algorithm key length and AEAD classification for ChaCha20-Poly1305
+ **/
+UTEST(CHACHA20_POLY1305, GET_ECS_ALGO_KEY_LEN)
+{
+    remove("sa_save_file.bin");
+    ASSERT_EQ(32, Crypto_Get_ECS_Algo_Keylen(CRYPTO_CIPHER_CHACHA20_POLY1305));
+    ASSERT_EQ(CRYPTO_TRUE, Crypto_Is_AEAD_Algorithm(CRYPTO_CIPHER_CHACHA20_POLY1305));
+}
+
+/**
+ * @brief Unit Test: Crypto ECS Get Algorithm response for ChaCha20-Poly1305
+ **/
+UTEST(CHACHA20_POLY1305, GET_ECS_ALGO)
+{
+    remove("sa_save_file.bin");
+    Crypto_Init_TC_Unit_Test();
+    int32_t algo = cryptography_if->cryptography_get_ecs_algo(CRYPTO_CIPHER_CHACHA20_POLY1305);
+    ASSERT_GT(algo, 0);
+    Crypto_Shutdown();
+}
+
+/**
+ * @brief Validation Test: RFC 8439 2.8.2 known answer, encrypt then decrypt, full and truncated tags
+ **/
+UTEST(CHACHA20_POLY1305, RFC8439_KAT)
+{
+    remove("sa_save_file.bin");
+    Crypto_Init_TC_Unit_Test();
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    uint8_t ecs = CRYPTO_CIPHER_CHACHA20_POLY1305;
+
+    uint8_t* key_b = NULL;
+    uint8_t* nonce_b = NULL;
+    uint8_t* aad_b = NULL;
+    uint8_t* pt_b = NULL;
+    uint8_t* ct_b = NULL;
+    uint8_t* tag_b = NULL;
+    int key_len = 0;
+    int nonce_len = 0;
+    int aad_len = 0;
+    int pt_len = 0;
+    int ct_len = 0;
+    int tag_len = 0;
+    hex_conversion(rfc_key_h, (char**)&key_b, &key_len);
+    hex_conversion(rfc_nonce_h, (char**)&nonce_b, &nonce_len);
+    hex_conversion(rfc_aad_h, (char**)&aad_b, &aad_len);
+    hex_conversion(rfc_pt_h, (char**)&pt_b, &pt_len);
+    hex_conversion(rfc_ct_h, (char**)&ct_b, &ct_len);
+    hex_conversion(rfc_tag_h, (char**)&tag_b, &tag_len);
+
+    uint8_t enc_out[128];
+    uint8_t dec_out[128];
+    uint8_t mac[16];
+
+    status = cryptography_if->cryptography_aead_encrypt(enc_out, pt_len, pt_b, pt_len, key_b, key_len, NULL, nonce_b,
+                                                        nonce_len, mac, tag_len, aad_b, aad_len, CRYPTO_TRUE,
+                                                        CRYPTO_TRUE, CRYPTO_TRUE, &ecs, NULL, NULL);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+    ASSERT_EQ(0, memcmp(enc_out, ct_b, ct_len));
+    ASSERT_EQ(0, memcmp(mac, tag_b, tag_len));
+
+    status = cryptography_if->cryptography_aead_decrypt(dec_out, ct_len, ct_b, ct_len, key_b, key_len, NULL, nonce_b,
+                                                        nonce_len, tag_b, tag_len, aad_b, aad_len, CRYPTO_TRUE,
+                                                        CRYPTO_TRUE, CRYPTO_TRUE, &ecs, NULL, NULL);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+    ASSERT_EQ(0, memcmp(dec_out, pt_b, pt_len));
+
+    // SDLS MACs are commonly truncated, the truncated tag is a prefix of the full one
+    memset(mac, 0, sizeof(mac));
+    status = cryptography_if->cryptography_aead_encrypt(enc_out, pt_len, pt_b, pt_len, key_b, key_len, NULL, nonce_b,
+                                                        nonce_len, mac, 8, aad_b, aad_len, CRYPTO_TRUE,
+                                                        CRYPTO_TRUE, CRYPTO_TRUE, &ecs, NULL, NULL);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+    ASSERT_EQ(0, memcmp(mac, tag_b, 8));
+    status = cryptography_if->cryptography_aead_decrypt(dec_out, ct_len, ct_b, ct_len, key_b, key_len, NULL, nonce_b,
+                                                        nonce_len, tag_b, 8, aad_b, aad_len, CRYPTO_TRUE,
+                                                        CRYPTO_TRUE, CRYPTO_TRUE, &ecs, NULL, NULL);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+
+    // Tampered tag and tampered AAD both fail
+    tag_b[0] ^= 0x01;
+    status = cryptography_if->cryptography_aead_decrypt(dec_out, ct_len, ct_b, ct_len, key_b, key_len, NULL, nonce_b,
+                                                        nonce_len, tag_b, tag_len, aad_b, aad_len, CRYPTO_TRUE,
+                                                        CRYPTO_TRUE, CRYPTO_TRUE, &ecs, NULL, NULL);
+    ASSERT_EQ(CRYPTO_LIB_ERR_MAC_VALIDATION_ERROR, status);
+    tag_b[0] ^= 0x01;
+    aad_b[0] ^= 0x01;
+    status = cryptography_if->cryptography_aead_decrypt(dec_out, ct_len, ct_b, ct_len, key_b, key_len, NULL, nonce_b,
+                                                        nonce_len, tag_b, 8, aad_b, aad_len, CRYPTO_TRUE,
+                                                        CRYPTO_TRUE, CRYPTO_TRUE, &ecs, NULL, NULL);
+    ASSERT_EQ(CRYPTO_LIB_ERR_MAC_VALIDATION_ERROR, status);
+
+    Crypto_Shutdown();
+    free(key_b);
+    free(nonce_b);
+    free(aad_b);
+    free(pt_b);
+    free(ct_b);
+    free(tag_b);
+}
+
+/**
+ * @brief Unit Test: TC ApplySecurity then ProcessSecurity on a ChaCha20-Poly1305 SA
+ **/
+UTEST(CHACHA20_POLY1305, TC_APPLY_PROCESS_ROUND_TRIP)
+{
+    remove("sa_save_file.bin");
+    uint8_t* ptr_enc_frame = NULL;
+    uint16_t enc_frame_len = 0;
+    Crypto_Config_CryptoLib(KEY_TYPE_INTERNAL, MC_TYPE_INTERNAL, SA_TYPE_INMEMORY, CRYPTOGRAPHY_TYPE_LIBGCRYPT,
+                            IV_INTERNAL, CRYPTO_TC_CREATE_FECF_TRUE, TC_PROCESS_SDLS_PDUS_TRUE, TC_HAS_PUS_HDR,
+                            TC_IGNORE_SA_STATE_FALSE, TC_IGNORE_ANTI_REPLAY_FALSE, TC_UNIQUE_SA_PER_MAP_ID_FALSE,
+                            TC_CHECK_FECF_TRUE, 0x3F, SA_INCREMENT_NONTRANSMITTED_IV_TRUE);
+    GvcidManagedParameters_t TC_0_Managed_Parameters = {0, 0x0003, 0, TC_NO_FECF, AOS_FHEC_NA, AOS_IZ_NA, 0, TC_NO_SEGMENT_HDRS, 1024, TC_OCF_NA, 1};
+    Crypto_Config_Add_Gvcid_Managed_Parameters(TC_0_Managed_Parameters);
+    GvcidManagedParameters_t TC_1_Managed_Parameters = {0, 0x0003, 1, TC_NO_FECF, AOS_FHEC_NA, AOS_IZ_NA, 0, TC_NO_SEGMENT_HDRS, 1024, TC_OCF_NA, 1};
+    Crypto_Config_Add_Gvcid_Managed_Parameters(TC_1_Managed_Parameters);
+    Crypto_Init();
+    SaInterface sa_if = get_sa_interface_inmemory();
+    crypto_key_t* ekp = NULL;
+
+    char* raw_tc_h = "200300180001000102030405060708090a0b0c0d0e0f101112";
+    uint8_t* raw_tc_b = NULL;
+    int raw_tc_len = 0;
+    uint8_t* key_b = NULL;
+    uint8_t* nonce_b = NULL;
+    int key_len = 0;
+    int nonce_len = 0;
+    hex_conversion(raw_tc_h, (char**)&raw_tc_b, &raw_tc_len);
+    hex_conversion(rfc_key_h, (char**)&key_b, &key_len);
+    hex_conversion(rfc_nonce_h, (char**)&nonce_b, &nonce_len);
+
+    SecurityAssociation_t* test_association = NULL;
+    sa_if->sa_get_from_spi(1, &test_association);
+    test_association->sa_state = SA_NONE;
+    sa_if->sa_get_from_spi(9, &test_association);
+    test_association->arsn_len = 0;
+    test_association->shsnf_len = 0;
+    test_association->sa_state = SA_OPERATIONAL;
+    test_association->ast = 1;
+    test_association->est = 1;
+    test_association->ecs_len = 1;
+    test_association->ecs = CRYPTO_CIPHER_CHACHA20_POLY1305;
+    test_association->stmacf_len = 16;
+    test_association->gvcid_blk.tfvn = 0;
+    test_association->abm_len = 1024;
+    memcpy(test_association->iv, nonce_b, nonce_len);
+    ekp = key_if->get_key(test_association->ekid);
+    memcpy(ekp->value, key_b, key_len);
+
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_TC_ApplySecurity(raw_tc_b, raw_tc_len, &ptr_enc_frame, &enc_frame_len));
+    ASSERT_GT(enc_frame_len, raw_tc_len);
+
+    // Receiving side holds the nonce preceding the one the frame was sent with
+    memcpy(test_association->iv, nonce_b, nonce_len);
+    test_association->iv[nonce_len - 1] -= 1;
+    TC_t* tc_processed_frame = malloc(sizeof(uint8_t) * TC_SIZE);
+    int processed_len = enc_frame_len;
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_TC_ProcessSecurity(ptr_enc_frame, &processed_len, tc_processed_frame));
+    ASSERT_EQ(raw_tc_len - 5, tc_processed_frame->tc_pdu_len);
+    ASSERT_EQ(0, memcmp(tc_processed_frame->tc_pdu, raw_tc_b + 5, tc_processed_frame->tc_pdu_len));
+
+    // A flipped ciphertext bit is rejected
+    memcpy(test_association->iv, nonce_b, nonce_len);
+    test_association->iv[nonce_len - 1] -= 1;
+    ptr_enc_frame[enc_frame_len - 20] ^= 0x01;
+    processed_len = enc_frame_len;
+    ASSERT_EQ(CRYPTO_LIB_ERR_MAC_VALIDATION_ERROR, Crypto_TC_ProcessSecurity(ptr_enc_frame, &processed_len, tc_processed_frame));
+
+    Crypto_Shutdown();
+    free(tc_processed_frame);
+    free(ptr_enc_frame);
+    free(raw_tc_b);
+    free(key_b);
+    free(nonce_b);
+}
+
+UTEST_MAIN();
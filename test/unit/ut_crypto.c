@@ -25,6 +25,10 @@
 #include "sa_interface.h"
 #include "utest.h"
 
+#include <pthread.h>
+
+#include <unistd.h>
+
 /**
  * @brief Unit Test: Crypto Calc/Verify CRC16
  **/
@@ -351,4 +355,364 @@ UTEST(CRYPTO_C, GET_ECS_ALGO_KEY_LEN)
     ASSERT_EQ(algo_keylen, 32);
 }
 
-UTEST_MAIN();
\ No newline at end of file
+/**
+ * @brief Unit Test: Managed parameters table grows past its initial size and resolves every GVCID by pointer
+ **/
+UTEST(CRYPTO_C, MANAGED_PARAMETERS_LOOKUP)
+{
+    int32_t status = CRYPTO_LIB_ERROR;
+    const GvcidManagedParameters_t* found = NULL;
+    GvcidManagedParameters_t copy = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+    GvcidManagedParameters_t mp = {0, 0x0003, 0, TC_HAS_FECF, AOS_FHEC_NA, AOS_IZ_NA, 0, TC_HAS_SEGMENT_HDRS, 1024, TC_OCF_NA, 1};
+    int count = GVCID_MAN_PARAM_INITIAL_SIZE * 4;
+
+    Crypto_Shutdown();
+    for (int i = 0; i < count; i++)
+    {
+        mp.vcid = i % 64;
+        mp.scid = 0x0003 + (i / 64);
+        mp.max_frame_size = 100 + i;
+        status = Crypto_Config_Add_Gvcid_Managed_Parameters(mp);
+        ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+    }
+
+    // Duplicate GVCID keeps the first match
+    mp.vcid = 5;
+    mp.scid = 0x0003;
+    mp.max_frame_size = 9999;
+    status = Crypto_Config_Add_Gvcid_Managed_Parameters(mp);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+
+    for (int i = 0; i < count; i++)
+    {
+        status = Crypto_Get_Managed_Parameters_Ptr_For_Gvcid(0, 0x0003 + (i / 64), i % 64, &found);
+        ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+        ASSERT_EQ(&gvcid_managed_parameters_array[i], found);
+        ASSERT_EQ(100 + i, found->max_frame_size);
+    }
+
+    status = Crypto_Get_Managed_Parameters_For_Gvcid(0, 0x0003, 5, gvcid_managed_parameters_array, &copy);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+    ASSERT_EQ(105, copy.max_frame_size);
+
+    status = Crypto_Get_Managed_Parameters_Ptr_For_Gvcid(1, 0x0003, 0, &found);
+    ASSERT_EQ(MANAGED_PARAMETERS_FOR_GVCID_NOT_FOUND, status);
+    status = Crypto_Get_Managed_Parameters_Ptr_For_Gvcid(0, 0x0400, 0, &found);
+    ASSERT_EQ(MANAGED_PARAMETERS_FOR_GVCID_NOT_FOUND, status);
+}
+
+/**
+ * @brief Unit Test: AEAD encrypt over a run of counter IVs
+ * Consecutive IVs are what a keystream prefetching module precomputes, every frame must still round trip
+ **/
+UTEST(CRYPTO_C, AEAD_COUNTER_IV_SEQUENCE)
+{
+    remove("sa_save_file.bin");
+    Crypto_Init_TM_Unit_Test();
+    int32_t status = CRYPTO_LIB_SUCCESS;
+
+    char* key_h = "feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308";
+    char* iv_h = "cafebabefacedbaddecaf888";
+    char* aad_h = "feedfacedeadbeeffeedfacedeadbeefabaddad2";
+    char* pt_h = "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a721c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39";
+    char* ct_h = "522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662";
+    char* tag_h = "76fc6ece0f4e1768cddf8853bb2d551b";
+    uint8_t* key_b = NULL;
+    uint8_t* iv_b = NULL;
+    uint8_t* aad_b = NULL;
+    uint8_t* pt_b = NULL;
+    uint8_t* ct_b = NULL;
+    uint8_t* tag_b = NULL;
+    int key_len = 0;
+    int iv_len = 0;
+    int aad_len = 0;
+    int pt_len = 0;
+    int ct_len = 0;
+    int tag_len = 0;
+    hex_conversion(key_h, (char**)&key_b, &key_len);
+    hex_conversion(iv_h, (char**)&iv_b, &iv_len);
+    hex_conversion(aad_h, (char**)&aad_b, &aad_len);
+    hex_conversion(pt_h, (char**)&pt_b, &pt_len);
+    hex_conversion(ct_h, (char**)&ct_b, &ct_len);
+    hex_conversion(tag_h, (char**)&tag_b, &tag_len);
+
+    SecurityAssociation_t sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.spi = 7;
+    sa.iv_len = iv_len;
+    memcpy(sa.iv, iv_b, iv_len);
+    uint8_t ecs = CRYPTO_CIPHER_AES256_GCM;
+
+    uint8_t enc_out[24][64];
+    uint8_t dec_out[64];
+    uint8_t macs[24][16];
+    uint8_t ivs[24][12];
+    for (int f = 0; f < 24; f++)
+    {
+        // Payload length changes part way, and a flush mid run stands in for a rekey
+        int len = (f < 16) ? pt_len : pt_len - 4;
+        if (f == 12)
+        {
+            ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_Flush_SA(sa.spi));
+        }
+        memcpy(ivs[f], sa.iv, iv_len);
+        status = cryptography_if->cryptography_aead_encrypt(enc_out[f], len, pt_b, len, key_b, key_len, &sa, sa.iv,
+                                                            iv_len, macs[f], tag_len, aad_b, aad_len, CRYPTO_TRUE,
+                                                            CRYPTO_TRUE, CRYPTO_TRUE, &ecs, NULL, NULL);
+        ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+        Crypto_increment(sa.iv, iv_len);
+        usleep(1000);
+    }
+    ASSERT_EQ(0, memcmp(enc_out[0], ct_b, ct_len));
+    ASSERT_EQ(0, memcmp(macs[0], tag_b, tag_len));
+
+    sa.spi = 8;
+    for (int f = 0; f < 24; f++)
+    {
+        int len = (f < 16) ? pt_len : pt_len - 4;
+        status = cryptography_if->cryptography_aead_decrypt(dec_out, len, enc_out[f], len, key_b, key_len, &sa, ivs[f],
+                                                            iv_len, macs[f], tag_len, aad_b, aad_len, CRYPTO_TRUE,
+                                                            CRYPTO_TRUE, CRYPTO_TRUE, &ecs, NULL, NULL);
+        ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+        ASSERT_EQ(0, memcmp(dec_out, pt_b, len));
+    }
+
+    Crypto_Shutdown();
+    free(key_b);
+    free(iv_b);
+    free(aad_b);
+    free(pt_b);
+    free(ct_b);
+    free(tag_b);
+}
+
+/**
+ * @brief Unit Test: AEAD tag check over ciphertext without decrypting
+ * Tags from the encrypt path over a spread of AAD and payload lengths must verify, tampering must not
+ **/
+UTEST(CRYPTO_C, AEAD_VERIFY_WITHOUT_DECRYPT)
+{
+    remove("sa_save_file.bin");
+    Crypto_Init_TM_Unit_Test();
+    int32_t status = CRYPTO_LIB_SUCCESS;
+
+    char* key_h = "feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308";
+    char* iv_h = "cafebabefacedbaddecaf888";
+    char* aad_h = "feedfacedeadbeeffeedfacedeadbeefabaddad2";
+    char* ct_h = "522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662";
+    char* tag_h = "76fc6ece0f4e1768cddf8853bb2d551b";
+    uint8_t* key_b = NULL;
+    uint8_t* iv_b = NULL;
+    uint8_t* aad_b = NULL;
+    uint8_t* ct_b = NULL;
+    uint8_t* tag_b = NULL;
+    int key_len = 0;
+    int iv_len = 0;
+    int aad_len = 0;
+    int ct_len = 0;
+    int tag_len = 0;
+    hex_conversion(key_h, (char**)&key_b, &key_len);
+    hex_conversion(iv_h, (char**)&iv_b, &iv_len);
+    hex_conversion(aad_h, (char**)&aad_b, &aad_len);
+    hex_conversion(ct_h, (char**)&ct_b, &ct_len);
+    hex_conversion(tag_h, (char**)&tag_b, &tag_len);
+
+    SecurityAssociation_t sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.spi = 9;
+    uint8_t ecs = CRYPTO_CIPHER_AES256_GCM;
+
+    // Optional member, modules without it leave Crypto_Frame_Verify_Auth on the decrypt path
+    if (cryptography_if->cryptography_aead_verify == NULL)
+    {
+        Crypto_Shutdown();
+        free(key_b);
+        free(iv_b);
+        free(aad_b);
+        free(ct_b);
+        free(tag_b);
+        return;
+    }
+
+    // GCM spec test case 16, 20 byte AAD exercises the padding between AAD and ciphertext
+    status = cryptography_if->cryptography_aead_verify(ct_b, ct_len, key_b, key_len, &sa, iv_b, iv_len, tag_b, tag_len,
+                                                       aad_b, aad_len, &ecs);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+    status = cryptography_if->cryptography_aead_verify(ct_b, ct_len, key_b, key_len, &sa, iv_b, iv_len, tag_b, 8,
+                                                       aad_b, aad_len, &ecs);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+
+    uint8_t pt[64];
+    uint8_t enc_out[64];
+    uint8_t mac[16];
+    int lens[][2] = {{0, 60}, {16, 60}, {20, 0}, {5, 17}, {32, 64}, {1, 1}};
+    memset(pt, 0xa5, sizeof(pt));
+    for (size_t i = 0; i < sizeof(lens) / sizeof(lens[0]); i++)
+    {
+        int a_len = lens[i][0];
+        int p_len = lens[i][1];
+        status = cryptography_if->cryptography_aead_encrypt(enc_out, p_len, pt, p_len, key_b, key_len, &sa, iv_b,
+                                                            iv_len, mac, 16, aad_b, a_len, CRYPTO_TRUE, CRYPTO_TRUE,
+                                                            CRYPTO_TRUE, &ecs, NULL, NULL);
+        ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+        status = cryptography_if->cryptography_aead_verify(enc_out, p_len, key_b, key_len, &sa, iv_b, iv_len, mac, 16,
+                                                           aad_b, a_len, &ecs);
+        ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+        if (p_len > 0)
+        {
+            enc_out[p_len - 1] ^= 0x80;
+            status = cryptography_if->cryptography_aead_verify(enc_out, p_len, key_b, key_len, &sa, iv_b, iv_len, mac,
+                                                               16, aad_b, a_len, &ecs);
+            ASSERT_EQ(CRYPTO_LIB_ERR_MAC_VALIDATION_ERROR, status);
+        }
+    }
+
+    // Tampered tag and AAD fail, the flush drops any cached subkey and the next check derives it again
+    tag_b[15] ^= 0x01;
+    status = cryptography_if->cryptography_aead_verify(ct_b, ct_len, key_b, key_len, &sa, iv_b, iv_len, tag_b, tag_len,
+                                                       aad_b, aad_len, &ecs);
+    ASSERT_EQ(CRYPTO_LIB_ERR_MAC_VALIDATION_ERROR, status);
+    tag_b[15] ^= 0x01;
+    aad_b[19] ^= 0x01;
+    status = cryptography_if->cryptography_aead_verify(ct_b, ct_len, key_b, key_len, &sa, iv_b, iv_len, tag_b, tag_len,
+                                                       aad_b, aad_len, &ecs);
+    ASSERT_EQ(CRYPTO_LIB_ERR_MAC_VALIDATION_ERROR, status);
+    aad_b[19] ^= 0x01;
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_Flush_SA(sa.spi));
+    status = cryptography_if->cryptography_aead_verify(ct_b, ct_len, key_b, key_len, &sa, iv_b, iv_len, tag_b, tag_len,
+                                                       aad_b, aad_len, &ecs);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+
+    // Suites without a cheap tag check are left to the decrypt fallback
+    ecs = CRYPTO_CIPHER_AES256_CBC;
+    status = cryptography_if->cryptography_aead_verify(ct_b, ct_len, key_b, key_len, &sa, iv_b, iv_len, tag_b, tag_len,
+                                                       aad_b, aad_len, &ecs);
+    ASSERT_EQ(CRYPTO_LIB_ERR_UNSUPPORTED_ECS, status);
+
+    Crypto_Shutdown();
+    free(key_b);
+    free(iv_b);
+    free(aad_b);
+    free(ct_b);
+    free(tag_b);
+}
+
+#define UT_CONCURRENT_THREADS 4
+#define UT_CONCURRENT_ROUNDS 200
+#define UT_CONCURRENT_LEN 4096
+
+typedef struct
+{
+    SecurityAssociation_t* sa;
+    uint8_t* key;
+    uint8_t iv[12];
+    uint8_t pt[UT_CONCURRENT_LEN];
+    uint8_t ct[UT_CONCURRENT_LEN];
+    uint8_t tag[16];
+    uint8_t hmac[32];
+    int failures;
+} ut_concurrent_worker_t;
+
+/**
+ * @brief Function: ut_concurrent_worker
+ * Seals, opens and MACs its own buffer on the shared SA and compares with the results computed up front
+ **/
+static void* ut_concurrent_worker(void* arg)
+{
+    ut_concurrent_worker_t* worker = (ut_concurrent_worker_t*)arg;
+    uint8_t ecs = CRYPTO_CIPHER_AES256_GCM;
+    uint8_t acs = CRYPTO_MAC_HMAC_SHA256;
+    uint8_t buf[UT_CONCURRENT_LEN];
+    uint8_t out[UT_CONCURRENT_LEN];
+    uint8_t tag[32];
+    int i;
+
+    for (i = 0; i < UT_CONCURRENT_ROUNDS; i++)
+    {
+        if ((cryptography_if->cryptography_aead_encrypt(buf, UT_CONCURRENT_LEN, worker->pt, UT_CONCURRENT_LEN, worker->key,
+                                                        32, worker->sa, worker->iv, 12, tag, 16, NULL, 0, CRYPTO_TRUE,
+                                                        CRYPTO_TRUE, CRYPTO_FALSE, &ecs, NULL, NULL) != CRYPTO_LIB_SUCCESS) ||
+            (memcmp(buf, worker->ct, UT_CONCURRENT_LEN) != 0) || (memcmp(tag, worker->tag, 16) != 0))
+        {
+            worker->failures++;
+        }
+        if ((cryptography_if->cryptography_aead_decrypt(out, UT_CONCURRENT_LEN, worker->ct, UT_CONCURRENT_LEN, worker->key,
+                                                        32, worker->sa, worker->iv, 12, worker->tag, 16, NULL, 0,
+                                                        CRYPTO_TRUE, CRYPTO_TRUE, CRYPTO_FALSE, &ecs, NULL,
+                                                        NULL) != CRYPTO_LIB_SUCCESS) ||
+            (memcmp(out, worker->pt, UT_CONCURRENT_LEN) != 0))
+        {
+            worker->failures++;
+        }
+        if ((cryptography_if->cryptography_authenticate(out, UT_CONCURRENT_LEN, worker->pt, UT_CONCURRENT_LEN, worker->key,
+                                                        32, worker->sa, NULL, 0, tag, 32, worker->pt,
+                                                        UT_CONCURRENT_LEN, 0, acs, NULL) != CRYPTO_LIB_SUCCESS) ||
+            (memcmp(tag, worker->hmac, 32) != 0))
+        {
+            worker->failures++;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Unit Test: Cryptography module calls on one SA from several threads
+ * Threads share an SA but not a key, so every call may find the SA's cached context keyed for another thread or in
+ * use.  Each result must still match the one computed single threaded.  OpenSSL is picked when it is built.
+ **/
+UTEST(CRYPTO_C, MODULE_CONCURRENT_SAME_SA)
+{
+    remove("sa_save_file.bin");
+    Crypto_Config_CryptoLib(KEY_TYPE_INTERNAL, MC_TYPE_INTERNAL, SA_TYPE_INMEMORY, CRYPTOGRAPHY_TYPE_OPENSSL,
+                            IV_INTERNAL, CRYPTO_TM_CREATE_FECF_TRUE, TC_PROCESS_SDLS_PDUS_TRUE, TC_HAS_PUS_HDR,
+                            TC_IGNORE_SA_STATE_FALSE, TC_IGNORE_ANTI_REPLAY_FALSE, TC_UNIQUE_SA_PER_MAP_ID_FALSE,
+                            TM_CHECK_FECF_TRUE, 0x3F, SA_INCREMENT_NONTRANSMITTED_IV_TRUE);
+    GvcidManagedParameters_t TM_UT_Managed_Parameters = {0, 0x0003, 0, TM_HAS_FECF, AOS_FHEC_NA, AOS_IZ_NA, 0, TM_SEGMENT_HDRS_NA, 1786, TM_NO_OCF, 1};
+    Crypto_Config_Add_Gvcid_Managed_Parameters(TM_UT_Managed_Parameters);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_Init());
+
+    static ut_concurrent_worker_t workers[UT_CONCURRENT_THREADS];
+    pthread_t threads[UT_CONCURRENT_THREADS];
+    uint8_t keys[2][32];
+    uint8_t ecs = CRYPTO_CIPHER_AES256_GCM;
+    uint8_t scratch[UT_CONCURRENT_LEN];
+    SecurityAssociation_t sa;
+    int i;
+
+    memset(&sa, 0, sizeof(sa));
+    sa.spi = 9;
+    memset(keys[0], 0x11, sizeof(keys[0]));
+    memset(keys[1], 0x22, sizeof(keys[1]));
+    for (i = 0; i < UT_CONCURRENT_THREADS; i++)
+    {
+        memset(&workers[i], 0, sizeof(ut_concurrent_worker_t));
+        workers[i].sa = &sa;
+        workers[i].key = keys[i % 2];
+        memset(workers[i].iv, 0x30 + i, sizeof(workers[i].iv));
+        memset(workers[i].pt, 0x40 + i, UT_CONCURRENT_LEN);
+        ASSERT_EQ(CRYPTO_LIB_SUCCESS,
+                  cryptography_if->cryptography_aead_encrypt(workers[i].ct, UT_CONCURRENT_LEN, workers[i].pt,
+                                                             UT_CONCURRENT_LEN, workers[i].key, 32, &sa, workers[i].iv, 12,
+                                                             workers[i].tag, 16, NULL, 0, CRYPTO_TRUE, CRYPTO_TRUE,
+                                                             CRYPTO_FALSE, &ecs, NULL, NULL));
+        ASSERT_EQ(CRYPTO_LIB_SUCCESS,
+                  cryptography_if->cryptography_authenticate(scratch, UT_CONCURRENT_LEN, workers[i].pt, UT_CONCURRENT_LEN,
+                                                             workers[i].key, 32, &sa, NULL, 0, workers[i].hmac,
+                                                             32, workers[i].pt, UT_CONCURRENT_LEN, 0,
+                                                             CRYPTO_MAC_HMAC_SHA256, NULL));
+    }
+
+    for (i = 0; i < UT_CONCURRENT_THREADS; i++)
+    {
+        ASSERT_EQ(0, pthread_create(&threads[i], NULL, ut_concurrent_worker, &workers[i]));
+    }
+    for (i = 0; i < UT_CONCURRENT_THREADS; i++)
+    {
+        ASSERT_EQ(0, pthread_join(threads[i], NULL));
+        ASSERT_EQ(0, workers[i].failures);
+    }
+
+    Crypto_Shutdown();
+}
+
+UTEST_MAIN();
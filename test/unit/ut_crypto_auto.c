@@ -0,0 +1,179 @@
+/* Copyright (C) 2009 - 2022 National Aeronautics and Space Administration.
+   All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any kind, either expressed, implied, or statutory,
+   including, but not limited to, any warranty that the software will conform to specifications, any implied warranties
+   of merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+   documentation will conform to the program, or any warranty that the software will be error free.
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+   consequential damages, arising out of, resulting from, or in any way connected with the software or its
+   documentation, whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained
+   from, or arose out of the results of, or use of, the software, documentation or services provided hereunder.
+
+   ITC Team
+   NASA IV&V
+   jstar-development-team@mail.nasa.gov
+*/
+
+/**
+ *  Unit Tests for CRYPTOGRAPHY_TYPE_AUTO, per cipher suite routing to the fastest compiled in module
+ **/
+#include "ut_crypto_auto.h"
+#include "crypto.h"
+#include "crypto_error.h"
+#include "sa_interface.h"
+#include "utest.h"
+
+static int32_t ut_crypto_auto_init(void)
+{
+    Crypto_Config_CryptoLib(KEY_TYPE_INTERNAL, MC_TYPE_INTERNAL, SA_TYPE_INMEMORY, CRYPTOGRAPHY_TYPE_AUTO,
+                            IV_INTERNAL, CRYPTO_TC_CREATE_FECF_TRUE, TC_PROCESS_SDLS_PDUS_TRUE, TC_HAS_PUS_HDR,
+                            TC_IGNORE_SA_STATE_FALSE, TC_IGNORE_ANTI_REPLAY_TRUE, TC_UNIQUE_SA_PER_MAP_ID_FALSE,
+                            TC_CHECK_FECF_TRUE, 0x3F, SA_INCREMENT_NONTRANSMITTED_IV_TRUE);
+    GvcidManagedParameters_t TC_UT_Managed_Parameters = {0, 0x0003, 0, TC_HAS_FECF, AOS_FHEC_NA, AOS_IZ_NA, 0, TC_HAS_SEGMENT_HDRS, 1024, TC_OCF_NA, 1};
+    Crypto_Config_Add_Gvcid_Managed_Parameters(TC_UT_Managed_Parameters);
+    return Crypto_Init();
+}
+
+/**
+ * @brief Unit Test: Auto selection initializes, routes every measured suite and logs each decision
+ **/
+UTEST(CRYPTO_AUTO, INIT_ROUTES_AND_LOGS)
+{
+    remove("sa_save_file.bin");
+    remove(MC_LOG_PATH);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, ut_crypto_auto_init());
+    ASSERT_TRUE(cryptography_if == get_cryptography_interface_auto());
+
+    ASSERT_GT(cryptography_if->cryptography_get_ecs_algo(CRYPTO_CIPHER_AES256_GCM), 0);
+    ASSERT_GT(cryptography_if->cryptography_get_ecs_algo(CRYPTO_CIPHER_AES256_CBC), 0);
+    ASSERT_GT(cryptography_if->cryptography_get_acs_algo(CRYPTO_MAC_CMAC_AES256), 0);
+    ASSERT_GT(cryptography_if->cryptography_get_acs_algo(CRYPTO_MAC_HMAC_SHA512), 0);
+    Crypto_Shutdown();
+
+    char line[512];
+    int gcm_logged = 0;
+    int hmac_logged = 0;
+    FILE* log = fopen(MC_LOG_PATH, "r");
+    ASSERT_TRUE(log != NULL);
+    while (fgets(line, sizeof(line), log) != NULL)
+    {
+        if (strstr(line, "cryptography auto: AES256_GCM ") != NULL && strstr(line, "-> none") == NULL)
+        {
+            gcm_logged = 1;
+        }
+        if (strstr(line, "cryptography auto: HMAC_SHA256 ") != NULL && strstr(line, "-> none") == NULL)
+        {
+            hmac_logged = 1;
+        }
+    }
+    fclose(log);
+    ASSERT_EQ(1, gcm_logged);
+    ASSERT_EQ(1, hmac_logged);
+}
+
+/**
+ * @brief Unit Test: Frames protected through auto selection match the fixed module output
+ **/
+UTEST(CRYPTO_AUTO, TC_APPLY_ENC_CBC_MATCHES_TRUTH)
+{
+    remove("sa_save_file.bin");
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, ut_crypto_auto_init());
+
+    char* raw_tc_sdls_ping_h = "20030016000080d2c70008197f0b0031000000b1fe3128";
+    char* raw_tc_sdls_ping_b = NULL;
+    int raw_tc_sdls_ping_len = 0;
+    SaInterface sa_if = get_sa_interface_inmemory();
+    hex_conversion(raw_tc_sdls_ping_h, &raw_tc_sdls_ping_b, &raw_tc_sdls_ping_len);
+
+    uint8_t* ptr_enc_frame = NULL;
+    uint16_t enc_frame_len = 0;
+
+    SecurityAssociation_t* test_association;
+    sa_if->sa_get_from_spi(1, &test_association);
+    test_association->sa_state = SA_NONE;
+    sa_if->sa_get_from_spi(4, &test_association);
+    test_association->sa_state = SA_OPERATIONAL;
+    test_association->ekid = 1;
+    test_association->shivf_len = 16;
+    test_association->iv_len = 16;
+    test_association->arsn_len = 0;
+    test_association->ast = 0;
+    test_association->stmacf_len = 0;
+    test_association->shplf_len = 1;
+    test_association->ecs = CRYPTO_CIPHER_AES256_CBC;
+    int32_t return_val =
+        Crypto_TC_ApplySecurity((uint8_t*)raw_tc_sdls_ping_b, raw_tc_sdls_ping_len, &ptr_enc_frame, &enc_frame_len);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, return_val);
+
+    char* truth_data_h = "2003002a000000040000000000000000000000000000000001956b3e423390b3c3756c626f8b30812b6c0e";
+    uint8_t* truth_data_b = NULL;
+    int truth_data_l = 0;
+    hex_conversion(truth_data_h, (char**)&truth_data_b, &truth_data_l);
+    ASSERT_EQ(truth_data_l, enc_frame_len);
+    ASSERT_EQ(0, memcmp(ptr_enc_frame, truth_data_b, enc_frame_len));
+
+    Crypto_Shutdown();
+    free(truth_data_b);
+    free(raw_tc_sdls_ping_b);
+    free(ptr_enc_frame);
+}
+
+/**
+ * @brief Unit Test: GCM frames round trip through auto selection, and a second init after shutdown works
+ **/
+UTEST(CRYPTO_AUTO, TC_APPLY_PROCESS_GCM_REINIT)
+{
+    int round;
+    for (round = 0; round < 2; round++)
+    {
+        remove("sa_save_file.bin");
+        Crypto_Config_CryptoLib(KEY_TYPE_INTERNAL, MC_TYPE_INTERNAL, SA_TYPE_INMEMORY, CRYPTOGRAPHY_TYPE_AUTO,
+                                IV_INTERNAL, CRYPTO_TC_CREATE_FECF_TRUE, TC_PROCESS_SDLS_PDUS_TRUE, TC_HAS_PUS_HDR,
+                                TC_IGNORE_SA_STATE_FALSE, TC_IGNORE_ANTI_REPLAY_TRUE, TC_UNIQUE_SA_PER_MAP_ID_FALSE,
+                                TC_CHECK_FECF_TRUE, 0x3F, SA_INCREMENT_NONTRANSMITTED_IV_TRUE);
+        GvcidManagedParameters_t TC_0_Managed_Parameters = {0, 0x0003, 0, TC_NO_FECF, AOS_FHEC_NA, AOS_IZ_NA, 0, TC_NO_SEGMENT_HDRS, 1024, TC_OCF_NA, 1};
+        Crypto_Config_Add_Gvcid_Managed_Parameters(TC_0_Managed_Parameters);
+        ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_Init());
+
+        char* raw_tc_h = "200300180001000102030405060708090a0b0c0d0e0f101112";
+        char* raw_tc_b = NULL;
+        int raw_tc_len = 0;
+        hex_conversion(raw_tc_h, &raw_tc_b, &raw_tc_len);
+        SaInterface sa_if = get_sa_interface_inmemory();
+
+        SecurityAssociation_t* test_association;
+        sa_if->sa_get_from_spi(1, &test_association);
+        test_association->sa_state = SA_NONE;
+        sa_if->sa_get_from_spi(9, &test_association);
+        test_association->arsn_len = 0;
+        test_association->shsnf_len = 0;
+        test_association->sa_state = SA_OPERATIONAL;
+        test_association->ast = 1;
+        test_association->est = 1;
+        test_association->ecs_len = 1;
+        test_association->ecs = CRYPTO_CIPHER_AES256_GCM;
+        test_association->stmacf_len = 16;
+        test_association->gvcid_blk.tfvn = 0;
+        test_association->abm_len = 1024;
+
+        uint8_t* ptr_enc_frame = NULL;
+        uint16_t enc_frame_len = 0;
+        ASSERT_EQ(CRYPTO_LIB_SUCCESS,
+                  Crypto_TC_ApplySecurity((uint8_t*)raw_tc_b, raw_tc_len, &ptr_enc_frame, &enc_frame_len));
+
+        TC_t* tc_processed_frame = malloc(sizeof(uint8_t) * TC_SIZE);
+        int processed_len = enc_frame_len;
+        ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_TC_ProcessSecurity(ptr_enc_frame, &processed_len, tc_processed_frame));
+        ASSERT_EQ(raw_tc_len - 5, tc_processed_frame->tc_pdu_len);
+        ASSERT_EQ(0, memcmp(tc_processed_frame->tc_pdu, raw_tc_b + 5, tc_processed_frame->tc_pdu_len));
+
+        Crypto_Shutdown();
+        free(tc_processed_frame);
+        free(ptr_enc_frame);
+        free(raw_tc_b);
+    }
+}
+
+UTEST_MAIN();
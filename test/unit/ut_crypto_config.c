@@ -191,6 +191,139 @@ UTEST(CRYPTO_CONFIG, CRYPTO_CONFIG_KMC)
     ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
 }
 
+/**
+ * @brief Unit Test: Snapshot round trip restores identical state, and rejects a wrong master key or a damaged file
+ **/
+UTEST(CRYPTO_CONFIG, CRYPTO_INIT_FROM_SNAPSHOT)
+{
+    remove("sa_save_file.bin");
+    int32_t status = CRYPTO_LIB_ERROR;
+    uint8_t master_key[32];
+    uint8_t* saved_sa = malloc(NUM_SA * SA_SIZE);
+    crypto_snapshot_key_t* saved_keys = malloc(NUM_KEYS * CRYPTO_SNAPSHOT_KEY_SIZE);
+    SecurityAssociation_t* sa_ptr = NULL;
+    crypto_key_t* key_ptr = NULL;
+    SaInterface sa_if = NULL;
+    KeyInterface key_if = NULL;
+    FILE* snapshot_file = NULL;
+    int i;
+
+    for (i = 0; i < 32; i++)
+    {
+        master_key[i] = (uint8_t)(0xA0 + i);
+    }
+
+    // Earlier tests leave managed parameters configured
+    Crypto_Shutdown();
+    Crypto_Config_CryptoLib(KEY_TYPE_INTERNAL, MC_TYPE_INTERNAL, SA_TYPE_INMEMORY, CRYPTOGRAPHY_TYPE_LIBGCRYPT,
+                            IV_INTERNAL, CRYPTO_TC_CREATE_FECF_TRUE, TC_PROCESS_SDLS_PDUS_TRUE, TC_HAS_PUS_HDR,
+                            TC_IGNORE_SA_STATE_FALSE, TC_IGNORE_ANTI_REPLAY_TRUE, TC_UNIQUE_SA_PER_MAP_ID_FALSE,
+                            TC_CHECK_FECF_TRUE, 0x3F, SA_INCREMENT_NONTRANSMITTED_IV_TRUE);
+    GvcidManagedParameters_t TC_UT_Managed_Parameters = {0, 0x0003, 0, TC_HAS_FECF, AOS_FHEC_NA, AOS_IZ_NA, 0, TC_HAS_SEGMENT_HDRS, 1024, TC_OCF_NA, 1};
+    Crypto_Config_Add_Gvcid_Managed_Parameters(TC_UT_Managed_Parameters);
+    TC_UT_Managed_Parameters.vcid = 1;
+    Crypto_Config_Add_Gvcid_Managed_Parameters(TC_UT_Managed_Parameters);
+    Crypto_Config_Gvcid_Idle_Frames(0, 0x0003, 1, IDLE_VC_TRUE, IDLE_FRAMES_VERIFY);
+    status = Crypto_Init();
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+
+    // State that differs from a default init
+    sa_if = get_sa_interface_inmemory();
+    key_if = get_key_interface_internal();
+    sa_if->sa_get_from_spi(4, &sa_ptr);
+    sa_ptr->sa_state = SA_OPERATIONAL;
+    sa_ptr->iv[11] = 0x42;
+    key_ptr = key_if->get_key(200);
+    key_ptr->value[0] = 0x5A;
+    key_ptr->key_len = 32;
+    for (i = 0; i < NUM_SA; i++)
+    {
+        sa_if->sa_get_from_spi(i, &sa_ptr);
+        memcpy(saved_sa + (i * SA_SIZE), sa_ptr, SA_SIZE);
+    }
+    for (i = 0; i < NUM_KEYS; i++)
+    {
+        // crypto_key_t is a handle into the key pool, compare the material it points at
+        key_ptr = key_if->get_key(i);
+        memcpy(saved_keys[i].value, key_ptr->value, KEY_SIZE);
+        saved_keys[i].key_len = key_ptr->key_len;
+        saved_keys[i].key_state = key_ptr->key_state;
+    }
+
+    status = Crypto_Snapshot_Save("crypto_snapshot.bin", master_key, 32);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+    Crypto_Shutdown();
+
+    status = Crypto_Init_From_Snapshot("crypto_snapshot.bin", master_key, 32);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+    ASSERT_EQ(2, gvcid_counter);
+    ASSERT_EQ(1, gvcid_managed_parameters_array[1].vcid);
+    ASSERT_EQ((uint32_t)IDLE_VC_FALSE, Crypto_Get_Idle_Frames_For_Managed_Parameters(&gvcid_managed_parameters_array[0])->idle_vc);
+    ASSERT_EQ((uint32_t)IDLE_FRAMES_PROCESS, Crypto_Get_Idle_Frames_For_Managed_Parameters(&gvcid_managed_parameters_array[0])->idle_policy);
+    ASSERT_EQ((uint32_t)IDLE_VC_TRUE, Crypto_Get_Idle_Frames_For_Managed_Parameters(&gvcid_managed_parameters_array[1])->idle_vc);
+    ASSERT_EQ((uint32_t)IDLE_FRAMES_VERIFY, Crypto_Get_Idle_Frames_For_Managed_Parameters(&gvcid_managed_parameters_array[1])->idle_policy);
+    ASSERT_TRUE(crypto_config.sa_type == SA_TYPE_INMEMORY);
+    for (i = 0; i < NUM_SA; i++)
+    {
+        sa_if->sa_get_from_spi(i, &sa_ptr);
+        ASSERT_EQ(0, memcmp(saved_sa + (i * SA_SIZE), sa_ptr, SA_SIZE));
+    }
+    for (i = 0; i < NUM_KEYS; i++)
+    {
+        key_ptr = key_if->get_key(i);
+        ASSERT_EQ(0, memcmp(saved_keys[i].value, key_ptr->value, KEY_SIZE));
+        ASSERT_EQ(saved_keys[i].key_len, key_ptr->key_len);
+        ASSERT_EQ(saved_keys[i].key_state, key_ptr->key_state);
+    }
+    ASSERT_EQ(0x5A, key_if->get_key(200)->value[0]);
+    Crypto_Shutdown();
+
+    // Key ring does not open under another master key
+    master_key[0] ^= 0x01;
+    status = Crypto_Init_From_Snapshot("crypto_snapshot.bin", master_key, 32);
+    ASSERT_NE(CRYPTO_LIB_SUCCESS, status);
+    master_key[0] ^= 0x01;
+
+    // Flipped byte in the SA section
+    snapshot_file = fopen("crypto_snapshot.bin", "rb+");
+    ASSERT_TRUE(snapshot_file != NULL);
+    fseek(snapshot_file, sizeof(crypto_snapshot_header_t) + CRYPTO_CONFIG_SIZE +
+          (2 * (GVCID_MANAGED_PARAMETERS_SIZE + GVCID_IDLE_FRAMES_SIZE)) + 10, SEEK_SET);
+    fputc(0xFF, snapshot_file);
+    fclose(snapshot_file);
+    status = Crypto_Init_From_Snapshot("crypto_snapshot.bin", master_key, 32);
+    ASSERT_EQ(CRYPTO_LIB_ERR_SNAPSHOT_CHECKSUM, status);
+    Crypto_Shutdown();
+
+    status = Crypto_Init_From_Snapshot("no_such_snapshot.bin", master_key, 32);
+    ASSERT_EQ(CRYPTO_LIB_ERR_SNAPSHOT_IO, status);
+
+    remove("crypto_snapshot.bin");
+    free(saved_sa);
+    free(saved_keys);
+}
+
+#ifdef CRYPTO_DIRECT_CALL
+/**
+ * @brief Unit Test: Crypto Init selecting a module other than the one bound at build time
+ **/
+UTEST(CRYPTO_CONFIG, CRYPTO_INIT_DIRECT_CALL_MISMATCH)
+{
+    remove("sa_save_file.bin");
+    int32_t status = CRYPTO_LIB_ERROR;
+    // Auto routing is never a bound module
+    Crypto_Config_CryptoLib(KEY_TYPE_INTERNAL, MC_TYPE_INTERNAL, SA_TYPE_INMEMORY, CRYPTOGRAPHY_TYPE_AUTO,
+                            IV_INTERNAL, CRYPTO_TC_CREATE_FECF_TRUE, TC_PROCESS_SDLS_PDUS_TRUE, TC_HAS_PUS_HDR,
+                            TC_IGNORE_SA_STATE_FALSE, TC_IGNORE_ANTI_REPLAY_TRUE, TC_UNIQUE_SA_PER_MAP_ID_FALSE,
+                            TC_CHECK_FECF_TRUE, 0x3F, SA_INCREMENT_NONTRANSMITTED_IV_TRUE);
+    GvcidManagedParameters_t TC_UT_Managed_Parameters = {0, 0x0003, 0, TC_HAS_FECF, AOS_FHEC_NA, AOS_IZ_NA, 0, TC_HAS_SEGMENT_HDRS, 1024, TC_OCF_NA, 1};
+    Crypto_Config_Add_Gvcid_Managed_Parameters(TC_UT_Managed_Parameters);
+    status = Crypto_Init();
+    Crypto_Shutdown();
+    ASSERT_EQ(CRYPTO_DIRECT_CALL_MODULE_MISMATCH, status);
+}
+#endif
+
 #ifdef TODO_NEEDSWORK
 UTEST(CRYPTO_CONFIG, CRYPTO_INIT_KMC_OK)
 {
@@ -113,6 +113,31 @@ UTEST(CRYPTO_MC, PROCESS)
     ASSERT_EQ(103, status);
 }
 
+/**
+ * @brief Unit Test: Crypto MC Event Rate Limit Test
+ * A flood of unknown GVCID lookups reports the first burst and only counts the rest
+ **/
+UTEST(CRYPTO_MC, EVENT_RATE_LIMIT)
+{
+    remove("sa_save_file.bin");
+    const GvcidManagedParameters_t* mp = NULL;
+    int i;
+
+    Crypto_MC_Event_Reset();
+    ASSERT_EQ((uint32_t)0, Crypto_MC_Event_Get_Suppressed(MANAGED_PARAMETERS_FOR_GVCID_NOT_FOUND));
+
+    for (i = 0; i < MC_EVENT_BURST + 5; i++)
+    {
+        ASSERT_EQ(MANAGED_PARAMETERS_FOR_GVCID_NOT_FOUND, Crypto_Get_Managed_Parameters_Ptr_For_Gvcid(0, 0x0044, 1, &mp));
+    }
+    ASSERT_EQ((uint32_t)5, Crypto_MC_Event_Get_Suppressed(MANAGED_PARAMETERS_FOR_GVCID_NOT_FOUND));
+    // Codes are limited independently
+    ASSERT_EQ((uint32_t)0, Crypto_MC_Event_Get_Suppressed(CRYPTO_LIB_ERR_NO_CONFIG));
+
+    Crypto_MC_Event_Reset();
+    ASSERT_EQ((uint32_t)0, Crypto_MC_Event_Get_Suppressed(MANAGED_PARAMETERS_FOR_GVCID_NOT_FOUND));
+}
+
 /**
  * @brief Unit Test: Crypto Get TM Length Test
  **/
@@ -0,0 +1,269 @@
+/* Copyright (C) 2009 - 2022 National Aeronautics and Space Administration.
+   All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any kind, either expressed, implied, or statutory,
+   including, but not limited to, any warranty that the software will conform to specifications, any implied warranties
+   of merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+   documentation will conform to the program, or any warranty that the software will be error free.
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+   consequential damages, arising out of, resulting from, or in any way connected with the software or its
+   documentation, whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained
+   from, or arose out of the results of, or use of, the software, documentation or services provided hereunder.
+
+   ITC Team
+   NASA IV&V
+   jstar-development-team@mail.nasa.gov
+*/
+
+#include "ut_kmc_batch.h"
+#include "crypto.h"
+#include "crypto_error.h"
+#include "cryptography_interface.h"
+#include "kmc_mock.h"
+#include "utest.h"
+
+#include <pthread.h>
+#include <time.h>
+
+#define UT_KMC_BATCH_CALLERS 8
+#define UT_KMC_BATCH_WINDOW_US 500000 // Generous, full batches are sent without waiting it out
+#define UT_KMC_BATCH_SHORT_WINDOW_US 50000
+
+static kmc_mock_t ut_kmc_batch_server;
+
+// One concurrent caller of the KMC crypto service
+typedef struct
+{
+    CryptographyInterface kmc_if;
+    pthread_barrier_t* start;
+    const char* key_ref;
+    uint8_t tag; // First payload byte, echoed in the MAC
+    uint8_t mac[KMC_MOCK_MAC_SIZE];
+    int32_t status;
+} ut_kmc_batch_caller_t;
+
+/**
+ * @brief Function: ut_kmc_batch_init
+ * Configures the KMC crypto service interface with the stand-in and batching
+ * @param batch_max: uint8_t
+ * @param batch_window_us: uint32_t
+ * @return CryptographyInterface: NULL when KMC support is not built
+ **/
+static CryptographyInterface ut_kmc_batch_init(uint8_t batch_max, uint32_t batch_window_us)
+{
+    CryptographyInterface kmc_if = get_cryptography_interface_kmc_crypto_service();
+    if (kmc_if == NULL)
+    {
+        return NULL;
+    }
+    Crypto_Config_Kmc_Crypto_Service("http", "127.0.0.1", ut_kmc_batch_server.port, KMC_MOCK_APP_URI, NULL, NULL,
+                                     CRYPTO_FALSE, NULL, NULL, NULL, NULL, NULL);
+    Crypto_Config_Kmc_Crypto_Service_Batching(batch_max, batch_window_us);
+    kmc_if->cryptography_init();
+    kmc_if->cryptography_config();
+    return kmc_if;
+}
+
+/**
+ * @brief Function: ut_kmc_batch_authenticate
+ * Requests a MAC over a payload starting with the caller's tag
+ **/
+static void* ut_kmc_batch_authenticate(void* arg)
+{
+    ut_kmc_batch_caller_t* caller = (ut_kmc_batch_caller_t*)arg;
+    SecurityAssociation_t sa;
+    uint8_t data_in[8] = {caller->tag, 0x03, 0x00, 0x08, 0x00, 0x01, 0x02, 0x03};
+    uint8_t data_out[8];
+
+    memset(&sa, 0, sizeof(sa));
+    strcpy(sa.ak_ref, caller->key_ref);
+    if (caller->start != NULL)
+    {
+        pthread_barrier_wait(caller->start);
+    }
+    Crypto_Arena_Enter();
+    caller->status = caller->kmc_if->cryptography_authenticate(data_out, sizeof(data_out), data_in, sizeof(data_in),
+                                                               NULL, 0, &sa, NULL, 0, caller->mac, KMC_MOCK_MAC_SIZE,
+                                                               data_in, sizeof(data_in), 0, CRYPTO_MAC_HMAC_SHA256, NULL);
+    Crypto_Arena_Leave();
+    return NULL;
+}
+
+/**
+ * @brief Function: ut_kmc_batch_run
+ * Starts the callers together and waits for all of them, callers alternate between the given key references
+ **/
+static void ut_kmc_batch_run(CryptographyInterface kmc_if, ut_kmc_batch_caller_t* callers, int count,
+                             const char** key_refs, int key_ref_count)
+{
+    pthread_t threads[UT_KMC_BATCH_CALLERS];
+    pthread_barrier_t start;
+
+    pthread_barrier_init(&start, NULL, count);
+    for (int i = 0; i < count; i++)
+    {
+        memset(&callers[i], 0, sizeof(ut_kmc_batch_caller_t));
+        callers[i].kmc_if = kmc_if;
+        callers[i].start = &start;
+        callers[i].key_ref = key_refs[i % key_ref_count];
+        callers[i].tag = (uint8_t)(0x40 + i);
+        pthread_create(&threads[i], NULL, ut_kmc_batch_authenticate, &callers[i]);
+    }
+    for (int i = 0; i < count; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    pthread_barrier_destroy(&start);
+}
+
+static uint64_t ut_kmc_batch_now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000) + ((uint64_t)ts.tv_nsec / 1000000);
+}
+
+/**
+ * @brief Unit Test: Batch limits are checked when configured
+ **/
+UTEST(KMC_BATCH, CONFIG_LIMITS)
+{
+    Crypto_Shutdown();
+    ASSERT_EQ(CRYPTOGRAPHY_KMC_CRYPTO_SERVICE_CONFIGURATION_NOT_COMPLETE,
+              Crypto_Config_Kmc_Crypto_Service_Batching(UT_KMC_BATCH_CALLERS, UT_KMC_BATCH_WINDOW_US));
+    Crypto_Config_Kmc_Crypto_Service("http", "127.0.0.1", 8080, KMC_MOCK_APP_URI, NULL, NULL, CRYPTO_FALSE, NULL, NULL,
+                                     NULL, NULL, NULL);
+    ASSERT_EQ(CRYPTOGRAPHY_KMC_CRYPTO_SERVICE_BATCH_LIMIT,
+              Crypto_Config_Kmc_Crypto_Service_Batching(KMC_CRYPTO_BATCH_MAX + 1, UT_KMC_BATCH_WINDOW_US));
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_Config_Kmc_Crypto_Service_Batching(KMC_CRYPTO_BATCH_MAX, UT_KMC_BATCH_WINDOW_US));
+    Crypto_Shutdown();
+}
+
+/**
+ * @brief Unit Test: Concurrent operations on one key go out in a single request, each caller gets its own answer
+ **/
+UTEST(KMC_BATCH, GATHERS_CONCURRENT_OPERATIONS)
+{
+    ut_kmc_batch_caller_t callers[UT_KMC_BATCH_CALLERS];
+    const char* key_refs[] = {"kmc/test/hmacsha256"};
+
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, kmc_mock_start(&ut_kmc_batch_server, 0));
+    CryptographyInterface kmc_if = ut_kmc_batch_init(UT_KMC_BATCH_CALLERS, UT_KMC_BATCH_WINDOW_US);
+    if (kmc_if != NULL)
+    {
+        ut_kmc_batch_run(kmc_if, callers, UT_KMC_BATCH_CALLERS, key_refs, 1);
+        for (int i = 0; i < UT_KMC_BATCH_CALLERS; i++)
+        {
+            ASSERT_EQ(CRYPTO_LIB_SUCCESS, callers[i].status);
+            ASSERT_EQ(0x11, callers[i].mac[0]);
+            ASSERT_EQ(callers[i].tag, callers[i].mac[1]);
+        }
+        ASSERT_EQ(1, kmc_mock_read(&ut_kmc_batch_server.hits));
+        ASSERT_EQ(1, kmc_mock_read(&ut_kmc_batch_server.batch_hits));
+        ASSERT_EQ(UT_KMC_BATCH_CALLERS, kmc_mock_read(&ut_kmc_batch_server.batch_ops));
+        kmc_if->cryptography_shutdown();
+    }
+    Crypto_Shutdown();
+    kmc_mock_stop(&ut_kmc_batch_server);
+}
+
+/**
+ * @brief Unit Test: Operations on different keys are batched apart
+ **/
+UTEST(KMC_BATCH, SEPARATES_KEY_REFERENCES)
+{
+    ut_kmc_batch_caller_t callers[UT_KMC_BATCH_CALLERS];
+    const char* key_refs[] = {"kmc/test/hmacsha256", "kmc/test/hmacsha512"};
+
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, kmc_mock_start(&ut_kmc_batch_server, 0));
+    CryptographyInterface kmc_if = ut_kmc_batch_init(UT_KMC_BATCH_CALLERS / 2, UT_KMC_BATCH_WINDOW_US);
+    if (kmc_if != NULL)
+    {
+        ut_kmc_batch_run(kmc_if, callers, UT_KMC_BATCH_CALLERS, key_refs, 2);
+        for (int i = 0; i < UT_KMC_BATCH_CALLERS; i++)
+        {
+            ASSERT_EQ(CRYPTO_LIB_SUCCESS, callers[i].status);
+            ASSERT_EQ(callers[i].tag, callers[i].mac[1]);
+        }
+        ASSERT_EQ(2, kmc_mock_read(&ut_kmc_batch_server.batch_hits));
+        ASSERT_EQ(UT_KMC_BATCH_CALLERS, kmc_mock_read(&ut_kmc_batch_server.batch_ops));
+        kmc_if->cryptography_shutdown();
+    }
+    Crypto_Shutdown();
+    kmc_mock_stop(&ut_kmc_batch_server);
+}
+
+/**
+ * @brief Unit Test: A lone operation waits no longer than the window and is sent as a plain request
+ **/
+UTEST(KMC_BATCH, WINDOW_BOUNDS_WAIT)
+{
+    ut_kmc_batch_caller_t caller;
+    uint64_t start;
+    uint64_t elapsed;
+
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, kmc_mock_start(&ut_kmc_batch_server, 0));
+    CryptographyInterface kmc_if = ut_kmc_batch_init(UT_KMC_BATCH_CALLERS, UT_KMC_BATCH_SHORT_WINDOW_US);
+    if (kmc_if != NULL)
+    {
+        memset(&caller, 0, sizeof(caller));
+        caller.kmc_if = kmc_if;
+        caller.key_ref = "kmc/test/hmacsha256";
+        caller.tag = 0x40;
+        start = ut_kmc_batch_now_ms();
+        ut_kmc_batch_authenticate(&caller);
+        elapsed = ut_kmc_batch_now_ms() - start;
+        ASSERT_EQ(CRYPTO_LIB_SUCCESS, caller.status);
+        ASSERT_EQ(0x40, caller.mac[1]);
+        ASSERT_GE(elapsed, (uint64_t)(UT_KMC_BATCH_SHORT_WINDOW_US / 1000) - 1);
+        ASSERT_LT(elapsed, (uint64_t)(UT_KMC_BATCH_WINDOW_US / 1000));
+        ASSERT_EQ(1, kmc_mock_read(&ut_kmc_batch_server.hits));
+        ASSERT_EQ(0, kmc_mock_read(&ut_kmc_batch_server.batch_hits));
+        kmc_if->cryptography_shutdown();
+    }
+    Crypto_Shutdown();
+    kmc_mock_stop(&ut_kmc_batch_server);
+}
+
+/**
+ * @brief Unit Test: A service without the batch endpoint still answers every operation, and is not sent
+ * batches, nor kept waiting on the window, once it answered 404
+ **/
+UTEST(KMC_BATCH, FALLS_BACK_WITHOUT_BATCH_ENDPOINT)
+{
+    ut_kmc_batch_caller_t callers[UT_KMC_BATCH_CALLERS];
+    const char* key_refs[] = {"kmc/test/hmacsha256"};
+    uint64_t start;
+
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, kmc_mock_start(&ut_kmc_batch_server, 0));
+    ut_kmc_batch_server.batch_unsupported = 1;
+    CryptographyInterface kmc_if = ut_kmc_batch_init(UT_KMC_BATCH_CALLERS, UT_KMC_BATCH_WINDOW_US);
+    if (kmc_if != NULL)
+    {
+        ut_kmc_batch_run(kmc_if, callers, UT_KMC_BATCH_CALLERS, key_refs, 1);
+        for (int i = 0; i < UT_KMC_BATCH_CALLERS; i++)
+        {
+            ASSERT_EQ(CRYPTO_LIB_SUCCESS, callers[i].status);
+            ASSERT_EQ(callers[i].tag, callers[i].mac[1]);
+        }
+        ASSERT_EQ(1, kmc_mock_read(&ut_kmc_batch_server.batch_hits));
+        ASSERT_EQ(1 + UT_KMC_BATCH_CALLERS, kmc_mock_read(&ut_kmc_batch_server.hits));
+
+        start = ut_kmc_batch_now_ms();
+        ut_kmc_batch_run(kmc_if, callers, UT_KMC_BATCH_CALLERS, key_refs, 1);
+        ASSERT_LT(ut_kmc_batch_now_ms() - start, (uint64_t)(UT_KMC_BATCH_WINDOW_US / 1000));
+        for (int i = 0; i < UT_KMC_BATCH_CALLERS; i++)
+        {
+            ASSERT_EQ(CRYPTO_LIB_SUCCESS, callers[i].status);
+            ASSERT_EQ(callers[i].tag, callers[i].mac[1]);
+        }
+        ASSERT_EQ(1, kmc_mock_read(&ut_kmc_batch_server.batch_hits));
+        ASSERT_EQ(1 + (2 * UT_KMC_BATCH_CALLERS), kmc_mock_read(&ut_kmc_batch_server.hits));
+        kmc_if->cryptography_shutdown();
+    }
+    Crypto_Shutdown();
+    kmc_mock_stop(&ut_kmc_batch_server);
+}
+
+UTEST_MAIN();
@@ -0,0 +1,201 @@
+/* Copyright (C) 2009 - 2022 National Aeronautics and Space Administration.
+   All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any kind, either expressed, implied, or statutory,
+   including, but not limited to, any warranty that the software will conform to specifications, any implied warranties
+   of merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+   documentation will conform to the program, or any warranty that the software will be error free.
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+   consequential damages, arising out of, resulting from, or in any way connected with the software or its
+   documentation, whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained
+   from, or arose out of the results of, or use of, the software, documentation or services provided hereunder.
+
+   ITC Team
+   NASA IV&V
+   jstar-development-team@mail.nasa.gov
+*/
+
+#include "ut_kmc_endpoints.h"
+#include "crypto.h"
+#include "crypto_error.h"
+#include "cryptography_interface.h"
+#include "kmc_mock.h"
+#include "utest.h"
+
+#include <time.h>
+
+#define UT_KMC_SERVERS 2
+#define UT_KMC_SLOW_MS 600
+#define UT_KMC_HEDGE_MS 50
+#define UT_KMC_REQUESTS 8
+
+static kmc_mock_t ut_kmc_servers[UT_KMC_SERVERS];
+
+/**
+ * @brief Function: ut_kmc_start_servers
+ * @return int32: Success/Failure
+ **/
+static int32_t ut_kmc_start_servers(void)
+{
+    for (uint8_t i = 0; i < UT_KMC_SERVERS; i++)
+    {
+        if (kmc_mock_start(&ut_kmc_servers[i], i) != CRYPTO_LIB_SUCCESS)
+        {
+            return CRYPTO_LIB_ERROR;
+        }
+    }
+    return CRYPTO_LIB_SUCCESS;
+}
+
+/**
+ * @brief Function: ut_kmc_stop_servers
+ **/
+static void ut_kmc_stop_servers(void)
+{
+    for (uint8_t i = 0; i < UT_KMC_SERVERS; i++)
+    {
+        kmc_mock_stop(&ut_kmc_servers[i]);
+    }
+}
+
+/**
+ * @brief Function: ut_kmc_init
+ * Configures the KMC crypto service interface with the stand-ins, server 0 is the primary
+ * @param hedge_delay_ms: uint32_t
+ * @param breaker_threshold: uint8_t
+ * @return CryptographyInterface: NULL when KMC support is not built
+ **/
+static CryptographyInterface ut_kmc_init(uint32_t hedge_delay_ms, uint8_t breaker_threshold)
+{
+    CryptographyInterface kmc_if = get_cryptography_interface_kmc_crypto_service();
+    if (kmc_if == NULL)
+    {
+        return NULL;
+    }
+    Crypto_Config_Kmc_Crypto_Service("http", "127.0.0.1", ut_kmc_servers[0].port, KMC_MOCK_APP_URI, NULL, NULL,
+                                     CRYPTO_FALSE, NULL, NULL, NULL, NULL, NULL);
+    Crypto_Config_Kmc_Crypto_Service_Add_Endpoint("127.0.0.1", ut_kmc_servers[1].port);
+    Crypto_Config_Kmc_Crypto_Service_Hedging(hedge_delay_ms, breaker_threshold, 60000);
+    kmc_if->cryptography_init();
+    kmc_if->cryptography_config();
+    return kmc_if;
+}
+
+/**
+ * @brief Function: ut_kmc_authenticate
+ * Requests a MAC, the first MAC byte tells which stand-in answered
+ * @param kmc_if: CryptographyInterface
+ * @param mac: uint8_t*
+ * @return int32: Success/Failure
+ **/
+static int32_t ut_kmc_authenticate(CryptographyInterface kmc_if, uint8_t* mac)
+{
+    SecurityAssociation_t sa;
+    uint8_t data_in[8] = {0x20, 0x03, 0x00, 0x08, 0x00, 0x01, 0x02, 0x03};
+    uint8_t data_out[8];
+    int32_t status;
+
+    memset(&sa, 0, sizeof(sa));
+    strcpy(sa.ak_ref, "kmc/test/hmacsha256");
+    memset(mac, 0, KMC_MOCK_MAC_SIZE);
+
+    Crypto_Arena_Enter();
+    status = kmc_if->cryptography_authenticate(data_out, sizeof(data_out), data_in, sizeof(data_in), NULL, 0, &sa,
+                                               NULL, 0, mac, KMC_MOCK_MAC_SIZE, data_in, sizeof(data_in), 0,
+                                               CRYPTO_MAC_HMAC_SHA256, NULL);
+    Crypto_Arena_Leave();
+    return status;
+}
+
+static uint64_t ut_kmc_now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000) + ((uint64_t)ts.tv_nsec / 1000000);
+}
+
+/**
+ * @brief Unit Test: A request stuck on a slow endpoint is hedged, the faster answer wins
+ **/
+UTEST(KMC_ENDPOINTS, HEDGE_SLOW_PRIMARY)
+{
+    uint8_t mac[KMC_MOCK_MAC_SIZE];
+    uint64_t start;
+
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, ut_kmc_start_servers());
+    ut_kmc_servers[0].delay_ms = UT_KMC_SLOW_MS;
+    CryptographyInterface kmc_if = ut_kmc_init(UT_KMC_HEDGE_MS, KMC_CRYPTO_BREAKER_THRESHOLD);
+    if (kmc_if != NULL)
+    {
+        start = ut_kmc_now_ms();
+        ASSERT_EQ(CRYPTO_LIB_SUCCESS, ut_kmc_authenticate(kmc_if, mac));
+        ASSERT_EQ(0x22, mac[0]);
+        ASSERT_EQ(0x20, mac[1]); // Echo of the first payload byte
+        ASSERT_LT(ut_kmc_now_ms() - start, (uint64_t)UT_KMC_SLOW_MS);
+        ASSERT_EQ(1, kmc_mock_read(&ut_kmc_servers[0].hits));
+        ASSERT_EQ(1, kmc_mock_read(&ut_kmc_servers[1].hits));
+
+        // The slow endpoint is now known, later requests start on the fast one
+        ASSERT_EQ(CRYPTO_LIB_SUCCESS, ut_kmc_authenticate(kmc_if, mac));
+        ASSERT_EQ(0x22, mac[0]);
+        ASSERT_EQ(1, kmc_mock_read(&ut_kmc_servers[0].hits));
+        kmc_if->cryptography_shutdown();
+    }
+    Crypto_Shutdown();
+    ut_kmc_stop_servers();
+}
+
+/**
+ * @brief Unit Test: Requests fail over from an endpoint answering with server errors until its circuit opens
+ **/
+UTEST(KMC_ENDPOINTS, BREAKER_SKIPS_FAILING_ENDPOINT)
+{
+    uint8_t mac[KMC_MOCK_MAC_SIZE];
+
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, ut_kmc_start_servers());
+    ut_kmc_servers[0].fail = 1;
+    CryptographyInterface kmc_if = ut_kmc_init(KMC_CRYPTO_HEDGE_OFF, 2);
+    if (kmc_if != NULL)
+    {
+        for (int i = 0; i < UT_KMC_REQUESTS; i++)
+        {
+            ASSERT_EQ(CRYPTO_LIB_SUCCESS, ut_kmc_authenticate(kmc_if, mac));
+            ASSERT_EQ(0x22, mac[0]);
+        }
+        // Two failures opened the circuit, the failing endpoint saw no more requests
+        ASSERT_EQ(2, kmc_mock_read(&ut_kmc_servers[0].hits));
+        ASSERT_EQ(UT_KMC_REQUESTS, kmc_mock_read(&ut_kmc_servers[1].hits));
+        kmc_if->cryptography_shutdown();
+    }
+    Crypto_Shutdown();
+    ut_kmc_stop_servers();
+}
+
+/**
+ * @brief Unit Test: Without hedging, requests go to the endpoint with the lowest latency
+ **/
+UTEST(KMC_ENDPOINTS, PREFER_FASTEST_ENDPOINT)
+{
+    uint8_t mac[KMC_MOCK_MAC_SIZE];
+
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, ut_kmc_start_servers());
+    ut_kmc_servers[0].delay_ms = UT_KMC_HEDGE_MS;
+    CryptographyInterface kmc_if = ut_kmc_init(KMC_CRYPTO_HEDGE_OFF, KMC_CRYPTO_BREAKER_THRESHOLD);
+    if (kmc_if != NULL)
+    {
+        for (int i = 0; i < UT_KMC_REQUESTS; i++)
+        {
+            ASSERT_EQ(CRYPTO_LIB_SUCCESS, ut_kmc_authenticate(kmc_if, mac));
+        }
+        // Each endpoint is measured once, everything after that goes to the fast one
+        ASSERT_EQ(1, kmc_mock_read(&ut_kmc_servers[0].hits));
+        ASSERT_EQ(UT_KMC_REQUESTS - 1, kmc_mock_read(&ut_kmc_servers[1].hits));
+        ASSERT_EQ(0x22, mac[0]);
+        kmc_if->cryptography_shutdown();
+    }
+    Crypto_Shutdown();
+    ut_kmc_stop_servers();
+}
+
+UTEST_MAIN();
@@ -0,0 +1,253 @@
+/* Copyright (C) 2009 - 2022 National Aeronautics and Space Administration.
+   All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any kind, either expressed, implied, or statutory,
+   including, but not limited to, any warranty that the software will conform to specifications, any implied warranties
+   of merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+   documentation will conform to the program, or any warranty that the software will be error free.
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+   consequential damages, arising out of, resulting from, or in any way connected with the software or its
+   documentation, whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained
+   from, or arose out of the results of, or use of, the software, documentation or services provided hereunder.
+
+   ITC Team
+   NASA IV&V
+   jstar-development-team@mail.nasa.gov
+*/
+
+#include "ut_sa_profile.h"
+#include "crypto.h"
+#include "crypto_error.h"
+#include "sa_interface.h"
+#include "utest.h"
+
+#define UT_TM_PROFILE_FRAME_SIZE 128
+
+/**
+ * @brief Unit Test: TC AES-GCM SA takes its profile and matches a frame built from the cryptography interface
+ **/
+UTEST(SA_PROFILE, TC_GCM_MATCHES_REFERENCE)
+{
+    remove("sa_save_file.bin");
+    Crypto_Init_TC_Unit_Test();
+    SaInterface sa_if = get_sa_interface_inmemory();
+    char* raw_tc_h = "20030015000080d2c70008197f0b00310000b1fe3128";
+    char* raw_tc_b = NULL;
+    int raw_tc_len = 0;
+    uint8_t* ptr_enc_frame = NULL;
+    uint16_t enc_frame_len = 0;
+    uint8_t expected[64];
+    uint8_t aad[20];
+    uint8_t iv[12];
+    uint16_t fecf = 0;
+    int i;
+    hex_conversion(raw_tc_h, &raw_tc_b, &raw_tc_len);
+
+    SecurityAssociation_t* test_association = NULL;
+    sa_if->sa_get_from_spi(1, &test_association);
+    test_association->sa_state = SA_NONE;
+    sa_if->sa_get_from_spi(4, &test_association);
+    test_association->sa_state = SA_OPERATIONAL;
+    test_association->arsn_len = 0;
+    for (i = 0; i < 12; i++)
+    {
+        test_association->iv[i] = i;
+    }
+    test_association->iv[11] = 0xFF;
+    memcpy(iv, test_association->iv, 12);
+    memset(test_association->abm, 0xFF, 20);
+    test_association->abm[2] = 0xFC;
+    crypto_key_t* ekp = key_if->get_key(test_association->ekid);
+
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_TC_ApplySecurity((uint8_t*)raw_tc_b, raw_tc_len, &ptr_enc_frame, &enc_frame_len));
+    ASSERT_NE(NULL, Crypto_SA_Profile_Get(test_association, TYPE_TC));
+    // Header and segment header, SPI, IV, 14 byte payload, MAC, FECF
+    ASSERT_EQ(6 + 2 + 12 + 14 + 16 + 2, enc_frame_len);
+
+    memcpy(expected, raw_tc_b, 6);
+    expected[2] = (expected[2] & 0xFC) | (((enc_frame_len - 1) & 0x0300) >> 8);
+    expected[3] = (enc_frame_len - 1) & 0x00FF;
+    expected[6] = 0x00;
+    expected[7] = 0x04;
+    memcpy(expected + 8, iv, 12);
+    for (i = 0; i < 20; i++)
+    {
+        aad[i] = expected[i] & test_association->abm[i];
+    }
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS,
+              cryptography_if->cryptography_aead_encrypt(expected + 20, 14, (uint8_t*)raw_tc_b + 6, 14, ekp->value,
+                                                         32, NULL, iv, 12, expected + 34, 16, aad, 20, CRYPTO_TRUE,
+                                                         CRYPTO_TRUE, CRYPTO_TRUE, &test_association->ecs,
+                                                         &test_association->acs, NULL));
+    fecf = Crypto_Calc_FECF(expected, 50);
+    expected[50] = (fecf & 0xFF00) >> 8;
+    expected[51] = fecf & 0x00FF;
+    ASSERT_EQ(0, memcmp(expected, ptr_enc_frame, enc_frame_len));
+
+    // IV advanced with carry, as the generic path does
+    ASSERT_EQ(0x0B, test_association->iv[10]);
+    ASSERT_EQ(0x00, test_association->iv[11]);
+
+    Crypto_Shutdown();
+    free(raw_tc_b);
+    free(ptr_enc_frame);
+}
+
+/**
+ * @brief Unit Test: Changing the SA shape drops it back to the generic path, restoring it compiles the profile again
+ **/
+UTEST(SA_PROFILE, TC_SHAPE_CHANGE_FALLS_BACK)
+{
+    remove("sa_save_file.bin");
+    Crypto_Init_TC_Unit_Test();
+    SaInterface sa_if = get_sa_interface_inmemory();
+    char* raw_tc_h = "20030015000080d2c70008197f0b00310000b1fe3128";
+    char* raw_tc_b = NULL;
+    int raw_tc_len = 0;
+    uint8_t* ptr_enc_frame = NULL;
+    uint16_t enc_frame_len = 0;
+    hex_conversion(raw_tc_h, &raw_tc_b, &raw_tc_len);
+
+    SecurityAssociation_t* test_association = NULL;
+    sa_if->sa_get_from_spi(1, &test_association);
+    test_association->sa_state = SA_NONE;
+    sa_if->sa_get_from_spi(4, &test_association);
+    test_association->sa_state = SA_OPERATIONAL;
+    test_association->arsn_len = 0;
+
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_TC_ApplySecurity((uint8_t*)raw_tc_b, raw_tc_len, &ptr_enc_frame, &enc_frame_len));
+    ASSERT_NE(NULL, Crypto_SA_Profile_Get(test_association, TYPE_TC));
+    free(ptr_enc_frame);
+    ptr_enc_frame = NULL;
+
+    // Truncated MAC is not a profiled shape
+    test_association->stmacf_len = 8;
+    ASSERT_EQ(NULL, Crypto_SA_Profile_Get(test_association, TYPE_TC));
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_TC_ApplySecurity((uint8_t*)raw_tc_b, raw_tc_len, &ptr_enc_frame, &enc_frame_len));
+    ASSERT_EQ(6 + 2 + 12 + 14 + 8 + 2, enc_frame_len);
+    free(ptr_enc_frame);
+    ptr_enc_frame = NULL;
+
+    // Neither is a sequence number
+    test_association->stmacf_len = 16;
+    test_association->shsnf_len = 2;
+    test_association->arsn_len = 2;
+    ASSERT_EQ(NULL, Crypto_SA_Profile_Get(test_association, TYPE_TC));
+    test_association->shsnf_len = 0;
+    test_association->arsn_len = 0;
+
+    // Nor a non AEAD cipher suite
+    test_association->ecs = CRYPTO_CIPHER_AES256_CBC;
+    ASSERT_EQ(NULL, Crypto_SA_Profile_Get(test_association, TYPE_TC));
+    test_association->ecs = CRYPTO_CIPHER_AES256_GCM;
+
+    // Restored shape, and a flush, both compile a fresh profile
+    ASSERT_NE(NULL, Crypto_SA_Profile_Get(test_association, TYPE_TC));
+    Crypto_Flush_SA(test_association->spi);
+    ASSERT_NE(NULL, Crypto_SA_Profile_Get(test_association, TYPE_TC));
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_TC_ApplySecurity((uint8_t*)raw_tc_b, raw_tc_len, &ptr_enc_frame, &enc_frame_len));
+    ASSERT_EQ(6 + 2 + 12 + 14 + 16 + 2, enc_frame_len);
+
+    // Unknown key is reported the same way as on the generic path
+    free(ptr_enc_frame);
+    ptr_enc_frame = NULL;
+    test_association->ekid = 0xFFFF;
+    ASSERT_EQ(CRYPTO_LIB_ERR_KEY_ID_ERROR, Crypto_TC_ApplySecurity((uint8_t*)raw_tc_b, raw_tc_len, &ptr_enc_frame, &enc_frame_len));
+
+    Crypto_Shutdown();
+    free(raw_tc_b);
+    free(ptr_enc_frame);
+}
+
+/**
+ * @brief Unit Test: TM AES-GCM SA with OCF and FECF takes its profile and matches a frame built from the cryptography interface
+ **/
+UTEST(SA_PROFILE, TM_GCM_MATCHES_REFERENCE)
+{
+    remove("sa_save_file.bin");
+    Crypto_Config_CryptoLib(KEY_TYPE_INTERNAL, MC_TYPE_INTERNAL, SA_TYPE_INMEMORY, CRYPTOGRAPHY_TYPE_LIBGCRYPT,
+                            IV_INTERNAL, CRYPTO_TM_CREATE_FECF_TRUE, TC_PROCESS_SDLS_PDUS_TRUE, TC_HAS_PUS_HDR,
+                            TC_IGNORE_SA_STATE_FALSE, TC_IGNORE_ANTI_REPLAY_FALSE, TC_UNIQUE_SA_PER_MAP_ID_FALSE,
+                            TC_CHECK_FECF_TRUE, 0x3F, SA_INCREMENT_NONTRANSMITTED_IV_TRUE);
+    GvcidManagedParameters_t TM_UT_Managed_Parameters = {0, 0x002c, 0, TM_HAS_FECF, AOS_FHEC_NA, AOS_IZ_NA, 0, TM_SEGMENT_HDRS_NA, UT_TM_PROFILE_FRAME_SIZE, TM_HAS_OCF, 1};
+    Crypto_Config_Add_Gvcid_Managed_Parameters(TM_UT_Managed_Parameters);
+    Crypto_Init();
+    SaInterface sa_if = get_sa_interface_inmemory();
+    uint8_t frame[UT_TM_PROFILE_FRAME_SIZE];
+    uint8_t expected[UT_TM_PROFILE_FRAME_SIZE];
+    uint8_t aad[20];
+    uint8_t iv[12];
+    // Primary header, SPI, IV, data, MAC, OCF, FECF
+    uint16_t pdu_len = UT_TM_PROFILE_FRAME_SIZE - 6 - 2 - 12 - 16 - 4 - 2;
+    uint16_t fecf = 0;
+    int i;
+
+    memset(frame, 0xAB, sizeof(frame));
+    frame[0] = 0x02;
+    frame[1] = 0xC0;
+    frame[2] = 0x00;
+    frame[3] = 0x00;
+    frame[4] = 0x18;
+    frame[5] = 0x00;
+    memset(frame + UT_TM_PROFILE_FRAME_SIZE - 6, 0xCD, 4);
+
+    SecurityAssociation_t* sa_ptr = NULL;
+    sa_if->sa_get_from_spi(1, &sa_ptr);
+    sa_ptr->sa_state = SA_NONE;
+    sa_if->sa_get_from_spi(5, &sa_ptr);
+    sa_ptr->gvcid_blk.scid = 44;
+    sa_ptr->gvcid_blk.vcid = 0;
+    sa_ptr->sa_state = SA_OPERATIONAL;
+    sa_ptr->est = 1;
+    sa_ptr->ast = 1;
+    sa_ptr->ecs_len = 1;
+    sa_ptr->ecs = CRYPTO_CIPHER_AES256_GCM;
+    sa_ptr->acs_len = 0;
+    sa_ptr->shsnf_len = 0;
+    sa_ptr->arsn_len = 0;
+    sa_ptr->stmacf_len = 16;
+    sa_ptr->abm_len = UT_TM_PROFILE_FRAME_SIZE;
+    memset(sa_ptr->abm, 0xFF, UT_TM_PROFILE_FRAME_SIZE);
+    for (i = 0; i < 12; i++)
+    {
+        sa_ptr->iv[i] = 0xA0 + i;
+    }
+    memcpy(iv, sa_ptr->iv, 12);
+    crypto_key_t* ekp = key_if->get_key(sa_ptr->ekid);
+
+    memcpy(expected, frame, sizeof(frame));
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_TM_ApplySecurity(frame));
+    ASSERT_NE(NULL, Crypto_SA_Profile_Get(sa_ptr, TYPE_TM));
+
+    expected[6] = 0x00;
+    expected[7] = 0x05;
+    memcpy(expected + 8, iv, 12);
+    for (i = 0; i < 20; i++)
+    {
+        aad[i] = expected[i] & sa_ptr->abm[i];
+    }
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS,
+              cryptography_if->cryptography_aead_encrypt(expected + 20, pdu_len, expected + 20, pdu_len, ekp->value,
+                                                         32, NULL, iv, 12, expected + 20 + pdu_len, 16, aad, 20,
+                                                         CRYPTO_TRUE, CRYPTO_TRUE, CRYPTO_TRUE, &sa_ptr->ecs,
+                                                         &sa_ptr->acs, NULL));
+    fecf = Crypto_Calc_FECF(expected, UT_TM_PROFILE_FRAME_SIZE - 2);
+    expected[UT_TM_PROFILE_FRAME_SIZE - 2] = (fecf & 0xFF00) >> 8;
+    expected[UT_TM_PROFILE_FRAME_SIZE - 1] = fecf & 0x00FF;
+    ASSERT_EQ(0, memcmp(expected, frame, sizeof(frame)));
+    // OCF left as the caller placed it
+    ASSERT_EQ(0xCD, frame[UT_TM_PROFILE_FRAME_SIZE - 6]);
+    ASSERT_EQ(0xAC, sa_ptr->iv[11]);
+
+    // Secondary header present, generic path handles the frame
+    frame[4] = 0x98;
+    frame[6] = 0x00;
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_TM_ApplySecurity(frame));
+    ASSERT_EQ(0x00, frame[7]);
+    ASSERT_EQ(0x05, frame[8]);
+
+    Crypto_Shutdown();
+}
+
+UTEST_MAIN();
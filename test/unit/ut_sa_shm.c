@@ -0,0 +1,188 @@
+/* Copyright (C) 2009 - 2022 National Aeronautics and Space Administration.
+   All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any kind, either expressed, implied, or statutory,
+   including, but not limited to, any warranty that the software will conform to specifications, any implied warranties
+   of merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+   documentation will conform to the program, or any warranty that the software will be error free.
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+   consequential damages, arising out of, resulting from, or in any way connected with the software or its
+   documentation, whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained
+   from, or arose out of the results of, or use of, the software, documentation or services provided hereunder.
+
+   ITC Team
+   NASA IV&V
+   jstar-development-team@mail.nasa.gov
+*/
+
+#include "ut_sa_shm.h"
+#include "crypto.h"
+#include "crypto_error.h"
+#include "sa_interface.h"
+#include "utest.h"
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define UT_SA_SHM_CHILD_FRAMES 3
+
+/**
+ * @brief Function: ut_sa_shm_init
+ * TC unit test configuration on the shared memory SADB
+ * @return int32: Success/Failure
+ **/
+static int32_t ut_sa_shm_init(void)
+{
+    Crypto_Config_CryptoLib(KEY_TYPE_INTERNAL, MC_TYPE_INTERNAL, SA_TYPE_SHM, CRYPTOGRAPHY_TYPE_LIBGCRYPT,
+                            IV_INTERNAL, CRYPTO_TC_CREATE_FECF_TRUE, TC_PROCESS_SDLS_PDUS_TRUE, TC_HAS_PUS_HDR,
+                            TC_IGNORE_SA_STATE_FALSE, TC_IGNORE_ANTI_REPLAY_FALSE, TC_UNIQUE_SA_PER_MAP_ID_FALSE,
+                            TC_CHECK_FECF_TRUE, 0x3F, SA_INCREMENT_NONTRANSMITTED_IV_TRUE);
+    GvcidManagedParameters_t TC_UT_Managed_Parameters = {0, 0x0003, 0, TC_HAS_FECF, AOS_FHEC_NA, AOS_IZ_NA, 0, TC_HAS_SEGMENT_HDRS, 1024, TC_OCF_NA, 1};
+    Crypto_Config_Add_Gvcid_Managed_Parameters(TC_UT_Managed_Parameters);
+    return Crypto_Init();
+}
+
+/**
+ * @brief Unit Test: Counters advanced by one process are seen by another, and a stale copy cannot roll them back
+ **/
+UTEST(SA_SHM, COUNTERS_SHARED_ACROSS_PROCESSES)
+{
+    remove("sa_save_file.bin");
+    Crypto_Shutdown();
+    shm_unlink(SA_SHM_NAME);
+    SecurityAssociation_t* sa_ptr = NULL;
+    int child_status = 0;
+    pid_t pid;
+    int i;
+
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, ut_sa_shm_init());
+    SaInterface sa_if = get_sa_interface_shm();
+
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, sa_if->sa_get_from_spi(1, &sa_ptr));
+    ASSERT_EQ(2, sa_ptr->arsn_len);
+    ASSERT_EQ(0, sa_ptr->arsn[0]);
+    ASSERT_EQ(0, sa_ptr->arsn[1]);
+
+    pid = fork();
+    ASSERT_TRUE(pid >= 0);
+    if (pid == 0)
+    {
+        // Attach as a separate CryptoLib instance to the segment the parent populated, and send a few frames
+        int exit_code = 0;
+        Crypto_Shutdown();
+        if (ut_sa_shm_init() != CRYPTO_LIB_SUCCESS)
+        {
+            exit_code = 1;
+        }
+        for (i = 0; (exit_code == 0) && (i < UT_SA_SHM_CHILD_FRAMES); i++)
+        {
+            if (sa_if->sa_get_from_spi(1, &sa_ptr) != CRYPTO_LIB_SUCCESS)
+            {
+                exit_code = 2;
+                break;
+            }
+            Crypto_increment(sa_ptr->arsn, sa_ptr->arsn_len);
+            Crypto_increment(sa_ptr->iv, sa_ptr->iv_len);
+            if (sa_if->sa_save_sa(sa_ptr) != CRYPTO_LIB_SUCCESS)
+            {
+                exit_code = 3;
+            }
+        }
+        Crypto_Shutdown();
+        _exit(exit_code);
+    }
+    ASSERT_EQ(pid, waitpid(pid, &child_status, 0));
+    ASSERT_TRUE(WIFEXITED(child_status));
+    ASSERT_EQ(0, WEXITSTATUS(child_status));
+
+    // The parent sees the child's counters without re-initializing
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, sa_if->sa_get_from_spi(1, &sa_ptr));
+    ASSERT_EQ(0, sa_ptr->arsn[0]);
+    ASSERT_EQ(UT_SA_SHM_CHILD_FRAMES, sa_ptr->arsn[1]);
+    ASSERT_EQ(UT_SA_SHM_CHILD_FRAMES, sa_ptr->iv[sa_ptr->iv_len - 1]);
+
+    // Publishing a lower counter keeps the shared one and hands it back
+    sa_ptr->arsn[1] = 1;
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, sa_if->sa_save_sa(sa_ptr));
+    ASSERT_EQ(UT_SA_SHM_CHILD_FRAMES, sa_ptr->arsn[1]);
+
+    // Configuration changes on a local copy stay local
+    sa_ptr->sa_state = SA_KEYED;
+    Crypto_increment(sa_ptr->arsn, sa_ptr->arsn_len);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, sa_if->sa_save_sa(sa_ptr));
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, sa_if->sa_get_operational_sa_from_gvcid(0, SCID, 0, 0, &sa_ptr));
+    ASSERT_EQ(1, sa_ptr->spi);
+    ASSERT_EQ(UT_SA_SHM_CHILD_FRAMES + 1, sa_ptr->arsn[1]);
+
+    // Re-attaching keeps the counters, the segment outlives the process that created it
+    Crypto_Shutdown();
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, ut_sa_shm_init());
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, sa_if->sa_get_from_spi(1, &sa_ptr));
+    ASSERT_EQ(SA_OPERATIONAL, sa_ptr->sa_state);
+    ASSERT_EQ(UT_SA_SHM_CHILD_FRAMES + 1, sa_ptr->arsn[1]);
+
+    Crypto_Shutdown();
+    shm_unlink(SA_SHM_NAME);
+}
+
+/**
+ * @brief Unit Test: Operational SAs are found through the shared GVCID index, misses keep the in-memory error codes
+ **/
+UTEST(SA_SHM, GVCID_INDEX)
+{
+    remove("sa_save_file.bin");
+    Crypto_Shutdown();
+    shm_unlink(SA_SHM_NAME);
+    SecurityAssociation_t* sa_ptr = NULL;
+
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, ut_sa_shm_init());
+    SaInterface sa_if = get_sa_interface_shm();
+
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, sa_if->sa_get_operational_sa_from_gvcid(0, SCID, 0, 0, &sa_ptr));
+    ASSERT_EQ(1, sa_ptr->spi);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, sa_if->sa_get_operational_sa_from_gvcid(1, SCID, 0, 0, &sa_ptr));
+    ASSERT_EQ(10, sa_ptr->spi);
+    ASSERT_EQ(CRYPTO_LIB_ERR_NO_OPERATIONAL_SA, sa_if->sa_get_operational_sa_from_gvcid(0, SCID + 1, 0, 0, &sa_ptr));
+    ASSERT_EQ(CRYPTO_LIB_ERR_SPI_INDEX_OOB, sa_if->sa_get_from_spi(NUM_SA, &sa_ptr));
+
+    Crypto_Shutdown();
+    shm_unlink(SA_SHM_NAME);
+}
+
+/**
+ * @brief Unit Test: Counter reservations go through the segment, a reserved value is never handed out twice
+ **/
+UTEST(SA_SHM, RESERVE_COUNTERS)
+{
+    remove("sa_save_file.bin");
+    Crypto_Shutdown();
+    shm_unlink(SA_SHM_NAME);
+    SecurityAssociation_t* sa_ptr = NULL;
+    crypto_sa_counters_t counters;
+
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, ut_sa_shm_init());
+    SaInterface sa_if = get_sa_interface_shm();
+
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, sa_if->sa_get_from_spi(1, &sa_ptr));
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_SA_Counters_Reserve(sa_ptr, SA_AUTHENTICATED_ENCRYPTION, &counters));
+    ASSERT_EQ(0, counters.arsn[1]);
+    ASSERT_EQ(1, sa_ptr->arsn[1]);
+
+    // A reservation from a copy rolled back locally still starts past the first one
+    sa_ptr->arsn[1] = 0;
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_SA_Counters_Reserve(sa_ptr, SA_AUTHENTICATED_ENCRYPTION, &counters));
+    ASSERT_EQ(1, counters.arsn[1]);
+    ASSERT_EQ(2, sa_ptr->arsn[1]);
+
+    Crypto_Shutdown();
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, ut_sa_shm_init());
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, sa_if->sa_get_from_spi(1, &sa_ptr));
+    ASSERT_EQ(2, sa_ptr->arsn[1]);
+
+    Crypto_Shutdown();
+    shm_unlink(SA_SHM_NAME);
+}
+
+UTEST_MAIN();
@@ -25,6 +25,8 @@
 #include "sa_interface.h"
 #include "utest.h"
 
+#include <pthread.h>
+
 /**
  * @brief Unit Test: No Crypto_Init()
  *
@@ -1292,4 +1294,374 @@ UTEST(TC_APPLY_SECURITY, PLAINTEXT_W_ARSN)
     ASSERT_EQ(CRYPTO_LIB_SUCCESS, return_val);
 }
 
+/**
+ * @brief Unit Test: Scratch Arena
+ * Transient AAD comes out of the per-thread arena, which is released when each ApplySecurity call returns
+ **/
+UTEST(TC_APPLY_SECURITY, SCRATCH_ARENA)
+{
+    remove("sa_save_file.bin");
+    crypto_arena_stats_t stats;
+    uint8_t* first = NULL;
+
+    // Exhaustion is reported rather than spilling to the heap
+    Crypto_Arena_Reset_Stats();
+    Crypto_Arena_Enter();
+    first = Crypto_Arena_Alloc(CRYPTO_ARENA_SIZE / 2);
+    ASSERT_TRUE(first != NULL);
+    ASSERT_TRUE(Crypto_Arena_Alloc(CRYPTO_ARENA_SIZE / 2) != NULL);
+    ASSERT_TRUE(Crypto_Arena_Alloc(1) == NULL);
+    Crypto_Arena_Leave();
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_Arena_Get_Stats(&stats));
+    ASSERT_EQ((size_t)CRYPTO_ARENA_SIZE, stats.high_water);
+    ASSERT_EQ((uint32_t)1, stats.exhausted);
+    // Leaving the outermost scope hands the whole block back
+    Crypto_Arena_Enter();
+    ASSERT_TRUE(Crypto_Arena_Alloc(CRYPTO_ARENA_SIZE) == first);
+    Crypto_Arena_Leave();
+
+    // Setup & Initialize CryptoLib
+    Crypto_Init_TC_Unit_Test();
+    char* raw_tc_sdls_ping_h = "20030015000080d2c70008197f0b00310000b1fe3128";
+    char* raw_tc_sdls_ping_b = NULL;
+    int raw_tc_sdls_ping_len = 0;
+    SaInterface sa_if = get_sa_interface_inmemory();
+
+    hex_conversion(raw_tc_sdls_ping_h, &raw_tc_sdls_ping_b, &raw_tc_sdls_ping_len);
+
+    uint8_t* ptr_enc_frame = NULL;
+    uint16_t enc_frame_len = 0;
+    int32_t return_val = CRYPTO_LIB_ERROR;
+    int i;
+
+    SecurityAssociation_t* test_association;
+    // Expose the SADB Security Association for test edits.
+    sa_if->sa_get_from_spi(1, &test_association);
+    test_association->sa_state = SA_NONE;
+    sa_if->sa_get_from_spi(4, &test_association);
+    test_association->ekid = 130;
+    test_association->gvcid_blk.vcid = 0;
+    test_association->sa_state = SA_OPERATIONAL;
+    test_association->arsn_len = 0;
+    test_association->ast = 1;
+    // A truncated MAC keeps the SA off the specialized profile path, which needs no AAD buffer
+    test_association->stmacf_len = 8;
+
+    Crypto_Arena_Reset_Stats();
+    for (i = 0; i < 4; i++)
+    {
+        return_val =
+            Crypto_TC_ApplySecurity((uint8_t* )raw_tc_sdls_ping_b, raw_tc_sdls_ping_len, &ptr_enc_frame, &enc_frame_len);
+        ASSERT_EQ(CRYPTO_LIB_SUCCESS, return_val);
+        free(ptr_enc_frame);
+        ptr_enc_frame = NULL;
+    }
+    Crypto_Shutdown();
+    free(raw_tc_sdls_ping_b);
+
+    // One AAD per frame, and the high-water mark stays at a single frame's worth
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_Arena_Get_Stats(&stats));
+    ASSERT_EQ((uint32_t)4, stats.allocations);
+    ASSERT_TRUE(stats.high_water > 0);
+    ASSERT_TRUE(stats.high_water < 64);
+    ASSERT_EQ((uint32_t)0, stats.exhausted);
+}
+
+#define UT_COUNTER_THREADS 4
+#define UT_COUNTER_FRAMES 64
+#define UT_COUNTER_FRAME_SIZE 128
+#define UT_COUNTER_IV_LEN 12
+#define UT_COUNTER_IV_LOC 8 // TC header, segment header, SPI
+
+typedef struct
+{
+    uint8_t frame[UT_COUNTER_FRAME_SIZE];
+    int frame_len;
+} ut_counter_frame_t;
+
+typedef struct
+{
+    char* frame;
+    int frame_len;
+    ut_counter_frame_t sent[UT_COUNTER_FRAMES];
+    int failures;
+} ut_counter_producer_t;
+
+/**
+ * @brief Function: ut_counter_producer
+ * Applies security on the shared SA from its own thread and keeps every frame it built
+ **/
+static void* ut_counter_producer(void* arg)
+{
+    ut_counter_producer_t* producer = (ut_counter_producer_t*)arg;
+    uint8_t* ptr_enc_frame = NULL;
+    uint16_t enc_frame_len = 0;
+    int i;
+
+    for (i = 0; i < UT_COUNTER_FRAMES; i++)
+    {
+        if ((Crypto_TC_ApplySecurity((uint8_t*)producer->frame, producer->frame_len, &ptr_enc_frame, &enc_frame_len) !=
+             CRYPTO_LIB_SUCCESS) || (enc_frame_len > UT_COUNTER_FRAME_SIZE))
+        {
+            producer->failures++;
+            free(ptr_enc_frame);
+            ptr_enc_frame = NULL;
+            continue;
+        }
+        memcpy(producer->sent[i].frame, ptr_enc_frame, enc_frame_len);
+        producer->sent[i].frame_len = enc_frame_len;
+        free(ptr_enc_frame);
+        ptr_enc_frame = NULL;
+    }
+    Crypto_SA_Counters_Release();
+    return NULL;
+}
+
+static int ut_counter_frame_compare(const void* a, const void* b)
+{
+    return memcmp(((const ut_counter_frame_t*)a)->frame + UT_COUNTER_IV_LOC,
+                  ((const ut_counter_frame_t*)b)->frame + UT_COUNTER_IV_LOC, UT_COUNTER_IV_LEN);
+}
+
+/**
+ * @brief Function: ut_counter_receiver_reset
+ * Points the SA, which doubles as the receiving end, at the value just before the first frame sent
+ **/
+static void ut_counter_receiver_reset(SecurityAssociation_t* sa_ptr, const uint8_t* first_iv)
+{
+    int i;
+
+    memcpy(sa_ptr->iv, first_iv, UT_COUNTER_IV_LEN);
+    for (i = UT_COUNTER_IV_LEN - 1; i >= 0; i--)
+    {
+        if (sa_ptr->iv[i]-- != 0)
+        {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Function: ut_counter_setup_sa
+ * Sets up SA 4 as an AES-GCM SA with a window of five, clearing what earlier tests left in the in-memory SADB
+ **/
+static SecurityAssociation_t* ut_counter_setup_sa(uint8_t stmacf_len)
+{
+    SaInterface sa_if = get_sa_interface_inmemory();
+    SecurityAssociation_t* test_association;
+
+    sa_if->sa_get_from_spi(1, &test_association);
+    test_association->sa_state = SA_NONE;
+    sa_if->sa_get_from_spi(4, &test_association);
+    test_association->ekid = 130;
+    test_association->gvcid_blk.vcid = 0;
+    test_association->sa_state = SA_OPERATIONAL;
+    test_association->est = 1;
+    test_association->ast = 1;
+    test_association->ecs_len = 1;
+    test_association->ecs = CRYPTO_CIPHER_AES256_GCM;
+    test_association->acs_len = 0;
+    test_association->acs = CRYPTO_MAC_NONE;
+    test_association->shivf_len = UT_COUNTER_IV_LEN;
+    test_association->iv_len = UT_COUNTER_IV_LEN;
+    test_association->shsnf_len = 0;
+    test_association->arsn_len = 0;
+    test_association->shplf_len = 0;
+    test_association->arsnw = 5;
+    test_association->stmacf_len = stmacf_len;
+    return test_association;
+}
+
+/**
+ * @brief Function: ut_counter_init
+ * Crypto_Init_TC_Unit_Test on the given cryptography module
+ **/
+static int32_t ut_counter_init(uint8_t cryptography_type)
+{
+    Crypto_Config_CryptoLib(KEY_TYPE_INTERNAL, MC_TYPE_INTERNAL, SA_TYPE_INMEMORY, cryptography_type, IV_INTERNAL,
+                            CRYPTO_TC_CREATE_FECF_TRUE, TC_PROCESS_SDLS_PDUS_TRUE, TC_HAS_PUS_HDR,
+                            TC_IGNORE_SA_STATE_FALSE, TC_IGNORE_ANTI_REPLAY_FALSE, TC_UNIQUE_SA_PER_MAP_ID_FALSE,
+                            TC_CHECK_FECF_TRUE, 0x3F, SA_INCREMENT_NONTRANSMITTED_IV_TRUE);
+    GvcidManagedParameters_t TC_UT_Managed_Parameters = {0, 0x0003, 0, TC_HAS_FECF, AOS_FHEC_NA, AOS_IZ_NA, 0, TC_HAS_SEGMENT_HDRS, 1024, TC_OCF_NA, 1};
+    Crypto_Config_Add_Gvcid_Managed_Parameters(TC_UT_Managed_Parameters);
+    TC_UT_Managed_Parameters.vcid = 1;
+    Crypto_Config_Add_Gvcid_Managed_Parameters(TC_UT_Managed_Parameters);
+    TC_UT_Managed_Parameters.vcid = 4;
+    Crypto_Config_Add_Gvcid_Managed_Parameters(TC_UT_Managed_Parameters);
+    return Crypto_Init();
+}
+
+/**
+ * @brief Unit Test: Concurrent ApplySecurity on one SA
+ * Producer threads share an AES-GCM SA, once reserving one IV per frame through the generic path and once in
+ * blocks through the specialized profile.  No IV may be used twice, and the interleaved frames of all producers,
+ * put back in counter order, must all pass ProcessSecurity on an SA whose anti-replay window is smaller than the
+ * requested block.  Both rounds run again on OpenSSL when it is built, whose cached contexts the producers contend for.
+ **/
+UTEST(TC_APPLY_SECURITY, CONCURRENT_FRAMES_ACCEPTED)
+{
+    remove("sa_save_file.bin");
+    static ut_counter_producer_t producers[UT_COUNTER_THREADS];
+    static ut_counter_frame_t frames[UT_COUNTER_THREADS * UT_COUNTER_FRAMES];
+    pthread_t threads[UT_COUNTER_THREADS];
+    char* raw_tc_sdls_ping_h = "20030015000080d2c70008197f0b00310000b1fe3128";
+    char* raw_tc_sdls_ping_b = NULL;
+    int raw_tc_sdls_ping_len = 0;
+    uint8_t first_iv[UT_COUNTER_IV_LEN];
+    uint8_t expected_iv[UT_COUNTER_IV_LEN];
+    uint64_t gaps;
+    uint64_t expected_gaps;
+    uint64_t n;
+    int round;
+    int i;
+
+    hex_conversion(raw_tc_sdls_ping_h, &raw_tc_sdls_ping_b, &raw_tc_sdls_ping_len);
+    TC_t* tc_processed_frame = malloc(sizeof(uint8_t) * TC_SIZE);
+
+    for (round = 0; round < 4; round++)
+    {
+        if ((round >= 2) && (get_cryptography_interface_openssl() == NULL))
+        {
+            break;
+        }
+        ASSERT_EQ(CRYPTO_LIB_SUCCESS, ut_counter_init((round < 2) ? CRYPTOGRAPHY_TYPE_LIBGCRYPT : CRYPTOGRAPHY_TYPE_OPENSSL));
+        // A truncated MAC keeps the SA on the generic path
+        SecurityAssociation_t* test_association = ut_counter_setup_sa(((round % 2) == 0) ? 8 : 16);
+        if ((round % 2) == 0)
+        {
+            ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_SA_Counters_Set_Block(1));
+            expected_gaps = 0;
+        }
+        else
+        {
+            // Cut down to arsnw, each producer leaves the rest of its last block unsent
+            ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_SA_Counters_Set_Block(SA_COUNTER_BLOCK_MAX));
+            expected_gaps = UT_COUNTER_THREADS * (test_association->arsnw - (UT_COUNTER_FRAMES % test_association->arsnw));
+        }
+        memcpy(first_iv, test_association->iv, UT_COUNTER_IV_LEN);
+        gaps = Crypto_SA_Counters_Get_Gaps(4);
+
+        for (i = 0; i < UT_COUNTER_THREADS; i++)
+        {
+            memset(&producers[i], 0, sizeof(ut_counter_producer_t));
+            producers[i].frame = raw_tc_sdls_ping_b;
+            producers[i].frame_len = raw_tc_sdls_ping_len;
+            ASSERT_EQ(0, pthread_create(&threads[i], NULL, ut_counter_producer, &producers[i]));
+        }
+        for (i = 0; i < UT_COUNTER_THREADS; i++)
+        {
+            ASSERT_EQ(0, pthread_join(threads[i], NULL));
+            ASSERT_EQ(0, producers[i].failures);
+            memcpy(&frames[i * UT_COUNTER_FRAMES], producers[i].sent, sizeof(producers[i].sent));
+        }
+
+        qsort(frames, UT_COUNTER_THREADS * UT_COUNTER_FRAMES, sizeof(ut_counter_frame_t), ut_counter_frame_compare);
+        for (i = 1; i < UT_COUNTER_THREADS * UT_COUNTER_FRAMES; i++)
+        {
+            ASSERT_NE(0, ut_counter_frame_compare(&frames[i - 1], &frames[i]));
+        }
+        ASSERT_EQ(0, memcmp(frames[0].frame + UT_COUNTER_IV_LOC, first_iv, UT_COUNTER_IV_LEN));
+
+        // The SA moved on by the frames sent plus the values left in released blocks
+        ASSERT_EQ(gaps + expected_gaps, Crypto_SA_Counters_Get_Gaps(4));
+        memcpy(expected_iv, first_iv, UT_COUNTER_IV_LEN);
+        for (n = 0; n < (UT_COUNTER_THREADS * UT_COUNTER_FRAMES) + expected_gaps; n++)
+        {
+            Crypto_increment(expected_iv, UT_COUNTER_IV_LEN);
+        }
+        ASSERT_EQ(0, memcmp(test_association->iv, expected_iv, UT_COUNTER_IV_LEN));
+
+        // Every frame is accepted, gaps left by released blocks stay within the window
+        ut_counter_receiver_reset(test_association, first_iv);
+        for (i = 0; i < UT_COUNTER_THREADS * UT_COUNTER_FRAMES; i++)
+        {
+            ASSERT_EQ(CRYPTO_LIB_SUCCESS,
+                      Crypto_TC_ProcessSecurity(frames[i].frame, &frames[i].frame_len, tc_processed_frame));
+        }
+        ASSERT_EQ(0, memcmp(test_association->iv, frames[(UT_COUNTER_THREADS * UT_COUNTER_FRAMES) - 1].frame + UT_COUNTER_IV_LOC,
+                            UT_COUNTER_IV_LEN));
+        Crypto_Shutdown();
+    }
+    Crypto_SA_Counters_Set_Block(SA_COUNTER_BLOCK_DEFAULT);
+    free(tc_processed_frame);
+    free(raw_tc_sdls_ping_b);
+}
+
+/**
+ * @brief Unit Test: Counter blocks
+ * A block is taken out of the SA in one step and is never larger than the SA's anti-replay window.  Values left
+ * unsent by a release or flush are reported as gaps, and the frames sent around them are still accepted.
+ **/
+UTEST(TC_APPLY_SECURITY, COUNTER_BLOCK_GAPS)
+{
+    remove("sa_save_file.bin");
+    Crypto_Init_TC_Unit_Test();
+    char* raw_tc_sdls_ping_h = "20030015000080d2c70008197f0b00310000b1fe3128";
+    char* raw_tc_sdls_ping_b = NULL;
+    int raw_tc_sdls_ping_len = 0;
+    uint8_t* ptr_enc_frame = NULL;
+    uint16_t enc_frame_len = 0;
+    uint8_t first_iv[UT_COUNTER_IV_LEN];
+    ut_counter_frame_t frames[4];
+    ut_counter_frame_t replay;
+    uint64_t gaps;
+    int i;
+
+    hex_conversion(raw_tc_sdls_ping_h, &raw_tc_sdls_ping_b, &raw_tc_sdls_ping_len);
+    TC_t* tc_processed_frame = malloc(sizeof(uint8_t) * TC_SIZE);
+    SecurityAssociation_t* test_association = ut_counter_setup_sa(16);
+    memcpy(first_iv, test_association->iv, UT_COUNTER_IV_LEN);
+    gaps = Crypto_SA_Counters_Get_Gaps(4);
+
+    ASSERT_EQ(CRYPTO_LIB_ERR_SA_COUNTER_BLOCK, Crypto_SA_Counters_Set_Block(0));
+    ASSERT_EQ(CRYPTO_LIB_ERR_SA_COUNTER_BLOCK, Crypto_SA_Counters_Set_Block(SA_COUNTER_BLOCK_MAX + 1));
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_SA_Counters_Set_Block(SA_COUNTER_BLOCK_MAX));
+
+    for (i = 0; i < 4; i++)
+    {
+        if (i == 2)
+        {
+            // Releasing the block leaves three values unsent
+            Crypto_SA_Counters_Release();
+            ASSERT_EQ(gaps + 3, Crypto_SA_Counters_Get_Gaps(4));
+        }
+        if (i == 3)
+        {
+            // A flushed SA drops the rest of the block on the next frame
+            Crypto_Flush_SA(4);
+        }
+        ASSERT_EQ(CRYPTO_LIB_SUCCESS,
+                  Crypto_TC_ApplySecurity((uint8_t*)raw_tc_sdls_ping_b, raw_tc_sdls_ping_len, &ptr_enc_frame, &enc_frame_len));
+        memcpy(frames[i].frame, ptr_enc_frame, enc_frame_len);
+        frames[i].frame_len = enc_frame_len;
+        free(ptr_enc_frame);
+        ptr_enc_frame = NULL;
+        if (i == 0)
+        {
+            // The block is cut down to the window, the SA is past all five values
+            ASSERT_EQ(first_iv[UT_COUNTER_IV_LEN - 1] + 5, test_association->iv[UT_COUNTER_IV_LEN - 1]);
+        }
+    }
+    ASSERT_EQ(first_iv[UT_COUNTER_IV_LEN - 1], frames[0].frame[UT_COUNTER_IV_LOC + UT_COUNTER_IV_LEN - 1]);
+    ASSERT_EQ(first_iv[UT_COUNTER_IV_LEN - 1] + 1, frames[1].frame[UT_COUNTER_IV_LOC + UT_COUNTER_IV_LEN - 1]);
+    ASSERT_EQ(first_iv[UT_COUNTER_IV_LEN - 1] + 5, frames[2].frame[UT_COUNTER_IV_LOC + UT_COUNTER_IV_LEN - 1]);
+    ASSERT_EQ(first_iv[UT_COUNTER_IV_LEN - 1] + 10, frames[3].frame[UT_COUNTER_IV_LOC + UT_COUNTER_IV_LEN - 1]);
+    ASSERT_EQ(gaps + 7, Crypto_SA_Counters_Get_Gaps(4));
+    Crypto_SA_Counters_Release();
+    Crypto_SA_Counters_Set_Block(SA_COUNTER_BLOCK_DEFAULT);
+
+    // The largest jump, over a flushed block, is exactly the window; all four frames are accepted
+    replay = frames[1];
+    ut_counter_receiver_reset(test_association, first_iv);
+    for (i = 0; i < 4; i++)
+    {
+        ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_TC_ProcessSecurity(frames[i].frame, &frames[i].frame_len, tc_processed_frame));
+    }
+    ASSERT_EQ(CRYPTO_LIB_ERR_IV_OUTSIDE_WINDOW, Crypto_TC_ProcessSecurity(replay.frame, &replay.frame_len, tc_processed_frame));
+
+    Crypto_Shutdown();
+    free(tc_processed_frame);
+    free(raw_tc_sdls_ping_b);
+}
+
 UTEST_MAIN();
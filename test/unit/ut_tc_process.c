@@ -1096,4 +1096,249 @@ UTEST(TC_PROCESS, TC_SA_NOT_OPERATIONAL)
     Crypto_Shutdown();
 }
 
+/**
+ * @brief Frame descriptor offsets for a segmented TC frame with IV and pad length fields
+ **/
+UTEST(TC_PROCESS, FRAME_DESCRIPTOR_OFFSETS)
+{
+    remove("sa_save_file.bin");
+    Crypto_Config_CryptoLib(KEY_TYPE_INTERNAL, MC_TYPE_INTERNAL, SA_TYPE_INMEMORY, CRYPTOGRAPHY_TYPE_LIBGCRYPT,
+                            IV_INTERNAL, CRYPTO_TC_CREATE_FECF_TRUE, TC_PROCESS_SDLS_PDUS_TRUE, TC_HAS_PUS_HDR,
+                            TC_IGNORE_SA_STATE_FALSE, TC_IGNORE_ANTI_REPLAY_FALSE, TC_UNIQUE_SA_PER_MAP_ID_FALSE,
+                            TC_CHECK_FECF_TRUE, 0x3F, SA_INCREMENT_NONTRANSMITTED_IV_TRUE);
+    GvcidManagedParameters_t TC_UT_Managed_Parameters = {0, 0x0003, 0, TC_HAS_FECF, AOS_FHEC_NA, AOS_IZ_NA, 0, TC_HAS_SEGMENT_HDRS, 1024, TC_OCF_NA, 1};
+    Crypto_Config_Add_Gvcid_Managed_Parameters(TC_UT_Managed_Parameters);
+    Crypto_Init();
+    SaInterface sa_if = get_sa_interface_inmemory();
+    int32_t status = CRYPTO_LIB_SUCCESS;
+
+    char* test_frame_h = "2003002500FF0009B6AC8E4963F49207FFD6374C1224DFEFB72A20D49E09256908874979AD6F";
+    uint8_t* test_frame_b = NULL;
+    int test_frame_len = 0;
+    hex_conversion(test_frame_h, (char**) &test_frame_b, &test_frame_len);
+
+    TC_t* tc_processed_frame;
+    tc_processed_frame = malloc(sizeof(uint8_t) * TC_SIZE);
+    memset(tc_processed_frame, 0, (sizeof(uint8_t) * TC_SIZE));
+
+    SecurityAssociation_t* test_association;
+    sa_if->sa_get_from_spi(9, &test_association);
+    test_association->shivf_len = 12;
+    test_association->iv_len = 12;
+    test_association->shsnf_len = 0;
+    test_association->arsn_len = 0;
+    test_association->shplf_len = 1;
+    test_association->stmacf_len = 0;
+
+    crypto_frame_desc_t desc;
+    status = Crypto_TC_Decode_Frame(test_frame_b, test_frame_len, tc_processed_frame, &desc);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+    ASSERT_EQ(TYPE_TC, desc.frame_type);
+    ASSERT_EQ(0x0003, desc.scid);
+    ASSERT_EQ(0, desc.vcid);
+    ASSERT_EQ(0x3F, desc.map_id);
+    ASSERT_EQ(test_frame_len, desc.frame_len);
+    ASSERT_EQ(TC_SEGMENT_HDR_SIZE, desc.seg_hdr_len);
+    ASSERT_EQ(FECF_SIZE, desc.fecf_len);
+    ASSERT_EQ(6, desc.spi_loc);
+    ASSERT_EQ(9, desc.spi);
+    ASSERT_EQ(9, tc_processed_frame->tc_sec_header.spi);
+    ASSERT_EQ(0x25, tc_processed_frame->tc_header.fl);
+
+    status = Crypto_Frame_Desc_Set_SA(&desc, test_association);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+    ASSERT_EQ(8, desc.iv_loc);
+    ASSERT_EQ(20, desc.sn_loc);
+    ASSERT_EQ(20, desc.pl_loc);
+    ASSERT_EQ(21, desc.pdu_loc);
+    ASSERT_EQ(15, desc.pdu_len);
+    ASSERT_EQ(36, desc.mac_loc);
+    ASSERT_EQ(36, desc.fecf_loc);
+
+    // Security fields that no longer fit in the frame are rejected
+    test_association->stmacf_len = 16;
+    status = Crypto_Frame_Desc_Set_SA(&desc, test_association);
+    ASSERT_EQ(CRYPTO_LIB_ERR_INVALID_HEADER, status);
+
+    free(test_frame_b);
+    free(tc_processed_frame);
+    Crypto_Shutdown();
+}
+
+/**
+ * @brief Function: ut_tc_setup_gcm_sa
+ * Configures the GVCID and SA 9 of EXERCISE_IV, the next IV the SA expects is B6AC8E4963F49207FFD6374C
+ * @return SecurityAssociation_t*: SA 9
+ **/
+static SecurityAssociation_t* ut_tc_setup_gcm_sa(void)
+{
+    char* buffer_nist_key_h = "ef9f9284cf599eac3b119905a7d18851e7e374cf63aea04358586b0f757670f8";
+    char* buffer_nist_iv_h = "b6ac8e4963f49207ffd6374b";
+    uint8_t *buffer_nist_key_b, *buffer_nist_iv_b = NULL;
+    int buffer_nist_key_len, buffer_nist_iv_len = 0;
+    SecurityAssociation_t* test_association;
+    crypto_key_t* ekp = NULL;
+
+    remove("sa_save_file.bin");
+    Crypto_Config_CryptoLib(KEY_TYPE_INTERNAL, MC_TYPE_INTERNAL, SA_TYPE_INMEMORY, CRYPTOGRAPHY_TYPE_LIBGCRYPT,
+                            IV_INTERNAL, CRYPTO_TC_CREATE_FECF_TRUE, TC_PROCESS_SDLS_PDUS_TRUE, TC_HAS_PUS_HDR,
+                            TC_IGNORE_SA_STATE_FALSE, TC_IGNORE_ANTI_REPLAY_FALSE, TC_UNIQUE_SA_PER_MAP_ID_FALSE,
+                            TC_CHECK_FECF_TRUE, 0x3F, SA_INCREMENT_NONTRANSMITTED_IV_TRUE);
+    GvcidManagedParameters_t TC_UT_Managed_Parameters = {0, 0x0003, 0, TC_HAS_FECF, AOS_FHEC_NA, AOS_IZ_NA, 0, TC_HAS_SEGMENT_HDRS, 1024, TC_OCF_NA, 1};
+    Crypto_Config_Add_Gvcid_Managed_Parameters(TC_UT_Managed_Parameters);
+    Crypto_Init();
+    SaInterface sa_if = get_sa_interface_inmemory();
+
+    sa_if->sa_get_from_spi(1, &test_association);
+    test_association->sa_state = SA_NONE;
+    sa_if->sa_get_from_spi(9, &test_association);
+    test_association->sa_state = SA_OPERATIONAL;
+    test_association->est = 1;
+    test_association->ast = 0;
+    test_association->ekid = 136;
+    test_association->shivf_len = 12;
+    test_association->iv_len = 12;
+    test_association->ecs_len = 1;
+    test_association->shplf_len = 1;
+    test_association->arsnw_len = 1;
+    test_association->arsnw = 5;
+    test_association->arsn_len = 0;
+    test_association->shsnf_len = 0;
+    test_association->stmacf_len = 0;
+    test_association->abm_len = ABM_SIZE;
+    test_association->ecs = CRYPTO_CIPHER_AES256_GCM;
+
+    hex_conversion(buffer_nist_key_h, (char**) &buffer_nist_key_b, &buffer_nist_key_len);
+    ekp = key_if->get_key(test_association->ekid);
+    memcpy(ekp->value, buffer_nist_key_b, buffer_nist_key_len);
+    hex_conversion(buffer_nist_iv_h, (char**) &buffer_nist_iv_b, &buffer_nist_iv_len);
+    memcpy(test_association->iv, buffer_nist_iv_b, buffer_nist_iv_len);
+
+    free(buffer_nist_key_b);
+    free(buffer_nist_iv_b);
+    return test_association;
+}
+
+/**
+ * @brief Cheap checks reject bad frames before the MAC, and leave the SA untouched
+ * Test Cases: Wrong version, bad FECF, replayed IV with a bad FECF
+ **/
+UTEST(TC_PROCESS, EARLY_REJECT_ORDER)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    SecurityAssociation_t* test_association = ut_tc_setup_gcm_sa();
+    uint8_t sa_iv[IV_SIZE];
+
+    char* buffer_good_iv_h = "2003002500FF0009B6AC8E4963F49207FFD6374C1224DFEFB72A20D49E09256908874979AD6F";
+    char* buffer_replay_h = "2003002500FF0009B6AC8E4963F49207FFD6374B1224DFEFB72A20D49E09256908874979DFC1";
+    uint8_t *buffer_good_iv_b, *buffer_replay_b = NULL;
+    int buffer_good_iv_len, buffer_replay_len = 0;
+    hex_conversion(buffer_good_iv_h, (char**) &buffer_good_iv_b, &buffer_good_iv_len);
+    hex_conversion(buffer_replay_h, (char**) &buffer_replay_b, &buffer_replay_len);
+
+    TC_t* tc_processed_frame;
+    tc_processed_frame = malloc(sizeof(uint8_t) * TC_SIZE);
+    memset(tc_processed_frame, 0, (sizeof(uint8_t) * TC_SIZE));
+    memcpy(sa_iv, test_association->iv, test_association->iv_len);
+
+    // Not a TC version 1 frame
+    buffer_good_iv_b[0] |= 0x40;
+    status = Crypto_TC_ProcessSecurity(buffer_good_iv_b, &buffer_good_iv_len, tc_processed_frame);
+    ASSERT_EQ(CRYPTO_LIB_ERR_INVALID_TFVN, status);
+    buffer_good_iv_b[0] &= 0x3F;
+
+    // A bad FECF is no longer passed on to the MAC check
+    buffer_good_iv_b[buffer_good_iv_len - 1] ^= 0xFF;
+    status = Crypto_TC_ProcessSecurity(buffer_good_iv_b, &buffer_good_iv_len, tc_processed_frame);
+    ASSERT_EQ(CRYPTO_LIB_ERR_INVALID_FECF, status);
+    buffer_good_iv_b[buffer_good_iv_len - 1] ^= 0xFF;
+
+    // The anti-replay window is checked ahead of the FECF
+    buffer_replay_b[buffer_replay_len - 1] ^= 0xFF;
+    status = Crypto_TC_ProcessSecurity(buffer_replay_b, &buffer_replay_len, tc_processed_frame);
+    ASSERT_EQ(CRYPTO_LIB_ERR_IV_OUTSIDE_WINDOW, status);
+    ASSERT_EQ(0, memcmp(sa_iv, test_association->iv, test_association->iv_len));
+
+    // The untouched frame is still accepted
+    status = Crypto_TC_ProcessSecurity(buffer_good_iv_b, &buffer_good_iv_len, tc_processed_frame);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+
+    free(buffer_good_iv_b);
+    free(buffer_replay_b);
+    free(tc_processed_frame);
+    Crypto_Shutdown();
+}
+
+/**
+ * @brief A GVCID sending more bad frames than its budget allows is shed, the SA it names only counts them
+ **/
+UTEST(TC_PROCESS, REJECT_BUDGET_SHEDS)
+{
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    crypto_reject_counters_t counters;
+
+    ut_tc_setup_gcm_sa();
+    ASSERT_EQ(CRYPTO_LIB_ERROR, Crypto_Config_Reject_Budget(2, 0, 60000));
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_Config_Reject_Budget(2, 1, 60000));
+
+    char* buffer_good_iv_h = "2003002500FF0009B6AC8E4963F49207FFD6374C1224DFEFB72A20D49E09256908874979AD6F";
+    uint8_t* buffer_good_iv_b = NULL;
+    int buffer_good_iv_len = 0;
+    hex_conversion(buffer_good_iv_h, (char**) &buffer_good_iv_b, &buffer_good_iv_len);
+
+    TC_t* tc_processed_frame;
+    tc_processed_frame = malloc(sizeof(uint8_t) * TC_SIZE);
+    memset(tc_processed_frame, 0, (sizeof(uint8_t) * TC_SIZE));
+
+    // Burst of two, the third bad frame starts the hold-off
+    buffer_good_iv_b[buffer_good_iv_len - 1] ^= 0xFF;
+    for (int i = 0; i < 3; i++)
+    {
+        status = Crypto_TC_ProcessSecurity(buffer_good_iv_b, &buffer_good_iv_len, tc_processed_frame);
+        ASSERT_EQ(CRYPTO_LIB_ERR_INVALID_FECF, status);
+    }
+    buffer_good_iv_b[buffer_good_iv_len - 1] ^= 0xFF;
+
+    // Even a good frame is dropped during the hold-off
+    status = Crypto_TC_ProcessSecurity(buffer_good_iv_b, &buffer_good_iv_len, tc_processed_frame);
+    ASSERT_EQ(CRYPTO_LIB_ERR_FRAME_SHED, status);
+
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_MC_Reject_Get_Gvcid_Counters(0, 0x0003, 0, &counters));
+    ASSERT_EQ((uint32_t)3, counters.rejected);
+    ASSERT_EQ((uint32_t)1, counters.holdoffs);
+    ASSERT_EQ((uint32_t)1, counters.shed);
+    // The SA ran out of its own budget too, the GVCID hold-off shed the good frame first
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_MC_Reject_Get_SA_Counters(9, &counters));
+    ASSERT_EQ((uint32_t)3, counters.rejected);
+    ASSERT_EQ((uint32_t)1, counters.holdoffs);
+    ASSERT_EQ((uint32_t)0, counters.shed);
+    ASSERT_EQ(CRYPTO_LIB_ERR_SPI_INDEX_OOB, Crypto_MC_Reject_Get_SA_Counters(NUM_SA, &counters));
+
+    // Frames rejected before their SA is located are counted but charged to neither budget
+    Crypto_MC_Reject_Reset();
+    buffer_good_iv_b[7] = 0x30;
+    for (int i = 0; i < 3; i++)
+    {
+        status = Crypto_TC_ProcessSecurity(buffer_good_iv_b, &buffer_good_iv_len, tc_processed_frame);
+        ASSERT_NE(CRYPTO_LIB_SUCCESS, status);
+        ASSERT_NE(CRYPTO_LIB_ERR_FRAME_SHED, status);
+    }
+    buffer_good_iv_b[7] = 0x09;
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_MC_Reject_Get_Gvcid_Counters(0, 0x0003, 0, &counters));
+    ASSERT_EQ((uint32_t)3, counters.rejected);
+    ASSERT_EQ((uint32_t)0, counters.holdoffs);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, Crypto_MC_Reject_Get_SA_Counters(0x30, &counters));
+    ASSERT_EQ((uint32_t)3, counters.rejected);
+    ASSERT_EQ((uint32_t)0, counters.holdoffs);
+
+    // Clearing the budgets lets the GVCID back in
+    Crypto_MC_Reject_Reset();
+    status = Crypto_TC_ProcessSecurity(buffer_good_iv_b, &buffer_good_iv_len, tc_processed_frame);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+
+    free(buffer_good_iv_b);
+    free(tc_processed_frame);
+    Crypto_Shutdown();
+}
+
 UTEST_MAIN();
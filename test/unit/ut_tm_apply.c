@@ -151,7 +151,7 @@ UTEST(TM_APPLY_SECURITY, HAPPY_PATH_CLEAR_FECF)
     ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
 
     // Now, byte by byte verify the static frame in memory is equivalent to what we started with
-    for(int i=0; i < current_managed_parameters_struct.max_frame_size; i++)
+    for(int i=0; i < current_managed_parameters->max_frame_size; i++)
     {
         // printf("Checking %02x against %02X\n", (uint8_t)framed_tm_b[i], (uint8_t)*(truth_tm_b + i));
         ASSERT_EQ((uint8_t)framed_tm_b[i], (uint8_t)*(truth_tm_b + i));
@@ -225,7 +225,7 @@ UTEST(TM_APPLY_SECURITY, HAPPY_PATH_CLEAR_FECF_LEFT_BLANK)
     ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
 
     // Now, byte by byte verify the static frame in memory is equivalent to what we started with
-    for(int i=0; i < current_managed_parameters_struct.max_frame_size; i++)
+    for(int i=0; i < current_managed_parameters->max_frame_size; i++)
     {
         // printf("Checking %02x against %02X\n", (uint8_t)framed_tm_b[i], (uint8_t)*(truth_tm_b + i));
         ASSERT_EQ((uint8_t)framed_tm_b[i], (uint8_t)*(truth_tm_b + i));
@@ -300,7 +300,7 @@ UTEST(TM_APPLY_SECURITY, SECONDARY_HDR_PRESENT_PLAINTEXT)
     ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
 
     // Now, byte by byte verify the static frame in memory is equivalent to what we started with
-    for(int i=0; i < current_managed_parameters_struct.max_frame_size; i++)
+    for(int i=0; i < current_managed_parameters->max_frame_size; i++)
     {
         // printf("Checking %02x against %02X\n", (uint8_t)framed_tm_b[i], (uint8_t)*(truth_tm_b + i));
         ASSERT_EQ((uint8_t)framed_tm_b[i], (uint8_t)*(truth_tm_b + i));
@@ -379,7 +379,7 @@ UTEST(TM_APPLY_SECURITY, SECONDARY_HDR_PRESENT_MAC)
     ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
 
     // Now, byte by byte verify the static frame in memory is equivalent to what we started with
-    for(int i=0; i < current_managed_parameters_struct.max_frame_size; i++)
+    for(int i=0; i < current_managed_parameters->max_frame_size; i++)
     {
         // printf("Checking %02x against %02X\n", (uint8_t)framed_tm_b[i], (uint8_t)*(truth_tm_b + i));
         ASSERT_EQ((uint8_t)framed_tm_b[i], (uint8_t)*(truth_tm_b + i));
@@ -468,7 +468,7 @@ UTEST(TM_APPLY_SECURITY, AES_CMAC_256_TEST_0)
     // 2) SPI is set correctly
     // 3) MAC is calculated and placed correctly
     // 4) FECF is re-calculated and updated
-    for (int i = 0; i < current_managed_parameters_struct.max_frame_size; i++)
+    for (int i = 0; i < current_managed_parameters->max_frame_size; i++)
     {
         printf("Index %d: Checking %02x against %02X\n", i, (uint8_t)framed_tm_b[i], (uint8_t)*(truth_tm_b + i));
         ASSERT_EQ((uint8_t)framed_tm_b[i], (uint8_t)*(truth_tm_b + i));
@@ -566,7 +566,7 @@ UTEST(TM_APPLY_SECURITY, AES_CMAC_256_TEST_1)
     // 2) SPI is set correctly
     // 3) MAC is calculated and placed correctly
     // 4) FECF is re-calculated and updated
-    for (int i = 0; i < current_managed_parameters_struct.max_frame_size; i++)
+    for (int i = 0; i < current_managed_parameters->max_frame_size; i++)
     {
         // printf("Index %d: Checking %02x against %02X\n", i, (uint8_t)framed_tm_b[i], (uint8_t)*(truth_tm_b + i));
         ASSERT_EQ((uint8_t)framed_tm_b[i], (uint8_t)*(truth_tm_b + i));
@@ -655,7 +655,7 @@ UTEST(TM_APPLY_ENC_VAL, AES_HMAC_SHA_256_TEST_0)
     // 2) SPI is set correctly
     // 3) MAC is calculated and placed correctly
     // 4) FECF is re-calculated and updated
-    for (int i = 0; i < current_managed_parameters_struct.max_frame_size; i++)
+    for (int i = 0; i < current_managed_parameters->max_frame_size; i++)
     {
         // printf("Index %d: Checking %02x against %02X\n", i, (uint8_t)framed_tm_b[i], (uint8_t)*(truth_tm_b + i));
         ASSERT_EQ((uint8_t)framed_tm_b[i], (uint8_t)*(truth_tm_b + i));
@@ -745,7 +745,7 @@ UTEST(TM_APPLY_ENC_VAL, AES_HMAC_SHA_256_TEST_1)
     // 2) SPI is set correctly
     // 3) MAC is calculated and placed correctly
     // 4) FECF is re-calculated and updated
-    for (int i = 0; i < current_managed_parameters_struct.max_frame_size; i++)
+    for (int i = 0; i < current_managed_parameters->max_frame_size; i++)
     {
         // printf("Index %d: Checking %02x against %02X\n", i, (uint8_t)framed_tm_b[i], (uint8_t)*(truth_tm_b + i));
         ASSERT_EQ((uint8_t)framed_tm_b[i], (uint8_t)*(truth_tm_b + i));
@@ -842,7 +842,7 @@ UTEST(TM_APPLY_ENC_VAL, AES_HMAC_SHA_512_TEST_0)
     // 2) SPI is set correctly
     // 3) MAC is calculated and placed correctly
     // 4) FECF is re-calculated and updated
-    for (int i = 0; i < current_managed_parameters_struct.max_frame_size; i++)
+    for (int i = 0; i < current_managed_parameters->max_frame_size; i++)
     {
         if (framed_tm_b[i] != truth_tm_b[i])
         {
@@ -940,7 +940,7 @@ UTEST(TM_APPLY_ENC_VAL, AES_HMAC_SHA_512_TEST_1)
     // 2) SPI is set correctly
     // 3) MAC is calculated and placed correctly
     // 4) FECF is re-calculated and updated
-    for (int i = 0; i < current_managed_parameters_struct.max_frame_size; i++)
+    for (int i = 0; i < current_managed_parameters->max_frame_size; i++)
     {
         // printf("Index %d: Checking %02x against %02X\n", i, (uint8_t)framed_tm_b[i], (uint8_t)*(truth_tm_b + i));
         ASSERT_EQ((uint8_t)framed_tm_b[i], (uint8_t)*(truth_tm_b + i));
@@ -323,7 +323,7 @@ UTEST(TM_PROCESS_SECURITY, SECONDARY_HDR_PRESENT_MAC)
     status = Crypto_TM_ProcessSecurity((uint8_t* )framed_tm_b, framed_tm_len, &ptr_processed_frame, &processed_tm_len);
     ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
     // Now, byte by byte verify the static frame in memory is equivalent to what we started with
-    for(int i=0; i < current_managed_parameters_struct.max_frame_size; i++)
+    for(int i=0; i < current_managed_parameters->max_frame_size; i++)
     {
         // printf("Checking %02x against %02X\n", ptr_processed_frame[i], (uint8_t)*(truth_tm_b + i));
         ASSERT_EQ(ptr_processed_frame[i], (uint8_t)*(truth_tm_b + i));
@@ -419,7 +419,7 @@ UTEST(TM_PROCESS_SECURITY, AES_CMAC_256_TEST_0)
     // 2) SPI is set correctly
     // 3) MAC is calculated and placed correctly
     // 4) FECF is re-calculated and updated
-    for (int i = 0; i < current_managed_parameters_struct.max_frame_size; i++)
+    for (int i = 0; i < current_managed_parameters->max_frame_size; i++)
     {
         // printf("Checking %02x against %02X\n", ptr_processed_frame[i], (uint8_t)*(truth_tm_b + i));
         ASSERT_EQ(ptr_processed_frame[i], (uint8_t)*(truth_tm_b + i));
@@ -518,7 +518,7 @@ UTEST(TM_PROCESS_SECURITY, AES_CMAC_256_TEST_1)
     // 2) SPI is zeroed
     // 3) MAC is zeroed
     // 4) FECF is zeroed
-    for (int i = 0; i < current_managed_parameters_struct.max_frame_size; i++)
+    for (int i = 0; i < current_managed_parameters->max_frame_size; i++)
     {
         // printf("Checking %02x against %02X\n", ptr_processed_frame[i], (uint8_t)*(truth_tm_b + i));
         ASSERT_EQ(ptr_processed_frame[i], (uint8_t)*(truth_tm_b + i));
@@ -615,7 +615,7 @@ UTEST(TM_PROCESS_ENC_VAL, AES_HMAC_SHA_256_TEST_0)
     // 2) SPI is set correctly
     // 3) MAC is calculated and placed correctly
     // 4) FECF is re-calculated and updated
-    for (int i = 0; i < current_managed_parameters_struct.max_frame_size; i++)
+    for (int i = 0; i < current_managed_parameters->max_frame_size; i++)
     {
         // printf("Checking %02x against %02X\n", ptr_processed_frame[i], (uint8_t)*(truth_tm_b + i));
         ASSERT_EQ(ptr_processed_frame[i], (uint8_t)*(truth_tm_b + i));
@@ -712,7 +712,7 @@ UTEST(TM_PROCESS_ENC_VAL, AES_HMAC_SHA_256_TEST_1)
     // 2) SPI is set correctly
     // 3) MAC is calculated and placed correctly
     // 4) FECF is re-calculated and updated
-    for (int i = 0; i < current_managed_parameters_struct.max_frame_size; i++)
+    for (int i = 0; i < current_managed_parameters->max_frame_size; i++)
     {
         // printf("Checking %02x against %02X\n", ptr_processed_frame[i], (uint8_t)*(truth_tm_b + i));
         ASSERT_EQ(ptr_processed_frame[i], (uint8_t)*(truth_tm_b + i));
@@ -815,7 +815,7 @@ UTEST(TM_PROCESS_ENC_VAL, AES_HMAC_SHA_512_TEST_0)
     // 2) SPI is set correctly
     // 3) MAC is calculated and placed correctly
     // 4) FECF is re-calculated and updated
-    for (int i = 0; i < current_managed_parameters_struct.max_frame_size; i++)
+    for (int i = 0; i < current_managed_parameters->max_frame_size; i++)
     {
         // printf("Checking %02x against %02X\n", ptr_processed_frame[i], (uint8_t)*(truth_tm_b + i));
         ASSERT_EQ(ptr_processed_frame[i], (uint8_t)*(truth_tm_b + i));
@@ -918,7 +918,7 @@ UTEST(TM_PROCESS_ENC_VAL, AES_HMAC_SHA_512_TEST_1)
     // 2) SPI is set correctly
     // 3) MAC is calculated and placed correctly
     // 4) FECF is re-calculated and updated
-    for (int i = 0; i < current_managed_parameters_struct.max_frame_size; i++)
+    for (int i = 0; i < current_managed_parameters->max_frame_size; i++)
     {
         // printf("Checking %02x against %02X\n", ptr_processed_frame[i], (uint8_t)*(truth_tm_b + i));
         ASSERT_EQ(ptr_processed_frame[i], (uint8_t)*(truth_tm_b + i));
@@ -1164,9 +1164,529 @@ UTEST(TM_PROCESS, TM_SA_SEGFAULT_TEST)
     status = Crypto_TM_ProcessSecurity((uint8_t* )framed_tm_b, framed_tm_len, &ptr_processed_frame, &processed_tm_len);
     ASSERT_EQ(CRYPTO_LIB_ERR_SPI_INDEX_OOB, status);
 
+    // Version is checked before the GVCID lookup
+    framed_tm_b[0] |= 0x40;
+    status = Crypto_TM_ProcessSecurity((uint8_t* )framed_tm_b, framed_tm_len, &ptr_processed_frame, &processed_tm_len);
+    ASSERT_EQ(CRYPTO_LIB_ERR_INVALID_TFVN, status);
+
     Crypto_Shutdown();
     free(framed_tm_b);
     free(ptr_processed_frame);
 }
 
+/**
+ * @brief Unit Test: Batch processing matches one thread
+ *
+ * Frames of one SA are decrypted on several threads while the anti-replay check and IV update are committed in
+ * arrival order.  A replayed frame and a frame with a corrupted tag are mixed in, per frame results and the final SA
+ * IV must match the single threaded run, the replayed frame must not return plaintext, and the decrypted frames must
+ * match Crypto_TM_ProcessSecurity.
+ **/
+UTEST(TM_PROCESS_SECURITY, BATCH_MATCHES_SERIAL)
+{
+    remove("sa_save_file.bin");
+    // Local Variables
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    uint8_t frames[6][1786];
+    uint8_t start_iv[16];
+    uint8_t* ptr_processed_frame = NULL;
+    uint16_t processed_tm_len;
+    crypto_tm_batch_job_t serial_jobs[7];
+    crypto_tm_batch_job_t parallel_jobs[7];
+    uint8_t serial_iv[16];
+    uint8_t* job_frames[7];
+    int i;
+    int j;
+
+    // Setup & Initialize CryptoLib
+    Crypto_Config_CryptoLib(KEY_TYPE_INTERNAL, MC_TYPE_INTERNAL, SA_TYPE_INMEMORY, CRYPTOGRAPHY_TYPE_LIBGCRYPT, 
+                            IV_INTERNAL, CRYPTO_TM_CREATE_FECF_TRUE, TC_PROCESS_SDLS_PDUS_TRUE, TC_HAS_PUS_HDR,
+                            TC_IGNORE_SA_STATE_FALSE, TC_IGNORE_ANTI_REPLAY_FALSE, TC_UNIQUE_SA_PER_MAP_ID_FALSE,
+                            TC_CHECK_FECF_TRUE, 0x3F, SA_INCREMENT_NONTRANSMITTED_IV_TRUE);
+    GvcidManagedParameters_t TM_UT_Managed_Parameters = {0, 0x002c, 0, TM_HAS_FECF, AOS_FHEC_NA, AOS_IZ_NA, 0, TM_SEGMENT_HDRS_NA, 1786, TM_NO_OCF, 1};
+    Crypto_Config_Add_Gvcid_Managed_Parameters(TM_UT_Managed_Parameters);
+    Crypto_Config_TM_Anti_Replay(TM_CHECK_ANTI_REPLAY_TRUE);
+    Crypto_Init();
+    SaInterface sa_if = get_sa_interface_inmemory();
+
+    // Expose/setup SAs for testing
+    SecurityAssociation_t* sa_ptr = NULL;
+    // Deactivate SA 1
+    sa_if->sa_get_from_spi(1, &sa_ptr);
+    sa_ptr->sa_state = SA_NONE;
+    // Activate SA 5
+    sa_if->sa_get_from_spi(5, &sa_ptr);
+    sa_ptr->gvcid_blk.scid = 44;
+    sa_ptr->gvcid_blk.vcid = 0;
+    sa_ptr->arsn_len = 0;
+    sa_ptr->shsnf_len = 0;
+    sa_ptr->arsnw = 5;
+    sa_ptr->abm_len = 1786;
+    memset(sa_ptr->abm, 0xFF, (sa_ptr->abm_len * sizeof(uint8_t))); // Bitmask
+    sa_ptr->sa_state = SA_OPERATIONAL;
+    sa_ptr->ast = 1;
+    sa_ptr->est = 1;
+    sa_ptr->ecs_len = 1;
+    sa_ptr->ecs = CRYPTO_CIPHER_AES256_GCM;
+    sa_ptr->acs_len = 1;
+    sa_ptr->acs = CRYPTO_MAC_NONE;
+    sa_ptr->iv_len = 16;
+    sa_ptr->shivf_len = 16;
+    sa_ptr->stmacf_len = 16;
+    // Frames carry IVs 1 through 6, the SA starts each run having last seen IV 0
+    memset(start_iv, 0, sizeof(start_iv));
+    memset(sa_ptr->iv, 0, 16);
+    sa_ptr->iv[15] = 1;
+
+    // Six consecutive frames, each takes the next IV
+    for (i = 0; i < 6; i++)
+    {
+        memset(frames[i], 0, sizeof(frames[i]));
+        frames[i][0] = 0x02;
+        frames[i][1] = 0xC0;
+        frames[i][4] = 0x18;
+        for (j = 24; j < 1768; j++)
+        {
+            frames[i][j] = (uint8_t)(i + j);
+        }
+        status = Crypto_TM_ApplySecurity(frames[i]);
+        ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+    }
+    // Corrupt the tag of the fifth frame and fix up its FECF
+    frames[4][1770] ^= 0x01;
+    uint16_t fecf = Crypto_Calc_FECF(frames[4], 1784);
+    frames[4][1784] = (uint8_t)(fecf >> 8);
+    frames[4][1785] = (uint8_t)(fecf & 0x00FF);
+
+    // Arrival order, frame 1 replayed after frame 2
+    job_frames[0] = frames[0];
+    job_frames[1] = frames[1];
+    job_frames[2] = frames[2];
+    job_frames[3] = frames[1];
+    job_frames[4] = frames[3];
+    job_frames[5] = frames[4];
+    job_frames[6] = frames[5];
+    for (i = 0; i < 7; i++)
+    {
+        serial_jobs[i].p_ingest = job_frames[i];
+        serial_jobs[i].len_ingest = 1786;
+        parallel_jobs[i] = serial_jobs[i];
+    }
+
+    // Single thread
+    memcpy(sa_ptr->iv, start_iv, 16);
+    status = Crypto_TM_ProcessSecurity_Batch(serial_jobs, 7, 1);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+    memcpy(serial_iv, sa_ptr->iv, 16);
+
+    // Four threads from the same starting IV
+    memcpy(sa_ptr->iv, start_iv, 16);
+    status = Crypto_TM_ProcessSecurity_Batch(parallel_jobs, 7, 4);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, serial_jobs[0].status);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, serial_jobs[2].status);
+    ASSERT_EQ(CRYPTO_LIB_ERR_IV_OUTSIDE_WINDOW, serial_jobs[3].status);
+    ASSERT_TRUE(serial_jobs[3].p_processed_frame == NULL);
+    ASSERT_TRUE(parallel_jobs[3].p_processed_frame == NULL);
+    ASSERT_NE(CRYPTO_LIB_SUCCESS, serial_jobs[5].status);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, serial_jobs[6].status);
+    for (i = 0; i < 16; i++)
+    {
+        ASSERT_EQ(frames[5][8 + i], sa_ptr->iv[i]);
+        ASSERT_EQ(serial_iv[i], sa_ptr->iv[i]);
+    }
+
+    // Frame by frame through ProcessSecurity from the same starting IV
+    memcpy(sa_ptr->iv, start_iv, 16);
+    for (i = 0; i < 7; i++)
+    {
+        ASSERT_EQ(serial_jobs[i].status, parallel_jobs[i].status);
+        ASSERT_EQ(serial_jobs[i].processed_length, parallel_jobs[i].processed_length);
+        ptr_processed_frame = NULL;
+        status = Crypto_TM_ProcessSecurity(job_frames[i], 1786, &ptr_processed_frame, &processed_tm_len);
+        ASSERT_EQ(serial_jobs[i].status, status);
+        if (serial_jobs[i].status == CRYPTO_LIB_SUCCESS)
+        {
+            ASSERT_EQ(0, memcmp(ptr_processed_frame, parallel_jobs[i].p_processed_frame, processed_tm_len));
+            ASSERT_EQ(0, memcmp(ptr_processed_frame, serial_jobs[i].p_processed_frame, processed_tm_len));
+        }
+        free(ptr_processed_frame);
+        free(serial_jobs[i].p_processed_frame);
+        free(parallel_jobs[i].p_processed_frame);
+    }
+    for (i = 0; i < 16; i++)
+    {
+        ASSERT_EQ(serial_iv[i], sa_ptr->iv[i]);
+    }
+
+    // Without TM anti-replay neither holds the replayed frame to the window nor advances the SA
+    Crypto_Config_TM_Anti_Replay(TM_CHECK_ANTI_REPLAY_FALSE);
+    memcpy(sa_ptr->iv, start_iv, 16);
+    status = Crypto_TM_ProcessSecurity_Batch(parallel_jobs, 7, 4);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, parallel_jobs[3].status);
+    ASSERT_EQ(0, memcmp(parallel_jobs[1].p_processed_frame, parallel_jobs[3].p_processed_frame, 1786));
+    ptr_processed_frame = NULL;
+    status = Crypto_TM_ProcessSecurity(job_frames[3], 1786, &ptr_processed_frame, &processed_tm_len);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+    free(ptr_processed_frame);
+    ASSERT_EQ(0, memcmp(start_iv, sa_ptr->iv, 16));
+    for (i = 0; i < 7; i++)
+    {
+        free(parallel_jobs[i].p_processed_frame);
+    }
+
+    Crypto_Shutdown();
+}
+
+UTEST(TM_PROCESS_SECURITY, VERIFY_ONLY)
+{
+    remove("sa_save_file.bin");
+    // Local Variables
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    uint8_t frames[3][1786];
+    uint8_t copy[1786];
+    int i;
+    int j;
+
+    // Setup & Initialize CryptoLib
+    Crypto_Config_CryptoLib(KEY_TYPE_INTERNAL, MC_TYPE_INTERNAL, SA_TYPE_INMEMORY, CRYPTOGRAPHY_TYPE_LIBGCRYPT, 
+                            IV_INTERNAL, CRYPTO_TM_CREATE_FECF_TRUE, TC_PROCESS_SDLS_PDUS_TRUE, TC_HAS_PUS_HDR,
+                            TC_IGNORE_SA_STATE_FALSE, TC_IGNORE_ANTI_REPLAY_FALSE, TC_UNIQUE_SA_PER_MAP_ID_FALSE,
+                            TC_CHECK_FECF_TRUE, 0x3F, SA_INCREMENT_NONTRANSMITTED_IV_TRUE);
+    GvcidManagedParameters_t TM_UT_Managed_Parameters = {0, 0x002c, 0, TM_HAS_FECF, AOS_FHEC_NA, AOS_IZ_NA, 0, TM_SEGMENT_HDRS_NA, 1786, TM_NO_OCF, 1};
+    Crypto_Config_Add_Gvcid_Managed_Parameters(TM_UT_Managed_Parameters);
+    Crypto_Init();
+    SaInterface sa_if = get_sa_interface_inmemory();
+
+    // Expose/setup SAs for testing
+    SecurityAssociation_t* sa_ptr = NULL;
+    // Deactivate SA 1
+    sa_if->sa_get_from_spi(1, &sa_ptr);
+    sa_ptr->sa_state = SA_NONE;
+    // Activate SA 5
+    sa_if->sa_get_from_spi(5, &sa_ptr);
+    sa_ptr->gvcid_blk.scid = 44;
+    sa_ptr->gvcid_blk.vcid = 0;
+    sa_ptr->arsn_len = 0;
+    sa_ptr->shsnf_len = 0;
+    sa_ptr->arsnw = 5;
+    sa_ptr->abm_len = 1786;
+    memset(sa_ptr->abm, 0xFF, (sa_ptr->abm_len * sizeof(uint8_t))); // Bitmask
+    sa_ptr->sa_state = SA_OPERATIONAL;
+    sa_ptr->ast = 1;
+    sa_ptr->est = 1;
+    sa_ptr->ecs_len = 1;
+    sa_ptr->ecs = CRYPTO_CIPHER_AES256_GCM;
+    sa_ptr->acs_len = 1;
+    sa_ptr->acs = CRYPTO_MAC_NONE;
+    sa_ptr->iv_len = 16;
+    sa_ptr->shivf_len = 16;
+    sa_ptr->stmacf_len = 16;
+    memset(sa_ptr->iv, 0, 16);
+    sa_ptr->iv[15] = 1;
+
+    // Frame 0 and 1 encrypted, frame 2 authenticated only (CMAC)
+    for (i = 0; i < 3; i++)
+    {
+        memset(frames[i], 0, sizeof(frames[i]));
+        frames[i][0] = 0x02;
+        frames[i][1] = 0xC0;
+        frames[i][4] = 0x18;
+        for (j = 24; j < 1768; j++)
+        {
+            frames[i][j] = (uint8_t)(i + j);
+        }
+        if (i == 2)
+        {
+            sa_ptr->est = 0;
+            sa_ptr->ecs = CRYPTO_CIPHER_NONE;
+            sa_ptr->acs = CRYPTO_MAC_CMAC_AES256;
+            sa_ptr->akid = 136;
+            sa_ptr->iv_len = 0;
+            sa_ptr->shivf_len = 0;
+        }
+        status = Crypto_TM_ApplySecurity(frames[i]);
+        ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+    }
+    sa_ptr->est = 1;
+    sa_ptr->ecs = CRYPTO_CIPHER_AES256_GCM;
+    sa_ptr->acs = CRYPTO_MAC_NONE;
+    sa_ptr->iv_len = 16;
+    sa_ptr->shivf_len = 16;
+    memset(sa_ptr->iv, 0, 16);
+
+    // Good frame is accepted, left untouched, and advances the SA
+    memcpy(copy, frames[0], 1786);
+    status = Crypto_TM_VerifySecurity(frames[0], 1786);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+    ASSERT_EQ(0, memcmp(copy, frames[0], 1786));
+    ASSERT_EQ(1, sa_ptr->iv[15]);
+
+    // Replay is rejected
+    status = Crypto_TM_VerifySecurity(frames[0], 1786);
+    ASSERT_EQ(CRYPTO_LIB_ERR_IV_OUTSIDE_WINDOW, status);
+
+    // Bad tag is rejected and does not advance the SA
+    memcpy(copy, frames[1], 1786);
+    copy[1770] ^= 0x01;
+    uint16_t fecf = Crypto_Calc_FECF(copy, 1784);
+    copy[1784] = (uint8_t)(fecf >> 8);
+    copy[1785] = (uint8_t)(fecf & 0x00FF);
+    status = Crypto_TM_VerifySecurity(copy, 1786);
+    ASSERT_NE(CRYPTO_LIB_SUCCESS, status);
+    ASSERT_EQ(1, sa_ptr->iv[15]);
+
+    status = Crypto_TM_VerifySecurity(frames[1], 1786);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+    ASSERT_EQ(2, sa_ptr->iv[15]);
+
+    // CMAC frame without IV, checked through the MAC validate path
+    sa_ptr->est = 0;
+    sa_ptr->ecs = CRYPTO_CIPHER_NONE;
+    sa_ptr->acs = CRYPTO_MAC_CMAC_AES256;
+    sa_ptr->iv_len = 0;
+    sa_ptr->shivf_len = 0;
+    memcpy(copy, frames[2], 1786);
+    copy[100] ^= 0x01;
+    fecf = Crypto_Calc_FECF(copy, 1784);
+    copy[1784] = (uint8_t)(fecf >> 8);
+    copy[1785] = (uint8_t)(fecf & 0x00FF);
+    status = Crypto_TM_VerifySecurity(copy, 1786);
+    ASSERT_NE(CRYPTO_LIB_SUCCESS, status);
+    status = Crypto_TM_VerifySecurity(frames[2], 1786);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+
+    Crypto_Shutdown();
+}
+
+/**
+ * @brief Function: ut_tm_idle_init
+ * Initializes CryptoLib for SCID 44 VCID 0 with the given idle frame handling and an AES-GCM SA on SPI 5, IV 0
+ * @param idle_vc: uint8_t
+ * @param idle_policy: uint8_t
+ * @return SecurityAssociation_t*: SA 5
+ **/
+static SecurityAssociation_t* ut_tm_idle_init(uint8_t idle_vc, uint8_t idle_policy)
+{
+    SecurityAssociation_t* sa_ptr = NULL;
+
+    Crypto_Config_CryptoLib(KEY_TYPE_INTERNAL, MC_TYPE_INTERNAL, SA_TYPE_INMEMORY, CRYPTOGRAPHY_TYPE_LIBGCRYPT, 
+                            IV_INTERNAL, CRYPTO_TM_CREATE_FECF_TRUE, TC_PROCESS_SDLS_PDUS_TRUE, TC_HAS_PUS_HDR,
+                            TC_IGNORE_SA_STATE_FALSE, TC_IGNORE_ANTI_REPLAY_FALSE, TC_UNIQUE_SA_PER_MAP_ID_FALSE,
+                            TC_CHECK_FECF_TRUE, 0x3F, SA_INCREMENT_NONTRANSMITTED_IV_TRUE);
+    GvcidManagedParameters_t TM_UT_Managed_Parameters = {0, 0x002c, 0, TM_HAS_FECF, AOS_FHEC_NA, AOS_IZ_NA, 0, TM_SEGMENT_HDRS_NA, 1786, TM_NO_OCF, 1};
+    Crypto_Config_Add_Gvcid_Managed_Parameters(TM_UT_Managed_Parameters);
+    Crypto_Config_Gvcid_Idle_Frames(0, 0x002c, 0, idle_vc, idle_policy);
+    Crypto_Init();
+    SaInterface sa_if = get_sa_interface_inmemory();
+
+    // Deactivate SA 1
+    sa_if->sa_get_from_spi(1, &sa_ptr);
+    sa_ptr->sa_state = SA_NONE;
+    // Activate SA 5
+    sa_if->sa_get_from_spi(5, &sa_ptr);
+    sa_ptr->gvcid_blk.scid = 44;
+    sa_ptr->gvcid_blk.vcid = 0;
+    sa_ptr->arsn_len = 0;
+    sa_ptr->shsnf_len = 0;
+    sa_ptr->arsnw = 5;
+    sa_ptr->abm_len = 1786;
+    memset(sa_ptr->abm, 0xFF, (sa_ptr->abm_len * sizeof(uint8_t))); // Bitmask
+    sa_ptr->sa_state = SA_OPERATIONAL;
+    sa_ptr->ast = 1;
+    sa_ptr->est = 1;
+    sa_ptr->ecs_len = 1;
+    sa_ptr->ecs = CRYPTO_CIPHER_AES256_GCM;
+    sa_ptr->acs_len = 1;
+    sa_ptr->acs = CRYPTO_MAC_NONE;
+    sa_ptr->iv_len = 16;
+    sa_ptr->shivf_len = 16;
+    sa_ptr->stmacf_len = 16;
+    memset(sa_ptr->iv, 0, 16);
+    return sa_ptr;
+}
+
+UTEST(TM_PROCESS_SECURITY, IDLE_FRAME_POLICY)
+{
+    remove("sa_save_file.bin");
+    // Local Variables
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    uint8_t frames[3][1786];
+    uint8_t copy[1786];
+    uint8_t* ptr_processed_frame = NULL;
+    uint16_t processed_tm_len;
+    crypto_tm_batch_job_t jobs[2];
+    SecurityAssociation_t* sa_ptr = NULL;
+    uint16_t fecf;
+    int i;
+    int j;
+
+    sa_ptr = ut_tm_idle_init(IDLE_VC_FALSE, IDLE_FRAMES_PROCESS);
+    sa_ptr->iv[15] = 1;
+
+    // Frames 0 and 2 only carry idle data (first header pointer 0x7FE), frame 1 carries packets
+    for (i = 0; i < 3; i++)
+    {
+        memset(frames[i], 0, sizeof(frames[i]));
+        frames[i][0] = 0x02;
+        frames[i][1] = 0xC0;
+        frames[i][4] = (i == 1) ? 0x18 : 0x07;
+        frames[i][5] = (i == 1) ? 0x00 : 0xFE;
+        for (j = 24; j < 1768; j++)
+        {
+            frames[i][j] = (uint8_t)(i + j);
+        }
+        status = Crypto_TM_ApplySecurity(frames[i]);
+        ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+    }
+
+    // Idle frames are processed like any other by default
+    memset(sa_ptr->iv, 0, 16);
+    status = Crypto_TM_ProcessSecurity(frames[0], 1786, &ptr_processed_frame, &processed_tm_len);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+    free(ptr_processed_frame);
+    ptr_processed_frame = NULL;
+    Crypto_Shutdown();
+
+    // Skipped idle frames never reach the SA lookup, even with an unknown SPI
+    sa_ptr = ut_tm_idle_init(IDLE_VC_FALSE, IDLE_FRAMES_SKIP);
+    memcpy(copy, frames[0], 1786);
+    copy[6] = 0xFF;
+    copy[7] = 0xFF;
+    status = Crypto_TM_ProcessSecurity(copy, 1786, &ptr_processed_frame, &processed_tm_len);
+    ASSERT_EQ(CRYPTO_LIB_ERR_IDLE_FRAME, status);
+    ASSERT_TRUE(ptr_processed_frame == NULL);
+    status = Crypto_TM_ProcessSecurity(frames[1], 1786, &ptr_processed_frame, &processed_tm_len);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+    free(ptr_processed_frame);
+    ptr_processed_frame = NULL;
+    Crypto_Shutdown();
+
+    // Verified idle frames are authenticated and replay checked, nothing is handed back
+    sa_ptr = ut_tm_idle_init(IDLE_VC_FALSE, IDLE_FRAMES_VERIFY);
+    Crypto_Config_TM_Anti_Replay(TM_CHECK_ANTI_REPLAY_TRUE);
+    jobs[0].p_ingest = frames[0];
+    jobs[0].len_ingest = 1786;
+    jobs[1].p_ingest = frames[1];
+    jobs[1].len_ingest = 1786;
+    status = Crypto_TM_ProcessSecurity_Batch(jobs, 2, 1);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+    ASSERT_EQ(CRYPTO_LIB_ERR_IDLE_FRAME, jobs[0].status);
+    ASSERT_TRUE(jobs[0].p_processed_frame == NULL);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, jobs[1].status);
+    ASSERT_EQ(2, sa_ptr->iv[15]);
+    free(jobs[1].p_processed_frame);
+
+    memcpy(copy, frames[2], 1786);
+    copy[1770] ^= 0x01;
+    fecf = Crypto_Calc_FECF(copy, 1784);
+    copy[1784] = (uint8_t)(fecf >> 8);
+    copy[1785] = (uint8_t)(fecf & 0x00FF);
+    status = Crypto_TM_ProcessSecurity(copy, 1786, &ptr_processed_frame, &processed_tm_len);
+    ASSERT_NE(CRYPTO_LIB_SUCCESS, status);
+    ASSERT_NE(CRYPTO_LIB_ERR_IDLE_FRAME, status);
+    ASSERT_EQ(2, sa_ptr->iv[15]);
+    status = Crypto_TM_ProcessSecurity(frames[2], 1786, &ptr_processed_frame, &processed_tm_len);
+    ASSERT_EQ(CRYPTO_LIB_ERR_IDLE_FRAME, status);
+    ASSERT_TRUE(ptr_processed_frame == NULL);
+    ASSERT_EQ(3, sa_ptr->iv[15]);
+    status = Crypto_TM_ProcessSecurity(frames[2], 1786, &ptr_processed_frame, &processed_tm_len);
+    ASSERT_EQ(CRYPTO_LIB_ERR_IV_OUTSIDE_WINDOW, status);
+    Crypto_Shutdown();
+
+    // An idle virtual channel makes every frame on it idle fill
+    sa_ptr = ut_tm_idle_init(IDLE_VC_TRUE, IDLE_FRAMES_SKIP);
+    status = Crypto_TM_ProcessSecurity(frames[1], 1786, &ptr_processed_frame, &processed_tm_len);
+    ASSERT_EQ(CRYPTO_LIB_ERR_IDLE_FRAME, status);
+    ASSERT_TRUE(ptr_processed_frame == NULL);
+
+    Crypto_Shutdown();
+}
+
+/**
+ * @brief Unit Test: Batches spanning several windows
+ * Windows are set up while the one before them decrypts on the worker pool, commits still follow arrival order
+ **/
+UTEST(TM_PROCESS_SECURITY, BATCH_PIPELINED_WINDOWS)
+{
+    remove("sa_save_file.bin");
+    // Local Variables
+    int32_t status = CRYPTO_LIB_SUCCESS;
+    uint32_t num_frames = (2 * TM_BATCH_WINDOW) + 12;
+    uint32_t num_jobs = num_frames + 1;
+    uint8_t* frames = NULL;
+    crypto_tm_batch_job_t* serial_jobs = NULL;
+    crypto_tm_batch_job_t* parallel_jobs = NULL;
+    uint8_t serial_iv[16];
+    SecurityAssociation_t* sa_ptr = NULL;
+    uint32_t i;
+    int j;
+
+    sa_ptr = ut_tm_idle_init(IDLE_VC_FALSE, IDLE_FRAMES_PROCESS);
+    Crypto_Config_TM_Anti_Replay(TM_CHECK_ANTI_REPLAY_TRUE);
+    frames = (uint8_t*)calloc(num_frames, 1786);
+    serial_jobs = (crypto_tm_batch_job_t*)calloc(num_jobs, sizeof(crypto_tm_batch_job_t));
+    parallel_jobs = (crypto_tm_batch_job_t*)calloc(num_jobs, sizeof(crypto_tm_batch_job_t));
+    ASSERT_TRUE((frames != NULL) && (serial_jobs != NULL) && (parallel_jobs != NULL));
+
+    sa_ptr->iv[15] = 1;
+    for (i = 0; i < num_frames; i++)
+    {
+        frames[(i * 1786) + 0] = 0x02;
+        frames[(i * 1786) + 1] = 0xC0;
+        frames[(i * 1786) + 4] = 0x18;
+        for (j = 24; j < 1768; j++)
+        {
+            frames[(i * 1786) + j] = (uint8_t)(i + j);
+        }
+        status = Crypto_TM_ApplySecurity(&frames[i * 1786]);
+        ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+    }
+
+    // Last frame of the first window replayed as the first of the second
+    for (i = 0; i < num_jobs; i++)
+    {
+        serial_jobs[i].p_ingest = &frames[((i < TM_BATCH_WINDOW) ? i : (i - 1)) * 1786];
+        serial_jobs[i].len_ingest = 1786;
+        parallel_jobs[i] = serial_jobs[i];
+    }
+
+    memset(sa_ptr->iv, 0, 16);
+    status = Crypto_TM_ProcessSecurity_Batch(serial_jobs, num_jobs, 1);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+    memcpy(serial_iv, sa_ptr->iv, 16);
+
+    memset(sa_ptr->iv, 0, 16);
+    status = Crypto_TM_ProcessSecurity_Batch(parallel_jobs, num_jobs, 4);
+    ASSERT_EQ(CRYPTO_LIB_SUCCESS, status);
+
+    for (i = 0; i < num_jobs; i++)
+    {
+        ASSERT_EQ((i == TM_BATCH_WINDOW) ? CRYPTO_LIB_ERR_IV_OUTSIDE_WINDOW : CRYPTO_LIB_SUCCESS, serial_jobs[i].status);
+        ASSERT_EQ(serial_jobs[i].status, parallel_jobs[i].status);
+        if (serial_jobs[i].status == CRYPTO_LIB_SUCCESS)
+        {
+            ASSERT_EQ(0, memcmp(serial_jobs[i].p_processed_frame, parallel_jobs[i].p_processed_frame, 1786));
+        }
+        else
+        {
+            ASSERT_TRUE(parallel_jobs[i].p_processed_frame == NULL);
+        }
+        free(serial_jobs[i].p_processed_frame);
+        free(parallel_jobs[i].p_processed_frame);
+    }
+    for (i = 0; i < 16; i++)
+    {
+        ASSERT_EQ(frames[((num_frames - 1) * 1786) + 8 + i], sa_ptr->iv[i]);
+        ASSERT_EQ(serial_iv[i], sa_ptr->iv[i]);
+    }
+
+    free(frames);
+    free(serial_jobs);
+    free(parallel_jobs);
+    Crypto_Shutdown();
+}
+
 UTEST_MAIN();
\ No newline at end of file